@@ -0,0 +1,105 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// One workgroup per meshlet, one thread per triangle. Every triangle of a
+// culled meshlet is written out as degenerate so the index buffer keeps its
+// layout and can be drawn with a fixed index count.
+//
+// Must match ppx::Meshlet, ppx::MeshletBounds and ppx::MeshletCuller.
+
+#define MAX_MESHLET_TRIANGLES 128
+
+struct Meshlet
+{
+    uint vertexOffset;
+    uint triangleOffset;
+    uint vertexCount;
+    uint triangleCount;
+};
+
+struct MeshletBounds
+{
+    float3 center;
+    float  radius;
+    float3 coneAxis;
+    float  coneCutoff;
+    float3 coneApex;
+    float  reserved;
+};
+
+struct CullParamsData
+{
+    float4 frustumPlanes[6]; // Object space
+    float3 cameraPosition;   // Object space
+    uint   meshletCount;
+    uint   enableFrustumCulling;
+    uint   enableBackfaceCulling;
+};
+
+ConstantBuffer<CullParamsData>  CullParams : register(b0);
+StructuredBuffer<Meshlet>       Meshlets   : register(t1);
+StructuredBuffer<MeshletBounds> Bounds     : register(t2);
+StructuredBuffer<uint>          Triangles  : register(t3);
+RWStructuredBuffer<uint>        Indices    : register(u4);
+
+bool IsVisible(MeshletBounds bounds)
+{
+    if (CullParams.enableFrustumCulling) {
+        for (uint i = 0; i < 6; ++i) {
+            float4 plane = CullParams.frustumPlanes[i];
+            if (dot(plane.xyz, bounds.center) + plane.w < -bounds.radius) {
+                return false;
+            }
+        }
+    }
+
+    if (CullParams.enableBackfaceCulling && (bounds.coneCutoff < 1.0)) {
+        float3 view = bounds.coneApex - CullParams.cameraPosition;
+        if (dot(view, view) > 0) {
+            if (dot(normalize(view), bounds.coneAxis) >= bounds.coneCutoff) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+[numthreads(MAX_MESHLET_TRIANGLES, 1, 1)]
+void csmain(uint3 gid : SV_GroupID, uint tid : SV_GroupIndex)
+{
+    uint meshletIndex = gid.x;
+    if (meshletIndex >= CullParams.meshletCount) {
+        return;
+    }
+
+    Meshlet meshlet = Meshlets[meshletIndex];
+    if (tid >= meshlet.triangleCount) {
+        return;
+    }
+
+    uint dst = 3 * (meshlet.triangleOffset + tid);
+    if (!IsVisible(Bounds[meshletIndex])) {
+        Indices[dst + 0] = 0;
+        Indices[dst + 1] = 0;
+        Indices[dst + 2] = 0;
+        return;
+    }
+
+    // Vertex buffer holds one vertex per meshlet vertex entry
+    uint packed = Triangles[meshlet.triangleOffset + tid];
+    Indices[dst + 0] = meshlet.vertexOffset + (packed & 0xFF);
+    Indices[dst + 1] = meshlet.vertexOffset + ((packed >> 8) & 0xFF);
+    Indices[dst + 2] = meshlet.vertexOffset + ((packed >> 16) & 0xFF);
+}
@@ -0,0 +1,188 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_benchmark.h"
+
+#include "ppx/bitmap.h"
+#include "ppx/mipmap.h"
+
+#include <filesystem>
+
+using namespace ppx;
+
+namespace {
+
+// Gradients with some high frequency detail so PNG compression and
+// filtering do realistic amounts of work
+Bitmap CreateTestBitmap(uint32_t size, Bitmap::Format format = Bitmap::FORMAT_RGBA_UINT8)
+{
+    Bitmap bitmap = Bitmap::Create(size, size, format);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) {
+            const uint8_t values[4] = {
+                static_cast<uint8_t>((x * 255) / size),
+                static_cast<uint8_t>((y * 255) / size),
+                static_cast<uint8_t>((x ^ y) & 0xFF),
+                255};
+
+            if (format == Bitmap::FORMAT_RGBA_FLOAT) {
+                float* pPixel = bitmap.GetPixel32f(x, y);
+                for (uint32_t c = 0; c < 4; ++c) {
+                    pPixel[c] = values[c] / 255.0f;
+                }
+            }
+            else {
+                uint8_t* pPixel = bitmap.GetPixel8u(x, y);
+                for (uint32_t c = 0; c < 4; ++c) {
+                    pPixel[c] = values[c];
+                }
+            }
+        }
+    }
+    return bitmap;
+}
+
+void Bitmap_LoadFile(bench::State& state)
+{
+    const uint32_t              size = static_cast<uint32_t>(state.GetArg(0));
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / ("ppx_cpu_benchmark_" + std::to_string(size) + ".png");
+
+    Bitmap source = CreateTestBitmap(size);
+    if (Failed(Bitmap::SaveFilePNG(path, &source))) {
+        state.SkipWithError("failed to write " + path.string());
+        return;
+    }
+
+    while (state.KeepRunning()) {
+        Bitmap bitmap;
+        if (Failed(Bitmap::LoadFile(path, &bitmap))) {
+            state.SkipWithError("failed to load " + path.string());
+            break;
+        }
+        bench::DoNotOptimize(bitmap.GetData());
+    }
+    state.SetBytesProcessed(state.GetIterations() * source.GetFootprintSize());
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+PPX_CPU_BENCHMARK(Bitmap_LoadFile)->Arg(256)->Arg(1024);
+
+// stb_image_resize box filter, the reference for Bitmap_Downsample
+void ScaleTo(bench::State& state, Bitmap::Format format)
+{
+    const uint32_t size   = static_cast<uint32_t>(state.GetArg(0));
+    Bitmap         source = CreateTestBitmap(size, format);
+    Bitmap         target = Bitmap::Create(size / 2, size / 2, format);
+
+    while (state.KeepRunning()) {
+        source.ScaleTo(&target, STBIR_FILTER_BOX);
+        bench::DoNotOptimize(target.GetData());
+    }
+    state.SetBytesProcessed(state.GetIterations() * source.GetFootprintSize());
+}
+
+void Downsample(bench::State& state, Bitmap::Format format, bool sRGB)
+{
+    const uint32_t size   = static_cast<uint32_t>(state.GetArg(0));
+    Bitmap         source = CreateTestBitmap(size, format);
+    Bitmap         target = Bitmap::Create(size / 2, size / 2, format);
+
+    while (state.KeepRunning()) {
+        source.Downsample(&target, sRGB);
+        bench::DoNotOptimize(target.GetData());
+    }
+    state.SetBytesProcessed(state.GetIterations() * source.GetFootprintSize());
+}
+
+void Bitmap_ScaleTo(bench::State& state)
+{
+    ScaleTo(state, Bitmap::FORMAT_RGBA_UINT8);
+}
+PPX_CPU_BENCHMARK(Bitmap_ScaleTo)->Arg(256)->Arg(1024)->Arg(4096);
+
+void Bitmap_ScaleToFloat(bench::State& state)
+{
+    ScaleTo(state, Bitmap::FORMAT_RGBA_FLOAT);
+}
+PPX_CPU_BENCHMARK(Bitmap_ScaleToFloat)->Arg(256)->Arg(1024)->Arg(4096);
+
+void Bitmap_Downsample(bench::State& state)
+{
+    Downsample(state, Bitmap::FORMAT_RGBA_UINT8, false);
+}
+PPX_CPU_BENCHMARK(Bitmap_Downsample)->Arg(256)->Arg(1024)->Arg(4096);
+
+void Bitmap_DownsampleSRGB(bench::State& state)
+{
+    Downsample(state, Bitmap::FORMAT_RGBA_UINT8, true);
+}
+PPX_CPU_BENCHMARK(Bitmap_DownsampleSRGB)->Arg(256)->Arg(1024)->Arg(4096);
+
+void Bitmap_DownsampleFloat(bench::State& state)
+{
+    Downsample(state, Bitmap::FORMAT_RGBA_FLOAT, false);
+}
+PPX_CPU_BENCHMARK(Bitmap_DownsampleFloat)->Arg(256)->Arg(1024)->Arg(4096);
+
+// Per-pixel walk the way Bitmap::PixelIterator users write it, the
+// reference for Bitmap_ParallelForEachRow
+void Bitmap_PixelIterator(bench::State& state)
+{
+    const uint32_t size   = static_cast<uint32_t>(state.GetArg(0));
+    Bitmap         bitmap = CreateTestBitmap(size, Bitmap::FORMAT_RGBA_FLOAT);
+
+    while (state.KeepRunning()) {
+        for (Bitmap::PixelIterator iter = bitmap.GetPixelIterator(); !iter.Done(); iter.Next()) {
+            float4* pPixel = iter.GetPixelAddress<float4>();
+            *pPixel        = *pPixel * 0.5f + float4(0.25f);
+        }
+        bench::DoNotOptimize(bitmap.GetData());
+    }
+    state.SetBytesProcessed(state.GetIterations() * bitmap.GetFootprintSize());
+}
+PPX_CPU_BENCHMARK(Bitmap_PixelIterator)->Arg(256)->Arg(1024)->Arg(4096);
+
+void Bitmap_ParallelForEachRow(bench::State& state)
+{
+    const uint32_t size   = static_cast<uint32_t>(state.GetArg(0));
+    Bitmap         bitmap = CreateTestBitmap(size, Bitmap::FORMAT_RGBA_FLOAT);
+
+    while (state.KeepRunning()) {
+        bitmap.ParallelForEachRow<float4>([](Bitmap::RowSpan<float4> row) {
+            for (float4& pixel : row) {
+                pixel = pixel * 0.5f + float4(0.25f);
+            }
+        });
+        bench::DoNotOptimize(bitmap.GetData());
+    }
+    state.SetBytesProcessed(state.GetIterations() * bitmap.GetFootprintSize());
+}
+PPX_CPU_BENCHMARK(Bitmap_ParallelForEachRow)->Arg(256)->Arg(1024)->Arg(4096);
+
+void Mipmap_Create(bench::State& state)
+{
+    const uint32_t size       = static_cast<uint32_t>(state.GetArg(0));
+    const uint32_t levelCount = Mipmap::CalculateLevelCount(size, size);
+    Bitmap         source     = CreateTestBitmap(size);
+
+    while (state.KeepRunning()) {
+        Mipmap mipmap(source, levelCount);
+        bench::DoNotOptimize(mipmap.GetMip(0));
+    }
+    state.SetBytesProcessed(state.GetIterations() * source.GetFootprintSize());
+}
+PPX_CPU_BENCHMARK(Mipmap_Create)->Arg(256)->Arg(1024);
+
+} // namespace
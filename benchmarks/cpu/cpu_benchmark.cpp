@@ -0,0 +1,414 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_benchmark.h"
+
+#include "ppx/log.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+namespace ppx {
+namespace bench {
+
+State::State(uint64_t maxIterations, const std::vector<int64_t>& args)
+    : mMaxIterations(maxIterations), mArgs(args)
+{
+}
+
+void State::StartTimer()
+{
+    mRealStart = Clock::now();
+    mCpuStart  = std::clock();
+    mRunning   = true;
+}
+
+void State::StopTimer()
+{
+    if (!mRunning) {
+        return;
+    }
+    mRealSeconds += std::chrono::duration<double>(Clock::now() - mRealStart).count();
+    mCpuSeconds += static_cast<double>(std::clock() - mCpuStart) / CLOCKS_PER_SEC;
+    mRunning = false;
+}
+
+bool State::KeepRunning()
+{
+    if (!mStarted) {
+        mStarted = true;
+        StartTimer();
+    }
+    if ((mIterations < mMaxIterations) && !HasError()) {
+        ++mIterations;
+        return true;
+    }
+    StopTimer();
+    return false;
+}
+
+void State::PauseTiming()
+{
+    StopTimer();
+}
+
+void State::ResumeTiming()
+{
+    StartTimer();
+}
+
+void State::SkipWithError(const std::string& message)
+{
+    mError = message;
+    StopTimer();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Benchmark* Benchmark::Arg(int64_t value)
+{
+    mArgs.push_back({value});
+    return this;
+}
+
+Benchmark* Benchmark::Args(const std::vector<int64_t>& values)
+{
+    mArgs.push_back(values);
+    return this;
+}
+
+static std::vector<std::unique_ptr<Benchmark>>& GetRegistry()
+{
+    static std::vector<std::unique_ptr<Benchmark>> sRegistry;
+    return sRegistry;
+}
+
+Benchmark* RegisterBenchmark(const std::string& name, BenchmarkFn fn)
+{
+    GetRegistry().push_back(std::make_unique<Benchmark>(name, fn));
+    return GetRegistry().back().get();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+namespace {
+
+constexpr uint64_t kMaxIterations = 1000000000;
+
+struct Options
+{
+    std::string filter      = "";
+    std::string outPath     = "";
+    double      minTime     = 0.5;
+    uint32_t    repetitions = 1;
+    bool        list        = false;
+};
+
+struct RunResult
+{
+    std::string name;
+    uint32_t    repetitionIndex = 0;
+    uint64_t    iterations      = 0;
+    double      realTimeNs      = 0; // Per iteration
+    double      cpuTimeNs       = 0; // Per iteration
+    double      itemsPerSecond  = 0;
+    double      bytesPerSecond  = 0;
+    std::string error;
+};
+
+void PrintUsage(const char* exe)
+{
+    std::cout << "Usage: " << exe << " [options]\n"
+              << "  --filter=<regex>       Only run benchmarks whose name matches\n"
+              << "  --out=<path>           Write results as JSON to path\n"
+              << "  --min-time=<seconds>   Minimum measured time per run (default 0.5)\n"
+              << "  --repetitions=<n>      Runs per benchmark, adds mean/median/stddev when > 1\n"
+              << "  --list                 List benchmarks and exit\n";
+}
+
+bool ParseOptions(int argc, char** argv, Options* pOptions)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg   = argv[i];
+        const size_t      eq    = arg.find('=');
+        const std::string key   = arg.substr(0, eq);
+        const std::string value = (eq != std::string::npos) ? arg.substr(eq + 1) : "";
+
+        if (key == "--filter") {
+            pOptions->filter = value;
+        }
+        else if (key == "--out") {
+            pOptions->outPath = value;
+        }
+        else if (key == "--min-time") {
+            pOptions->minTime = std::stod(value);
+        }
+        else if (key == "--repetitions") {
+            pOptions->repetitions = std::max(1, std::stoi(value));
+        }
+        else if (key == "--list") {
+            pOptions->list = true;
+        }
+        else {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string GetRunName(const Benchmark& benchmark, const std::vector<int64_t>& args)
+{
+    std::stringstream ss;
+    ss << benchmark.GetName();
+    for (int64_t arg : args) {
+        ss << "/" << arg;
+    }
+    return ss.str();
+}
+
+// Grows the iteration count until the timed section reaches minTime
+RunResult Run(const Benchmark& benchmark, const std::vector<int64_t>& args, double minTime)
+{
+    RunResult result = {};
+    result.name      = GetRunName(benchmark, args);
+
+    uint64_t iterations = 1;
+    while (true) {
+        State state(iterations, args);
+        benchmark.GetFn()(state);
+
+        if (state.HasError()) {
+            result.error = state.GetError();
+            return result;
+        }
+        if (state.GetIterations() != iterations) {
+            result.error = "benchmark returned before KeepRunning() returned false";
+            return result;
+        }
+
+        const double seconds = state.GetRealSeconds();
+        if ((seconds >= minTime) || (iterations >= kMaxIterations)) {
+            result.iterations = iterations;
+            result.realTimeNs = 1e9 * seconds / iterations;
+            result.cpuTimeNs  = 1e9 * state.GetCpuSeconds() / iterations;
+            if (seconds > 0) {
+                result.itemsPerSecond = state.GetItemsProcessed() / seconds;
+                result.bytesPerSecond = state.GetBytesProcessed() / seconds;
+            }
+            return result;
+        }
+
+        // Overshoot a little so the next attempt is likely the last one
+        const double multiplier = (seconds > 0) ? std::min(10.0, 1.4 * minTime / seconds) : 10.0;
+        const double next       = std::ceil(iterations * multiplier);
+        iterations              = std::max(iterations + 1, static_cast<uint64_t>(std::min(next, static_cast<double>(kMaxIterations))));
+    }
+}
+
+nlohmann::json ToJson(const RunResult& result, uint32_t repetitions)
+{
+    nlohmann::json entry;
+    entry["name"]             = result.name;
+    entry["run_name"]         = result.name;
+    entry["run_type"]         = "iteration";
+    entry["repetitions"]      = repetitions;
+    entry["repetition_index"] = result.repetitionIndex;
+    if (!result.error.empty()) {
+        entry["error_occurred"] = true;
+        entry["error_message"]  = result.error;
+        return entry;
+    }
+    entry["iterations"] = result.iterations;
+    entry["real_time"]  = result.realTimeNs;
+    entry["cpu_time"]   = result.cpuTimeNs;
+    entry["time_unit"]  = "ns";
+    if (result.itemsPerSecond > 0) {
+        entry["items_per_second"] = result.itemsPerSecond;
+    }
+    if (result.bytesPerSecond > 0) {
+        entry["bytes_per_second"] = result.bytesPerSecond;
+    }
+    return entry;
+}
+
+std::vector<nlohmann::json> Aggregate(const std::vector<RunResult>& results)
+{
+    std::vector<double> realTimes;
+    std::vector<double> cpuTimes;
+    for (const RunResult& result : results) {
+        if (!result.error.empty()) {
+            return {};
+        }
+        realTimes.push_back(result.realTimeNs);
+        cpuTimes.push_back(result.cpuTimeNs);
+    }
+
+    auto mean = [](const std::vector<double>& values) {
+        return std::accumulate(values.begin(), values.end(), 0.0) / values.size();
+    };
+    auto median = [](std::vector<double> values) {
+        std::sort(values.begin(), values.end());
+        const size_t n = values.size();
+        return (n % 2) ? values[n / 2] : 0.5 * (values[n / 2 - 1] + values[n / 2]);
+    };
+    auto stddev = [&mean](const std::vector<double>& values) {
+        const double m   = mean(values);
+        double       sum = 0;
+        for (double v : values) {
+            sum += (v - m) * (v - m);
+        }
+        return std::sqrt(sum / (values.size() - 1));
+    };
+
+    std::vector<nlohmann::json> entries;
+    const std::string           name = results.front().name;
+    for (const char* aggregate : {"mean", "median", "stddev"}) {
+        const std::string aggregateName = aggregate;
+
+        nlohmann::json entry;
+        entry["name"]           = name + "_" + aggregateName;
+        entry["run_name"]       = name;
+        entry["run_type"]       = "aggregate";
+        entry["repetitions"]    = results.size();
+        entry["aggregate_name"] = aggregateName;
+        entry["iterations"]     = results.size();
+        entry["time_unit"]      = "ns";
+        if (aggregateName == "mean") {
+            entry["real_time"] = mean(realTimes);
+            entry["cpu_time"]  = mean(cpuTimes);
+        }
+        else if (aggregateName == "median") {
+            entry["real_time"] = median(realTimes);
+            entry["cpu_time"]  = median(cpuTimes);
+        }
+        else {
+            entry["real_time"] = stddev(realTimes);
+            entry["cpu_time"]  = stddev(cpuTimes);
+        }
+        entries.push_back(entry);
+    }
+    return entries;
+}
+
+std::string GetDateString()
+{
+    std::time_t now = std::time(nullptr);
+    char        buffer[64];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    return buffer;
+}
+
+} // namespace
+
+int RunBenchmarks(int argc, char** argv)
+{
+    Options options = {};
+    if (!ParseOptions(argc, argv, &options)) {
+        PrintUsage(argv[0]);
+        return 1;
+    }
+
+    // Keep library logging out of the results on the console
+    Log::Initialize(LOG_MODE_FILE, "ppx_cpu_benchmarks.log");
+
+    std::regex filter(options.filter);
+
+#if defined(NDEBUG)
+    const char* buildType = "release";
+#else
+    const char* buildType = "debug";
+#endif
+
+    nlohmann::json report;
+    report["context"]["date"]               = GetDateString();
+    report["context"]["executable"]         = argv[0];
+    report["context"]["num_cpus"]           = std::thread::hardware_concurrency();
+    report["context"]["library_build_type"] = buildType;
+    report["context"]["min_time"]           = options.minTime;
+    report["context"]["repetitions"]        = options.repetitions;
+    report["benchmarks"]                    = nlohmann::json::array();
+
+    std::printf("%-48s %16s %16s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+    std::printf("%s\n", std::string(95, '-').c_str());
+
+    int failureCount = 0;
+    for (const auto& benchmark : GetRegistry()) {
+        std::vector<std::vector<int64_t>> argSets = benchmark->GetArgs();
+        if (argSets.empty()) {
+            argSets.push_back({});
+        }
+
+        for (const auto& args : argSets) {
+            const std::string runName = GetRunName(*benchmark, args);
+            if (!options.filter.empty() && !std::regex_search(runName, filter)) {
+                continue;
+            }
+            if (options.list) {
+                std::printf("%s\n", runName.c_str());
+                continue;
+            }
+
+            std::vector<RunResult> results;
+            for (uint32_t i = 0; i < options.repetitions; ++i) {
+                RunResult result       = Run(*benchmark, args, options.minTime);
+                result.repetitionIndex = i;
+                if (result.error.empty()) {
+                    std::printf("%-48s %16.1f %16.1f %12llu\n", runName.c_str(), result.realTimeNs, result.cpuTimeNs, static_cast<unsigned long long>(result.iterations));
+                }
+                else {
+                    std::printf("%-48s ERROR: %s\n", runName.c_str(), result.error.c_str());
+                    ++failureCount;
+                }
+                report["benchmarks"].push_back(ToJson(result, options.repetitions));
+                results.push_back(result);
+            }
+
+            if (options.repetitions > 1) {
+                for (const nlohmann::json& entry : Aggregate(results)) {
+                    report["benchmarks"].push_back(entry);
+                }
+            }
+        }
+    }
+
+    if (!options.outPath.empty() && !options.list) {
+        std::ofstream file(options.outPath);
+        if (!file) {
+            std::cerr << "Failed to open " << options.outPath << " for writing" << std::endl;
+            return 1;
+        }
+        file << report.dump(2) << std::endl;
+    }
+
+    Log::Shutdown();
+    return (failureCount > 0) ? 1 : 0;
+}
+
+} // namespace bench
+} // namespace ppx
+
+int main(int argc, char** argv)
+{
+    return ppx::bench::RunBenchmarks(argc, argv);
+}
@@ -0,0 +1,173 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_cpu_benchmark_h
+#define ppx_cpu_benchmark_h
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <functional>
+#include <string>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ppx {
+namespace bench {
+
+//! @fn DoNotOptimize
+//!
+//! Keeps the compiler from discarding a value whose computation is being
+//! measured.
+//!
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+#if defined(_MSC_VER)
+    static const volatile void* sSink;
+    sSink = &value;
+    _ReadWriteBarrier();
+#else
+    asm volatile(""
+                 :
+                 : "r,m"(value)
+                 : "memory");
+#endif
+}
+
+//! @fn ClobberMemory
+//!
+//! Forces pending writes to memory to be treated as observable.
+//!
+inline void ClobberMemory()
+{
+#if defined(_MSC_VER)
+    _ReadWriteBarrier();
+#else
+    asm volatile(""
+                 :
+                 :
+                 : "memory");
+#endif
+}
+
+//! @class State
+//!
+//! Passed to a benchmark function, which runs the code being measured
+//! while KeepRunning() returns true:
+//!
+//!   void Bitmap_ScaleTo(bench::State& state)
+//!   {
+//!       ... setup, not timed ...
+//!       while (state.KeepRunning()) {
+//!           ... measured code ...
+//!       }
+//!   }
+//!
+//! The runner calls the function with increasing iteration counts until
+//! the timed section runs for at least the minimum time.
+//!
+class State
+{
+public:
+    State(uint64_t maxIterations, const std::vector<int64_t>& args);
+
+    bool KeepRunning();
+
+    // Excludes per-iteration setup from the measurement
+    void PauseTiming();
+    void ResumeTiming();
+
+    int64_t  GetArg(size_t index = 0) const { return mArgs[index]; }
+    uint64_t GetIterations() const { return mIterations; }
+
+    // Totals over all iterations, reported per second
+    void SetItemsProcessed(uint64_t count) { mItemsProcessed = count; }
+    void SetBytesProcessed(uint64_t count) { mBytesProcessed = count; }
+
+    // Stops the benchmark and reports message instead of timings
+    void SkipWithError(const std::string& message);
+
+    bool               HasError() const { return !mError.empty(); }
+    const std::string& GetError() const { return mError; }
+    double             GetRealSeconds() const { return mRealSeconds; }
+    double             GetCpuSeconds() const { return mCpuSeconds; }
+    uint64_t           GetItemsProcessed() const { return mItemsProcessed; }
+    uint64_t           GetBytesProcessed() const { return mBytesProcessed; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void StartTimer();
+    void StopTimer();
+
+private:
+    uint64_t             mMaxIterations  = 0;
+    uint64_t             mIterations     = 0;
+    std::vector<int64_t> mArgs;
+    bool                 mStarted        = false;
+    bool                 mRunning        = false;
+    Clock::time_point    mRealStart      = {};
+    std::clock_t         mCpuStart       = 0;
+    double               mRealSeconds    = 0;
+    double               mCpuSeconds     = 0;
+    uint64_t             mItemsProcessed = 0;
+    uint64_t             mBytesProcessed = 0;
+    std::string          mError;
+};
+
+using BenchmarkFn = std::function<void(State&)>;
+
+//! @class Benchmark
+//!
+//! A registered benchmark. Each Arg() or Args() call adds a variant that
+//! runs separately and is reported as name/arg0/arg1...
+//!
+class Benchmark
+{
+public:
+    Benchmark(const std::string& name, BenchmarkFn fn)
+        : mName(name), mFn(fn) {}
+
+    Benchmark* Arg(int64_t value);
+    Benchmark* Args(const std::vector<int64_t>& values);
+
+    const std::string&                       GetName() const { return mName; }
+    const BenchmarkFn&                       GetFn() const { return mFn; }
+    const std::vector<std::vector<int64_t>>& GetArgs() const { return mArgs; }
+
+private:
+    std::string                       mName;
+    BenchmarkFn                       mFn;
+    std::vector<std::vector<int64_t>> mArgs;
+};
+
+Benchmark* RegisterBenchmark(const std::string& name, BenchmarkFn fn);
+
+} // namespace bench
+} // namespace ppx
+
+#define PPX_BENCHMARK_CONCAT_INTERNAL(a, b) a##b
+#define PPX_BENCHMARK_CONCAT(a, b)          PPX_BENCHMARK_CONCAT_INTERNAL(a, b)
+
+// Registers fn under its own name, arguments can be chained:
+//   PPX_CPU_BENCHMARK(Bitmap_ScaleTo)->Arg(256)->Arg(1024);
+#define PPX_CPU_BENCHMARK(fn)                                                     \
+    static ::ppx::bench::Benchmark* PPX_BENCHMARK_CONCAT(sBenchmark_, __LINE__) = \
+        ::ppx::bench::RegisterBenchmark(#fn, fn)
+
+#endif // ppx_cpu_benchmark_h
@@ -0,0 +1,116 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_benchmark.h"
+
+#include "ppx/geometry.h"
+#include "ppx/tri_mesh.h"
+
+#include <filesystem>
+#include <fstream>
+
+using namespace ppx;
+
+namespace {
+
+// Writes an indexed sphere with normals and texture coordinates as OBJ
+bool WriteSphereOBJ(const std::filesystem::path& path, uint32_t segments)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 2 * segments, segments, TriMeshOptions().Indices().Normals().TexCoords());
+
+    std::ofstream file(path);
+    if (!file) {
+        return false;
+    }
+    for (uint32_t i = 0; i < mesh.GetCountPositions(); ++i) {
+        TriMeshVertexData vertexData = {};
+        mesh.GetVertexData(i, &vertexData);
+        file << "v " << vertexData.position.x << " " << vertexData.position.y << " " << vertexData.position.z << "\n";
+        file << "vn " << vertexData.normal.x << " " << vertexData.normal.y << " " << vertexData.normal.z << "\n";
+        file << "vt " << vertexData.texCoord.x << " " << vertexData.texCoord.y << "\n";
+    }
+    for (uint32_t i = 0; i < mesh.GetCountTriangles(); ++i) {
+        uint32_t v[3] = {};
+        mesh.GetTriangle(i, v[0], v[1], v[2]);
+        file << "f";
+        for (uint32_t k = 0; k < 3; ++k) {
+            const uint32_t index = v[k] + 1;
+            file << " " << index << "/" << index << "/" << index;
+        }
+        file << "\n";
+    }
+    return file.good();
+}
+
+void TriMesh_CreateFromOBJ(bench::State& state)
+{
+    const uint32_t              segments = static_cast<uint32_t>(state.GetArg(0));
+    const std::filesystem::path path     = std::filesystem::temp_directory_path() / ("ppx_cpu_benchmark_sphere_" + std::to_string(segments) + ".obj");
+    if (!WriteSphereOBJ(path, segments)) {
+        state.SkipWithError("failed to write " + path.string());
+        return;
+    }
+
+    uint64_t triangleCount = 0;
+    while (state.KeepRunning()) {
+        TriMesh mesh;
+        if (Failed(TriMesh::CreateFromOBJ(path, TriMeshOptions().Indices().Normals().TexCoords(), &mesh))) {
+            state.SkipWithError("failed to load " + path.string());
+            break;
+        }
+        triangleCount += mesh.GetCountTriangles();
+        bench::DoNotOptimize(mesh);
+    }
+    state.SetItemsProcessed(triangleCount);
+
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+}
+PPX_CPU_BENCHMARK(TriMesh_CreateFromOBJ)->Arg(16)->Arg(64);
+
+void TriMesh_CreateSphere(bench::State& state)
+{
+    const uint32_t segments = static_cast<uint32_t>(state.GetArg(0));
+
+    uint64_t triangleCount = 0;
+    while (state.KeepRunning()) {
+        TriMesh mesh = TriMesh::CreateSphere(1.0f, 2 * segments, segments, TriMeshOptions().Indices().AllAttributes());
+        triangleCount += mesh.GetCountTriangles();
+        bench::DoNotOptimize(mesh);
+    }
+    state.SetItemsProcessed(triangleCount);
+}
+PPX_CPU_BENCHMARK(TriMesh_CreateSphere)->Arg(16)->Arg(64);
+
+// Arg 0 selects the layout: 0 = interleaved, 1 = planar
+void Geometry_Create(bench::State& state)
+{
+    const bool         planar     = (state.GetArg(0) != 0);
+    TriMesh            mesh       = TriMesh::CreateSphere(1.0f, 128, 64, TriMeshOptions().Indices().AllAttributes());
+    GeometryCreateInfo createInfo = planar ? GeometryCreateInfo::PlanarU32() : GeometryCreateInfo::InterleavedU32();
+    createInfo.AddColor().AddNormal().AddTexCoord().AddTangent().AddBitangent();
+
+    while (state.KeepRunning()) {
+        Geometry geometry;
+        if (Failed(Geometry::Create(createInfo, mesh, &geometry))) {
+            state.SkipWithError("Geometry::Create failed");
+            break;
+        }
+        bench::DoNotOptimize(geometry);
+    }
+    state.SetItemsProcessed(state.GetIterations() * mesh.GetCountPositions());
+}
+PPX_CPU_BENCHMARK(Geometry_Create)->Arg(0)->Arg(1);
+
+} // namespace
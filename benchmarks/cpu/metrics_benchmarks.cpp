@@ -0,0 +1,114 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_benchmark.h"
+
+#include "ppx/metrics.h"
+#include "ppx/profiler.h"
+
+#include <chrono>
+#include <map>
+
+using namespace ppx;
+
+namespace {
+
+metrics::MetricID AddGauge(metrics::Manager& manager, const std::string& name)
+{
+    metrics::MetricMetadata metadata = {};
+    metadata.type                    = metrics::MetricType::GAUGE;
+    metadata.name                    = name;
+    metadata.unit                    = "ms";
+    metadata.interpretation          = metrics::MetricInterpretation::LOWER_IS_BETTER;
+    return manager.AddMetric(metadata);
+}
+
+void MetricGauge_RecordEntry(bench::State& state)
+{
+    metrics::Manager manager;
+    manager.StartRun("benchmark");
+    const metrics::MetricID id = AddGauge(manager, "frame_time");
+
+    metrics::MetricData data = {metrics::MetricType::GAUGE};
+    uint64_t            i    = 0;
+    while (state.KeepRunning()) {
+        data.gauge.seconds = i * 0.016;
+        data.gauge.value   = 16.0 + (i % 7);
+        bench::DoNotOptimize(manager.RecordMetricData(id, data));
+        ++i;
+    }
+    state.SetItemsProcessed(state.GetIterations());
+}
+PPX_CPU_BENCHMARK(MetricGauge_RecordEntry);
+
+// Report generation at the end of a run with arg entries per gauge
+void MetricGauge_Export(bench::State& state)
+{
+    const uint32_t entryCount = static_cast<uint32_t>(state.GetArg(0));
+
+    metrics::Manager manager;
+    manager.StartRun("benchmark");
+    const metrics::MetricID frameTimeId = AddGauge(manager, "frame_time");
+    const metrics::MetricID cpuTimeId   = AddGauge(manager, "cpu_time");
+
+    metrics::MetricData data = {metrics::MetricType::GAUGE};
+    for (uint32_t i = 0; i < entryCount; ++i) {
+        data.gauge.seconds = i * 0.016;
+        data.gauge.value   = 16.0 + (i % 7);
+        manager.RecordMetricData(frameTimeId, data);
+        manager.RecordMetricData(cpuTimeId, data);
+    }
+
+    while (state.KeepRunning()) {
+        metrics::Report report = manager.CreateReport("report");
+        bench::DoNotOptimize(report.GetContentString());
+    }
+    state.SetItemsProcessed(state.GetIterations() * entryCount * 2);
+}
+PPX_CPU_BENCHMARK(MetricGauge_Export)->Arg(1000)->Arg(10000);
+
+// Event lookup is linear, arg is the number of registered events
+void Profiler_RecordSample(bench::State& state)
+{
+    const uint32_t eventCount = static_cast<uint32_t>(state.GetArg(0));
+
+    // Events can't be unregistered, so register each set once per process
+    static std::map<uint32_t, ProfilerEventToken> sTokens;
+    if (sTokens.find(eventCount) == sTokens.end()) {
+        ProfilerEventToken token = 0;
+        for (uint32_t i = 0; i < eventCount; ++i) {
+            const std::string name   = "Profiler_RecordSample/" + std::to_string(eventCount) + "/" + std::to_string(i);
+            Result            ppxres = Profiler::RegisterEvent(PROFILER_EVENT_TYPE_GRFX_API_FN, name, PROFILER_EVENT_RECORD_ACTION_AVERAGE, &token);
+            if (Failed(ppxres)) {
+                state.SkipWithError("failed to register profiler event");
+                return;
+            }
+        }
+        sTokens[eventCount] = token;
+    }
+
+    const ProfilerEventToken token     = sTokens[eventCount];
+    Profiler*                pProfiler = Profiler::GetProfilerForThread();
+
+    ProfilerEventSample sample = {};
+    while (state.KeepRunning()) {
+        sample.endTimestamp += 100;
+        pProfiler->RecordSample(token, sample);
+        bench::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.GetIterations());
+}
+PPX_CPU_BENCHMARK(Profiler_RecordSample)->Arg(1)->Arg(64);
+
+} // namespace
@@ -0,0 +1,129 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_benchmark.h"
+
+#if defined(PPX_NULL)
+
+#include "ppx/font.h"
+#include "ppx/grfx/grfx_device.h"
+#include "ppx/grfx/grfx_instance.h"
+#include "ppx/grfx/grfx_text_draw.h"
+#include "ppx/imgui/font_inconsolata.h"
+
+using namespace ppx;
+
+namespace {
+
+// TextDraw needs a device, the null backend provides one without a GPU.
+// Objects are kept for the life of the process since the runner calls
+// each benchmark several times.
+class NullTextDraw
+{
+public:
+    Result Initialize()
+    {
+        grfx::InstanceCreateInfo instanceCreateInfo = {};
+        instanceCreateInfo.api                      = grfx::API_NULL;
+        Result ppxres                               = grfx::CreateInstance(&instanceCreateInfo, &mInstance);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        grfx::GpuPtr gpu;
+        ppxres = mInstance->GetGpu(0, &gpu);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        grfx::DeviceCreateInfo deviceCreateInfo = {};
+        deviceCreateInfo.pGpu                   = gpu;
+        deviceCreateInfo.graphicsQueueCount     = 1;
+        ppxres                                  = mInstance->CreateDevice(&deviceCreateInfo, &mDevice);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        grfx::TextureFontCreateInfo fontCreateInfo = {};
+        ppxres                                     = Font::CreateFromMemory(imgui::kFontInconsolataSize, reinterpret_cast<const char*>(imgui::kFontInconsolata), &fontCreateInfo.font);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        fontCreateInfo.size = 16.0f;
+
+        ppxres = mDevice->CreateTextureFont(&fontCreateInfo, &mFont);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        // The null backend doesn't look at shader code
+        const char                   code[4]          = {};
+        grfx::ShaderModuleCreateInfo shaderCreateInfo = {sizeof(code), code};
+        ppxres                                        = mDevice->CreateShaderModule(&shaderCreateInfo, &mShader);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        grfx::TextDrawCreateInfo createInfo = {};
+        createInfo.pFont                    = mFont;
+        createInfo.maxTextLength            = 4096;
+        createInfo.VS                       = {mShader, "vsmain"};
+        createInfo.PS                       = {mShader, "psmain"};
+        createInfo.renderTargetFormat       = grfx::FORMAT_B8G8R8A8_UNORM;
+        return mDevice->CreateTextDraw(&createInfo, &mTextDraw);
+    }
+
+    grfx::TextDraw* GetTextDraw() const { return mTextDraw; }
+
+private:
+    grfx::InstancePtr     mInstance;
+    grfx::DevicePtr       mDevice;
+    grfx::TextureFontPtr  mFont;
+    grfx::ShaderModulePtr mShader;
+    grfx::TextDrawPtr     mTextDraw;
+};
+
+grfx::TextDraw* GetTextDraw()
+{
+    static NullTextDraw sTextDraw;
+    static Result       sResult = sTextDraw.Initialize();
+    return Success(sResult) ? sTextDraw.GetTextDraw() : nullptr;
+}
+
+// Lays out a debug overlay sized block of text, arg is the line count
+void TextDraw_AddString(bench::State& state)
+{
+    grfx::TextDraw* pTextDraw = GetTextDraw();
+    if (IsNull(pTextDraw)) {
+        state.SkipWithError("failed to create text draw on null device");
+        return;
+    }
+
+    const uint32_t lineCount = static_cast<uint32_t>(state.GetArg(0));
+    std::string    text;
+    for (uint32_t i = 0; i < lineCount; ++i) {
+        text += "Frame " + std::to_string(i) + ": 16.667 ms\tGPU 12.345 ms\n";
+    }
+
+    while (state.KeepRunning()) {
+        pTextDraw->Clear();
+        pTextDraw->AddString(float2(10, 10), text);
+    }
+    state.SetItemsProcessed(state.GetIterations() * text.size());
+}
+PPX_CPU_BENCHMARK(TextDraw_AddString)->Arg(1)->Arg(32);
+
+} // namespace
+
+#endif // defined(PPX_NULL)
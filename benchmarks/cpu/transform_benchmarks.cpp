@@ -0,0 +1,55 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "cpu_benchmark.h"
+
+#include "ppx/transform.h"
+
+using namespace ppx;
+
+namespace {
+
+// Rebuilds all matrices, as for an object animated every frame
+void Transform_GetConcatenatedMatrix(bench::State& state)
+{
+    Transform transform;
+    transform.SetScale(2.0f, 2.0f, 2.0f);
+
+    float t = 0;
+    while (state.KeepRunning()) {
+        transform.SetTranslation(t, 2.0f * t, 3.0f * t);
+        transform.SetRotation(t, 0.5f * t, 0.25f * t);
+        bench::DoNotOptimize(transform.GetConcatenatedMatrix());
+        t += 0.001f;
+    }
+    state.SetItemsProcessed(state.GetIterations());
+}
+PPX_CPU_BENCHMARK(Transform_GetConcatenatedMatrix);
+
+// Matrices are cached, measures the dirty check
+void Transform_GetConcatenatedMatrixCached(bench::State& state)
+{
+    Transform transform;
+    transform.SetTranslation(1.0f, 2.0f, 3.0f);
+    transform.SetRotation(0.1f, 0.2f, 0.3f);
+    transform.GetConcatenatedMatrix();
+
+    while (state.KeepRunning()) {
+        bench::DoNotOptimize(transform.GetConcatenatedMatrix());
+    }
+    state.SetItemsProcessed(state.GetIterations());
+}
+PPX_CPU_BENCHMARK(Transform_GetConcatenatedMatrixCached);
+
+} // namespace
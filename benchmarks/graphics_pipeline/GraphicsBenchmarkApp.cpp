@@ -200,6 +200,14 @@ void GraphicsBenchmarkApp::Setup()
     // SCENE (skybox and spheres)
     // =====================================================================
 
+    // Shaders, read in parallel before the setup below creates their modules
+    {
+        // Shader directories can't be listed on every platform, e.g. Android
+        // assets, shaders are then loaded one at a time.
+        if (Failed(PreloadShaders(kShaderBaseDir))) {
+            PPX_LOG_WARN("Shader preloading failed, loading shaders on demand");
+        }
+    }
     // Camera
     {
         mCamera.LookAt(mCamera.GetEyePosition(), mCamera.GetTarget());
@@ -230,6 +238,16 @@ void GraphicsBenchmarkApp::Setup()
 
         PPX_CHECKED_CALL(GetDevice()->CreateDescriptorPool(&createInfo, &mDescriptorPool));
     }
+    // Uniform buffer pool, small uniform buffers share its blocks instead of
+    // getting an allocation each
+    {
+        grfx::MemoryPoolCreateInfo createInfo    = {};
+        createInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+        createInfo.usageFlags.bits.uniformBuffer = true;
+        createInfo.algorithm                     = grfx::MEMORY_POOL_ALGORITHM_DEFAULT;
+        createInfo.blockSize                     = 64 * 1024;
+        PPX_CHECKED_CALL(GetDevice()->CreateMemoryPool(&createInfo, &mUniformBufferPool));
+    }
 
     SetupSkyBoxResources();
     SetupSkyBoxMeshes();
@@ -295,6 +313,9 @@ void GraphicsBenchmarkApp::Setup()
         PPX_CHECKED_CALL(CreateOffscreenFrame(frame, RenderFormat(), GetSwapchain()->GetDepthFormat(), GetSwapchain()->GetWidth(), GetSwapchain()->GetHeight()));
         mOffscreenFrame.push_back(frame);
     }
+
+    // All shader modules exist now, pipelines compiled later reuse them
+    ClearShaderCache();
 }
 
 void GraphicsBenchmarkApp::SetupMetrics()
@@ -368,6 +389,7 @@ void GraphicsBenchmarkApp::SetupSkyBoxResources()
         bufferCreateInfo.size                          = PPX_MINIMUM_UNIFORM_BUFFER_SIZE;
         bufferCreateInfo.usageFlags.bits.uniformBuffer = true;
         bufferCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+        bufferCreateInfo.pMemoryPool                   = mUniformBufferPool;
         PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mSkyBox.uniformBuffer));
     }
 
@@ -416,6 +438,7 @@ void GraphicsBenchmarkApp::SetupSphereResources()
         bufferCreateInfo.size                          = PPX_MINIMUM_UNIFORM_BUFFER_SIZE;
         bufferCreateInfo.usageFlags.bits.uniformBuffer = true;
         bufferCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+        bufferCreateInfo.pMemoryPool                   = mUniformBufferPool;
         PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mSphere.uniformBuffer));
     }
 
@@ -1522,9 +1545,7 @@ void GraphicsBenchmarkApp::CreateColorsForDrawCalls()
 {
     // Create colors randomly.
     mColorsForDrawCalls.resize(kMaxSphereInstanceCount);
-    for (size_t i = 0; i < kMaxSphereInstanceCount; i++) {
-        mColorsForDrawCalls[i] = float4(mRandom.Float(), mRandom.Float(), mRandom.Float(), 0.5f);
-    }
+    mRandom.Fill(mColorsForDrawCalls.data(), mColorsForDrawCalls.size(), float4(0.0f, 0.0f, 0.0f, 0.5f), float4(1.0f, 1.0f, 1.0f, 0.5f));
 }
 
 void GraphicsBenchmarkApp::RecordCommandBuffer(PerFrame& frame, const RenderPasses& renderpasses, uint32_t imageIndex)
@@ -1770,10 +1791,8 @@ void GraphicsBenchmarkApp::SetupShader(const std::filesystem::path& fileName, gr
 
 void GraphicsBenchmarkApp::SetupShader(const char* baseDir, const std::filesystem::path& fileName, grfx::ShaderModule** ppShaderModule)
 {
-    std::vector<char> bytecode = LoadShader(baseDir, fileName);
-    PPX_ASSERT_MSG(!bytecode.empty(), "shader bytecode load failed for " << kShaderBaseDir << " " << fileName);
-    grfx::ShaderModuleCreateInfo shaderCreateInfo = {static_cast<uint32_t>(bytecode.size()), bytecode.data()};
-    PPX_CHECKED_CALL(GetDevice()->CreateShaderModule(&shaderCreateInfo, ppShaderModule));
+    // Shader modules are shared, pipelines using the same shader don't create it again
+    PPX_CHECKED_CALL(CreateShader(baseDir, fileName, ppShaderModule));
 }
 
 const ppx::Camera& GraphicsBenchmarkApp::GetCamera() const
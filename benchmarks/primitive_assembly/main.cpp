@@ -17,6 +17,7 @@
 
 #include "ppx/ppx.h"
 #include "ppx/csv_file_log.h"
+#include "ppx/mesh_optimizer.h"
 
 using namespace ppx;
 
@@ -53,6 +54,7 @@ private:
     ppx::grfx::PipelineInterfacePtr mPipelineInterface;
     ppx::grfx::GraphicsPipelinePtr  mPipeline;
     ppx::grfx::BufferPtr            mVertexBuffer;
+    ppx::grfx::BufferPtr            mIndexBuffer;
     grfx::DrawPassPtr               mDrawPass;
     grfx::Viewport                  mViewport;
     grfx::Rect                      mScissorRect;
@@ -60,11 +62,16 @@ private:
     uint2                           mRenderTargetSize;
     uint32_t                        mNumTriangles;
     std::string                     mCSVFileName;
+    std::string                     mMeshName;
+    uint32_t                        mMeshSegments       = 0;
+    bool                            mOptimizeMesh       = false;
+    uint32_t                        mMeshIndexCount     = 0;
     uint64_t                        mGpuWorkDuration    = 0;
     bool                            mUsePipelineQuery   = false;
     grfx::PipelineStatistics        mPipelineStatistics = {};
 
     void SetupTestParameters();
+    void SetupMesh();
 
     struct PerFrameRegister
     {
@@ -129,6 +136,53 @@ void ProjApp::SetupTestParameters()
 
     // Whether to use pipeline statistics queries.
     mUsePipelineQuery = cl_options.HasExtraOption("use-pipeline-query");
+
+    // Indexed mesh to draw instead of instanced triangles, either "sphere" or an OBJ file path
+    mMeshName     = cl_options.GetExtraOptionValueOrDefault<std::string>("mesh", "");
+    mMeshSegments = cl_options.GetExtraOptionValueOrDefault<uint32_t>("mesh-segments", 256);
+
+    // Whether to reorder the mesh for vertex cache, overdraw and vertex fetch efficiency
+    mOptimizeMesh = cl_options.HasExtraOption("optimize-mesh");
+}
+
+void ProjApp::SetupMesh()
+{
+    TriMeshOptions options = TriMeshOptions().Indices();
+    TriMesh        mesh    = (mMeshName == "sphere") ? TriMesh::CreateSphere(0.5f, mMeshSegments, mMeshSegments / 2, options) : TriMesh::CreateFromOBJ(GetAssetPath(mMeshName), options);
+
+    MeshOptimizerOptions optimizerOptions = {};
+    if (!mOptimizeMesh) {
+        optimizerOptions.vertexCacheMethod   = MESH_OPTIMIZER_VERTEX_CACHE_METHOD_NONE;
+        optimizerOptions.optimizeVertexFetch = false;
+    }
+    MeshOptimizerStatistics stats = {};
+    PPX_CHECKED_CALL(MeshOptimizer::Optimize(optimizerOptions, &mesh, &stats));
+    PPX_LOG_INFO("Mesh: " << mMeshName << " (" << mesh.GetCountTriangles() << " triangles)");
+    PPX_LOG_INFO("   ACMR: " << stats.before.acmr << " -> " << stats.after.acmr);
+    PPX_LOG_INFO("   ATVR: " << stats.before.atvr << " -> " << stats.after.atvr);
+
+    // The pass through shader takes float4 positions
+    std::vector<float4> vertexData(mesh.GetCountPositions());
+    for (uint32_t i = 0; i < mesh.GetCountPositions(); ++i) {
+        vertexData[i] = float4(*mesh.GetDataPositions(i), 1.0f);
+    }
+    mMeshIndexCount = mesh.GetCountIndices();
+
+    grfx::BufferCreateInfo bufferCreateInfo       = {};
+    bufferCreateInfo.size                         = SizeInBytesU32(vertexData);
+    bufferCreateInfo.usageFlags.bits.vertexBuffer = true;
+    bufferCreateInfo.memoryUsage                  = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    bufferCreateInfo.initialState                 = grfx::RESOURCE_STATE_VERTEX_BUFFER;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mVertexBuffer));
+    PPX_CHECKED_CALL(mVertexBuffer->CopyFromSource(bufferCreateInfo.size, vertexData.data()));
+
+    bufferCreateInfo                             = {};
+    bufferCreateInfo.size                        = static_cast<uint32_t>(mesh.GetDataSizeIndices());
+    bufferCreateInfo.usageFlags.bits.indexBuffer = true;
+    bufferCreateInfo.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    bufferCreateInfo.initialState                = grfx::RESOURCE_STATE_INDEX_BUFFER;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mIndexBuffer));
+    PPX_CHECKED_CALL(mIndexBuffer->CopyFromSource(bufferCreateInfo.size, mesh.GetDataIndicesU32()));
 }
 
 void ProjApp::Setup()
@@ -231,7 +285,10 @@ void ProjApp::Setup()
     }
 
     // Buffer and geometry data
-    {
+    if (!mMeshName.empty()) {
+        SetupMesh();
+    }
+    else {
         // clang-format off
         std::vector<float> vertexData = {
             // position           
@@ -305,7 +362,13 @@ void ProjApp::Render()
             if (mUsePipelineQuery) {
                 frame.cmd->BeginQuery(frame.pipelineStatsQuery, 0);
             }
-            frame.cmd->Draw(3, mNumTriangles, 0, 0);
+            if (mIndexBuffer) {
+                frame.cmd->BindIndexBuffer(mIndexBuffer, grfx::INDEX_TYPE_UINT32);
+                frame.cmd->DrawIndexed(mMeshIndexCount);
+            }
+            else {
+                frame.cmd->Draw(3, mNumTriangles, 0, 0);
+            }
             if (mUsePipelineQuery) {
                 frame.cmd->EndQuery(frame.pipelineStatsQuery, 0);
             }
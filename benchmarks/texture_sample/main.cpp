@@ -79,6 +79,7 @@ private:
     ppx::grfx::SamplerPtr                       mSampler;
     std::string                                 mSamplerFilterType;
     std::string                                 mSamplerMipmapFilterType;
+    grfx::Format                                mCompressionFormat = grfx::FORMAT_UNDEFINED;
 
     // Drawn rectangle sizes (number of mipmaps of target resolution)
     uint32_t mNumRectSizes = 0;
@@ -149,6 +150,21 @@ void ProjApp::Setup()
         PPX_LOG_WARN("Invalid sampler mipmap filter type (must be `linear` or `nearest`), defaulting to: " + mSamplerMipmapFilterType);
     }
 
+    // Block compression format for the textures, compressed files are cached between runs.
+    const std::string compression = cl_options.GetExtraOptionValueOrDefault<std::string>("texture-compression", "none");
+    if (compression == "bc1") {
+        mCompressionFormat = grfx::FORMAT_BC1_RGB_UNORM;
+    }
+    else if (compression == "bc3") {
+        mCompressionFormat = grfx::FORMAT_BC3_UNORM;
+    }
+    else if (compression == "bc7") {
+        mCompressionFormat = grfx::FORMAT_BC7_UNORM;
+    }
+    else if (compression != "none") {
+        PPX_LOG_WARN("Invalid texture compression (must be `none`, `bc1`, `bc3` or `bc7`), defaulting to: none");
+    }
+
     // Forced mip level to use for all frames (instead of cycling through all mip levels, one per frame).
     // This value is validated once the image is created and the mip level count is known.
     mForcedMipLevel = cl_options.GetExtraOptionValueOrDefault<int32_t>("force-mip-level", -1);
@@ -257,7 +273,9 @@ void ProjApp::Setup()
             res = "4k";
         }
 
-        grfx_util::ImageOptions options = grfx_util::ImageOptions().MipLevelCount(PPX_REMAINING_MIP_LEVELS);
+        TextureCompressionOptions compression = {};
+        compression.format                    = mCompressionFormat;
+        grfx_util::ImageOptions options       = grfx_util::ImageOptions().MipLevelCount(PPX_REMAINING_MIP_LEVELS).Compression(compression);
 
         for (uint32_t i = 0; i < mNumImages; ++i) {
             grfx::ImagePtr image;
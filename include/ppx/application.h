@@ -30,6 +30,8 @@
 #include <deque>
 #include <filesystem>
 #include <cinttypes>
+#include <mutex>
+#include <unordered_map>
 #include <vector>
 
 // clang-format off
@@ -71,8 +73,12 @@ struct StandardOptions
     std::shared_ptr<KnobFlag<bool>> pListGpus;
     std::shared_ptr<KnobFlag<bool>> pUseSoftwareRenderer;
     std::shared_ptr<KnobFlag<bool>> pHeadless;
+#if defined(PPX_NULL)
+    std::shared_ptr<KnobFlag<bool>> pNullGrfx;
+#endif
     std::shared_ptr<KnobFlag<bool>> pDeterministic;
     std::shared_ptr<KnobFlag<bool>> pEnableMetrics;
+    std::shared_ptr<KnobFlag<bool>> pFilterRedundantState;
     std::shared_ptr<KnobFlag<bool>> pOverwriteMetricsFile;
 
     // Options
@@ -192,6 +198,7 @@ struct ApplicationSettings
         std::vector<std::string> configJsonPaths       = {};
         bool                     deterministic         = false;
         bool                     enableMetrics         = false;
+        bool                     filterRedundantState  = false;
         uint64_t                 frameCount            = 0;
         uint32_t                 gpuIndex              = 0;
         bool                     headless              = false;
@@ -204,6 +211,9 @@ struct ApplicationSettings
         std::string              screenshotPath        = "screenshot_frame_#.ppm";
         int                      statsFrameWindow      = -1;
         bool                     useSoftwareRenderer   = false;
+#if defined(PPX_NULL)
+        bool nullGrfx = false;
+#endif
 #if defined(PPX_BUILD_XR)
         std::pair<int, int>      xrUiResolution       = std::make_pair(0, 0);
         std::vector<std::string> xrRequiredExtensions = {};
@@ -312,8 +322,24 @@ public:
     //     - loads shader file: some/path/shaders/dxil/Texture.vs.dxil for API_DX_12_0, API_DX_12_1
     //     - loads shader file: some/path/shaders/spv/Texture.vs.spv   for API_VK_1_1, API_VK_1_2
     //
-    std::vector<char> LoadShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName) const;
-    Result            CreateShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName, grfx::ShaderModule** ppShaderModule) const;
+    // Bytecode is cached by file path, so loading a shader again doesn't read
+    // the file. The returned bytecode is owned by the cache and stays valid
+    // until ClearShaderCache(), it's empty if the file couldn't be loaded.
+    // CreateShader() shares modules created from identical bytecode, see
+    // grfx::Device::AcquireShaderModule(). Destroying a shared module with
+    // DestroyShaderModule() releases one reference.
+    //
+    const std::vector<char>& LoadShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName) const;
+    Result                   CreateShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName, grfx::ShaderModule** ppShaderModule) const;
+
+    // Reads every shader in baseDir's dxil or spv subdirectory into the
+    // bytecode cache, using multiple threads. Subdirectories aren't read.
+    Result PreloadShaders(const std::filesystem::path& baseDir);
+
+    // Frees all cached shader bytecode, e.g. once Setup() has created its
+    // pipelines. Shader modules that were already created aren't affected.
+    // Bytecode returned by LoadShader() must not be used after this call.
+    void ClearShaderCache();
 
     Window*           GetWindow() const { return mWindow.get(); }
     grfx::InstancePtr GetInstance() const { return mInstance; }
@@ -468,6 +494,7 @@ private:
     float                           mRunTimeSeconds;
     ApplicationSettings             mSettings = {};
     std::string                     mDecoratedApiName;
+    grfx::Api                       mShaderApi = grfx::API_UNDEFINED; // API shaders are loaded for
     Timer                           mTimer;
     std::unique_ptr<Window>         mWindow                     = nullptr; // Requires enableDisplay
     bool                            mWindowSurfaceInvalid       = false;
@@ -481,6 +508,10 @@ private:
     std::unique_ptr<ImGuiImpl>      mImGui;
     KnobManager                     mKnobManager;
 
+    // Shader bytecode by file path, see LoadShader()
+    mutable std::mutex                                         mShaderBytecodeMutex;
+    mutable std::unordered_map<std::string, std::vector<char>> mShaderBytecode;
+
     uint64_t          mFrameCount        = 0;
     uint32_t          mSwapchainIndex    = 0;
     float             mAverageFPS        = 0;
@@ -499,6 +530,15 @@ private:
         metrics::MetricID framerateId    = metrics::kInvalidMetricID;
         metrics::MetricID frameCountId   = metrics::kInvalidMetricID;
 
+        // Only added when redundant state filtering is enabled
+        metrics::MetricID stateCommandsSubmittedId = metrics::kInvalidMetricID;
+        metrics::MetricID stateCommandsElidedId    = metrics::kInvalidMetricID;
+
+        // GPU memory, in MiB
+        metrics::MetricID gpuMemoryUsageId                                  = metrics::kInvalidMetricID;
+        metrics::MetricID gpuMemoryBudgetId                                 = metrics::kInvalidMetricID;
+        metrics::MetricID gpuMemoryCategoryIds[grfx::MEMORY_CATEGORY_COUNT] = {};
+
         double   framerateRecordTimer   = 0.0;
         uint64_t framerateFrameCount    = 0;
         bool     resetFramerateTracking = true;
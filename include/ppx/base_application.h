@@ -40,7 +40,9 @@ public:
     std::filesystem::path GetApplicationPath() const;
 
     const std::vector<std::filesystem::path>& GetAssetDirs() const { return mAssetDirs; }
-    void                                      AddAssetDir(const std::filesystem::path& path, bool insertAtFront = false);
+    // path can also be an asset pack (see ppx::fs::MountPack), which is
+    // mounted at path and searched like a directory.
+    void AddAssetDir(const std::filesystem::path& path, bool insertAtFront = false);
 
     // Returns the first valid subPath in the asset directories list
     //
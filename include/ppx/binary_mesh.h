@@ -0,0 +1,160 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_binary_mesh_h
+#define ppx_binary_mesh_h
+
+#include "ppx/config.h"
+#include "ppx/fs.h"
+#include "ppx/geometry.h"
+#include "ppx/meshlet.h"
+#include "ppx/tri_mesh.h"
+
+#include <filesystem>
+
+namespace ppx {
+
+//! @enum BinaryMeshStream
+//!
+//! Data streams stored in a binary mesh file. Vertex attribute streams are
+//! planar, i.e. one stream per attribute. Meshlet streams hold the
+//! corresponding MeshletData arrays and are optional.
+//!
+enum BinaryMeshStream
+{
+    BINARY_MESH_STREAM_INDICES           = 0,
+    BINARY_MESH_STREAM_POSITIONS         = 1,
+    BINARY_MESH_STREAM_COLORS            = 2,
+    BINARY_MESH_STREAM_NORMALS           = 3,
+    BINARY_MESH_STREAM_TEXCOORDS         = 4,
+    BINARY_MESH_STREAM_TANGENTS          = 5,
+    BINARY_MESH_STREAM_BITANGENTS        = 6,
+    BINARY_MESH_STREAM_MESHLETS          = 7,
+    BINARY_MESH_STREAM_MESHLET_VERTICES  = 8,
+    BINARY_MESH_STREAM_MESHLET_TRIANGLES = 9,
+    BINARY_MESH_STREAM_MESHLET_BOUNDS    = 10,
+    BINARY_MESH_STREAM_COUNT             = 11,
+};
+
+//! @struct BinaryMeshStreamDesc
+//!
+//! offset is relative to the start of the file and is always aligned
+//! to kBinaryMeshStreamAlignment. size is 0 if the stream is not present.
+//!
+struct BinaryMeshStreamDesc
+{
+    uint64_t offset      = 0;
+    uint64_t size        = 0;
+    uint32_t elementSize = 0;
+    uint32_t reserved    = 0;
+};
+
+//! @struct BinaryMeshHeader
+//!
+//! File layout:
+//!   BinaryMeshHeader
+//!   Stream data, each stream starts at a kBinaryMeshStreamAlignment boundary
+//!
+//! sourceHash and optionsHash are opaque to the file format, they're used
+//! by caches to detect stale files. See TriMesh::CreateFromOBJ.
+//!
+struct BinaryMeshHeader
+{
+    uint32_t             magic        = 0;
+    uint32_t             version      = 0;
+    uint64_t             sourceHash   = 0;
+    uint64_t             optionsHash  = 0;
+    uint32_t             indexType    = 0; // grfx::IndexType
+    uint32_t             texCoordDim  = 0; // TriMeshAttributeDim
+    uint32_t             indexCount   = 0;
+    uint32_t             vertexCount  = 0;
+    float                boundingBoxMin[3];
+    float                boundingBoxMax[3];
+    uint32_t             meshletCount = 0;
+    uint32_t             reserved     = 0;
+    BinaryMeshStreamDesc streams[BINARY_MESH_STREAM_COUNT];
+};
+
+//! @class BinaryMesh
+//!
+//! Read-only view of a binary mesh file. The file is memory mapped when the
+//! platform allows it, stream data can then be read in place, e.g. to copy
+//! directly into a staging buffer with grfx::Buffer::CopyFromSource().
+//!
+class BinaryMesh
+{
+public:
+    static constexpr uint32_t kMagic                     = 0x4D585050; // 'PPXM'
+    static constexpr uint32_t kVersion                   = 2;
+    static constexpr uint32_t kBinaryMeshStreamAlignment = 16;
+
+    BinaryMesh() {}
+    BinaryMesh(const BinaryMesh&) = delete;
+    BinaryMesh& operator=(const BinaryMesh&) = delete;
+    ~BinaryMesh() {}
+
+    // Writes mesh to path. The hashes are stored in the header as is.
+    // If pMeshletData is not null, its meshlets are stored alongside the mesh.
+    static Result Write(const std::filesystem::path& path, const TriMesh& mesh, uint64_t sourceHash = 0, uint64_t optionsHash = 0, const MeshletData* pMeshletData = nullptr);
+
+    // Writes geometry to path. Only planar geometry with attribute formats
+    // matching TriMeshVertexData can be written.
+    static Result Write(const std::filesystem::path& path, const Geometry& geometry, uint64_t sourceHash = 0, uint64_t optionsHash = 0, const MeshletData* pMeshletData = nullptr);
+
+    // Returns the XXH64 hash of the file content at path, 0 if the file can't be read.
+    static uint64_t HashFile(const std::filesystem::path& path);
+
+    // Opens and validates the binary mesh file at path. Files with stream
+    // layouts that don't match the header or indices outside of the vertex
+    // streams are rejected with ERROR_BAD_DATA_SOURCE.
+    Result Open(const std::filesystem::path& path);
+
+    bool IsOpen() const { return !IsNull(mHeader); }
+    bool IsMapped() const { return IsOpen() && mFile.IsMapped(); }
+
+    uint64_t            GetSourceHash() const { return mHeader->sourceHash; }
+    uint64_t            GetOptionsHash() const { return mHeader->optionsHash; }
+    grfx::IndexType     GetIndexType() const { return static_cast<grfx::IndexType>(mHeader->indexType); }
+    TriMeshAttributeDim GetTexCoordDim() const { return static_cast<TriMeshAttributeDim>(mHeader->texCoordDim); }
+    uint32_t            GetIndexCount() const { return mHeader->indexCount; }
+    uint32_t            GetVertexCount() const { return mHeader->vertexCount; }
+    uint32_t            GetMeshletCount() const { return mHeader->meshletCount; }
+    float3              GetBoundingBoxMin() const;
+    float3              GetBoundingBoxMax() const;
+
+    bool        HasStream(BinaryMeshStream stream) const { return GetStreamSize(stream) > 0; }
+    uint64_t    GetStreamSize(BinaryMeshStream stream) const;
+    uint32_t    GetStreamElementSize(BinaryMeshStream stream) const;
+    const void* GetStreamData(BinaryMeshStream stream) const;
+
+    // Creates a TriMesh from the file's streams, each stream is copied once.
+    Result CreateTriMesh(TriMesh* pMesh) const;
+
+    // Creates a planar geometry from the file's streams, each stream is copied once.
+    // Has the same layout as Geometry::Create(const TriMesh&, Geometry*).
+    Result CreateGeometry(Geometry* pGeometry) const;
+
+    // Copies the meshlet streams into pMeshletData. Fails if the file has no meshlets.
+    Result CreateMeshletData(MeshletData* pMeshletData) const;
+
+private:
+    fs::File                mFile;
+    std::vector<char>       mFileData; // Only used if the file can't be mapped
+    const char*             mData   = nullptr;
+    const BinaryMeshHeader* mHeader = nullptr;
+};
+
+} // namespace ppx
+
+#endif // ppx_binary_mesh_h
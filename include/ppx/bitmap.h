@@ -16,16 +16,23 @@
 #define ppx_bitmap_h
 
 #include "ppx/config.h"
+#include "ppx/math_config.h"
 #include "ppx/grfx/grfx_format.h"
 
 #include "stb_image_resize.h"
 
 #include <filesystem>
+#include <limits>
+#include <type_traits>
+#include <vector>
 
 namespace ppx {
 
 //! @class Bitmap
 //!
+//! Copies always get internal, tightly packed storage. Moves transfer
+//! the storage, including external storage and pixels owned by stbi, and
+//! leave the source empty.
 //!
 class Bitmap
 {
@@ -64,9 +71,11 @@ public:
 
     Bitmap();
     Bitmap(const Bitmap& obj);
+    Bitmap(Bitmap&& obj) noexcept;
     ~Bitmap();
 
     Bitmap& operator=(const Bitmap& rhs);
+    Bitmap& operator=(Bitmap&& rhs) noexcept;
 
     //! Creates a bitmap with internal storage.
     static Result Create(uint32_t width, uint32_t height, Bitmap::Format format, Bitmap* pBitmap);
@@ -97,6 +106,13 @@ public:
     Result ScaleTo(Bitmap* pTargetBitmap) const;
     Result ScaleTo(Bitmap* pTargetBitmap, stbir_filter filterType) const;
 
+    //! Halves the bitmap into \b pTargetBitmap, which must have the same
+    //! format and half the width and height (rounded down). Uses a 2x2 box
+    //! filter, or 3 taps along an odd dimension. If \b sRGB is true, 8-bit
+    //! color channels are averaged in linear space, alpha never is. Large
+    //! bitmaps are processed in row bands on multiple threads.
+    Result Downsample(Bitmap* pTargetBitmap, bool sRGB = false) const;
+
     template <typename PixelDataType>
     void Fill(PixelDataType r, PixelDataType g, PixelDataType b, PixelDataType a);
 
@@ -125,6 +141,9 @@ public:
 
     static Result GetFileProperties(const std::filesystem::path& path, uint32_t* pWidth, uint32_t* pHeight, Bitmap::Format* pFormat);
     static Result LoadFile(const std::filesystem::path& path, Bitmap* pBitmap);
+    // Loads paths[i] into (*pBitmaps)[i], decoding files on multiple threads.
+    // Returns the first failure in path order.
+    static Result LoadFiles(const std::vector<std::filesystem::path>& paths, std::vector<Bitmap>* pBitmaps);
     static Result SaveFilePNG(const std::filesystem::path& path, const Bitmap* pBitmap);
     static bool   IsBitmapFile(const std::filesystem::path& path);
 
@@ -193,10 +212,55 @@ public:
 
     PixelIterator GetPixelIterator() { return PixelIterator(this); }
 
+    // ---------------------------------------------------------------------------------------------
+
+    //! @struct RowSpan
+    //!
+    //! The pixels of row \b y as an array of \b width elements of type T.
+    //! sizeof(T) must be the pixel stride, for example float4 for
+    //! FORMAT_RGBA_FLOAT or uint8_t for FORMAT_R_UINT8.
+    //!
+    template <typename T>
+    struct RowSpan
+    {
+        T*       pPixels = nullptr;
+        uint32_t width   = 0;
+        uint32_t y       = 0;
+
+        T*       begin() const { return pPixels; }
+        T*       end() const { return pPixels + width; }
+        uint32_t size() const { return width; }
+        T&       operator[](uint32_t x) const { return pPixels[x]; }
+    };
+
+    //! Calls \b fn(Bitmap::RowSpan<T>) for each row, top to bottom. Const
+    //! bitmaps pass Bitmap::RowSpan<const T>.
+    template <typename T, typename RowFn>
+    void ForEachRow(RowFn fn) { ForEachRowSpan<T>(fn); }
+    template <typename T, typename RowFn>
+    void ForEachRow(RowFn fn) const { ForEachRowSpan<const T>(fn); }
+
+    //! Same as ForEachRow(), but large bitmaps are split into bands of rows
+    //! processed on multiple threads. \b fn is called concurrently for
+    //! different rows, in no particular order.
+    template <typename T, typename RowFn>
+    void ParallelForEachRow(RowFn fn) { ParallelForEachRowSpan<T>(fn); }
+    template <typename T, typename RowFn>
+    void ParallelForEachRow(RowFn fn) const { ParallelForEachRowSpan<const T>(fn); }
+
+    //! Replaces each pixel with \b fn(x, y, value), which takes and returns
+    //! a float4, for any format. 8 and 16-bit channels are normalized to
+    //! [0, 1] and written back rounded and clamped. Channels the format
+    //! doesn't have read as 0, alpha as 1, and aren't written. Rows are
+    //! processed as in ParallelForEachRow().
+    template <typename PixelFn>
+    Result Transform(PixelFn fn);
+
 private:
     void   InternalCtor();
     Result InternalInitialize(uint32_t width, uint32_t height, Bitmap::Format format, uint32_t rowStride, char* pExternalStorage);
     Result InternalCopy(const Bitmap& obj);
+    void   InternalMove(Bitmap& obj);
     void   FreeStbiDataIfNeeded();
 
     // Stbi-specific functions/wrappers.
@@ -206,6 +270,20 @@ private:
     // These arugments mirror those for stbi_info.
     static Result StbiInfo(const std::filesystem::path& path, int* pX, int* pY, int* pComp);
 
+    // Calls fn(firstRow, endRow) for bands of rows. Bands run on separate
+    // threads if pixelCount is large enough to pay for them.
+    static void ParallelForRowBands(uint32_t rowCount, uint64_t pixelCount, const std::function<void(uint32_t, uint32_t)>& fn);
+
+    // Row iteration behind ForEachRow() and ParallelForEachRow(), T is const
+    // qualified for const bitmaps
+    template <typename T, typename RowFn>
+    void ForEachRowSpan(RowFn& fn) const;
+    template <typename T, typename RowFn>
+    void ParallelForEachRowSpan(RowFn& fn) const;
+
+    template <typename ChannelType, uint32_t ChannelCount, typename PixelFn>
+    void TransformRows(PixelFn& fn);
+
 private:
     uint32_t          mWidth           = 0;
     uint32_t          mHeight          = 0;
@@ -218,6 +296,155 @@ private:
     std::vector<char> mInternalStorage = {};
 };
 
+//! @class BitmapView
+//!
+//! Non-owning view of the pixels of a Bitmap, a rectangle inside one, or
+//! any other memory. Creating a view never allocates or copies; the
+//! pixels must outlive the view. Rows are \b rowStride bytes apart, so a
+//! sub view keeps the row stride of the view it was taken from.
+//!
+//! Views of a const Bitmap or const memory are read-only, their sub views
+//! too. Mutable access to a read-only view asserts and returns null.
+//!
+class BitmapView
+{
+public:
+    BitmapView() {}
+    // Not explicit so a Bitmap can be passed wherever a view is expected
+    BitmapView(Bitmap& bitmap);
+    BitmapView(const Bitmap& bitmap);
+    //! If \b rowStride is 0, default row stride for format is used.
+    BitmapView(uint32_t width, uint32_t height, Bitmap::Format format, uint32_t rowStride, char* pData);
+    BitmapView(uint32_t width, uint32_t height, Bitmap::Format format, uint32_t rowStride, const char* pData);
+
+    // Returns true if dimensions are greater than one, format is valid, and data is valid
+    bool IsOk() const;
+    bool IsReadOnly() const { return mReadOnly; }
+
+    uint32_t       GetWidth() const { return mWidth; }
+    uint32_t       GetHeight() const { return mHeight; }
+    Bitmap::Format GetFormat() const { return mFormat; }
+    uint32_t       GetPixelStride() const { return mPixelStride; }
+    uint32_t       GetRowStride() const { return mRowStride; }
+    const char*    GetData() const { return mData; }
+    char*          GetMutableData() const;
+
+    // Returns byte address of pixel at (x,y), or null if outside the view
+    const char* GetPixelAddress(uint32_t x, uint32_t y) const;
+    char*       GetMutablePixelAddress(uint32_t x, uint32_t y) const;
+
+    // Returns an empty view if the rectangle isn't inside this view
+    BitmapView GetSubView(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const;
+
+    // Target must have the same format and must not be read-only
+    Result ScaleTo(const BitmapView& target, stbir_filter filterType = STBIR_FILTER_DEFAULT) const;
+
+private:
+    uint32_t       mWidth       = 0;
+    uint32_t       mHeight      = 0;
+    Bitmap::Format mFormat      = Bitmap::FORMAT_UNDEFINED;
+    uint32_t       mPixelStride = 0;
+    uint32_t       mRowStride   = 0;
+    const char*    mData        = nullptr;
+    bool           mReadOnly    = false;
+};
+
+template <typename T, typename RowFn>
+void Bitmap::ForEachRowSpan(RowFn& fn) const
+{
+    PPX_ASSERT_MSG(sizeof(T) == mPixelStride, "row element size doesn't match pixel stride");
+    if (IsNull(mData)) {
+        return;
+    }
+
+    for (uint32_t y = 0; y < mHeight; ++y) {
+        T* pPixels = reinterpret_cast<T*>(mData + static_cast<size_t>(y) * mRowStride);
+        fn(RowSpan<T>{pPixels, mWidth, y});
+    }
+}
+
+template <typename T, typename RowFn>
+void Bitmap::ParallelForEachRowSpan(RowFn& fn) const
+{
+    PPX_ASSERT_MSG(sizeof(T) == mPixelStride, "row element size doesn't match pixel stride");
+    if (IsNull(mData)) {
+        return;
+    }
+
+    ParallelForRowBands(mHeight, static_cast<uint64_t>(mWidth) * mHeight, [this, &fn](uint32_t firstRow, uint32_t endRow) {
+        for (uint32_t y = firstRow; y < endRow; ++y) {
+            T* pPixels = reinterpret_cast<T*>(mData + static_cast<size_t>(y) * mRowStride);
+            fn(RowSpan<T>{pPixels, mWidth, y});
+        }
+    });
+}
+
+template <typename ChannelType, uint32_t ChannelCount, typename PixelFn>
+void Bitmap::TransformRows(PixelFn& fn)
+{
+    struct Pixel
+    {
+        ChannelType channels[ChannelCount];
+    };
+
+    // 32-bit integers don't fit in a float's mantissa, so only smaller
+    // integers are normalized
+    constexpr bool   kIsInteger    = std::is_integral<ChannelType>::value;
+    constexpr bool   kIsNormalized = kIsInteger && (sizeof(ChannelType) <= 2);
+    constexpr double kMaxValue     = kIsInteger ? static_cast<double>(std::numeric_limits<ChannelType>::max()) : 0.0;
+    constexpr float  kScale        = kIsNormalized ? static_cast<float>(kMaxValue) : 1.0f;
+
+    ParallelForEachRow<Pixel>([&](RowSpan<Pixel> row) {
+        for (uint32_t x = 0; x < row.width; ++x) {
+            Pixel& pixel = row[x];
+
+            float4 value = float4(0, 0, 0, 1);
+            for (uint32_t c = 0; c < ChannelCount; ++c) {
+                value[c] = static_cast<float>(pixel.channels[c]) / kScale;
+            }
+
+            value = fn(x, row.y, value);
+
+            for (uint32_t c = 0; c < ChannelCount; ++c) {
+                if constexpr (kIsInteger) {
+                    double scaled     = static_cast<double>(value[c]) * kScale + 0.5;
+                    pixel.channels[c] = static_cast<ChannelType>(std::min(std::max(scaled, 0.0), kMaxValue));
+                }
+                else {
+                    pixel.channels[c] = value[c];
+                }
+            }
+        }
+    });
+}
+
+template <typename PixelFn>
+Result Bitmap::Transform(PixelFn fn)
+{
+    // clang-format off
+    switch (mFormat) {
+        default: return ppx::ERROR_IMAGE_INVALID_FORMAT;
+        case Bitmap::FORMAT_R_UINT8     : TransformRows<uint8_t, 1>(fn); break;
+        case Bitmap::FORMAT_RG_UINT8    : TransformRows<uint8_t, 2>(fn); break;
+        case Bitmap::FORMAT_RGB_UINT8   : TransformRows<uint8_t, 3>(fn); break;
+        case Bitmap::FORMAT_RGBA_UINT8  : TransformRows<uint8_t, 4>(fn); break;
+        case Bitmap::FORMAT_R_UINT16    : TransformRows<uint16_t, 1>(fn); break;
+        case Bitmap::FORMAT_RG_UINT16   : TransformRows<uint16_t, 2>(fn); break;
+        case Bitmap::FORMAT_RGB_UINT16  : TransformRows<uint16_t, 3>(fn); break;
+        case Bitmap::FORMAT_RGBA_UINT16 : TransformRows<uint16_t, 4>(fn); break;
+        case Bitmap::FORMAT_R_UINT32    : TransformRows<uint32_t, 1>(fn); break;
+        case Bitmap::FORMAT_RG_UINT32   : TransformRows<uint32_t, 2>(fn); break;
+        case Bitmap::FORMAT_RGB_UINT32  : TransformRows<uint32_t, 3>(fn); break;
+        case Bitmap::FORMAT_RGBA_UINT32 : TransformRows<uint32_t, 4>(fn); break;
+        case Bitmap::FORMAT_R_FLOAT     : TransformRows<float, 1>(fn); break;
+        case Bitmap::FORMAT_RG_FLOAT    : TransformRows<float, 2>(fn); break;
+        case Bitmap::FORMAT_RGB_FLOAT   : TransformRows<float, 3>(fn); break;
+        case Bitmap::FORMAT_RGBA_FLOAT  : TransformRows<float, 4>(fn); break;
+    }
+    // clang-format on
+    return ppx::SUCCESS;
+}
+
 template <typename PixelDataType>
 void Bitmap::Fill(PixelDataType r, PixelDataType g, PixelDataType b, PixelDataType a)
 {
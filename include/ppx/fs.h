@@ -35,6 +35,7 @@
 #include <vector>
 #include <filesystem>
 #include <fstream>
+#include <memory>
 
 #if defined(PPX_ANDROID)
 #include <android_native_app_glue.h>
@@ -60,6 +61,10 @@ class File
         STREAM_HANDLE = 1,
         // The file is accessible through an Android asset handle.
         ASSET_HANDLE = 2,
+        // The file is memory mapped from disk.
+        MAPPED_HANDLE = 3,
+        // The file is a view into a mounted asset pack's mapping.
+        PACK_HANDLE = 4,
     };
 
 public:
@@ -70,6 +75,8 @@ public:
 
     // Opens a file given a specific path.
     // path: the path of the file to open.
+    //  - If `path` is inside a mounted asset pack (see `MountPack()`), the file is served from the
+    //    pack's mapping and `File::IsMapped()` is true.
     //  - On desktop, loads the regular file at `path`. (memory-mapping availability is implementation defined).
     //  - On Android, relative path are assumed to be loaded from the APK, those are memory mapped.
     //                absolute path are loaded as regular files (mapping availability is implementation defined).
@@ -79,6 +86,16 @@ public:
     // - This class supports RAII. File will be closed on destroy.
     bool Open(const std::filesystem::path& path);
 
+    // Opens a file given a specific path and maps it into memory.
+    // path: the path of the file to open.
+    //  - On desktop, maps the regular file at `path` read-only.
+    //  - On Android, same behavior as `File::Open()`.
+    //
+    // - If the file cannot be mapped (empty file, mapping failure), this falls back to `File::Open()`.
+    //   Use `File::IsMapped()` to check whether `File::GetMappedData()` can be used.
+    // - The mapping is released when the File is destroyed.
+    bool OpenMapped(const std::filesystem::path& path);
+
     // Reads `size` bytes from the file into `buffer`.
     // buffer: a pointer to a buffer with at least `count` writable bytes.
     // count: the maximum number of bytes to write to `buffer`.
@@ -98,17 +115,22 @@ public:
     // Returns a readable pointer to a beginning of the file. Behavior undefined if `File::IsMapped()` is false.
     const void* GetMappedData() const;
 
+private:
+    bool OpenFromPack(const std::filesystem::path& path);
+
 private:
 #if !defined(PPX_ANDROID)
     typedef void AAsset;
 #endif
 
-    FileHandleType mHandleType = BAD_HANDLE;
-    AAsset*        mAsset      = nullptr;
-    const void*    mBuffer     = nullptr;
-    std::ifstream  mStream;
-    size_t         mFileSize   = 0;
-    size_t         mFileOffset = 0;
+    FileHandleType              mHandleType = BAD_HANDLE;
+    AAsset*                     mAsset      = nullptr;
+    const void*                 mBuffer     = nullptr;
+    void*                       mMapping    = nullptr;
+    std::ifstream               mStream;
+    size_t                      mFileSize   = 0;
+    size_t                      mFileOffset = 0;
+    std::shared_ptr<const void> mPack; // Keeps a mounted asset pack alive while open
 };
 
 class FileStream : public std::streambuf
@@ -129,11 +151,33 @@ std::optional<std::vector<char>> load_file(const std::filesystem::path& path);
 
 // Returns true if a given path exists (file or directory).
 // `path`: the path to check.
+// Files and directories inside mounted asset packs exist.
 // The path is handled differently depending on the platform:
 //  - desktop: all path are treated the same.
 //  - android: relative path are assumed to be in APK's storage (Asset API). Absolute are loaded from disk.
 bool path_exists(const std::filesystem::path& path);
 
+// Asset packs
+//
+// An asset pack is a single file holding a tree of files, built with
+// tools/pack_assets.py. Its index is sorted by path hash, so lookups need no
+// system calls, and file contents are aligned so they can be used in place
+// from the pack's memory mapping.
+//
+// A mounted pack is a layer ahead of the disk: `File`, `load_file()` and
+// `path_exists()` look up paths under its mount point in the pack first.
+// Packs mounted later take precedence over earlier ones.
+
+// Returns true if `path` has the asset pack extension (.ppxpack).
+bool IsPackFile(const std::filesystem::path& path);
+
+// Mounts the pack at `packPath` so that "dir/file.ext" in the pack is found at
+// `mountPoint` / "dir/file.ext". Returns false if the pack can't be mapped or is malformed.
+bool MountPack(const std::filesystem::path& packPath, const std::filesystem::path& mountPoint);
+
+// Unmounts a pack mounted from `packPath`. Files already open from it stay valid.
+void UnmountPack(const std::filesystem::path& packPath);
+
 #if defined(PPX_ANDROID)
 // Returns a path to the application's internal data directory (can be used for output).
 // NOTE: The internal data path on Android is extremely limited in terms of filesize!
@@ -204,6 +204,16 @@ public:
 private:
     Result InternalCtor();
 
+    // Bulk writes vertexCount vertices from mesh into the vertex buffers.
+    // Buffers are sized once up front and each attribute stream is written
+    // in a single loop. If srcIndexType is not UNDEFINED, vertex i is read
+    // from mesh vertex pSrcIndices[i], otherwise from mesh vertex i.
+    Result WriteVertexData(const TriMesh& mesh, uint32_t vertexCount, grfx::IndexType srcIndexType, const void* pSrcIndices);
+
+    // Bulk writes count indices into the index buffer. If srcIndexType is
+    // not UNDEFINED, index i is pSrcIndices[i], otherwise it's i.
+    void WriteIndexData(uint32_t count, grfx::IndexType srcIndexType, const void* pSrcIndices);
+
 public:
     // Create object using parameters from createInfo
     static Result Create(const GeometryCreateInfo& createInfo, Geometry* pGeometry);
@@ -248,7 +258,8 @@ public:
     void AppendIndicesTriangle(uint32_t idx0, uint32_t idx1, uint32_t idx2);
     void AppendIndicesEdge(uint32_t idx0, uint32_t idx1);
 
-    // Append a chunk of UINT32 indices
+    // Append a chunk of UINT16 or UINT32 indices
+    void AppendIndicesU16(uint32_t count, const uint16_t* pIndices);
     void AppendIndicesU32(uint32_t count, const uint32_t* pIndices);
 
     // Append multiple attributes at once
@@ -20,12 +20,15 @@
 #include "ppx/grfx/grfx_texture.h"
 #include "ppx/bitmap.h"
 #include "ppx/geometry.h"
+#include "ppx/ktx2.h"
 #include "ppx/mipmap.h"
+#include "ppx/texture_compression.h"
 #include "gli/gli.hpp"
 
 #include <array>
 #include <filesystem>
 #include <type_traits>
+#include <vector>
 
 namespace ppx {
 namespace grfx_util {
@@ -39,11 +42,13 @@ public:
     // clang-format off
     ImageOptions& AdditionalUsage(grfx::ImageUsageFlags flags) { mAdditionalUsage = flags; return *this; }
     ImageOptions& MipLevelCount(uint32_t levelCount) { mMipLevelCount = levelCount; return *this; }
+    ImageOptions& Compression(const TextureCompressionOptions& compression) { mCompression = compression; return *this; }
     // clang-format on
 
 private:
-    grfx::ImageUsageFlags mAdditionalUsage = grfx::ImageUsageFlags();
-    uint32_t              mMipLevelCount   = PPX_REMAINING_MIP_LEVELS;
+    grfx::ImageUsageFlags     mAdditionalUsage = grfx::ImageUsageFlags();
+    uint32_t                  mMipLevelCount   = PPX_REMAINING_MIP_LEVELS;
+    TextureCompressionOptions mCompression     = {};
 
     friend Result CreateImageFromBitmap(
         grfx::Queue*        pQueue,
@@ -69,8 +74,29 @@ private:
         const Bitmap*       pBitmap,
         grfx::Image**       ppImage,
         const ImageOptions& options);
+
+    friend Result CreateImageFromKtx2File(
+        grfx::Queue*        pQueue,
+        const Ktx2File&     file,
+        grfx::Image**       ppImage,
+        const ImageOptions& options,
+        uint32_t            uploadLevelCount);
 };
 
+//! @fn CopyBitmapToImage
+//!
+//! The view can be a mip level or a rectangle inside a larger bitmap,
+//! rows are read with the view's row stride.
+//!
+Result CopyBitmapToImage(
+    grfx::Queue*        pQueue,
+    const BitmapView&   bitmap,
+    grfx::Image*        pImage,
+    uint32_t            mipLevel,
+    uint32_t            arrayLayer,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter);
+
 //! @fn CopyBitmapToImage
 //!
 //!
@@ -83,6 +109,31 @@ Result CopyBitmapToImage(
     grfx::ResourceState stateBefore,
     grfx::ResourceState stateAfter);
 
+//! @struct BitmapSubresource
+//!
+//! Source of one region of a batched bitmap upload, see CopyBitmapsToImage().
+//!
+struct BitmapSubresource
+{
+    BitmapView bitmap;
+    uint32_t   mipLevel   = 0;
+    uint32_t   arrayLayer = 0;
+};
+
+//! @fn CopyBitmapsToImage
+//!
+//! Uploads several bitmaps to mip levels and array layers of pImage with a
+//! single staging buffer, copy and submit. Every subresource between the
+//! lowest and highest mip level and array layer of the regions is
+//! transitioned from stateBefore to stateAfter.
+//!
+Result CopyBitmapsToImage(
+    grfx::Queue*                          pQueue,
+    const std::vector<BitmapSubresource>& subresources,
+    grfx::Image*                          pImage,
+    grfx::ResourceState                   stateBefore,
+    grfx::ResourceState                   stateAfter);
+
 //! @fn CreateImageFromBitmap
 //!
 //!
@@ -94,6 +145,11 @@ Result CreateImageFromBitmap(
 
 //! @fn CreateImageFromFile
 //!
+//! If options enable compression, bitmap files are loaded from the
+//! compressed texture cache instead, see GetCompressedTextureFile().
+//! Falls back to the uncompressed bitmap if the file can't be compressed.
+//!
+//! KTX2 files are loaded with CreateImageFromKtx2File(), DDS files with gli.
 //!
 Result CreateImageFromFile(
     grfx::Queue*                 pQueue,
@@ -102,6 +158,38 @@ Result CreateImageFromFile(
     const ImageOptions&          options = ImageOptions(),
     bool                         useGpu  = false);
 
+//! @fn CopyKtx2LevelToImage
+//!
+//! Uploads mip \b level of a KTX2 file to the same mip level of pImage.
+//! Supercompressed levels are decompressed into the staging buffer, which
+//! only holds this one level.
+//!
+Result CopyKtx2LevelToImage(
+    grfx::Queue*        pQueue,
+    const Ktx2File&     file,
+    uint32_t            level,
+    grfx::Image*        pImage,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter);
+
+//! @fn CreateImageFromKtx2File
+//!
+//! Creates a 2D image from a KTX2 file, leaving it in the shader resource
+//! state. Levels are uploaded one at a time, coarsest first, so staging
+//! memory never exceeds the size of one level.
+//!
+//! Only the \b uploadLevelCount coarsest levels are uploaded. The finer
+//! levels can be streamed in later with CopyKtx2LevelToImage(), going from
+//! coarse to fine. Until a level is uploaded its content is undefined, so
+//! views must start at the finest uploaded level.
+//!
+Result CreateImageFromKtx2File(
+    grfx::Queue*        pQueue,
+    const Ktx2File&     file,
+    grfx::Image**       ppImage,
+    const ImageOptions& options          = ImageOptions(),
+    uint32_t            uploadLevelCount = PPX_REMAINING_MIP_LEVELS);
+
 //! @fn CreateMipMapsForImage
 //!
 //!
@@ -123,12 +211,14 @@ public:
     TextureOptions& AdditionalUsage(grfx::ImageUsageFlags flags) { mAdditionalUsage = flags; return *this; }
     TextureOptions& InitialState(grfx::ResourceState state) { mInitialState = state; return *this; }
     TextureOptions& MipLevelCount(uint32_t levelCount) { mMipLevelCount = levelCount; return *this; }
+    TextureOptions& Compression(const TextureCompressionOptions& compression) { mCompression = compression; return *this; }
     // clang-format on
 
 private:
-    grfx::ImageUsageFlags mAdditionalUsage = grfx::ImageUsageFlags();
-    grfx::ResourceState   mInitialState    = grfx::ResourceState::RESOURCE_STATE_SHADER_RESOURCE;
-    uint32_t              mMipLevelCount   = 1;
+    grfx::ImageUsageFlags     mAdditionalUsage = grfx::ImageUsageFlags();
+    grfx::ResourceState       mInitialState    = grfx::ResourceState::RESOURCE_STATE_SHADER_RESOURCE;
+    uint32_t                  mMipLevelCount   = 1;
+    TextureCompressionOptions mCompression     = {};
 
     friend Result CreateTextureFromBitmap(
         grfx::Queue*          pQueue,
@@ -149,6 +239,19 @@ private:
         const TextureOptions&        options);
 };
 
+//! @fn CopyBitmapToTexture
+//!
+//! See CopyBitmapToImage().
+//!
+Result CopyBitmapToTexture(
+    grfx::Queue*        pQueue,
+    const BitmapView&   bitmap,
+    grfx::Texture*      pTexture,
+    uint32_t            mipLevel,
+    uint32_t            arrayLayer,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter);
+
 //! @fn CreateTextureFromBitmap
 //!
 //!
@@ -161,6 +264,17 @@ Result CopyBitmapToTexture(
     grfx::ResourceState stateBefore,
     grfx::ResourceState stateAfter);
 
+//! @fn CopyBitmapsToTexture
+//!
+//! See CopyBitmapsToImage().
+//!
+Result CopyBitmapsToTexture(
+    grfx::Queue*                          pQueue,
+    const std::vector<BitmapSubresource>& subresources,
+    grfx::Texture*                        pTexture,
+    grfx::ResourceState                   stateBefore,
+    grfx::ResourceState                   stateAfter);
+
 //! @fn CreateTextureFromBitmap
 //!
 //!
@@ -182,6 +296,10 @@ Result CreateTextureFromMipmap(
 
 //! @fn CreateTextureFromFile
 //!
+//! See CreateImageFromFile() for compression. Compressed textures keep all
+//! the mip levels stored in the cache file, up to the options' level count.
+//! KTX2 files are supported too, see CreateImageFromKtx2File(). Compressed
+//! and KTX2 textures are created in the shader resource state.
 //!
 Result CreateTextureFromFile(
     grfx::Queue*                 pQueue,
@@ -22,6 +22,27 @@ namespace ppx {
 namespace grfx {
 namespace dx12 {
 
+class MemoryPool
+    : public grfx::MemoryPool
+{
+public:
+    MemoryPool() {}
+    virtual ~MemoryPool() {}
+
+    D3D12MA::Pool* GetDxPool() const { return mPool.Get(); }
+
+    virtual grfx::MemoryPoolStatistics GetStatistics() const override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::MemoryPoolCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    ObjPtr<D3D12MA::Pool> mPool;
+};
+
+// -------------------------------------------------------------------------------------------------
+
 class Buffer
     : public grfx::Buffer
 {
@@ -38,6 +59,10 @@ protected:
     virtual Result CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo) override;
     virtual void   DestroyApiObjects() override;
 
+private:
+    virtual Result FlushRangeImpl(uint64_t offset, uint64_t size) override;
+    virtual Result InvalidateRangeImpl(uint64_t offset, uint64_t size) override;
+
 private:
     D3D12ResourcePtr            mResource;
     D3D12_HEAP_TYPE             mHeapType;
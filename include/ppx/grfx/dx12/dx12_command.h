@@ -31,9 +31,6 @@ public:
 
     typename D3D12GraphicsCommandListPtr::InterfaceType* GetDxCommandList() const { return mCommandList.Get(); }
 
-    virtual Result Begin() override;
-    virtual Result End() override;
-
 private:
     virtual void BeginRenderPassImpl(const grfx::RenderPassBeginInfo* pBeginInfo) override;
     virtual void EndRenderPassImpl() override;
@@ -53,45 +50,46 @@ private:
         const grfx::StorageImageView*  pStorageImageView,
         const grfx::Sampler*           pSampler) override;
 
-public:
-    virtual void ClearRenderTarget(
-        grfx::Image*                        pImage,
-        const grfx::RenderTargetClearValue& clearValue) override;
-    virtual void ClearDepthStencil(
-        grfx::Image*                        pImage,
-        const grfx::DepthStencilClearValue& clearValue,
-        uint32_t                            clearFlags) override;
+    virtual Result BeginImpl() override;
+    virtual Result EndImpl() override;
 
-    virtual void TransitionImageLayout(
-        const grfx::Image*  pImage,
-        uint32_t            mipLevel,
-        uint32_t            mipLevelCount,
-        uint32_t            arrayLayer,
-        uint32_t            arrayLayerCount,
-        grfx::ResourceState beforeState,
-        grfx::ResourceState afterState,
-        const grfx::Queue*  pSrcQueue,
-        const grfx::Queue*  pDstQueue) override;
-
-    virtual void BufferResourceBarrier(
-        const grfx::Buffer* pBuffer,
-        grfx::ResourceState beforeState,
-        grfx::ResourceState afterState,
-        const grfx::Queue*  pSrcQueue = nullptr,
-        const grfx::Queue*  pDstQueue = nullptr) override;
-
-    virtual void SetViewports(
+    virtual void SetViewportsImpl(
         uint32_t              viewportCount,
         const grfx::Viewport* pViewports) override;
 
-    virtual void SetScissors(
+    virtual void SetScissorsImpl(
         uint32_t          scissorCount,
         const grfx::Rect* pScissors) override;
 
-    virtual void BindGraphicsDescriptorSets(
+    virtual void BindGraphicsDescriptorSetsImpl(
         const grfx::PipelineInterface*    pInterface,
         uint32_t                          setCount,
-        const grfx::DescriptorSet* const* ppSets) override;
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount,
+        const uint32_t*                   pDynamicOffsets) override;
+
+    virtual void BindGraphicsPipelineImpl(const grfx::GraphicsPipeline* pPipeline) override;
+
+    virtual void BindIndexBufferImpl(const grfx::IndexBufferView* pView) override;
+
+    virtual void BindVertexBuffersImpl(
+        uint32_t                      viewCount,
+        const grfx::VertexBufferView* pViews) override;
+
+    virtual void PipelineBarrierImpl(
+        uint32_t                   imageBarrierCount,
+        const grfx::ImageBarrier*  pImageBarriers,
+        uint32_t                   bufferBarrierCount,
+        const grfx::BufferBarrier* pBufferBarriers) override;
+
+public:
+    virtual void ClearRenderTarget(
+        grfx::Image*                        pImage,
+        const grfx::RenderTargetClearValue& clearValue) override;
+    virtual void ClearDepthStencil(
+        grfx::Image*                        pImage,
+        const grfx::DepthStencilClearValue& clearValue,
+        uint32_t                            clearFlags) override;
 
     virtual void PushGraphicsConstants(
         const grfx::PipelineInterface* pInterface,
@@ -99,12 +97,12 @@ public:
         const void*                    pValues,
         uint32_t                       dstOffset) override;
 
-    virtual void BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline) override;
-
     virtual void BindComputeDescriptorSets(
         const grfx::PipelineInterface*    pInterface,
         uint32_t                          setCount,
-        const grfx::DescriptorSet* const* ppSets) override;
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount = 0,
+        const uint32_t*                   pDynamicOffsets    = nullptr) override;
 
     virtual void PushComputeConstants(
         const grfx::PipelineInterface* pInterface,
@@ -114,12 +112,6 @@ public:
 
     virtual void BindComputePipeline(const grfx::ComputePipeline* pPipeline) override;
 
-    virtual void BindIndexBuffer(const grfx::IndexBufferView* pView) override;
-
-    virtual void BindVertexBuffers(
-        uint32_t                      viewCount,
-        const grfx::VertexBufferView* pViews) override;
-
     virtual void Draw(
         uint32_t vertexCount,
         uint32_t instanceCount,
@@ -193,8 +185,11 @@ private:
         const grfx::PipelineInterface*    pInterface,
         uint32_t                          setCount,
         const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount,
+        const uint32_t*                   pDynamicOffsets,
         size_t&                           rdtCountCBVSRVUAV,
-        size_t&                           rdtCountSampler);
+        size_t&                           rdtCountSampler,
+        size_t&                           rdCountCBV);
 
 private:
     D3D12GraphicsCommandListPtr    mCommandList;
@@ -214,8 +209,16 @@ private:
         D3D12_GPU_DESCRIPTOR_HANDLE baseDescriptor = {~0ULL};
     };
 
-    std::vector<RootDescriptorTable> mRootDescriptorTablesCBVSRVUAV;
-    std::vector<RootDescriptorTable> mRootDescriptorTablesSampler;
+    struct RootDescriptor
+    {
+        UINT                      parameterIndex = PPX_VALUE_IGNORED;
+        D3D12_GPU_VIRTUAL_ADDRESS bufferLocation = 0;
+    };
+
+    std::vector<RootDescriptorTable>    mRootDescriptorTablesCBVSRVUAV;
+    std::vector<RootDescriptorTable>    mRootDescriptorTablesSampler;
+    std::vector<RootDescriptor>         mRootDescriptorsCBV;
+    std::vector<D3D12_RESOURCE_BARRIER> mResourceBarriers;
 };
 
 // -------------------------------------------------------------------------------------------------
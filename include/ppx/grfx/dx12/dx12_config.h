@@ -76,6 +76,7 @@ class Gpu;
 class GraphicsPipeline;
 class Image;
 class Instance;
+class MemoryPool;
 class Pipeline;
 class PipelineInterface;
 class Queue;
@@ -179,6 +180,13 @@ struct ApiObjectLookUp<grfx::Image>
     using ApiType  = dx12::Image;
 };
 
+template <>
+struct ApiObjectLookUp<grfx::MemoryPool>
+{
+    using GrfxType = grfx::MemoryPool;
+    using ApiType  = dx12::MemoryPool;
+};
+
 template <>
 struct ApiObjectLookUp<grfx::Instance>
 {
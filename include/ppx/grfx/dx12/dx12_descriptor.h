@@ -77,6 +77,12 @@ public:
         D3D12_CPU_DESCRIPTOR_HANDLE descriptorHandle = {};
     };
 
+    struct DynamicUniformBuffer
+    {
+        UINT                      binding        = UINT32_MAX;
+        D3D12_GPU_VIRTUAL_ADDRESS bufferLocation = 0; // Excludes the dynamic offset
+    };
+
     DescriptorSet() {}
     virtual ~DescriptorSet() {}
 
@@ -88,6 +94,9 @@ public:
     typename D3D12DescriptorHeapPtr::InterfaceType* GetHeapCBVSRVUAV() const { return mHeapCBVSRVUAV.Get(); }
     typename D3D12DescriptorHeapPtr::InterfaceType* GetHeapSampler() const { return mHeapSampler.Get(); }
 
+    // In the same order as the layout's GetDynamicUniformBufferBindings()
+    const std::vector<DynamicUniformBuffer>& GetDynamicUniformBuffers() const { return mDynamicUniformBuffers; }
+
     virtual Result UpdateDescriptors(uint32_t writeCount, const grfx::WriteDescriptor* pWrites) override;
 
 protected:
@@ -95,11 +104,12 @@ protected:
     virtual void   DestroyApiObjects() override;
 
 private:
-    UINT                    mNumDescriptorsCBVSRVUAV = 0;
-    UINT                    mNumDescriptorsSampler   = 0;
-    D3D12DescriptorHeapPtr  mHeapCBVSRVUAV;
-    D3D12DescriptorHeapPtr  mHeapSampler;
-    std::vector<HeapOffset> mHeapOffsets;
+    UINT                              mNumDescriptorsCBVSRVUAV = 0;
+    UINT                              mNumDescriptorsSampler   = 0;
+    D3D12DescriptorHeapPtr            mHeapCBVSRVUAV;
+    D3D12DescriptorHeapPtr            mHeapSampler;
+    std::vector<HeapOffset>           mHeapOffsets;
+    std::vector<DynamicUniformBuffer> mDynamicUniformBuffers;
 };
 
 // -------------------------------------------------------------------------------------------------
@@ -123,6 +133,9 @@ public:
     const std::vector<DescriptorRange>& GetRangesCBVSRVUAV() const { return mRangesCBVSRVUAV; }
     const std::vector<DescriptorRange>& GetRangesSampler() const { return mRangesSampler; }
 
+    // Bindings of type DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC in layout order
+    const std::vector<uint32_t>& GetDynamicUniformBufferBindings() const { return mDynamicUniformBufferBindings; }
+
 protected:
     virtual Result CreateApiObjects(const grfx::DescriptorSetLayoutCreateInfo* pCreateInfo) override;
     virtual void   DestroyApiObjects() override;
@@ -132,6 +145,7 @@ private:
     uint32_t                     mCountSampler   = 0;
     std::vector<DescriptorRange> mRangesCBVSRVUAV;
     std::vector<DescriptorRange> mRangesSampler;
+    std::vector<uint32_t>        mDynamicUniformBufferBindings;
 };
 
 } // namespace dx12
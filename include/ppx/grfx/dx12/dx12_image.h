@@ -31,6 +31,7 @@ public:
     virtual ~Image();
 
     typename D3D12ResourcePtr::InterfaceType* GetDxResource() const { return mResource.Get(); }
+    D3D12MA::Allocation*                      GetAllocation() const { return mAllocation.Get(); }
 
     virtual Result MapMemory(uint64_t offset, void** ppMappedAddress) override;
     virtual void   UnmapMemory() override;
@@ -20,8 +20,66 @@
 namespace ppx {
 namespace grfx {
 
+//! @struct MemoryPoolCreateInfo
+//!
+//! \b usageFlags must cover the usage of every buffer placed in the pool,
+//! Vulkan picks the pool's memory type from them. Blocks are allocated as
+//! buffers need them, up to \b maxBlockCount.
+//!
+struct MemoryPoolCreateInfo
+{
+    grfx::MemoryUsage         memoryUsage   = grfx::MEMORY_USAGE_GPU_ONLY;
+    grfx::BufferUsageFlags    usageFlags    = 0;
+    grfx::MemoryPoolAlgorithm algorithm     = grfx::MEMORY_POOL_ALGORITHM_DEFAULT;
+    uint64_t                  blockSize     = 0; // 0 uses the allocator's preferred block size
+    uint32_t                  minBlockCount = 0;
+    uint32_t                  maxBlockCount = 0; // 0 for no limit
+};
+
+//! @struct MemoryPoolStatistics
+//!
+//!
+struct MemoryPoolStatistics
+{
+    uint32_t blockCount      = 0;
+    uint32_t allocationCount = 0;
+    uint64_t blockBytes      = 0;
+    uint64_t allocationBytes = 0;
+};
+
+//! @class MemoryPool
+//!
+//! Memory blocks owned by the device that buffers sub-allocate from, see
+//! BufferCreateInfo::pMemoryPool. Creating a pooled buffer doesn't
+//! allocate device memory unless the pool needs a new block, which makes
+//! large numbers of small uniform or staging buffers cheap.
+//!
+//! The pool must outlive the buffers created in it.
+//!
+class MemoryPool
+    : public grfx::DeviceObject<grfx::MemoryPoolCreateInfo>
+{
+public:
+    MemoryPool() {}
+    virtual ~MemoryPool() {}
+
+    grfx::MemoryUsage             GetMemoryUsage() const { return mCreateInfo.memoryUsage; }
+    const grfx::BufferUsageFlags& GetUsageFlags() const { return mCreateInfo.usageFlags; }
+    grfx::MemoryPoolAlgorithm     GetAlgorithm() const { return mCreateInfo.algorithm; }
+
+    virtual grfx::MemoryPoolStatistics GetStatistics() const = 0;
+
+protected:
+    virtual Result Create(const grfx::MemoryPoolCreateInfo* pCreateInfo) override;
+    friend class grfx::Device;
+};
+
+// -------------------------------------------------------------------------------------------------
+
 //! @struct BufferCreateInfo
 //!
+//! If \b pMemoryPool is set, \b memoryUsage must match the pool's and
+//! \b usageFlags must be a subset of the pool's.
 //!
 struct BufferCreateInfo
 {
@@ -31,6 +89,9 @@ struct BufferCreateInfo
     grfx::MemoryUsage      memoryUsage             = grfx::MEMORY_USAGE_GPU_ONLY;
     grfx::ResourceState    initialState            = grfx::RESOURCE_STATE_GENERAL;
     grfx::Ownership        ownership               = grfx::OWNERSHIP_REFERENCE;
+    bool                   persistentMap           = false;                           // Host visible memory usages only, see Buffer::GetMappedAddress()
+    grfx::MemoryCategory   memoryCategory          = grfx::MEMORY_CATEGORY_UNDEFINED; // [OPTIONAL] Inferred from usage if undefined
+    grfx::MemoryPool*      pMemoryPool             = nullptr;                         // [OPTIONAL] Sub-allocate from a pool
 };
 
 //! @class Buffer
@@ -46,16 +107,52 @@ public:
     uint64_t                      GetSize() const { return mCreateInfo.size; }
     uint32_t                      GetStructuredElementStride() const { return mCreateInfo.structuredElementStride; }
     const grfx::BufferUsageFlags& GetUsageFlags() const { return mCreateInfo.usageFlags; }
+    grfx::MemoryUsage             GetMemoryUsage() const { return mCreateInfo.memoryUsage; }
+    grfx::MemoryCategory          GetMemoryCategory() const { return mCreateInfo.memoryCategory; }
+    grfx::MemoryPool*             GetMemoryPool() const { return mCreateInfo.pMemoryPool; }
 
+    // Bytes the API allocated for the buffer, can be larger than GetSize()
+    uint64_t GetAllocationSize() const { return mAllocationSize; }
+
+    // Persistently mapped buffers return GetMappedAddress() + offset and
+    // UnmapMemory() does nothing.
     virtual Result MapMemory(uint64_t offset, void** ppMappedAddress) = 0;
     virtual void   UnmapMemory()                                      = 0;
 
+    // Address the memory stays mapped at for the buffer's lifetime, or
+    // nullptr if the buffer wasn't created with persistentMap.
+    void* GetMappedAddress() const { return mMappedAddress; }
+    bool  IsPersistentlyMapped() const { return !IsNull(mMappedAddress); }
+
+    // Memory that isn't host coherent needs CPU writes flushed before the
+    // GPU reads them and GPU writes invalidated before the CPU reads them.
+    // Both do nothing on host coherent memory. size can be PPX_WHOLE_SIZE.
+    Result FlushRange(uint64_t offset = 0, uint64_t size = PPX_WHOLE_SIZE);
+    Result InvalidateRange(uint64_t offset = 0, uint64_t size = PPX_WHOLE_SIZE);
+
     Result CopyFromSource(uint32_t dataSize, const void* pData);
     Result CopyToDest(uint32_t dataSize, void* pData);
 
+    // State left by the most recently recorded barrier, see
+    // grfx::CommandBuffer::BufferResourceBarrier.
+    grfx::ResourceState GetResourceState() const { return mResourceState; }
+
+protected:
+    void*    mMappedAddress  = nullptr; // Set by the API object when persistently mapped
+    uint64_t mAllocationSize = 0;       // Set by the API object
+
 private:
     virtual Result Create(const grfx::BufferCreateInfo* pCreateInfo) override;
     friend class grfx::Device;
+
+    // Offset and size are within the buffer, size is never PPX_WHOLE_SIZE
+    virtual Result FlushRangeImpl(uint64_t offset, uint64_t size)      = 0;
+    virtual Result InvalidateRangeImpl(uint64_t offset, uint64_t size) = 0;
+
+    void SetResourceState(grfx::ResourceState state) { mResourceState = state; }
+    friend class grfx::CommandBuffer;
+
+    grfx::ResourceState mResourceState = grfx::RESOURCE_STATE_UNDEFINED;
 };
 
 // -------------------------------------------------------------------------------------------------
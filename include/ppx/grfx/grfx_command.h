@@ -37,6 +37,7 @@
 //
 
 #include "ppx/grfx/grfx_config.h"
+#include "ppx/grfx/grfx_buffer.h"
 
 namespace ppx {
 namespace grfx {
@@ -249,8 +250,75 @@ struct CommandBufferCreateInfo
 
 } // namespace internal
 
+//! @struct ImageBarrier
+//!
+//! A pending image transition. Mip level and array layer counts are
+//! always resolved, never PPX_REMAINING_MIP_LEVELS/ARRAY_LAYERS.
+//!
+//! \b discardContents is set for the first use of an image whose memory
+//! was last used by an aliased resource.
+//!
+struct ImageBarrier
+{
+    const grfx::Image*  pImage          = nullptr;
+    uint32_t            mipLevel        = 0;
+    uint32_t            mipLevelCount   = 0;
+    uint32_t            arrayLayer      = 0;
+    uint32_t            arrayLayerCount = 0;
+    grfx::ResourceState beforeState     = grfx::RESOURCE_STATE_UNDEFINED;
+    grfx::ResourceState afterState      = grfx::RESOURCE_STATE_UNDEFINED;
+    const grfx::Queue*  pSrcQueue       = nullptr;
+    const grfx::Queue*  pDstQueue       = nullptr;
+    bool                discardContents = false;
+};
+
+//! @struct BufferBarrier
+//!
+//! A pending buffer transition, always covers the whole buffer.
+//!
+struct BufferBarrier
+{
+    const grfx::Buffer* pBuffer     = nullptr;
+    grfx::ResourceState beforeState = grfx::RESOURCE_STATE_UNDEFINED;
+    grfx::ResourceState afterState  = grfx::RESOURCE_STATE_UNDEFINED;
+    const grfx::Queue*  pSrcQueue   = nullptr;
+    const grfx::Queue*  pDstQueue   = nullptr;
+};
+
+//! @struct CommandBufferStatistics
+//!
+//! Counts of the state commands that go through redundant state filtering:
+//! pipeline, descriptor set, index buffer, vertex buffer, viewport and
+//! scissor binds. Elided commands were dropped because they matched the
+//! state that was already bound.
+//!
+struct CommandBufferStatistics
+{
+    uint64_t submittedStateCommands = 0;
+    uint64_t elidedStateCommands    = 0;
+};
+
 //! @class CommandBuffer
 //!
+//! When redundant state filtering is enabled on the device (see
+//! grfx::DeviceCreateInfo::enableRedundantStateFiltering) the command
+//! buffer keeps a shadow copy of the graphics state bound since Begin()
+//! and drops binds that would not change it. Descriptor sets are compared
+//! by pointer, so - same as in Vulkan - their contents must not be updated
+//! while they're bound. Code that records into the API command buffer
+//! directly must call InvalidateFilteredState() afterwards.
+//!
+//! Image and buffer barriers are batched: TransitionImageLayout and
+//! BufferResourceBarrier queue a barrier and all queued barriers are
+//! issued together right before the next draw, dispatch, copy, query,
+//! render pass or End(). A barrier that touches a resource which is
+//! already queued flushes the queue first so transitions stay ordered.
+//!
+//! The command buffer also records the state each transition leaves a
+//! resource in on the grfx::Image or grfx::Buffer itself, which is what
+//! the overloads without a before state use. The recorded state follows
+//! recording order, so it's only accurate if command buffers that touch
+//! the same resource are submitted in the order they were recorded.
 //!
 class CommandBuffer
     : public grfx::DeviceObject<grfx::internal::CommandBufferCreateInfo>
@@ -261,8 +329,16 @@ public:
 
     grfx::CommandType GetCommandType() const { return mCreateInfo.pPool->GetCommandType(); }
 
-    virtual Result Begin() = 0;
-    virtual Result End()   = 0;
+    Result Begin();
+    Result End();
+
+    bool IsRedundantStateFilteringEnabled() const { return mStateFilter.enabled; }
+
+    // Forgets all shadowed state so the next bind of each kind is forwarded
+    void InvalidateFilteredState();
+
+    // Counts since the last call to Begin()
+    const grfx::CommandBufferStatistics& GetStatistics() const { return mStatistics; }
 
     void BeginRenderPass(const grfx::RenderPassBeginInfo* pBeginInfo);
     void EndRenderPass();
@@ -298,7 +374,7 @@ public:
     //! D3D12 ignores both \b pSrcQueue and \b pDstQueue since they're not
     //! relevant.
     //!
-    virtual void TransitionImageLayout(
+    void TransitionImageLayout(
         const grfx::Image*  pImage,
         uint32_t            mipLevel,
         uint32_t            mipLevelCount,
@@ -307,31 +383,70 @@ public:
         grfx::ResourceState beforeState,
         grfx::ResourceState afterState,
         const grfx::Queue*  pSrcQueue = nullptr,
-        const grfx::Queue*  pDstQueue = nullptr) = 0;
+        const grfx::Queue*  pDstQueue = nullptr);
+
+    // Transitions from the state recorded on the image. Subresources that
+    // are in different states get separate barriers.
+    void TransitionImageLayout(
+        const grfx::Image*  pImage,
+        uint32_t            mipLevel,
+        uint32_t            mipLevelCount,
+        uint32_t            arrayLayer,
+        uint32_t            arrayLayerCount,
+        grfx::ResourceState afterState);
 
     //
     // See comment at function \b TransitionImageLayout for details
     // on queue ownership transfer.
     //
-    virtual void BufferResourceBarrier(
+    void BufferResourceBarrier(
         const grfx::Buffer* pBuffer,
         grfx::ResourceState beforeState,
         grfx::ResourceState afterState,
         const grfx::Queue*  pSrcQueue = nullptr,
-        const grfx::Queue*  pDstQueue = nullptr) = 0;
+        const grfx::Queue*  pDstQueue = nullptr);
 
-    virtual void SetViewports(
+    // Transitions from the state recorded on the buffer
+    void BufferResourceBarrier(
+        const grfx::Buffer* pBuffer,
+        grfx::ResourceState afterState);
+
+    // Transitions all of an image that shares memory with other resources
+    // (see grfx::ImageCreateInfo::pMemoryAliasImage) to afterState without
+    // preserving its contents. Must precede the first use of the image
+    // after an aliased resource used the memory. Vulkan transitions from
+    // VK_IMAGE_LAYOUT_UNDEFINED and D3D12 adds an aliasing barrier.
+    void AliasingImageBarrier(
+        const grfx::Image*  pImage,
+        grfx::ResourceState afterState);
+
+    // Issues all queued barriers now
+    void FlushBarriers();
+
+    void SetViewports(
         uint32_t              viewportCount,
-        const grfx::Viewport* pViewports) = 0;
+        const grfx::Viewport* pViewports);
 
-    virtual void SetScissors(
+    void SetScissors(
         uint32_t          scissorCount,
-        const grfx::Rect* pScissors) = 0;
+        const grfx::Rect* pScissors);
 
-    virtual void BindGraphicsDescriptorSets(
+    //
+    // Bindings of type DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC take one entry
+    // of pDynamicOffsets per array element, ordered by set and then by the
+    // binding order in each set's layout. The offset is added to the buffer
+    // offset written to the descriptor and must be a multiple of
+    // PPX_UNIFORM_BUFFER_ALIGNMENT. dynamicOffsetCount must equal the sum of
+    // GetDynamicOffsetCount() over the layouts of ppSets.
+    //
+    // D3D12: dynamic uniform buffers are bound as root CBVs.
+    //
+    void BindGraphicsDescriptorSets(
         const grfx::PipelineInterface*    pInterface,
         uint32_t                          setCount,
-        const grfx::DescriptorSet* const* ppSets) = 0;
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount = 0,
+        const uint32_t*                   pDynamicOffsets    = nullptr);
 
     //
     // Parameters count and dstOffset are measured in DWORDs (uint32_t) aka 32-bit values.
@@ -389,12 +504,15 @@ public:
         uint32_t                       set,
         const grfx::Sampler*           pSampler);
 
-    virtual void BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline) = 0;
+    void BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline);
 
+    // See comments at BindGraphicsDescriptorSets for explanation about dynamic offsets.
     virtual void BindComputeDescriptorSets(
         const grfx::PipelineInterface*    pInterface,
         uint32_t                          setCount,
-        const grfx::DescriptorSet* const* ppSets) = 0;
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount = 0,
+        const uint32_t*                   pDynamicOffsets    = nullptr) = 0;
 
     // See comments at SetGraphicsPushConstants for explanation about count, pValues and dstOffset.
     virtual void PushComputeConstants(
@@ -444,11 +562,11 @@ public:
 
     virtual void BindComputePipeline(const grfx::ComputePipeline* pPipeline) = 0;
 
-    virtual void BindIndexBuffer(const grfx::IndexBufferView* pView) = 0;
+    void BindIndexBuffer(const grfx::IndexBufferView* pView);
 
-    virtual void BindVertexBuffers(
+    void BindVertexBuffers(
         uint32_t                      viewCount,
-        const grfx::VertexBufferView* pViews) = 0;
+        const grfx::VertexBufferView* pViews);
 
     virtual void Draw(
         uint32_t vertexCount,
@@ -597,6 +715,9 @@ protected:
     DynamicRenderPassInfo mDynamicRenderPassInfo   = {};
 
 private:
+    virtual Result BeginImpl() = 0;
+    virtual Result EndImpl()   = 0;
+
     virtual void BeginRenderPassImpl(const grfx::RenderPassBeginInfo* pBeginInfo) = 0;
     virtual void EndRenderPassImpl()                                              = 0;
 
@@ -615,7 +736,82 @@ private:
         const grfx::StorageImageView*  pStorageImageView,
         const grfx::Sampler*           pSampler) = 0;
 
-    const grfx::RenderPass* mCurrentRenderPass = nullptr;
+    virtual void SetViewportsImpl(
+        uint32_t              viewportCount,
+        const grfx::Viewport* pViewports) = 0;
+
+    virtual void SetScissorsImpl(
+        uint32_t          scissorCount,
+        const grfx::Rect* pScissors) = 0;
+
+    virtual void BindGraphicsDescriptorSetsImpl(
+        const grfx::PipelineInterface*    pInterface,
+        uint32_t                          setCount,
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount,
+        const uint32_t*                   pDynamicOffsets) = 0;
+
+    virtual void BindGraphicsPipelineImpl(const grfx::GraphicsPipeline* pPipeline) = 0;
+
+    virtual void BindIndexBufferImpl(const grfx::IndexBufferView* pView) = 0;
+
+    virtual void BindVertexBuffersImpl(
+        uint32_t                      viewCount,
+        const grfx::VertexBufferView* pViews) = 0;
+
+    void QueueImageBarrier(const grfx::ImageBarrier& barrier);
+
+    void TransitionTrackedImageLayout(
+        const grfx::Image*  pImage,
+        uint32_t            mipLevel,
+        uint32_t            mipLevelCount,
+        uint32_t            arrayLayer,
+        uint32_t            arrayLayerCount,
+        grfx::ResourceState afterState,
+        bool                discardContents);
+
+    // Issues every barrier in a single API call where the API allows it
+    virtual void PipelineBarrierImpl(
+        uint32_t                   imageBarrierCount,
+        const grfx::ImageBarrier*  pImageBarriers,
+        uint32_t                   bufferBarrierCount,
+        const grfx::BufferBarrier* pBufferBarriers) = 0;
+
+    void PushDescriptor(
+        grfx::CommandType              pipelineBindPoint,
+        const grfx::PipelineInterface* pInterface,
+        grfx::DescriptorType           descriptorType,
+        uint32_t                       binding,
+        uint32_t                       set,
+        uint32_t                       bufferOffset,
+        const grfx::Buffer*            pBuffer,
+        const grfx::SampledImageView*  pSampledImageView,
+        const grfx::StorageImageView*  pStorageImageView,
+        const grfx::Sampler*           pSampler);
+
+    // Returns true if the command should be forwarded to the API
+    bool FilterStateCommand(bool redundant);
+
+    // Shadow copy of the bound graphics state. Empty containers and null
+    // pointers mean the state is unknown and the next bind is forwarded.
+    struct StateFilter
+    {
+        bool                                    enabled            = false;
+        const grfx::GraphicsPipeline*           pGraphicsPipeline  = nullptr;
+        const grfx::PipelineInterface*          pGraphicsInterface = nullptr;
+        std::vector<const grfx::DescriptorSet*> graphicsSets;
+        std::vector<uint32_t>                   graphicsDynamicOffsets;
+        grfx::IndexBufferView                   indexBuffer;
+        std::vector<grfx::VertexBufferView>     vertexBuffers;
+        std::vector<grfx::Viewport>             viewports;
+        std::vector<grfx::Rect>                 scissors;
+    };
+
+    const grfx::RenderPass*          mCurrentRenderPass = nullptr;
+    StateFilter                      mStateFilter       = {};
+    grfx::CommandBufferStatistics    mStatistics        = {};
+    std::vector<grfx::ImageBarrier>  mPendingImageBarriers;
+    std::vector<grfx::BufferBarrier> mPendingBufferBarriers;
 };
 
 } // namespace grfx
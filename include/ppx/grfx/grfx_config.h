@@ -43,6 +43,7 @@ class GraphicsPipeline;
 class Image;
 class ImageView;
 class Instance;
+class MemoryPool;
 class Mesh;
 class PipelineInterface;
 class Queue;
@@ -90,6 +91,7 @@ using GraphicsPipelinePtr    = ObjPtr<GraphicsPipeline>;
 using GpuPtr                 = ObjPtr<Gpu>;
 using ImagePtr               = ObjPtr<Image>;
 using InstancePtr            = ObjPtr<Instance>;
+using MemoryPoolPtr          = ObjPtr<MemoryPool>;
 using MeshPtr                = ObjPtr<Mesh>;
 using PipelineInterfacePtr   = ObjPtr<PipelineInterface>;
 using QueuePtr               = ObjPtr<Queue>;
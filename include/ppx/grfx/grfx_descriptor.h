@@ -172,9 +172,15 @@ public:
 
     const std::vector<grfx::DescriptorBinding>& GetBindings() const { return mCreateInfo.bindings; }
 
+    // Number of dynamic offsets a set with this layout consumes when bound
+    uint32_t GetDynamicOffsetCount() const { return mDynamicOffsetCount; }
+
 protected:
     virtual Result Create(const grfx::DescriptorSetLayoutCreateInfo* pCreateInfo) override;
     friend class grfx::Device;
+
+private:
+    uint32_t mDynamicOffsetCount = 0;
 };
 
 } // namespace grfx
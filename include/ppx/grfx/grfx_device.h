@@ -34,21 +34,66 @@
 #include "ppx/grfx/grfx_text_draw.h"
 #include "ppx/grfx/grfx_texture.h"
 
+#include <mutex>
+#include <unordered_map>
+
 namespace ppx {
 namespace grfx {
 
+//! @struct MemoryCategoryStatistics
+//!
+//! Buffers and images currently alive with a given grfx::MemoryCategory.
+//!
+struct MemoryCategoryStatistics
+{
+    uint32_t allocationCount     = 0;
+    uint64_t allocationBytes     = 0;
+    uint64_t peakAllocationBytes = 0; // Highest allocationBytes since the device was created
+};
+
+//! @struct MemoryHeapStatistics
+//!
+//! A memory heap as reported by VMA or D3D12MA. usageBytes is what the
+//! whole process uses, including memory allocated outside of grfx, and
+//! budgetBytes is how much the OS currently lets the process use before
+//! allocations start failing or getting evicted. blockBytes versus
+//! allocationBytes shows how much of the allocator's memory is unused.
+//!
+struct MemoryHeapStatistics
+{
+    bool     deviceLocal     = false;
+    uint64_t usageBytes      = 0;
+    uint64_t budgetBytes     = 0;
+    uint64_t blockBytes      = 0; // Memory the allocator owns
+    uint64_t allocationBytes = 0; // Memory handed out to resources
+};
+
+//! @struct MemoryStatistics
+//!
+//!
+struct MemoryStatistics
+{
+    std::vector<grfx::MemoryHeapStatistics> heaps;
+    grfx::MemoryCategoryStatistics          categories[grfx::MEMORY_CATEGORY_COUNT] = {};
+
+    uint64_t GetDeviceLocalUsageBytes() const;
+    uint64_t GetDeviceLocalBudgetBytes() const;
+    uint64_t GetCategoryAllocationBytes() const;
+};
+
 //! @struct DeviceCreateInfo
 //!
 //!
 struct DeviceCreateInfo
 {
-    grfx::Gpu*               pGpu                   = nullptr;
-    uint32_t                 graphicsQueueCount     = 0;
-    uint32_t                 computeQueueCount      = 0;
-    uint32_t                 transferQueueCount     = 0;
-    std::vector<std::string> vulkanExtensions       = {};      // [OPTIONAL] Additional device extensions
-    const void*              pVulkanDeviceFeatures  = nullptr; // [OPTIONAL] Pointer to custom VkPhysicalDeviceFeatures
-    ShadingRateMode          supportShadingRateMode = SHADING_RATE_NONE;
+    grfx::Gpu*               pGpu                          = nullptr;
+    uint32_t                 graphicsQueueCount            = 0;
+    uint32_t                 computeQueueCount             = 0;
+    uint32_t                 transferQueueCount            = 0;
+    std::vector<std::string> vulkanExtensions              = {};      // [OPTIONAL] Additional device extensions
+    const void*              pVulkanDeviceFeatures         = nullptr; // [OPTIONAL] Pointer to custom VkPhysicalDeviceFeatures
+    ShadingRateMode          supportShadingRateMode        = SHADING_RATE_NONE;
+    bool                     enableRedundantStateFiltering = false; // [OPTIONAL] Drop redundant binds, see grfx::CommandBuffer
 #if defined(PPX_BUILD_XR)
     XrComponent* pXrComponent = nullptr;
 #endif
@@ -112,6 +157,9 @@ public:
     Result CreateImage(const grfx::ImageCreateInfo* pCreateInfo, grfx::Image** ppImage);
     void   DestroyImage(const grfx::Image* pImage);
 
+    Result CreateMemoryPool(const grfx::MemoryPoolCreateInfo* pCreateInfo, grfx::MemoryPool** ppMemoryPool);
+    void   DestroyMemoryPool(const grfx::MemoryPool* pMemoryPool);
+
     Result CreateMesh(const grfx::MeshCreateInfo* pCreateInfo, grfx::Mesh** ppMesh);
     void   DestroyMesh(const grfx::Mesh* pMesh);
 
@@ -141,6 +189,15 @@ public:
     Result CreateShaderModule(const grfx::ShaderModuleCreateInfo* pCreateInfo, grfx::ShaderModule** ppShaderModule);
     void   DestroyShaderModule(const grfx::ShaderModule* pShaderModule);
 
+    // Returns the module already created from the same bytecode, looked up
+    // by the XXH64 hash of the bytecode and compared byte for byte, or
+    // creates it. Each call adds a reference that DestroyShaderModule()
+    // releases, the module is destroyed with its last reference.
+    // GetShaderModuleReferenceCount() returns 0 for modules that have been
+    // destroyed.
+    Result   AcquireShaderModule(const grfx::ShaderModuleCreateInfo* pCreateInfo, grfx::ShaderModule** ppShaderModule);
+    uint32_t GetShaderModuleReferenceCount(const grfx::ShaderModule* pShaderModule) const;
+
     Result CreateStorageImageView(const grfx::StorageImageViewCreateInfo* pCreateInfo, grfx::StorageImageView** ppStorageImageView);
     void   DestroyStorageImageView(const grfx::StorageImageView* pStorageImageView);
 
@@ -185,6 +242,18 @@ public:
 
     const grfx::ShadingRateCapabilities& GetShadingRateCapabilities() const { return mShadingRateCapabilities; }
 
+    bool IsRedundantStateFilteringEnabled() const { return mCreateInfo.enableRedundantStateFiltering; }
+
+    // Totals over command buffers ended since the last reset. Applications
+    // typically read and reset these once per frame.
+    grfx::CommandBufferStatistics GetCommandBufferStatistics() const;
+    void                          ResetCommandBufferStatistics();
+    void                          AccumulateCommandBufferStatistics(const grfx::CommandBufferStatistics& statistics);
+
+    // Heaps come from the API allocator and categories from the buffers
+    // and images created on this device. Cheap enough to call every frame.
+    grfx::MemoryStatistics GetMemoryStatistics() const;
+
     virtual Result WaitIdle() = 0;
 
     virtual bool PipelineStatsAvailable() const            = 0;
@@ -208,6 +277,7 @@ protected:
     virtual Result AllocateObject(grfx::Fence** ppObject)               = 0;
     virtual Result AllocateObject(grfx::GraphicsPipeline** ppObject)    = 0;
     virtual Result AllocateObject(grfx::Image** ppObject)               = 0;
+    virtual Result AllocateObject(grfx::MemoryPool** ppObject)          = 0;
     virtual Result AllocateObject(grfx::PipelineInterface** ppObject)   = 0;
     virtual Result AllocateObject(grfx::Queue** ppObject)               = 0;
     virtual Result AllocateObject(grfx::Query** ppObject)               = 0;
@@ -229,6 +299,9 @@ protected:
     virtual Result AllocateObject(grfx::Texture** ppObject);
     virtual Result AllocateObject(grfx::TextureFont** ppObject);
 
+    // Fills pStatistics->heaps, categories are already filled in
+    virtual void GetMemoryHeapStatistics(grfx::MemoryStatistics* pStatistics) const = 0;
+
     template <
         typename ObjectT,
         typename CreateInfoT,
@@ -263,6 +336,7 @@ protected:
     std::vector<grfx::FullscreenQuadPtr>      mFullscreenQuads;
     std::vector<grfx::GraphicsPipelinePtr>    mGraphicsPipelines;
     std::vector<grfx::ImagePtr>               mImages;
+    std::vector<grfx::MemoryPoolPtr>          mMemoryPools;
     std::vector<grfx::MeshPtr>                mMeshes;
     std::vector<grfx::PipelineInterfacePtr>   mPipelineInterfaces;
     std::vector<grfx::QueryPtr>               mQuerys;
@@ -282,6 +356,24 @@ protected:
     std::vector<grfx::QueuePtr>               mComputeQueues;
     std::vector<grfx::QueuePtr>               mTransferQueues;
     grfx::ShadingRateCapabilities             mShadingRateCapabilities;
+
+private:
+    void TrackMemory(grfx::MemoryCategory category, uint64_t allocationBytes, bool allocated);
+
+private:
+    struct SharedShaderModule
+    {
+        grfx::ShaderModule* pShaderModule  = nullptr;
+        uint32_t            referenceCount = 0;
+        std::vector<char>   code; // Compared on lookup to rule out hash collisions
+    };
+
+    std::unordered_map<uint64_t, SharedShaderModule> mSharedShaderModules; // Keyed by bytecode hash
+
+    mutable std::mutex             mCommandBufferStatisticsMutex;
+    grfx::CommandBufferStatistics  mCommandBufferStatistics = {};
+    mutable std::mutex             mMemoryStatisticsMutex;
+    grfx::MemoryCategoryStatistics mMemoryCategories[grfx::MEMORY_CATEGORY_COUNT] = {};
 };
 
 } // namespace grfx
@@ -26,6 +26,7 @@ enum Api
     API_VK_1_3    = (1 << 16) | (3 << 0),
     API_DX_12_0   = (12 << 16) | (0 << 0),
     API_DX_12_1   = (12 << 16) | (1 << 0),
+    API_NULL      = (255 << 16) | (0 << 0), // No GPU, commands are validated and dropped
 };
 
 enum AttachmentLoadOp
@@ -343,6 +344,34 @@ enum MemoryUsage
     MEMORY_USAGE_GPU_TO_CPU = 4,
 };
 
+//
+// Tags buffer and image allocations for grfx::Device::GetMemoryStatistics().
+// MEMORY_CATEGORY_UNDEFINED is resolved from the usage flags and memory
+// usage when the resource is created.
+//
+enum MemoryCategory
+{
+    MEMORY_CATEGORY_UNDEFINED     = 0,
+    MEMORY_CATEGORY_TEXTURE       = 1,
+    MEMORY_CATEGORY_MESH          = 2,
+    MEMORY_CATEGORY_RENDER_TARGET = 3,
+    MEMORY_CATEGORY_STAGING       = 4,
+    MEMORY_CATEGORY_OTHER         = 5,
+    MEMORY_CATEGORY_COUNT,
+};
+
+//
+// Allocation strategy of a grfx::MemoryPool. DEFAULT is a general purpose
+// allocator (TLSF in VMA and D3D12MA) that frees in any order. LINEAR
+// only appends, freeing in creation order turns it into a ring buffer;
+// it suits data rewritten every frame.
+//
+enum MemoryPoolAlgorithm
+{
+    MEMORY_POOL_ALGORITHM_DEFAULT = 0,
+    MEMORY_POOL_ALGORITHM_LINEAR  = 1,
+};
+
 //
 // VK: Maps to top/bottom of pipeline stages for timestamp queries.
 // DX: Maps to begin/end for timestamp queries.
@@ -39,8 +39,10 @@ struct ImageCreateInfo
     grfx::RenderTargetClearValue RTVClearValue             = {0, 0, 0, 0};                 // Optimized RTV clear value
     grfx::DepthStencilClearValue DSVClearValue             = {1.0f, 0xFF};                 // Optimized DSV clear value
     void*                        pApiObject                = nullptr;                      // [OPTIONAL] For external images such as swapchain images
+    const grfx::Image*           pMemoryAliasImage         = nullptr;                      // [OPTIONAL] Place the image in this image's memory instead of allocating
     grfx::Ownership              ownership                 = grfx::OWNERSHIP_REFERENCE;
     bool                         concurrentMultiQueueUsage = false;
+    grfx::MemoryCategory         memoryCategory            = grfx::MEMORY_CATEGORY_UNDEFINED; // [OPTIONAL] Inferred from usage if undefined
 
     // Returns a create info for sampled image
     static ImageCreateInfo SampledImage2D(
@@ -89,16 +91,41 @@ public:
     const grfx::RenderTargetClearValue& GetRTVClearValue() const { return mCreateInfo.RTVClearValue; }
     const grfx::DepthStencilClearValue& GetDSVClearValue() const { return mCreateInfo.DSVClearValue; }
     bool                                GetConcurrentMultiQueueUsageEnabled() const { return mCreateInfo.concurrentMultiQueueUsage; }
+    const grfx::Image*                  GetMemoryAliasImage() const { return mCreateInfo.pMemoryAliasImage; }
+    grfx::MemoryCategory                GetMemoryCategory() const { return mCreateInfo.memoryCategory; }
+
+    // Bytes the API allocated for the image. Zero for external images and
+    // images placed in another image's memory.
+    uint64_t GetAllocationSize() const { return mAllocationSize; }
 
     // Convenience functions
     grfx::ImageViewType GuessImageViewType(bool isCube = false) const;
 
+    // State left by the most recently recorded transition of the
+    // subresource, see grfx::CommandBuffer::TransitionImageLayout.
+    grfx::ResourceState GetSubresourceState(uint32_t mipLevel, uint32_t arrayLayer) const;
+
     virtual Result MapMemory(uint64_t offset, void** ppMappedAddress) = 0;
     virtual void   UnmapMemory()                                      = 0;
 
 protected:
     virtual Result Create(const grfx::ImageCreateInfo* pCreateInfo) override;
     friend class grfx::Device;
+
+protected:
+    uint64_t mAllocationSize = 0; // Set by the API object
+
+private:
+    void SetSubresourceState(
+        uint32_t            mipLevel,
+        uint32_t            mipLevelCount,
+        uint32_t            arrayLayer,
+        uint32_t            arrayLayerCount,
+        grfx::ResourceState state);
+    friend class grfx::CommandBuffer;
+
+    // Indexed by arrayLayer * mipLevelCount + mipLevel
+    std::vector<grfx::ResourceState> mSubresourceStates;
 };
 
 // -------------------------------------------------------------------------------------------------
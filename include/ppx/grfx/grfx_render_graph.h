@@ -0,0 +1,214 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_render_graph_h
+#define ppx_grfx_render_graph_h
+
+#include "ppx/grfx/grfx_config.h"
+
+namespace ppx {
+namespace grfx {
+
+class RenderGraph;
+
+//! @struct RenderGraphImage
+//!
+//! Handle to an image declared on a grfx::RenderGraph.
+//!
+struct RenderGraphImage
+{
+    uint32_t index = UINT32_MAX;
+
+    bool IsValid() const { return index != UINT32_MAX; }
+};
+
+//! @struct RenderGraphImageCreateInfo
+//!
+//! Describes a transient image. The graph adds the usage flags implied by
+//! the states the passes access the image in.
+//!
+struct RenderGraphImageCreateInfo
+{
+    uint32_t                     width           = 0;
+    uint32_t                     height          = 0;
+    grfx::Format                 format          = grfx::FORMAT_UNDEFINED;
+    grfx::SampleCount            sampleCount     = grfx::SAMPLE_COUNT_1;
+    uint32_t                     mipLevelCount   = 1;
+    uint32_t                     arrayLayerCount = 1;
+    grfx::ImageUsageFlags        usageFlags      = {};
+    grfx::RenderTargetClearValue RTVClearValue   = {0, 0, 0, 0};
+    grfx::DepthStencilClearValue DSVClearValue   = {1.0f, 0xFF};
+};
+
+//! @struct RenderGraphImageAccess
+//!
+//! An image a pass accesses and the state it needs it in.
+//!
+struct RenderGraphImageAccess
+{
+    grfx::RenderGraphImage image = {};
+    grfx::ResourceState    state = grfx::RESOURCE_STATE_SHADER_RESOURCE;
+};
+
+// Records a pass, images are looked up with grfx::RenderGraph::GetImage()
+using RenderGraphExecuteFn = std::function<void(grfx::CommandBuffer* pCommandBuffer, const grfx::RenderGraph& graph)>;
+
+//! @struct RenderGraphPassCreateInfo
+//!
+//! A pass with render targets or a depth stencil is a raster pass: the
+//! graph begins a render pass on a grfx::DrawPass over the attachments
+//! and sets the viewport and scissor before calling \b execute. Any other
+//! pass only gets its barriers before \b execute.
+//!
+//! \b reads and \b writes list every other image the pass accesses and
+//! the state it needs them in. Attachments that aren't cleared count as
+//! reads as well as writes.
+//!
+//! A pass is culled if nothing it writes is read by a later live pass or
+//! is an imported image, unless \b hasSideEffects is set.
+//!
+struct RenderGraphPassCreateInfo
+{
+    std::string                               name;
+    uint32_t                                  renderTargetCount                     = 0;
+    grfx::RenderGraphImage                    renderTargets[PPX_MAX_RENDER_TARGETS] = {};
+    grfx::RenderGraphImage                    depthStencil                          = {};
+    grfx::ResourceState                       depthStencilState                     = grfx::RESOURCE_STATE_DEPTH_STENCIL_WRITE;
+    grfx::DrawPassClearFlags                  clearFlags                            = grfx::DRAW_PASS_CLEAR_FLAG_CLEAR_ALL;
+    std::vector<grfx::RenderGraphImageAccess> reads;
+    std::vector<grfx::RenderGraphImageAccess> writes;
+    bool                                      hasSideEffects = false;
+    grfx::RenderGraphExecuteFn                execute;
+};
+
+//! @struct RenderGraphStatistics
+//!
+//! Memory sizes are estimates from format, extent, sample count, mip
+//! levels and array layers, they don't include API alignment.
+//!
+struct RenderGraphStatistics
+{
+    uint32_t passCount           = 0;
+    uint32_t culledPassCount     = 0;
+    uint32_t transientImageCount = 0; // Transient images used by live passes
+    uint32_t aliasedImageCount   = 0; // Transient images placed in another image's memory
+    uint64_t transientMemorySize = 0; // Without aliasing
+    uint64_t allocatedMemorySize = 0; // With aliasing
+};
+
+//! @class RenderGraph
+//!
+//! Frame graph over grfx::DrawPass. Images are either imported (owned by
+//! the caller, kept across frames) or transient (created by the graph,
+//! contents only valid between the first and last pass that uses them).
+//!
+//! Usage:
+//!   1. Declare images with ImportImage() and CreateImage().
+//!   2. Declare passes with AddPass() in execution order.
+//!   3. Compile() culls passes, creates transient images and draw passes.
+//!   4. Execute() records the live passes each frame.
+//!
+//! Transient images whose lifetimes don't overlap share memory (see
+//! grfx::ImageCreateInfo::pMemoryAliasImage). Only images of the same
+//! kind (color attachment, depth stencil, other) share memory, which
+//! keeps D3D12 resource heap tier 1 hardware working. If an image
+//! doesn't fit in the memory it was assigned, it gets its own memory.
+//!
+//! Barriers are derived from the states passes declare, using the state
+//! tracking in grfx::CommandBuffer, so they batch per pass.
+//!
+//! Call Reset() to declare a new graph, for example after a resize.
+//!
+class RenderGraph
+{
+public:
+    RenderGraph(grfx::Device* pDevice);
+    ~RenderGraph();
+
+    RenderGraph(const RenderGraph&)            = delete;
+    RenderGraph& operator=(const RenderGraph&) = delete;
+
+    // Images that outlive the graph. If finalState is not
+    // RESOURCE_STATE_UNDEFINED the image is transitioned to it at the end
+    // of Execute().
+    grfx::RenderGraphImage ImportImage(
+        grfx::Image*        pImage,
+        grfx::ResourceState finalState = grfx::RESOURCE_STATE_UNDEFINED);
+
+    grfx::RenderGraphImage CreateImage(const grfx::RenderGraphImageCreateInfo& createInfo);
+
+    Result AddPass(const grfx::RenderGraphPassCreateInfo& createInfo);
+
+    Result Compile(bool enableAliasing = true);
+    Result Execute(grfx::CommandBuffer* pCommandBuffer) const;
+
+    // Destroys everything the graph created and forgets all declarations
+    void Reset();
+
+    bool IsCompiled() const { return mCompiled; }
+    bool IsPassCulled(uint32_t passIndex) const;
+
+    // Valid after Compile(). Transient images only used by culled
+    // passes are never created and return nullptr.
+    grfx::Image*   GetImage(grfx::RenderGraphImage image) const;
+    grfx::Texture* GetTexture(grfx::RenderGraphImage image) const;
+
+    // Transient image whose memory image shares, or nullptr
+    grfx::Image* GetMemoryAliasImage(grfx::RenderGraphImage image) const;
+
+    const grfx::RenderGraphStatistics& GetStatistics() const { return mStatistics; }
+
+private:
+    struct ImageEntry
+    {
+        bool                             imported = false;
+        grfx::ImagePtr                   image;
+        grfx::ResourceState              finalState = grfx::RESOURCE_STATE_UNDEFINED;
+        grfx::RenderGraphImageCreateInfo createInfo = {};
+        grfx::ImageUsageFlags            usageFlags = {};
+        grfx::TexturePtr                 texture;
+        grfx::ImagePtr                   memoryAliasImage;
+        bool                             sharesMemory = false; // Contents don't survive to the next frame
+        uint32_t                         firstPass    = UINT32_MAX;
+        uint32_t                         lastPass     = 0;
+    };
+
+    struct PassEntry
+    {
+        grfx::RenderGraphPassCreateInfo           createInfo;
+        std::vector<grfx::RenderGraphImageAccess> accesses; // Attachments, reads and writes
+        std::vector<uint32_t>                     readImages;
+        std::vector<uint32_t>                     writtenImages;
+        bool                                      culled = false;
+        grfx::DrawPassPtr                         drawPass;
+    };
+
+    void   CullPasses();
+    void   ComputeLifetimes();
+    Result CreateTransientImages(bool enableAliasing);
+    Result CreateTextures();
+    Result CreateDrawPasses();
+
+private:
+    grfx::DevicePtr             mDevice;
+    std::vector<ImageEntry>     mImages;
+    std::vector<PassEntry>      mPasses;
+    bool                        mCompiled   = false;
+    grfx::RenderGraphStatistics mStatistics = {};
+};
+
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_render_graph_h
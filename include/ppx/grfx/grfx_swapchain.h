@@ -147,6 +147,9 @@ public:
         grfx::Fence*     pFence,     // Wait fence
         uint32_t*        pImageIndex);
 
+    // Headless swapchains wait for ppWaitSemaphores when imageIndex is next
+    // acquired. Like with a real present, keep one set of semaphores per
+    // image and don't signal them again before the image is reacquired.
     Result Present(
         uint32_t                      imageIndex,
         uint32_t                      waitSemaphoreCount,
@@ -209,7 +212,9 @@ private:
         uint32_t                      waitSemaphoreCount,
         const grfx::Semaphore* const* ppWaitSemaphores);
 
-    std::vector<grfx::CommandBufferPtr> mHeadlessCommandBuffers;
+    // Semaphores passed to the last headless Present() of each image, the
+    // next acquire of that image waits for them
+    std::vector<std::vector<const grfx::Semaphore*>> mHeadlessWaitSemaphores;
 
 protected:
     grfx::QueuePtr                         mQueue;
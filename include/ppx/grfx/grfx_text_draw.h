@@ -125,6 +125,9 @@ protected:
     virtual Result CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo) override;
     virtual void   DestroyApiObjects() override;
 
+private:
+    ppx::Result FlushCpuBuffers();
+
 private:
     uint32_t                     mTextLength = 0;
     grfx::BufferPtr              mCpuIndexBuffer;
@@ -24,6 +24,7 @@ namespace ppx {
 namespace grfx {
 
 const char* ToString(grfx::Api value);
+const char* ToString(grfx::MemoryCategory value);
 const char* ToString(grfx::DescriptorType value);
 const char* ToString(grfx::VertexSemantic value);
 
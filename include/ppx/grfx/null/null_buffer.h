@@ -0,0 +1,93 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_buffer_h
+#define ppx_grfx_null_buffer_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_buffer.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+//! @class MemoryPool
+//!
+//! Only counts: blocks are added as the pooled bytes need them, ignoring
+//! fragmentation and alignment. Allocations larger than a block, or that
+//! would need more than maxBlockCount blocks, fail like they would on a
+//! real allocator.
+//!
+class MemoryPool
+    : public grfx::MemoryPool
+{
+public:
+    MemoryPool() {}
+    virtual ~MemoryPool() {}
+
+    virtual grfx::MemoryPoolStatistics GetStatistics() const override;
+
+    Result Allocate(uint64_t size);
+    void   Free(uint64_t size);
+
+protected:
+    virtual Result CreateApiObjects(const grfx::MemoryPoolCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    uint32_t GetBlockCount(uint64_t allocationBytes) const;
+
+private:
+    uint64_t mBlockSize       = 0;
+    uint32_t mAllocationCount = 0;
+    uint64_t mAllocationBytes = 0;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! @class Buffer
+//!
+//! Host memory for the buffer is only allocated the first time the buffer is
+//! mapped, or at creation for persistently mapped buffers, so GPU only
+//! buffers cost nothing. Commands never read or write
+//! buffer contents.
+//!
+class Buffer
+    : public grfx::Buffer,
+      public null::HandleTrait
+{
+public:
+    Buffer() {}
+    virtual ~Buffer() {}
+
+    virtual Result MapMemory(uint64_t offset, void** ppMappedAddress) override;
+    virtual void   UnmapMemory() override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    virtual Result FlushRangeImpl(uint64_t offset, uint64_t size) override;
+    virtual Result InvalidateRangeImpl(uint64_t offset, uint64_t size) override;
+
+private:
+    std::vector<char> mMemory;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_buffer_h
@@ -0,0 +1,306 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_command_buffer_h
+#define ppx_grfx_null_command_buffer_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_command.h"
+
+#include <initializer_list>
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+enum CommandOp
+{
+    COMMAND_OP_UNDEFINED = 0,
+    COMMAND_OP_BEGIN_RENDER_PASS,
+    COMMAND_OP_END_RENDER_PASS,
+    COMMAND_OP_BEGIN_RENDERING,
+    COMMAND_OP_END_RENDERING,
+    COMMAND_OP_PUSH_DESCRIPTOR,
+    COMMAND_OP_CLEAR_RENDER_TARGET,
+    COMMAND_OP_CLEAR_DEPTH_STENCIL,
+    COMMAND_OP_PIPELINE_BARRIER,
+    COMMAND_OP_SET_VIEWPORTS,
+    COMMAND_OP_SET_SCISSORS,
+    COMMAND_OP_BIND_GRAPHICS_DESCRIPTOR_SETS,
+    COMMAND_OP_PUSH_GRAPHICS_CONSTANTS,
+    COMMAND_OP_BIND_GRAPHICS_PIPELINE,
+    COMMAND_OP_BIND_COMPUTE_DESCRIPTOR_SETS,
+    COMMAND_OP_PUSH_COMPUTE_CONSTANTS,
+    COMMAND_OP_BIND_COMPUTE_PIPELINE,
+    COMMAND_OP_BIND_INDEX_BUFFER,
+    COMMAND_OP_BIND_VERTEX_BUFFERS,
+    COMMAND_OP_DRAW,
+    COMMAND_OP_DRAW_INDEXED,
+    COMMAND_OP_DISPATCH,
+    COMMAND_OP_COPY_BUFFER_TO_BUFFER,
+    COMMAND_OP_COPY_BUFFER_TO_IMAGE,
+    COMMAND_OP_COPY_IMAGE_TO_BUFFER,
+    COMMAND_OP_COPY_IMAGE_TO_IMAGE,
+    COMMAND_OP_BEGIN_QUERY,
+    COMMAND_OP_END_QUERY,
+    COMMAND_OP_WRITE_TIMESTAMP,
+    COMMAND_OP_RESOLVE_QUERY_DATA,
+    COMMAND_OP_COUNT,
+};
+
+//! @class CommandStream
+//!
+//! Flat encoding of recorded commands. Each command is a header word
+//! holding the op in the low 16 bits and the argument count in the high
+//! 16 bits, followed by that many 32-bit arguments. Objects are encoded
+//! by their null handle and 64-bit values are split into two words, low
+//! word first.
+//!
+class CommandStream
+{
+public:
+    struct Command
+    {
+        grfx::null::CommandOp op       = COMMAND_OP_UNDEFINED;
+        uint32_t              argCount = 0;
+        const uint32_t*       pArgs    = nullptr;
+    };
+
+    CommandStream() {}
+    ~CommandStream() {}
+
+    void Clear();
+
+    void      Write(grfx::null::CommandOp op, std::initializer_list<uint32_t> args);
+    uint32_t* Write(grfx::null::CommandOp op, uint32_t argCount);
+
+    uint32_t                     GetCommandCount() const { return mCommandCount; }
+    uint32_t                     GetCommandCount(grfx::null::CommandOp op) const { return mOpCounts[op]; }
+    const std::vector<uint32_t>& GetWords() const { return mWords; }
+
+    // Reads the command at *pOffset and advances *pOffset past it. Returns
+    // false once the end of the stream is reached.
+    bool Read(size_t* pOffset, Command* pCommand) const;
+
+private:
+    std::vector<uint32_t> mWords;
+    uint32_t              mCommandCount               = 0;
+    uint32_t              mOpCounts[COMMAND_OP_COUNT] = {};
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! @class CommandBuffer
+//!
+//! Commands are validated by grfx::CommandBuffer and then dropped. If
+//! command recording is enabled on the device when Begin() is called,
+//! they are also encoded into a CommandStream so tests can inspect what
+//! a frame would have submitted.
+//!
+class CommandBuffer
+    : public grfx::CommandBuffer
+{
+public:
+    CommandBuffer() {}
+    virtual ~CommandBuffer() {}
+
+    const grfx::null::CommandStream& GetCommandStream() const { return mCommandStream; }
+    bool                             IsRecording() const { return mRecording; }
+
+private:
+    virtual void BeginRenderPassImpl(const grfx::RenderPassBeginInfo* pBeginInfo) override;
+    virtual void EndRenderPassImpl() override;
+
+    virtual void BeginRenderingImpl(const grfx::RenderingInfo* pRenderingInfo) override;
+    virtual void EndRenderingImpl() override;
+
+    virtual void PushDescriptorImpl(
+        grfx::CommandType              pipelineBindPoint,
+        const grfx::PipelineInterface* pInterface,
+        grfx::DescriptorType           descriptorType,
+        uint32_t                       binding,
+        uint32_t                       set,
+        uint32_t                       bufferOffset,
+        const grfx::Buffer*            pBuffer,
+        const grfx::SampledImageView*  pSampledImageView,
+        const grfx::StorageImageView*  pStorageImageView,
+        const grfx::Sampler*           pSampler) override;
+
+    virtual Result BeginImpl() override;
+    virtual Result EndImpl() override;
+
+    virtual void SetViewportsImpl(
+        uint32_t              viewportCount,
+        const grfx::Viewport* pViewports) override;
+
+    virtual void SetScissorsImpl(
+        uint32_t          scissorCount,
+        const grfx::Rect* pScissors) override;
+
+    virtual void BindGraphicsDescriptorSetsImpl(
+        const grfx::PipelineInterface*    pInterface,
+        uint32_t                          setCount,
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount,
+        const uint32_t*                   pDynamicOffsets) override;
+
+    virtual void BindGraphicsPipelineImpl(const grfx::GraphicsPipeline* pPipeline) override;
+
+    virtual void BindIndexBufferImpl(const grfx::IndexBufferView* pView) override;
+
+    virtual void BindVertexBuffersImpl(
+        uint32_t                      viewCount,
+        const grfx::VertexBufferView* pViews) override;
+
+    virtual void PipelineBarrierImpl(
+        uint32_t                   imageBarrierCount,
+        const grfx::ImageBarrier*  pImageBarriers,
+        uint32_t                   bufferBarrierCount,
+        const grfx::BufferBarrier* pBufferBarriers) override;
+
+public:
+    virtual void ClearRenderTarget(
+        grfx::Image*                        pImage,
+        const grfx::RenderTargetClearValue& clearValue) override;
+    virtual void ClearDepthStencil(
+        grfx::Image*                        pImage,
+        const grfx::DepthStencilClearValue& clearValue,
+        uint32_t                            clearFlags) override;
+
+    virtual void PushGraphicsConstants(
+        const grfx::PipelineInterface* pInterface,
+        uint32_t                       count,
+        const void*                    pValues,
+        uint32_t                       dstOffset) override;
+
+    virtual void BindComputeDescriptorSets(
+        const grfx::PipelineInterface*    pInterface,
+        uint32_t                          setCount,
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount = 0,
+        const uint32_t*                   pDynamicOffsets    = nullptr) override;
+
+    virtual void PushComputeConstants(
+        const grfx::PipelineInterface* pInterface,
+        uint32_t                       count,
+        const void*                    pValues,
+        uint32_t                       dstOffset) override;
+
+    virtual void BindComputePipeline(const grfx::ComputePipeline* pPipeline) override;
+
+    virtual void Draw(
+        uint32_t vertexCount,
+        uint32_t instanceCount,
+        uint32_t firstVertex,
+        uint32_t firstInstance) override;
+
+    virtual void DrawIndexed(
+        uint32_t indexCount,
+        uint32_t instanceCount,
+        uint32_t firstIndex,
+        int32_t  vertexOffset,
+        uint32_t firstInstance) override;
+
+    virtual void Dispatch(
+        uint32_t groupCountX,
+        uint32_t groupCountY,
+        uint32_t groupCountZ) override;
+
+    virtual void CopyBufferToBuffer(
+        const grfx::BufferToBufferCopyInfo* pCopyInfo,
+        grfx::Buffer*                       pSrcBuffer,
+        grfx::Buffer*                       pDstBuffer) override;
+
+    virtual void CopyBufferToImage(
+        const std::vector<grfx::BufferToImageCopyInfo>& pCopyInfos,
+        grfx::Buffer*                                   pSrcBuffer,
+        grfx::Image*                                    pDstImage) override;
+
+    virtual void CopyBufferToImage(
+        const grfx::BufferToImageCopyInfo* pCopyInfo,
+        grfx::Buffer*                      pSrcBuffer,
+        grfx::Image*                       pDstImage) override;
+
+    virtual grfx::ImageToBufferOutputPitch CopyImageToBuffer(
+        const grfx::ImageToBufferCopyInfo* pCopyInfo,
+        grfx::Image*                       pSrcImage,
+        grfx::Buffer*                      pDstBuffer) override;
+
+    virtual void CopyImageToImage(
+        const grfx::ImageToImageCopyInfo* pCopyInfo,
+        grfx::Image*                      pSrcImage,
+        grfx::Image*                      pDstImage) override;
+
+    virtual void BeginQuery(
+        const grfx::Query* pQuery,
+        uint32_t           queryIndex) override;
+
+    virtual void EndQuery(
+        const grfx::Query* pQuery,
+        uint32_t           queryIndex) override;
+
+    virtual void WriteTimestamp(
+        const grfx::Query*  pQuery,
+        grfx::PipelineStage pipelineStage,
+        uint32_t            queryIndex) override;
+
+    virtual void ResolveQueryData(
+        grfx::Query* pQuery,
+        uint32_t     startIndex,
+        uint32_t     numQueries) override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::internal::CommandBufferCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    void BindDescriptorSets(
+        grfx::null::CommandOp             op,
+        const grfx::PipelineInterface*    pInterface,
+        uint32_t                          setCount,
+        const grfx::DescriptorSet* const* ppSets,
+        uint32_t                          dynamicOffsetCount,
+        const uint32_t*                   pDynamicOffsets);
+
+    void PushConstants(
+        grfx::null::CommandOp          op,
+        const grfx::PipelineInterface* pInterface,
+        uint32_t                       count,
+        const void*                    pValues,
+        uint32_t                       dstOffset);
+
+private:
+    grfx::null::CommandStream mCommandStream;
+    bool                      mRecording = false;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class CommandPool
+    : public grfx::CommandPool
+{
+public:
+    CommandPool() {}
+    virtual ~CommandPool() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::CommandPoolCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_command_buffer_h
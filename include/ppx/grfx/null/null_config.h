@@ -0,0 +1,308 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_config_h
+#define ppx_grfx_null_config_h
+
+#include "ppx/grfx/grfx_config.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+class Buffer;
+class CommandBuffer;
+class CommandPool;
+class ComputePipeline;
+class DepthStencilView;
+class DescriptorPool;
+class DescriptorSet;
+class DescriptorSetLayout;
+class Device;
+class Fence;
+class Gpu;
+class GraphicsPipeline;
+class Image;
+class Instance;
+class MemoryPool;
+class PipelineInterface;
+class Queue;
+class Query;
+class RenderPass;
+class RenderTargetView;
+class SampledImageView;
+class Sampler;
+class Semaphore;
+class ShaderModule;
+class StorageImageView;
+class Surface;
+class Swapchain;
+
+// -------------------------------------------------------------------------------------------------
+
+//! @class HandleTrait
+//!
+//! Null objects have no API object behind them. Objects that can be
+//! referenced by commands get a small, device unique handle instead so
+//! recorded command streams can identify them. Handles are assigned in
+//! creation order starting at 1; 0 is never a valid handle.
+//!
+class HandleTrait
+{
+public:
+    HandleTrait() {}
+    virtual ~HandleTrait() {}
+
+    uint32_t GetNullHandle() const { return mNullHandle; }
+
+protected:
+    void AllocateNullHandle(grfx::Device* pDevice);
+
+private:
+    uint32_t mNullHandle = 0;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+template <typename GrfxTypeT>
+struct ApiObjectLookUp
+{
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Buffer>
+{
+    using GrfxType = grfx::Buffer;
+    using ApiType  = null::Buffer;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::CommandBuffer>
+{
+    using GrfxType = grfx::CommandBuffer;
+    using ApiType  = null::CommandBuffer;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::CommandPool>
+{
+    using GrfxType = grfx::CommandPool;
+    using ApiType  = null::CommandPool;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::ComputePipeline>
+{
+    using GrfxType = grfx::ComputePipeline;
+    using ApiType  = null::ComputePipeline;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::DepthStencilView>
+{
+    using GrfxType = grfx::DepthStencilView;
+    using ApiType  = null::DepthStencilView;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::DescriptorPool>
+{
+    using GrfxType = grfx::DescriptorPool;
+    using ApiType  = null::DescriptorPool;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::DescriptorSet>
+{
+    using GrfxType = grfx::DescriptorSet;
+    using ApiType  = null::DescriptorSet;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::DescriptorSetLayout>
+{
+    using GrfxType = grfx::DescriptorSetLayout;
+    using ApiType  = null::DescriptorSetLayout;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Device>
+{
+    using GrfxType = grfx::Device;
+    using ApiType  = null::Device;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Fence>
+{
+    using GrfxType = grfx::Fence;
+    using ApiType  = null::Fence;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Gpu>
+{
+    using GrfxType = grfx::Gpu;
+    using ApiType  = null::Gpu;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::GraphicsPipeline>
+{
+    using GrfxType = grfx::GraphicsPipeline;
+    using ApiType  = null::GraphicsPipeline;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Image>
+{
+    using GrfxType = grfx::Image;
+    using ApiType  = null::Image;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::MemoryPool>
+{
+    using GrfxType = grfx::MemoryPool;
+    using ApiType  = null::MemoryPool;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Instance>
+{
+    using GrfxType = grfx::Instance;
+    using ApiType  = null::Instance;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::PipelineInterface>
+{
+    using GrfxType = grfx::PipelineInterface;
+    using ApiType  = null::PipelineInterface;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Queue>
+{
+    using GrfxType = grfx::Queue;
+    using ApiType  = null::Queue;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Query>
+{
+    using GrfxType = grfx::Query;
+    using ApiType  = null::Query;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::RenderPass>
+{
+    using GrfxType = grfx::RenderPass;
+    using ApiType  = null::RenderPass;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::RenderTargetView>
+{
+    using GrfxType = grfx::RenderTargetView;
+    using ApiType  = null::RenderTargetView;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::SampledImageView>
+{
+    using GrfxType = grfx::SampledImageView;
+    using ApiType  = null::SampledImageView;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Sampler>
+{
+    using GrfxType = grfx::Sampler;
+    using ApiType  = null::Sampler;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Semaphore>
+{
+    using GrfxType = grfx::Semaphore;
+    using ApiType  = null::Semaphore;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::ShaderModule>
+{
+    using GrfxType = grfx::ShaderModule;
+    using ApiType  = null::ShaderModule;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::StorageImageView>
+{
+    using GrfxType = grfx::StorageImageView;
+    using ApiType  = null::StorageImageView;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Surface>
+{
+    using GrfxType = grfx::Surface;
+    using ApiType  = null::Surface;
+};
+
+template <>
+struct ApiObjectLookUp<grfx::Swapchain>
+{
+    using GrfxType = grfx::Swapchain;
+    using ApiType  = null::Swapchain;
+};
+
+template <typename GrfxTypeT>
+typename ApiObjectLookUp<GrfxTypeT>::ApiType* ToApi(GrfxTypeT* pGrfxObject)
+{
+    using ApiType       = typename ApiObjectLookUp<GrfxTypeT>::ApiType;
+    ApiType* pApiObject = static_cast<ApiType*>(pGrfxObject);
+    return pApiObject;
+}
+
+template <typename GrfxTypeT>
+const typename ApiObjectLookUp<GrfxTypeT>::ApiType* ToApi(const GrfxTypeT* pGrfxObject)
+{
+    using ApiType             = typename ApiObjectLookUp<GrfxTypeT>::ApiType;
+    const ApiType* pApiObject = static_cast<const ApiType*>(pGrfxObject);
+    return pApiObject;
+}
+
+template <typename GrfxTypeT>
+typename ApiObjectLookUp<GrfxTypeT>::ApiType* ToApi(ObjPtr<GrfxTypeT>& pGrfxObject)
+{
+    using ApiType       = typename ApiObjectLookUp<GrfxTypeT>::ApiType;
+    ApiType* pApiObject = static_cast<ApiType*>(pGrfxObject.Get());
+    return pApiObject;
+}
+
+template <typename GrfxTypeT>
+const typename ApiObjectLookUp<GrfxTypeT>::ApiType* ToApi(const ObjPtr<GrfxTypeT>& pGrfxObject)
+{
+    using ApiType       = typename ApiObjectLookUp<GrfxTypeT>::ApiType;
+    ApiType* pApiObject = static_cast<ApiType*>(pGrfxObject.Get());
+    return pApiObject;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_config_h
@@ -0,0 +1,72 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_descriptor_h
+#define ppx_grfx_null_descriptor_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_descriptor.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+class DescriptorPool
+    : public grfx::DescriptorPool
+{
+public:
+    DescriptorPool() {}
+    virtual ~DescriptorPool() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::DescriptorPoolCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class DescriptorSet
+    : public grfx::DescriptorSet,
+      public null::HandleTrait
+{
+public:
+    DescriptorSet() {}
+    virtual ~DescriptorSet() {}
+
+    virtual Result UpdateDescriptors(uint32_t writeCount, const grfx::WriteDescriptor* pWrites) override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::internal::DescriptorSetCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class DescriptorSetLayout
+    : public grfx::DescriptorSetLayout
+{
+public:
+    DescriptorSetLayout() {}
+    virtual ~DescriptorSetLayout() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::DescriptorSetLayoutCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_descriptor_h
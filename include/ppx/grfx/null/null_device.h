@@ -0,0 +1,101 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_device_h
+#define ppx_grfx_null_device_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_device.h"
+
+#include <atomic>
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+//! @class Device
+//!
+//! Every object allocated by the null device is a plain CPU object with no
+//! API object behind it. Submitted work completes immediately: fences and
+//! semaphores are signaled at submission and queries read back zeros.
+//!
+//! When command recording is enabled, command buffers begun afterwards keep
+//! a null::CommandStream of everything recorded into them. Recording is off
+//! by default so measurements only see the cost of the framework.
+//!
+class Device
+    : public grfx::Device
+{
+public:
+    Device() {}
+    virtual ~Device() {}
+
+    bool IsCommandRecordingEnabled() const { return mCommandRecordingEnabled; }
+    void SetCommandRecordingEnabled(bool enabled) { mCommandRecordingEnabled = enabled; }
+
+    uint32_t AllocateNullHandle() { return ++mNextNullHandle; }
+
+    virtual Result WaitIdle() override;
+
+    virtual bool PipelineStatsAvailable() const override;
+    virtual bool DynamicRenderingSupported() const override;
+    virtual bool IndependentBlendingSupported() const override;
+    virtual bool FragmentStoresAndAtomicsSupported() const override;
+
+protected:
+    virtual Result AllocateObject(grfx::Buffer** ppObject) override;
+    virtual Result AllocateObject(grfx::CommandBuffer** ppObject) override;
+    virtual Result AllocateObject(grfx::CommandPool** ppObject) override;
+    virtual Result AllocateObject(grfx::ComputePipeline** ppObject) override;
+    virtual Result AllocateObject(grfx::DepthStencilView** ppObject) override;
+    virtual Result AllocateObject(grfx::DescriptorPool** ppObject) override;
+    virtual Result AllocateObject(grfx::DescriptorSet** ppObject) override;
+    virtual Result AllocateObject(grfx::DescriptorSetLayout** ppObject) override;
+    virtual Result AllocateObject(grfx::Fence** ppObject) override;
+    virtual Result AllocateObject(grfx::GraphicsPipeline** ppObject) override;
+    virtual Result AllocateObject(grfx::Image** ppObject) override;
+    virtual Result AllocateObject(grfx::MemoryPool** ppObject) override;
+    virtual Result AllocateObject(grfx::PipelineInterface** ppObject) override;
+    virtual Result AllocateObject(grfx::Queue** ppObject) override;
+    virtual Result AllocateObject(grfx::Query** ppObject) override;
+    virtual Result AllocateObject(grfx::RenderPass** ppObject) override;
+    virtual Result AllocateObject(grfx::RenderTargetView** ppObject) override;
+    virtual Result AllocateObject(grfx::SampledImageView** ppObject) override;
+    virtual Result AllocateObject(grfx::Sampler** ppObject) override;
+    virtual Result AllocateObject(grfx::Semaphore** ppObject) override;
+    virtual Result AllocateObject(grfx::ShaderModule** ppObject) override;
+    virtual Result AllocateObject(grfx::ShaderProgram** ppObject) override;
+    virtual Result AllocateObject(grfx::ShadingRatePattern** ppObject) override;
+    virtual Result AllocateObject(grfx::StorageImageView** ppObject) override;
+    virtual Result AllocateObject(grfx::Swapchain** ppObject) override;
+
+    virtual void GetMemoryHeapStatistics(grfx::MemoryStatistics* pStatistics) const override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::DeviceCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    Result CreateQueues(const grfx::DeviceCreateInfo* pCreateInfo);
+
+private:
+    std::atomic<uint32_t> mNextNullHandle          = 0;
+    bool                  mCommandRecordingEnabled = false;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_device_h
@@ -0,0 +1,120 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_image_h
+#define ppx_grfx_null_image_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_image.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+class Image
+    : public grfx::Image,
+      public null::HandleTrait
+{
+public:
+    Image() {}
+    virtual ~Image() {}
+
+    virtual Result MapMemory(uint64_t offset, void** ppMappedAddress) override;
+    virtual void   UnmapMemory() override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::ImageCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class Sampler
+    : public grfx::Sampler,
+      public null::HandleTrait
+{
+public:
+    Sampler() {}
+    virtual ~Sampler() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::SamplerCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class DepthStencilView
+    : public grfx::DepthStencilView,
+      public null::HandleTrait
+{
+public:
+    DepthStencilView() {}
+    virtual ~DepthStencilView() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::DepthStencilViewCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class RenderTargetView
+    : public grfx::RenderTargetView,
+      public null::HandleTrait
+{
+public:
+    RenderTargetView() {}
+    virtual ~RenderTargetView() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::RenderTargetViewCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class SampledImageView
+    : public grfx::SampledImageView,
+      public null::HandleTrait
+{
+public:
+    SampledImageView() {}
+    virtual ~SampledImageView() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::SampledImageViewCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class StorageImageView
+    : public grfx::StorageImageView,
+      public null::HandleTrait
+{
+public:
+    StorageImageView() {}
+    virtual ~StorageImageView() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::StorageImageViewCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_image_h
@@ -0,0 +1,58 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_instance_h
+#define ppx_grfx_null_instance_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_instance.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+//! @class Instance
+//!
+//! Instance for the null backend. Exposes a single GPU and never touches a
+//! graphics driver, so applications can run where no GPU is present to
+//! measure the CPU cost of the framework itself.
+//!
+class Instance
+    : public grfx::Instance
+{
+public:
+    Instance() {}
+    virtual ~Instance() {}
+
+#if defined(PPX_BUILD_XR)
+    virtual const XrBaseInStructure* XrGetGraphicsBinding() const override;
+    virtual bool                     XrIsGraphicsBindingValid() const override;
+    virtual void                     XrUpdateDeviceInGraphicsBinding() override;
+#endif
+
+protected:
+    virtual Result AllocateObject(grfx::Device** ppDevice) override;
+    virtual Result AllocateObject(grfx::Gpu** ppGpu) override;
+    virtual Result AllocateObject(grfx::Surface** ppSurface) override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::InstanceCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_instance_h
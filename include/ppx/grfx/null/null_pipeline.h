@@ -0,0 +1,72 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_pipeline_h
+#define ppx_grfx_null_pipeline_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_pipeline.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+class ComputePipeline
+    : public grfx::ComputePipeline,
+      public null::HandleTrait
+{
+public:
+    ComputePipeline() {}
+    virtual ~ComputePipeline() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::ComputePipelineCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class GraphicsPipeline
+    : public grfx::GraphicsPipeline,
+      public null::HandleTrait
+{
+public:
+    GraphicsPipeline() {}
+    virtual ~GraphicsPipeline() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::GraphicsPipelineCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+class PipelineInterface
+    : public grfx::PipelineInterface,
+      public null::HandleTrait
+{
+public:
+    PipelineInterface() {}
+    virtual ~PipelineInterface() {}
+
+protected:
+    virtual Result CreateApiObjects(const grfx::PipelineInterfaceCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_pipeline_h
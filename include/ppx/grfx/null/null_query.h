@@ -0,0 +1,49 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_query_h
+#define ppx_grfx_null_query_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_query.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+//! @class Query
+//!
+//! Nothing executes, so all query results read back as zero.
+//!
+class Query
+    : public grfx::Query,
+      public null::HandleTrait
+{
+public:
+    Query() {}
+    virtual ~Query() {}
+
+    virtual void   Reset(uint32_t firstQuery, uint32_t queryCount) override;
+    virtual Result GetData(void* pDstData, uint64_t dstDataSize) override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::QueryCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_query_h
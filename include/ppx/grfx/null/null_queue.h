@@ -0,0 +1,65 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_queue_h
+#define ppx_grfx_null_queue_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_queue.h"
+
+#include <atomic>
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+//! @class Queue
+//!
+//! Submissions complete immediately: the fence and signal semaphores of a
+//! submission are signaled before Submit returns.
+//!
+class Queue
+    : public grfx::Queue
+{
+public:
+    Queue() {}
+    virtual ~Queue() {}
+
+    uint64_t GetSubmitCount() const { return mSubmitCount; }
+    uint64_t GetSubmittedCommandBufferCount() const { return mSubmittedCommandBufferCount; }
+    uint64_t GetSubmittedWaitSemaphoreCount() const { return mSubmittedWaitSemaphoreCount; }
+
+    virtual Result WaitIdle() override;
+    virtual Result Submit(const grfx::SubmitInfo* pSubmitInfo) override;
+
+    virtual Result QueueWait(grfx::Semaphore* pSemaphore, uint64_t value) override;
+    virtual Result QueueSignal(grfx::Semaphore* pSemaphore, uint64_t value) override;
+
+    virtual Result GetTimestampFrequency(uint64_t* pFrequency) const override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::internal::QueueCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    std::atomic<uint64_t> mSubmitCount                 = 0;
+    std::atomic<uint64_t> mSubmittedCommandBufferCount = 0;
+    std::atomic<uint64_t> mSubmittedWaitSemaphoreCount = 0;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_queue_h
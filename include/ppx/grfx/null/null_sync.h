@@ -0,0 +1,87 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_grfx_null_sync_h
+#define ppx_grfx_null_sync_h
+
+#include "ppx/grfx/null/null_config.h"
+#include "ppx/grfx/grfx_sync.h"
+
+#include <atomic>
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+//! @class Fence
+//!
+//! Signaled by the queue at submission. Since there is no asynchronous work
+//! that could signal it later, waiting on an unsignaled fence times out
+//! immediately instead of blocking.
+//!
+class Fence
+    : public grfx::Fence
+{
+public:
+    Fence() {}
+    virtual ~Fence() {}
+
+    void Signal() { mSignaled = true; }
+
+    virtual Result Wait(uint64_t timeout = UINT64_MAX) override;
+    virtual Result Reset() override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::FenceCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    std::atomic<bool> mSignaled = false;
+};
+
+// -------------------------------------------------------------------------------------------------
+
+//! @class Semaphore
+//!
+//! Binary semaphores carry no state. Timeline semaphores keep their counter
+//! value and, like fences, fail waits on values that were never signaled.
+//!
+class Semaphore
+    : public grfx::Semaphore
+{
+public:
+    Semaphore() {}
+    virtual ~Semaphore() {}
+
+    // Signal from a queue submission, ignored for binary semaphores
+    void SignalFromQueue(uint64_t value);
+
+private:
+    virtual Result   TimelineWait(uint64_t value, uint64_t timeout) const override;
+    virtual Result   TimelineSignal(uint64_t value) const override;
+    virtual uint64_t TimelineCounterValue() const override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::SemaphoreCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    mutable std::atomic<uint64_t> mValue = 0;
+};
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
+
+#endif // ppx_grfx_null_sync_h
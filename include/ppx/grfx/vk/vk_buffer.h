@@ -22,6 +22,27 @@ namespace ppx {
 namespace grfx {
 namespace vk {
 
+class MemoryPool
+    : public grfx::MemoryPool
+{
+public:
+    MemoryPool() {}
+    virtual ~MemoryPool() {}
+
+    VmaPoolPtr GetVmaPool() const { return mPool; }
+
+    virtual grfx::MemoryPoolStatistics GetStatistics() const override;
+
+protected:
+    virtual Result CreateApiObjects(const grfx::MemoryPoolCreateInfo* pCreateInfo) override;
+    virtual void   DestroyApiObjects() override;
+
+private:
+    VmaPoolPtr mPool;
+};
+
+// -------------------------------------------------------------------------------------------------
+
 class Buffer
     : public grfx::Buffer
 {
@@ -38,6 +59,10 @@ protected:
     virtual Result CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo) override;
     virtual void   DestroyApiObjects() override;
 
+private:
+    virtual Result FlushRangeImpl(uint64_t offset, uint64_t size) override;
+    virtual Result InvalidateRangeImpl(uint64_t offset, uint64_t size) override;
+
 private:
     VkBufferPtr       mBuffer;
     VmaAllocationPtr  mAllocation;
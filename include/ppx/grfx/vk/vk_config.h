@@ -132,6 +132,7 @@ using VkSwapchainPtr           = VkHandlePtr<VkSwapchainKHR>;
 
 using VmaAllocationPtr = VkHandlePtr<VmaAllocation>;
 using VmaAllocatorPtr  = VkHandlePtr<VmaAllocator>;
+using VmaPoolPtr       = VkHandlePtr<VmaPool>;
 
 // -------------------------------------------------------------------------------------------------
 
@@ -149,6 +150,7 @@ class Gpu;
 class GraphicsPipeline;
 class Image;
 class Instance;
+class MemoryPool;
 class Pipeline;
 class PipelineInterface;
 class Query;
@@ -261,6 +263,13 @@ struct ApiObjectLookUp<grfx::Image>
     using ApiType  = vk::Image;
 };
 
+template <>
+struct ApiObjectLookUp<grfx::MemoryPool>
+{
+    using GrfxType = grfx::MemoryPool;
+    using ApiType  = vk::MemoryPool;
+};
+
 template <>
 struct ApiObjectLookUp<grfx::internal::ImageResourceView>
 {
@@ -73,6 +73,7 @@ protected:
     virtual Result AllocateObject(grfx::Fence** ppObject) override;
     virtual Result AllocateObject(grfx::GraphicsPipeline** ppObject) override;
     virtual Result AllocateObject(grfx::Image** ppObject) override;
+    virtual Result AllocateObject(grfx::MemoryPool** ppObject) override;
     virtual Result AllocateObject(grfx::PipelineInterface** ppObject) override;
     virtual Result AllocateObject(grfx::Queue** ppObject) override;
     virtual Result AllocateObject(grfx::Query** ppObject) override;
@@ -87,6 +88,8 @@ protected:
     virtual Result AllocateObject(grfx::StorageImageView** ppObject) override;
     virtual Result AllocateObject(grfx::Swapchain** ppObject) override;
 
+    virtual void GetMemoryHeapStatistics(grfx::MemoryStatistics* pStatistics) const override;
+
 protected:
     virtual Result CreateApiObjects(const grfx::DeviceCreateInfo* pCreateInfo) override;
     virtual void   DestroyApiObjects() override;
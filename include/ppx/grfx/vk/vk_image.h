@@ -32,6 +32,7 @@ public:
     VkImagePtr         GetVkImage() const { return mImage; }
     VkFormat           GetVkFormat() const { return mVkFormat; }
     VkImageAspectFlags GetVkImageAspectFlags() const { return mImageAspect; }
+    VmaAllocationPtr   GetVmaAllocation() const { return mAllocation; }
 
     virtual Result MapMemory(uint64_t offset, void** ppMappedAddress) override;
     virtual void   UnmapMemory() override;
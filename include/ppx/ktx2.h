@@ -0,0 +1,142 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_ktx2_h
+#define ppx_ktx2_h
+
+#include "ppx/config.h"
+#include "ppx/fs.h"
+#include "ppx/grfx/grfx_format.h"
+
+#include <algorithm>
+#include <filesystem>
+
+namespace ppx {
+
+//! @enum Ktx2Supercompression
+//!
+//! Values of the header's supercompressionScheme field. Only NONE and ZSTD
+//! level data can be read, ZSTD requires the library to be built with
+//! Zstandard support (PPX_ENABLE_ZSTD).
+//!
+enum Ktx2Supercompression
+{
+    KTX2_SUPERCOMPRESSION_NONE     = 0,
+    KTX2_SUPERCOMPRESSION_BASIS_LZ = 1,
+    KTX2_SUPERCOMPRESSION_ZSTD     = 2,
+    KTX2_SUPERCOMPRESSION_ZLIB     = 3,
+};
+
+//! @struct Ktx2Header
+//!
+//! File layout, all offsets are relative to the start of the file:
+//!   Ktx2Header
+//!   Ktx2LevelIndex[max(levelCount, 1)], level 0 (the largest) first
+//!   Data format descriptor, key/value data, supercompression global data
+//!   Level data, usually stored smallest level first
+//!
+struct Ktx2Header
+{
+    uint8_t  identifier[12];
+    uint32_t vkFormat;
+    uint32_t typeSize;
+    uint32_t pixelWidth;
+    uint32_t pixelHeight;
+    uint32_t pixelDepth;
+    uint32_t layerCount;
+    uint32_t faceCount;
+    uint32_t levelCount;
+    uint32_t supercompressionScheme;
+    uint32_t dfdByteOffset;
+    uint32_t dfdByteLength;
+    uint32_t kvdByteOffset;
+    uint32_t kvdByteLength;
+    uint64_t sgdByteOffset;
+    uint64_t sgdByteLength;
+};
+
+struct Ktx2LevelIndex
+{
+    uint64_t byteOffset;
+    uint64_t byteLength;
+    uint64_t uncompressedByteLength;
+};
+
+//! @class Ktx2File
+//!
+//! Read-only view of a KTX2 file. The file is memory mapped when the
+//! platform allows it, so levels can be read one at a time without loading
+//! the whole file, e.g. to stream mip levels into an image on demand. See
+//! grfx_util::CreateImageFromKtx2File() and grfx_util::CopyKtx2LevelToImage().
+//!
+class Ktx2File
+{
+public:
+    static constexpr uint8_t kIdentifier[12] = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+    Ktx2File() {}
+    Ktx2File(const Ktx2File&) = delete;
+    Ktx2File& operator=(const Ktx2File&) = delete;
+    ~Ktx2File() {}
+
+    // Returns true if path has the .ktx2 extension.
+    static bool IsKtx2File(const std::filesystem::path& path);
+
+    // Returns the grfx format for a VkFormat value, FORMAT_UNDEFINED if
+    // there's no matching format.
+    static grfx::Format ToGrfxFormat(uint32_t vkFormat);
+
+    // Opens and validates the KTX2 file at path.
+    Result Open(const std::filesystem::path& path);
+
+    bool IsOpen() const { return !IsNull(mHeader); }
+    bool IsMapped() const { return IsOpen() && mFile.IsMapped(); }
+
+    grfx::Format         GetFormat() const { return ToGrfxFormat(mHeader->vkFormat); }
+    uint32_t             GetWidth() const { return mHeader->pixelWidth; }
+    uint32_t             GetHeight() const { return std::max<uint32_t>(mHeader->pixelHeight, 1); }
+    uint32_t             GetDepth() const { return std::max<uint32_t>(mHeader->pixelDepth, 1); }
+    uint32_t             GetArrayLayerCount() const { return std::max<uint32_t>(mHeader->layerCount, 1); }
+    uint32_t             GetFaceCount() const { return mHeader->faceCount; }
+    uint32_t             GetLevelCount() const { return std::max<uint32_t>(mHeader->levelCount, 1); }
+    Ktx2Supercompression GetSupercompression() const { return static_cast<Ktx2Supercompression>(mHeader->supercompressionScheme); }
+
+    uint32_t GetLevelWidth(uint32_t level) const { return std::max<uint32_t>(GetWidth() >> level, 1); }
+    uint32_t GetLevelHeight(uint32_t level) const { return std::max<uint32_t>(GetHeight() >> level, 1); }
+
+    // Size of the level once decompressed, i.e. the size ReadLevel() writes.
+    uint64_t GetLevelSize(uint32_t level) const;
+
+    // Returns the level data as stored in the file, still supercompressed
+    // if GetSupercompression() isn't KTX2_SUPERCOMPRESSION_NONE.
+    const void* GetLevelData(uint32_t level) const;
+    uint64_t    GetLevelDataSize(uint32_t level) const;
+
+    // Writes the decompressed level data to pDst, which must have room for
+    // GetLevelSize(level) bytes. Rows are tightly packed, rows of blocks for
+    // block compressed formats.
+    Result ReadLevel(uint32_t level, void* pDst, uint64_t dstSize) const;
+
+private:
+    fs::File              mFile;
+    std::vector<char>     mFileData; // Only used if the file can't be mapped
+    const char*           mData       = nullptr;
+    uint64_t              mSize       = 0;
+    const Ktx2Header*     mHeader     = nullptr;
+    const Ktx2LevelIndex* mLevelIndex = nullptr;
+};
+
+} // namespace ppx
+
+#endif // ppx_ktx2_h
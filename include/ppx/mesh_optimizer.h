@@ -0,0 +1,128 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_mesh_optimizer_h
+#define ppx_mesh_optimizer_h
+
+#include "ppx/config.h"
+#include "ppx/geometry.h"
+#include "ppx/tri_mesh.h"
+
+#include <vector>
+
+namespace ppx {
+
+//! @enum MeshOptimizerVertexCacheMethod
+//!
+//! FORSYTH - Tom Forsyth's linear-speed vertex cache optimization, targets LRU caches.
+//! TIPSIFY - Sander et al.'s fast triangle reordering, targets FIFO caches and
+//!           produces the clusters used for overdraw optimization.
+//!
+enum MeshOptimizerVertexCacheMethod
+{
+    MESH_OPTIMIZER_VERTEX_CACHE_METHOD_NONE    = 0,
+    MESH_OPTIMIZER_VERTEX_CACHE_METHOD_FORSYTH = 1,
+    MESH_OPTIMIZER_VERTEX_CACHE_METHOD_TIPSIFY = 2,
+};
+
+//! @struct MeshOptimizerOptions
+//!
+//! overdrawThreshold is the ACMR increase allowed by overdraw optimization,
+//! i.e. 1.05 accepts a cluster order that's at most 5% worse for the vertex
+//! cache. Overdraw optimization requires the TIPSIFY method.
+//!
+struct MeshOptimizerOptions
+{
+    MeshOptimizerVertexCacheMethod vertexCacheMethod   = MESH_OPTIMIZER_VERTEX_CACHE_METHOD_TIPSIFY;
+    uint32_t                       vertexCacheSize     = 16;
+    bool                           optimizeOverdraw    = true;
+    float                          overdrawThreshold   = 1.05f;
+    bool                           optimizeVertexFetch = true;
+};
+
+//! @struct VertexCacheStatistics
+//!
+//! acmr - average cache miss ratio, transformed vertices per triangle. Range is [~0.5, 3.0].
+//! atvr - average transform to vertex ratio, transformed vertices per vertex. 1.0 is optimal.
+//!
+struct VertexCacheStatistics
+{
+    uint32_t triangleCount  = 0;
+    uint32_t vertexCount    = 0;
+    uint32_t transformCount = 0;
+    float    acmr           = 0;
+    float    atvr           = 0;
+};
+
+//! @struct MeshOptimizerStatistics
+//!
+//!
+struct MeshOptimizerStatistics
+{
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+};
+
+//! @class MeshOptimizer
+//!
+//! Reorders triangle lists for post-transform vertex cache efficiency,
+//! overdraw and vertex fetch locality. The index based functions don't
+//! allow pDstIndices to alias pIndices.
+//!
+class MeshOptimizer
+{
+public:
+    // Simulates a FIFO post-transform vertex cache of cacheSize entries.
+    static VertexCacheStatistics AnalyzeVertexCache(const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize = 16);
+
+    static void OptimizeVertexCacheForsyth(uint32_t* pDstIndices, const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize = 32);
+
+    // If pClusters is not null, it receives the first index of each cluster of
+    // triangles that was emitted after a cache miss on the fanning vertex.
+    static void OptimizeVertexCacheTipsify(uint32_t* pDstIndices, const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize = 16, std::vector<uint32_t>* pClusters = nullptr);
+
+    // Sorts the clusters of a Tipsify-ordered index list so clusters that are
+    // likely to occlude others are drawn first. positionStride is in bytes.
+    static void OptimizeOverdraw(
+        uint32_t*                    pDstIndices,
+        const uint32_t*              pIndices,
+        uint32_t                     indexCount,
+        const float*                 pPositions,
+        uint32_t                     positionStride,
+        uint32_t                     vertexCount,
+        const std::vector<uint32_t>& clusters,
+        uint32_t                     cacheSize = 16,
+        float                        threshold = 1.05f);
+
+    // Writes the new location of each vertex to pRemap, in order of first use.
+    // Unreferenced vertices are set to UINT32_MAX. Returns the new vertex count.
+    static uint32_t CreateVertexFetchRemap(uint32_t* pRemap, const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount);
+
+    // Optimizes mesh in place. Non-indexed meshes are left untouched, as are
+    // meshes the optimization fails for.
+    static Result Optimize(const MeshOptimizerOptions& options, TriMesh* pMesh, MeshOptimizerStatistics* pStatistics = nullptr);
+
+    // Optimizes geometry in place. Non-indexed geometries are left untouched, as
+    // are geometries the optimization fails for. Overdraw optimization needs a
+    // R32G32B32(A32)_FLOAT position attribute and is skipped without one, the
+    // vertex cache and vertex fetch passes still run.
+    static Result Optimize(const MeshOptimizerOptions& options, Geometry* pGeometry, MeshOptimizerStatistics* pStatistics = nullptr);
+
+private:
+    static Result OptimizeIndices(const MeshOptimizerOptions& options, std::vector<uint32_t>& indices, uint32_t vertexCount, const float* pPositions, uint32_t positionStride);
+};
+
+} // namespace ppx
+
+#endif // ppx_mesh_optimizer_h
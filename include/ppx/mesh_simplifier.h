@@ -0,0 +1,111 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_mesh_simplifier_h
+#define ppx_mesh_simplifier_h
+
+#include "ppx/config.h"
+#include "ppx/camera.h"
+#include "ppx/tri_mesh.h"
+
+#include <vector>
+
+namespace ppx {
+
+//! @struct MeshSimplifierOptions
+//!
+//! targetIndexCount - Simplification stops once the index count is at or below this value.
+//! maxError         - Collapses that would move the surface further than this object
+//!                    space distance are skipped. Use a negative value for no limit.
+//! attributeWeight  - Weight of normal, color and texture coordinate differences relative
+//!                    to the mesh's bounding box diagonal, when ordering collapses.
+//!                    0 ignores attributes.
+//! lockBorders      - Keeps vertices on open borders in place.
+//!
+struct MeshSimplifierOptions
+{
+    uint32_t targetIndexCount = 0;
+    float    maxError         = -1.0f;
+    float    attributeWeight  = 0.05f;
+    bool     lockBorders      = false;
+};
+
+//! @struct MeshLOD
+//!
+//! error is the estimated object space deviation from the source mesh.
+//!
+struct MeshLOD
+{
+    TriMesh mesh;
+    float   error = 0;
+};
+
+//! @struct MeshLODChainOptions
+//!
+//! Each LOD targets reductionRatio of the previous LOD's triangles. The
+//! chain ends early if a LOD can't be reduced by at least minReductionRatio.
+//!
+struct MeshLODChainOptions
+{
+    uint32_t maxLODCount       = 5;
+    float    reductionRatio    = 0.5f;
+    float    minReductionRatio = 0.95f;
+    float    maxError          = -1.0f;
+    float    attributeWeight   = 0.05f;
+    bool     lockBorders       = false;
+};
+
+//! @class MeshSimplifier
+//!
+//! Edge collapse simplification driven by quadric error metrics (Garland and Heckbert).
+//! Vertices with identical positions are collapsed together, so attribute seams and
+//! non-welded meshes are handled. Each collapsed vertex picks the target vertex with the
+//! closest attributes and the attribute difference is added to the collapse cost.
+//!
+//! Collapses are ordered by cost, but errors are distances: a collapse's error is the
+//! distance from the removed vertex to the triangles around it afterwards, plus the error
+//! the vertex already carried. Errors are in object space units, so they scale with the
+//! mesh and can be compared against world space distances.
+//!
+class MeshSimplifier
+{
+public:
+    // Simplifies mesh into pSimplified. Non-indexed meshes produce a UINT32 indexed result.
+    static Result Simplify(const TriMesh& mesh, const MeshSimplifierOptions& options, TriMesh* pSimplified, float* pError = nullptr);
+
+    // Generates an LOD chain, pLODs[0] is a copy of mesh with an error of 0.
+    static Result CreateLODChain(const TriMesh& mesh, const MeshLODChainOptions& options, std::vector<MeshLOD>* pLODs);
+
+    // Returns the size in pixels of an object space error projected by camera.
+    // Distance is measured to the closest point of the object's world space bounding sphere.
+    static float ComputeScreenSpaceError(
+        const Camera&   camera,
+        const float4x4& modelMatrix,
+        const float3&   boundsMin,
+        const float3&   boundsMax,
+        float           objectError,
+        float           viewportHeight);
+
+    // Returns the index of the coarsest LOD with a screen space error at or below maxPixelError.
+    static uint32_t SelectLOD(
+        const Camera&               camera,
+        const float4x4&             modelMatrix,
+        const std::vector<MeshLOD>& lods,
+        float                       viewportHeight,
+        float                       maxPixelError = 1.0f);
+};
+
+} // namespace ppx
+
+#endif // ppx_mesh_simplifier_h
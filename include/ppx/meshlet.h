@@ -0,0 +1,179 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_meshlet_h
+#define ppx_meshlet_h
+
+#include "ppx/config.h"
+#include "ppx/camera.h"
+#include "ppx/tri_mesh.h"
+
+#include <vector>
+
+namespace ppx {
+
+//! @struct Meshlet
+//!
+//! vertexOffset   - First entry of the meshlet in MeshletData::vertices.
+//! triangleOffset - First entry of the meshlet in MeshletData::triangles.
+//!
+struct Meshlet
+{
+    uint32_t vertexOffset   = 0;
+    uint32_t triangleOffset = 0;
+    uint32_t vertexCount    = 0;
+    uint32_t triangleCount  = 0;
+};
+
+//! @struct MeshletBounds
+//!
+//! Bounding sphere and normal cone of a meshlet in object space. The layout
+//! matches a tightly packed HLSL StructuredBuffer element.
+//!
+//! A meshlet is backfacing if:
+//!   dot(normalize(coneApex - cameraPosition), coneAxis) >= coneCutoff
+//!
+//! Meshlets with normals spread too wide to be culled have a zero coneAxis
+//! and a coneCutoff of 1.
+//!
+struct MeshletBounds
+{
+    float3 center     = float3(0);
+    float  radius     = 0;
+    float3 coneAxis   = float3(0);
+    float  coneCutoff = 1;
+    float3 coneApex   = float3(0);
+    float  reserved   = 0;
+};
+
+//! @struct MeshletData
+//!
+//! vertices  - Indices into the source mesh's vertices, referenced by local triangle indices.
+//! triangles - One entry per triangle, local vertex indices packed in bits [0,8), [8,16) and [16,24).
+//! bounds    - One entry per meshlet.
+//!
+struct MeshletData
+{
+    std::vector<Meshlet>       meshlets;
+    std::vector<uint32_t>      vertices;
+    std::vector<uint32_t>      triangles;
+    std::vector<MeshletBounds> bounds;
+
+    uint32_t GetMeshletCount() const { return CountU32(meshlets); }
+};
+
+//! @struct MeshletBuildOptions
+//!
+//! Limits must be between 3 and MeshletBuilder::kMaxVertices, and 1 and
+//! MeshletBuilder::kMaxTriangles. The defaults fit a 128 thread workgroup
+//! and are the limits commonly recommended for mesh shaders.
+//!
+struct MeshletBuildOptions
+{
+    uint32_t maxVertices  = 64;
+    uint32_t maxTriangles = 124;
+};
+
+//! @class MeshletBuilder
+//!
+//! Greedily partitions a triangle list into meshlets. Triangles adjacent to a
+//! meshlet are added in order of fewest new vertices, then proximity to the
+//! meshlet's centroid, so meshlets stay compact and bounds stay tight.
+//!
+class MeshletBuilder
+{
+public:
+    static constexpr uint32_t kMaxVertices  = 256;
+    static constexpr uint32_t kMaxTriangles = 512;
+
+    static uint32_t PackTriangle(uint32_t i0, uint32_t i1, uint32_t i2) { return i0 | (i1 << 8) | (i2 << 16); }
+    static void     UnpackTriangle(uint32_t packed, uint32_t& i0, uint32_t& i1, uint32_t& i2);
+
+    static Result Build(
+        const uint32_t*            pIndices,
+        uint32_t                   indexCount,
+        const float3*              pPositions,
+        uint32_t                   vertexCount,
+        const MeshletBuildOptions& options,
+        MeshletData*               pMeshletData);
+
+    // Non-indexed meshes are treated as having sequential indices.
+    static Result Build(const TriMesh& mesh, const MeshletBuildOptions& options, MeshletData* pMeshletData);
+
+    static MeshletBounds ComputeBounds(
+        const MeshletData& meshletData,
+        const Meshlet&     meshlet,
+        const float3*      pPositions);
+};
+
+//! @struct MeshletCullStatistics
+//!
+//!
+struct MeshletCullStatistics
+{
+    uint32_t meshletCount        = 0;
+    uint32_t frustumCulledCount  = 0;
+    uint32_t backfaceCulledCount = 0;
+    uint32_t visibleCount        = 0;
+    uint32_t visibleTriangles    = 0;
+};
+
+//! @struct MeshletCullOptions
+//!
+//!
+struct MeshletCullOptions
+{
+    bool enableFrustumCulling  = true;
+    bool enableBackfaceCulling = true;
+};
+
+//! @class MeshletCuller
+//!
+//! CPU reference implementation of per meshlet frustum and backface cone
+//! culling. Culling is done in object space: planes are extracted from
+//! viewProjectionMatrix * modelMatrix and the camera position is moved to
+//! object space, so bounds never need to be transformed. GPU implementations
+//! should produce the same results from the same planes and camera position.
+//!
+class MeshletCuller
+{
+public:
+    // Planes are normalized with normals pointing inside, for a [0, 1] clip space depth range.
+    static void ExtractFrustumPlanes(const float4x4& matrix, float4* pPlanes);
+
+    static bool IsSphereOutsideFrustum(const float4* pPlanes, const float3& center, float radius);
+    static bool IsConeBackfacing(const MeshletBounds& bounds, const float3& cameraPosition);
+
+    // pVisibleMeshlets receives the indices of the meshlets that pass culling.
+    static Result Cull(
+        const MeshletData&        meshletData,
+        const float4x4&           viewProjectionMatrix,
+        const float4x4&           modelMatrix,
+        const float3&             cameraPosition,
+        const MeshletCullOptions& options,
+        std::vector<uint32_t>*    pVisibleMeshlets,
+        MeshletCullStatistics*    pStatistics = nullptr);
+
+    static Result Cull(
+        const MeshletData&        meshletData,
+        const Camera&             camera,
+        const float4x4&           modelMatrix,
+        const MeshletCullOptions& options,
+        std::vector<uint32_t>*    pVisibleMeshlets,
+        MeshletCullStatistics*    pStatistics = nullptr);
+};
+
+} // namespace ppx
+
+#endif // ppx_meshlet_h
@@ -46,10 +46,18 @@ public:
     Mipmap(uint32_t width, uint32_t height, Bitmap::Format format, uint32_t levelCount);
     // Using the static, shared-memory pool is currently only safe in single-threaded applications!
     // This should only be used for temporary mipmaps which will be destroyed prior to the creation of any new mipmap.
-    Mipmap(const Bitmap& bitmap, uint32_t levelCount, bool useStaticPool);
+    // Levels are generated with Bitmap::Downsample(), see there for \b sRGB.
+    Mipmap(const Bitmap& bitmap, uint32_t levelCount, bool useStaticPool, bool sRGB = false);
     Mipmap(const Bitmap& bitmap, uint32_t levelCount);
+    // Copies get their own storage (unless they use the static pool) with
+    // the mips pointing into it. Moves keep the storage and the mips.
+    Mipmap(const Mipmap& obj);
+    Mipmap(Mipmap&& obj) noexcept = default;
     ~Mipmap() {}
 
+    Mipmap& operator=(const Mipmap& rhs);
+    Mipmap& operator=(Mipmap&& rhs) noexcept = default;
+
     // Returns true if there's at least one mip level, format is valid, and storage is valid
     bool IsOk() const;
 
@@ -65,6 +73,9 @@ public:
     static Result   LoadFile(const std::filesystem::path& path, uint32_t baseWidth, uint32_t baseHeight, Mipmap* pMipmap, uint32_t levelCount = PPX_REMAINING_MIP_LEVELS);
     static Result   SaveFile(const std::filesystem::path& path, const Mipmap* pMipmap, uint32_t levelCount = PPX_REMAINING_MIP_LEVELS);
 
+private:
+    void InternalCopyMips(const Mipmap& obj);
+
 private:
     std::vector<char>   mData;
     std::vector<Bitmap> mMips;
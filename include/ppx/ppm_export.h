@@ -15,6 +15,7 @@
 #ifndef ppm_export_h
 #define ppm_export_h
 
+#include "ppx/bitmap.h"
 #include "ppx/config.h"
 #include "ppx/grfx/grfx_format.h"
 
@@ -40,6 +41,16 @@ Result ExportToPPM(const std::string& outputFilename, grfx::Format inputFormat,
 //! @param rowStride The row stride, in bytes.
 Result ExportToPPM(std::ostream& outputStream, grfx::Format inputFormat, const void* texels, uint32_t width, uint32_t height, uint32_t rowStride);
 
+//! @brief Exports a bitmap, or a rectangle inside one, to a PPM file.
+//! @param outputFilename The name of the PPM file to be written.
+//! @param bitmap The pixels to export, only 8-bit formats are supported.
+Result ExportToPPM(const std::string& outputFilename, const BitmapView& bitmap);
+
+//! @brief Exports a bitmap, or a rectangle inside one, as a PPM stream.
+//! @param outputStream The output stream where the PPM data will be written.
+//! @param bitmap The pixels to export, only 8-bit formats are supported.
+Result ExportToPPM(std::ostream& outputStream, const BitmapView& bitmap);
+
 } // namespace ppx
 
 #endif // ppm_export_h
@@ -15,11 +15,138 @@
 #ifndef ppx_random_h
 #define ppx_random_h
 
+#include "ppx/config.h"
 #include "ppx/math_config.h"
 #include "pcg32.h"
 
+#include <cstring>
+
 namespace ppx {
 
+class Bitmap;
+
+//! @class RandomLanes
+//!
+//! kLaneCount xoshiro128+ generators stepped together. Lane i produces the
+//! same numbers as lane 0 of RandomLanes(initialState, initialSequence + i).
+//! The lanes only use 32-bit adds, xors and constant shifts, so the loops
+//! below vectorize with SSE2 or NEON. pcg32's 64-bit multiply and variable
+//! rotate don't, which makes it slower per number even across lanes.
+//!
+class RandomLanes
+{
+public:
+    static constexpr uint32_t kLaneCount = 8;
+
+    RandomLanes(uint64_t initialState, uint64_t initialSequence)
+    {
+        Seed(initialState, initialSequence);
+    }
+
+    void Seed(uint64_t initialState, uint64_t initialSequence)
+    {
+        // SplitMix64 spreads nearby seeds over the whole state
+        for (uint32_t i = 0; i < kLaneCount; ++i) {
+            uint64_t       x  = initialState ^ ((initialSequence + i) * 0xD1B54A32D192ED03ULL);
+            const uint64_t s0 = SplitMix64(x);
+            const uint64_t s1 = SplitMix64(x);
+            mState0[i]        = static_cast<uint32_t>(s0);
+            mState1[i]        = static_cast<uint32_t>(s0 >> 32);
+            mState2[i]        = static_cast<uint32_t>(s1);
+            mState3[i]        = static_cast<uint32_t>(s1 >> 32) | 1; // State must not be all zero
+        }
+    }
+
+    // Writes one number per lane to pValues[0, kLaneCount). The low bits
+    // are weaker than the high bits, use the high bits for small ranges.
+    void UInt32(uint32_t* pValues)
+    {
+        // Results go to a local first: pValues could alias the state, which
+        // would keep the loop from vectorizing
+        uint32_t results[kLaneCount];
+        for (uint32_t i = 0; i < kLaneCount; ++i) {
+            results[i]       = mState0[i] + mState3[i];
+            const uint32_t t = mState1[i] << 9;
+
+            mState2[i] ^= mState0[i];
+            mState3[i] ^= mState1[i];
+            mState1[i] ^= mState2[i];
+            mState0[i] ^= mState3[i];
+            mState2[i] ^= t;
+
+            mState3[i] = (mState3[i] << 11) | (mState3[i] >> 21);
+        }
+        std::memcpy(pValues, results, sizeof(results));
+    }
+
+    // Writes one number in [0, 1) per lane, from the high 23 bits
+    void Float(float* pValues) { Float(pValues, kLaneCount); }
+
+    // Writes count / kLaneCount numbers per lane, interleaved: pValues[j]
+    // is from lane j % kLaneCount. count must be a multiple of kLaneCount.
+    void Float(float* pValues, size_t count)
+    {
+        // The state stays in locals over the whole loop, which lets the
+        // compiler keep it in vector registers
+        uint32_t s0[kLaneCount];
+        uint32_t s1[kLaneCount];
+        uint32_t s2[kLaneCount];
+        uint32_t s3[kLaneCount];
+        std::memcpy(s0, mState0, sizeof(s0));
+        std::memcpy(s1, mState1, sizeof(s1));
+        std::memcpy(s2, mState2, sizeof(s2));
+        std::memcpy(s3, mState3, sizeof(s3));
+
+        for (size_t j = 0; j + kLaneCount <= count; j += kLaneCount) {
+            for (uint32_t i = 0; i < kLaneCount; ++i) {
+                const uint32_t mantissa = ((s0[i] + s3[i]) >> 9) | 0x3F800000u;
+                const uint32_t t        = s1[i] << 9;
+
+                s2[i] ^= s0[i];
+                s3[i] ^= s1[i];
+                s1[i] ^= s2[i];
+                s0[i] ^= s3[i];
+                s2[i] ^= t;
+
+                s3[i] = (s3[i] << 11) | (s3[i] >> 21);
+
+                float value = 0;
+                std::memcpy(&value, &mantissa, sizeof(value));
+                pValues[j + i] = value - 1.0f;
+            }
+        }
+
+        std::memcpy(mState0, s0, sizeof(s0));
+        std::memcpy(mState1, s1, sizeof(s1));
+        std::memcpy(mState2, s2, sizeof(s2));
+        std::memcpy(mState3, s3, sizeof(s3));
+    }
+
+private:
+    static uint64_t SplitMix64(uint64_t& x)
+    {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+        z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z          = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    uint32_t mState0[kLaneCount] = {};
+    uint32_t mState1[kLaneCount] = {};
+    uint32_t mState2[kLaneCount] = {};
+    uint32_t mState3[kLaneCount] = {};
+};
+
+//! @class Random
+//!
+//! The bulk Fill functions produce values in blocks of kFillBlockSize
+//! elements, or one row of a bitmap, and each block has its own
+//! RandomLanes streams. Large fills run on multiple threads and still
+//! produce the same values for the same seed, whatever the thread count,
+//! so --deterministic runs stay reproducible. A fill advances this
+//! generator by two numbers, whatever its size. Filled values differ from
+//! the values the per-value functions would have returned.
+//!
 class Random
 {
 public:
@@ -112,7 +239,29 @@ public:
         return value;
     }
 
+    static constexpr uint32_t kFillBlockSize = 4096;
+
+    // Fills pValues[0, count) with values between a and b
+    void Fill(float* pValues, size_t count, float a = 0.0f, float b = 1.0f);
+    void Fill(float2* pValues, size_t count, const float2& a = float2(0.0f), const float2& b = float2(1.0f));
+    void Fill(float3* pValues, size_t count, const float3& a = float3(0.0f), const float3& b = float3(1.0f));
+    void Fill(float4* pValues, size_t count, const float4& a = float4(0.0f), const float4& b = float4(1.0f));
+
+    // Fills the channels of every pixel, channel c with values between a[c]
+    // and b[c]. 8 and 16-bit channels are normalized like in
+    // Bitmap::Transform(), so [0, 1] covers their whole range.
+    Result Fill(Bitmap* pBitmap, const float4& a = float4(0.0f), const float4& b = float4(1.0f));
+
+    // Same as Fill(Bitmap*) for one channel, leaving the others untouched
+    Result FillChannel(Bitmap* pBitmap, uint32_t channel, float a = 0.0f, float b = 1.0f);
+
 private:
+    // Initial state of the lanes of the next fill
+    uint64_t NextFillState();
+
+    void   FillComponents(float* pValues, size_t count, uint32_t componentCount, const float* pA, const float* pB);
+    Result FillChannels(Bitmap* pBitmap, uint32_t firstChannel, uint32_t channelCount, const float* pA, const float* pB);
+
     pcg32 mRng;
 };
 
@@ -0,0 +1,85 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_texture_compression_h
+#define ppx_texture_compression_h
+
+#include "ppx/bitmap.h"
+#include "ppx/config.h"
+#include "ppx/grfx/grfx_format.h"
+
+#include <filesystem>
+
+namespace ppx {
+
+//! @enum TextureCompressionQuality
+//!
+//! How hard the block encoders search for endpoints.
+//!
+enum TextureCompressionQuality
+{
+    TEXTURE_COMPRESSION_QUALITY_FAST   = 0, // Bounding box endpoints
+    TEXTURE_COMPRESSION_QUALITY_NORMAL = 1, // Principal axis endpoints
+    TEXTURE_COMPRESSION_QUALITY_HIGH   = 2, // Principal axis endpoints refined with least squares
+};
+
+//! @struct TextureCompressionOptions
+//!
+//! \b format is one of the BC1, BC3, BC4, BC5 or BC7 UNORM or SRGB
+//! formats, FORMAT_UNDEFINED disables compression. For SRGB formats mip
+//! levels are filtered in linear space.
+//!
+//! Compressed files are cached in \b cacheDirectory, or in
+//! <output directory>/texture_cache if it's empty.
+//!
+struct TextureCompressionOptions
+{
+    grfx::Format              format         = grfx::FORMAT_UNDEFINED;
+    TextureCompressionQuality quality        = TEXTURE_COMPRESSION_QUALITY_NORMAL;
+    std::filesystem::path     cacheDirectory = "";
+};
+
+// Returns true if CompressBitmap() can encode format
+bool IsTextureCompressionFormatSupported(grfx::Format format);
+
+//! Encodes an RGBA8 bitmap into 4x4 blocks of \b format, stored row of
+//! blocks by row of blocks. Edge blocks of sizes that aren't multiples of
+//! 4 repeat the last row and column. Large bitmaps are encoded in bands
+//! of block rows on multiple threads.
+Result CompressBitmap(
+    const BitmapView&         bitmap,
+    grfx::Format              format,
+    TextureCompressionQuality quality,
+    std::vector<char>*        pBlocks);
+
+//! Generates mip levels for \b bitmap, compresses them and writes them to
+//! a DDS file. Levels stop before the first one whose size isn't a
+//! multiple of 4, which block compressed images can't have.
+Result CompressBitmapToDDS(
+    const Bitmap&                    bitmap,
+    const TextureCompressionOptions& options,
+    const std::filesystem::path&     path);
+
+//! Returns in \b pCachePath the DDS file holding the compressed version of
+//! the image file at \b sourcePath, compressing it first if it isn't in the
+//! cache yet. Cache files are named after the XXH64 hash of the source
+//! content and the options, so edited sources get new cache files.
+Result GetCompressedTextureFile(
+    const std::filesystem::path&     sourcePath,
+    const TextureCompressionOptions& options,
+    std::filesystem::path*           pCachePath);
+
+} // namespace ppx
+
+#endif // ppx_texture_compression_h
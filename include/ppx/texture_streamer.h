@@ -0,0 +1,216 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef ppx_texture_streamer_h
+#define ppx_texture_streamer_h
+
+#include "ppx/config.h"
+#include "ppx/ktx2.h"
+#include "ppx/grfx/grfx_config.h"
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ppx {
+
+//! @struct TextureStreamerCreateInfo
+//!
+//!
+struct TextureStreamerCreateInfo
+{
+    grfx::Queue* pQueue = nullptr;
+
+    // Image memory the streamed textures may use, in bytes. Textures are
+    // dropped to coarser levels when their desired levels don't fit.
+    uint64_t memoryBudget = 512 * 1024 * 1024;
+
+    // Levels no larger than this many texels on a side stay resident.
+    uint32_t residentTailSize = 128;
+
+    // Threads reading and decompressing level data.
+    uint32_t workerThreadCount = 2;
+
+    // Maximum number of level loads waiting to be decoded or uploaded.
+    uint32_t maxPendingLoadCount = 8;
+
+    // Maximum number of textures replaced by a single Update() call.
+    uint32_t maxUploadsPerUpdate = 4;
+
+    // Number of Update() calls a replaced texture is kept alive for, must
+    // cover the frames in flight that may still sample it.
+    uint32_t retireUpdateCount = 3;
+};
+
+//! @class StreamedTexture
+//!
+//! Texture whose finer mip levels are streamed from a KTX2 file. The
+//! texture only holds the resident levels: level 0 of GetTexture() is level
+//! GetResidentMipLevel() of the file. Samplers don't need a LOD clamp, but
+//! the texture is replaced as levels arrive and get evicted, so descriptors
+//! must be rewritten whenever GetVersion() changes.
+//!
+class StreamedTexture
+{
+public:
+    StreamedTexture(const StreamedTexture&) = delete;
+    StreamedTexture& operator=(const StreamedTexture&) = delete;
+    ~StreamedTexture() {}
+
+    const Ktx2File& GetFile() const { return mFile; }
+    grfx::Texture*  GetTexture() const { return mTexture; }
+    uint64_t        GetVersion() const { return mVersion; }
+
+    // Number of mip levels that can be streamed, levels with sizes that
+    // aren't a multiple of the format's block size are left out.
+    uint32_t GetMipLevelCount() const { return CountU32(mImageSizes); }
+
+    // Coarsest level the texture can be dropped to.
+    uint32_t GetTailMipLevel() const { return mTailLevel; }
+
+    uint32_t GetResidentMipLevel() const { return mResidentLevel; }
+    uint64_t GetResidentSize() const { return mImageSizes[mResidentLevel]; }
+
+    // Finest level the texture needs, 0 by default. The resident level may
+    // be coarser if the memory budget doesn't allow it.
+    uint32_t GetDesiredMipLevel() const { return mDesiredLevel; }
+    void     SetDesiredMipLevel(uint32_t level) { mDesiredLevel = level; }
+
+    // Sets the desired level from the size the texture covers on screen,
+    // see TextureStreamer::CalculateMipLevel().
+    void SetScreenSize(float width, float height);
+
+private:
+    friend class TextureStreamer;
+
+    StreamedTexture() {}
+
+    // Size of an image holding levels [level, GetMipLevelCount())
+    uint64_t GetImageSize(uint32_t level) const { return mImageSizes[level]; }
+
+    static constexpr uint32_t kNoPendingLevel = UINT32_MAX;
+
+    Ktx2File              mFile;
+    std::vector<uint64_t> mImageSizes;
+    uint32_t              mTailLevel     = 0;
+    uint32_t              mResidentLevel = 0;
+    uint32_t              mDesiredLevel  = 0;
+    uint32_t              mTargetLevel   = 0;
+    uint32_t              mPendingLevel  = kNoPendingLevel;
+    bool                  mRemoved       = false;
+    bool                  mFailed        = false;
+    grfx::TexturePtr      mTexture;
+    uint64_t              mVersion = 0;
+};
+
+//! @class TextureStreamer
+//!
+//! Keeps the mip levels of KTX2 textures resident under a memory budget.
+//! Each Update() picks the finest levels that fit the budget, dropping
+//! levels from the largest textures first, then loads or evicts levels to
+//! match. Worker threads read and decompress the level data. The calling
+//! thread uploads it, since queues and devices aren't thread safe, and
+//! swaps in a texture holding the new set of levels.
+//!
+//! Textures aren't sparse, so changing the resident levels means creating
+//! a new texture. The coarse levels are small so they are reloaded too.
+//!
+class TextureStreamer
+{
+public:
+    TextureStreamer() {}
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+    ~TextureStreamer();
+
+    Result Create(const TextureStreamerCreateInfo& createInfo);
+    void   Destroy();
+
+    // Opens path and uploads its resident tail levels before returning.
+    // The texture is owned by the streamer.
+    Result AddTexture(const std::filesystem::path& path, StreamedTexture** ppTexture);
+
+    // The texture is destroyed by a later Update(), after any pending load.
+    void RemoveTexture(StreamedTexture* pTexture);
+
+    // Call once per frame from the thread that owns the queue.
+    Result Update();
+
+    uint64_t GetMemoryBudget() const { return mCreateInfo.memoryBudget; }
+    void     SetMemoryBudget(uint64_t budget) { mCreateInfo.memoryBudget = budget; }
+
+    // Sum of the resident sizes of all textures, textures replaced but not
+    // destroyed yet aren't counted.
+    uint64_t GetResidentSize() const;
+
+    // Number of level loads queued, being decoded or waiting for upload.
+    uint32_t GetPendingLoadCount() const { return mPendingLoadCount; }
+
+    // Level to sample for a texture covering width x height pixels on
+    // screen: one texel per pixel along the most minified axis.
+    static uint32_t CalculateMipLevel(uint32_t textureWidth, uint32_t textureHeight, float screenWidth, float screenHeight);
+
+private:
+    struct LoadRequest
+    {
+        StreamedTexture* pTexture = nullptr;
+        uint32_t         level    = 0;
+    };
+
+    struct LoadResult
+    {
+        StreamedTexture*      pTexture = nullptr;
+        uint32_t              level    = 0;
+        Result                result   = ppx::ERROR_FAILED;
+        std::vector<char>     data;
+        std::vector<uint64_t> levelOffsets;
+    };
+
+    struct RetiredTexture
+    {
+        grfx::TexturePtr texture;
+        uint64_t         updateIndex = 0;
+    };
+
+    // Reads levels [request.level, GetMipLevelCount()) tightly packed
+    static void LoadLevels(const LoadRequest& request, LoadResult* pResult);
+
+    void   WorkerThread();
+    Result UploadLevels(const LoadResult& load);
+    void   UpdateTargetLevels();
+    void   ScheduleLoads();
+    void   RetireTexture(grfx::Texture* pTexture);
+
+    TextureStreamerCreateInfo                     mCreateInfo = {};
+    std::vector<std::unique_ptr<StreamedTexture>> mTextures;
+    std::vector<RetiredTexture>                   mRetiredTextures;
+    uint64_t                                      mUpdateIndex      = 0;
+    uint32_t                                      mPendingLoadCount = 0;
+
+    // Shared with the worker threads
+    std::mutex               mMutex;
+    std::condition_variable  mWorkAvailable;
+    std::deque<LoadRequest>  mLoadRequests;
+    std::deque<LoadResult>   mLoadResults;
+    bool                     mStopWorkers = false;
+    std::vector<std::thread> mWorkers;
+};
+
+} // namespace ppx
+
+#endif // ppx_texture_streamer_h
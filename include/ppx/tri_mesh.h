@@ -106,6 +106,12 @@ public:
     TriMeshOptions& InvertTexCoordsV() { mInvertTexCoordsV = true; return *this; }
     //! Inverts winding order of ONLY indices
     TriMeshOptions& InvertWinding() { mInvertWinding = true; return *this; }
+    //! Enable/disable vertex cache, overdraw and vertex fetch optimization of indexed meshes, see MeshOptimizer
+    TriMeshOptions& OptimizeMesh(bool value = true) { mEnableOptimizeMesh = value; return *this; }
+    //! Enable/disable the binary mesh cache for meshes loaded from files
+    TriMeshOptions& BinaryCache(bool value = true) { mEnableBinaryCache = value; return *this; }
+    //! Sets the binary mesh cache directory, default is <default output directory>/mesh_cache
+    TriMeshOptions& BinaryCacheDirectory(const std::filesystem::path& path) { mBinaryCacheDirectory = path; return *this; }
     // clang-format on
 private:
     bool   mEnableIndices      = false;
@@ -120,6 +126,10 @@ private:
     float3 mTranslate          = float3(0, 0, 0);
     float3 mScale              = float3(1, 1, 1);
     float2 mTexCoordScale      = float2(1, 1);
+    bool   mEnableOptimizeMesh = false;
+    bool   mEnableBinaryCache  = false;
+
+    std::filesystem::path mBinaryCacheDirectory;
     friend class TriMesh;
 };
 
@@ -191,6 +201,8 @@ public:
     Result GetTriangle(uint32_t triIndex, uint32_t& v0, uint32_t& v1, uint32_t& v2) const;
     Result GetVertexData(uint32_t vtxIndex, TriMeshVertexData* pVertexData) const;
 
+    // If options enable mesh optimization and it fails, a warning is logged
+    // and the unoptimized mesh is returned.
     static TriMesh CreatePlane(TriMeshPlane plane, const float2& size, uint32_t usegs, uint32_t vsegs, const TriMeshOptions& options = TriMeshOptions());
     static TriMesh CreateCube(const float3& size, const TriMeshOptions& options = TriMeshOptions());
     static TriMesh CreateSphere(float radius, uint32_t usegs, uint32_t vsegs, const TriMeshOptions& options = TriMeshOptions());
@@ -202,7 +214,13 @@ private:
     void AppendIndexU16(uint16_t value);
     void AppendIndexU32(uint32_t value);
 
-    static void AppendIndexAndVertexData(
+    // Parses the OBJ file at path, CreateFromOBJ() wraps this with the binary mesh cache
+    static Result ParseOBJ(const std::filesystem::path& path, const TriMeshOptions& options, TriMesh* pTriMesh);
+
+    // Hashes the options that affect the mesh data, used to invalidate binary mesh cache files
+    static uint64_t HashOptions(const TriMeshOptions& options);
+
+    static Result AppendIndexAndVertexData(
         std::vector<uint32_t>&    indexData,
         const std::vector<float>& vertexData,
         const uint32_t            expectedVertexCount,
@@ -221,6 +239,10 @@ private:
     std::vector<float3>  mBitangents;     // Vertex bitangents
     float3               mBoundingBoxMin; // Bounding box min
     float3               mBoundingBoxMax; // Bounding box max
+
+    friend class BinaryMesh;
+    friend class MeshOptimizer;
+    friend class MeshSimplifier;
 };
 
 } // namespace ppx
@@ -356,17 +356,25 @@ void FishTornadoApp::SetupCaustics()
 
 void FishTornadoApp::UploadCaustics()
 {
+    ScopedTimer timer("Caustics image creation");
+
+    std::vector<std::filesystem::path> paths;
     for (uint32_t i = 0; i < kCausticsImageCount; ++i) {
         std::stringstream filename;
         filename << "fishtornado/textures/ocean/caustics/save." << std::setw(2) << std::setfill('0') << i << ".png";
-        std::filesystem::path path = GetAssetPath(filename.str());
-        ScopedTimer           timer("Image creation from file '" + path.string() + "'");
+        paths.push_back(GetAssetPath(filename.str()));
+    }
 
-        Bitmap bitmap;
-        PPX_CHECKED_CALL(Bitmap::LoadFile(path, &bitmap));
+    std::vector<Bitmap> bitmaps;
+    PPX_CHECKED_CALL(Bitmap::LoadFiles(paths, &bitmaps));
 
-        PPX_CHECKED_CALL(grfx_util::CopyBitmapToTexture(GetGraphicsQueue(), &bitmap, mCausticsTexture, 0, i, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_SHADER_RESOURCE));
+    std::vector<grfx_util::BitmapSubresource> subresources(kCausticsImageCount);
+    for (uint32_t i = 0; i < kCausticsImageCount; ++i) {
+        subresources[i].bitmap     = bitmaps[i];
+        subresources[i].arrayLayer = i;
     }
+
+    PPX_CHECKED_CALL(grfx_util::CopyBitmapsToTexture(GetGraphicsQueue(), subresources, mCausticsTexture, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_SHADER_RESOURCE));
 }
 
 void FishTornadoApp::SetupDebug()
@@ -45,43 +45,39 @@ static void FillInitialPositionData(Bitmap* pVelocity, Bitmap* pPosition)
 {
     ppx::Random rand;
 
-    for (Bitmap::PixelIterator iter = pPosition->GetPixelIterator(); !iter.Done(); iter.Next()) {
-        float4* pPixel = iter.GetPixelAddress<float4>();
-        float3  pos    = float3(rand.Float(-200.0f, 200.0f), rand.Float(50.0f, 450.0f), rand.Float(-200.0f, 200.0f));
-        pPixel->r      = pos.x;
-        pPixel->g      = pos.y;
-        pPixel->b      = pos.z;
-        pPixel->a      = rand.Float(0.5f, 1.0f);
-    }
-
-    Bitmap::PixelIterator posIter = pPosition->GetPixelIterator();
-    Bitmap::PixelIterator velIter = pVelocity->GetPixelIterator();
-    for (; posIter.Next() && velIter.Next();) {
-        float4*     pPos = posIter.GetPixelAddress<float4>();
-        float4*     pVel = velIter.GetPixelAddress<float4>();
-        const float s    = 0.1f;
-        pPos->r -= s * pVel->r;
-        pPos->g -= s * pVel->g;
-        pPos->b -= s * pVel->b;
-    }
+    // Rows are filled from their own streams, so positions don't depend on
+    // how rows are spread over threads
+    PPX_CHECKED_CALL(rand.Fill(pPosition, float4(-200.0f, 50.0f, -200.0f, 0.5f), float4(200.0f, 450.0f, 200.0f, 1.0f)));
+
+    pPosition->ParallelForEachRow<float4>([pVelocity](Bitmap::RowSpan<float4> row) {
+        const float4* pVel = reinterpret_cast<const float4*>(pVelocity->GetPixelAddress(0, row.y));
+        const float   s    = 0.1f;
+        for (uint32_t x = 0; x < row.width; ++x) {
+            row[x].r -= s * pVel[x].r;
+            row[x].g -= s * pVel[x].g;
+            row[x].b -= s * pVel[x].b;
+        }
+    });
 }
 
 static void FillInitialVelocityData(Bitmap* pPosition)
 {
-    const float PI          = ppx::pi<float>();
-    const float numFlockers = static_cast<float>(pPosition->GetWidth() * pPosition->GetHeight());
-    const float azimuth     = 64.0f * PI / numFlockers;
-    const float inclination = PI / numFlockers;
-    const float radius      = 0.1f;
-
-    int i = 0;
-    for (Bitmap::PixelIterator iter = pPosition->GetPixelIterator(); !iter.Done(); iter.Next(), ++i) {
-        float4* pPixel = iter.GetPixelAddress<float4>();
-        pPixel->r      = radius * sin(inclination * (float)i) * cos(azimuth * i);
-        pPixel->g      = radius * cos(inclination * (float)i);
-        pPixel->b      = radius * sin(inclination * (float)i) * sin(azimuth * i);
-        pPixel->a      = 1.0f;
-    }
+    const float    PI          = ppx::pi<float>();
+    const float    numFlockers = static_cast<float>(pPosition->GetWidth() * pPosition->GetHeight());
+    const float    azimuth     = 64.0f * PI / numFlockers;
+    const float    inclination = PI / numFlockers;
+    const float    radius      = 0.1f;
+    const uint32_t width       = pPosition->GetWidth();
+
+    pPosition->ParallelForEachRow<float4>([=](Bitmap::RowSpan<float4> row) {
+        for (uint32_t x = 0; x < row.width; ++x) {
+            const int i = static_cast<int>(row.y * width + x);
+            row[x].r    = radius * sin(inclination * (float)i) * cos(azimuth * i);
+            row[x].g    = radius * cos(inclination * (float)i);
+            row[x].b    = radius * sin(inclination * (float)i) * sin(azimuth * i);
+            row[x].a    = 1.0f;
+        }
+    });
 }
 
 void Flocking::SetupSetLayouts()
@@ -0,0 +1,478 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/ppx.h"
+#include "ppx/graphics_util.h"
+#include "ppx/meshlet.h"
+using namespace ppx;
+
+#if defined(USE_DX12)
+const grfx::Api kApi = grfx::API_DX_12_0;
+#elif defined(USE_VK)
+const grfx::Api kApi = grfx::API_VK_1_1;
+#endif
+
+// Workgroup size of MeshletCull.hlsl
+static constexpr uint32_t kMaxMeshletTriangles = 128;
+
+class ProjApp
+    : public ppx::Application
+{
+public:
+    virtual void Config(ppx::ApplicationSettings& settings) override;
+    virtual void Setup() override;
+    virtual void MouseMove(int32_t x, int32_t y, int32_t dx, int32_t dy, uint32_t buttons) override;
+    virtual void Scroll(float dx, float dy) override;
+    virtual void Render() override;
+    virtual void DrawGui() override;
+
+private:
+    struct PerFrame
+    {
+        grfx::CommandBufferPtr cmd;
+        grfx::SemaphorePtr     imageAcquiredSemaphore;
+        grfx::FencePtr         imageAcquiredFence;
+        grfx::SemaphorePtr     renderCompleteSemaphore;
+        grfx::FencePtr         renderCompleteFence;
+    };
+
+    // Must match CullParamsData in MeshletCull.hlsl
+    struct CullParams
+    {
+        float4   frustumPlanes[6];
+        float3   cameraPosition;
+        uint32_t meshletCount;
+        uint32_t enableFrustumCulling;
+        uint32_t enableBackfaceCulling;
+    };
+
+    std::vector<PerFrame>        mPerFrame;
+    ArcballCamera                mCamera;
+    grfx::DescriptorPoolPtr      mDescriptorPool;
+    grfx::ShaderModulePtr        mCS;
+    grfx::DescriptorSetLayoutPtr mCullDescriptorSetLayout;
+    grfx::DescriptorSetPtr       mCullDescriptorSet;
+    grfx::PipelineInterfacePtr   mCullPipelineInterface;
+    grfx::ComputePipelinePtr     mCullPipeline;
+    grfx::ShaderModulePtr        mVS;
+    grfx::ShaderModulePtr        mPS;
+    grfx::DescriptorSetLayoutPtr mDrawDescriptorSetLayout;
+    grfx::DescriptorSetPtr       mDrawDescriptorSet;
+    grfx::PipelineInterfacePtr   mDrawPipelineInterface;
+    grfx::GraphicsPipelinePtr    mDrawPipeline;
+    grfx::VertexBinding          mVertexBinding;
+    grfx::BufferPtr              mCullParamsBuffer;
+    grfx::BufferPtr              mDrawUniformBuffer;
+    grfx::BufferPtr              mMeshletBuffer;
+    grfx::BufferPtr              mBoundsBuffer;
+    grfx::BufferPtr              mTriangleBuffer;
+    grfx::BufferPtr              mVertexBuffer;
+    grfx::BufferPtr              mIndexBuffer;
+    MeshletData                  mMeshletData;
+    uint32_t                     mIndexCount = 0;
+    MeshletCullStatistics        mCullStats  = {};
+    float4x4                     mCullViewProjectionMatrix;
+    float3                       mCullCameraPosition;
+    bool                         mEnableFrustumCulling  = true;
+    bool                         mEnableBackfaceCulling = true;
+    bool                         mFreezeCulling         = false;
+
+private:
+    void SetupMeshlets();
+    void SetupCompute();
+    void SetupDraw();
+
+    // Uploads data to a new CPU visible buffer
+    void CreateStructuredBuffer(uint32_t elementSize, uint32_t elementCount, const void* pData, grfx::Buffer** ppBuffer);
+};
+
+void ProjApp::Config(ppx::ApplicationSettings& settings)
+{
+    settings.appName                    = "meshlet_culling";
+    settings.enableImGui                = true;
+    settings.grfx.api                   = kApi;
+    settings.grfx.swapchain.depthFormat = grfx::FORMAT_D32_FLOAT;
+    settings.grfx.enableDebug           = false;
+}
+
+void ProjApp::CreateStructuredBuffer(uint32_t elementSize, uint32_t elementCount, const void* pData, grfx::Buffer** ppBuffer)
+{
+    grfx::BufferCreateInfo bufferCreateInfo             = {};
+    bufferCreateInfo.size                               = std::max<uint64_t>(elementSize * elementCount, elementSize);
+    bufferCreateInfo.structuredElementStride            = elementSize;
+    bufferCreateInfo.usageFlags.bits.roStructuredBuffer = true;
+    bufferCreateInfo.memoryUsage                        = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, ppBuffer));
+    PPX_CHECKED_CALL((*ppBuffer)->CopyFromSource(elementSize * elementCount, pData));
+}
+
+void ProjApp::SetupMeshlets()
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 512, 256, TriMeshOptions().Indices());
+
+    MeshletBuildOptions options = {};
+    PPX_ASSERT_MSG(options.maxTriangles <= kMaxMeshletTriangles, "meshlets don't fit the cull shader's workgroup");
+    PPX_CHECKED_CALL(MeshletBuilder::Build(mesh, options, &mMeshletData));
+    PPX_LOG_INFO("Built " << mMeshletData.GetMeshletCount() << " meshlets from " << mesh.GetCountTriangles() << " triangles");
+
+    CreateStructuredBuffer(sizeof(Meshlet), mMeshletData.GetMeshletCount(), mMeshletData.meshlets.data(), &mMeshletBuffer);
+    CreateStructuredBuffer(sizeof(MeshletBounds), mMeshletData.GetMeshletCount(), mMeshletData.bounds.data(), &mBoundsBuffer);
+    CreateStructuredBuffer(sizeof(uint32_t), CountU32(mMeshletData.triangles), mMeshletData.triangles.data(), &mTriangleBuffer);
+
+    // One vertex per meshlet vertex entry so each meshlet gets its own color
+    struct Vertex
+    {
+        float3 position;
+        float3 color;
+    };
+    std::vector<Vertex> vertices(mMeshletData.vertices.size());
+    for (uint32_t i = 0; i < mMeshletData.GetMeshletCount(); ++i) {
+        const Meshlet& meshlet = mMeshletData.meshlets[i];
+        const uint32_t hash    = (i + 1) * 2654435761u;
+        const float3   color   = float3((hash >> 8) & 0xFF, (hash >> 16) & 0xFF, (hash >> 24) & 0xFF) / 255.0f;
+        for (uint32_t j = 0; j < meshlet.vertexCount; ++j) {
+            const uint32_t index = meshlet.vertexOffset + j;
+            vertices[index]      = {*mesh.GetDataPositions(mMeshletData.vertices[index]), glm::mix(float3(0.2f), color, 0.8f)};
+        }
+    }
+
+    mVertexBinding.AppendAttribute({"POSITION", 0, grfx::FORMAT_R32G32B32_FLOAT, 0, PPX_APPEND_OFFSET_ALIGNED, grfx::VERTEX_INPUT_RATE_VERTEX});
+    mVertexBinding.AppendAttribute({"COLOR", 1, grfx::FORMAT_R32G32B32_FLOAT, 0, PPX_APPEND_OFFSET_ALIGNED, grfx::VERTEX_INPUT_RATE_VERTEX});
+
+    grfx::BufferCreateInfo bufferCreateInfo       = {};
+    bufferCreateInfo.size                         = SizeInBytesU32(vertices);
+    bufferCreateInfo.usageFlags.bits.vertexBuffer = true;
+    bufferCreateInfo.memoryUsage                  = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mVertexBuffer));
+    PPX_CHECKED_CALL(mVertexBuffer->CopyFromSource(SizeInBytesU32(vertices), vertices.data()));
+
+    // Written by the cull shader every frame
+    mIndexCount = 3 * CountU32(mMeshletData.triangles);
+
+    bufferCreateInfo                                    = {};
+    bufferCreateInfo.size                               = mIndexCount * sizeof(uint32_t);
+    bufferCreateInfo.structuredElementStride            = sizeof(uint32_t);
+    bufferCreateInfo.usageFlags.bits.rwStructuredBuffer = true;
+    bufferCreateInfo.usageFlags.bits.indexBuffer        = true;
+    bufferCreateInfo.memoryUsage                        = grfx::MEMORY_USAGE_GPU_ONLY;
+    bufferCreateInfo.initialState                       = grfx::RESOURCE_STATE_INDEX_BUFFER;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mIndexBuffer));
+}
+
+void ProjApp::SetupCompute()
+{
+    grfx::BufferCreateInfo bufferCreateInfo        = {};
+    bufferCreateInfo.size                          = PPX_MINIMUM_UNIFORM_BUFFER_SIZE;
+    bufferCreateInfo.usageFlags.bits.uniformBuffer = true;
+    bufferCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mCullParamsBuffer));
+
+    grfx::DescriptorSetLayoutCreateInfo layoutCreateInfo = {};
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(0, grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER));
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(1, grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER));
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(2, grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER));
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(3, grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER));
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(4, grfx::DESCRIPTOR_TYPE_RW_STRUCTURED_BUFFER));
+    PPX_CHECKED_CALL(GetDevice()->CreateDescriptorSetLayout(&layoutCreateInfo, &mCullDescriptorSetLayout));
+    PPX_CHECKED_CALL(GetDevice()->AllocateDescriptorSet(mDescriptorPool, mCullDescriptorSetLayout, &mCullDescriptorSet));
+
+    std::array<grfx::WriteDescriptor, 5> writes = {};
+
+    writes[0].binding      = 0;
+    writes[0].type         = grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    writes[0].bufferOffset = 0;
+    writes[0].bufferRange  = PPX_WHOLE_SIZE;
+    writes[0].pBuffer      = mCullParamsBuffer;
+
+    writes[1].binding                = 1;
+    writes[1].type                   = grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER;
+    writes[1].bufferRange            = PPX_WHOLE_SIZE;
+    writes[1].structuredElementCount = mMeshletData.GetMeshletCount();
+    writes[1].pBuffer                = mMeshletBuffer;
+
+    writes[2].binding                = 2;
+    writes[2].type                   = grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER;
+    writes[2].bufferRange            = PPX_WHOLE_SIZE;
+    writes[2].structuredElementCount = mMeshletData.GetMeshletCount();
+    writes[2].pBuffer                = mBoundsBuffer;
+
+    writes[3].binding                = 3;
+    writes[3].type                   = grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER;
+    writes[3].bufferRange            = PPX_WHOLE_SIZE;
+    writes[3].structuredElementCount = CountU32(mMeshletData.triangles);
+    writes[3].pBuffer                = mTriangleBuffer;
+
+    writes[4].binding                = 4;
+    writes[4].type                   = grfx::DESCRIPTOR_TYPE_RW_STRUCTURED_BUFFER;
+    writes[4].bufferRange            = PPX_WHOLE_SIZE;
+    writes[4].structuredElementCount = mIndexCount;
+    writes[4].pBuffer                = mIndexBuffer;
+
+    PPX_CHECKED_CALL(mCullDescriptorSet->UpdateDescriptors(CountU32(writes), writes.data()));
+
+    std::vector<char> bytecode = LoadShader("basic/shaders", "MeshletCull.cs");
+    PPX_ASSERT_MSG(!bytecode.empty(), "CS shader bytecode load failed");
+    grfx::ShaderModuleCreateInfo shaderCreateInfo = {static_cast<uint32_t>(bytecode.size()), bytecode.data()};
+    PPX_CHECKED_CALL(GetDevice()->CreateShaderModule(&shaderCreateInfo, &mCS));
+
+    grfx::PipelineInterfaceCreateInfo piCreateInfo = {};
+    piCreateInfo.setCount                          = 1;
+    piCreateInfo.sets[0].set                       = 0;
+    piCreateInfo.sets[0].pLayout                   = mCullDescriptorSetLayout;
+    PPX_CHECKED_CALL(GetDevice()->CreatePipelineInterface(&piCreateInfo, &mCullPipelineInterface));
+
+    grfx::ComputePipelineCreateInfo cpCreateInfo = {};
+    cpCreateInfo.CS                              = {mCS.Get(), "csmain"};
+    cpCreateInfo.pPipelineInterface              = mCullPipelineInterface;
+    PPX_CHECKED_CALL(GetDevice()->CreateComputePipeline(&cpCreateInfo, &mCullPipeline));
+}
+
+void ProjApp::SetupDraw()
+{
+    grfx::BufferCreateInfo bufferCreateInfo        = {};
+    bufferCreateInfo.size                          = PPX_MINIMUM_UNIFORM_BUFFER_SIZE;
+    bufferCreateInfo.usageFlags.bits.uniformBuffer = true;
+    bufferCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    PPX_CHECKED_CALL(GetDevice()->CreateBuffer(&bufferCreateInfo, &mDrawUniformBuffer));
+
+    grfx::DescriptorSetLayoutCreateInfo layoutCreateInfo = {};
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding{0, grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1, grfx::SHADER_STAGE_ALL_GRAPHICS});
+    PPX_CHECKED_CALL(GetDevice()->CreateDescriptorSetLayout(&layoutCreateInfo, &mDrawDescriptorSetLayout));
+    PPX_CHECKED_CALL(GetDevice()->AllocateDescriptorSet(mDescriptorPool, mDrawDescriptorSetLayout, &mDrawDescriptorSet));
+
+    grfx::WriteDescriptor write = {};
+    write.binding               = 0;
+    write.type                  = grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    write.bufferOffset          = 0;
+    write.bufferRange           = PPX_WHOLE_SIZE;
+    write.pBuffer               = mDrawUniformBuffer;
+    PPX_CHECKED_CALL(mDrawDescriptorSet->UpdateDescriptors(1, &write));
+
+    std::vector<char> bytecode = LoadShader("basic/shaders", "VertexColors.vs");
+    PPX_ASSERT_MSG(!bytecode.empty(), "VS shader bytecode load failed");
+    grfx::ShaderModuleCreateInfo shaderCreateInfo = {static_cast<uint32_t>(bytecode.size()), bytecode.data()};
+    PPX_CHECKED_CALL(GetDevice()->CreateShaderModule(&shaderCreateInfo, &mVS));
+
+    bytecode = LoadShader("basic/shaders", "VertexColors.ps");
+    PPX_ASSERT_MSG(!bytecode.empty(), "PS shader bytecode load failed");
+    shaderCreateInfo = {static_cast<uint32_t>(bytecode.size()), bytecode.data()};
+    PPX_CHECKED_CALL(GetDevice()->CreateShaderModule(&shaderCreateInfo, &mPS));
+
+    grfx::PipelineInterfaceCreateInfo piCreateInfo = {};
+    piCreateInfo.setCount                          = 1;
+    piCreateInfo.sets[0].set                       = 0;
+    piCreateInfo.sets[0].pLayout                   = mDrawDescriptorSetLayout;
+    PPX_CHECKED_CALL(GetDevice()->CreatePipelineInterface(&piCreateInfo, &mDrawPipelineInterface));
+
+    grfx::GraphicsPipelineCreateInfo2 gpCreateInfo  = {};
+    gpCreateInfo.VS                                 = {mVS.Get(), "vsmain"};
+    gpCreateInfo.PS                                 = {mPS.Get(), "psmain"};
+    gpCreateInfo.vertexInputState.bindingCount      = 1;
+    gpCreateInfo.vertexInputState.bindings[0]       = mVertexBinding;
+    gpCreateInfo.topology                           = grfx::PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+    gpCreateInfo.polygonMode                        = grfx::POLYGON_MODE_FILL;
+    gpCreateInfo.cullMode                           = grfx::CULL_MODE_NONE;
+    gpCreateInfo.frontFace                          = grfx::FRONT_FACE_CCW;
+    gpCreateInfo.depthReadEnable                    = true;
+    gpCreateInfo.depthWriteEnable                   = true;
+    gpCreateInfo.blendModes[0]                      = grfx::BLEND_MODE_NONE;
+    gpCreateInfo.outputState.renderTargetCount      = 1;
+    gpCreateInfo.outputState.renderTargetFormats[0] = GetSwapchain()->GetColorFormat();
+    gpCreateInfo.outputState.depthStencilFormat     = GetSwapchain()->GetDepthFormat();
+    gpCreateInfo.pPipelineInterface                 = mDrawPipelineInterface;
+    PPX_CHECKED_CALL(GetDevice()->CreateGraphicsPipeline(&gpCreateInfo, &mDrawPipeline));
+}
+
+void ProjApp::Setup()
+{
+    grfx::DescriptorPoolCreateInfo poolCreateInfo = {};
+    poolCreateInfo.uniformBuffer                  = 2;
+    poolCreateInfo.structuredBuffer               = 4;
+    PPX_CHECKED_CALL(GetDevice()->CreateDescriptorPool(&poolCreateInfo, &mDescriptorPool));
+
+    SetupMeshlets();
+    SetupCompute();
+    SetupDraw();
+
+    mCamera.LookAt(float3(0, 0, 3), float3(0, 0, 0), float3(0, 1, 0));
+    mCamera.SetPerspective(60.0f, GetWindowAspect(), 0.01f, 100.0f);
+
+    // Per frame data
+    {
+        PerFrame frame = {};
+
+        PPX_CHECKED_CALL(GetGraphicsQueue()->CreateCommandBuffer(&frame.cmd));
+
+        grfx::SemaphoreCreateInfo semaCreateInfo = {};
+        PPX_CHECKED_CALL(GetDevice()->CreateSemaphore(&semaCreateInfo, &frame.imageAcquiredSemaphore));
+
+        grfx::FenceCreateInfo fenceCreateInfo = {};
+        PPX_CHECKED_CALL(GetDevice()->CreateFence(&fenceCreateInfo, &frame.imageAcquiredFence));
+
+        PPX_CHECKED_CALL(GetDevice()->CreateSemaphore(&semaCreateInfo, &frame.renderCompleteSemaphore));
+
+        fenceCreateInfo = {true}; // Create signaled
+        PPX_CHECKED_CALL(GetDevice()->CreateFence(&fenceCreateInfo, &frame.renderCompleteFence));
+
+        mPerFrame.push_back(frame);
+    }
+}
+
+void ProjApp::MouseMove(int32_t x, int32_t y, int32_t dx, int32_t dy, uint32_t buttons)
+{
+    if (buttons & ppx::MOUSE_BUTTON_LEFT) {
+        int32_t prevX = x - dx;
+        int32_t prevY = y - dy;
+
+        float2 prevPos = GetNormalizedDeviceCoordinates(prevX, prevY);
+        float2 curPos  = GetNormalizedDeviceCoordinates(x, y);
+
+        mCamera.Rotate(prevPos, curPos);
+    }
+}
+
+void ProjApp::Scroll(float dx, float dy)
+{
+    mCamera.Zoom(dy / 4.0f);
+}
+
+void ProjApp::Render()
+{
+    PerFrame& frame = mPerFrame[0];
+
+    grfx::SwapchainPtr swapchain = GetSwapchain();
+
+    uint32_t imageIndex = UINT32_MAX;
+    PPX_CHECKED_CALL(swapchain->AcquireNextImage(UINT64_MAX, frame.imageAcquiredSemaphore, frame.imageAcquiredFence, &imageIndex));
+
+    // Wait for and reset image acquired fence
+    PPX_CHECKED_CALL(frame.imageAcquiredFence->WaitAndReset());
+
+    // Wait for and reset render complete fence
+    PPX_CHECKED_CALL(frame.renderCompleteFence->WaitAndReset());
+
+    // Update cull params, frozen culling keeps the last camera so culled meshlets can be inspected
+    {
+        if (!mFreezeCulling) {
+            mCullViewProjectionMatrix = mCamera.GetViewProjectionMatrix();
+            mCullCameraPosition       = mCamera.GetEyePosition();
+        }
+
+        const float4x4 model = float4x4(1.0f);
+
+        CullParams params = {};
+        MeshletCuller::ExtractFrustumPlanes(mCullViewProjectionMatrix * model, params.frustumPlanes);
+        params.cameraPosition        = float3(glm::inverse(model) * float4(mCullCameraPosition, 1.0f));
+        params.meshletCount          = mMeshletData.GetMeshletCount();
+        params.enableFrustumCulling  = mEnableFrustumCulling ? 1 : 0;
+        params.enableBackfaceCulling = mEnableBackfaceCulling ? 1 : 0;
+        PPX_CHECKED_CALL(mCullParamsBuffer->CopyFromSource(sizeof(params), &params));
+
+        // CPU reference results for the GUI, the GPU culls the same meshlets
+        MeshletCullOptions options    = {};
+        options.enableFrustumCulling  = mEnableFrustumCulling;
+        options.enableBackfaceCulling = mEnableBackfaceCulling;
+
+        std::vector<uint32_t> visibleMeshlets;
+        PPX_CHECKED_CALL(MeshletCuller::Cull(mMeshletData, mCullViewProjectionMatrix, model, mCullCameraPosition, options, &visibleMeshlets, &mCullStats));
+
+        const float4x4 mvp = mCamera.GetViewProjectionMatrix() * model;
+        PPX_CHECKED_CALL(mDrawUniformBuffer->CopyFromSource(sizeof(mvp), &mvp));
+    }
+
+    // Build command buffer
+    PPX_CHECKED_CALL(frame.cmd->Begin());
+    {
+        // Cull meshlets into the index buffer
+        frame.cmd->BufferResourceBarrier(mIndexBuffer, grfx::RESOURCE_STATE_INDEX_BUFFER, grfx::RESOURCE_STATE_UNORDERED_ACCESS);
+        frame.cmd->BindComputeDescriptorSets(mCullPipelineInterface, 1, &mCullDescriptorSet);
+        frame.cmd->BindComputePipeline(mCullPipeline);
+        frame.cmd->Dispatch(mMeshletData.GetMeshletCount(), 1, 1);
+        frame.cmd->BufferResourceBarrier(mIndexBuffer, grfx::RESOURCE_STATE_UNORDERED_ACCESS, grfx::RESOURCE_STATE_INDEX_BUFFER);
+
+        grfx::RenderPassPtr renderPass = swapchain->GetRenderPass(imageIndex);
+        PPX_ASSERT_MSG(!renderPass.IsNull(), "render pass object is null");
+
+        grfx::RenderPassBeginInfo beginInfo = {};
+        beginInfo.pRenderPass               = renderPass;
+        beginInfo.renderArea                = renderPass->GetRenderArea();
+        beginInfo.RTVClearCount             = 1;
+        beginInfo.RTVClearValues[0]         = {{0.1f, 0.1f, 0.1f, 0}};
+        beginInfo.DSVClearValue             = {1.0f, 0xFF};
+
+        frame.cmd->TransitionImageLayout(renderPass->GetRenderTargetImage(0), PPX_ALL_SUBRESOURCES, grfx::RESOURCE_STATE_PRESENT, grfx::RESOURCE_STATE_RENDER_TARGET);
+        frame.cmd->BeginRenderPass(&beginInfo);
+        {
+            frame.cmd->SetScissors(GetScissor());
+            frame.cmd->SetViewports(GetViewport());
+            frame.cmd->BindGraphicsDescriptorSets(mDrawPipelineInterface, 1, &mDrawDescriptorSet);
+            frame.cmd->BindGraphicsPipeline(mDrawPipeline);
+            frame.cmd->BindIndexBuffer(mIndexBuffer, grfx::INDEX_TYPE_UINT32);
+            frame.cmd->BindVertexBuffers(1, &mVertexBuffer, &mVertexBinding.GetStride());
+            frame.cmd->DrawIndexed(mIndexCount);
+
+            // Draw ImGui
+            DrawDebugInfo();
+            DrawImGui(frame.cmd);
+        }
+        frame.cmd->EndRenderPass();
+        frame.cmd->TransitionImageLayout(renderPass->GetRenderTargetImage(0), PPX_ALL_SUBRESOURCES, grfx::RESOURCE_STATE_RENDER_TARGET, grfx::RESOURCE_STATE_PRESENT);
+    }
+    PPX_CHECKED_CALL(frame.cmd->End());
+
+    grfx::SubmitInfo submitInfo     = {};
+    submitInfo.commandBufferCount   = 1;
+    submitInfo.ppCommandBuffers     = &frame.cmd;
+    submitInfo.waitSemaphoreCount   = 1;
+    submitInfo.ppWaitSemaphores     = &frame.imageAcquiredSemaphore;
+    submitInfo.signalSemaphoreCount = 1;
+    submitInfo.ppSignalSemaphores   = &frame.renderCompleteSemaphore;
+    submitInfo.pFence               = frame.renderCompleteFence;
+
+    PPX_CHECKED_CALL(GetGraphicsQueue()->Submit(&submitInfo));
+
+    PPX_CHECKED_CALL(swapchain->Present(imageIndex, 1, &frame.renderCompleteSemaphore));
+}
+
+void ProjApp::DrawGui()
+{
+    ImGui::Separator();
+
+    ImGui::Checkbox("Frustum Culling", &mEnableFrustumCulling);
+    ImGui::Checkbox("Backface Culling", &mEnableBackfaceCulling);
+    ImGui::Checkbox("Freeze Culling Camera", &mFreezeCulling);
+
+    ImGui::Separator();
+
+    ImGui::Columns(2);
+    ImGui::Text("Meshlets");
+    ImGui::NextColumn();
+    ImGui::Text("%u", mCullStats.meshletCount);
+    ImGui::NextColumn();
+    ImGui::Text("Frustum Culled");
+    ImGui::NextColumn();
+    ImGui::Text("%u", mCullStats.frustumCulledCount);
+    ImGui::NextColumn();
+    ImGui::Text("Backface Culled");
+    ImGui::NextColumn();
+    ImGui::Text("%u", mCullStats.backfaceCulledCount);
+    ImGui::NextColumn();
+    ImGui::Text("Visible Triangles");
+    ImGui::NextColumn();
+    ImGui::Text("%u / %u", mCullStats.visibleTriangles, mIndexCount / 3);
+    ImGui::NextColumn();
+    ImGui::Columns(1);
+}
+
+SETUP_APPLICATION(ProjApp)
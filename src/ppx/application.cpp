@@ -17,6 +17,7 @@
 #include "ppx/ppm_export.h"
 #include "ppx/profiler.h"
 
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
@@ -25,7 +26,9 @@
 #include <numeric>
 #include <optional>
 #include <sstream>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace ppx {
 
@@ -159,14 +162,15 @@ Result Application::InitializeGrfxDevice()
             return ppxres;
         }
 
-        grfx::DeviceCreateInfo ci = {};
-        ci.pGpu                   = gpu;
-        ci.graphicsQueueCount     = mSettings.grfx.device.graphicsQueueCount;
-        ci.computeQueueCount      = mSettings.grfx.device.computeQueueCount;
-        ci.transferQueueCount     = mSettings.grfx.device.transferQueueCount;
-        ci.vulkanExtensions       = {};
-        ci.pVulkanDeviceFeatures  = nullptr;
-        ci.supportShadingRateMode = mSettings.grfx.device.supportShadingRateMode;
+        grfx::DeviceCreateInfo ci        = {};
+        ci.pGpu                          = gpu;
+        ci.graphicsQueueCount            = mSettings.grfx.device.graphicsQueueCount;
+        ci.computeQueueCount             = mSettings.grfx.device.computeQueueCount;
+        ci.transferQueueCount            = mSettings.grfx.device.transferQueueCount;
+        ci.vulkanExtensions              = {};
+        ci.pVulkanDeviceFeatures         = nullptr;
+        ci.supportShadingRateMode        = mSettings.grfx.device.supportShadingRateMode;
+        ci.enableRedundantStateFiltering = mStandardOpts.pFilterRedundantState->GetValue();
 #if defined(PPX_BUILD_XR)
         ci.pXrComponent = mSettings.xr.enable ? &mXrComponent : nullptr;
 #endif
@@ -588,7 +592,7 @@ void Application::InitStandardKnobs()
     // Flag names in alphabetical order
     GetKnobManager().InitKnob(&mStandardOpts.pAssetsPaths, "extra-assets-path", mSettings.standardKnobsDefaultValue.assetsPaths);
     mStandardOpts.pAssetsPaths->SetFlagDescription(
-        "Add a path before the default assets folder in the search list.");
+        "Add a path before the default assets folder in the search list. The path can be an asset pack (.ppxpack).");
     mStandardOpts.pAssetsPaths->SetFlagParameters("<path>");
 
     GetKnobManager().InitKnob(&mStandardOpts.pConfigJsonPaths, mCommandLineParser.GetJsonConfigFlagName(), mSettings.standardKnobsDefaultValue.configJsonPaths);
@@ -606,6 +610,12 @@ void Application::InitStandardKnobs()
     mStandardOpts.pEnableMetrics->SetFlagDescription(
         "Enable metrics report output. See also: `--metrics-filename` and `--overwrite-metrics-file`.");
 
+    GetKnobManager().InitKnob(&mStandardOpts.pFilterRedundantState, "filter-redundant-state", mSettings.standardKnobsDefaultValue.filterRedundantState);
+    mStandardOpts.pFilterRedundantState->SetFlagDescription(
+        "Drop pipeline, descriptor set, vertex/index buffer, viewport and scissor "
+        "binds that match the state already bound in the command buffer. Submitted "
+        "and elided counts are reported through metrics.");
+
     GetKnobManager().InitKnob(&mStandardOpts.pFrameCount, "frame-count", mSettings.standardKnobsDefaultValue.frameCount, 0, UINT64_MAX);
     mStandardOpts.pFrameCount->SetFlagDescription(
         "Shutdown the application after successfully rendering N frames. "
@@ -633,6 +643,13 @@ void Application::InitStandardKnobs()
         "If not a full path, will be defined relative to the default "
         "output directory. See also `--enable-metrics` and `--overwrite-metrics-file`.");
 
+#if defined(PPX_NULL)
+    GetKnobManager().InitKnob(&mStandardOpts.pNullGrfx, "null-grfx", mSettings.standardKnobsDefaultValue.nullGrfx);
+    mStandardOpts.pNullGrfx->SetFlagDescription(
+        "Run on the null graphics backend instead of a GPU. Implies `--headless`. "
+        "Useful for measuring CPU overhead on machines without a GPU.");
+#endif
+
     GetKnobManager().InitKnob(&mStandardOpts.pOverwriteMetricsFile, "overwrite-metrics-file", mSettings.standardKnobsDefaultValue.overwriteMetricsFile);
     mStandardOpts.pOverwriteMetricsFile->SetFlagDescription(
         "Only applies if metrics are enabled with `--enable-metrics`. "
@@ -928,6 +945,16 @@ bool Application::IsRunning() const
 void Application::UpdateStandardSettings()
 {
     mSettings.headless = mStandardOpts.pHeadless->GetValue();
+    mShaderApi         = mSettings.grfx.api;
+
+#if defined(PPX_NULL)
+    // Shaders are still loaded from the API the sample was configured for,
+    // the null backend ignores the bytecode.
+    if (mStandardOpts.pNullGrfx->GetValue()) {
+        mSettings.grfx.api = grfx::API_NULL;
+        mSettings.headless = true;
+    }
+#endif
 
     // If command line argument provided width and height
     auto       resolution        = mStandardOpts.pResolution->GetValue();
@@ -1444,52 +1471,150 @@ grfx::Viewport Application::GetViewport(float minDepth, float maxDepth) const
 
 namespace {
 
-std::optional<std::filesystem::path> GetShaderPathSuffix(const ppx::ApplicationSettings& settings, const std::filesystem::path& baseName)
+// Subdirectory and file extension of the shaders loaded for api
+std::optional<std::pair<std::filesystem::path, std::string>> GetShaderFormat(grfx::Api api)
 {
-    switch (settings.grfx.api) {
+    switch (api) {
         case grfx::API_DX_12_0:
         case grfx::API_DX_12_1:
-            return (std::filesystem::path("dxil") / baseName).concat(".dxil");
+            return std::make_pair(std::filesystem::path("dxil"), std::string(".dxil"));
         case grfx::API_VK_1_1:
         case grfx::API_VK_1_2:
-            return (std::filesystem::path("spv") / baseName).concat(".spv");
+            return std::make_pair(std::filesystem::path("spv"), std::string(".spv"));
         default:
             return std::nullopt;
     }
 };
 
+std::optional<std::filesystem::path> GetShaderPathSuffix(grfx::Api api, const std::filesystem::path& baseName)
+{
+    auto format = GetShaderFormat(api);
+    if (!format.has_value()) {
+        return std::nullopt;
+    }
+    return (format->first / baseName).concat(format->second);
+};
+
 } // namespace
 
-std::vector<char> Application::LoadShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName) const
+const std::vector<char>& Application::LoadShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName) const
 {
+    static const std::vector<char> kNoBytecode;
+
     PPX_ASSERT_MSG(baseDir.is_relative(), "baseDir must be relative. Do not call GetAssetPath() on the directory.");
     PPX_ASSERT_MSG(baseName.is_relative(), "baseName must be relative. Do not call GetAssetPath() on the directory.");
-    auto suffix = GetShaderPathSuffix(mSettings, baseName);
+    auto suffix = GetShaderPathSuffix(mShaderApi, baseName);
     if (!suffix.has_value()) {
         PPX_ASSERT_MSG(false, "unsupported API");
-        return {};
+        return kNoBytecode;
     }
 
     const auto filePath = GetAssetPath(baseDir / suffix.value());
-    auto       bytecode = fs::load_file(filePath);
+    {
+        std::lock_guard<std::mutex> lock(mShaderBytecodeMutex);
+        auto                        it = mShaderBytecode.find(filePath.string());
+        if (it != mShaderBytecode.end()) {
+            return it->second;
+        }
+    }
+
+    auto bytecode = fs::load_file(filePath);
     if (!bytecode.has_value()) {
         PPX_ASSERT_MSG(false, "could not load file: " << filePath);
-        return {};
+        return kNoBytecode;
     }
 
     PPX_LOG_INFO("Loaded shader from " << filePath);
-    return bytecode.value();
+
+    // Another thread may have loaded the same file in the meantime, its
+    // bytecode is kept in that case
+    std::lock_guard<std::mutex> lock(mShaderBytecodeMutex);
+    return mShaderBytecode.emplace(filePath.string(), std::move(bytecode.value())).first->second;
+}
+
+void Application::ClearShaderCache()
+{
+    std::lock_guard<std::mutex> lock(mShaderBytecodeMutex);
+    mShaderBytecode.clear();
+}
+
+Result Application::PreloadShaders(const std::filesystem::path& baseDir)
+{
+    PPX_ASSERT_MSG(baseDir.is_relative(), "baseDir must be relative. Do not call GetAssetPath() on the directory.");
+    auto format = GetShaderFormat(mShaderApi);
+    if (!format.has_value()) {
+        PPX_ASSERT_MSG(false, "unsupported API");
+        return ppx::ERROR_UNSUPPORTED_API;
+    }
+
+    // Same lookup as GetAssetPath(): a file in an earlier asset directory
+    // hides files with the same name in later ones.
+    std::vector<std::filesystem::path> paths;
+    std::unordered_set<std::string>    fileNames;
+    bool                               foundDir = false;
+    for (const auto& assetDir : GetAssetDirs()) {
+        std::error_code                     ec;
+        std::filesystem::directory_iterator dirIt(assetDir / baseDir / format->first, ec);
+        if (ec) {
+            continue;
+        }
+        foundDir = true;
+        for (const auto& entry : dirIt) {
+            if (!entry.is_regular_file() || (entry.path().extension() != format->second)) {
+                continue;
+            }
+            if (fileNames.insert(entry.path().filename().string()).second) {
+                paths.push_back(entry.path());
+            }
+        }
+    }
+    if (!foundDir) {
+        PPX_LOG_ERROR("Shader directory not found: " << (baseDir / format->first));
+        return ppx::ERROR_PATH_DOES_NOT_EXIST;
+    }
+
+    // Read the files on multiple threads
+    const uint32_t                                fileCount = CountU32(paths);
+    std::vector<std::optional<std::vector<char>>> bytecodes(fileCount);
+    std::atomic<uint32_t>                         nextFile  = 0;
+    auto                                          loadFiles = [&]() {
+        for (uint32_t i = nextFile++; i < fileCount; i = nextFile++) {
+            bytecodes[i] = fs::load_file(paths[i]);
+        }
+    };
+
+    const uint32_t           threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), std::max(fileCount, 1u));
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(loadFiles);
+    }
+    loadFiles();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mShaderBytecodeMutex);
+    for (uint32_t i = 0; i < fileCount; ++i) {
+        if (!bytecodes[i].has_value()) {
+            PPX_LOG_ERROR("Failed to preload shader: " << paths[i]);
+            return ppx::ERROR_FAILED;
+        }
+        mShaderBytecode.emplace(paths[i].string(), std::move(bytecodes[i].value()));
+    }
+
+    PPX_LOG_INFO("Preloaded " << fileCount << " shaders from " << (baseDir / format->first));
+    return ppx::SUCCESS;
 }
 
 Result Application::CreateShader(const std::filesystem::path& baseDir, const std::filesystem::path& baseName, grfx::ShaderModule** ppShaderModule) const
 {
-    std::vector<char> bytecode = LoadShader(baseDir, baseName);
+    const std::vector<char>& bytecode = LoadShader(baseDir, baseName);
     if (bytecode.empty()) {
         return ppx::ERROR_GRFX_INVALID_SHADER_BYTE_CODE;
     }
 
     grfx::ShaderModuleCreateInfo shaderCreateInfo = {static_cast<uint32_t>(bytecode.size()), bytecode.data()};
-    Result                       ppxres           = GetDevice()->CreateShaderModule(&shaderCreateInfo, ppShaderModule);
+    Result                       ppxres           = GetDevice()->AcquireShaderModule(&shaderCreateInfo, ppShaderModule);
     if (Failed(ppxres)) {
         return ppxres;
     }
@@ -1576,6 +1701,64 @@ void Application::StartMetricsRun(const std::string& name)
         mMetrics.frameCountId            = mMetrics.manager.AddMetric(metadata);
         PPX_ASSERT_MSG(mMetrics.frameCountId != metrics::kInvalidMetricID, "Failed to create frame count metric");
     }
+    if (mStandardOpts.pFilterRedundantState->GetValue()) {
+        {
+            metrics::MetricMetadata metadata  = {};
+            metadata.type                     = metrics::MetricType::GAUGE;
+            metadata.name                     = "state_commands_submitted";
+            metadata.unit                     = "";
+            metadata.interpretation           = metrics::MetricInterpretation::LOWER_IS_BETTER;
+            mMetrics.stateCommandsSubmittedId = mMetrics.manager.AddMetric(metadata);
+            PPX_ASSERT_MSG(mMetrics.stateCommandsSubmittedId != metrics::kInvalidMetricID, "Failed to create submitted state commands metric");
+        }
+        {
+            metrics::MetricMetadata metadata = {};
+            metadata.type                    = metrics::MetricType::GAUGE;
+            metadata.name                    = "state_commands_elided";
+            metadata.unit                    = "";
+            metadata.interpretation          = metrics::MetricInterpretation::NONE;
+            mMetrics.stateCommandsElidedId   = mMetrics.manager.AddMetric(metadata);
+            PPX_ASSERT_MSG(mMetrics.stateCommandsElidedId != metrics::kInvalidMetricID, "Failed to create elided state commands metric");
+        }
+    }
+    {
+        metrics::MetricMetadata metadata = {};
+        metadata.type                    = metrics::MetricType::GAUGE;
+        metadata.name                    = "gpu_memory_usage";
+        metadata.unit                    = "MiB";
+        metadata.interpretation          = metrics::MetricInterpretation::LOWER_IS_BETTER;
+        mMetrics.gpuMemoryUsageId        = mMetrics.manager.AddMetric(metadata);
+        PPX_ASSERT_MSG(mMetrics.gpuMemoryUsageId != metrics::kInvalidMetricID, "Failed to create GPU memory usage metric");
+    }
+    {
+        metrics::MetricMetadata metadata = {};
+        metadata.type                    = metrics::MetricType::GAUGE;
+        metadata.name                    = "gpu_memory_budget";
+        metadata.unit                    = "MiB";
+        metadata.interpretation          = metrics::MetricInterpretation::NONE;
+        mMetrics.gpuMemoryBudgetId       = mMetrics.manager.AddMetric(metadata);
+        PPX_ASSERT_MSG(mMetrics.gpuMemoryBudgetId != metrics::kInvalidMetricID, "Failed to create GPU memory budget metric");
+    }
+    {
+        // Indexed by grfx::MemoryCategory, inference never leaves a resource undefined
+        static const char* kCategoryMetricNames[grfx::MEMORY_CATEGORY_COUNT] = {
+            nullptr,
+            "gpu_memory_texture",
+            "gpu_memory_mesh",
+            "gpu_memory_render_target",
+            "gpu_memory_staging",
+            "gpu_memory_other",
+        };
+        for (uint32_t i = grfx::MEMORY_CATEGORY_TEXTURE; i < grfx::MEMORY_CATEGORY_COUNT; ++i) {
+            metrics::MetricMetadata metadata = {};
+            metadata.type                    = metrics::MetricType::GAUGE;
+            metadata.name                    = kCategoryMetricNames[i];
+            metadata.unit                    = "MiB";
+            metadata.interpretation          = metrics::MetricInterpretation::LOWER_IS_BETTER;
+            mMetrics.gpuMemoryCategoryIds[i] = mMetrics.manager.AddMetric(metadata);
+            PPX_ASSERT_MSG(mMetrics.gpuMemoryCategoryIds[i] != metrics::kInvalidMetricID, "Failed to create GPU memory category metric");
+        }
+    }
 
     mMetrics.resetFramerateTracking = true;
 }
@@ -1594,6 +1777,15 @@ void Application::StopMetricsRun()
     mMetrics.cpuFrameTimeId = metrics::kInvalidMetricID;
     mMetrics.framerateId    = metrics::kInvalidMetricID;
     mMetrics.frameCountId   = metrics::kInvalidMetricID;
+
+    mMetrics.stateCommandsSubmittedId = metrics::kInvalidMetricID;
+    mMetrics.stateCommandsElidedId    = metrics::kInvalidMetricID;
+
+    mMetrics.gpuMemoryUsageId  = metrics::kInvalidMetricID;
+    mMetrics.gpuMemoryBudgetId = metrics::kInvalidMetricID;
+    for (uint32_t i = 0; i < grfx::MEMORY_CATEGORY_COUNT; ++i) {
+        mMetrics.gpuMemoryCategoryIds[i] = metrics::kInvalidMetricID;
+    }
 }
 
 bool Application::HasActiveMetricsRun() const
@@ -1639,6 +1831,15 @@ void Application::AddAssetDirs()
         AddAssetDir(projectRootPath / "third_party/assets");
     }
 
+#if !defined(PPX_ANDROID)
+    // A pack built from assets/ with tools/pack_assets.py is searched before
+    // the loose files
+    std::filesystem::path assetPackPath = projectRootPath / "assets.ppxpack";
+    if (std::filesystem::is_regular_file(assetPackPath)) {
+        AddAssetDir(assetPackPath, /* insert_at_front= */ true);
+    }
+#endif
+
     auto assetPaths = mStandardOpts.pAssetsPaths->GetValue();
     if (!assetPaths.empty()) {
         // Insert at front, in reverse order, so we respect the command line ordering for priority.
@@ -1658,6 +1859,13 @@ void Application::UpdateAppMetrics()
         return data;
     }();
 
+    // Command buffer statistics are per frame, so reset them even when not recording
+    grfx::CommandBufferStatistics commandBufferStats = {};
+    if (mDevice) {
+        commandBufferStats = mDevice->GetCommandBufferStatistics();
+        mDevice->ResetCommandBufferStatistics();
+    }
+
     if (!HasActiveMetricsRun()) {
         return;
     }
@@ -1671,6 +1879,42 @@ void Application::UpdateAppMetrics()
     mMetrics.manager.RecordMetricData(mMetrics.cpuFrameTimeId, frameTimeData);
     mMetrics.manager.RecordMetricData(mMetrics.frameCountId, frameCountData);
 
+    if (mMetrics.stateCommandsSubmittedId != metrics::kInvalidMetricID) {
+        metrics::MetricData submittedData = {metrics::MetricType::GAUGE};
+        submittedData.gauge.seconds       = seconds;
+        submittedData.gauge.value         = static_cast<double>(commandBufferStats.submittedStateCommands);
+        mMetrics.manager.RecordMetricData(mMetrics.stateCommandsSubmittedId, submittedData);
+
+        metrics::MetricData elidedData = {metrics::MetricType::GAUGE};
+        elidedData.gauge.seconds       = seconds;
+        elidedData.gauge.value         = static_cast<double>(commandBufferStats.elidedStateCommands);
+        mMetrics.manager.RecordMetricData(mMetrics.stateCommandsElidedId, elidedData);
+    }
+
+    if (mDevice && (mMetrics.gpuMemoryUsageId != metrics::kInvalidMetricID)) {
+        const grfx::MemoryStatistics memoryStats = mDevice->GetMemoryStatistics();
+
+        metrics::MetricData usageData = {metrics::MetricType::GAUGE};
+        usageData.gauge.seconds       = seconds;
+        usageData.gauge.value         = static_cast<double>(memoryStats.GetDeviceLocalUsageBytes()) / (1024.0 * 1024.0);
+        mMetrics.manager.RecordMetricData(mMetrics.gpuMemoryUsageId, usageData);
+
+        metrics::MetricData budgetData = {metrics::MetricType::GAUGE};
+        budgetData.gauge.seconds       = seconds;
+        budgetData.gauge.value         = static_cast<double>(memoryStats.GetDeviceLocalBudgetBytes()) / (1024.0 * 1024.0);
+        mMetrics.manager.RecordMetricData(mMetrics.gpuMemoryBudgetId, budgetData);
+
+        for (uint32_t i = 0; i < grfx::MEMORY_CATEGORY_COUNT; ++i) {
+            if (mMetrics.gpuMemoryCategoryIds[i] == metrics::kInvalidMetricID) {
+                continue;
+            }
+            metrics::MetricData categoryData = {metrics::MetricType::GAUGE};
+            categoryData.gauge.seconds       = seconds;
+            categoryData.gauge.value         = static_cast<double>(memoryStats.categories[i].allocationBytes) / (1024.0 * 1024.0);
+            mMetrics.manager.RecordMetricData(mMetrics.gpuMemoryCategoryIds[i], categoryData);
+        }
+    }
+
     // Record the average framerate over a given period of time
     if (mMetrics.resetFramerateTracking) {
         // Start tracking time
@@ -1823,6 +2067,26 @@ void Application::DrawDebugInfo()
             ImGui::NextColumn();
         }
 
+        ImGui::Separator();
+
+        // GPU memory
+        {
+            const grfx::MemoryStatistics memoryStats = mDevice->GetMemoryStatistics();
+
+            ImGui::Text("GPU Memory Usage");
+            ImGui::NextColumn();
+            ImGui::Text("%.1f / %.1f MiB", static_cast<double>(memoryStats.GetDeviceLocalUsageBytes()) / (1024.0 * 1024.0), static_cast<double>(memoryStats.GetDeviceLocalBudgetBytes()) / (1024.0 * 1024.0));
+            ImGui::NextColumn();
+
+            for (uint32_t i = grfx::MEMORY_CATEGORY_TEXTURE; i < grfx::MEMORY_CATEGORY_COUNT; ++i) {
+                const grfx::MemoryCategoryStatistics& category = memoryStats.categories[i];
+                ImGui::Text("  %s", ToString(static_cast<grfx::MemoryCategory>(i)));
+                ImGui::NextColumn();
+                ImGui::Text("%u (%.1f MiB, peak %.1f MiB)", category.allocationCount, static_cast<double>(category.allocationBytes) / (1024.0 * 1024.0), static_cast<double>(category.peakAllocationBytes) / (1024.0 * 1024.0));
+                ImGui::NextColumn();
+            }
+        }
+
         ImGui::Columns(1);
 
         // Draw additional elements
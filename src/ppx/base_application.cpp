@@ -72,8 +72,15 @@ void BaseApplication::AddAssetDir(const std::filesystem::path& path, bool insert
         return;
     }
 
+    // Asset packs are mounted at their own path and searched like directories
+    if (ppx::fs::IsPackFile(path)) {
+        if (!ppx::fs::MountPack(path, path)) {
+            PPX_LOG_WARN("Could not mount asset pack " << path);
+            return;
+        }
+    }
 #if !defined(PPX_ANDROID)
-    if (!std::filesystem::is_directory(path)) {
+    else if (!std::filesystem::is_directory(path)) {
         return;
     }
 #endif
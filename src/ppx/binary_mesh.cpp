@@ -0,0 +1,589 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/binary_mesh.h"
+#include "ppx/grfx/grfx_util.h"
+
+#include "xxhash.h"
+
+#include <algorithm>
+#include <fstream>
+
+namespace ppx {
+
+namespace {
+
+struct BinaryMeshStreamSource
+{
+    const void* pData       = nullptr;
+    uint64_t    size        = 0;
+    uint32_t    elementSize = 0;
+};
+
+uint64_t AlignStreamOffset(uint64_t offset)
+{
+    const uint64_t alignment = BinaryMesh::kBinaryMeshStreamAlignment;
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+BinaryMeshStream ToBinaryMeshStream(grfx::VertexSemantic semantic)
+{
+    // clang-format off
+    switch (semantic) {
+        default: break;
+        case grfx::VERTEX_SEMANTIC_POSITION  : return BINARY_MESH_STREAM_POSITIONS;
+        case grfx::VERTEX_SEMANTIC_COLOR     : return BINARY_MESH_STREAM_COLORS;
+        case grfx::VERTEX_SEMANTIC_NORMAL    : return BINARY_MESH_STREAM_NORMALS;
+        case grfx::VERTEX_SEMANTIC_TEXCOORD  : return BINARY_MESH_STREAM_TEXCOORDS;
+        case grfx::VERTEX_SEMANTIC_TANGENT   : return BINARY_MESH_STREAM_TANGENTS;
+        case grfx::VERTEX_SEMANTIC_BITANGENT : return BINARY_MESH_STREAM_BITANGENTS;
+    }
+    // clang-format on
+    return BINARY_MESH_STREAM_COUNT;
+}
+
+// Vertex attribute format used by TriMesh and Geometry::Create(const TriMesh&, Geometry*)
+grfx::Format GetBinaryMeshStreamFormat(BinaryMeshStream stream, uint32_t elementSize)
+{
+    // clang-format off
+    switch (stream) {
+        default: break;
+        case BINARY_MESH_STREAM_POSITIONS  : return grfx::FORMAT_R32G32B32_FLOAT;
+        case BINARY_MESH_STREAM_COLORS     : return grfx::FORMAT_R32G32B32_FLOAT;
+        case BINARY_MESH_STREAM_NORMALS    : return grfx::FORMAT_R32G32B32_FLOAT;
+        case BINARY_MESH_STREAM_TANGENTS   : return grfx::FORMAT_R32G32B32A32_FLOAT;
+        case BINARY_MESH_STREAM_BITANGENTS : return grfx::FORMAT_R32G32B32_FLOAT;
+        case BINARY_MESH_STREAM_TEXCOORDS: {
+            switch (elementSize) {
+                default: break;
+                case sizeof(float2) : return grfx::FORMAT_R32G32_FLOAT;
+                case sizeof(float3) : return grfx::FORMAT_R32G32B32_FLOAT;
+                case sizeof(float4) : return grfx::FORMAT_R32G32B32A32_FLOAT;
+            }
+        } break;
+    }
+    // clang-format on
+    return grfx::FORMAT_UNDEFINED;
+}
+
+// Element size CreateTriMesh(), CreateGeometry() and CreateMeshletData()
+// read a stream with, 0 if the header doesn't allow the stream
+uint32_t GetExpectedElementSize(BinaryMeshStream stream, const BinaryMeshHeader& header)
+{
+    // clang-format off
+    switch (stream) {
+        default: break;
+        case BINARY_MESH_STREAM_INDICES           : return grfx::IndexTypeSize(static_cast<grfx::IndexType>(header.indexType));
+        case BINARY_MESH_STREAM_POSITIONS         : return sizeof(float3);
+        case BINARY_MESH_STREAM_COLORS            : return sizeof(float3);
+        case BINARY_MESH_STREAM_NORMALS           : return sizeof(float3);
+        case BINARY_MESH_STREAM_TEXCOORDS         : return header.texCoordDim * static_cast<uint32_t>(sizeof(float));
+        case BINARY_MESH_STREAM_TANGENTS          : return sizeof(float4);
+        case BINARY_MESH_STREAM_BITANGENTS        : return sizeof(float3);
+        case BINARY_MESH_STREAM_MESHLETS          : return sizeof(Meshlet);
+        case BINARY_MESH_STREAM_MESHLET_VERTICES  : return sizeof(uint32_t);
+        case BINARY_MESH_STREAM_MESHLET_TRIANGLES : return sizeof(uint32_t);
+        case BINARY_MESH_STREAM_MESHLET_BOUNDS    : return sizeof(MeshletBounds);
+    }
+    // clang-format on
+    return 0;
+}
+
+// Returns true if every element of pIndices is less than vertexCount
+template <typename T>
+bool IndicesInRange(const void* pIndices, uint64_t count, uint64_t vertexCount)
+{
+    const T* pElements = static_cast<const T*>(pIndices);
+    T        maxIndex  = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        maxIndex = std::max(maxIndex, pElements[i]);
+    }
+    return (count == 0) || (uint64_t(maxIndex) < vertexCount);
+}
+
+void SetMeshletSources(const MeshletData* pMeshletData, BinaryMeshHeader& header, BinaryMeshStreamSource* pSources)
+{
+    if (IsNull(pMeshletData) || pMeshletData->meshlets.empty()) {
+        return;
+    }
+
+    PPX_ASSERT_MSG(pMeshletData->bounds.size() == pMeshletData->meshlets.size(), "meshlet bounds count doesn't match meshlet count");
+
+    header.meshletCount = pMeshletData->GetMeshletCount();
+
+    pSources[BINARY_MESH_STREAM_MESHLETS]          = {pMeshletData->meshlets.data(), pMeshletData->meshlets.size() * sizeof(Meshlet), sizeof(Meshlet)};
+    pSources[BINARY_MESH_STREAM_MESHLET_VERTICES]  = {pMeshletData->vertices.data(), pMeshletData->vertices.size() * sizeof(uint32_t), sizeof(uint32_t)};
+    pSources[BINARY_MESH_STREAM_MESHLET_TRIANGLES] = {pMeshletData->triangles.data(), pMeshletData->triangles.size() * sizeof(uint32_t), sizeof(uint32_t)};
+    pSources[BINARY_MESH_STREAM_MESHLET_BOUNDS]    = {pMeshletData->bounds.data(), pMeshletData->bounds.size() * sizeof(MeshletBounds), sizeof(MeshletBounds)};
+}
+
+Result WriteBinaryMeshFile(const std::filesystem::path& path, BinaryMeshHeader& header, const BinaryMeshStreamSource* pSources)
+{
+    header.magic   = BinaryMesh::kMagic;
+    header.version = BinaryMesh::kVersion;
+
+    uint64_t offset = AlignStreamOffset(sizeof(BinaryMeshHeader));
+    for (uint32_t i = 0; i < BINARY_MESH_STREAM_COUNT; ++i) {
+        BinaryMeshStreamDesc& desc = header.streams[i];
+        desc.offset                = (pSources[i].size > 0) ? offset : 0;
+        desc.size                  = pSources[i].size;
+        desc.elementSize           = pSources[i].elementSize;
+        offset                     = AlignStreamOffset(offset + desc.size);
+    }
+
+    if (path.has_parent_path()) {
+        std::error_code ec;
+        std::filesystem::create_directories(path.parent_path(), ec);
+    }
+
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        return ppx::ERROR_PATH_DOES_NOT_EXIST;
+    }
+
+    const char padding[BinaryMesh::kBinaryMeshStreamAlignment] = {};
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    uint64_t written = sizeof(header);
+    for (uint32_t i = 0; i < BINARY_MESH_STREAM_COUNT; ++i) {
+        const BinaryMeshStreamDesc& desc = header.streams[i];
+        if (desc.size == 0) {
+            continue;
+        }
+        file.write(padding, static_cast<std::streamsize>(desc.offset - written));
+        file.write(static_cast<const char*>(pSources[i].pData), static_cast<std::streamsize>(desc.size));
+        written = desc.offset + desc.size;
+    }
+
+    if (!file.good()) {
+        return ppx::ERROR_FAILED;
+    }
+
+    return ppx::SUCCESS;
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+// BinaryMesh
+// -------------------------------------------------------------------------------------------------
+Result BinaryMesh::Write(const std::filesystem::path& path, const TriMesh& mesh, uint64_t sourceHash, uint64_t optionsHash, const MeshletData* pMeshletData)
+{
+    BinaryMeshHeader header = {};
+    header.sourceHash       = sourceHash;
+    header.optionsHash      = optionsHash;
+    header.indexType        = static_cast<uint32_t>(mesh.mIndexType);
+    header.texCoordDim      = static_cast<uint32_t>(mesh.mTexCoordDim);
+    header.indexCount       = mesh.GetCountIndices();
+    header.vertexCount      = mesh.GetCountPositions();
+    memcpy(header.boundingBoxMin, &mesh.mBoundingBoxMin, sizeof(header.boundingBoxMin));
+    memcpy(header.boundingBoxMax, &mesh.mBoundingBoxMax, sizeof(header.boundingBoxMax));
+
+    const uint32_t texCoordSize = static_cast<uint32_t>(mesh.mTexCoordDim) * static_cast<uint32_t>(sizeof(float));
+
+    BinaryMeshStreamSource sources[BINARY_MESH_STREAM_COUNT] = {};
+    sources[BINARY_MESH_STREAM_INDICES]                      = {mesh.mIndices.data(), mesh.mIndices.size(), grfx::IndexTypeSize(mesh.mIndexType)};
+    sources[BINARY_MESH_STREAM_POSITIONS]                    = {mesh.mPositions.data(), mesh.mPositions.size() * sizeof(float3), sizeof(float3)};
+    sources[BINARY_MESH_STREAM_COLORS]                       = {mesh.mColors.data(), mesh.mColors.size() * sizeof(float3), sizeof(float3)};
+    sources[BINARY_MESH_STREAM_NORMALS]                      = {mesh.mNormals.data(), mesh.mNormals.size() * sizeof(float3), sizeof(float3)};
+    sources[BINARY_MESH_STREAM_TEXCOORDS]                    = {mesh.mTexCoords.data(), mesh.mTexCoords.size() * sizeof(float), texCoordSize};
+    sources[BINARY_MESH_STREAM_TANGENTS]                     = {mesh.mTangents.data(), mesh.mTangents.size() * sizeof(float4), sizeof(float4)};
+    sources[BINARY_MESH_STREAM_BITANGENTS]                   = {mesh.mBitangents.data(), mesh.mBitangents.size() * sizeof(float3), sizeof(float3)};
+    SetMeshletSources(pMeshletData, header, sources);
+
+    return WriteBinaryMeshFile(path, header, sources);
+}
+
+Result BinaryMesh::Write(const std::filesystem::path& path, const Geometry& geometry, uint64_t sourceHash, uint64_t optionsHash, const MeshletData* pMeshletData)
+{
+    if (geometry.GetVertexAttributeLayout() != GEOMETRY_VERTEX_ATTRIBUTE_LAYOUT_PLANAR) {
+        PPX_ASSERT_MSG(false, "only planar geometry can be written to a binary mesh");
+        return ppx::ERROR_GRFX_INVALID_GEOMETRY_CONFIGURATION;
+    }
+
+    const grfx::IndexType indexType = geometry.GetIndexType();
+    if ((indexType != grfx::INDEX_TYPE_UNDEFINED) && (indexType != grfx::INDEX_TYPE_UINT16) && (indexType != grfx::INDEX_TYPE_UINT32)) {
+        return ppx::ERROR_GRFX_INVALID_INDEX_TYPE;
+    }
+
+    BinaryMeshHeader header = {};
+    header.sourceHash       = sourceHash;
+    header.optionsHash      = optionsHash;
+    header.indexType        = static_cast<uint32_t>(indexType);
+    header.indexCount       = geometry.GetIndexCount();
+    header.vertexCount      = geometry.GetVertexCount();
+
+    BinaryMeshStreamSource sources[BINARY_MESH_STREAM_COUNT] = {};
+    if (indexType != grfx::INDEX_TYPE_UNDEFINED) {
+        const Geometry::Buffer* pBuffer       = geometry.GetIndexBuffer();
+        sources[BINARY_MESH_STREAM_INDICES] = {pBuffer->GetData(), pBuffer->GetSize(), grfx::IndexTypeSize(indexType)};
+    }
+
+    for (uint32_t bindingIndex = 0; bindingIndex < geometry.GetVertexBindingCount(); ++bindingIndex) {
+        const grfx::VertexBinding*   pBinding   = geometry.GetVertexBinding(bindingIndex);
+        const grfx::VertexAttribute* pAttribute = nullptr;
+        if ((pBinding->GetAttributeCount() != 1) || Failed(pBinding->GetAttribute(0, &pAttribute))) {
+            return ppx::ERROR_GRFX_INVALID_VERTEX_ATTRIBUTE_COUNT;
+        }
+
+        BinaryMeshStream stream = ToBinaryMeshStream(pAttribute->semantic);
+        if ((stream == BINARY_MESH_STREAM_COUNT) || (sources[stream].size > 0)) {
+            return ppx::ERROR_GEOMETRY_INVALID_VERTEX_SEMANTIC;
+        }
+
+        const uint32_t elementSize = pBinding->GetStride();
+        if (pAttribute->format != GetBinaryMeshStreamFormat(stream, elementSize)) {
+            PPX_ASSERT_MSG(false, "vertex attribute format is not supported by binary mesh");
+            return ppx::ERROR_GRFX_VERTEX_ATTRIBUTE_FORMAT_UNDEFINED;
+        }
+
+        const Geometry::Buffer* pBuffer = geometry.GetVertexBuffer(bindingIndex);
+        sources[stream]                 = {pBuffer->GetData(), pBuffer->GetSize(), elementSize};
+
+        if (stream == BINARY_MESH_STREAM_TEXCOORDS) {
+            header.texCoordDim = elementSize / static_cast<uint32_t>(sizeof(float));
+        }
+    }
+
+    // Planar geometry doesn't track bounds, compute them from the positions
+    float3 boundingBoxMin = float3(0);
+    float3 boundingBoxMax = float3(0);
+    if (sources[BINARY_MESH_STREAM_POSITIONS].size > 0) {
+        const float3* pPositions = static_cast<const float3*>(sources[BINARY_MESH_STREAM_POSITIONS].pData);
+        boundingBoxMin           = pPositions[0];
+        boundingBoxMax           = pPositions[0];
+        for (uint32_t i = 1; i < header.vertexCount; ++i) {
+            boundingBoxMin = glm::min(boundingBoxMin, pPositions[i]);
+            boundingBoxMax = glm::max(boundingBoxMax, pPositions[i]);
+        }
+    }
+    memcpy(header.boundingBoxMin, &boundingBoxMin, sizeof(header.boundingBoxMin));
+    memcpy(header.boundingBoxMax, &boundingBoxMax, sizeof(header.boundingBoxMax));
+
+    SetMeshletSources(pMeshletData, header, sources);
+
+    return WriteBinaryMeshFile(path, header, sources);
+}
+
+uint64_t BinaryMesh::HashFile(const std::filesystem::path& path)
+{
+    fs::File file;
+    if (!file.OpenMapped(path)) {
+        return 0;
+    }
+
+    if (file.IsMapped()) {
+        return XXH64(file.GetMappedData(), file.GetLength(), 0);
+    }
+
+    std::vector<char> data(file.GetLength());
+    if (file.Read(data.data(), data.size()) != data.size()) {
+        return 0;
+    }
+    return XXH64(data.data(), data.size(), 0);
+}
+
+Result BinaryMesh::Open(const std::filesystem::path& path)
+{
+    mHeader = nullptr;
+    mData   = nullptr;
+    mFileData.clear();
+
+    if (!mFile.OpenMapped(path)) {
+        return ppx::ERROR_PATH_DOES_NOT_EXIST;
+    }
+
+    size_t fileSize = mFile.GetLength();
+    if (mFile.IsMapped()) {
+        mData = static_cast<const char*>(mFile.GetMappedData());
+    }
+    else {
+        mFileData.resize(fileSize);
+        if (mFile.Read(mFileData.data(), fileSize) != fileSize) {
+            return ppx::ERROR_GEOMETRY_FILE_LOAD_FAILED;
+        }
+        mData = mFileData.data();
+    }
+
+    // Validate header
+    if (fileSize < sizeof(BinaryMeshHeader)) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+    const BinaryMeshHeader* pHeader = reinterpret_cast<const BinaryMeshHeader*>(mData);
+    if ((pHeader->magic != kMagic) || (pHeader->version != kVersion)) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+    const uint32_t texCoordDim      = pHeader->texCoordDim;
+    const bool     validTexCoordDim = (texCoordDim == TRI_MESH_ATTRIBUTE_DIM_UNDEFINED) || ((texCoordDim >= TRI_MESH_ATTRIBUTE_DIM_2) && (texCoordDim <= TRI_MESH_ATTRIBUTE_DIM_4));
+    const bool     validIndexType   = (pHeader->indexType == grfx::INDEX_TYPE_UNDEFINED) || (grfx::IndexTypeSize(static_cast<grfx::IndexType>(pHeader->indexType)) > 0);
+    if (!validTexCoordDim || !validIndexType) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    // Streams that are read whenever their count is non-zero
+    const bool missingIndices   = (pHeader->indexCount > 0) && (pHeader->streams[BINARY_MESH_STREAM_INDICES].size == 0);
+    const bool missingPositions = (pHeader->vertexCount > 0) && (pHeader->streams[BINARY_MESH_STREAM_POSITIONS].size == 0);
+    if (missingIndices || missingPositions) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    // Validate streams
+    for (uint32_t i = 0; i < BINARY_MESH_STREAM_COUNT; ++i) {
+        const BinaryMeshStreamDesc& desc = pHeader->streams[i];
+        if (desc.size == 0) {
+            continue;
+        }
+
+        bool inBounds = (desc.offset <= fileSize) && (desc.size <= (fileSize - desc.offset));
+        if (!inBounds || ((desc.offset % kBinaryMeshStreamAlignment) != 0)) {
+            return ppx::ERROR_BAD_DATA_SOURCE;
+        }
+
+        // Streams are copied out as arrays of their attribute types, so
+        // their layout must match exactly
+        const uint32_t expectedElementSize = GetExpectedElementSize(static_cast<BinaryMeshStream>(i), *pHeader);
+        if ((expectedElementSize == 0) || (desc.elementSize != expectedElementSize)) {
+            return ppx::ERROR_BAD_DATA_SOURCE;
+        }
+
+        // Meshlet vertex and triangle streams are variable length
+        if ((i == BINARY_MESH_STREAM_MESHLET_VERTICES) || (i == BINARY_MESH_STREAM_MESHLET_TRIANGLES)) {
+            if ((desc.size % desc.elementSize) != 0) {
+                return ppx::ERROR_BAD_DATA_SOURCE;
+            }
+            continue;
+        }
+
+        uint64_t count = pHeader->vertexCount;
+        if (i == BINARY_MESH_STREAM_INDICES) {
+            count = pHeader->indexCount;
+        }
+        else if ((i == BINARY_MESH_STREAM_MESHLETS) || (i == BINARY_MESH_STREAM_MESHLET_BOUNDS)) {
+            count = pHeader->meshletCount;
+        }
+        if (desc.size != (count * desc.elementSize)) {
+            return ppx::ERROR_BAD_DATA_SOURCE;
+        }
+    }
+
+    // Indices are written to geometry buffers without further checks, so
+    // reject any that reference vertices outside of the position stream
+    const char* pIndices       = mData + pHeader->streams[BINARY_MESH_STREAM_INDICES].offset;
+    bool        indicesInRange = true;
+    if (pHeader->indexType == grfx::INDEX_TYPE_UINT16) {
+        indicesInRange = IndicesInRange<uint16_t>(pIndices, pHeader->indexCount, pHeader->vertexCount);
+    }
+    else if (pHeader->indexType == grfx::INDEX_TYPE_UINT32) {
+        indicesInRange = IndicesInRange<uint32_t>(pIndices, pHeader->indexCount, pHeader->vertexCount);
+    }
+    if (!indicesInRange) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    // Meshlet vertices index the same vertex streams
+    const auto& meshletVertices = pHeader->streams[BINARY_MESH_STREAM_MESHLET_VERTICES];
+    if (!IndicesInRange<uint32_t>(mData + meshletVertices.offset, meshletVertices.size / sizeof(uint32_t), pHeader->vertexCount)) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    mHeader = pHeader;
+
+    return ppx::SUCCESS;
+}
+
+float3 BinaryMesh::GetBoundingBoxMin() const
+{
+    return float3(mHeader->boundingBoxMin[0], mHeader->boundingBoxMin[1], mHeader->boundingBoxMin[2]);
+}
+
+float3 BinaryMesh::GetBoundingBoxMax() const
+{
+    return float3(mHeader->boundingBoxMax[0], mHeader->boundingBoxMax[1], mHeader->boundingBoxMax[2]);
+}
+
+uint64_t BinaryMesh::GetStreamSize(BinaryMeshStream stream) const
+{
+    if (IsNull(mHeader) || (stream >= BINARY_MESH_STREAM_COUNT)) {
+        return 0;
+    }
+    return mHeader->streams[stream].size;
+}
+
+uint32_t BinaryMesh::GetStreamElementSize(BinaryMeshStream stream) const
+{
+    if (IsNull(mHeader) || (stream >= BINARY_MESH_STREAM_COUNT)) {
+        return 0;
+    }
+    return mHeader->streams[stream].elementSize;
+}
+
+const void* BinaryMesh::GetStreamData(BinaryMeshStream stream) const
+{
+    if (GetStreamSize(stream) == 0) {
+        return nullptr;
+    }
+    return mData + mHeader->streams[stream].offset;
+}
+
+Result BinaryMesh::CreateTriMesh(TriMesh* pMesh) const
+{
+    PPX_ASSERT_NULL_ARG(pMesh);
+
+    if (!IsOpen()) {
+        return ppx::ERROR_GEOMETRY_FILE_NO_DATA;
+    }
+
+    *pMesh = TriMesh(GetIndexType(), GetTexCoordDim());
+
+    auto copyStream = [this](BinaryMeshStream stream, auto& dst) {
+        using ElementT = typename std::remove_reference_t<decltype(dst)>::value_type;
+        dst.resize(static_cast<size_t>(GetStreamSize(stream) / sizeof(ElementT)));
+        if (!dst.empty()) {
+            memcpy(dst.data(), GetStreamData(stream), GetStreamSize(stream));
+        }
+    };
+
+    copyStream(BINARY_MESH_STREAM_INDICES, pMesh->mIndices);
+    copyStream(BINARY_MESH_STREAM_POSITIONS, pMesh->mPositions);
+    copyStream(BINARY_MESH_STREAM_COLORS, pMesh->mColors);
+    copyStream(BINARY_MESH_STREAM_NORMALS, pMesh->mNormals);
+    copyStream(BINARY_MESH_STREAM_TEXCOORDS, pMesh->mTexCoords);
+    copyStream(BINARY_MESH_STREAM_TANGENTS, pMesh->mTangents);
+    copyStream(BINARY_MESH_STREAM_BITANGENTS, pMesh->mBitangents);
+
+    pMesh->mBoundingBoxMin = GetBoundingBoxMin();
+    pMesh->mBoundingBoxMax = GetBoundingBoxMax();
+
+    return ppx::SUCCESS;
+}
+
+Result BinaryMesh::CreateGeometry(Geometry* pGeometry) const
+{
+    PPX_ASSERT_NULL_ARG(pGeometry);
+
+    if (!IsOpen()) {
+        return ppx::ERROR_GEOMETRY_FILE_NO_DATA;
+    }
+
+    GeometryCreateInfo createInfo    = {};
+    createInfo.vertexAttributeLayout = ppx::GEOMETRY_VERTEX_ATTRIBUTE_LAYOUT_PLANAR;
+    createInfo.indexType             = GetIndexType();
+    createInfo.primitiveTopology     = grfx::PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+    // Same attribute order as Geometry::Create(const TriMesh&, Geometry*)
+    const BinaryMeshStream streams[] = {
+        BINARY_MESH_STREAM_POSITIONS,
+        BINARY_MESH_STREAM_COLORS,
+        BINARY_MESH_STREAM_NORMALS,
+        BINARY_MESH_STREAM_TEXCOORDS,
+        BINARY_MESH_STREAM_TANGENTS,
+        BINARY_MESH_STREAM_BITANGENTS,
+    };
+
+    std::vector<BinaryMeshStream> bindingStreams;
+    for (BinaryMeshStream stream : streams) {
+        if ((stream != BINARY_MESH_STREAM_POSITIONS) && !HasStream(stream)) {
+            continue;
+        }
+
+        grfx::Format format = GetBinaryMeshStreamFormat(stream, GetStreamElementSize(stream));
+        if (stream == BINARY_MESH_STREAM_POSITIONS) {
+            format = grfx::FORMAT_R32G32B32_FLOAT;
+        }
+        if (format == grfx::FORMAT_UNDEFINED) {
+            return ppx::ERROR_BAD_DATA_SOURCE;
+        }
+
+        // clang-format off
+        switch (stream) {
+            default: break;
+            case BINARY_MESH_STREAM_POSITIONS  : createInfo.AddPosition(format); break;
+            case BINARY_MESH_STREAM_COLORS     : createInfo.AddColor(format); break;
+            case BINARY_MESH_STREAM_NORMALS    : createInfo.AddNormal(format); break;
+            case BINARY_MESH_STREAM_TEXCOORDS  : createInfo.AddTexCoord(format); break;
+            case BINARY_MESH_STREAM_TANGENTS   : createInfo.AddTangent(format); break;
+            case BINARY_MESH_STREAM_BITANGENTS : createInfo.AddBitangent(format); break;
+        }
+        // clang-format on
+        bindingStreams.push_back(stream);
+    }
+
+    Result ppxres = Geometry::Create(createInfo, pGeometry);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    // Indices
+    if (GetIndexType() == grfx::INDEX_TYPE_UINT16) {
+        pGeometry->AppendIndicesU16(GetIndexCount(), static_cast<const uint16_t*>(GetStreamData(BINARY_MESH_STREAM_INDICES)));
+    }
+    else if (GetIndexType() == grfx::INDEX_TYPE_UINT32) {
+        pGeometry->AppendIndicesU32(GetIndexCount(), static_cast<const uint32_t*>(GetStreamData(BINARY_MESH_STREAM_INDICES)));
+    }
+
+    // Vertices, one stream per binding
+    for (uint32_t bindingIndex = 0; bindingIndex < CountU32(bindingStreams); ++bindingIndex) {
+        const BinaryMeshStream stream  = bindingStreams[bindingIndex];
+        Geometry::Buffer*      pBuffer = pGeometry->GetVertexBuffer(bindingIndex);
+        if (HasStream(stream)) {
+            pBuffer->Append(static_cast<uint32_t>(GetStreamSize(stream)), static_cast<const char*>(GetStreamData(stream)));
+        }
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result BinaryMesh::CreateMeshletData(MeshletData* pMeshletData) const
+{
+    PPX_ASSERT_NULL_ARG(pMeshletData);
+
+    if (!IsOpen()) {
+        return ppx::ERROR_GEOMETRY_FILE_NO_DATA;
+    }
+    if (!HasStream(BINARY_MESH_STREAM_MESHLETS) || !HasStream(BINARY_MESH_STREAM_MESHLET_BOUNDS)) {
+        return ppx::ERROR_ELEMENT_NOT_FOUND;
+    }
+    if ((GetStreamElementSize(BINARY_MESH_STREAM_MESHLETS) != sizeof(Meshlet)) || (GetStreamElementSize(BINARY_MESH_STREAM_MESHLET_BOUNDS) != sizeof(MeshletBounds))) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    *pMeshletData = MeshletData();
+
+    auto copyStream = [this](BinaryMeshStream stream, auto& dst) {
+        using ElementT = typename std::remove_reference_t<decltype(dst)>::value_type;
+        dst.resize(static_cast<size_t>(GetStreamSize(stream) / sizeof(ElementT)));
+        if (!dst.empty()) {
+            memcpy(dst.data(), GetStreamData(stream), GetStreamSize(stream));
+        }
+    };
+
+    copyStream(BINARY_MESH_STREAM_MESHLETS, pMeshletData->meshlets);
+    copyStream(BINARY_MESH_STREAM_MESHLET_VERTICES, pMeshletData->vertices);
+    copyStream(BINARY_MESH_STREAM_MESHLET_TRIANGLES, pMeshletData->triangles);
+    copyStream(BINARY_MESH_STREAM_MESHLET_BOUNDS, pMeshletData->bounds);
+
+    // Reject meshlets that reference data outside of their streams
+    for (const Meshlet& meshlet : pMeshletData->meshlets) {
+        bool verticesInRange  = (uint64_t(meshlet.vertexOffset) + meshlet.vertexCount) <= pMeshletData->vertices.size();
+        bool trianglesInRange = (uint64_t(meshlet.triangleOffset) + meshlet.triangleCount) <= pMeshletData->triangles.size();
+        if (!verticesInRange || !trianglesInRange) {
+            *pMeshletData = MeshletData();
+            return ppx::ERROR_BAD_DATA_SOURCE;
+        }
+    }
+
+    return ppx::SUCCESS;
+}
+
+} // namespace ppx
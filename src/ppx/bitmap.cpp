@@ -25,11 +25,18 @@
 
 #include "ppx/fs.h"
 
+#include <atomic>
+#include <thread>
+
 namespace ppx {
 
 static const char*  kRadianceSig     = "#?RADIANCE";
 static const size_t kRadianceSigSize = 10;
 
+// Bitmaps smaller than this are processed on the calling thread
+static const uint64_t kParallelPixelThreshold = 256 * 256;
+static const uint32_t kMinRowsPerBand         = 32;
+
 // -------------------------------------------------------------------------------------------------
 // Bitmap
 // -------------------------------------------------------------------------------------------------
@@ -47,6 +54,11 @@ Bitmap::Bitmap(const Bitmap& obj)
     }
 }
 
+Bitmap::Bitmap(Bitmap&& obj) noexcept
+{
+    InternalMove(obj);
+}
+
 Bitmap::~Bitmap()
 {
     FreeStbiDataIfNeeded();
@@ -64,6 +76,14 @@ Bitmap& Bitmap::operator=(const Bitmap& rhs)
     return *this;
 }
 
+Bitmap& Bitmap::operator=(Bitmap&& rhs) noexcept
+{
+    if (&rhs != this) {
+        InternalMove(rhs);
+    }
+    return *this;
+}
+
 void Bitmap::FreeStbiDataIfNeeded()
 {
     if (mDataIsFromStbi && !IsNull(mData)) {
@@ -130,13 +150,13 @@ Result Bitmap::InternalCopy(const Bitmap& obj)
     // In case of copies into a preexisting object.
     FreeStbiDataIfNeeded();
 
-    // Copy properties
+    // Copy properties, the copy is tightly packed even if obj has padded rows
     mWidth        = obj.mWidth;
     mHeight       = obj.mHeight;
     mFormat       = obj.mFormat;
     mChannelCount = obj.mChannelCount;
     mPixelStride  = obj.mPixelStride;
-    mRowStride    = obj.mRowStride;
+    mRowStride    = obj.mWidth * obj.mPixelStride;
 
     // Allocate storage
     size_t footprint = Bitmap::StorageFootprint(mWidth, mHeight, mFormat);
@@ -144,18 +164,48 @@ Result Bitmap::InternalCopy(const Bitmap& obj)
     if (mInternalStorage.size() != footprint) {
         return ppx::ERROR_ALLOCATION_FAILED;
     }
-    mData = mInternalStorage.data();
+    mData = (footprint > 0) ? mInternalStorage.data() : nullptr;
 
-    uint64_t srcFootprint = obj.GetFootprintSize();
-    if (srcFootprint != static_cast<uint64_t>(footprint)) {
-        return ppx::ERROR_BITMAP_FOOTPRINT_MISMATCH;
+    if (IsNull(obj.mData) || IsNull(mData)) {
+        return ppx::SUCCESS;
     }
 
-    memcpy(mData, obj.mData, footprint);
+    if (obj.mRowStride == mRowStride) {
+        memcpy(mData, obj.mData, footprint);
+    }
+    else {
+        const char* pSrc = obj.mData;
+        char*       pDst = mData;
+        for (uint32_t y = 0; y < mHeight; ++y) {
+            memcpy(pDst, pSrc, mRowStride);
+            pSrc += obj.mRowStride;
+            pDst += mRowStride;
+        }
+    }
 
     return ppx::SUCCESS;
 }
 
+void Bitmap::InternalMove(Bitmap& obj)
+{
+    // In case of moves into a preexisting object.
+    FreeStbiDataIfNeeded();
+
+    // Moving the vector keeps its buffer, so mData stays valid
+    mWidth           = obj.mWidth;
+    mHeight          = obj.mHeight;
+    mFormat          = obj.mFormat;
+    mChannelCount    = obj.mChannelCount;
+    mPixelStride     = obj.mPixelStride;
+    mRowStride       = obj.mRowStride;
+    mData            = obj.mData;
+    mDataIsFromStbi  = obj.mDataIsFromStbi;
+    mInternalStorage = std::move(obj.mInternalStorage);
+
+    obj.mDataIsFromStbi = false;
+    obj.InternalCtor();
+}
+
 Result Bitmap::Create(uint32_t width, uint32_t height, Bitmap::Format format, Bitmap* pBitmap)
 {
     PPX_ASSERT_NULL_ARG(pBitmap);
@@ -268,47 +318,31 @@ Result Bitmap::ScaleTo(Bitmap* pTargetBitmap, stbir_filter filterType) const
         return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
     }
 
-    // Format must match
-    if (pTargetBitmap->GetFormat() != mFormat) {
-        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    return BitmapView(*this).ScaleTo(*pTargetBitmap, filterType);
+}
+
+void Bitmap::ParallelForRowBands(uint32_t rowCount, uint64_t pixelCount, const std::function<void(uint32_t, uint32_t)>& fn)
+{
+    if (rowCount == 0) {
+        return;
     }
 
-    // clang-format off
-    stbir_datatype datatype = InvalidValue<stbir_datatype>();
-    switch (ChannelDataType(GetFormat())) {
-        default: break;
-        case Bitmap::DATA_TYPE_UINT8  : datatype = STBIR_TYPE_UINT8; break;
-        case Bitmap::DATA_TYPE_UINT16 : datatype = STBIR_TYPE_UINT16; break;
-        case Bitmap::DATA_TYPE_UINT32 : datatype = STBIR_TYPE_UINT32; break;
-        case Bitmap::DATA_TYPE_FLOAT  : datatype = STBIR_TYPE_FLOAT; break;
+    uint32_t bandCount = 1;
+    if (pixelCount >= kParallelPixelThreshold) {
+        bandCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), std::max(rowCount / kMinRowsPerBand, 1u));
     }
-    // clang-format on
 
-    int res = stbir_resize(
-        static_cast<const void*>(GetData()),
-        static_cast<int>(GetWidth()),
-        static_cast<int>(GetHeight()),
-        static_cast<int>(GetRowStride()),
-        static_cast<void*>(pTargetBitmap->GetData()),
-        static_cast<int>(pTargetBitmap->GetWidth()),
-        static_cast<int>(pTargetBitmap->GetHeight()),
-        static_cast<int>(pTargetBitmap->GetRowStride()),
-        datatype,
-        static_cast<int>(Bitmap::ChannelCount(GetFormat())),
-        -1,
-        0,
-        STBIR_EDGE_CLAMP,
-        STBIR_EDGE_CLAMP,
-        filterType,
-        filterType,
-        STBIR_COLORSPACE_LINEAR,
-        nullptr);
+    const uint32_t rowsPerBand = (rowCount + bandCount - 1) / bandCount;
 
-    if (res == 0) {
-        return ERROR_IMAGE_RESIZE_FAILED;
+    std::vector<std::thread> threads;
+    for (uint32_t firstRow = rowsPerBand; firstRow < rowCount; firstRow += rowsPerBand) {
+        threads.emplace_back(fn, firstRow, std::min(firstRow + rowsPerBand, rowCount));
     }
+    fn(0, std::min(rowsPerBand, rowCount));
 
-    return ppx::SUCCESS;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
 }
 
 char* Bitmap::GetPixelAddress(uint32_t x, uint32_t y)
@@ -674,6 +708,45 @@ Result Bitmap::LoadFile(const std::filesystem::path& path, Bitmap* pBitmap)
     return ppx::SUCCESS;
 }
 
+Result Bitmap::LoadFiles(const std::vector<std::filesystem::path>& paths, std::vector<Bitmap>* pBitmaps)
+{
+    PPX_ASSERT_NULL_ARG(pBitmaps);
+
+    const uint32_t fileCount = CountU32(paths);
+    pBitmaps->clear();
+    pBitmaps->resize(fileCount);
+
+    // Files are handed out one at a time since their sizes can differ a lot
+    std::vector<Result>   results(fileCount, ppx::ERROR_FAILED);
+    std::atomic<uint32_t> nextFile  = 0;
+    auto                  loadFiles = [&]() {
+        for (uint32_t i = nextFile++; i < fileCount; i = nextFile++) {
+            results[i] = LoadFile(paths[i], &(*pBitmaps)[i]);
+        }
+    };
+
+    const uint32_t threadCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), std::max(fileCount, 1u));
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(loadFiles);
+    }
+    loadFiles();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (Result ppxres : results) {
+        if (Failed(ppxres)) {
+            pBitmaps->clear();
+            return ppxres;
+        }
+    }
+
+    return ppx::SUCCESS;
+}
+
 Result Bitmap::SaveFilePNG(const std::filesystem::path& path, const Bitmap* pBitmap)
 {
 #if defined(PPX_ANDROID)
@@ -742,4 +815,134 @@ Result Bitmap::LoadFromMemory(const size_t dataSize, const void* pData, Bitmap*
     return ppx::SUCCESS;
 }
 
+// -------------------------------------------------------------------------------------------------
+// BitmapView
+// -------------------------------------------------------------------------------------------------
+BitmapView::BitmapView(Bitmap& bitmap)
+    : BitmapView(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetFormat(), bitmap.GetRowStride(), bitmap.GetData())
+{
+}
+
+BitmapView::BitmapView(const Bitmap& bitmap)
+    : BitmapView(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetFormat(), bitmap.GetRowStride(), static_cast<const char*>(bitmap.GetData()))
+{
+}
+
+BitmapView::BitmapView(uint32_t width, uint32_t height, Bitmap::Format format, uint32_t rowStride, char* pData)
+    : BitmapView(width, height, format, rowStride, static_cast<const char*>(pData))
+{
+    mReadOnly = false;
+}
+
+BitmapView::BitmapView(uint32_t width, uint32_t height, Bitmap::Format format, uint32_t rowStride, const char* pData)
+    : mWidth(width),
+      mHeight(height),
+      mFormat(format),
+      mPixelStride(Bitmap::FormatSize(format)),
+      mRowStride((rowStride > 0) ? rowStride : width * Bitmap::FormatSize(format)),
+      mData(pData),
+      mReadOnly(true)
+{
+    PPX_ASSERT_MSG(mRowStride >= (mWidth * mPixelStride), "row stride is smaller than width * pixel stride");
+}
+
+bool BitmapView::IsOk() const
+{
+    bool isSizeValid    = (mWidth > 0) && (mHeight > 0);
+    bool isFormatValid  = (mFormat != Bitmap::FORMAT_UNDEFINED);
+    bool isStorageValid = (mData != nullptr);
+    return isSizeValid && isFormatValid && isStorageValid;
+}
+
+char* BitmapView::GetMutableData() const
+{
+    if (mReadOnly) {
+        PPX_ASSERT_MSG(false, "mutable access to a read-only bitmap view");
+        return nullptr;
+    }
+    // Only views created from mutable pixels get here
+    return const_cast<char*>(mData);
+}
+
+const char* BitmapView::GetPixelAddress(uint32_t x, uint32_t y) const
+{
+    const char* pPixel = nullptr;
+    if (!IsNull(mData) && (x < mWidth) && (y < mHeight)) {
+        size_t offset = (static_cast<size_t>(y) * mRowStride) + (static_cast<size_t>(x) * mPixelStride);
+        pPixel        = mData + offset;
+    }
+    return pPixel;
+}
+
+char* BitmapView::GetMutablePixelAddress(uint32_t x, uint32_t y) const
+{
+    if (IsNull(GetMutableData())) {
+        return nullptr;
+    }
+    return const_cast<char*>(GetPixelAddress(x, y));
+}
+
+BitmapView BitmapView::GetSubView(uint32_t x, uint32_t y, uint32_t width, uint32_t height) const
+{
+    // Compare in 64 bits so x + width can't wrap around
+    bool isInside = (static_cast<uint64_t>(x) + width <= mWidth) && (static_cast<uint64_t>(y) + height <= mHeight);
+    if (!IsOk() || !isInside || (width == 0) || (height == 0)) {
+        return BitmapView();
+    }
+
+    BitmapView view = *this;
+    view.mWidth     = width;
+    view.mHeight    = height;
+    view.mData      = GetPixelAddress(x, y);
+    return view;
+}
+
+Result BitmapView::ScaleTo(const BitmapView& target, stbir_filter filterType) const
+{
+    // Format must match
+    if (target.GetFormat() != mFormat) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+    if (target.IsReadOnly()) {
+        return ppx::ERROR_IMAGE_RESIZE_FAILED;
+    }
+
+    // clang-format off
+    stbir_datatype datatype = InvalidValue<stbir_datatype>();
+    switch (Bitmap::ChannelDataType(mFormat)) {
+        default: break;
+        case Bitmap::DATA_TYPE_UINT8  : datatype = STBIR_TYPE_UINT8; break;
+        case Bitmap::DATA_TYPE_UINT16 : datatype = STBIR_TYPE_UINT16; break;
+        case Bitmap::DATA_TYPE_UINT32 : datatype = STBIR_TYPE_UINT32; break;
+        case Bitmap::DATA_TYPE_FLOAT  : datatype = STBIR_TYPE_FLOAT; break;
+    }
+    // clang-format on
+
+    int res = stbir_resize(
+        static_cast<const void*>(mData),
+        static_cast<int>(mWidth),
+        static_cast<int>(mHeight),
+        static_cast<int>(mRowStride),
+        static_cast<void*>(target.GetMutableData()),
+        static_cast<int>(target.GetWidth()),
+        static_cast<int>(target.GetHeight()),
+        static_cast<int>(target.GetRowStride()),
+        datatype,
+        static_cast<int>(Bitmap::ChannelCount(mFormat)),
+        -1,
+        0,
+        STBIR_EDGE_CLAMP,
+        STBIR_EDGE_CLAMP,
+        filterType,
+        filterType,
+        STBIR_COLORSPACE_LINEAR,
+        nullptr);
+
+    if (res == 0) {
+        return ERROR_IMAGE_RESIZE_FAILED;
+    }
+
+    return ppx::SUCCESS;
+}
+
 } // namespace ppx
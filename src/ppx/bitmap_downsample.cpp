@@ -0,0 +1,306 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/bitmap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <type_traits>
+#include <vector>
+
+// SSE2 is part of the x86-64 baseline, other targets use the scalar path
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define PPX_BITMAP_DOWNSAMPLE_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace ppx {
+
+namespace {
+
+// sRGB to linear for each 8-bit value, and linear to sRGB at 16-bit
+// linear precision, which round trips every 8-bit value exactly.
+struct SRGBTables
+{
+    float   toLinear[256];
+    uint8_t toSRGB[65536];
+
+    SRGBTables()
+    {
+        for (uint32_t i = 0; i < 256; ++i) {
+            const float c = i / 255.0f;
+            toLinear[i]   = (c <= 0.04045f) ? (c / 12.92f) : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (uint32_t i = 0; i < 65536; ++i) {
+            const float l = i / 65535.0f;
+            const float c = (l <= 0.0031308f) ? (l * 12.92f) : (1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f);
+            toSRGB[i]     = static_cast<uint8_t>(std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f));
+        }
+    }
+};
+
+const SRGBTables& GetSRGBTables()
+{
+    static const SRGBTables sTables;
+    return sTables;
+}
+
+template <typename T>
+struct Accumulator
+{
+    using Type = uint64_t;
+};
+
+template <>
+struct Accumulator<float>
+{
+    using Type = float;
+};
+
+template <typename T>
+T Average(typename Accumulator<T>::Type sum, uint32_t count)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        return sum / static_cast<float>(count);
+    }
+    else {
+        return static_cast<T>((sum + count / 2) / count);
+    }
+}
+
+// Each target pixel averages xTaps x yTaps source pixels starting at
+// twice its coordinates. Even source sizes use 2 taps, odd sizes use 3
+// so the last row or column isn't dropped.
+template <typename T>
+void DownsampleRowsGeneric(const Bitmap& source, Bitmap* pTarget, uint32_t firstRow, uint32_t endRow, bool sRGB)
+{
+    const uint32_t channelCount = source.GetChannelCount();
+    const uint32_t xTaps        = (source.GetWidth() == 2 * pTarget->GetWidth()) ? 2 : 3;
+    const uint32_t yTaps        = (source.GetHeight() == 2 * pTarget->GetHeight()) ? 2 : 3;
+    const uint32_t tapCount     = xTaps * yTaps;
+
+    // Only 8-bit data is stored as sRGB, alpha stays linear
+    const bool        convertSRGB = sRGB && std::is_same_v<T, uint8_t>;
+    const uint32_t    colorCount  = (channelCount == 4) ? 3 : channelCount;
+    const SRGBTables* pTables     = convertSRGB ? &GetSRGBTables() : nullptr;
+
+    for (uint32_t y = firstRow; y < endRow; ++y) {
+        const char* pSrcRows[3] = {};
+        for (uint32_t ty = 0; ty < yTaps; ++ty) {
+            pSrcRows[ty] = source.GetData() + static_cast<size_t>(2 * y + ty) * source.GetRowStride();
+        }
+        T* pDst = reinterpret_cast<T*>(pTarget->GetData() + static_cast<size_t>(y) * pTarget->GetRowStride());
+
+        for (uint32_t x = 0; x < pTarget->GetWidth(); ++x) {
+            for (uint32_t c = 0; c < channelCount; ++c) {
+                if (convertSRGB && (c < colorCount)) {
+                    float sum = 0;
+                    for (uint32_t ty = 0; ty < yTaps; ++ty) {
+                        const uint8_t* pSrc = reinterpret_cast<const uint8_t*>(pSrcRows[ty]);
+                        for (uint32_t tx = 0; tx < xTaps; ++tx) {
+                            sum += pTables->toLinear[pSrc[(2 * x + tx) * channelCount + c]];
+                        }
+                    }
+                    const float linear         = sum / static_cast<float>(tapCount);
+                    pDst[x * channelCount + c] = static_cast<T>(pTables->toSRGB[static_cast<uint32_t>(linear * 65535.0f + 0.5f)]);
+                    continue;
+                }
+
+                typename Accumulator<T>::Type sum = 0;
+                for (uint32_t ty = 0; ty < yTaps; ++ty) {
+                    const T* pSrc = reinterpret_cast<const T*>(pSrcRows[ty]);
+                    for (uint32_t tx = 0; tx < xTaps; ++tx) {
+                        sum += pSrc[(2 * x + tx) * channelCount + c];
+                    }
+                }
+                pDst[x * channelCount + c] = Average<T>(sum, tapCount);
+            }
+        }
+    }
+}
+
+// Even sizes only. Table lookups don't vectorize, so this is scalar on
+// all targets but avoids the per-channel branches of the generic path.
+void DownsampleRowsSRGBA8(const Bitmap& source, Bitmap* pTarget, uint32_t firstRow, uint32_t endRow)
+{
+    const SRGBTables& tables = GetSRGBTables();
+    const float       scale  = 65535.0f / 4.0f;
+    const uint32_t    width  = pTarget->GetWidth();
+
+    for (uint32_t y = firstRow; y < endRow; ++y) {
+        const uint8_t* pSrc0 = reinterpret_cast<const uint8_t*>(source.GetData() + static_cast<size_t>(2 * y) * source.GetRowStride());
+        const uint8_t* pSrc1 = pSrc0 + source.GetRowStride();
+        uint8_t*       pDst  = reinterpret_cast<uint8_t*>(pTarget->GetData() + static_cast<size_t>(y) * pTarget->GetRowStride());
+
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint8_t* a = pSrc0 + 8 * x;
+            const uint8_t* b = pSrc1 + 8 * x;
+            for (uint32_t c = 0; c < 3; ++c) {
+                const float sum = tables.toLinear[a[c]] + tables.toLinear[a[4 + c]] + tables.toLinear[b[c]] + tables.toLinear[b[4 + c]];
+                pDst[4 * x + c] = tables.toSRGB[static_cast<uint32_t>(sum * scale + 0.5f)];
+            }
+            pDst[4 * x + 3] = static_cast<uint8_t>((a[3] + a[7] + b[3] + b[7] + 2) >> 2);
+        }
+    }
+}
+
+#if defined(PPX_BITMAP_DOWNSAMPLE_SSE2)
+// Even sizes only. 4 target pixels per iteration, sums are 16-bit.
+void DownsampleRowsRGBA8(const Bitmap& source, Bitmap* pTarget, uint32_t firstRow, uint32_t endRow)
+{
+    const __m128i  zero   = _mm_setzero_si128();
+    const __m128i  round  = _mm_set1_epi16(2);
+    const uint32_t width  = pTarget->GetWidth();
+    const uint32_t width4 = width & ~3u;
+
+    for (uint32_t y = firstRow; y < endRow; ++y) {
+        const uint8_t* pSrc0 = reinterpret_cast<const uint8_t*>(source.GetData() + static_cast<size_t>(2 * y) * source.GetRowStride());
+        const uint8_t* pSrc1 = pSrc0 + source.GetRowStride();
+        uint8_t*       pDst  = reinterpret_cast<uint8_t*>(pTarget->GetData() + static_cast<size_t>(y) * pTarget->GetRowStride());
+
+        uint32_t x = 0;
+        for (; x < width4; x += 4) {
+            // 8 source pixels from each row
+            const __m128i a0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + 8 * x));
+            const __m128i a1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc0 + 8 * x + 16));
+            const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + 8 * x));
+            const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrc1 + 8 * x + 16));
+
+            // Vertical sums, 2 pixels per register
+            const __m128i s0 = _mm_add_epi16(_mm_unpacklo_epi8(a0, zero), _mm_unpacklo_epi8(b0, zero));
+            const __m128i s1 = _mm_add_epi16(_mm_unpackhi_epi8(a0, zero), _mm_unpackhi_epi8(b0, zero));
+            const __m128i s2 = _mm_add_epi16(_mm_unpacklo_epi8(a1, zero), _mm_unpacklo_epi8(b1, zero));
+            const __m128i s3 = _mm_add_epi16(_mm_unpackhi_epi8(a1, zero), _mm_unpackhi_epi8(b1, zero));
+
+            // Horizontal sums of neighboring pixels
+            const __m128i h0 = _mm_add_epi16(_mm_unpacklo_epi64(s0, s1), _mm_unpackhi_epi64(s0, s1));
+            const __m128i h1 = _mm_add_epi16(_mm_unpacklo_epi64(s2, s3), _mm_unpackhi_epi64(s2, s3));
+
+            const __m128i r0 = _mm_srli_epi16(_mm_add_epi16(h0, round), 2);
+            const __m128i r1 = _mm_srli_epi16(_mm_add_epi16(h1, round), 2);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pDst + 4 * x), _mm_packus_epi16(r0, r1));
+        }
+
+        for (; x < width; ++x) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                const uint32_t sum = pSrc0[8 * x + c] + pSrc0[8 * x + 4 + c] + pSrc1[8 * x + c] + pSrc1[8 * x + 4 + c];
+                pDst[4 * x + c]    = static_cast<uint8_t>((sum + 2) >> 2);
+            }
+        }
+    }
+}
+
+// Even sizes only
+void DownsampleRowsRGBA32F(const Bitmap& source, Bitmap* pTarget, uint32_t firstRow, uint32_t endRow)
+{
+    const __m128   quarter = _mm_set1_ps(0.25f);
+    const uint32_t width   = pTarget->GetWidth();
+
+    for (uint32_t y = firstRow; y < endRow; ++y) {
+        const float* pSrc0 = reinterpret_cast<const float*>(source.GetData() + static_cast<size_t>(2 * y) * source.GetRowStride());
+        const float* pSrc1 = reinterpret_cast<const float*>(reinterpret_cast<const char*>(pSrc0) + source.GetRowStride());
+        float*       pDst  = reinterpret_cast<float*>(pTarget->GetData() + static_cast<size_t>(y) * pTarget->GetRowStride());
+
+        for (uint32_t x = 0; x < width; ++x) {
+            const __m128 a = _mm_add_ps(_mm_loadu_ps(pSrc0 + 8 * x), _mm_loadu_ps(pSrc0 + 8 * x + 4));
+            const __m128 b = _mm_add_ps(_mm_loadu_ps(pSrc1 + 8 * x), _mm_loadu_ps(pSrc1 + 8 * x + 4));
+            _mm_storeu_ps(pDst + 4 * x, _mm_mul_ps(_mm_add_ps(a, b), quarter));
+        }
+    }
+}
+#endif // defined(PPX_BITMAP_DOWNSAMPLE_SSE2)
+
+} // namespace
+
+Result Bitmap::Downsample(Bitmap* pTargetBitmap, bool sRGB) const
+{
+    if (IsNull(pTargetBitmap)) {
+        return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
+    }
+
+    // Format must match
+    if (pTargetBitmap->GetFormat() != mFormat) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    const uint32_t width  = pTargetBitmap->GetWidth();
+    const uint32_t height = pTargetBitmap->GetHeight();
+    if ((width == 0) || (height == 0) || (width != mWidth / 2) || (height != mHeight / 2)) {
+        return ppx::ERROR_IMAGE_RESIZE_FAILED;
+    }
+    if (IsNull(GetData()) || IsNull(pTargetBitmap->GetData())) {
+        return ppx::ERROR_IMAGE_RESIZE_FAILED;
+    }
+
+    // Specialized paths handle even sizes in the most common formats
+    [[maybe_unused]] const bool isEven = (mWidth == 2 * width) && (mHeight == 2 * height);
+
+    std::function<void(uint32_t, uint32_t)> rowsFn;
+    switch (ChannelDataType(mFormat)) {
+        default: return ppx::ERROR_IMAGE_INVALID_FORMAT;
+
+        case Bitmap::DATA_TYPE_UINT8: {
+            if (isEven && sRGB && (mFormat == Bitmap::FORMAT_RGBA_UINT8)) {
+                rowsFn = [this, pTargetBitmap](uint32_t firstRow, uint32_t endRow) {
+                    DownsampleRowsSRGBA8(*this, pTargetBitmap, firstRow, endRow);
+                };
+                break;
+            }
+#if defined(PPX_BITMAP_DOWNSAMPLE_SSE2)
+            if (isEven && !sRGB && (mFormat == Bitmap::FORMAT_RGBA_UINT8)) {
+                rowsFn = [this, pTargetBitmap](uint32_t firstRow, uint32_t endRow) {
+                    DownsampleRowsRGBA8(*this, pTargetBitmap, firstRow, endRow);
+                };
+                break;
+            }
+#endif
+            rowsFn = [this, pTargetBitmap, sRGB](uint32_t firstRow, uint32_t endRow) {
+                DownsampleRowsGeneric<uint8_t>(*this, pTargetBitmap, firstRow, endRow, sRGB);
+            };
+        } break;
+
+        case Bitmap::DATA_TYPE_UINT16: {
+            rowsFn = [this, pTargetBitmap](uint32_t firstRow, uint32_t endRow) {
+                DownsampleRowsGeneric<uint16_t>(*this, pTargetBitmap, firstRow, endRow, false);
+            };
+        } break;
+
+        case Bitmap::DATA_TYPE_UINT32: {
+            rowsFn = [this, pTargetBitmap](uint32_t firstRow, uint32_t endRow) {
+                DownsampleRowsGeneric<uint32_t>(*this, pTargetBitmap, firstRow, endRow, false);
+            };
+        } break;
+
+        case Bitmap::DATA_TYPE_FLOAT: {
+#if defined(PPX_BITMAP_DOWNSAMPLE_SSE2)
+            if (isEven && (mFormat == Bitmap::FORMAT_RGBA_FLOAT)) {
+                rowsFn = [this, pTargetBitmap](uint32_t firstRow, uint32_t endRow) {
+                    DownsampleRowsRGBA32F(*this, pTargetBitmap, firstRow, endRow);
+                };
+                break;
+            }
+#endif
+            rowsFn = [this, pTargetBitmap](uint32_t firstRow, uint32_t endRow) {
+                DownsampleRowsGeneric<float>(*this, pTargetBitmap, firstRow, endRow, false);
+            };
+        } break;
+    }
+
+    ParallelForRowBands(height, static_cast<uint64_t>(width) * height, rowsFn);
+
+    return ppx::SUCCESS;
+}
+
+} // namespace ppx
@@ -44,14 +44,13 @@ ppx::Result Font::CreateFromFile(const std::filesystem::path& path, ppx::Font* p
         return ppx::ERROR_PATH_DOES_NOT_EXIST;
     }
 
-    std::ifstream is(path.c_str(), std::ios::binary);
-    if (!is.is_open()) {
+    // Through ppx::fs so fonts can come from asset packs
+    ppx::fs::File file;
+    if (!file.Open(path)) {
         return ppx::ERROR_BAD_DATA_SOURCE;
     }
 
-    is.seekg(0, std::ios::end);
-    size_t size = is.tellg();
-    is.seekg(0, std::ios::beg);
+    size_t size = file.GetLength();
 
     auto object = std::make_shared<Font::Object>();
     if (!object) {
@@ -59,7 +58,9 @@ ppx::Result Font::CreateFromFile(const std::filesystem::path& path, ppx::Font* p
     }
 
     object->fontData.resize(size);
-    is.read(reinterpret_cast<char*>(object->fontData.data()), size);
+    if (file.Read(object->fontData.data(), size) != size) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
 
     int stbres = stbtt_InitFont(&object->fontInfo, object->fontData.data(), 0);
     if (stbres == 0) {
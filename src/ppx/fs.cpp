@@ -15,14 +15,26 @@
 #include "ppx/fs.h"
 #include "ppx/config.h"
 
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
+#include <mutex>
 #include <regex>
 #include <optional>
+#include <set>
+#include <string>
 #include <vector>
 
 #if defined(PPX_ANDROID)
 #include <android_native_app_glue.h>
 android_app* gAndroidContext;
+#elif defined(PPX_MSW)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #endif
 
 namespace ppx::fs {
@@ -34,6 +46,254 @@ void set_android_context(android_app* androidContext)
 }
 #endif
 
+// -------------------------------------------------------------------------------------------------
+// Asset packs
+//
+// Layout, little endian:
+//   PackHeader
+//   PackEntry[entryCount]   sorted by (pathHash, path)
+//   string table            UTF-8 paths relative to the pack root, '/' separated
+//   file contents           each aligned to kPackDataAlignment
+//
+// tools/pack_assets.py writes this layout, keep the two in sync.
+// -------------------------------------------------------------------------------------------------
+namespace {
+
+constexpr char     kPackMagic[8]      = {'P', 'P', 'X', 'P', 'A', 'C', 'K', '\0'};
+constexpr uint32_t kPackVersion       = 1;
+constexpr uint64_t kPackDataAlignment = 64;
+
+struct PackHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t entryCount;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+};
+
+struct PackEntry
+{
+    uint64_t pathHash;
+    uint64_t dataOffset;
+    uint64_t dataSize;
+    uint32_t pathOffset;
+    uint32_t pathLength;
+};
+
+static_assert(sizeof(PackHeader) == 32, "PackHeader must match the on-disk layout");
+static_assert(sizeof(PackEntry) == 32, "PackEntry must match the on-disk layout");
+
+// FNV-1a, simple enough for the pack tool to reproduce
+uint64_t HashPackPath(const std::string& path)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (char c : path) {
+        hash ^= static_cast<uint8_t>(c);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// Paths are compared as normalized generic strings
+std::string NormalizePackPath(const std::filesystem::path& path)
+{
+    std::string normalized = path.lexically_normal().generic_string();
+    while ((normalized.size() > 1) && (normalized.back() == '/')) {
+        normalized.pop_back();
+    }
+    return (normalized == ".") ? std::string() : normalized;
+}
+
+class Pack
+{
+public:
+    bool Open(const std::filesystem::path& packPath, const std::filesystem::path& mountPoint)
+    {
+        mPackPath   = NormalizePackPath(packPath);
+        mMountPoint = NormalizePackPath(mountPoint);
+
+        if (!mFile.OpenMapped(packPath) || !mFile.IsMapped()) {
+            return false;
+        }
+
+        const char*  pData = static_cast<const char*>(mFile.GetMappedData());
+        const size_t size  = mFile.GetLength();
+        if (size < sizeof(PackHeader)) {
+            return false;
+        }
+
+        PackHeader header = {};
+        memcpy(&header, pData, sizeof(header));
+        if ((memcmp(header.magic, kPackMagic, sizeof(kPackMagic)) != 0) || (header.version != kPackVersion)) {
+            return false;
+        }
+
+        const uint64_t indexEnd = sizeof(PackHeader) + static_cast<uint64_t>(header.entryCount) * sizeof(PackEntry);
+        if ((indexEnd > size) || (header.stringTableOffset < indexEnd) || (header.stringTableSize > size - header.stringTableOffset)) {
+            return false;
+        }
+
+        mEntries     = reinterpret_cast<const PackEntry*>(pData + sizeof(PackHeader));
+        mEntryCount  = header.entryCount;
+        mStringTable = pData + header.stringTableOffset;
+
+        for (uint32_t i = 0; i < mEntryCount; ++i) {
+            const PackEntry& entry       = mEntries[i];
+            const bool       isValidData = (entry.dataOffset <= size) && (entry.dataSize <= size - entry.dataOffset);
+            const bool       isValidPath = (static_cast<uint64_t>(entry.pathOffset) + entry.pathLength <= header.stringTableSize);
+            if (!isValidData || !isValidPath) {
+                return false;
+            }
+
+            // Parent directories of every file, for path_exists()
+            const std::string path = GetPath(entry);
+            for (size_t slash = path.find('/'); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+                mDirectories.insert(path.substr(0, slash));
+            }
+        }
+
+        return true;
+    }
+
+    const std::string& GetPackPath() const { return mPackPath; }
+
+    // Returns the path relative to the pack root if path is under the mount point
+    std::optional<std::string> GetRelativePath(const std::string& path) const
+    {
+        if (mMountPoint.empty()) {
+            return path;
+        }
+        if (path == mMountPoint) {
+            return std::string();
+        }
+        if ((path.size() > mMountPoint.size()) && (path.compare(0, mMountPoint.size(), mMountPoint) == 0) && (path[mMountPoint.size()] == '/')) {
+            return path.substr(mMountPoint.size() + 1);
+        }
+        return std::nullopt;
+    }
+
+    const PackEntry* FindFile(const std::string& relativePath) const
+    {
+        const uint64_t   hash  = HashPackPath(relativePath);
+        const PackEntry* pEnd  = mEntries + mEntryCount;
+        const PackEntry* pIter = std::lower_bound(
+            mEntries,
+            pEnd,
+            hash,
+            [](const PackEntry& entry, uint64_t value) { return entry.pathHash < value; });
+
+        for (; (pIter != pEnd) && (pIter->pathHash == hash); ++pIter) {
+            if ((pIter->pathLength == relativePath.size()) && (memcmp(mStringTable + pIter->pathOffset, relativePath.data(), relativePath.size()) == 0)) {
+                return pIter;
+            }
+        }
+        return nullptr;
+    }
+
+    bool HasDirectory(const std::string& relativePath) const
+    {
+        return relativePath.empty() || (mDirectories.find(relativePath) != mDirectories.end());
+    }
+
+    const void* GetData(const PackEntry& entry) const
+    {
+        return static_cast<const char*>(mFile.GetMappedData()) + entry.dataOffset;
+    }
+
+private:
+    std::string GetPath(const PackEntry& entry) const
+    {
+        return std::string(mStringTable + entry.pathOffset, entry.pathLength);
+    }
+
+private:
+    std::string           mPackPath;
+    std::string           mMountPoint;
+    File                  mFile;
+    const PackEntry*      mEntries     = nullptr;
+    uint32_t              mEntryCount  = 0;
+    const char*           mStringTable = nullptr;
+    std::set<std::string> mDirectories;
+};
+
+std::mutex                         sPacksMutex;
+std::vector<std::shared_ptr<Pack>> sPacks; // Most recently mounted last
+
+// Returns the pack serving the file at path, newest pack first
+std::shared_ptr<Pack> FindPackedFile(const std::filesystem::path& path, const PackEntry** ppEntry)
+{
+    std::lock_guard<std::mutex> lock(sPacksMutex);
+    if (sPacks.empty()) {
+        return nullptr;
+    }
+
+    const std::string normalized = NormalizePackPath(path);
+    for (auto it = sPacks.rbegin(); it != sPacks.rend(); ++it) {
+        std::optional<std::string> relativePath = (*it)->GetRelativePath(normalized);
+        if (!relativePath.has_value()) {
+            continue;
+        }
+        const PackEntry* pEntry = (*it)->FindFile(relativePath.value());
+        if (!IsNull(pEntry)) {
+            *ppEntry = pEntry;
+            return *it;
+        }
+    }
+    return nullptr;
+}
+
+bool PackedPathExists(const std::filesystem::path& path)
+{
+    std::lock_guard<std::mutex> lock(sPacksMutex);
+    if (sPacks.empty()) {
+        return false;
+    }
+
+    const std::string normalized = NormalizePackPath(path);
+    for (const auto& pack : sPacks) {
+        std::optional<std::string> relativePath = pack->GetRelativePath(normalized);
+        if (relativePath.has_value() && (pack->HasDirectory(relativePath.value()) || !IsNull(pack->FindFile(relativePath.value())))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+bool IsPackFile(const std::filesystem::path& path)
+{
+    return path.extension() == ".ppxpack";
+}
+
+bool MountPack(const std::filesystem::path& packPath, const std::filesystem::path& mountPoint)
+{
+    auto pack = std::make_shared<Pack>();
+    if (!pack->Open(packPath, mountPoint)) {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(sPacksMutex);
+    sPacks.push_back(pack);
+    return true;
+}
+
+void UnmountPack(const std::filesystem::path& packPath)
+{
+    const std::string normalized = NormalizePackPath(packPath);
+
+    std::lock_guard<std::mutex> lock(sPacksMutex);
+    sPacks.erase(
+        std::remove_if(
+            sPacks.begin(),
+            sPacks.end(),
+            [&normalized](const std::shared_ptr<Pack>& pack) { return pack->GetPackPath() == normalized; }),
+        sPacks.end());
+}
+
+// -------------------------------------------------------------------------------------------------
+
 File::File()
     : mHandleType(BAD_HANDLE)
 {
@@ -52,13 +312,42 @@ File::~File()
         case STREAM_HANDLE:
             mStream.close();
             break;
+        case MAPPED_HANDLE:
+#if defined(PPX_MSW)
+            UnmapViewOfFile(mMapping);
+#elif !defined(PPX_ANDROID)
+            munmap(mMapping, mFileSize);
+#else
+            PPX_ASSERT_MSG(false, "Bad implem. This case should never be reached.");
+#endif
+            break;
         default:
             break;
     }
 }
 
+bool File::OpenFromPack(const std::filesystem::path& path)
+{
+    const PackEntry*      pEntry = nullptr;
+    std::shared_ptr<Pack> pack   = FindPackedFile(path, &pEntry);
+    if (!pack) {
+        return false;
+    }
+
+    mPack       = pack;
+    mBuffer     = pack->GetData(*pEntry);
+    mFileSize   = static_cast<size_t>(pEntry->dataSize);
+    mFileOffset = 0;
+    mHandleType = PACK_HANDLE;
+    return true;
+}
+
 bool File::Open(const std::filesystem::path& path)
 {
+    if (OpenFromPack(path)) {
+        return true;
+    }
+
 #if defined(PPX_ANDROID)
     if (!path.is_absolute()) {
         mAsset      = AAssetManager_open(gAndroidContext->activity->assetManager, path.c_str(), AASSET_MODE_BUFFER);
@@ -83,11 +372,70 @@ bool File::Open(const std::filesystem::path& path)
     return true;
 }
 
+bool File::OpenMapped(const std::filesystem::path& path)
+{
+    if (OpenFromPack(path)) {
+        return true;
+    }
+
+#if defined(PPX_ANDROID)
+    // Assets are already mapped by the asset manager.
+    return Open(path);
+#else
+    void*  mapping  = nullptr;
+    size_t fileSize = 0;
+#if defined(PPX_MSW)
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file != INVALID_HANDLE_VALUE) {
+        LARGE_INTEGER size = {};
+        if (GetFileSizeEx(file, &size) && (size.QuadPart > 0)) {
+            HANDLE fileMapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (fileMapping != nullptr) {
+                mapping  = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+                fileSize = static_cast<size_t>(size.QuadPart);
+                // The view keeps the mapping alive.
+                CloseHandle(fileMapping);
+            }
+        }
+        CloseHandle(file);
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd != -1) {
+        struct stat info = {};
+        if ((fstat(fd, &info) == 0) && S_ISREG(info.st_mode) && (info.st_size > 0)) {
+            mapping = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                mapping = nullptr;
+            }
+            fileSize = static_cast<size_t>(info.st_size);
+        }
+        // The mapping keeps a reference to the file.
+        close(fd);
+    }
+#endif
+
+    if (mapping == nullptr) {
+        return Open(path);
+    }
+
+    mMapping    = mapping;
+    mBuffer     = mapping;
+    mFileSize   = fileSize;
+    mFileOffset = 0;
+    mHandleType = MAPPED_HANDLE;
+    return true;
+#endif
+}
+
 bool File::IsValid() const
 {
     if (mHandleType == STREAM_HANDLE) {
         return mStream.good();
     }
+    if ((mHandleType == MAPPED_HANDLE) || (mHandleType == PACK_HANDLE)) {
+        return mBuffer != nullptr;
+    }
     return mHandleType == ASSET_HANDLE && mAsset != nullptr;
 }
 
@@ -158,6 +506,10 @@ std::optional<std::vector<char>> load_file(const std::filesystem::path& path)
 
 bool path_exists(const std::filesystem::path& path)
 {
+    if (PackedPathExists(path)) {
+        return true;
+    }
+
 #if defined(PPX_ANDROID)
     if (!path.is_absolute()) {
         AAsset* temp_file = AAssetManager_open(gAndroidContext->activity->assetManager, path.c_str(), AASSET_MODE_BUFFER);
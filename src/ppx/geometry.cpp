@@ -410,6 +410,107 @@ static VertexDataProcessorInterleaved<TriMeshVertexDataCompressed>    sVDProcess
 static VertexDataProcessorPositionPlanar<TriMeshVertexData>           sVDProcessorPositionPlanar;
 static VertexDataProcessorPositionPlanar<TriMeshVertexDataCompressed> sVDProcessorPositionPlanarCompressed;
 
+// -------------------------------------------------------------------------------------------------
+// Bulk TriMesh attribute writers
+//     Used by Geometry::Create(createInfo, TriMesh) to write each attribute stream of a mesh
+//     in one tight loop instead of going through VertexDataProcessor per vertex.
+// -------------------------------------------------------------------------------------------------
+namespace {
+
+// Source data for a single vertex attribute stream. pData is null if the mesh does not have
+// the attribute, in which case zeros are written - same as a default TriMeshVertexData.
+struct TriMeshAttributeStream
+{
+    const char* pData       = nullptr;
+    uint32_t    elementSize = 0;
+};
+
+// Vertex i maps to mesh vertex i
+struct SequentialVertexIndex
+{
+    uint32_t operator()(uint32_t i) const { return i; }
+};
+
+// Vertex i maps to mesh vertex pIndices[i]
+template <typename IndexT>
+struct IndexedVertexIndex
+{
+    const IndexT* pIndices = nullptr;
+
+    uint32_t operator()(uint32_t i) const { return static_cast<uint32_t>(pIndices[i]); }
+};
+
+// Calls fn with the vertex index functor matching indexType
+template <typename Fn>
+void DispatchVertexIndex(grfx::IndexType indexType, const void* pIndices, Fn fn)
+{
+    switch (indexType) {
+        default: fn(SequentialVertexIndex{}); break;
+        case grfx::INDEX_TYPE_UINT16: fn(IndexedVertexIndex<uint16_t>{static_cast<const uint16_t*>(pIndices)}); break;
+        case grfx::INDEX_TYPE_UINT32: fn(IndexedVertexIndex<uint32_t>{static_cast<const uint32_t*>(pIndices)}); break;
+    }
+}
+
+template <uint32_t ElementSize, typename VertexIndexFn>
+void WriteAttributeStream(const char* pSrc, char* pDst, uint32_t dstStride, uint32_t vertexCount, VertexIndexFn vertexIndex)
+{
+    if (IsNull(pSrc)) {
+        for (uint32_t i = 0; i < vertexCount; ++i, pDst += dstStride) {
+            std::memset(pDst, 0, ElementSize);
+        }
+        return;
+    }
+
+    for (uint32_t i = 0; i < vertexCount; ++i, pDst += dstStride) {
+        const char* pSrcElement = pSrc + static_cast<size_t>(vertexIndex(i)) * ElementSize;
+        std::memcpy(pDst, pSrcElement, ElementSize);
+    }
+}
+
+template <typename VertexIndexFn>
+void WriteAttributeStream(const TriMeshAttributeStream& stream, char* pDst, uint32_t dstStride, uint32_t vertexCount, VertexIndexFn vertexIndex)
+{
+    // clang-format off
+    switch (stream.elementSize) {
+        default             : PPX_ASSERT_MSG(false, "unsupported attribute element size"); break;
+        case sizeof(float2) : WriteAttributeStream<sizeof(float2)>(stream.pData, pDst, dstStride, vertexCount, vertexIndex); break;
+        case sizeof(float3) : WriteAttributeStream<sizeof(float3)>(stream.pData, pDst, dstStride, vertexCount, vertexIndex); break;
+        case sizeof(float4) : WriteAttributeStream<sizeof(float4)>(stream.pData, pDst, dstStride, vertexCount, vertexIndex); break;
+    }
+    // clang-format on
+}
+
+template <typename DstIndexT, typename VertexIndexFn>
+void WriteIndexStream(char* pDst, uint32_t count, VertexIndexFn vertexIndex)
+{
+    DstIndexT* pDstIndices = reinterpret_cast<DstIndexT*>(pDst);
+    for (uint32_t i = 0; i < count; ++i) {
+        pDstIndices[i] = static_cast<DstIndexT>(vertexIndex(i));
+    }
+}
+
+// Returns the attribute stream for semantic from mesh. Element size is 0 if
+// the semantic isn't something a TriMesh can provide.
+TriMeshAttributeStream GetTriMeshAttributeStream(const TriMesh& mesh, grfx::VertexSemantic semantic)
+{
+    TriMeshAttributeStream stream = {};
+    // clang-format off
+    switch (semantic) {
+        default: break;
+        case grfx::VERTEX_SEMANTIC_POSITION  : stream = {reinterpret_cast<const char*>(mesh.GetDataPositions()),  sizeof(TriMeshVertexData::position)}; break;
+        case grfx::VERTEX_SEMANTIC_NORMAL    : stream = {reinterpret_cast<const char*>(mesh.GetDataNormalls()),   sizeof(TriMeshVertexData::normal)}; break;
+        case grfx::VERTEX_SEMANTIC_COLOR     : stream = {reinterpret_cast<const char*>(mesh.GetDataColors()),     sizeof(TriMeshVertexData::color)}; break;
+        case grfx::VERTEX_SEMANTIC_TANGENT   : stream = {reinterpret_cast<const char*>(mesh.GetDataTangents()),   sizeof(TriMeshVertexData::tangent)}; break;
+        case grfx::VERTEX_SEMANTIC_BITANGENT : stream = {reinterpret_cast<const char*>(mesh.GetDataBitangents()), sizeof(TriMeshVertexData::bitangent)}; break;
+        // Only 2-dimensional tex coords are part of TriMeshVertexData
+        case grfx::VERTEX_SEMANTIC_TEXCOORD  : stream = {reinterpret_cast<const char*>(mesh.GetDataTexCoords2()), sizeof(TriMeshVertexData::texCoord)}; break;
+    }
+    // clang-format on
+    return stream;
+}
+
+} // namespace
+
 // -------------------------------------------------------------------------------------------------
 // GeometryCreateInfo
 // -------------------------------------------------------------------------------------------------
@@ -719,64 +820,32 @@ Result Geometry::Create(
         return ppxres;
     }
 
+    // Mesh index data, if the mesh has any
+    const grfx::IndexType meshIndexType = mesh.GetIndexType();
+    const void*           pMeshIndices  = nullptr;
+    if (mesh.GetCountTriangles() > 0) {
+        if (meshIndexType == grfx::INDEX_TYPE_UINT16) {
+            pMeshIndices = mesh.GetDataIndicesU16();
+        }
+        else if (meshIndexType == grfx::INDEX_TYPE_UINT32) {
+            pMeshIndices = mesh.GetDataIndicesU32();
+        }
+    }
+
     //
     // Target geometry WITHOUT index data
     //
     if (createInfo.indexType == grfx::INDEX_TYPE_UNDEFINED) {
         // Mesh has index data
-        if (mesh.GetIndexType() != grfx::INDEX_TYPE_UNDEFINED) {
-            // Iterate through the meshes triangles and add vertex data for each triangle vertex
-            uint32_t triCount = mesh.GetCountTriangles();
-            for (uint32_t triIndex = 0; triIndex < triCount; ++triIndex) {
-                uint32_t vtxIndex0 = PPX_VALUE_IGNORED;
-                uint32_t vtxIndex1 = PPX_VALUE_IGNORED;
-                uint32_t vtxIndex2 = PPX_VALUE_IGNORED;
-                ppxres             = mesh.GetTriangle(triIndex, vtxIndex0, vtxIndex1, vtxIndex2);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting triangle indices at triIndex=" << triIndex);
-                    return ppxres;
-                }
-
-                // First vertex
-                TriMeshVertexData vertexData0 = {};
-                ppxres                        = mesh.GetVertexData(vtxIndex0, &vertexData0);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vtxIndex0=" << vtxIndex0);
-                    return ppxres;
-                }
-                // Second vertex
-                TriMeshVertexData vertexData1 = {};
-                ppxres                        = mesh.GetVertexData(vtxIndex1, &vertexData1);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vtxIndex1=" << vtxIndex1);
-                    return ppxres;
-                }
-                // Third vertex
-                TriMeshVertexData vertexData2 = {};
-                ppxres                        = mesh.GetVertexData(vtxIndex2, &vertexData2);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vtxIndex2=" << vtxIndex2);
-                    return ppxres;
-                }
-
-                pGeometry->AppendVertexData(vertexData0);
-                pGeometry->AppendVertexData(vertexData1);
-                pGeometry->AppendVertexData(vertexData2);
-            }
+        if (meshIndexType != grfx::INDEX_TYPE_UNDEFINED) {
+            // Expand the meshes triangles into vertex data for each triangle vertex
+            const uint32_t vertexCount = 3 * mesh.GetCountTriangles();
+            ppxres                     = pGeometry->WriteVertexData(mesh, vertexCount, meshIndexType, pMeshIndices);
         }
         // Mesh does not have index data
         else {
-            // Iterate through the meshes vertx data and add it to the geometry
-            uint32_t vertexCount = mesh.GetCountPositions();
-            for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
-                TriMeshVertexData vertexData = {};
-                ppxres                       = mesh.GetVertexData(vertexIndex, &vertexData);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vertexIndex=" << vertexIndex);
-                    return ppxres;
-                }
-                pGeometry->AppendVertexData(vertexData);
-            }
+            // Copy the meshes vertex data as is
+            ppxres = pGeometry->WriteVertexData(mesh, mesh.GetCountPositions(), grfx::INDEX_TYPE_UNDEFINED, nullptr);
         }
     }
     //
@@ -784,70 +853,25 @@ Result Geometry::Create(
     //
     else {
         // Mesh has index data
-        if (mesh.GetIndexType() != grfx::INDEX_TYPE_UNDEFINED) {
-            // Iterate the meshes triangles and add the vertex indices
-            uint32_t triCount = mesh.GetCountTriangles();
-            for (uint32_t triIndex = 0; triIndex < triCount; ++triIndex) {
-                uint32_t v0     = PPX_VALUE_IGNORED;
-                uint32_t v1     = PPX_VALUE_IGNORED;
-                uint32_t v2     = PPX_VALUE_IGNORED;
-                Result   ppxres = mesh.GetTriangle(triIndex, v0, v1, v2);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "couldn't get triangle at triIndex=" << triIndex);
-                    return ppxres;
-                }
-                pGeometry->AppendIndicesTriangle(v0, v1, v2);
-            }
-
-            // Iterate through the meshes vertx data and add it to the geometry
-            uint32_t vertexCount = mesh.GetCountPositions();
-            for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
-                TriMeshVertexData vertexData = {};
-                ppxres                       = mesh.GetVertexData(vertexIndex, &vertexData);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vertexIndex=" << vertexIndex);
-                    return ppxres;
-                }
-                pGeometry->AppendVertexData(vertexData);
-            }
+        if (meshIndexType != grfx::INDEX_TYPE_UNDEFINED) {
+            // Copy the meshes triangle indices and vertex data as is
+            pGeometry->WriteIndexData(3 * mesh.GetCountTriangles(), meshIndexType, pMeshIndices);
+            ppxres = pGeometry->WriteVertexData(mesh, mesh.GetCountPositions(), grfx::INDEX_TYPE_UNDEFINED, nullptr);
         }
         // Mesh does not have index data
         else {
             // Use every 3 vertices as a triangle and add each as an indexed triangle
-            uint32_t triCount = mesh.GetCountPositions() / 3;
-            for (uint32_t triIndex = 0; triIndex < triCount; ++triIndex) {
-                uint32_t vtxIndex0 = 3 * triIndex + 0;
-                uint32_t vtxIndex1 = 3 * triIndex + 1;
-                uint32_t vtxIndex2 = 3 * triIndex + 2;
-
-                // First vertex
-                TriMeshVertexData vertexData0 = {};
-                ppxres                        = mesh.GetVertexData(vtxIndex0, &vertexData0);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vtxIndex0=" << vtxIndex0);
-                    return ppxres;
-                }
-                // Second vertex
-                TriMeshVertexData vertexData1 = {};
-                ppxres                        = mesh.GetVertexData(vtxIndex1, &vertexData1);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vtxIndex1=" << vtxIndex1);
-                    return ppxres;
-                }
-                // Third vertex
-                TriMeshVertexData vertexData2 = {};
-                ppxres                        = mesh.GetVertexData(vtxIndex2, &vertexData2);
-                if (Failed(ppxres)) {
-                    PPX_ASSERT_MSG(false, "failed getting vertex data at vtxIndex2=" << vtxIndex2);
-                    return ppxres;
-                }
-
-                // Will append indices if geometry has index buffer
-                pGeometry->AppendTriangle(vertexData0, vertexData1, vertexData2);
-            }
+            const uint32_t vertexCount = 3 * (mesh.GetCountPositions() / 3);
+            pGeometry->WriteIndexData(vertexCount, grfx::INDEX_TYPE_UNDEFINED, nullptr);
+            ppxres = pGeometry->WriteVertexData(mesh, vertexCount, grfx::INDEX_TYPE_UNDEFINED, nullptr);
         }
     }
 
+    if (Failed(ppxres)) {
+        PPX_ASSERT_MSG(false, "failed writing vertex data from mesh");
+        return ppxres;
+    }
+
     return ppx::SUCCESS;
 }
 
@@ -1031,6 +1055,68 @@ Result Geometry::Create(const WireMesh& mesh, Geometry* pGeometry)
     return ppx::SUCCESS;
 }
 
+Result Geometry::WriteVertexData(const TriMesh& mesh, uint32_t vertexCount, grfx::IndexType srcIndexType, const void* pSrcIndices)
+{
+    for (uint32_t bindingIndex = 0; bindingIndex < mCreateInfo.vertexBindingCount; ++bindingIndex) {
+        const grfx::VertexBinding& binding = mCreateInfo.vertexBindings[bindingIndex];
+        const uint32_t             stride  = binding.GetStride();
+
+        // Vertex buffers are created in binding order for all attribute layouts
+        Geometry::Buffer& buffer = mVertexBuffers[bindingIndex];
+        buffer.SetSize(vertexCount * stride);
+
+        // Write each attribute stream, attributes are packed in the order they were added
+        uint32_t offset = 0;
+        for (uint32_t attrIndex = 0; attrIndex < binding.GetAttributeCount(); ++attrIndex) {
+            const grfx::VertexAttribute* pAttribute = nullptr;
+            binding.GetAttribute(attrIndex, &pAttribute);
+
+            TriMeshAttributeStream stream = GetTriMeshAttributeStream(mesh, pAttribute->semantic);
+            if (stream.elementSize == 0) {
+                return ppx::ERROR_GEOMETRY_INVALID_VERTEX_SEMANTIC;
+            }
+            if ((offset + stream.elementSize) > stride) {
+                PPX_ASSERT_MSG(false, "size of vertex data written does not match buffer's element size");
+                return ppx::ERROR_GRFX_INVALID_VERTEX_ATTRIBUTE_STRIDE;
+            }
+
+            char* pDst = buffer.GetData() + offset;
+            DispatchVertexIndex(srcIndexType, pSrcIndices, [&](auto vertexIndex) {
+                WriteAttributeStream(stream, pDst, stride, vertexCount, vertexIndex);
+            });
+
+            offset += stream.elementSize;
+        }
+
+        if (offset != stride) {
+            PPX_ASSERT_MSG(false, "size of vertex data written does not match buffer's element size");
+            return ppx::ERROR_GRFX_INVALID_VERTEX_ATTRIBUTE_STRIDE;
+        }
+    }
+
+    return ppx::SUCCESS;
+}
+
+void Geometry::WriteIndexData(uint32_t count, grfx::IndexType srcIndexType, const void* pSrcIndices)
+{
+    if (mCreateInfo.indexType == grfx::INDEX_TYPE_UNDEFINED) {
+        return;
+    }
+
+    const uint32_t elementSize = mIndexBuffer.GetElementSize();
+    mIndexBuffer.SetSize(count * elementSize);
+
+    char* pDst = mIndexBuffer.GetData();
+    DispatchVertexIndex(srcIndexType, pSrcIndices, [&](auto vertexIndex) {
+        if (mCreateInfo.indexType == grfx::INDEX_TYPE_UINT16) {
+            WriteIndexStream<uint16_t>(pDst, count, vertexIndex);
+        }
+        else {
+            WriteIndexStream<uint32_t>(pDst, count, vertexIndex);
+        }
+    });
+}
+
 const grfx::VertexBinding* Geometry::GetVertexBinding(uint32_t index) const
 {
     const grfx::VertexBinding* pBinding = nullptr;
@@ -1119,6 +1205,15 @@ void Geometry::AppendIndicesEdge(uint32_t idx0, uint32_t idx1)
     }
 }
 
+void Geometry::AppendIndicesU16(uint32_t count, const uint16_t* pIndices)
+{
+    if (mCreateInfo.indexType != grfx::INDEX_TYPE_UINT16) {
+        PPX_ASSERT_MSG(false, "Invalid geometry index type, trying to append UINT16 data to non-UINT16 indices");
+        return;
+    }
+    mIndexBuffer.Append(count, pIndices);
+}
+
 void Geometry::AppendIndicesU32(uint32_t count, const uint32_t* pIndices)
 {
     if (mCreateInfo.indexType == grfx::INDEX_TYPE_UINT16) {
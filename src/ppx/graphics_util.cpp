@@ -18,6 +18,7 @@
 #include "ppx/bitmap.h"
 #include "ppx/fs.h"
 #include "ppx/mipmap.h"
+#include "ppx/texture_compression.h"
 #include "ppx/timer.h"
 #include "ppx/grfx/grfx_buffer.h"
 #include "ppx/grfx/grfx_command.h"
@@ -85,44 +86,89 @@ grfx::Format ToGrfxFormat(gli::format value)
 
 // -------------------------------------------------------------------------------------------------
 
-Result CopyBitmapToImage(
-    grfx::Queue*        pQueue,
-    const Bitmap*       pBitmap,
-    grfx::Image*        pImage,
-    uint32_t            mipLevel,
-    uint32_t            arrayLayer,
-    grfx::ResourceState stateBefore,
-    grfx::ResourceState stateAfter)
+Result CopyBitmapsToImage(
+    grfx::Queue*                          pQueue,
+    const std::vector<BitmapSubresource>& subresources,
+    grfx::Image*                          pImage,
+    grfx::ResourceState                   stateBefore,
+    grfx::ResourceState                   stateAfter)
 {
     PPX_ASSERT_NULL_ARG(pQueue);
-    PPX_ASSERT_NULL_ARG(pBitmap);
     PPX_ASSERT_NULL_ARG(pImage);
 
     Result ppxres = ppx::ERROR_FAILED;
 
+    if (subresources.empty()) {
+        return ppx::ERROR_BITMAP_BAD_COPY_SOURCE;
+    }
+    for (const BitmapSubresource& subresource : subresources) {
+        if (!subresource.bitmap.IsOk()) {
+            return ppx::ERROR_BITMAP_BAD_COPY_SOURCE;
+        }
+    }
+
     // Scoped destroy
     grfx::ScopeDestroyer SCOPED_DESTROYER(pQueue->GetDevice());
 
-    // This is the number of bytes we're going to copy per row.
-    uint32_t rowCopySize = pBitmap->GetWidth() * pBitmap->GetPixelStride();
-
     // When copying from a buffer to a image/texture, D3D12 requires that the rows
-    // stored in the source buffer (aka staging buffer) are aligned to 256 bytes.
-    // Vulkan does not have this requirement. So for the staging buffer, we want
-    // to enforce the alignment for D3D12 but not for Vulkan.
+    // stored in the source buffer (aka staging buffer) are aligned to 256 bytes
+    // and that each region starts on a 512 byte boundary. Vulkan does not have
+    // these requirements. So for the staging buffer, we want to enforce the
+    // alignments for D3D12 but not for Vulkan.
     //
-    uint32_t apiRowStrideAligement = grfx::IsDx12(pQueue->GetDevice()->GetApi()) ? PPX_D3D12_TEXTURE_DATA_PITCH_ALIGNMENT : 1;
-    // The staging buffer's row stride alignemnt needs to be based off the bitmap's
-    // width (i.e. the number of bytes we're going to copy) and not the bitmap's row
-    // stride. The bitmap's may be padded beyond width * pixel stride.
+    const bool     isDx12             = grfx::IsDx12(pQueue->GetDevice()->GetApi());
+    const uint32_t rowStrideAlignment = isDx12 ? PPX_D3D12_TEXTURE_DATA_PITCH_ALIGNMENT : 1;
+    const uint32_t offsetAlignment    = isDx12 ? PPX_D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT : 1;
+
+    // Lay out the regions in the staging buffer and build their copy infos.
+    // The staging buffer's row stride alignemnt needs to be based off the
+    // bitmap's width (i.e. the number of bytes we're going to copy) and not
+    // the bitmap's row stride. The bitmap's may be padded beyond width * pixel
+    // stride.
     //
-    uint32_t stagingBufferRowStride = RoundUp<uint32_t>(rowCopySize, apiRowStrideAligement);
+    std::vector<grfx::BufferToImageCopyInfo> copyInfos;
+    uint64_t                                 bufferSize    = 0;
+    uint32_t                                 minMipLevel   = UINT32_MAX;
+    uint32_t                                 maxMipLevel   = 0;
+    uint32_t                                 minArrayLayer = UINT32_MAX;
+    uint32_t                                 maxArrayLayer = 0;
+    for (const BitmapSubresource& subresource : subresources) {
+        const BitmapView& bitmap                 = subresource.bitmap;
+        const uint32_t    rowCopySize            = bitmap.GetWidth() * bitmap.GetPixelStride();
+        const uint32_t    stagingBufferRowStride = RoundUp<uint32_t>(rowCopySize, rowStrideAlignment);
+
+        bufferSize = RoundUp<uint64_t>(bufferSize, offsetAlignment);
+
+        grfx::BufferToImageCopyInfo copyInfo = {};
+        copyInfo.srcBuffer.imageWidth        = bitmap.GetWidth();
+        copyInfo.srcBuffer.imageHeight       = bitmap.GetHeight();
+        copyInfo.srcBuffer.imageRowStride    = stagingBufferRowStride;
+        copyInfo.srcBuffer.footprintOffset   = bufferSize;
+        copyInfo.srcBuffer.footprintWidth    = bitmap.GetWidth();
+        copyInfo.srcBuffer.footprintHeight   = bitmap.GetHeight();
+        copyInfo.srcBuffer.footprintDepth    = 1;
+        copyInfo.dstImage.mipLevel           = subresource.mipLevel;
+        copyInfo.dstImage.arrayLayer         = subresource.arrayLayer;
+        copyInfo.dstImage.arrayLayerCount    = 1;
+        copyInfo.dstImage.x                  = 0;
+        copyInfo.dstImage.y                  = 0;
+        copyInfo.dstImage.z                  = 0;
+        copyInfo.dstImage.width              = bitmap.GetWidth();
+        copyInfo.dstImage.height             = bitmap.GetHeight();
+        copyInfo.dstImage.depth              = 1;
+        copyInfos.push_back(copyInfo);
+
+        bufferSize += static_cast<uint64_t>(stagingBufferRowStride) * bitmap.GetHeight();
+
+        minMipLevel   = std::min(minMipLevel, subresource.mipLevel);
+        maxMipLevel   = std::max(maxMipLevel, subresource.mipLevel);
+        minArrayLayer = std::min(minArrayLayer, subresource.arrayLayer);
+        maxArrayLayer = std::max(maxArrayLayer, subresource.arrayLayer);
+    }
 
     // Create staging buffer
     grfx::BufferPtr stagingBuffer;
     {
-        uint64_t bufferSize = stagingBufferRowStride * pBitmap->GetHeight();
-
         grfx::BufferCreateInfo ci      = {};
         ci.size                        = bufferSize;
         ci.usageFlags.bits.transferSrc = true;
@@ -141,47 +187,33 @@ Result CopyBitmapToImage(
             return ppxres;
         }
 
-        const char*    pSrc         = pBitmap->GetData();
-        char*          pDst         = static_cast<char*>(pBufferAddress);
-        const uint32_t srcRowStride = pBitmap->GetRowStride();
-        const uint32_t dstRowStride = stagingBufferRowStride;
-        for (uint32_t y = 0; y < pBitmap->GetHeight(); ++y) {
-            memcpy(pDst, pSrc, rowCopySize);
-            pSrc += srcRowStride;
-            pDst += dstRowStride;
+        for (size_t i = 0; i < subresources.size(); ++i) {
+            const BitmapView&                  bitmap       = subresources[i].bitmap;
+            const grfx::BufferToImageCopyInfo& copyInfo     = copyInfos[i];
+            const char*                        pSrc         = bitmap.GetData();
+            char*                              pDst         = static_cast<char*>(pBufferAddress) + copyInfo.srcBuffer.footprintOffset;
+            const uint32_t                     rowCopySize  = bitmap.GetWidth() * bitmap.GetPixelStride();
+            const uint32_t                     srcRowStride = bitmap.GetRowStride();
+            const uint32_t                     dstRowStride = copyInfo.srcBuffer.imageRowStride;
+            for (uint32_t y = 0; y < bitmap.GetHeight(); ++y) {
+                memcpy(pDst, pSrc, rowCopySize);
+                pSrc += srcRowStride;
+                pDst += dstRowStride;
+            }
         }
 
         stagingBuffer->UnmapMemory();
     }
 
-    // Copy info
-    grfx::BufferToImageCopyInfo copyInfo = {};
-    copyInfo.srcBuffer.imageWidth        = pBitmap->GetWidth();
-    copyInfo.srcBuffer.imageHeight       = pBitmap->GetHeight();
-    copyInfo.srcBuffer.imageRowStride    = stagingBufferRowStride;
-    copyInfo.srcBuffer.footprintOffset   = 0;
-    copyInfo.srcBuffer.footprintWidth    = pBitmap->GetWidth();
-    copyInfo.srcBuffer.footprintHeight   = pBitmap->GetHeight();
-    copyInfo.srcBuffer.footprintDepth    = 1;
-    copyInfo.dstImage.mipLevel           = mipLevel;
-    copyInfo.dstImage.arrayLayer         = arrayLayer;
-    copyInfo.dstImage.arrayLayerCount    = 1;
-    copyInfo.dstImage.x                  = 0;
-    copyInfo.dstImage.y                  = 0;
-    copyInfo.dstImage.z                  = 0;
-    copyInfo.dstImage.width              = pBitmap->GetWidth();
-    copyInfo.dstImage.height             = pBitmap->GetHeight();
-    copyInfo.dstImage.depth              = 1;
-
     // Copy to GPU image
     ppxres = pQueue->CopyBufferToImage(
-        std::vector<grfx::BufferToImageCopyInfo>{copyInfo},
+        copyInfos,
         stagingBuffer,
         pImage,
-        mipLevel,
-        1,
-        arrayLayer,
-        1,
+        minMipLevel,
+        maxMipLevel - minMipLevel + 1,
+        minArrayLayer,
+        maxArrayLayer - minArrayLayer + 1,
         stateBefore,
         stateAfter);
     if (Failed(ppxres)) {
@@ -193,6 +225,48 @@ Result CopyBitmapToImage(
 
 // -------------------------------------------------------------------------------------------------
 
+Result CopyBitmapToImage(
+    grfx::Queue*        pQueue,
+    const BitmapView&   bitmap,
+    grfx::Image*        pImage,
+    uint32_t            mipLevel,
+    uint32_t            arrayLayer,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter)
+{
+    BitmapSubresource subresource = {};
+    subresource.bitmap            = bitmap;
+    subresource.mipLevel          = mipLevel;
+    subresource.arrayLayer        = arrayLayer;
+
+    return CopyBitmapsToImage(pQueue, {subresource}, pImage, stateBefore, stateAfter);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Result CopyBitmapToImage(
+    grfx::Queue*        pQueue,
+    const Bitmap*       pBitmap,
+    grfx::Image*        pImage,
+    uint32_t            mipLevel,
+    uint32_t            arrayLayer,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter)
+{
+    PPX_ASSERT_NULL_ARG(pBitmap);
+
+    return CopyBitmapToImage(
+        pQueue,
+        BitmapView(*pBitmap),
+        pImage,
+        mipLevel,
+        arrayLayer,
+        stateBefore,
+        stateAfter);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Result CreateImageFromBitmap(
     grfx::Queue*        pQueue,
     const Bitmap*       pBitmap,
@@ -792,6 +866,227 @@ Result CreateImageFromCompressedImage(
 
 // -------------------------------------------------------------------------------------------------
 
+Result CopyKtx2LevelToImage(
+    grfx::Queue*        pQueue,
+    const Ktx2File&     file,
+    uint32_t            level,
+    grfx::Image*        pImage,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter)
+{
+    PPX_ASSERT_NULL_ARG(pQueue);
+    PPX_ASSERT_NULL_ARG(pImage);
+
+    if (!file.IsOpen() || (level >= file.GetLevelCount()) || (level >= pImage->GetMipLevelCount())) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+    if (file.GetFormat() != pImage->GetFormat()) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    // Scoped destroy
+    grfx::ScopeDestroyer SCOPED_DESTROYER(pQueue->GetDevice());
+
+    // Rows of blocks for compressed formats, rows of texels otherwise
+    const grfx::FormatDesc* pDesc         = grfx::GetFormatDescription(file.GetFormat());
+    const uint32_t          width         = file.GetLevelWidth(level);
+    const uint32_t          height        = file.GetLevelHeight(level);
+    const uint32_t          rowCount      = (height + pDesc->blockWidth - 1) / pDesc->blockWidth;
+    const uint32_t          rowCopySize   = ((width + pDesc->blockWidth - 1) / pDesc->blockWidth) * pDesc->bytesPerTexel;
+    const uint32_t          apiAlignment  = grfx::IsDx12(pQueue->GetDevice()->GetApi()) ? PPX_D3D12_TEXTURE_DATA_PITCH_ALIGNMENT : 1;
+    const uint32_t          dstRowStride  = RoundUp<uint32_t>(rowCopySize, apiAlignment);
+    const uint64_t          levelDataSize = file.GetLevelSize(level);
+
+    // Create staging buffer, it only holds this level
+    grfx::BufferPtr stagingBuffer;
+    {
+        grfx::BufferCreateInfo ci      = {};
+        ci.size                        = static_cast<uint64_t>(dstRowStride) * rowCount;
+        ci.usageFlags.bits.transferSrc = true;
+        ci.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
+
+        Result ppxres = pQueue->GetDevice()->CreateBuffer(&ci, &stagingBuffer);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        SCOPED_DESTROYER.AddObject(stagingBuffer);
+
+        void* pBufferAddress = nullptr;
+        ppxres               = stagingBuffer->MapMemory(0, &pBufferAddress);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        if (dstRowStride == rowCopySize) {
+            // Rows are tightly packed in both, decompress straight into the staging buffer
+            ppxres = file.ReadLevel(level, pBufferAddress, ci.size);
+        }
+        else {
+            // Uncompressed levels are copied from the file mapping, supercompressed
+            // ones go through a temporary buffer to pad the rows
+            std::vector<char> levelData;
+            const char*       pSrc = static_cast<const char*>(file.GetLevelData(level));
+            if (file.GetSupercompression() != KTX2_SUPERCOMPRESSION_NONE) {
+                levelData.resize(static_cast<size_t>(levelDataSize));
+                ppxres = file.ReadLevel(level, levelData.data(), levelDataSize);
+                pSrc   = levelData.data();
+            }
+            if (Success(ppxres)) {
+                char* pDst = static_cast<char*>(pBufferAddress);
+                for (uint32_t row = 0; row < rowCount; ++row) {
+                    memcpy(pDst, pSrc, rowCopySize);
+                    pSrc += rowCopySize;
+                    pDst += dstRowStride;
+                }
+            }
+        }
+
+        stagingBuffer->UnmapMemory();
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    // Copy info
+    grfx::BufferToImageCopyInfo copyInfo = {};
+    copyInfo.srcBuffer.imageWidth        = width;
+    copyInfo.srcBuffer.imageHeight       = height;
+    copyInfo.srcBuffer.imageRowStride    = dstRowStride;
+    copyInfo.srcBuffer.footprintOffset   = 0;
+    copyInfo.srcBuffer.footprintWidth    = width;
+    copyInfo.srcBuffer.footprintHeight   = height;
+    copyInfo.srcBuffer.footprintDepth    = 1;
+    copyInfo.dstImage.mipLevel           = level;
+    copyInfo.dstImage.arrayLayer         = 0;
+    copyInfo.dstImage.arrayLayerCount    = 1;
+    copyInfo.dstImage.x                  = 0;
+    copyInfo.dstImage.y                  = 0;
+    copyInfo.dstImage.z                  = 0;
+    copyInfo.dstImage.width              = width;
+    copyInfo.dstImage.height             = height;
+    copyInfo.dstImage.depth              = 1;
+
+    // Copy to GPU image
+    return pQueue->CopyBufferToImage(
+        std::vector<grfx::BufferToImageCopyInfo>{copyInfo},
+        stagingBuffer,
+        pImage,
+        level,
+        1,
+        0,
+        1,
+        stateBefore,
+        stateAfter);
+}
+
+Result CreateImageFromKtx2File(
+    grfx::Queue*        pQueue,
+    const Ktx2File&     file,
+    grfx::Image**       ppImage,
+    const ImageOptions& options,
+    uint32_t            uploadLevelCount)
+{
+    PPX_ASSERT_NULL_ARG(pQueue);
+    PPX_ASSERT_NULL_ARG(ppImage);
+
+    if (!file.IsOpen()) {
+        return ppx::ERROR_IMAGE_FILE_LOAD_FAILED;
+    }
+    if ((file.GetDepth() != 1) || (file.GetArrayLayerCount() != 1) || (file.GetFaceCount() != 1)) {
+        PPX_LOG_ERROR("Only 2D KTX2 images without array layers or faces are supported");
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    // Scoped destroy
+    grfx::ScopeDestroyer SCOPED_DESTROYER(pQueue->GetDevice());
+
+    // Cap mip level count, same rules as CreateImageFromCompressedImage()
+    const grfx::Format format     = file.GetFormat();
+    const uint32_t     blockWidth = grfx::GetFormatDescription(format)->blockWidth;
+    if ((file.GetWidth() % blockWidth != 0) || (file.GetHeight() % blockWidth != 0)) {
+        PPX_LOG_ERROR("Compressed textures width & height must be a multiple of the block size.");
+        return ERROR_IMAGE_INVALID_FORMAT;
+    }
+    const uint32_t maxMipLevelCount = std::min<uint32_t>(options.mMipLevelCount, file.GetLevelCount());
+    uint32_t       mipLevelCount    = 1;
+    while (mipLevelCount < maxMipLevelCount) {
+        const uint32_t width  = file.GetLevelWidth(mipLevelCount);
+        const uint32_t height = file.GetLevelHeight(mipLevelCount);
+        if ((width % blockWidth != 0) || (height % blockWidth != 0)) {
+            break;
+        }
+        ++mipLevelCount;
+    }
+
+    // Create target image
+    grfx::ImagePtr targetImage;
+    {
+        grfx::ImageCreateInfo ci       = {};
+        ci.type                        = grfx::IMAGE_TYPE_2D;
+        ci.width                       = file.GetWidth();
+        ci.height                      = file.GetHeight();
+        ci.depth                       = 1;
+        ci.format                      = format;
+        ci.sampleCount                 = grfx::SAMPLE_COUNT_1;
+        ci.mipLevelCount               = mipLevelCount;
+        ci.arrayLayerCount             = 1;
+        ci.usageFlags.bits.transferDst = true;
+        ci.usageFlags.bits.sampled     = true;
+        ci.memoryUsage                 = grfx::MEMORY_USAGE_GPU_ONLY;
+
+        ci.usageFlags.flags |= options.mAdditionalUsage;
+
+        Result ppxres = pQueue->GetDevice()->CreateImage(&ci, &targetImage);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        SCOPED_DESTROYER.AddObject(targetImage);
+    }
+
+    // Upload coarsest levels first so a partially uploaded image is usable
+    const uint32_t firstLevel = mipLevelCount - std::min(std::max<uint32_t>(uploadLevelCount, 1), mipLevelCount);
+    for (uint32_t level = mipLevelCount; level-- > firstLevel;) {
+        const grfx::ResourceState stateBefore = (level == mipLevelCount - 1) ? grfx::RESOURCE_STATE_UNDEFINED : grfx::RESOURCE_STATE_SHADER_RESOURCE;
+
+        Result ppxres = CopyKtx2LevelToImage(pQueue, file, level, targetImage, stateBefore, grfx::RESOURCE_STATE_SHADER_RESOURCE);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    // Change ownership to reference so object doesn't get destroyed
+    targetImage->SetOwnership(grfx::OWNERSHIP_REFERENCE);
+
+    // Assign output
+    *ppImage = targetImage;
+
+    return ppx::SUCCESS;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+// Creates the image from the compressed texture cache, compressing the
+// bitmap file first if it isn't cached yet
+static Result CreateImageFromCompressionCache(
+    grfx::Queue*                     pQueue,
+    const std::filesystem::path&     path,
+    const TextureCompressionOptions& compression,
+    grfx::Image**                    ppImage,
+    const ImageOptions&              options)
+{
+    std::filesystem::path cachePath;
+    Result                ppxres = GetCompressedTextureFile(path, compression, &cachePath);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    gli::texture image = gli::load(cachePath.string().c_str());
+    if (image.empty()) {
+        return Result::ERROR_IMAGE_FILE_LOAD_FAILED;
+    }
+    return CreateImageFromCompressedImage(pQueue, image, ppImage, options);
+}
+
 Result CreateImageFromFile(
     grfx::Queue*                 pQueue,
     const std::filesystem::path& path,
@@ -805,6 +1100,14 @@ Result CreateImageFromFile(
     ScopedTimer timer("Image creation from file '" + path.string() + "'");
 
     Result ppxres;
+    if (Bitmap::IsBitmapFile(path) && IsTextureCompressionFormatSupported(options.mCompression.format)) {
+        ppxres = CreateImageFromCompressionCache(pQueue, path, options.mCompression, ppImage, options);
+        if (Success(ppxres)) {
+            return ppx::SUCCESS;
+        }
+        PPX_LOG_WARN("Failed to create compressed image from " << path << " (" << ToString(ppxres) << "), using the uncompressed bitmap");
+    }
+
     if (Bitmap::IsBitmapFile(path)) {
         // Load bitmap
         Bitmap bitmap;
@@ -824,6 +1127,14 @@ Result CreateImageFromFile(
             return ppxres;
         }
     }
+    else if (Ktx2File::IsKtx2File(path)) {
+        Ktx2File file;
+        ppxres = file.Open(path);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        ppxres = CreateImageFromKtx2File(pQueue, file, ppImage, options);
+    }
     else if (IsDDSFile(path)) {
         // Generate a bitmap out of a DDS
         gli::texture image = gli::load(path.string().c_str());
@@ -847,7 +1158,7 @@ Result CreateImageFromFile(
 
 Result CopyBitmapToTexture(
     grfx::Queue*        pQueue,
-    const Bitmap*       pBitmap,
+    const BitmapView&   bitmap,
     grfx::Texture*      pTexture,
     uint32_t            mipLevel,
     uint32_t            arrayLayer,
@@ -855,12 +1166,11 @@ Result CopyBitmapToTexture(
     grfx::ResourceState stateAfter)
 {
     PPX_ASSERT_NULL_ARG(pQueue);
-    PPX_ASSERT_NULL_ARG(pBitmap);
     PPX_ASSERT_NULL_ARG(pTexture);
 
     Result ppxres = CopyBitmapToImage(
         pQueue,
-        pBitmap,
+        bitmap,
         pTexture->GetImage(),
         mipLevel,
         arrayLayer,
@@ -875,6 +1185,48 @@ Result CopyBitmapToTexture(
 
 // -------------------------------------------------------------------------------------------------
 
+Result CopyBitmapToTexture(
+    grfx::Queue*        pQueue,
+    const Bitmap*       pBitmap,
+    grfx::Texture*      pTexture,
+    uint32_t            mipLevel,
+    uint32_t            arrayLayer,
+    grfx::ResourceState stateBefore,
+    grfx::ResourceState stateAfter)
+{
+    PPX_ASSERT_NULL_ARG(pBitmap);
+
+    return CopyBitmapToTexture(
+        pQueue,
+        BitmapView(*pBitmap),
+        pTexture,
+        mipLevel,
+        arrayLayer,
+        stateBefore,
+        stateAfter);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Result CopyBitmapsToTexture(
+    grfx::Queue*                          pQueue,
+    const std::vector<BitmapSubresource>& subresources,
+    grfx::Texture*                        pTexture,
+    grfx::ResourceState                   stateBefore,
+    grfx::ResourceState                   stateAfter)
+{
+    PPX_ASSERT_NULL_ARG(pTexture);
+
+    return CopyBitmapsToImage(
+        pQueue,
+        subresources,
+        pTexture->GetImage(),
+        stateBefore,
+        stateAfter);
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Result CreateTextureFromBitmap(
     grfx::Queue*          pQueue,
     const Bitmap*         pBitmap,
@@ -1042,6 +1394,37 @@ Result CreateTextureFromMipmap(
 
 // -------------------------------------------------------------------------------------------------
 
+// Wraps an image that's already in the shader resource state in a texture,
+// the texture takes ownership of the image. Destroys the image on failure.
+static Result CreateTextureFromShaderResourceImage(
+    grfx::Queue*    pQueue,
+    grfx::Image*    pImage,
+    grfx::Texture** ppTexture)
+{
+    grfx::TextureCreateInfo ci = {};
+    ci.pImage                  = pImage;
+    ci.usageFlags.bits.sampled = true;
+    ci.sampledImageViewType    = grfx::IMAGE_VIEW_TYPE_UNDEFINED;
+    ci.sampledImageViewFormat  = grfx::FORMAT_UNDEFINED;
+    ci.renderTargetViewFormat  = grfx::FORMAT_UNDEFINED;
+    ci.depthStencilViewFormat  = grfx::FORMAT_UNDEFINED;
+    ci.storageImageViewFormat  = grfx::FORMAT_UNDEFINED;
+    ci.ownership               = grfx::OWNERSHIP_REFERENCE;
+
+    grfx::TexturePtr texture;
+    Result           ppxres = pQueue->GetDevice()->CreateTexture(&ci, &texture);
+    if (Failed(ppxres)) {
+        pQueue->GetDevice()->DestroyImage(pImage);
+        return ppxres;
+    }
+
+    // Texture destroys the image along with itself
+    pImage->SetOwnership(grfx::OWNERSHIP_EXCLUSIVE);
+    *ppTexture = texture;
+
+    return ppx::SUCCESS;
+}
+
 Result CreateTextureFromFile(
     grfx::Queue*                 pQueue,
     const std::filesystem::path& path,
@@ -1053,6 +1436,42 @@ Result CreateTextureFromFile(
 
     ScopedTimer timer("Texture creation from image file '" + path.string() + "'");
 
+    const ImageOptions imageOptions = ImageOptions().AdditionalUsage(options.mAdditionalUsage).MipLevelCount(options.mMipLevelCount);
+
+    // KTX2 images are uploaded straight into the shader resource state
+    if (Ktx2File::IsKtx2File(path)) {
+        if (options.mInitialState != grfx::RESOURCE_STATE_SHADER_RESOURCE) {
+            PPX_LOG_ERROR("KTX2 textures must be created in the shader resource state: " << path);
+            return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+        }
+
+        Ktx2File file;
+        Result   ppxres = file.Open(path);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        grfx::ImagePtr image;
+        ppxres = CreateImageFromKtx2File(pQueue, file, &image, imageOptions);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        return CreateTextureFromShaderResourceImage(pQueue, image, ppTexture);
+    }
+
+    // Compressed images are uploaded straight into the shader resource state
+    if (IsTextureCompressionFormatSupported(options.mCompression.format) && (options.mInitialState == grfx::RESOURCE_STATE_SHADER_RESOURCE)) {
+        grfx::ImagePtr image;
+        Result         ppxres = CreateImageFromCompressionCache(pQueue, path, options.mCompression, &image, imageOptions);
+        if (Success(ppxres)) {
+            ppxres = CreateTextureFromShaderResourceImage(pQueue, image, ppTexture);
+            if (Success(ppxres)) {
+                return ppx::SUCCESS;
+            }
+        }
+        PPX_LOG_WARN("Failed to create compressed texture from " << path << " (" << ToString(ppxres) << "), using the uncompressed bitmap");
+    }
+
     // Load bitmap
     Bitmap bitmap;
     Result ppxres = Bitmap::LoadFile(path, &bitmap);
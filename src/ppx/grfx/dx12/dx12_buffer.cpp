@@ -19,6 +19,56 @@ namespace ppx {
 namespace grfx {
 namespace dx12 {
 
+Result MemoryPool::CreateApiObjects(const grfx::MemoryPoolCreateInfo* pCreateInfo)
+{
+    D3D12MA::POOL_FLAGS flags = D3D12MA::POOL_FLAG_NONE;
+    if (pCreateInfo->algorithm == grfx::MEMORY_POOL_ALGORITHM_LINEAR) {
+        flags |= D3D12MA::POOL_FLAG_ALGORITHM_LINEAR;
+    }
+
+    // Buffers only, so the pool works on resource heap tier 1 hardware
+    //
+    D3D12MA::POOL_DESC poolDesc  = {};
+    poolDesc.Flags               = flags;
+    poolDesc.HeapProperties.Type = ToD3D12HeapType(pCreateInfo->memoryUsage);
+    poolDesc.HeapFlags           = D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS;
+    poolDesc.BlockSize           = static_cast<UINT64>(pCreateInfo->blockSize);
+    poolDesc.MinBlockCount       = static_cast<UINT>(pCreateInfo->minBlockCount);
+    poolDesc.MaxBlockCount       = static_cast<UINT>(pCreateInfo->maxBlockCount);
+
+    dx12::Device* pDevice = ToApi(GetDevice());
+    HRESULT       hr      = pDevice->GetAllocator()->CreatePool(&poolDesc, &mPool);
+    if (FAILED(hr)) {
+        PPX_ASSERT_MSG(false, "D3D12MA::Allocator::CreatePool failed");
+        return ppx::ERROR_API_FAILURE;
+    }
+
+    return ppx::SUCCESS;
+}
+
+void MemoryPool::DestroyApiObjects()
+{
+    if (mPool) {
+        mPool->Release();
+        mPool.Reset();
+    }
+}
+
+grfx::MemoryPoolStatistics MemoryPool::GetStatistics() const
+{
+    D3D12MA::Statistics dxStats = {};
+    mPool->GetStatistics(&dxStats);
+
+    grfx::MemoryPoolStatistics statistics = {};
+    statistics.blockCount                 = dxStats.BlockCount;
+    statistics.allocationCount            = dxStats.AllocationCount;
+    statistics.blockBytes                 = static_cast<uint64_t>(dxStats.BlockBytes);
+    statistics.allocationBytes            = static_cast<uint64_t>(dxStats.AllocationBytes);
+    return statistics;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
 {
     D3D12_RESOURCE_FLAGS flags = D3D12_RESOURCE_FLAG_NONE;
@@ -47,6 +97,9 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
 
     D3D12MA::ALLOCATION_DESC allocationDesc = {};
     allocationDesc.HeapType                 = mHeapType;
+    if (!IsNull(pCreateInfo->pMemoryPool)) {
+        allocationDesc.CustomPool = ToApi(pCreateInfo->pMemoryPool)->GetDxPool();
+    }
 
     D3D12_RESOURCE_STATES initialResourceState = ToD3D12ResourceStates(pCreateInfo->initialState, grfx::COMMAND_TYPE_GRAPHICS);
     // Using D3D12_HEAP_TYPE_UPLOAD requires D3D12_RESOURCE_STATE_GENERIC_READ
@@ -72,6 +125,23 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
         return ppx::ERROR_API_FAILURE;
     }
     PPX_LOG_OBJECT_CREATION(D3D12Resource(Buffer), mResource.Get());
+    mAllocationSize = static_cast<uint64_t>(mAllocation->GetSize());
+
+    // D3D12 allows resources to stay mapped while the GPU uses them, the
+    // matching Unmap happens in DestroyApiObjects()
+    //
+    if (pCreateInfo->persistentMap) {
+        D3D12_RANGE readRange = {0, 0};
+        if (mHeapType == D3D12_HEAP_TYPE_READBACK) {
+            readRange.End = static_cast<SIZE_T>(pCreateInfo->size);
+        }
+
+        hr = mResource->Map(0, &readRange, &mMappedAddress);
+        if (FAILED(hr)) {
+            PPX_ASSERT_MSG(false, "ID3D12Resource::Map failed for persistently mapped buffer");
+            return ppx::ERROR_API_FAILURE;
+        }
+    }
 
     return ppx::SUCCESS;
 }
@@ -79,12 +149,19 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
 void Buffer::DestroyApiObjects()
 {
     if (mResource) {
+        if (IsPersistentlyMapped()) {
+            D3D12_RANGE  writtenRange = {0, 0};
+            D3D12_RANGE* pRange       = (mHeapType == D3D12_HEAP_TYPE_UPLOAD) ? nullptr : &writtenRange;
+            mResource->Unmap(0, pRange);
+            mMappedAddress = nullptr;
+        }
         mResource.Reset();
     }
 
     if (mAllocation) {
         mAllocation->Release();
         mAllocation.Reset();
+        mAllocationSize = 0;
     }
 
     mHeapType = InvalidValue<D3D12_HEAP_TYPE>();
@@ -96,6 +173,11 @@ Result Buffer::MapMemory(uint64_t offset, void** ppMappedAddress)
         return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
     }
 
+    if (IsPersistentlyMapped()) {
+        *ppMappedAddress = static_cast<char*>(mMappedAddress) + offset;
+        return ppx::SUCCESS;
+    }
+
     // Use {0, 0} if we're not intending to read this resource
     //
     D3D12_RANGE readRange = {0, 0};
@@ -104,15 +186,22 @@ Result Buffer::MapMemory(uint64_t offset, void** ppMappedAddress)
         readRange.End   = mCreateInfo.size;
     }
 
-    HRESULT hr = mResource->Map(0, &readRange, ppMappedAddress);
+    void*   pMappedAddress = nullptr;
+    HRESULT hr             = mResource->Map(0, &readRange, &pMappedAddress);
     if (FAILED(hr)) {
         return ppx::ERROR_API_FAILURE;
     }
+    *ppMappedAddress = static_cast<char*>(pMappedAddress) + offset;
+
     return ppx::SUCCESS;
 }
 
 void Buffer::UnmapMemory()
 {
+    if (IsPersistentlyMapped()) {
+        return;
+    }
+
     // Use {0, 0} if no data is written
     //
     D3D12_RANGE writtenRange = {0, 0};
@@ -124,6 +213,17 @@ void Buffer::UnmapMemory()
     mResource->Unmap(0, pRange);
 }
 
+Result Buffer::FlushRangeImpl(uint64_t offset, uint64_t size)
+{
+    // Upload and readback heaps are always host coherent
+    return ppx::SUCCESS;
+}
+
+Result Buffer::InvalidateRangeImpl(uint64_t offset, uint64_t size)
+{
+    return ppx::SUCCESS;
+}
+
 } // namespace dx12
 } // namespace grfx
 } // namespace ppx
@@ -113,7 +113,7 @@ void CommandBuffer::DestroyApiObjects()
     }
 }
 
-Result CommandBuffer::Begin()
+Result CommandBuffer::BeginImpl()
 {
     HRESULT hr;
 
@@ -163,7 +163,7 @@ Result CommandBuffer::Begin()
     return ppx::SUCCESS;
 }
 
-Result CommandBuffer::End()
+Result CommandBuffer::EndImpl()
 {
     HRESULT hr = mCommandList->Close();
     if (FAILED(hr)) {
@@ -499,116 +499,86 @@ void CommandBuffer::ClearDepthStencil(
         &rect);
 }
 
-void CommandBuffer::TransitionImageLayout(
-    const grfx::Image*  pImage,
-    uint32_t            mipLevel,
-    uint32_t            mipLevelCount,
-    uint32_t            arrayLayer,
-    uint32_t            arrayLayerCount,
-    grfx::ResourceState beforeState,
-    grfx::ResourceState afterState,
-    const grfx::Queue*  pSrcQueue,
-    const grfx::Queue*  pDstQueue)
+void CommandBuffer::PipelineBarrierImpl(
+    uint32_t                   imageBarrierCount,
+    const grfx::ImageBarrier*  pImageBarriers,
+    uint32_t                   bufferBarrierCount,
+    const grfx::BufferBarrier* pBufferBarriers)
 {
-    PPX_ASSERT_NULL_ARG(pImage);
-
-    (void)pSrcQueue;
-    (void)pDstQueue;
-
-    if (beforeState == afterState) {
-        return;
-    }
-
-    bool allMipLevels    = (mipLevel == 0) && (mipLevelCount == PPX_REMAINING_MIP_LEVELS);
-    bool allArrayLayers  = (arrayLayer == 0) && (arrayLayerCount == PPX_REMAINING_ARRAY_LAYERS);
-    bool allSubresources = allMipLevels && allArrayLayers;
-
-    if (mipLevelCount == PPX_REMAINING_MIP_LEVELS) {
-        mipLevelCount = pImage->GetMipLevelCount();
-    }
+    grfx::CommandType commandType = GetCommandType();
 
-    if (arrayLayerCount == PPX_REMAINING_ARRAY_LAYERS) {
-        arrayLayerCount = pImage->GetArrayLayerCount();
-    }
+    // D3D12 has no queue family ownership so pSrcQueue and pDstQueue are ignored
+    mResourceBarriers.clear();
+    for (uint32_t i = 0; i < imageBarrierCount; ++i) {
+        const grfx::ImageBarrier& src = pImageBarriers[i];
+        if (src.discardContents) {
+            D3D12_RESOURCE_BARRIER barrier  = {};
+            barrier.Type                    = D3D12_RESOURCE_BARRIER_TYPE_ALIASING;
+            barrier.Flags                   = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+            barrier.Aliasing.pResourceAfter = ToApi(src.pImage)->GetDxResource();
+            mResourceBarriers.push_back(barrier);
+        }
+        if (src.beforeState == src.afterState) {
+            continue;
+        }
 
-    grfx::CommandType commandType = GetCommandType();
+        const grfx::Image* pImage          = src.pImage;
+        bool               allSubresources = (src.mipLevel == 0) && (src.mipLevelCount == pImage->GetMipLevelCount()) &&
+                               (src.arrayLayer == 0) && (src.arrayLayerCount == pImage->GetArrayLayerCount());
 
-    std::vector<D3D12_RESOURCE_BARRIER> barriers;
-    if (allSubresources) {
         D3D12_RESOURCE_BARRIER barrier = {};
         barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
         barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
         barrier.Transition.pResource   = ToApi(pImage)->GetDxResource();
         barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-        barrier.Transition.StateBefore = ToD3D12ResourceStates(beforeState, commandType);
-        barrier.Transition.StateAfter  = ToD3D12ResourceStates(afterState, commandType);
+        barrier.Transition.StateBefore = ToD3D12ResourceStates(src.beforeState, commandType);
+        barrier.Transition.StateAfter  = ToD3D12ResourceStates(src.afterState, commandType);
+
+        if (allSubresources) {
+            mResourceBarriers.push_back(barrier);
+            continue;
+        }
 
-        barriers.push_back(barrier);
-    }
-    else {
         //
         // For details about subresource indexing see this:
         //   https://docs.microsoft.com/en-us/windows/win32/direct3d12/subresources
         //
-
         uint32_t mipSpan = pImage->GetMipLevelCount();
-
-        for (uint32_t i = 0; i < arrayLayerCount; ++i) {
-            uint32_t baseSubresource = (arrayLayer + i) * mipSpan;
-            for (uint32_t j = 0; j < mipLevelCount; ++j) {
-                uint32_t targetSubResource = baseSubresource + (mipLevel + j);
-
-                D3D12_RESOURCE_BARRIER barrier = {};
-                barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-                barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-                barrier.Transition.pResource   = ToApi(pImage)->GetDxResource();
-                barrier.Transition.Subresource = static_cast<UINT>(targetSubResource);
-                barrier.Transition.StateBefore = ToD3D12ResourceStates(beforeState, commandType);
-                barrier.Transition.StateAfter  = ToD3D12ResourceStates(afterState, commandType);
-
-                barriers.push_back(barrier);
+        for (uint32_t layer = 0; layer < src.arrayLayerCount; ++layer) {
+            uint32_t baseSubresource = (src.arrayLayer + layer) * mipSpan;
+            for (uint32_t mip = 0; mip < src.mipLevelCount; ++mip) {
+                barrier.Transition.Subresource = static_cast<UINT>(baseSubresource + (src.mipLevel + mip));
+                mResourceBarriers.push_back(barrier);
             }
         }
     }
 
-    if (barriers.empty()) {
-        PPX_ASSERT_MSG(false, "parameters resulted in no barriers - try not to do this!")
-    }
-
-    mCommandList->ResourceBarrier(
-        static_cast<UINT>(barriers.size()),
-        DataPtr(barriers));
-}
-
-void CommandBuffer::BufferResourceBarrier(
-    const grfx::Buffer* pBuffer,
-    grfx::ResourceState beforeState,
-    grfx::ResourceState afterState,
-    const grfx::Queue*  pSrcQueue,
-    const grfx::Queue*  pDstQueue)
-{
-    PPX_ASSERT_NULL_ARG(pBuffer);
+    for (uint32_t i = 0; i < bufferBarrierCount; ++i) {
+        const grfx::BufferBarrier& src = pBufferBarriers[i];
+        if (src.beforeState == src.afterState) {
+            continue;
+        }
 
-    (void)pSrcQueue;
-    (void)pDstQueue;
+        D3D12_RESOURCE_BARRIER barrier = {};
+        barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
+        barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+        barrier.Transition.pResource   = ToApi(src.pBuffer)->GetDxResource();
+        barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+        barrier.Transition.StateBefore = ToD3D12ResourceStates(src.beforeState, commandType);
+        barrier.Transition.StateAfter  = ToD3D12ResourceStates(src.afterState, commandType);
+        mResourceBarriers.push_back(barrier);
+    }
 
-    if (beforeState == afterState) {
+    if (mResourceBarriers.empty()) {
         return;
     }
 
-    grfx::CommandType commandType = GetCommandType();
-
-    D3D12_RESOURCE_BARRIER barrier = {};
-    barrier.Type                   = D3D12_RESOURCE_BARRIER_TYPE_TRANSITION;
-    barrier.Flags                  = D3D12_RESOURCE_BARRIER_FLAG_NONE;
-    barrier.Transition.pResource   = ToApi(pBuffer)->GetDxResource();
-    barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
-    barrier.Transition.StateBefore = ToD3D12ResourceStates(beforeState, commandType);
-    barrier.Transition.StateAfter  = ToD3D12ResourceStates(afterState, commandType);
-    mCommandList->ResourceBarrier(1, &barrier);
+    mCommandList->ResourceBarrier(
+        CountU32(mResourceBarriers),
+        DataPtr(mResourceBarriers));
 }
 
-void CommandBuffer::SetViewports(
+void CommandBuffer::SetViewportsImpl(
     uint32_t              viewportCount,
     const grfx::Viewport* pViewports)
 {
@@ -625,7 +595,7 @@ void CommandBuffer::SetViewports(
     mCommandList->RSSetViewports(static_cast<UINT>(viewportCount), viewports);
 }
 
-void CommandBuffer::SetScissors(
+void CommandBuffer::SetScissorsImpl(
     uint32_t          scissorCount,
     const grfx::Rect* pScissors)
 {
@@ -646,6 +616,8 @@ void CommandBuffer::SetGraphicsPipelineInterface(const grfx::PipelineInterface*
     if (pInterface != mCurrentGraphicsInterface) {
         mCurrentGraphicsInterface = pInterface;
         mCommandList->SetGraphicsRootSignature(ToApi(mCurrentGraphicsInterface)->GetDxRootSignature().Get());
+        // Changing the root signature invalidates all root arguments
+        InvalidateFilteredState();
     }
 }
 
@@ -662,8 +634,11 @@ void CommandBuffer::BindDescriptorSets(
     const grfx::PipelineInterface*    pInterface,
     uint32_t                          setCount,
     const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets,
     size_t&                           rdtCountCBVSRVUAV,
-    size_t&                           rdtCountSampler)
+    size_t&                           rdtCountSampler,
+    size_t&                           rdCountCBV)
 {
     dx12::Device*                  pApiDevice             = ToApi(GetDevice());
     D3D12DevicePtr                 device                 = pApiDevice->GetDxDevice();
@@ -676,11 +651,14 @@ void CommandBuffer::BindDescriptorSets(
     if (parameterIndexCount > mRootDescriptorTablesCBVSRVUAV.size()) {
         mRootDescriptorTablesCBVSRVUAV.resize(parameterIndexCount);
         mRootDescriptorTablesSampler.resize(parameterIndexCount);
+        mRootDescriptorsCBV.resize(parameterIndexCount);
     }
 
-    // Root descriptor tables
-    rdtCountCBVSRVUAV = 0;
-    rdtCountSampler   = 0;
+    // Root descriptor tables and dynamic uniform buffer root descriptors
+    rdtCountCBVSRVUAV           = 0;
+    rdtCountSampler             = 0;
+    rdCountCBV                  = 0;
+    uint32_t dynamicOffsetIndex = 0;
     for (uint32_t setIndex = 0; setIndex < setCount; ++setIndex) {
         PPX_ASSERT_MSG(ppSets[setIndex] != nullptr, "ppSets[" << setIndex << "] is null");
         uint32_t                   set      = setNumbers[setIndex];
@@ -724,7 +702,21 @@ void CommandBuffer::BindDescriptorSets(
             UINT  parameterIndex = pApiPipelineInterface->FindParameterIndex(set, binding.binding);
             PPX_ASSERT_MSG(parameterIndex != UINT32_MAX, "invalid parameter index for set=" << set << ", binding=" << binding.binding);
 
-            if (binding.type == grfx::DESCRIPTOR_TYPE_SAMPLER) {
+            if (binding.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+                PPX_ASSERT_MSG(dynamicOffsetIndex < dynamicOffsetCount, "dynamicOffsetCount is less than the dynamic bindings in ppSets");
+                auto it = FindIf(
+                    pApiSet->GetDynamicUniformBuffers(),
+                    [&binding](const dx12::DescriptorSet::DynamicUniformBuffer& elem) -> bool { return elem.binding == binding.binding; });
+                PPX_ASSERT_MSG(it != std::end(pApiSet->GetDynamicUniformBuffers()), "dynamic uniform buffer binding " << binding.binding << " is not in set");
+
+                RootDescriptor& rd = mRootDescriptorsCBV[rdCountCBV];
+                rd.parameterIndex  = parameterIndex;
+                rd.bufferLocation  = it->bufferLocation + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(pDynamicOffsets[dynamicOffsetIndex]);
+
+                dynamicOffsetIndex += 1;
+                rdCountCBV += 1;
+            }
+            else if (binding.type == grfx::DESCRIPTOR_TYPE_SAMPLER) {
                 RootDescriptorTable& rdt = mRootDescriptorTablesSampler[rdtCountSampler];
                 rdt.parameterIndex       = parameterIndex;
                 rdt.baseDescriptor       = mHeapSampler->GetGPUDescriptorHandleForHeapStart();
@@ -744,20 +736,25 @@ void CommandBuffer::BindDescriptorSets(
             }
         }
     }
+
+    PPX_ASSERT_MSG(dynamicOffsetIndex == dynamicOffsetCount, "dynamicOffsetCount (" << dynamicOffsetCount << ") does not match the dynamic bindings in ppSets (" << dynamicOffsetIndex << ")");
 }
 
-void CommandBuffer::BindGraphicsDescriptorSets(
+void CommandBuffer::BindGraphicsDescriptorSetsImpl(
     const grfx::PipelineInterface*    pInterface,
     uint32_t                          setCount,
-    const grfx::DescriptorSet* const* ppSets)
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
 {
     // Set root signature
     SetGraphicsPipelineInterface(pInterface);
 
-    // Fill out mRootDescriptorTablesCBVSRVUAV and mRootDescriptorTablesSampler
+    // Fill out mRootDescriptorTablesCBVSRVUAV, mRootDescriptorTablesSampler and mRootDescriptorsCBV
     size_t rdtCountCBVSRVUAV = 0;
     size_t rdtCountSampler   = 0;
-    BindDescriptorSets(pInterface, setCount, ppSets, rdtCountCBVSRVUAV, rdtCountSampler);
+    size_t rdCountCBV        = 0;
+    BindDescriptorSets(pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets, rdtCountCBVSRVUAV, rdtCountSampler, rdCountCBV);
 
     // Set CBVSRVUAV root descriptor tables
     for (uint32_t i = 0; i < rdtCountCBVSRVUAV; ++i) {
@@ -770,6 +767,12 @@ void CommandBuffer::BindGraphicsDescriptorSets(
         const RootDescriptorTable& rdt = mRootDescriptorTablesSampler[i];
         mCommandList->SetGraphicsRootDescriptorTable(rdt.parameterIndex, rdt.baseDescriptor);
     }
+
+    // Set dynamic uniform buffer root CBVs
+    for (uint32_t i = 0; i < rdCountCBV; ++i) {
+        const RootDescriptor& rd = mRootDescriptorsCBV[i];
+        mCommandList->SetGraphicsRootConstantBufferView(rd.parameterIndex, rd.bufferLocation);
+    }
 }
 
 void CommandBuffer::PushGraphicsConstants(
@@ -791,7 +794,7 @@ void CommandBuffer::PushGraphicsConstants(
         static_cast<UINT>(dstOffset));
 }
 
-void CommandBuffer::BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline)
+void CommandBuffer::BindGraphicsPipelineImpl(const grfx::GraphicsPipeline* pPipeline)
 {
     mCommandList->SetPipelineState(ToApi(pPipeline)->GetDxPipeline().Get());
     mCommandList->IASetPrimitiveTopology(ToApi(pPipeline)->GetPrimitiveTopology());
@@ -800,15 +803,18 @@ void CommandBuffer::BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline
 void CommandBuffer::BindComputeDescriptorSets(
     const grfx::PipelineInterface*    pInterface,
     uint32_t                          setCount,
-    const grfx::DescriptorSet* const* ppSets)
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
 {
     // Set root signature
     SetComputePipelineInterface(pInterface);
 
-    // Fill out mRootDescriptorTablesCBVSRVUAV and mRootDescriptorTablesSampler
+    // Fill out mRootDescriptorTablesCBVSRVUAV, mRootDescriptorTablesSampler and mRootDescriptorsCBV
     size_t rdtCountCBVSRVUAV = 0;
     size_t rdtCountSampler   = 0;
-    BindDescriptorSets(pInterface, setCount, ppSets, rdtCountCBVSRVUAV, rdtCountSampler);
+    size_t rdCountCBV        = 0;
+    BindDescriptorSets(pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets, rdtCountCBVSRVUAV, rdtCountSampler, rdCountCBV);
 
     // Set CBVSRVUAV root descriptor tables
     for (uint32_t i = 0; i < rdtCountCBVSRVUAV; ++i) {
@@ -821,6 +827,12 @@ void CommandBuffer::BindComputeDescriptorSets(
         const RootDescriptorTable& rdt = mRootDescriptorTablesSampler[i];
         mCommandList->SetComputeRootDescriptorTable(rdt.parameterIndex, rdt.baseDescriptor);
     }
+
+    // Set dynamic uniform buffer root CBVs
+    for (uint32_t i = 0; i < rdCountCBV; ++i) {
+        const RootDescriptor& rd = mRootDescriptorsCBV[i];
+        mCommandList->SetComputeRootConstantBufferView(rd.parameterIndex, rd.bufferLocation);
+    }
 }
 
 void CommandBuffer::PushComputeConstants(
@@ -845,9 +857,11 @@ void CommandBuffer::PushComputeConstants(
 void CommandBuffer::BindComputePipeline(const grfx::ComputePipeline* pPipeline)
 {
     mCommandList->SetPipelineState(ToApi(pPipeline)->GetDxPipeline().Get());
+    // Graphics and compute share the pipeline state on the command list
+    InvalidateFilteredState();
 }
 
-void CommandBuffer::BindIndexBuffer(const grfx::IndexBufferView* pView)
+void CommandBuffer::BindIndexBufferImpl(const grfx::IndexBufferView* pView)
 {
     D3D12_GPU_VIRTUAL_ADDRESS baseAddress = ToApi(pView->pBuffer)->GetDxResource()->GetGPUVirtualAddress();
     UINT                      sizeInBytes = static_cast<UINT>((pView->size == PPX_WHOLE_SIZE) ? pView->pBuffer->GetSize() : pView->size);
@@ -861,7 +875,7 @@ void CommandBuffer::BindIndexBuffer(const grfx::IndexBufferView* pView)
     mCommandList->IASetIndexBuffer(&view);
 }
 
-void CommandBuffer::BindVertexBuffers(
+void CommandBuffer::BindVertexBuffersImpl(
     uint32_t                      viewCount,
     const grfx::VertexBufferView* pViews)
 {
@@ -887,6 +901,8 @@ void CommandBuffer::Draw(
     uint32_t firstVertex,
     uint32_t firstInstance)
 {
+    FlushBarriers();
+
     mCommandList->DrawInstanced(
         static_cast<UINT>(vertexCount),
         static_cast<UINT>(instanceCount),
@@ -901,6 +917,8 @@ void CommandBuffer::DrawIndexed(
     int32_t  vertexOffset,
     uint32_t firstInstance)
 {
+    FlushBarriers();
+
     mCommandList->DrawIndexedInstanced(
         static_cast<UINT>(indexCount),
         static_cast<UINT>(instanceCount),
@@ -914,6 +932,8 @@ void CommandBuffer::Dispatch(
     uint32_t groupCountY,
     uint32_t groupCountZ)
 {
+    FlushBarriers();
+
     mCommandList->Dispatch(
         static_cast<UINT>(groupCountX),
         static_cast<UINT>(groupCountY),
@@ -925,6 +945,8 @@ void CommandBuffer::CopyBufferToBuffer(
     grfx::Buffer*                       pSrcBuffer,
     grfx::Buffer*                       pDstBuffer)
 {
+    FlushBarriers();
+
     mCommandList->CopyBufferRegion(
         ToApi(pDstBuffer)->GetDxResource(),
         static_cast<UINT64>(pCopyInfo->dstBuffer.offset),
@@ -948,6 +970,8 @@ void CommandBuffer::CopyBufferToImage(
     grfx::Buffer*                      pSrcBuffer,
     grfx::Image*                       pDstImage)
 {
+    FlushBarriers();
+
     D3D12DevicePtr      device        = ToApi(GetDevice())->GetDxDevice();
     D3D12_RESOURCE_DESC resouceDesc   = ToApi(pDstImage)->GetDxResource()->GetDesc();
     const uint32_t      mipLevelCount = pDstImage->GetMipLevelCount();
@@ -1009,6 +1033,8 @@ grfx::ImageToBufferOutputPitch CommandBuffer::CopyImageToBuffer(
     grfx::Image*                       pSrcImage,
     grfx::Buffer*                      pDstBuffer)
 {
+    FlushBarriers();
+
     D3D12DevicePtr      device      = ToApi(GetDevice())->GetDxDevice();
     D3D12_RESOURCE_DESC resouceDesc = ToApi(pSrcImage)->GetDxResource()->GetDesc();
 
@@ -1087,6 +1113,8 @@ void CommandBuffer::CopyImageToImage(
     grfx::Image*                      pSrcImage,
     grfx::Image*                      pDstImage)
 {
+    FlushBarriers();
+
     bool isSourceDepthStencil = grfx::GetFormatDescription(pSrcImage->GetFormat())->aspect == grfx::FORMAT_ASPECT_DEPTH_STENCIL;
     bool isDestDepthStencil   = grfx::GetFormatDescription(pDstImage->GetFormat())->aspect == grfx::FORMAT_ASPECT_DEPTH_STENCIL;
     PPX_ASSERT_MSG(isSourceDepthStencil == isDestDepthStencil, "both images in an image copy must be depth-stencil if one is depth-stencil");
@@ -1133,6 +1161,8 @@ void CommandBuffer::BeginQuery(
     const grfx::Query* pQuery,
     uint32_t           queryIndex)
 {
+    FlushBarriers();
+
     PPX_ASSERT_NULL_ARG(pQuery);
     PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
 
@@ -1146,6 +1176,8 @@ void CommandBuffer::EndQuery(
     const grfx::Query* pQuery,
     uint32_t           queryIndex)
 {
+    FlushBarriers();
+
     PPX_ASSERT_NULL_ARG(pQuery);
     PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
 
@@ -1160,6 +1192,8 @@ void CommandBuffer::WriteTimestamp(
     grfx::PipelineStage pipelineStage,
     uint32_t            queryIndex)
 {
+    FlushBarriers();
+
     PPX_ASSERT_NULL_ARG(pQuery);
     PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
 
@@ -1182,6 +1216,8 @@ void CommandBuffer::ResolveQueryData(
     uint32_t     startIndex,
     uint32_t     numQueries)
 {
+    FlushBarriers();
+
     PPX_ASSERT_MSG((startIndex + numQueries) <= pQuery->GetCount(), "invalid query index/number");
     mCommandList->ResolveQueryData(ToApi(pQuery)->GetDxQueryHeap(), ToApi(pQuery)->GetQueryType(), startIndex, numQueries, ToApi(pQuery)->GetReadBackBuffer(), 0);
 }
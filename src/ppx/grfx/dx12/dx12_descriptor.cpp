@@ -21,10 +21,14 @@
 //
 // D3D12 doesn't have the following descriptor types:
 //   DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER
-//   DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC
 //   DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC
 //   DESCRIPTOR_TYPE_INPUT_ATTACHMENT
 //
+// DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC bindings don't occupy any heap
+// space. The descriptor set keeps the buffer address written to them and
+// the command buffer sets it as a root CBV, plus the dynamic offset, when
+// the set is bound.
+//
 
 namespace ppx {
 namespace grfx {
@@ -38,10 +42,9 @@ const uint32_t END_OF_HEAP_BINDING_ID = UINT32_MAX;
 Result DescriptorPool::CreateApiObjects(const grfx::DescriptorPoolCreateInfo* pCreateInfo)
 {
     bool hasCombinedImageSampler = (pCreateInfo->combinedImageSampler > 0);
-    bool hasUniformBufferDynamic = (pCreateInfo->uniformBufferDynamic > 0);
     bool hasStorageBufferDynamic = (pCreateInfo->storageBufferDynamic > 0);
     bool hasInputAtachment       = (pCreateInfo->inputAttachment > 0);
-    bool hasUnsupported          = hasCombinedImageSampler || hasUniformBufferDynamic || hasStorageBufferDynamic || hasInputAtachment;
+    bool hasUnsupported          = hasCombinedImageSampler || hasStorageBufferDynamic || hasInputAtachment;
     if (hasUnsupported) {
         return ppx::ERROR_GRFX_UNKNOWN_DESCRIPTOR_TYPE;
     }
@@ -193,6 +196,13 @@ Result DescriptorSet::CreateApiObjects(const grfx::internal::DescriptorSetCreate
         }
     }
 
+    // Dynamic uniform buffers get their address from UpdateDescriptors
+    for (uint32_t binding : ToApi(pCreateInfo->pLayout)->GetDynamicUniformBufferBindings()) {
+        DynamicUniformBuffer dynamicUniformBuffer = {};
+        dynamicUniformBuffer.binding              = binding;
+        mDynamicUniformBuffers.push_back(dynamicUniformBuffer);
+    }
+
     // Build Sampler offsets
     if (mNumDescriptorsSampler > 0) {
         UINT                        incrementSize = ToApi(GetDevice())->GetHandleIncrementSizeSampler();
@@ -228,6 +238,7 @@ void DescriptorSet::DestroyApiObjects()
     mNumDescriptorsSampler   = 0;
 
     mHeapOffsets.clear();
+    mDynamicUniformBuffers.clear();
 
     if (mHeapCBVSRVUAV) {
         mHeapCBVSRVUAV.Reset();
@@ -244,10 +255,9 @@ Result DescriptorSet::UpdateDescriptors(uint32_t writeCount, const grfx::WriteDe
     for (uint32_t writeIndex = 0; writeIndex < writeCount; ++writeIndex) {
         const grfx::WriteDescriptor& srcWrite               = pWrites[writeIndex];
         bool                         isCombinedImageSampler = (srcWrite.type == grfx::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-        bool                         isUniformBufferDynamic = (srcWrite.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
         bool                         isStorageBufferDynamic = (srcWrite.type == grfx::DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
         bool                         isInputAtachment       = (srcWrite.type == grfx::DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
-        bool                         isUnsupported          = isCombinedImageSampler || isUniformBufferDynamic || isStorageBufferDynamic || isInputAtachment;
+        bool                         isUnsupported          = isCombinedImageSampler || isStorageBufferDynamic || isInputAtachment;
         if (isUnsupported) {
             return ppx::ERROR_GRFX_UNKNOWN_DESCRIPTOR_TYPE;
         }
@@ -260,6 +270,20 @@ Result DescriptorSet::UpdateDescriptors(uint32_t writeCount, const grfx::WriteDe
     for (uint32_t writeIndex = 0; writeIndex < writeCount; ++writeIndex) {
         const grfx::WriteDescriptor& srcWrite = pWrites[writeIndex];
 
+        // Dynamic uniform buffers are root CBVs, only the address is stored
+        if (srcWrite.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            auto it = FindIf(mDynamicUniformBuffers, [srcWrite](const DynamicUniformBuffer& elem) -> bool { return elem.binding == srcWrite.binding; });
+            if (it == std::end(mDynamicUniformBuffers)) {
+                PPX_ASSERT_MSG(false, "attempted to update dynamic uniform buffer binding " << srcWrite.binding << " but binding is not in set");
+                return ppx::ERROR_GRFX_BINDING_NOT_IN_SET;
+            }
+            PPX_ASSERT_MSG(srcWrite.bufferOffset % PPX_CONSTANT_BUFFER_ALIGNMENT == 0, "Buffer offset for dynamic uniform buffer must be a multiple of " << PPX_CONSTANT_BUFFER_ALIGNMENT);
+
+            D3D12_GPU_VIRTUAL_ADDRESS baseAddress = ToApi(srcWrite.pBuffer)->GetDxResource()->GetGPUVirtualAddress();
+            it->bufferLocation                    = baseAddress + static_cast<D3D12_GPU_VIRTUAL_ADDRESS>(srcWrite.bufferOffset);
+            continue;
+        }
+
         // Find heap offset
         auto it = FindIf(mHeapOffsets, [srcWrite](const HeapOffset& elem) -> bool { return elem.binding == srcWrite.binding; });
         if (it == std::end(mHeapOffsets)) {
@@ -387,19 +411,29 @@ Result DescriptorSetLayout::CreateApiObjects(const grfx::DescriptorSetLayoutCrea
         const grfx::DescriptorBinding& binding = pCreateInfo->bindings[i];
 
         bool isCombinedImageSampler = (binding.type == grfx::DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER);
-        bool isUniformBufferDynamic = (binding.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
         bool isStorageBufferDynamic = (binding.type == grfx::DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC);
         bool isInputAtachment       = (binding.type == grfx::DESCRIPTOR_TYPE_INPUT_ATTACHMENT);
-        bool isUnsupported          = isCombinedImageSampler || isUniformBufferDynamic || isStorageBufferDynamic || isInputAtachment;
+        bool isUnsupported          = isCombinedImageSampler || isStorageBufferDynamic || isInputAtachment;
         if (isUnsupported) {
             return ppx::ERROR_GRFX_UNKNOWN_DESCRIPTOR_TYPE;
         }
+
+        // Root CBVs can't be arrayed
+        if ((binding.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) && (binding.arrayCount != 1)) {
+            PPX_ASSERT_MSG(false, "dynamic uniform buffer bindings must have an array count of 1 in Direct3D 12");
+            return ppx::ERROR_GRFX_INVALID_DESCRIPTOR_TYPE;
+        }
     }
 
     // Build descriptor ranges
     for (size_t i = 0; i < pCreateInfo->bindings.size(); ++i) {
         const grfx::DescriptorBinding& binding = pCreateInfo->bindings[i];
 
+        if (binding.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) {
+            mDynamicUniformBufferBindings.push_back(binding.binding);
+            continue;
+        }
+
         mCountCBVSRVUAV += (binding.type == grfx::DESCRIPTOR_TYPE_SAMPLER) ? 0 : binding.arrayCount;
         mCountSampler += (binding.type == grfx::DESCRIPTOR_TYPE_SAMPLER) ? binding.arrayCount : 0;
 
@@ -421,6 +455,7 @@ void DescriptorSetLayout::DestroyApiObjects()
     mCountSampler   = 0;
     mRangesCBVSRVUAV.clear();
     mRangesSampler.clear();
+    mDynamicUniformBufferBindings.clear();
 }
 
 } // namespace dx12
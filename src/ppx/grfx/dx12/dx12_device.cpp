@@ -472,6 +472,16 @@ Result Device::AllocateObject(grfx::Image** ppObject)
     return ppx::SUCCESS;
 }
 
+Result Device::AllocateObject(grfx::MemoryPool** ppObject)
+{
+    dx12::MemoryPool* pObject = new dx12::MemoryPool();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
 Result Device::AllocateObject(grfx::PipelineInterface** ppObject)
 {
     dx12::PipelineInterface* pObject = new dx12::PipelineInterface();
@@ -592,6 +602,26 @@ Result Device::AllocateObject(grfx::Swapchain** ppObject)
     return ppx::SUCCESS;
 }
 
+void Device::GetMemoryHeapStatistics(grfx::MemoryStatistics* pStatistics) const
+{
+    // D3D12MA reports the local (video memory) and non-local (system
+    // memory) segment groups. On UMA devices everything is local.
+    D3D12MA::Budget localBudget    = {};
+    D3D12MA::Budget nonLocalBudget = {};
+    mAllocator->GetBudget(&localBudget, &nonLocalBudget);
+
+    const D3D12MA::Budget* budgets[2] = {&localBudget, &nonLocalBudget};
+    for (uint32_t i = 0; i < 2; ++i) {
+        grfx::MemoryHeapStatistics heap = {};
+        heap.deviceLocal                = (i == 0);
+        heap.usageBytes                 = static_cast<uint64_t>(budgets[i]->UsageBytes);
+        heap.budgetBytes                = static_cast<uint64_t>(budgets[i]->BudgetBytes);
+        heap.blockBytes                 = static_cast<uint64_t>(budgets[i]->Stats.BlockBytes);
+        heap.allocationBytes            = static_cast<uint64_t>(budgets[i]->Stats.AllocationBytes);
+        pStatistics->heaps.push_back(heap);
+    }
+}
+
 Result Device::WaitIdle()
 {
     for (auto& queue : mGraphicsQueues) {
@@ -87,7 +87,25 @@ Result Image::CreateApiObjects(const grfx::ImageCreateInfo* pCreateInfo)
         }
 
         dx12::Device* pDevice = ToApi(GetDevice());
-        HRESULT       hr      = pDevice->GetAllocator()->CreateResource(
+
+        // Placed in the alias image's allocation, which the alias image
+        // keeps ownership of. D3D12MA fails if it doesn't fit.
+        if (!IsNull(pCreateInfo->pMemoryAliasImage)) {
+            HRESULT hr = pDevice->GetAllocator()->CreateAliasingResource(
+                ToApi(pCreateInfo->pMemoryAliasImage)->GetAllocation(),
+                0,
+                &resourceDesc,
+                initialResourceState,
+                useClearValue ? &clearValue : nullptr,
+                IID_PPV_ARGS(&mResource));
+            if (FAILED(hr)) {
+                return ppx::ERROR_ALLOCATION_FAILED;
+            }
+            PPX_LOG_OBJECT_CREATION(D3D12Resource(Image | Aliased), mResource.Get());
+            return ppx::SUCCESS;
+        }
+
+        HRESULT hr = pDevice->GetAllocator()->CreateResource(
             &allocationDesc,
             &resourceDesc,
             initialResourceState,
@@ -98,6 +116,7 @@ Result Image::CreateApiObjects(const grfx::ImageCreateInfo* pCreateInfo)
             return ppx::ERROR_API_FAILURE;
         }
         PPX_LOG_OBJECT_CREATION(D3D12Resource(Image), mResource.Get());
+        mAllocationSize = static_cast<uint64_t>(mAllocation->GetSize());
     }
     else {
         CComPtr<ID3D12Resource> resource = static_cast<ID3D12Resource*>(pCreateInfo->pApiObject);
@@ -131,6 +150,7 @@ void Image::DestroyApiObjects()
     if (mAllocation) {
         mAllocation->Release();
         mAllocation.Reset();
+        mAllocationSize = 0;
     }
 }
 
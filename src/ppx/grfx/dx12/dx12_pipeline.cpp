@@ -289,8 +289,10 @@ Result PipelineInterface::CreateApiObjects(const grfx::PipelineInterfaceCreateIn
         for (size_t bindingIndex = 0; bindingIndex < bindings.size(); ++bindingIndex) {
             const grfx::DescriptorBinding& binding = bindings[bindingIndex];
 
-            // If set is pushable then add as root descriptor...
-            if (pLayout->IsPushable()) {
+            // If set is pushable or the binding is a dynamic uniform buffer
+            // then add as root descriptor...
+            bool isUniformBufferDynamic = (binding.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC);
+            if (pLayout->IsPushable() || isUniformBufferDynamic) {
                 // Figure out which root descriptor parameter type
                 D3D12_ROOT_PARAMETER_TYPE parameterType = InvalidValue<D3D12_ROOT_PARAMETER_TYPE>();
                 switch (binding.type) {
@@ -300,6 +302,7 @@ Result PipelineInterface::CreateApiObjects(const grfx::PipelineInterfaceCreateIn
                     } break;
                     // CBV root descriptor
                     case grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+                    case grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
                         parameterType = D3D12_ROOT_PARAMETER_TYPE_CBV;
                         break;
                     // SRV root descriptor
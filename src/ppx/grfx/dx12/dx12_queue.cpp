@@ -95,9 +95,12 @@ Result Queue::Submit(const grfx::SubmitInfo* pSubmitInfo)
         }
     }
 
-    mCommandQueue->ExecuteCommandLists(
-        static_cast<UINT>(pSubmitInfo->commandBufferCount),
-        mListBuffer.data());
+    // Submissions may only wait and signal, e.g. for headless swapchains
+    if (pSubmitInfo->commandBufferCount > 0) {
+        mCommandQueue->ExecuteCommandLists(
+            static_cast<UINT>(pSubmitInfo->commandBufferCount),
+            mListBuffer.data());
+    }
 
     // Signal semaphores
     for (uint32_t i = 0; i < pSubmitInfo->signalSemaphoreCount; ++i) {
@@ -17,6 +17,27 @@
 namespace ppx {
 namespace grfx {
 
+Result MemoryPool::Create(const grfx::MemoryPoolCreateInfo* pCreateInfo)
+{
+    if (pCreateInfo->memoryUsage == grfx::MEMORY_USAGE_UNKNOWN) {
+        PPX_ASSERT_MSG(false, "memory pool needs a memory usage");
+        return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+    }
+    if ((pCreateInfo->maxBlockCount > 0) && (pCreateInfo->minBlockCount > pCreateInfo->maxBlockCount)) {
+        PPX_ASSERT_MSG(false, "memory pool minBlockCount exceeds maxBlockCount");
+        return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+    }
+
+    Result ppxres = grfx::DeviceObject<grfx::MemoryPoolCreateInfo>::Create(pCreateInfo);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    return ppx::SUCCESS;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Result Buffer::Create(const grfx::BufferCreateInfo* pCreateInfo)
 {
 #ifndef PPX_DISABLE_MINIMUM_BUFFER_SIZE_CHECK
@@ -32,20 +53,103 @@ Result Buffer::Create(const grfx::BufferCreateInfo* pCreateInfo)
         return ppx::ERROR_GRFX_MINIMUM_BUFFER_SIZE_NOT_MET;
     }
 #endif
+    if (pCreateInfo->persistentMap && (pCreateInfo->memoryUsage == grfx::MEMORY_USAGE_GPU_ONLY)) {
+        PPX_ASSERT_MSG(false, "persistentMap requires a host visible memory usage");
+        return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+    }
+    if (!IsNull(pCreateInfo->pMemoryPool)) {
+        const grfx::MemoryPool* pPool = pCreateInfo->pMemoryPool;
+        if (pCreateInfo->memoryUsage != pPool->GetMemoryUsage()) {
+            PPX_ASSERT_MSG(false, "buffer memory usage doesn't match its memory pool");
+            return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+        }
+        if ((pCreateInfo->usageFlags.flags & ~pPool->GetUsageFlags().flags) != 0) {
+            PPX_ASSERT_MSG(false, "buffer usage flags aren't covered by its memory pool");
+            return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+        }
+    }
+
     Result ppxres = grfx::DeviceObject<grfx::BufferCreateInfo>::Create(pCreateInfo);
     if (Failed(ppxres)) {
         return ppxres;
     }
 
+    mResourceState = pCreateInfo->initialState;
+
+    // Host visible copy sources and destinations are staging memory
+    if (mCreateInfo.memoryCategory == grfx::MEMORY_CATEGORY_UNDEFINED) {
+        const bool hostVisible = (pCreateInfo->memoryUsage != grfx::MEMORY_USAGE_GPU_ONLY);
+        const bool transfer    = pCreateInfo->usageFlags.bits.transferSrc || pCreateInfo->usageFlags.bits.transferDst;
+        if (hostVisible && transfer) {
+            mCreateInfo.memoryCategory = grfx::MEMORY_CATEGORY_STAGING;
+        }
+        else if (pCreateInfo->usageFlags.bits.vertexBuffer || pCreateInfo->usageFlags.bits.indexBuffer) {
+            mCreateInfo.memoryCategory = grfx::MEMORY_CATEGORY_MESH;
+        }
+        else {
+            mCreateInfo.memoryCategory = grfx::MEMORY_CATEGORY_OTHER;
+        }
+    }
+
     return ppx::SUCCESS;
 }
 
+namespace {
+
+Result ResolveRange(uint64_t bufferSize, uint64_t offset, uint64_t* pSize)
+{
+    if (offset > bufferSize) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+    if (*pSize == PPX_WHOLE_SIZE) {
+        *pSize = bufferSize - offset;
+    }
+    if (*pSize > (bufferSize - offset)) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+    return ppx::SUCCESS;
+}
+
+} // namespace
+
+Result Buffer::FlushRange(uint64_t offset, uint64_t size)
+{
+    Result ppxres = ResolveRange(GetSize(), offset, &size);
+    if (Failed(ppxres)) {
+        PPX_ASSERT_MSG(false, "flush range is outside of the buffer");
+        return ppxres;
+    }
+    if (size == 0) {
+        return ppx::SUCCESS;
+    }
+    return FlushRangeImpl(offset, size);
+}
+
+Result Buffer::InvalidateRange(uint64_t offset, uint64_t size)
+{
+    Result ppxres = ResolveRange(GetSize(), offset, &size);
+    if (Failed(ppxres)) {
+        PPX_ASSERT_MSG(false, "invalidate range is outside of the buffer");
+        return ppxres;
+    }
+    if (size == 0) {
+        return ppx::SUCCESS;
+    }
+    return InvalidateRangeImpl(offset, size);
+}
+
 Result Buffer::CopyFromSource(uint32_t dataSize, const void* pSrcData)
 {
     if (dataSize > GetSize()) {
         return ppx::ERROR_LIMIT_EXCEEDED;
     }
 
+    // Persistently mapped buffers skip the map and unmap
+    if (IsPersistentlyMapped()) {
+        std::memcpy(mMappedAddress, pSrcData, dataSize);
+        return FlushRange(0, dataSize);
+    }
+
     // Map
     void*  pBufferAddress = nullptr;
     Result ppxres         = MapMemory(0, &pBufferAddress);
@@ -55,11 +159,12 @@ Result Buffer::CopyFromSource(uint32_t dataSize, const void* pSrcData)
 
     // Copy
     std::memcpy(pBufferAddress, pSrcData, dataSize);
+    ppxres = FlushRange(0, dataSize);
 
     // Unmap
     UnmapMemory();
 
-    return ppx::SUCCESS;
+    return ppxres;
 }
 
 Result Buffer::CopyToDest(uint32_t dataSize, void* pDestData)
@@ -68,6 +173,16 @@ Result Buffer::CopyToDest(uint32_t dataSize, void* pDestData)
         return ppx::ERROR_LIMIT_EXCEEDED;
     }
 
+    // Persistently mapped buffers skip the map and unmap
+    if (IsPersistentlyMapped()) {
+        Result ppxres = InvalidateRange(0, dataSize);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        std::memcpy(pDestData, mMappedAddress, dataSize);
+        return ppx::SUCCESS;
+    }
+
     // Map
     void*  pBufferAddress = nullptr;
     Result ppxres         = MapMemory(0, &pBufferAddress);
@@ -76,12 +191,15 @@ Result Buffer::CopyToDest(uint32_t dataSize, void* pDestData)
     }
 
     // Copy
-    std::memcpy(pDestData, pBufferAddress, dataSize);
+    ppxres = InvalidateRange(0, dataSize);
+    if (Success(ppxres)) {
+        std::memcpy(pDestData, pBufferAddress, dataSize);
+    }
 
     // Unmap
     UnmapMemory();
 
-    return ppx::SUCCESS;
+    return ppxres;
 }
 
 } // namespace grfx
@@ -14,6 +14,7 @@
 
 #include "ppx/grfx/grfx_command.h"
 #include "ppx/grfx/grfx_buffer.h"
+#include "ppx/grfx/grfx_device.h"
 #include "ppx/grfx/grfx_queue.h"
 #include "ppx/grfx/grfx_draw_pass.h"
 #include "ppx/grfx/grfx_fullscreen_quad.h"
@@ -25,6 +26,26 @@
 namespace ppx {
 namespace grfx {
 
+static bool IsSameViewport(const grfx::Viewport& a, const grfx::Viewport& b)
+{
+    return (a.x == b.x) && (a.y == b.y) && (a.width == b.width) && (a.height == b.height) && (a.minDepth == b.minDepth) && (a.maxDepth == b.maxDepth);
+}
+
+static bool IsSameRect(const grfx::Rect& a, const grfx::Rect& b)
+{
+    return (a.x == b.x) && (a.y == b.y) && (a.width == b.width) && (a.height == b.height);
+}
+
+static bool IsSameIndexBufferView(const grfx::IndexBufferView& a, const grfx::IndexBufferView& b)
+{
+    return (a.pBuffer == b.pBuffer) && (a.indexType == b.indexType) && (a.offset == b.offset) && (a.size == b.size);
+}
+
+static bool IsSameVertexBufferView(const grfx::VertexBufferView& a, const grfx::VertexBufferView& b)
+{
+    return (a.pBuffer == b.pBuffer) && (a.stride == b.stride) && (a.offset == b.offset) && (a.size == b.size);
+}
+
 CommandType CommandPool::GetCommandType() const
 {
     return mCreateInfo.pQueue->GetCommandType();
@@ -35,6 +56,394 @@ bool CommandBuffer::HasActiveRenderPass() const
     return !IsNull(mCurrentRenderPass) || mDynamicRenderPassActive;
 }
 
+Result CommandBuffer::Begin()
+{
+    Result ppxres = BeginImpl();
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    InvalidateFilteredState();
+    mStateFilter.enabled = GetDevice()->IsRedundantStateFilteringEnabled();
+    mStatistics          = {};
+    mPendingImageBarriers.clear();
+    mPendingBufferBarriers.clear();
+
+    return ppx::SUCCESS;
+}
+
+Result CommandBuffer::End()
+{
+    FlushBarriers();
+
+    Result ppxres = EndImpl();
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    GetDevice()->AccumulateCommandBufferStatistics(mStatistics);
+
+    return ppx::SUCCESS;
+}
+
+void CommandBuffer::InvalidateFilteredState()
+{
+    mStateFilter.pGraphicsPipeline  = nullptr;
+    mStateFilter.pGraphicsInterface = nullptr;
+    mStateFilter.graphicsSets.clear();
+    mStateFilter.graphicsDynamicOffsets.clear();
+    mStateFilter.indexBuffer = {};
+    mStateFilter.vertexBuffers.clear();
+    mStateFilter.viewports.clear();
+    mStateFilter.scissors.clear();
+}
+
+bool CommandBuffer::FilterStateCommand(bool redundant)
+{
+    if (mStateFilter.enabled && redundant) {
+        ++mStatistics.elidedStateCommands;
+        return false;
+    }
+    ++mStatistics.submittedStateCommands;
+    return true;
+}
+
+void CommandBuffer::SetViewports(
+    uint32_t              viewportCount,
+    const grfx::Viewport* pViewports)
+{
+    bool redundant = (viewportCount > 0) && (viewportCount == CountU32(mStateFilter.viewports));
+    for (uint32_t i = 0; redundant && (i < viewportCount); ++i) {
+        redundant = IsSameViewport(pViewports[i], mStateFilter.viewports[i]);
+    }
+    if (!FilterStateCommand(redundant)) {
+        return;
+    }
+
+    SetViewportsImpl(viewportCount, pViewports);
+    mStateFilter.viewports.assign(pViewports, pViewports + viewportCount);
+}
+
+void CommandBuffer::SetScissors(
+    uint32_t          scissorCount,
+    const grfx::Rect* pScissors)
+{
+    bool redundant = (scissorCount > 0) && (scissorCount == CountU32(mStateFilter.scissors));
+    for (uint32_t i = 0; redundant && (i < scissorCount); ++i) {
+        redundant = IsSameRect(pScissors[i], mStateFilter.scissors[i]);
+    }
+    if (!FilterStateCommand(redundant)) {
+        return;
+    }
+
+    SetScissorsImpl(scissorCount, pScissors);
+    mStateFilter.scissors.assign(pScissors, pScissors + scissorCount);
+}
+
+void CommandBuffer::BindGraphicsDescriptorSets(
+    const grfx::PipelineInterface*    pInterface,
+    uint32_t                          setCount,
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
+{
+    bool redundant = !IsNull(pInterface) &&
+                     (pInterface == mStateFilter.pGraphicsInterface) &&
+                     (setCount == CountU32(mStateFilter.graphicsSets)) &&
+                     (dynamicOffsetCount == CountU32(mStateFilter.graphicsDynamicOffsets));
+    for (uint32_t i = 0; redundant && (i < setCount); ++i) {
+        redundant = (ppSets[i] == mStateFilter.graphicsSets[i]);
+    }
+    for (uint32_t i = 0; redundant && (i < dynamicOffsetCount); ++i) {
+        redundant = (pDynamicOffsets[i] == mStateFilter.graphicsDynamicOffsets[i]);
+    }
+    if (!FilterStateCommand(redundant)) {
+        return;
+    }
+
+    BindGraphicsDescriptorSetsImpl(pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets);
+    mStateFilter.pGraphicsInterface = pInterface;
+    mStateFilter.graphicsSets.assign(ppSets, ppSets + setCount);
+    mStateFilter.graphicsDynamicOffsets.assign(pDynamicOffsets, pDynamicOffsets + dynamicOffsetCount);
+}
+
+void CommandBuffer::BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline)
+{
+    bool redundant = !IsNull(pPipeline) && (pPipeline == mStateFilter.pGraphicsPipeline);
+    if (!FilterStateCommand(redundant)) {
+        return;
+    }
+
+    BindGraphicsPipelineImpl(pPipeline);
+    mStateFilter.pGraphicsPipeline = pPipeline;
+}
+
+void CommandBuffer::BindIndexBuffer(const grfx::IndexBufferView* pView)
+{
+    PPX_ASSERT_NULL_ARG(pView);
+
+    bool redundant = !IsNull(pView->pBuffer) && IsSameIndexBufferView(*pView, mStateFilter.indexBuffer);
+    if (!FilterStateCommand(redundant)) {
+        return;
+    }
+
+    BindIndexBufferImpl(pView);
+    mStateFilter.indexBuffer = *pView;
+}
+
+void CommandBuffer::BindVertexBuffers(
+    uint32_t                      viewCount,
+    const grfx::VertexBufferView* pViews)
+{
+    bool redundant = (viewCount > 0) && (viewCount == CountU32(mStateFilter.vertexBuffers));
+    for (uint32_t i = 0; redundant && (i < viewCount); ++i) {
+        redundant = IsSameVertexBufferView(pViews[i], mStateFilter.vertexBuffers[i]);
+    }
+    if (!FilterStateCommand(redundant)) {
+        return;
+    }
+
+    BindVertexBuffersImpl(viewCount, pViews);
+    mStateFilter.vertexBuffers.assign(pViews, pViews + viewCount);
+}
+
+void CommandBuffer::PushDescriptor(
+    grfx::CommandType              pipelineBindPoint,
+    const grfx::PipelineInterface* pInterface,
+    grfx::DescriptorType           descriptorType,
+    uint32_t                       binding,
+    uint32_t                       set,
+    uint32_t                       bufferOffset,
+    const grfx::Buffer*            pBuffer,
+    const grfx::SampledImageView*  pSampledImageView,
+    const grfx::StorageImageView*  pStorageImageView,
+    const grfx::Sampler*           pSampler)
+{
+    // A push can replace a bound set, so the next bind must go through
+    if (pipelineBindPoint == grfx::COMMAND_TYPE_GRAPHICS) {
+        mStateFilter.pGraphicsInterface = nullptr;
+        mStateFilter.graphicsSets.clear();
+        mStateFilter.graphicsDynamicOffsets.clear();
+    }
+
+    PushDescriptorImpl(
+        pipelineBindPoint,
+        pInterface,
+        descriptorType,
+        binding,
+        set,
+        bufferOffset,
+        pBuffer,
+        pSampledImageView,
+        pStorageImageView,
+        pSampler);
+}
+
+void CommandBuffer::TransitionImageLayout(
+    const grfx::Image*  pImage,
+    uint32_t            mipLevel,
+    uint32_t            mipLevelCount,
+    uint32_t            arrayLayer,
+    uint32_t            arrayLayerCount,
+    grfx::ResourceState beforeState,
+    grfx::ResourceState afterState,
+    const grfx::Queue*  pSrcQueue,
+    const grfx::Queue*  pDstQueue)
+{
+    PPX_ASSERT_NULL_ARG(pImage);
+
+    if ((!IsNull(pSrcQueue) && IsNull(pDstQueue)) || (IsNull(pSrcQueue) && !IsNull(pDstQueue))) {
+        PPX_ASSERT_MSG(false, "queue family transfer requires both pSrcQueue and pDstQueue to be NOT NULL");
+    }
+
+    if (mipLevelCount == PPX_REMAINING_MIP_LEVELS) {
+        mipLevelCount = pImage->GetMipLevelCount() - mipLevel;
+    }
+
+    if (arrayLayerCount == PPX_REMAINING_ARRAY_LAYERS) {
+        arrayLayerCount = pImage->GetArrayLayerCount() - arrayLayer;
+    }
+
+    grfx::ImageBarrier barrier = {};
+    barrier.pImage             = pImage;
+    barrier.mipLevel           = mipLevel;
+    barrier.mipLevelCount      = mipLevelCount;
+    barrier.arrayLayer         = arrayLayer;
+    barrier.arrayLayerCount    = arrayLayerCount;
+    barrier.beforeState        = beforeState;
+    barrier.afterState         = afterState;
+    barrier.pSrcQueue          = pSrcQueue;
+    barrier.pDstQueue          = pDstQueue;
+    QueueImageBarrier(barrier);
+}
+
+void CommandBuffer::TransitionImageLayout(
+    const grfx::Image*  pImage,
+    uint32_t            mipLevel,
+    uint32_t            mipLevelCount,
+    uint32_t            arrayLayer,
+    uint32_t            arrayLayerCount,
+    grfx::ResourceState afterState)
+{
+    PPX_ASSERT_NULL_ARG(pImage);
+
+    if (mipLevelCount == PPX_REMAINING_MIP_LEVELS) {
+        mipLevelCount = pImage->GetMipLevelCount() - mipLevel;
+    }
+
+    if (arrayLayerCount == PPX_REMAINING_ARRAY_LAYERS) {
+        arrayLayerCount = pImage->GetArrayLayerCount() - arrayLayer;
+    }
+
+    TransitionTrackedImageLayout(pImage, mipLevel, mipLevelCount, arrayLayer, arrayLayerCount, afterState, false);
+}
+
+void CommandBuffer::AliasingImageBarrier(
+    const grfx::Image*  pImage,
+    grfx::ResourceState afterState)
+{
+    PPX_ASSERT_NULL_ARG(pImage);
+
+    TransitionTrackedImageLayout(pImage, 0, pImage->GetMipLevelCount(), 0, pImage->GetArrayLayerCount(), afterState, true);
+}
+
+void CommandBuffer::QueueImageBarrier(const grfx::ImageBarrier& barrier)
+{
+    if ((barrier.beforeState == barrier.afterState) && (barrier.pSrcQueue == barrier.pDstQueue) && !barrier.discardContents) {
+        return;
+    }
+
+    // A second transition of the same subresources depends on the first
+    for (const grfx::ImageBarrier& pending : mPendingImageBarriers) {
+        bool overlapsMips   = (barrier.mipLevel < (pending.mipLevel + pending.mipLevelCount)) && (pending.mipLevel < (barrier.mipLevel + barrier.mipLevelCount));
+        bool overlapsLayers = (barrier.arrayLayer < (pending.arrayLayer + pending.arrayLayerCount)) && (pending.arrayLayer < (barrier.arrayLayer + barrier.arrayLayerCount));
+        if ((pending.pImage == barrier.pImage) && overlapsMips && overlapsLayers) {
+            FlushBarriers();
+            break;
+        }
+    }
+
+    mPendingImageBarriers.push_back(barrier);
+
+    const_cast<grfx::Image*>(barrier.pImage)->SetSubresourceState(barrier.mipLevel, barrier.mipLevelCount, barrier.arrayLayer, barrier.arrayLayerCount, barrier.afterState);
+}
+
+void CommandBuffer::TransitionTrackedImageLayout(
+    const grfx::Image*  pImage,
+    uint32_t            mipLevel,
+    uint32_t            mipLevelCount,
+    uint32_t            arrayLayer,
+    uint32_t            arrayLayerCount,
+    grfx::ResourceState afterState,
+    bool                discardContents)
+{
+    // One barrier per run of mip levels that share a state, merged
+    // across layers when whole runs line up
+    uint32_t layer = arrayLayer;
+    while (layer < (arrayLayer + arrayLayerCount)) {
+        uint32_t mip = mipLevel;
+        while (mip < (mipLevel + mipLevelCount)) {
+            grfx::ResourceState beforeState = pImage->GetSubresourceState(mip, layer);
+
+            uint32_t mipCount = 1;
+            while (((mip + mipCount) < (mipLevel + mipLevelCount)) && (pImage->GetSubresourceState(mip + mipCount, layer) == beforeState)) {
+                ++mipCount;
+            }
+
+            uint32_t layerCount = 1;
+            if ((mip == mipLevel) && (mipCount == mipLevelCount)) {
+                while ((layer + layerCount) < (arrayLayer + arrayLayerCount)) {
+                    bool sameState = true;
+                    for (uint32_t i = 0; sameState && (i < mipLevelCount); ++i) {
+                        sameState = (pImage->GetSubresourceState(mipLevel + i, layer + layerCount) == beforeState);
+                    }
+                    if (!sameState) {
+                        break;
+                    }
+                    ++layerCount;
+                }
+            }
+
+            grfx::ImageBarrier barrier = {};
+            barrier.pImage             = pImage;
+            barrier.mipLevel           = mip;
+            barrier.mipLevelCount      = mipCount;
+            barrier.arrayLayer         = layer;
+            barrier.arrayLayerCount    = layerCount;
+            barrier.beforeState        = beforeState;
+            barrier.afterState         = afterState;
+            barrier.discardContents    = discardContents;
+            QueueImageBarrier(barrier);
+
+            mip += mipCount;
+            if (layerCount > 1) {
+                layer += layerCount - 1;
+            }
+        }
+        ++layer;
+    }
+}
+
+void CommandBuffer::BufferResourceBarrier(
+    const grfx::Buffer* pBuffer,
+    grfx::ResourceState beforeState,
+    grfx::ResourceState afterState,
+    const grfx::Queue*  pSrcQueue,
+    const grfx::Queue*  pDstQueue)
+{
+    PPX_ASSERT_NULL_ARG(pBuffer);
+
+    if ((!IsNull(pSrcQueue) && IsNull(pDstQueue)) || (IsNull(pSrcQueue) && !IsNull(pDstQueue))) {
+        PPX_ASSERT_MSG(false, "queue family transfer requires both pSrcQueue and pDstQueue to be NOT NULL");
+    }
+
+    if ((beforeState == afterState) && (pSrcQueue == pDstQueue)) {
+        return;
+    }
+
+    for (const grfx::BufferBarrier& pending : mPendingBufferBarriers) {
+        if (pending.pBuffer == pBuffer) {
+            FlushBarriers();
+            break;
+        }
+    }
+
+    grfx::BufferBarrier barrier = {};
+    barrier.pBuffer             = pBuffer;
+    barrier.beforeState         = beforeState;
+    barrier.afterState          = afterState;
+    barrier.pSrcQueue           = pSrcQueue;
+    barrier.pDstQueue           = pDstQueue;
+    mPendingBufferBarriers.push_back(barrier);
+
+    const_cast<grfx::Buffer*>(pBuffer)->SetResourceState(afterState);
+}
+
+void CommandBuffer::BufferResourceBarrier(
+    const grfx::Buffer* pBuffer,
+    grfx::ResourceState afterState)
+{
+    PPX_ASSERT_NULL_ARG(pBuffer);
+
+    BufferResourceBarrier(pBuffer, pBuffer->GetResourceState(), afterState);
+}
+
+void CommandBuffer::FlushBarriers()
+{
+    if (mPendingImageBarriers.empty() && mPendingBufferBarriers.empty()) {
+        return;
+    }
+
+    PipelineBarrierImpl(
+        CountU32(mPendingImageBarriers),
+        DataPtr(mPendingImageBarriers),
+        CountU32(mPendingBufferBarriers),
+        DataPtr(mPendingBufferBarriers));
+
+    mPendingImageBarriers.clear();
+    mPendingBufferBarriers.clear();
+}
+
 void CommandBuffer::BeginRenderPass(const grfx::RenderPassBeginInfo* pBeginInfo)
 {
     if (HasActiveRenderPass()) {
@@ -49,6 +458,7 @@ void CommandBuffer::BeginRenderPass(const grfx::RenderPassBeginInfo* pBeginInfo)
         }
     }
 
+    FlushBarriers();
     BeginRenderPassImpl(pBeginInfo);
     mCurrentRenderPass = pBeginInfo->pRenderPass;
 }
@@ -69,6 +479,7 @@ void CommandBuffer::BeginRendering(const grfx::RenderingInfo* pRenderingInfo)
     PPX_ASSERT_NULL_ARG(pRenderingInfo);
     PPX_ASSERT_MSG(!HasActiveRenderPass(), "cannot nest render passes");
 
+    FlushBarriers();
     BeginRenderingImpl(pRenderingInfo);
     mDynamicRenderPassActive           = true;
     mDynamicRenderPassInfo.mRenderArea = pRenderingInfo->renderArea;
@@ -298,7 +709,7 @@ void CommandBuffer::PushGraphicsUniformBuffer(
     uint32_t                       bufferOffset,
     const grfx::Buffer*            pBuffer)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_GRAPHICS,          // pipelineBindPoint
         pInterface,                           // pInterface
         grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER, // descriptorType
@@ -318,7 +729,7 @@ void CommandBuffer::PushGraphicsStructuredBuffer(
     uint32_t                       bufferOffset,
     const grfx::Buffer*            pBuffer)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_GRAPHICS,                // pipelineBindPoint
         pInterface,                                 // pInterface
         grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER, // descriptorType
@@ -338,7 +749,7 @@ void CommandBuffer::PushGraphicsStorageBuffer(
     uint32_t                       bufferOffset,
     const grfx::Buffer*            pBuffer)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_GRAPHICS,                // pipelineBindPoint
         pInterface,                                 // pInterface
         grfx::DESCRIPTOR_TYPE_RW_STRUCTURED_BUFFER, // descriptorType
@@ -357,7 +768,7 @@ void CommandBuffer::PushGraphicsSampledImage(
     uint32_t                       set,
     const grfx::SampledImageView*  pView)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_GRAPHICS,         // pipelineBindPoint
         pInterface,                          // pInterface
         grfx::DESCRIPTOR_TYPE_SAMPLED_IMAGE, // descriptorType
@@ -376,7 +787,7 @@ void CommandBuffer::PushGraphicsStorageImage(
     uint32_t                       set,
     const grfx::StorageImageView*  pView)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_GRAPHICS,         // pipelineBindPoint
         pInterface,                          // pInterface
         grfx::DESCRIPTOR_TYPE_STORAGE_IMAGE, // descriptorType
@@ -395,7 +806,7 @@ void CommandBuffer::PushGraphicsSampler(
     uint32_t                       set,
     const grfx::Sampler*           pSampler)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_GRAPHICS,   // pipelineBindPoint
         pInterface,                    // pInterface
         grfx::DESCRIPTOR_TYPE_SAMPLER, // descriptorType
@@ -415,7 +826,7 @@ void CommandBuffer::PushComputeUniformBuffer(
     uint32_t                       bufferOffset,
     const grfx::Buffer*            pBuffer)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_COMPUTE,           // pipelineBindPoint
         pInterface,                           // pInterface
         grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER, // descriptorType
@@ -435,7 +846,7 @@ void CommandBuffer::PushComputeStructuredBuffer(
     uint32_t                       bufferOffset,
     const grfx::Buffer*            pBuffer)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_COMPUTE,                 // pipelineBindPoint
         pInterface,                                 // pInterface
         grfx::DESCRIPTOR_TYPE_RO_STRUCTURED_BUFFER, // descriptorType
@@ -455,7 +866,7 @@ void CommandBuffer::PushComputeStorageBuffer(
     uint32_t                       bufferOffset,
     const grfx::Buffer*            pBuffer)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_COMPUTE,                 // pipelineBindPoint
         pInterface,                                 // pInterface
         grfx::DESCRIPTOR_TYPE_RW_STRUCTURED_BUFFER, // descriptorType
@@ -474,7 +885,7 @@ void CommandBuffer::PushComputeSampledImage(
     uint32_t                       set,
     const grfx::SampledImageView*  pView)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_COMPUTE,          // pipelineBindPoint
         pInterface,                          // pInterface
         grfx::DESCRIPTOR_TYPE_SAMPLED_IMAGE, // descriptorType
@@ -493,7 +904,7 @@ void CommandBuffer::PushComputeStorageImage(
     uint32_t                       set,
     const grfx::StorageImageView*  pView)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_COMPUTE,          // pipelineBindPoint
         pInterface,                          // pInterface
         grfx::DESCRIPTOR_TYPE_STORAGE_IMAGE, // descriptorType
@@ -512,7 +923,7 @@ void CommandBuffer::PushComputeSampler(
     uint32_t                       set,
     const grfx::Sampler*           pSampler)
 {
-    PushDescriptorImpl(
+    PushDescriptor(
         grfx::COMMAND_TYPE_COMPUTE,    // pipelineBindPoint
         pInterface,                    // pInterface
         grfx::DESCRIPTOR_TYPE_SAMPLER, // descriptorType
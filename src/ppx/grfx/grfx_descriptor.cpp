@@ -138,11 +138,27 @@ Result DescriptorSetLayout::Create(const grfx::DescriptorSetLayoutCreateInfo* pC
         ranges.push_back(range);
     }
 
+    // Dynamic offsets are supplied when the set is bound, which push
+    // descriptors never are.
+    uint32_t dynamicOffsetCount = 0;
+    for (size_t i = 0; i < bindingCount; ++i) {
+        const grfx::DescriptorBinding& binding = pCreateInfo->bindings[i];
+        if ((binding.type == grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC) || (binding.type == grfx::DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC)) {
+            dynamicOffsetCount += binding.arrayCount;
+        }
+    }
+    if ((dynamicOffsetCount > 0) && pCreateInfo->flags.bits.pushable) {
+        PPX_ASSERT_MSG(false, "pushable descriptor set layouts cannot have dynamic bindings");
+        return ppx::ERROR_GRFX_INVALID_DESCRIPTOR_TYPE;
+    }
+
     Result ppxres = grfx::DeviceObject<grfx::DescriptorSetLayoutCreateInfo>::Create(pCreateInfo);
     if (Failed(ppxres)) {
         return ppxres;
     }
 
+    mDynamicOffsetCount = dynamicOffsetCount;
+
     return ppx::SUCCESS;
 }
 
@@ -16,6 +16,10 @@
 #include "ppx/grfx/grfx_gpu.h"
 #include "ppx/grfx/grfx_instance.h"
 
+#include "xxhash.h"
+
+#include <cstring>
+
 namespace ppx {
 namespace grfx {
 
@@ -48,6 +52,7 @@ void Device::Destroy()
     DestroyAllObjects(mRenderPasses);
 
     DestroyAllObjects(mBuffers);
+    DestroyAllObjects(mMemoryPools); // Memory pools need to be destroyed after buffers
     DestroyAllObjects(mCommandBuffers);
     DestroyAllObjects(mCommandPools);
     DestroyAllObjects(mComputePipelines);
@@ -65,6 +70,7 @@ void Device::Destroy()
     DestroyAllObjects(mSamplers);
     DestroyAllObjects(mSemaphores);
     DestroyAllObjects(mStorageImageViews);
+    mSharedShaderModules.clear();
     DestroyAllObjects(mShaderModules);
     DestroyAllObjects(mSwapchains);
 
@@ -229,12 +235,20 @@ Result Device::CreateBuffer(const grfx::BufferCreateInfo* pCreateInfo, grfx::Buf
 {
     PPX_ASSERT_NULL_ARG(pCreateInfo);
     PPX_ASSERT_NULL_ARG(ppBuffer);
-    return CreateObject(pCreateInfo, mBuffers, ppBuffer);
+    Result ppxres = CreateObject(pCreateInfo, mBuffers, ppBuffer);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+    TrackMemory((*ppBuffer)->GetMemoryCategory(), (*ppBuffer)->GetAllocationSize(), true);
+    return ppx::SUCCESS;
 }
 
 void Device::DestroyBuffer(const grfx::Buffer* pBuffer)
 {
     PPX_ASSERT_NULL_ARG(pBuffer);
+    if (std::find(std::begin(mBuffers), std::end(mBuffers), pBuffer) != std::end(mBuffers)) {
+        TrackMemory(pBuffer->GetMemoryCategory(), pBuffer->GetAllocationSize(), false);
+    }
     DestroyObject(mBuffers, pBuffer);
 }
 
@@ -406,15 +420,39 @@ Result Device::CreateImage(const grfx::ImageCreateInfo* pCreateInfo, grfx::Image
 {
     PPX_ASSERT_NULL_ARG(pCreateInfo);
     PPX_ASSERT_NULL_ARG(ppImage);
-    return CreateObject(pCreateInfo, mImages, ppImage);
+    Result ppxres = CreateObject(pCreateInfo, mImages, ppImage);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+    TrackMemory((*ppImage)->GetMemoryCategory(), (*ppImage)->GetAllocationSize(), true);
+    return ppx::SUCCESS;
 }
 
 void Device::DestroyImage(const grfx::Image* pImage)
 {
     PPX_ASSERT_NULL_ARG(pImage);
+    if (std::find(std::begin(mImages), std::end(mImages), pImage) != std::end(mImages)) {
+        TrackMemory(pImage->GetMemoryCategory(), pImage->GetAllocationSize(), false);
+    }
     DestroyObject(mImages, pImage);
 }
 
+Result Device::CreateMemoryPool(const grfx::MemoryPoolCreateInfo* pCreateInfo, grfx::MemoryPool** ppMemoryPool)
+{
+    PPX_ASSERT_NULL_ARG(pCreateInfo);
+    PPX_ASSERT_NULL_ARG(ppMemoryPool);
+    return CreateObject(pCreateInfo, mMemoryPools, ppMemoryPool);
+}
+
+void Device::DestroyMemoryPool(const grfx::MemoryPool* pMemoryPool)
+{
+    PPX_ASSERT_NULL_ARG(pMemoryPool);
+    for (const grfx::BufferPtr& buffer : mBuffers) {
+        PPX_ASSERT_MSG(buffer->GetMemoryPool() != pMemoryPool, "memory pool destroyed while buffers still use it");
+    }
+    DestroyObject(mMemoryPools, pMemoryPool);
+}
+
 Result Device::CreateMesh(const grfx::MeshCreateInfo* pCreateInfo, grfx::Mesh** ppMesh)
 {
     PPX_ASSERT_NULL_ARG(pCreateInfo);
@@ -552,9 +590,74 @@ Result Device::CreateShaderModule(const grfx::ShaderModuleCreateInfo* pCreateInf
 void Device::DestroyShaderModule(const grfx::ShaderModule* pShaderModule)
 {
     PPX_ASSERT_NULL_ARG(pShaderModule);
+
+    // Shared modules are only destroyed with their last reference
+    for (auto it = mSharedShaderModules.begin(); it != mSharedShaderModules.end(); ++it) {
+        if (it->second.pShaderModule == pShaderModule) {
+            if (--it->second.referenceCount > 0) {
+                return;
+            }
+            mSharedShaderModules.erase(it);
+            break;
+        }
+    }
+
     DestroyObject(mShaderModules, pShaderModule);
 }
 
+Result Device::AcquireShaderModule(const grfx::ShaderModuleCreateInfo* pCreateInfo, grfx::ShaderModule** ppShaderModule)
+{
+    PPX_ASSERT_NULL_ARG(pCreateInfo);
+    PPX_ASSERT_NULL_ARG(ppShaderModule);
+
+    const uint64_t hash = XXH64(pCreateInfo->pCode, pCreateInfo->size, 0);
+
+    auto it = mSharedShaderModules.find(hash);
+    if (it != mSharedShaderModules.end()) {
+        // Only identical bytecode is shared, equal hashes alone aren't enough
+        const std::vector<char>& code = it->second.code;
+        if ((code.size() == pCreateInfo->size) && (memcmp(code.data(), pCreateInfo->pCode, code.size()) == 0)) {
+            ++it->second.referenceCount;
+            *ppShaderModule = it->second.pShaderModule;
+            return ppx::SUCCESS;
+        }
+        // Hash collision, the module can't be shared
+        PPX_LOG_WARN("Shader bytecode hash collision, creating an unshared shader module");
+        return CreateShaderModule(pCreateInfo, ppShaderModule);
+    }
+
+    grfx::ShaderModule* pShaderModule = nullptr;
+    Result              ppxres        = CreateShaderModule(pCreateInfo, &pShaderModule);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    SharedShaderModule shared = {};
+    shared.pShaderModule      = pShaderModule;
+    shared.referenceCount     = 1;
+    shared.code.assign(pCreateInfo->pCode, pCreateInfo->pCode + pCreateInfo->size);
+    mSharedShaderModules.emplace(hash, std::move(shared));
+
+    *ppShaderModule = pShaderModule;
+    return ppx::SUCCESS;
+}
+
+uint32_t Device::GetShaderModuleReferenceCount(const grfx::ShaderModule* pShaderModule) const
+{
+    for (const auto& elem : mSharedShaderModules) {
+        if (elem.second.pShaderModule == pShaderModule) {
+            return elem.second.referenceCount;
+        }
+    }
+    // Unshared modules are only referenced by their creator
+    for (const auto& shaderModule : mShaderModules) {
+        if (shaderModule == pShaderModule) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
 Result Device::CreateStorageImageView(const grfx::StorageImageViewCreateInfo* pCreateInfo, grfx::StorageImageView** ppStorageImageView)
 {
     PPX_ASSERT_NULL_ARG(pCreateInfo);
@@ -803,5 +906,80 @@ grfx::QueuePtr Device::GetAnyAvailableQueue() const
     return queue;
 }
 
+grfx::CommandBufferStatistics Device::GetCommandBufferStatistics() const
+{
+    std::lock_guard<std::mutex> lock(mCommandBufferStatisticsMutex);
+    return mCommandBufferStatistics;
+}
+
+void Device::ResetCommandBufferStatistics()
+{
+    std::lock_guard<std::mutex> lock(mCommandBufferStatisticsMutex);
+    mCommandBufferStatistics = {};
+}
+
+void Device::AccumulateCommandBufferStatistics(const grfx::CommandBufferStatistics& statistics)
+{
+    std::lock_guard<std::mutex> lock(mCommandBufferStatisticsMutex);
+    mCommandBufferStatistics.submittedStateCommands += statistics.submittedStateCommands;
+    mCommandBufferStatistics.elidedStateCommands += statistics.elidedStateCommands;
+}
+
+grfx::MemoryStatistics Device::GetMemoryStatistics() const
+{
+    grfx::MemoryStatistics statistics = {};
+    {
+        std::lock_guard<std::mutex> lock(mMemoryStatisticsMutex);
+        std::copy(std::begin(mMemoryCategories), std::end(mMemoryCategories), std::begin(statistics.categories));
+    }
+    GetMemoryHeapStatistics(&statistics);
+    return statistics;
+}
+
+void Device::TrackMemory(grfx::MemoryCategory category, uint64_t allocationBytes, bool allocated)
+{
+    PPX_ASSERT_MSG(category < grfx::MEMORY_CATEGORY_COUNT, "invalid memory category");
+
+    std::lock_guard<std::mutex>     lock(mMemoryStatisticsMutex);
+    grfx::MemoryCategoryStatistics& stats = mMemoryCategories[category];
+    if (allocated) {
+        stats.allocationCount += 1;
+        stats.allocationBytes += allocationBytes;
+        stats.peakAllocationBytes = std::max(stats.peakAllocationBytes, stats.allocationBytes);
+    }
+    else {
+        PPX_ASSERT_MSG((stats.allocationCount > 0) && (stats.allocationBytes >= allocationBytes), "memory category statistics underflow");
+        stats.allocationCount -= 1;
+        stats.allocationBytes -= allocationBytes;
+    }
+}
+
+uint64_t MemoryStatistics::GetDeviceLocalUsageBytes() const
+{
+    uint64_t bytes = 0;
+    for (const grfx::MemoryHeapStatistics& heap : heaps) {
+        bytes += heap.deviceLocal ? heap.usageBytes : 0;
+    }
+    return bytes;
+}
+
+uint64_t MemoryStatistics::GetDeviceLocalBudgetBytes() const
+{
+    uint64_t bytes = 0;
+    for (const grfx::MemoryHeapStatistics& heap : heaps) {
+        bytes += heap.deviceLocal ? heap.budgetBytes : 0;
+    }
+    return bytes;
+}
+
+uint64_t MemoryStatistics::GetCategoryAllocationBytes() const
+{
+    uint64_t bytes = 0;
+    for (const grfx::MemoryCategoryStatistics& category : categories) {
+        bytes += category.allocationBytes;
+    }
+    return bytes;
+}
+
 } // namespace grfx
 } // namespace ppx
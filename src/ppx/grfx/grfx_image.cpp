@@ -98,14 +98,63 @@ Result Image::Create(const grfx::ImageCreateInfo* pCreateInfo)
         return ppx::ERROR_INVALID_CREATE_ARGUMENT;
     }
 
+    // Aliased images share memory the alias image owns, so the alias image
+    // must have allocated it and must outlive this image
+    if (!IsNull(pCreateInfo->pMemoryAliasImage)) {
+        const grfx::Image* pAliasImage = pCreateInfo->pMemoryAliasImage;
+        if (!IsNull(pCreateInfo->pApiObject) || !IsNull(pAliasImage->GetMemoryAliasImage())) {
+            PPX_ASSERT_MSG(false, "pMemoryAliasImage must be an image that allocated its own memory");
+            return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+        }
+        if ((pCreateInfo->memoryUsage != grfx::MEMORY_USAGE_GPU_ONLY) || (pAliasImage->GetMemoryUsage() != grfx::MEMORY_USAGE_GPU_ONLY)) {
+            PPX_ASSERT_MSG(false, "memory aliasing is only supported for MEMORY_USAGE_GPU_ONLY images");
+            return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+        }
+    }
+
     Result ppxres = grfx::DeviceObject<grfx::ImageCreateInfo>::Create(pCreateInfo);
     if (Failed(ppxres)) {
         return ppxres;
     }
 
+    mSubresourceStates.assign(pCreateInfo->mipLevelCount * pCreateInfo->arrayLayerCount, pCreateInfo->initialState);
+
+    if (mCreateInfo.memoryCategory == grfx::MEMORY_CATEGORY_UNDEFINED) {
+        if (pCreateInfo->usageFlags.bits.colorAttachment || pCreateInfo->usageFlags.bits.depthStencilAttachment) {
+            mCreateInfo.memoryCategory = grfx::MEMORY_CATEGORY_RENDER_TARGET;
+        }
+        else if (pCreateInfo->usageFlags.bits.sampled) {
+            mCreateInfo.memoryCategory = grfx::MEMORY_CATEGORY_TEXTURE;
+        }
+        else {
+            mCreateInfo.memoryCategory = grfx::MEMORY_CATEGORY_OTHER;
+        }
+    }
+
     return ppx::SUCCESS;
 }
 
+grfx::ResourceState Image::GetSubresourceState(uint32_t mipLevel, uint32_t arrayLayer) const
+{
+    PPX_ASSERT_MSG((mipLevel < GetMipLevelCount()) && (arrayLayer < GetArrayLayerCount()), "subresource out of range");
+    return mSubresourceStates[arrayLayer * GetMipLevelCount() + mipLevel];
+}
+
+void Image::SetSubresourceState(
+    uint32_t            mipLevel,
+    uint32_t            mipLevelCount,
+    uint32_t            arrayLayer,
+    uint32_t            arrayLayerCount,
+    grfx::ResourceState state)
+{
+    PPX_ASSERT_MSG((mipLevel + mipLevelCount) <= GetMipLevelCount(), "mip range out of range");
+    PPX_ASSERT_MSG((arrayLayer + arrayLayerCount) <= GetArrayLayerCount(), "array layer range out of range");
+    for (uint32_t layer = arrayLayer; layer < (arrayLayer + arrayLayerCount); ++layer) {
+        grfx::ResourceState* pLayerStates = mSubresourceStates.data() + layer * GetMipLevelCount();
+        std::fill(pLayerStates + mipLevel, pLayerStates + mipLevel + mipLevelCount, state);
+    }
+}
+
 grfx::ImageViewType Image::GuessImageViewType(bool isCube) const
 {
     const uint32_t arrayLayerCount = GetArrayLayerCount();
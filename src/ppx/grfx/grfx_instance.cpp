@@ -21,6 +21,9 @@
 #if defined(PPX_VULKAN)
 #include "ppx/grfx/vk/vk_instance.h"
 #endif // defined(PPX_VULKAN)
+#if defined(PPX_NULL)
+#include "ppx/grfx/null/null_instance.h"
+#endif // defined(PPX_NULL)
 
 namespace ppx {
 namespace grfx {
@@ -259,6 +262,15 @@ Result CreateInstance(const grfx::InstanceCreateInfo* pCreateInfo, grfx::Instanc
             }
         } break;
 #endif // defined(PPX_VULKAN)
+
+#if defined(PPX_NULL)
+        case grfx::API_NULL: {
+            pObject = new null::Instance();
+            if (IsNull(pObject)) {
+                return ppx::ERROR_ALLOCATION_FAILED;
+            }
+        } break;
+#endif // defined(PPX_NULL)
     }
 
     Result ppxres = pObject->Create(pCreateInfo);
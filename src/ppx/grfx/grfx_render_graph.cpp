@@ -0,0 +1,527 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/grfx_render_graph.h"
+#include "ppx/grfx/grfx_command.h"
+#include "ppx/grfx/grfx_device.h"
+#include "ppx/grfx/grfx_draw_pass.h"
+#include "ppx/grfx/grfx_image.h"
+#include "ppx/grfx/grfx_texture.h"
+
+namespace ppx {
+namespace grfx {
+
+namespace {
+
+enum MemoryKind
+{
+    MEMORY_KIND_COLOR_ATTACHMENT = 0,
+    MEMORY_KIND_DEPTH_STENCIL    = 1,
+    MEMORY_KIND_OTHER            = 2,
+};
+
+void AddUsageForState(grfx::ResourceState state, grfx::ImageUsageFlags& usageFlags)
+{
+    switch (state) {
+        default: break;
+        case grfx::RESOURCE_STATE_RENDER_TARGET: usageFlags.bits.colorAttachment = true; break;
+        case grfx::RESOURCE_STATE_DEPTH_STENCIL_READ:
+        case grfx::RESOURCE_STATE_DEPTH_STENCIL_WRITE:
+        case grfx::RESOURCE_STATE_DEPTH_WRITE_STENCIL_READ:
+        case grfx::RESOURCE_STATE_DEPTH_READ_STENCIL_WRITE: usageFlags.bits.depthStencilAttachment = true; break;
+        case grfx::RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE:
+        case grfx::RESOURCE_STATE_PIXEL_SHADER_RESOURCE:
+        case grfx::RESOURCE_STATE_SHADER_RESOURCE: usageFlags.bits.sampled = true; break;
+        case grfx::RESOURCE_STATE_GENERAL:
+        case grfx::RESOURCE_STATE_UNORDERED_ACCESS: usageFlags.bits.storage = true; break;
+        case grfx::RESOURCE_STATE_COPY_SRC:
+        case grfx::RESOURCE_STATE_RESOLVE_SRC: usageFlags.bits.transferSrc = true; break;
+        case grfx::RESOURCE_STATE_COPY_DST:
+        case grfx::RESOURCE_STATE_RESOLVE_DST: usageFlags.bits.transferDst = true; break;
+    }
+}
+
+MemoryKind GetMemoryKind(const grfx::ImageUsageFlags& usageFlags)
+{
+    if (usageFlags.bits.depthStencilAttachment) {
+        return MEMORY_KIND_DEPTH_STENCIL;
+    }
+    if (usageFlags.bits.colorAttachment) {
+        return MEMORY_KIND_COLOR_ATTACHMENT;
+    }
+    return MEMORY_KIND_OTHER;
+}
+
+uint64_t EstimateImageSize(const grfx::RenderGraphImageCreateInfo& createInfo)
+{
+    const grfx::FormatDesc* pFormatDesc = grfx::GetFormatDescription(createInfo.format);
+
+    uint64_t size   = 0;
+    uint32_t width  = createInfo.width;
+    uint32_t height = createInfo.height;
+    for (uint32_t mip = 0; mip < createInfo.mipLevelCount; ++mip) {
+        size += static_cast<uint64_t>(width) * height * pFormatDesc->bytesPerTexel;
+        width  = std::max<uint32_t>(width / 2, 1);
+        height = std::max<uint32_t>(height / 2, 1);
+    }
+    return size * static_cast<uint64_t>(createInfo.sampleCount) * createInfo.arrayLayerCount;
+}
+
+} // namespace
+
+RenderGraph::RenderGraph(grfx::Device* pDevice)
+    : mDevice(pDevice)
+{
+    PPX_ASSERT_NULL_ARG(pDevice);
+}
+
+RenderGraph::~RenderGraph()
+{
+    Reset();
+}
+
+grfx::RenderGraphImage RenderGraph::ImportImage(grfx::Image* pImage, grfx::ResourceState finalState)
+{
+    PPX_ASSERT_NULL_ARG(pImage);
+    PPX_ASSERT_MSG(!mCompiled, "cannot import images into a compiled render graph");
+
+    ImageEntry entry = {};
+    entry.imported   = true;
+    entry.image      = pImage;
+    entry.finalState = finalState;
+    entry.usageFlags = pImage->GetUsageFlags();
+    mImages.push_back(entry);
+
+    grfx::RenderGraphImage handle = {};
+    handle.index                  = CountU32(mImages) - 1;
+    return handle;
+}
+
+grfx::RenderGraphImage RenderGraph::CreateImage(const grfx::RenderGraphImageCreateInfo& createInfo)
+{
+    PPX_ASSERT_MSG(!mCompiled, "cannot create images in a compiled render graph");
+    PPX_ASSERT_MSG((createInfo.width > 0) && (createInfo.height > 0), "transient image extent cannot be zero");
+
+    ImageEntry entry = {};
+    entry.createInfo = createInfo;
+    entry.usageFlags = createInfo.usageFlags;
+    mImages.push_back(entry);
+
+    grfx::RenderGraphImage handle = {};
+    handle.index                  = CountU32(mImages) - 1;
+    return handle;
+}
+
+Result RenderGraph::AddPass(const grfx::RenderGraphPassCreateInfo& createInfo)
+{
+    if (mCompiled) {
+        PPX_ASSERT_MSG(false, "cannot add passes to a compiled render graph");
+        return ppx::ERROR_GRFX_OPERATION_NOT_PERMITTED;
+    }
+    if (createInfo.renderTargetCount > PPX_MAX_RENDER_TARGETS) {
+        PPX_ASSERT_MSG(false, "renderTargetCount exceeds PPX_MAX_RENDER_TARGETS");
+        return ppx::ERROR_LIMIT_EXCEEDED;
+    }
+
+    PassEntry pass  = {};
+    pass.createInfo = createInfo;
+
+    // Attachments are written and, when they're loaded, read
+    bool loadRenderTargets = !createInfo.clearFlags.bits.clearRenderTargets;
+    bool loadDepthStencil  = !createInfo.clearFlags.bits.clearDepth && !createInfo.clearFlags.bits.clearStencil;
+    for (uint32_t i = 0; i < createInfo.renderTargetCount; ++i) {
+        pass.accesses.push_back({createInfo.renderTargets[i], grfx::RESOURCE_STATE_RENDER_TARGET});
+        pass.writtenImages.push_back(createInfo.renderTargets[i].index);
+        if (loadRenderTargets) {
+            pass.readImages.push_back(createInfo.renderTargets[i].index);
+        }
+    }
+    if (createInfo.depthStencil.IsValid()) {
+        pass.accesses.push_back({createInfo.depthStencil, createInfo.depthStencilState});
+        pass.writtenImages.push_back(createInfo.depthStencil.index);
+        if (loadDepthStencil) {
+            pass.readImages.push_back(createInfo.depthStencil.index);
+        }
+    }
+    for (const grfx::RenderGraphImageAccess& access : createInfo.reads) {
+        pass.accesses.push_back(access);
+        pass.readImages.push_back(access.image.index);
+    }
+    for (const grfx::RenderGraphImageAccess& access : createInfo.writes) {
+        pass.accesses.push_back(access);
+        pass.writtenImages.push_back(access.image.index);
+    }
+
+    // Each image can only be in one state per pass
+    for (size_t i = 0; i < pass.accesses.size(); ++i) {
+        const grfx::RenderGraphImageAccess& access = pass.accesses[i];
+        if (access.image.index >= mImages.size()) {
+            PPX_ASSERT_MSG(false, "pass '" << createInfo.name << "' uses an image that wasn't declared on this graph");
+            return ppx::ERROR_ELEMENT_NOT_FOUND;
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (pass.accesses[j].image.index == access.image.index) {
+                PPX_ASSERT_MSG(false, "pass '" << createInfo.name << "' uses the same image more than once");
+                return ppx::ERROR_DUPLICATE_ELEMENT;
+            }
+        }
+    }
+
+    mPasses.push_back(pass);
+
+    return ppx::SUCCESS;
+}
+
+void RenderGraph::CullPasses()
+{
+    // Walk backwards from the passes that write imported images or have
+    // side effects, keeping the passes that produce what they read
+    std::vector<bool> needed(mImages.size(), false);
+    for (size_t i = mPasses.size(); i > 0; --i) {
+        PassEntry& pass = mPasses[i - 1];
+
+        bool live = pass.createInfo.hasSideEffects;
+        for (uint32_t imageIndex : pass.writtenImages) {
+            live = live || mImages[imageIndex].imported || needed[imageIndex];
+        }
+
+        pass.culled = !live;
+        if (!live) {
+            continue;
+        }
+
+        // Anything this pass overwrites without reading isn't needed
+        // from earlier passes
+        for (uint32_t imageIndex : pass.writtenImages) {
+            needed[imageIndex] = false;
+        }
+        for (uint32_t imageIndex : pass.readImages) {
+            needed[imageIndex] = true;
+        }
+    }
+}
+
+void RenderGraph::ComputeLifetimes()
+{
+    for (uint32_t passIndex = 0; passIndex < CountU32(mPasses); ++passIndex) {
+        const PassEntry& pass = mPasses[passIndex];
+        if (pass.culled) {
+            continue;
+        }
+
+        for (const grfx::RenderGraphImageAccess& access : pass.accesses) {
+            ImageEntry& image = mImages[access.image.index];
+            image.firstPass   = std::min(image.firstPass, passIndex);
+            image.lastPass    = std::max(image.lastPass, passIndex);
+            AddUsageForState(access.state, image.usageFlags);
+        }
+    }
+}
+
+Result RenderGraph::CreateTransientImages(bool enableAliasing)
+{
+    // Largest first so the image that allocates the memory is the
+    // largest one sharing it
+    std::vector<uint32_t> transientImages;
+    for (uint32_t i = 0; i < CountU32(mImages); ++i) {
+        if (!mImages[i].imported && (mImages[i].firstPass != UINT32_MAX)) {
+            transientImages.push_back(i);
+        }
+    }
+    std::stable_sort(
+        transientImages.begin(),
+        transientImages.end(),
+        [this](uint32_t a, uint32_t b) { return EstimateImageSize(mImages[a].createInfo) > EstimateImageSize(mImages[b].createInfo); });
+
+    // Greedy interval assignment: an image joins the first memory of its
+    // kind whose current users' lifetimes don't overlap its own
+    struct Memory
+    {
+        MemoryKind            kind       = MEMORY_KIND_OTHER;
+        uint32_t              ownerIndex = 0;
+        std::vector<uint32_t> users;
+    };
+    std::vector<Memory> memories;
+
+    for (uint32_t imageIndex : transientImages) {
+        ImageEntry&      entry   = mImages[imageIndex];
+        const MemoryKind kind    = GetMemoryKind(entry.usageFlags);
+        Memory*          pMemory = nullptr;
+        if (enableAliasing) {
+            for (Memory& memory : memories) {
+                if (memory.kind != kind) {
+                    continue;
+                }
+                bool overlaps = false;
+                for (uint32_t userIndex : memory.users) {
+                    const ImageEntry& user = mImages[userIndex];
+                    overlaps               = overlaps || ((entry.firstPass <= user.lastPass) && (user.firstPass <= entry.lastPass));
+                }
+                if (!overlaps) {
+                    pMemory = &memory;
+                    break;
+                }
+            }
+        }
+
+        grfx::ImageCreateInfo ci = {};
+        ci.type                  = grfx::IMAGE_TYPE_2D;
+        ci.width                 = entry.createInfo.width;
+        ci.height                = entry.createInfo.height;
+        ci.depth                 = 1;
+        ci.format                = entry.createInfo.format;
+        ci.sampleCount           = entry.createInfo.sampleCount;
+        ci.mipLevelCount         = entry.createInfo.mipLevelCount;
+        ci.arrayLayerCount       = entry.createInfo.arrayLayerCount;
+        ci.usageFlags            = entry.usageFlags;
+        ci.memoryUsage           = grfx::MEMORY_USAGE_GPU_ONLY;
+        ci.initialState          = grfx::RESOURCE_STATE_UNDEFINED;
+        ci.RTVClearValue         = entry.createInfo.RTVClearValue;
+        ci.DSVClearValue         = entry.createInfo.DSVClearValue;
+
+        const uint64_t size = EstimateImageSize(entry.createInfo);
+        mStatistics.transientMemorySize += size;
+        mStatistics.transientImageCount += 1;
+
+        if (!IsNull(pMemory)) {
+            ci.pMemoryAliasImage = mImages[pMemory->ownerIndex].image;
+
+            Result ppxres = mDevice->CreateImage(&ci, &entry.image);
+            if (Success(ppxres)) {
+                entry.memoryAliasImage                    = mImages[pMemory->ownerIndex].image;
+                entry.sharesMemory                        = true;
+                mImages[pMemory->ownerIndex].sharesMemory = true;
+                pMemory->users.push_back(imageIndex);
+                mStatistics.aliasedImageCount += 1;
+                continue;
+            }
+
+            // API alignment or memory type didn't fit, use new memory
+            PPX_LOG_WARN("render graph image " << imageIndex << " could not share memory, allocating separately");
+            ci.pMemoryAliasImage = nullptr;
+        }
+
+        Result ppxres = mDevice->CreateImage(&ci, &entry.image);
+        if (Failed(ppxres)) {
+            PPX_ASSERT_MSG(false, "render graph image create failed");
+            return ppxres;
+        }
+        mStatistics.allocatedMemorySize += size;
+
+        Memory memory     = {};
+        memory.kind       = kind;
+        memory.ownerIndex = imageIndex;
+        memory.users.push_back(imageIndex);
+        memories.push_back(memory);
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result RenderGraph::CreateTextures()
+{
+    for (ImageEntry& entry : mImages) {
+        if (!entry.image || (entry.firstPass == UINT32_MAX)) {
+            continue;
+        }
+
+        grfx::TextureCreateInfo ci = {};
+        ci.pImage                  = entry.image;
+        ci.usageFlags              = entry.image->GetUsageFlags();
+
+        Result ppxres = mDevice->CreateTexture(&ci, &entry.texture);
+        if (Failed(ppxres)) {
+            PPX_ASSERT_MSG(false, "render graph texture create failed");
+            return ppxres;
+        }
+    }
+    return ppx::SUCCESS;
+}
+
+Result RenderGraph::CreateDrawPasses()
+{
+    for (PassEntry& pass : mPasses) {
+        const grfx::RenderGraphPassCreateInfo& passInfo = pass.createInfo;
+        if (pass.culled || ((passInfo.renderTargetCount == 0) && !passInfo.depthStencil.IsValid())) {
+            continue;
+        }
+
+        grfx::Image* pFirstAttachment = (passInfo.renderTargetCount > 0) ? mImages[passInfo.renderTargets[0].index].image : mImages[passInfo.depthStencil.index].image;
+
+        grfx::DrawPassCreateInfo3 ci = {};
+        ci.width                     = pFirstAttachment->GetWidth();
+        ci.height                    = pFirstAttachment->GetHeight();
+        ci.renderTargetCount         = passInfo.renderTargetCount;
+        ci.depthStencilState         = passInfo.depthStencilState;
+        for (uint32_t i = 0; i < passInfo.renderTargetCount; ++i) {
+            ci.pRenderTargetTextures[i] = mImages[passInfo.renderTargets[i].index].texture;
+        }
+        if (passInfo.depthStencil.IsValid()) {
+            ci.pDepthStencilTexture = mImages[passInfo.depthStencil.index].texture;
+        }
+
+        Result ppxres = mDevice->CreateDrawPass(&ci, &pass.drawPass);
+        if (Failed(ppxres)) {
+            PPX_ASSERT_MSG(false, "render graph draw pass create failed for pass '" << passInfo.name << "'");
+            return ppxres;
+        }
+    }
+    return ppx::SUCCESS;
+}
+
+Result RenderGraph::Compile(bool enableAliasing)
+{
+    if (mCompiled) {
+        PPX_ASSERT_MSG(false, "render graph is already compiled");
+        return ppx::ERROR_GRFX_OPERATION_NOT_PERMITTED;
+    }
+
+    mStatistics           = {};
+    mStatistics.passCount = CountU32(mPasses);
+
+    CullPasses();
+    for (const PassEntry& pass : mPasses) {
+        mStatistics.culledPassCount += pass.culled ? 1 : 0;
+    }
+
+    ComputeLifetimes();
+
+    Result ppxres = CreateTransientImages(enableAliasing);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    ppxres = CreateTextures();
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    ppxres = CreateDrawPasses();
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    mCompiled = true;
+
+    return ppx::SUCCESS;
+}
+
+Result RenderGraph::Execute(grfx::CommandBuffer* pCommandBuffer) const
+{
+    PPX_ASSERT_NULL_ARG(pCommandBuffer);
+
+    if (!mCompiled) {
+        PPX_ASSERT_MSG(false, "render graph must be compiled before it's executed");
+        return ppx::ERROR_GRFX_OPERATION_NOT_PERMITTED;
+    }
+
+    for (uint32_t passIndex = 0; passIndex < CountU32(mPasses); ++passIndex) {
+        const PassEntry& pass = mPasses[passIndex];
+        if (pass.culled) {
+            continue;
+        }
+
+        // Barriers queue up and go out together when the pass starts
+        for (const grfx::RenderGraphImageAccess& access : pass.accesses) {
+            const ImageEntry& image = mImages[access.image.index];
+            if ((image.firstPass == passIndex) && image.sharesMemory) {
+                pCommandBuffer->AliasingImageBarrier(image.image, access.state);
+            }
+            else {
+                pCommandBuffer->TransitionImageLayout(image.image, PPX_ALL_SUBRESOURCES, access.state);
+            }
+        }
+
+        if (pass.drawPass) {
+            pCommandBuffer->BeginRenderPass(pass.drawPass, pass.createInfo.clearFlags);
+            pCommandBuffer->SetScissors(pass.drawPass->GetScissor());
+            pCommandBuffer->SetViewports(pass.drawPass->GetViewport());
+        }
+
+        if (pass.createInfo.execute) {
+            pass.createInfo.execute(pCommandBuffer, *this);
+        }
+
+        if (pass.drawPass) {
+            pCommandBuffer->EndRenderPass();
+        }
+    }
+
+    for (const ImageEntry& image : mImages) {
+        if (image.imported && (image.finalState != grfx::RESOURCE_STATE_UNDEFINED)) {
+            pCommandBuffer->TransitionImageLayout(image.image, PPX_ALL_SUBRESOURCES, image.finalState);
+        }
+    }
+
+    return ppx::SUCCESS;
+}
+
+void RenderGraph::Reset()
+{
+    for (PassEntry& pass : mPasses) {
+        if (pass.drawPass) {
+            mDevice->DestroyDrawPass(pass.drawPass);
+        }
+    }
+    mPasses.clear();
+
+    for (ImageEntry& entry : mImages) {
+        if (entry.texture) {
+            mDevice->DestroyTexture(entry.texture);
+        }
+    }
+
+    // Images placed in another image's memory go first
+    for (ImageEntry& entry : mImages) {
+        if (!entry.imported && entry.memoryAliasImage) {
+            mDevice->DestroyImage(entry.image);
+        }
+    }
+    for (ImageEntry& entry : mImages) {
+        if (!entry.imported && entry.image && !entry.memoryAliasImage) {
+            mDevice->DestroyImage(entry.image);
+        }
+    }
+    mImages.clear();
+
+    mCompiled   = false;
+    mStatistics = {};
+}
+
+bool RenderGraph::IsPassCulled(uint32_t passIndex) const
+{
+    PPX_ASSERT_MSG(passIndex < mPasses.size(), "pass index out of range");
+    return mPasses[passIndex].culled;
+}
+
+grfx::Image* RenderGraph::GetImage(grfx::RenderGraphImage image) const
+{
+    PPX_ASSERT_MSG(image.index < mImages.size(), "render graph image out of range");
+    return mImages[image.index].image;
+}
+
+grfx::Texture* RenderGraph::GetTexture(grfx::RenderGraphImage image) const
+{
+    PPX_ASSERT_MSG(image.index < mImages.size(), "render graph image out of range");
+    return mImages[image.index].texture;
+}
+
+grfx::Image* RenderGraph::GetMemoryAliasImage(grfx::RenderGraphImage image) const
+{
+    PPX_ASSERT_MSG(image.index < mImages.size(), "render graph image out of range");
+    return mImages[image.index].memoryAliasImage;
+}
+
+} // namespace grfx
+} // namespace ppx
@@ -95,14 +95,7 @@ Result Swapchain::Create(const grfx::SwapchainCreateInfo* pCreateInfo)
         // Set mCurrentImageIndex to (imageCount - 1) so that the first
         // AcquireNextImage call acquires the first image at index 0.
         mCurrentImageIndex = mCreateInfo.imageCount - 1;
-
-        // Create command buffers to signal and wait semaphores at
-        // AcquireNextImage and Present calls.
-        for (uint32_t i = 0; i < mCreateInfo.imageCount; ++i) {
-            grfx::CommandBufferPtr commandBuffer = nullptr;
-            mCreateInfo.pQueue->CreateCommandBuffer(&commandBuffer, 0, 0);
-            mHeadlessCommandBuffers.push_back(commandBuffer);
-        }
+        mHeadlessWaitSemaphores.resize(mCreateInfo.imageCount);
     }
 
     PPX_LOG_INFO("Swapchain created");
@@ -133,12 +126,7 @@ void Swapchain::Destroy()
     }
 #endif
 
-    for (auto& elem : mHeadlessCommandBuffers) {
-        if (elem) {
-            mCreateInfo.pQueue->DestroyCommandBuffer(elem);
-        }
-    }
-    mHeadlessCommandBuffers.clear();
+    mHeadlessWaitSemaphores.clear();
 
     grfx::DeviceObject<grfx::SwapchainCreateInfo>::Destroy();
 }
@@ -474,35 +462,39 @@ Result Swapchain::AcquireNextImageHeadless(uint64_t timeout, grfx::Semaphore* pS
     *pImageIndex       = (mCurrentImageIndex + 1u) % CountU32(mColorImages);
     mCurrentImageIndex = *pImageIndex;
 
-    grfx::CommandBufferPtr commandBuffer = mHeadlessCommandBuffers[mCurrentImageIndex];
-
-    commandBuffer->Begin();
-    commandBuffer->End();
+    // Like a real swapchain, an image only becomes available again once its
+    // own last present is done. Presents of other images don't hold it up.
+    std::vector<const grfx::Semaphore*>& waitSemaphores = mHeadlessWaitSemaphores[*pImageIndex];
+    if (waitSemaphores.empty() && IsNull(pSemaphore) && IsNull(pFence)) {
+        return ppx::SUCCESS;
+    }
 
+    // A single submission without command buffers waits for the image's
+    // previous present and signals the acquire's semaphore and fence.
     grfx::SubmitInfo sInfo     = {};
-    sInfo.ppCommandBuffers     = &commandBuffer;
-    sInfo.commandBufferCount   = 1;
-    sInfo.pFence               = pFence;
+    sInfo.waitSemaphoreCount   = CountU32(waitSemaphores);
+    sInfo.ppWaitSemaphores     = DataPtr(waitSemaphores);
+    sInfo.signalSemaphoreCount = IsNull(pSemaphore) ? 0 : 1;
     sInfo.ppSignalSemaphores   = &pSemaphore;
-    sInfo.signalSemaphoreCount = 1;
-    mCreateInfo.pQueue->Submit(&sInfo);
+    sInfo.pFence               = pFence;
 
-    return ppx::SUCCESS;
+    Result ppxres = mCreateInfo.pQueue->Submit(&sInfo);
+    waitSemaphores.clear();
+
+    return ppxres;
 }
 
 Result Swapchain::PresentHeadless(uint32_t imageIndex, uint32_t waitSemaphoreCount, const grfx::Semaphore* const* ppWaitSemaphores)
 {
-    grfx::CommandBufferPtr commandBuffer = mHeadlessCommandBuffers[mCurrentImageIndex];
-
-    commandBuffer->Begin();
-    commandBuffer->End();
+    if (imageIndex >= CountU32(mHeadlessWaitSemaphores)) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
 
-    grfx::SubmitInfo sInfo   = {};
-    sInfo.ppCommandBuffers   = &commandBuffer;
-    sInfo.commandBufferCount = 1;
-    sInfo.ppWaitSemaphores   = ppWaitSemaphores;
-    sInfo.waitSemaphoreCount = waitSemaphoreCount;
-    mCreateInfo.pQueue->Submit(&sInfo);
+    // Nothing is presented, the waits are deferred to the submission of the
+    // next acquire of the same image so presenting doesn't cost a submission
+    // of its own.
+    std::vector<const grfx::Semaphore*>& waitSemaphores = mHeadlessWaitSemaphores[imageIndex];
+    waitSemaphores.insert(waitSemaphores.end(), ppWaitSemaphores, ppWaitSemaphores + waitSemaphoreCount);
 
     return ppx::SUCCESS;
 }
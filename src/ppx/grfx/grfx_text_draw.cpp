@@ -198,6 +198,7 @@ Result TextDraw::CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo)
         createInfo.usageFlags.bits.transferSrc = true;
         createInfo.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
         createInfo.initialState                = grfx::RESOURCE_STATE_COPY_SRC;
+        createInfo.persistentMap               = true;
 
         ppx::Result ppxres = GetDevice()->CreateBuffer(&createInfo, &mCpuIndexBuffer);
         if (Failed(ppxres)) {
@@ -210,6 +211,7 @@ Result TextDraw::CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo)
         createInfo.usageFlags.bits.indexBuffer = true;
         createInfo.memoryUsage                 = grfx::MEMORY_USAGE_GPU_ONLY;
         createInfo.initialState                = grfx::RESOURCE_STATE_INDEX_BUFFER;
+        createInfo.persistentMap               = false;
 
         ppxres = GetDevice()->CreateBuffer(&createInfo, &mGpuIndexBuffer);
         if (Failed(ppxres)) {
@@ -231,6 +233,7 @@ Result TextDraw::CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo)
         createInfo.usageFlags.bits.transferSrc = true;
         createInfo.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
         createInfo.initialState                = grfx::RESOURCE_STATE_COPY_SRC;
+        createInfo.persistentMap               = true;
 
         ppx::Result ppxres = GetDevice()->CreateBuffer(&createInfo, &mCpuVertexBuffer);
         if (Failed(ppxres)) {
@@ -243,6 +246,7 @@ Result TextDraw::CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo)
         createInfo.usageFlags.bits.vertexBuffer = true;
         createInfo.memoryUsage                  = grfx::MEMORY_USAGE_GPU_ONLY;
         createInfo.initialState                 = grfx::RESOURCE_STATE_VERTEX_BUFFER;
+        createInfo.persistentMap                = false;
 
         ppxres = GetDevice()->CreateBuffer(&createInfo, &mGpuVertexBuffer);
         if (Failed(ppxres)) {
@@ -288,6 +292,7 @@ Result TextDraw::CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo)
         createInfo.usageFlags.bits.transferSrc = true;
         createInfo.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
         createInfo.initialState                = grfx::RESOURCE_STATE_COPY_SRC;
+        createInfo.persistentMap               = true;
 
         ppx::Result ppxres = GetDevice()->CreateBuffer(&createInfo, &mCpuConstantBuffer);
         if (Failed(ppxres)) {
@@ -300,6 +305,7 @@ Result TextDraw::CreateApiObjects(const grfx::TextDrawCreateInfo* pCreateInfo)
         createInfo.usageFlags.bits.uniformBuffer = true;
         createInfo.memoryUsage                   = grfx::MEMORY_USAGE_GPU_ONLY;
         createInfo.initialState                  = grfx::RESOURCE_STATE_CONSTANT_BUFFER;
+        createInfo.persistentMap                 = false;
 
         ppxres = GetDevice()->CreateBuffer(&createInfo, &mGpuConstantBuffer);
         if (Failed(ppxres)) {
@@ -476,20 +482,9 @@ void TextDraw::AddString(
         return;
     }
 
-    // Map index buffer
-    void*       mappedAddress = nullptr;
-    ppx::Result ppxres        = mCpuIndexBuffer->MapMemory(0, &mappedAddress);
-    if (Failed(ppxres)) {
-        return;
-    }
-    uint8_t* pIndicesBaseAddr = static_cast<uint8_t*>(mappedAddress);
-
-    // Map vertex buffer
-    ppxres = mCpuVertexBuffer->MapMemory(0, &mappedAddress);
-    if (Failed(ppxres)) {
-        return;
-    }
-    uint8_t* pVerticesBaseAddr = static_cast<uint8_t*>(mappedAddress);
+    // CPU buffers are persistently mapped, UploadToGpu() flushes them
+    uint8_t* pIndicesBaseAddr  = static_cast<uint8_t*>(mCpuIndexBuffer->GetMappedAddress());
+    uint8_t* pVerticesBaseAddr = static_cast<uint8_t*>(mCpuVertexBuffer->GetMappedAddress());
 
     // Convert to 8 bit color
     uint32_t r    = std::min<uint32_t>(static_cast<uint32_t>(color.r * 255.0f), 255);
@@ -561,9 +556,6 @@ void TextDraw::AddString(
         mTextLength += 1;
         baseline.x += pMetrics->glyphMetrics.advance;
     }
-
-    mCpuIndexBuffer->UnmapMemory();
-    mCpuVertexBuffer->UnmapMemory();
 }
 
 void TextDraw::AddString(
@@ -575,14 +567,29 @@ void TextDraw::AddString(
     AddString(position, string, 3.0f, 1.0f, color, opacity);
 }
 
+ppx::Result TextDraw::FlushCpuBuffers()
+{
+    // Only the glyphs written so far need to reach the GPU
+    ppx::Result ppxres = mCpuIndexBuffer->FlushRange(0, mTextLength * kGlyphIndicesSize);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+    return mCpuVertexBuffer->FlushRange(0, mTextLength * kGlyphVerticesSize);
+}
+
 ppx::Result TextDraw::UploadToGpu(grfx::Queue* pQueue)
 {
+    ppx::Result ppxres = FlushCpuBuffers();
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
     grfx::BufferToBufferCopyInfo copyInfo = {};
     copyInfo.size                         = mCpuIndexBuffer->GetSize();
     copyInfo.srcBuffer.offset             = 0;
     copyInfo.dstBuffer.offset             = 0;
 
-    ppx::Result ppxres = pQueue->CopyBufferToBuffer(&copyInfo, mCpuIndexBuffer, mGpuIndexBuffer, grfx::RESOURCE_STATE_INDEX_BUFFER, grfx::RESOURCE_STATE_INDEX_BUFFER);
+    ppxres = pQueue->CopyBufferToBuffer(&copyInfo, mCpuIndexBuffer, mGpuIndexBuffer, grfx::RESOURCE_STATE_INDEX_BUFFER, grfx::RESOURCE_STATE_INDEX_BUFFER);
     if (Failed(ppxres)) {
         return ppxres;
     }
@@ -598,41 +605,38 @@ ppx::Result TextDraw::UploadToGpu(grfx::Queue* pQueue)
 
 void TextDraw::UploadToGpu(grfx::CommandBuffer* pCommandBuffer)
 {
+    FlushCpuBuffers();
+
     grfx::BufferToBufferCopyInfo copyInfo = {};
     copyInfo.size                         = mTextLength * kGlyphIndicesSize;
     copyInfo.srcBuffer.offset             = 0;
     copyInfo.dstBuffer.offset             = 0;
 
-    pCommandBuffer->BufferResourceBarrier(mGpuIndexBuffer, grfx::RESOURCE_STATE_INDEX_BUFFER, grfx::RESOURCE_STATE_COPY_DST);
-    pCommandBuffer->CopyBufferToBuffer(&copyInfo, mCpuIndexBuffer, mGpuIndexBuffer);
-    pCommandBuffer->BufferResourceBarrier(mGpuIndexBuffer, grfx::RESOURCE_STATE_COPY_DST, grfx::RESOURCE_STATE_INDEX_BUFFER);
+    // Both buffers transition together so each side of the copies is a single barrier batch
+    pCommandBuffer->BufferResourceBarrier(mGpuIndexBuffer, grfx::RESOURCE_STATE_COPY_DST);
+    pCommandBuffer->BufferResourceBarrier(mGpuVertexBuffer, grfx::RESOURCE_STATE_COPY_DST);
 
+    pCommandBuffer->CopyBufferToBuffer(&copyInfo, mCpuIndexBuffer, mGpuIndexBuffer);
     copyInfo.size = mTextLength * kGlyphVerticesSize;
-    pCommandBuffer->BufferResourceBarrier(mGpuVertexBuffer, grfx::RESOURCE_STATE_VERTEX_BUFFER, grfx::RESOURCE_STATE_COPY_DST);
     pCommandBuffer->CopyBufferToBuffer(&copyInfo, mCpuVertexBuffer, mGpuVertexBuffer);
-    pCommandBuffer->BufferResourceBarrier(mGpuVertexBuffer, grfx::RESOURCE_STATE_COPY_DST, grfx::RESOURCE_STATE_VERTEX_BUFFER);
+
+    pCommandBuffer->BufferResourceBarrier(mGpuIndexBuffer, grfx::RESOURCE_STATE_INDEX_BUFFER);
+    pCommandBuffer->BufferResourceBarrier(mGpuVertexBuffer, grfx::RESOURCE_STATE_VERTEX_BUFFER);
 }
 
 void TextDraw::PrepareDraw(const float4x4& MVP, grfx::CommandBuffer* pCommandBuffer)
 {
-    void*       mappedAddress = nullptr;
-    ppx::Result ppxres        = mCpuConstantBuffer->MapMemory(0, &mappedAddress);
-    if (Failed(ppxres)) {
-        return;
-    }
-
-    std::memcpy(mappedAddress, &MVP, sizeof(float4x4));
-
-    mCpuConstantBuffer->UnmapMemory();
+    std::memcpy(mCpuConstantBuffer->GetMappedAddress(), &MVP, sizeof(float4x4));
+    mCpuConstantBuffer->FlushRange(0, sizeof(float4x4));
 
     grfx::BufferToBufferCopyInfo copyInfo = {};
     copyInfo.size                         = mCpuConstantBuffer->GetSize();
     copyInfo.srcBuffer.offset             = 0;
     copyInfo.dstBuffer.offset             = 0;
 
-    pCommandBuffer->BufferResourceBarrier(mGpuConstantBuffer, grfx::RESOURCE_STATE_CONSTANT_BUFFER, grfx::RESOURCE_STATE_COPY_DST);
+    pCommandBuffer->BufferResourceBarrier(mGpuConstantBuffer, grfx::RESOURCE_STATE_COPY_DST);
     pCommandBuffer->CopyBufferToBuffer(&copyInfo, mCpuConstantBuffer, mGpuConstantBuffer);
-    pCommandBuffer->BufferResourceBarrier(mGpuConstantBuffer, grfx::RESOURCE_STATE_COPY_DST, grfx::RESOURCE_STATE_CONSTANT_BUFFER);
+    pCommandBuffer->BufferResourceBarrier(mGpuConstantBuffer, grfx::RESOURCE_STATE_CONSTANT_BUFFER);
 }
 
 void TextDraw::Draw(grfx::CommandBuffer* pCommandBuffer)
@@ -26,10 +26,25 @@ const char* ToString(grfx::Api value)
         case grfx::API_VK_1_2: return "Vulkan 1.2"; break;
         case grfx::API_DX_12_0: return "Direct3D 12.0"; break;
         case grfx::API_DX_12_1: return "Direct3D 12.1"; break;
+        case grfx::API_NULL: return "Null"; break;
     }
     return "<unknown graphics API>";
 }
 
+const char* ToString(grfx::MemoryCategory value)
+{
+    switch (value) {
+        default: break;
+        case grfx::MEMORY_CATEGORY_UNDEFINED: return "Undefined"; break;
+        case grfx::MEMORY_CATEGORY_TEXTURE: return "Texture"; break;
+        case grfx::MEMORY_CATEGORY_MESH: return "Mesh"; break;
+        case grfx::MEMORY_CATEGORY_RENDER_TARGET: return "Render Target"; break;
+        case grfx::MEMORY_CATEGORY_STAGING: return "Staging"; break;
+        case grfx::MEMORY_CATEGORY_OTHER: return "Other"; break;
+    }
+    return "<unknown memory category>";
+}
+
 const char* ToString(grfx::DescriptorType value)
 {
     // clang-format off
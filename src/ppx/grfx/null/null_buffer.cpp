@@ -0,0 +1,137 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_buffer.h"
+#include "ppx/grfx/null/null_device.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+// Matches VMA's preferred block size for large heaps
+static constexpr uint64_t kDefaultMemoryPoolBlockSize = 256 * 1024 * 1024;
+
+Result MemoryPool::CreateApiObjects(const grfx::MemoryPoolCreateInfo* pCreateInfo)
+{
+    mBlockSize = (pCreateInfo->blockSize > 0) ? pCreateInfo->blockSize : kDefaultMemoryPoolBlockSize;
+    return ppx::SUCCESS;
+}
+
+void MemoryPool::DestroyApiObjects()
+{
+    mAllocationCount = 0;
+    mAllocationBytes = 0;
+}
+
+uint32_t MemoryPool::GetBlockCount(uint64_t allocationBytes) const
+{
+    uint32_t blockCount = static_cast<uint32_t>((allocationBytes + mBlockSize - 1) / mBlockSize);
+    return std::max(blockCount, mCreateInfo.minBlockCount);
+}
+
+grfx::MemoryPoolStatistics MemoryPool::GetStatistics() const
+{
+    grfx::MemoryPoolStatistics statistics = {};
+    statistics.blockCount                 = GetBlockCount(mAllocationBytes);
+    statistics.allocationCount            = mAllocationCount;
+    statistics.blockBytes                 = statistics.blockCount * mBlockSize;
+    statistics.allocationBytes            = mAllocationBytes;
+    return statistics;
+}
+
+Result MemoryPool::Allocate(uint64_t size)
+{
+    if (size > mBlockSize) {
+        return ppx::ERROR_OUT_OF_MEMORY;
+    }
+    if ((mCreateInfo.maxBlockCount > 0) && (GetBlockCount(mAllocationBytes + size) > mCreateInfo.maxBlockCount)) {
+        return ppx::ERROR_OUT_OF_MEMORY;
+    }
+    mAllocationCount += 1;
+    mAllocationBytes += size;
+    return ppx::SUCCESS;
+}
+
+void MemoryPool::Free(uint64_t size)
+{
+    PPX_ASSERT_MSG((mAllocationCount > 0) && (mAllocationBytes >= size), "memory pool free without a matching allocation");
+    mAllocationCount -= 1;
+    mAllocationBytes -= size;
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
+{
+    if (!IsNull(pCreateInfo->pMemoryPool)) {
+        Result ppxres = ToApi(pCreateInfo->pMemoryPool)->Allocate(pCreateInfo->size);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    AllocateNullHandle(GetDevice());
+    mAllocationSize = pCreateInfo->size;
+
+    if (pCreateInfo->persistentMap) {
+        mMemory.resize(static_cast<size_t>(pCreateInfo->size));
+        mMappedAddress = mMemory.data();
+    }
+
+    return ppx::SUCCESS;
+}
+
+void Buffer::DestroyApiObjects()
+{
+    if (!IsNull(mCreateInfo.pMemoryPool) && (mAllocationSize > 0)) {
+        ToApi(mCreateInfo.pMemoryPool)->Free(mAllocationSize);
+    }
+    mMappedAddress  = nullptr;
+    mAllocationSize = 0;
+    mMemory.clear();
+    mMemory.shrink_to_fit();
+}
+
+Result Buffer::MapMemory(uint64_t offset, void** ppMappedAddress)
+{
+    PPX_ASSERT_NULL_ARG(ppMappedAddress);
+    if (offset >= GetSize()) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+
+    if (mMemory.empty()) {
+        mMemory.resize(static_cast<size_t>(GetSize()));
+    }
+
+    *ppMappedAddress = mMemory.data() + offset;
+    return ppx::SUCCESS;
+}
+
+void Buffer::UnmapMemory()
+{
+}
+
+Result Buffer::FlushRangeImpl(uint64_t offset, uint64_t size)
+{
+    return ppx::SUCCESS;
+}
+
+Result Buffer::InvalidateRangeImpl(uint64_t offset, uint64_t size)
+{
+    return ppx::SUCCESS;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
@@ -0,0 +1,723 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_command.h"
+#include "ppx/grfx/null/null_buffer.h"
+#include "ppx/grfx/null/null_descriptor.h"
+#include "ppx/grfx/null/null_device.h"
+#include "ppx/grfx/null/null_image.h"
+#include "ppx/grfx/null/null_pipeline.h"
+#include "ppx/grfx/null/null_query.h"
+#include "ppx/grfx/null/null_render_pass.h"
+
+#include <cstring>
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+namespace {
+
+template <typename GrfxTypeT>
+uint32_t NullHandle(const GrfxTypeT* pObject)
+{
+    return IsNull(pObject) ? 0 : ToApi(pObject)->GetNullHandle();
+}
+
+uint32_t LowBits(uint64_t value)
+{
+    return static_cast<uint32_t>(value & 0xFFFFFFFF);
+}
+
+uint32_t HighBits(uint64_t value)
+{
+    return static_cast<uint32_t>(value >> 32);
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+// CommandStream
+// -------------------------------------------------------------------------------------------------
+void CommandStream::Clear()
+{
+    mWords.clear();
+    mCommandCount = 0;
+    std::memset(mOpCounts, 0, sizeof(mOpCounts));
+}
+
+void CommandStream::Write(grfx::null::CommandOp op, std::initializer_list<uint32_t> args)
+{
+    uint32_t* pArgs = Write(op, static_cast<uint32_t>(args.size()));
+    std::copy(args.begin(), args.end(), pArgs);
+}
+
+uint32_t* CommandStream::Write(grfx::null::CommandOp op, uint32_t argCount)
+{
+    PPX_ASSERT_MSG(argCount <= 0xFFFF, "too many command arguments");
+
+    size_t offset = mWords.size();
+    mWords.resize(offset + 1 + argCount);
+    mWords[offset] = static_cast<uint32_t>(op) | (argCount << 16);
+
+    ++mCommandCount;
+    ++mOpCounts[op];
+
+    return mWords.data() + offset + 1;
+}
+
+bool CommandStream::Read(size_t* pOffset, Command* pCommand) const
+{
+    PPX_ASSERT_NULL_ARG(pOffset);
+    PPX_ASSERT_NULL_ARG(pCommand);
+
+    if (*pOffset >= mWords.size()) {
+        return false;
+    }
+
+    uint32_t header    = mWords[*pOffset];
+    pCommand->op       = static_cast<grfx::null::CommandOp>(header & 0xFFFF);
+    pCommand->argCount = header >> 16;
+    pCommand->pArgs    = mWords.data() + *pOffset + 1;
+    *pOffset += 1 + pCommand->argCount;
+
+    PPX_ASSERT_MSG(*pOffset <= mWords.size(), "truncated command stream");
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+// CommandBuffer
+// -------------------------------------------------------------------------------------------------
+Result CommandBuffer::CreateApiObjects(const grfx::internal::CommandBufferCreateInfo* pCreateInfo)
+{
+    return ppx::SUCCESS;
+}
+
+void CommandBuffer::DestroyApiObjects()
+{
+    mCommandStream.Clear();
+}
+
+Result CommandBuffer::BeginImpl()
+{
+    mRecording = ToApi(GetDevice())->IsCommandRecordingEnabled();
+    mCommandStream.Clear();
+    return ppx::SUCCESS;
+}
+
+Result CommandBuffer::EndImpl()
+{
+    return ppx::SUCCESS;
+}
+
+void CommandBuffer::BeginRenderPassImpl(const grfx::RenderPassBeginInfo* pBeginInfo)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_BEGIN_RENDER_PASS,
+        {NullHandle(pBeginInfo->pRenderPass),
+         static_cast<uint32_t>(pBeginInfo->renderArea.x),
+         static_cast<uint32_t>(pBeginInfo->renderArea.y),
+         pBeginInfo->renderArea.width,
+         pBeginInfo->renderArea.height,
+         pBeginInfo->RTVClearCount});
+}
+
+void CommandBuffer::EndRenderPassImpl()
+{
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_END_RENDER_PASS, {});
+}
+
+void CommandBuffer::BeginRenderingImpl(const grfx::RenderingInfo* pRenderingInfo)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t  argCount = 6 + pRenderingInfo->renderTargetCount;
+    uint32_t* pArgs    = mCommandStream.Write(COMMAND_OP_BEGIN_RENDERING, argCount);
+    pArgs[0]           = static_cast<uint32_t>(pRenderingInfo->renderArea.x);
+    pArgs[1]           = static_cast<uint32_t>(pRenderingInfo->renderArea.y);
+    pArgs[2]           = pRenderingInfo->renderArea.width;
+    pArgs[3]           = pRenderingInfo->renderArea.height;
+    pArgs[4]           = NullHandle(pRenderingInfo->pDepthStencilView);
+    pArgs[5]           = pRenderingInfo->renderTargetCount;
+    for (uint32_t i = 0; i < pRenderingInfo->renderTargetCount; ++i) {
+        pArgs[6 + i] = NullHandle(pRenderingInfo->pRenderTargetViews[i]);
+    }
+}
+
+void CommandBuffer::EndRenderingImpl()
+{
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_END_RENDERING, {});
+}
+
+void CommandBuffer::PushDescriptorImpl(
+    grfx::CommandType              pipelineBindPoint,
+    const grfx::PipelineInterface* pInterface,
+    grfx::DescriptorType           descriptorType,
+    uint32_t                       binding,
+    uint32_t                       set,
+    uint32_t                       bufferOffset,
+    const grfx::Buffer*            pBuffer,
+    const grfx::SampledImageView*  pSampledImageView,
+    const grfx::StorageImageView*  pStorageImageView,
+    const grfx::Sampler*           pSampler)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t resource = 0;
+    if (!IsNull(pBuffer)) {
+        resource = NullHandle(pBuffer);
+    }
+    else if (!IsNull(pSampledImageView)) {
+        resource = NullHandle(pSampledImageView);
+    }
+    else if (!IsNull(pStorageImageView)) {
+        resource = NullHandle(pStorageImageView);
+    }
+    else if (!IsNull(pSampler)) {
+        resource = NullHandle(pSampler);
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_PUSH_DESCRIPTOR,
+        {static_cast<uint32_t>(pipelineBindPoint),
+         NullHandle(pInterface),
+         static_cast<uint32_t>(descriptorType),
+         binding,
+         set,
+         bufferOffset,
+         resource});
+}
+
+void CommandBuffer::ClearRenderTarget(
+    grfx::Image*                        pImage,
+    const grfx::RenderTargetClearValue& clearValue)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t* pArgs = mCommandStream.Write(COMMAND_OP_CLEAR_RENDER_TARGET, 5);
+    pArgs[0]        = NullHandle(pImage);
+    std::memcpy(pArgs + 1, &clearValue.rgba, sizeof(float) * 4);
+}
+
+void CommandBuffer::ClearDepthStencil(
+    grfx::Image*                        pImage,
+    const grfx::DepthStencilClearValue& clearValue,
+    uint32_t                            clearFlags)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t* pArgs = mCommandStream.Write(COMMAND_OP_CLEAR_DEPTH_STENCIL, 4);
+    pArgs[0]        = NullHandle(pImage);
+    std::memcpy(pArgs + 1, &clearValue.depth, sizeof(float));
+    pArgs[2] = clearValue.stencil;
+    pArgs[3] = clearFlags;
+}
+
+void CommandBuffer::PipelineBarrierImpl(
+    uint32_t                   imageBarrierCount,
+    const grfx::ImageBarrier*  pImageBarriers,
+    uint32_t                   bufferBarrierCount,
+    const grfx::BufferBarrier* pBufferBarriers)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    // Counts followed by 8 words per image barrier and 3 words per buffer barrier
+    const uint32_t kWordsPerImageBarrier  = 8;
+    const uint32_t kWordsPerBufferBarrier = 3;
+
+    uint32_t* pArgs = mCommandStream.Write(COMMAND_OP_PIPELINE_BARRIER, 2 + imageBarrierCount * kWordsPerImageBarrier + bufferBarrierCount * kWordsPerBufferBarrier);
+    pArgs[0]        = imageBarrierCount;
+    pArgs[1]        = bufferBarrierCount;
+    pArgs += 2;
+    for (uint32_t i = 0; i < imageBarrierCount; ++i, pArgs += kWordsPerImageBarrier) {
+        const grfx::ImageBarrier& barrier = pImageBarriers[i];
+        pArgs[0]                          = NullHandle(barrier.pImage);
+        pArgs[1]                          = barrier.mipLevel;
+        pArgs[2]                          = barrier.mipLevelCount;
+        pArgs[3]                          = barrier.arrayLayer;
+        pArgs[4]                          = barrier.arrayLayerCount;
+        pArgs[5]                          = static_cast<uint32_t>(barrier.beforeState);
+        pArgs[6]                          = static_cast<uint32_t>(barrier.afterState);
+        pArgs[7]                          = barrier.discardContents ? 1 : 0;
+    }
+    for (uint32_t i = 0; i < bufferBarrierCount; ++i, pArgs += kWordsPerBufferBarrier) {
+        const grfx::BufferBarrier& barrier = pBufferBarriers[i];
+        pArgs[0]                           = NullHandle(barrier.pBuffer);
+        pArgs[1]                           = static_cast<uint32_t>(barrier.beforeState);
+        pArgs[2]                           = static_cast<uint32_t>(barrier.afterState);
+    }
+}
+
+void CommandBuffer::SetViewportsImpl(
+    uint32_t              viewportCount,
+    const grfx::Viewport* pViewports)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    const uint32_t kFloatsPerViewport = 6;
+
+    uint32_t* pArgs = mCommandStream.Write(COMMAND_OP_SET_VIEWPORTS, 1 + viewportCount * kFloatsPerViewport);
+    pArgs[0]        = viewportCount;
+    for (uint32_t i = 0; i < viewportCount; ++i) {
+        const float values[kFloatsPerViewport] = {
+            pViewports[i].x,
+            pViewports[i].y,
+            pViewports[i].width,
+            pViewports[i].height,
+            pViewports[i].minDepth,
+            pViewports[i].maxDepth};
+        std::memcpy(pArgs + 1 + i * kFloatsPerViewport, values, sizeof(values));
+    }
+}
+
+void CommandBuffer::SetScissorsImpl(
+    uint32_t          scissorCount,
+    const grfx::Rect* pScissors)
+{
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t* pArgs = mCommandStream.Write(COMMAND_OP_SET_SCISSORS, 1 + scissorCount * 4);
+    pArgs[0]        = scissorCount;
+    for (uint32_t i = 0; i < scissorCount; ++i) {
+        pArgs[1 + i * 4 + 0] = static_cast<uint32_t>(pScissors[i].x);
+        pArgs[1 + i * 4 + 1] = static_cast<uint32_t>(pScissors[i].y);
+        pArgs[1 + i * 4 + 2] = pScissors[i].width;
+        pArgs[1 + i * 4 + 3] = pScissors[i].height;
+    }
+}
+
+void CommandBuffer::BindDescriptorSets(
+    grfx::null::CommandOp             op,
+    const grfx::PipelineInterface*    pInterface,
+    uint32_t                          setCount,
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
+{
+    PPX_ASSERT_NULL_ARG(pInterface);
+
+    uint32_t totalDynamicOffsetCount = 0;
+    for (uint32_t i = 0; i < setCount; ++i) {
+        totalDynamicOffsetCount += ppSets[i]->GetLayout()->GetDynamicOffsetCount();
+    }
+    PPX_ASSERT_MSG(dynamicOffsetCount == totalDynamicOffsetCount, "dynamicOffsetCount (" << dynamicOffsetCount << ") does not match the dynamic bindings in ppSets (" << totalDynamicOffsetCount << ")");
+
+    if (!mRecording) {
+        return;
+    }
+
+    // Sets followed by dynamic offsets
+    uint32_t* pArgs = mCommandStream.Write(op, 3 + setCount + dynamicOffsetCount);
+    pArgs[0]        = NullHandle(pInterface);
+    pArgs[1]        = setCount;
+    for (uint32_t i = 0; i < setCount; ++i) {
+        pArgs[2 + i] = NullHandle(ppSets[i]);
+    }
+    pArgs[2 + setCount] = dynamicOffsetCount;
+    for (uint32_t i = 0; i < dynamicOffsetCount; ++i) {
+        pArgs[3 + setCount + i] = pDynamicOffsets[i];
+    }
+}
+
+void CommandBuffer::PushConstants(
+    grfx::null::CommandOp          op,
+    const grfx::PipelineInterface* pInterface,
+    uint32_t                       count,
+    const void*                    pValues,
+    uint32_t                       dstOffset)
+{
+    PPX_ASSERT_NULL_ARG(pInterface);
+    PPX_ASSERT_NULL_ARG(pValues);
+    PPX_ASSERT_MSG(((dstOffset + count) <= PPX_MAX_PUSH_CONSTANTS), "dstOffset + count (" << (dstOffset + count) << ") exceeds PPX_MAX_PUSH_CONSTANTS (" << PPX_MAX_PUSH_CONSTANTS << ")");
+
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t* pArgs = mCommandStream.Write(op, 3 + count);
+    pArgs[0]        = NullHandle(pInterface);
+    pArgs[1]        = count;
+    pArgs[2]        = dstOffset;
+    std::memcpy(pArgs + 3, pValues, count * sizeof(uint32_t));
+}
+
+void CommandBuffer::BindGraphicsDescriptorSetsImpl(
+    const grfx::PipelineInterface*    pInterface,
+    uint32_t                          setCount,
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
+{
+    BindDescriptorSets(COMMAND_OP_BIND_GRAPHICS_DESCRIPTOR_SETS, pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets);
+}
+
+void CommandBuffer::PushGraphicsConstants(
+    const grfx::PipelineInterface* pInterface,
+    uint32_t                       count,
+    const void*                    pValues,
+    uint32_t                       dstOffset)
+{
+    PushConstants(COMMAND_OP_PUSH_GRAPHICS_CONSTANTS, pInterface, count, pValues, dstOffset);
+}
+
+void CommandBuffer::BindGraphicsPipelineImpl(const grfx::GraphicsPipeline* pPipeline)
+{
+    PPX_ASSERT_NULL_ARG(pPipeline);
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_BIND_GRAPHICS_PIPELINE, {NullHandle(pPipeline)});
+}
+
+void CommandBuffer::BindComputeDescriptorSets(
+    const grfx::PipelineInterface*    pInterface,
+    uint32_t                          setCount,
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
+{
+    BindDescriptorSets(COMMAND_OP_BIND_COMPUTE_DESCRIPTOR_SETS, pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets);
+}
+
+void CommandBuffer::PushComputeConstants(
+    const grfx::PipelineInterface* pInterface,
+    uint32_t                       count,
+    const void*                    pValues,
+    uint32_t                       dstOffset)
+{
+    PushConstants(COMMAND_OP_PUSH_COMPUTE_CONSTANTS, pInterface, count, pValues, dstOffset);
+}
+
+void CommandBuffer::BindComputePipeline(const grfx::ComputePipeline* pPipeline)
+{
+    PPX_ASSERT_NULL_ARG(pPipeline);
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_BIND_COMPUTE_PIPELINE, {NullHandle(pPipeline)});
+}
+
+void CommandBuffer::BindIndexBufferImpl(const grfx::IndexBufferView* pView)
+{
+    PPX_ASSERT_NULL_ARG(pView);
+    PPX_ASSERT_NULL_ARG(pView->pBuffer);
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_BIND_INDEX_BUFFER,
+        {NullHandle(pView->pBuffer),
+         static_cast<uint32_t>(pView->indexType),
+         LowBits(pView->offset),
+         HighBits(pView->offset)});
+}
+
+void CommandBuffer::BindVertexBuffersImpl(
+    uint32_t                      viewCount,
+    const grfx::VertexBufferView* pViews)
+{
+    PPX_ASSERT_NULL_ARG(pViews);
+    PPX_ASSERT_MSG(viewCount < PPX_MAX_VERTEX_BINDINGS, "viewCount exceeds PPX_MAX_VERTEX_BINDINGS");
+
+    if (!mRecording) {
+        return;
+    }
+
+    uint32_t* pArgs = mCommandStream.Write(COMMAND_OP_BIND_VERTEX_BUFFERS, 1 + viewCount * 4);
+    pArgs[0]        = viewCount;
+    for (uint32_t i = 0; i < viewCount; ++i) {
+        pArgs[1 + i * 4 + 0] = NullHandle(pViews[i].pBuffer);
+        pArgs[1 + i * 4 + 1] = pViews[i].stride;
+        pArgs[1 + i * 4 + 2] = LowBits(pViews[i].offset);
+        pArgs[1 + i * 4 + 3] = HighBits(pViews[i].offset);
+    }
+}
+
+void CommandBuffer::Draw(
+    uint32_t vertexCount,
+    uint32_t instanceCount,
+    uint32_t firstVertex,
+    uint32_t firstInstance)
+{
+    FlushBarriers();
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_DRAW, {vertexCount, instanceCount, firstVertex, firstInstance});
+}
+
+void CommandBuffer::DrawIndexed(
+    uint32_t indexCount,
+    uint32_t instanceCount,
+    uint32_t firstIndex,
+    int32_t  vertexOffset,
+    uint32_t firstInstance)
+{
+    FlushBarriers();
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_DRAW_INDEXED,
+        {indexCount,
+         instanceCount,
+         firstIndex,
+         static_cast<uint32_t>(vertexOffset),
+         firstInstance});
+}
+
+void CommandBuffer::Dispatch(
+    uint32_t groupCountX,
+    uint32_t groupCountY,
+    uint32_t groupCountZ)
+{
+    FlushBarriers();
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_DISPATCH, {groupCountX, groupCountY, groupCountZ});
+}
+
+void CommandBuffer::CopyBufferToBuffer(
+    const grfx::BufferToBufferCopyInfo* pCopyInfo,
+    grfx::Buffer*                       pSrcBuffer,
+    grfx::Buffer*                       pDstBuffer)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pCopyInfo);
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_COPY_BUFFER_TO_BUFFER,
+        {NullHandle(pSrcBuffer),
+         NullHandle(pDstBuffer),
+         LowBits(pCopyInfo->srcBuffer.offset),
+         HighBits(pCopyInfo->srcBuffer.offset),
+         pCopyInfo->dstBuffer.offset,
+         LowBits(pCopyInfo->size),
+         HighBits(pCopyInfo->size)});
+}
+
+void CommandBuffer::CopyBufferToImage(
+    const std::vector<grfx::BufferToImageCopyInfo>& pCopyInfos,
+    grfx::Buffer*                                   pSrcBuffer,
+    grfx::Image*                                    pDstImage)
+{
+    for (const auto& copyInfo : pCopyInfos) {
+        CopyBufferToImage(&copyInfo, pSrcBuffer, pDstImage);
+    }
+}
+
+void CommandBuffer::CopyBufferToImage(
+    const grfx::BufferToImageCopyInfo* pCopyInfo,
+    grfx::Buffer*                      pSrcBuffer,
+    grfx::Image*                       pDstImage)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pCopyInfo);
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_COPY_BUFFER_TO_IMAGE,
+        {NullHandle(pSrcBuffer),
+         NullHandle(pDstImage),
+         LowBits(pCopyInfo->srcBuffer.footprintOffset),
+         HighBits(pCopyInfo->srcBuffer.footprintOffset),
+         pCopyInfo->dstImage.mipLevel,
+         pCopyInfo->dstImage.arrayLayer,
+         pCopyInfo->dstImage.arrayLayerCount});
+}
+
+grfx::ImageToBufferOutputPitch CommandBuffer::CopyImageToBuffer(
+    const grfx::ImageToBufferCopyInfo* pCopyInfo,
+    grfx::Image*                       pSrcImage,
+    grfx::Buffer*                      pDstBuffer)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pCopyInfo);
+    PPX_ASSERT_NULL_ARG(pSrcImage);
+
+    if (mRecording) {
+        mCommandStream.Write(
+            COMMAND_OP_COPY_IMAGE_TO_BUFFER,
+            {NullHandle(pSrcImage),
+             NullHandle(pDstBuffer),
+             pCopyInfo->srcImage.mipLevel,
+             pCopyInfo->srcImage.arrayLayer,
+             pCopyInfo->srcImage.arrayLayerCount});
+    }
+
+    // Tightly packed, same as Vulkan
+    const grfx::FormatDesc*        srcDesc = grfx::GetFormatDescription(pSrcImage->GetFormat());
+    grfx::ImageToBufferOutputPitch outPitch;
+    outPitch.rowPitch = srcDesc->bytesPerTexel * pCopyInfo->extent.x;
+    return outPitch;
+}
+
+void CommandBuffer::CopyImageToImage(
+    const grfx::ImageToImageCopyInfo* pCopyInfo,
+    grfx::Image*                      pSrcImage,
+    grfx::Image*                      pDstImage)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pCopyInfo);
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_COPY_IMAGE_TO_IMAGE,
+        {NullHandle(pSrcImage),
+         NullHandle(pDstImage),
+         pCopyInfo->srcImage.mipLevel,
+         pCopyInfo->dstImage.mipLevel,
+         pCopyInfo->extent.x,
+         pCopyInfo->extent.y,
+         pCopyInfo->extent.z});
+}
+
+void CommandBuffer::BeginQuery(
+    const grfx::Query* pQuery,
+    uint32_t           queryIndex)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pQuery);
+    PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_BEGIN_QUERY, {NullHandle(pQuery), queryIndex});
+}
+
+void CommandBuffer::EndQuery(
+    const grfx::Query* pQuery,
+    uint32_t           queryIndex)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pQuery);
+    PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_END_QUERY, {NullHandle(pQuery), queryIndex});
+}
+
+void CommandBuffer::WriteTimestamp(
+    const grfx::Query*  pQuery,
+    grfx::PipelineStage pipelineStage,
+    uint32_t            queryIndex)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pQuery);
+    PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(
+        COMMAND_OP_WRITE_TIMESTAMP,
+        {NullHandle(pQuery),
+         static_cast<uint32_t>(pipelineStage),
+         queryIndex});
+}
+
+void CommandBuffer::ResolveQueryData(
+    grfx::Query* pQuery,
+    uint32_t     startIndex,
+    uint32_t     numQueries)
+{
+    FlushBarriers();
+
+    PPX_ASSERT_NULL_ARG(pQuery);
+    PPX_ASSERT_MSG((startIndex + numQueries) <= pQuery->GetCount(), "invalid query index/number");
+
+    if (!mRecording) {
+        return;
+    }
+
+    mCommandStream.Write(COMMAND_OP_RESOLVE_QUERY_DATA, {NullHandle(pQuery), startIndex, numQueries});
+}
+
+// -------------------------------------------------------------------------------------------------
+// CommandPool
+// -------------------------------------------------------------------------------------------------
+Result CommandPool::CreateApiObjects(const grfx::CommandPoolCreateInfo* pCreateInfo)
+{
+    return ppx::SUCCESS;
+}
+
+void CommandPool::DestroyApiObjects()
+{
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
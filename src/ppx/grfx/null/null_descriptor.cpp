@@ -0,0 +1,67 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_descriptor.h"
+#include "ppx/grfx/null/null_device.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+// -------------------------------------------------------------------------------------------------
+// DescriptorPool
+// -------------------------------------------------------------------------------------------------
+Result DescriptorPool::CreateApiObjects(const grfx::DescriptorPoolCreateInfo* pCreateInfo)
+{
+    return ppx::SUCCESS;
+}
+
+void DescriptorPool::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// DescriptorSet
+// -------------------------------------------------------------------------------------------------
+Result DescriptorSet::CreateApiObjects(const grfx::internal::DescriptorSetCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void DescriptorSet::DestroyApiObjects()
+{
+}
+
+Result DescriptorSet::UpdateDescriptors(uint32_t writeCount, const grfx::WriteDescriptor* pWrites)
+{
+    // Descriptors are never read
+    return ppx::SUCCESS;
+}
+
+// -------------------------------------------------------------------------------------------------
+// DescriptorSetLayout
+// -------------------------------------------------------------------------------------------------
+Result DescriptorSetLayout::CreateApiObjects(const grfx::DescriptorSetLayoutCreateInfo* pCreateInfo)
+{
+    return ppx::SUCCESS;
+}
+
+void DescriptorSetLayout::DestroyApiObjects()
+{
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
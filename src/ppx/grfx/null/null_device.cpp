@@ -0,0 +1,382 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_device.h"
+#include "ppx/grfx/null/null_buffer.h"
+#include "ppx/grfx/null/null_command.h"
+#include "ppx/grfx/null/null_descriptor.h"
+#include "ppx/grfx/null/null_gpu.h"
+#include "ppx/grfx/null/null_image.h"
+#include "ppx/grfx/null/null_instance.h"
+#include "ppx/grfx/null/null_pipeline.h"
+#include "ppx/grfx/null/null_queue.h"
+#include "ppx/grfx/null/null_query.h"
+#include "ppx/grfx/null/null_render_pass.h"
+#include "ppx/grfx/null/null_shader.h"
+#include "ppx/grfx/null/null_swapchain.h"
+#include "ppx/grfx/null/null_sync.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+void HandleTrait::AllocateNullHandle(grfx::Device* pDevice)
+{
+    mNullHandle = ToApi(pDevice)->AllocateNullHandle();
+}
+
+// -------------------------------------------------------------------------------------------------
+
+Result Device::CreateQueues(const grfx::DeviceCreateInfo* pCreateInfo)
+{
+    // Graphics
+    for (uint32_t queueIndex = 0; queueIndex < pCreateInfo->graphicsQueueCount; ++queueIndex) {
+        grfx::internal::QueueCreateInfo queueCreateInfo = {};
+        queueCreateInfo.commandType                     = grfx::COMMAND_TYPE_GRAPHICS;
+        queueCreateInfo.queueIndex                      = queueIndex;
+
+        grfx::QueuePtr tmpQueue;
+        Result         ppxres = CreateGraphicsQueue(&queueCreateInfo, &tmpQueue);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    // Compute
+    for (uint32_t queueIndex = 0; queueIndex < pCreateInfo->computeQueueCount; ++queueIndex) {
+        grfx::internal::QueueCreateInfo queueCreateInfo = {};
+        queueCreateInfo.commandType                     = grfx::COMMAND_TYPE_COMPUTE;
+        queueCreateInfo.queueIndex                      = queueIndex;
+
+        grfx::QueuePtr tmpQueue;
+        Result         ppxres = CreateComputeQueue(&queueCreateInfo, &tmpQueue);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    // Transfer
+    for (uint32_t queueIndex = 0; queueIndex < pCreateInfo->transferQueueCount; ++queueIndex) {
+        grfx::internal::QueueCreateInfo queueCreateInfo = {};
+        queueCreateInfo.commandType                     = grfx::COMMAND_TYPE_TRANSFER;
+        queueCreateInfo.queueIndex                      = queueIndex;
+
+        grfx::QueuePtr tmpQueue;
+        Result         ppxres = CreateTransferQueue(&queueCreateInfo, &tmpQueue);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result Device::CreateApiObjects(const grfx::DeviceCreateInfo* pCreateInfo)
+{
+    Result ppxres = CreateQueues(pCreateInfo);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    return ppx::SUCCESS;
+}
+
+void Device::DestroyApiObjects()
+{
+}
+
+Result Device::AllocateObject(grfx::Buffer** ppObject)
+{
+    null::Buffer* pObject = new null::Buffer();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::CommandBuffer** ppObject)
+{
+    null::CommandBuffer* pObject = new null::CommandBuffer();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::CommandPool** ppObject)
+{
+    null::CommandPool* pObject = new null::CommandPool();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::ComputePipeline** ppObject)
+{
+    null::ComputePipeline* pObject = new null::ComputePipeline();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::DepthStencilView** ppObject)
+{
+    null::DepthStencilView* pObject = new null::DepthStencilView();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::DescriptorPool** ppObject)
+{
+    null::DescriptorPool* pObject = new null::DescriptorPool();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::DescriptorSet** ppObject)
+{
+    null::DescriptorSet* pObject = new null::DescriptorSet();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::DescriptorSetLayout** ppObject)
+{
+    null::DescriptorSetLayout* pObject = new null::DescriptorSetLayout();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Fence** ppObject)
+{
+    null::Fence* pObject = new null::Fence();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::GraphicsPipeline** ppObject)
+{
+    null::GraphicsPipeline* pObject = new null::GraphicsPipeline();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Image** ppObject)
+{
+    null::Image* pObject = new null::Image();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::MemoryPool** ppObject)
+{
+    null::MemoryPool* pObject = new null::MemoryPool();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::PipelineInterface** ppObject)
+{
+    null::PipelineInterface* pObject = new null::PipelineInterface();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Queue** ppObject)
+{
+    null::Queue* pObject = new null::Queue();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Query** ppObject)
+{
+    null::Query* pObject = new null::Query();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::RenderPass** ppObject)
+{
+    null::RenderPass* pObject = new null::RenderPass();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::RenderTargetView** ppObject)
+{
+    null::RenderTargetView* pObject = new null::RenderTargetView();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::SampledImageView** ppObject)
+{
+    null::SampledImageView* pObject = new null::SampledImageView();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Sampler** ppObject)
+{
+    null::Sampler* pObject = new null::Sampler();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Semaphore** ppObject)
+{
+    null::Semaphore* pObject = new null::Semaphore();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::ShaderModule** ppObject)
+{
+    null::ShaderModule* pObject = new null::ShaderModule();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::ShaderProgram** ppObject)
+{
+    return ppx::ERROR_ALLOCATION_FAILED;
+}
+
+Result Device::AllocateObject(grfx::ShadingRatePattern** ppObject)
+{
+    PPX_ASSERT_MSG(false, "ShadingRatePattern is not supported by the null backend");
+    return ppx::ERROR_ALLOCATION_FAILED;
+}
+
+Result Device::AllocateObject(grfx::StorageImageView** ppObject)
+{
+    null::StorageImageView* pObject = new null::StorageImageView();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Device::AllocateObject(grfx::Swapchain** ppObject)
+{
+    null::Swapchain* pObject = new null::Swapchain();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
+void Device::GetMemoryHeapStatistics(grfx::MemoryStatistics* pStatistics) const
+{
+    // A single device local heap holding everything created on the device
+    const uint64_t kHeapSize = 8ull * 1024 * 1024 * 1024;
+
+    grfx::MemoryHeapStatistics heap = {};
+    heap.deviceLocal                = true;
+    heap.usageBytes                 = pStatistics->GetCategoryAllocationBytes();
+    heap.budgetBytes                = kHeapSize;
+    heap.blockBytes                 = heap.usageBytes;
+    heap.allocationBytes            = heap.usageBytes;
+    pStatistics->heaps.push_back(heap);
+}
+
+Result Device::WaitIdle()
+{
+    // Work completes at submission
+    return ppx::SUCCESS;
+}
+
+bool Device::PipelineStatsAvailable() const
+{
+    return true;
+}
+
+bool Device::DynamicRenderingSupported() const
+{
+    return true;
+}
+
+bool Device::IndependentBlendingSupported() const
+{
+    return true;
+}
+
+bool Device::FragmentStoresAndAtomicsSupported() const
+{
+    return true;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
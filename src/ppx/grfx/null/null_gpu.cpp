@@ -0,0 +1,53 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_gpu.h"
+
+#define PPX_MAX_NULL_GRAPHICS_QUEUES 1
+#define PPX_MAX_NULL_COMPUTE_QUEUES  2
+#define PPX_MAX_NULL_TRANSFER_QUEUES 2
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+Result Gpu::CreateApiObjects(const grfx::internal::GpuCreateInfo* pCreateInfo)
+{
+    mDeviceName     = "Null GPU";
+    mDeviceVendorId = grfx::VENDOR_ID_UNKNOWN;
+    return ppx::SUCCESS;
+}
+
+void Gpu::DestroyApiObjects()
+{
+}
+
+uint32_t Gpu::GetGraphicsQueueCount() const
+{
+    return PPX_MAX_NULL_GRAPHICS_QUEUES;
+}
+
+uint32_t Gpu::GetComputeQueueCount() const
+{
+    return PPX_MAX_NULL_COMPUTE_QUEUES;
+}
+
+uint32_t Gpu::GetTransferQueueCount() const
+{
+    return PPX_MAX_NULL_TRANSFER_QUEUES;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
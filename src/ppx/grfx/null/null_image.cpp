@@ -0,0 +1,135 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_image.h"
+#include "ppx/grfx/null/null_device.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+// -------------------------------------------------------------------------------------------------
+// Image
+// -------------------------------------------------------------------------------------------------
+Result Image::CreateApiObjects(const grfx::ImageCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+
+    // Tightly packed size, external and aliased images don't own memory
+    if (IsNull(pCreateInfo->pApiObject) && IsNull(pCreateInfo->pMemoryAliasImage)) {
+        const grfx::FormatDesc* pFormatDesc = grfx::GetFormatDescription(pCreateInfo->format);
+        const uint32_t          blockWidth  = std::max<uint32_t>(pFormatDesc->blockWidth, 1);
+
+        uint32_t width  = pCreateInfo->width;
+        uint32_t height = pCreateInfo->height;
+        uint32_t depth  = std::max<uint32_t>(pCreateInfo->depth, 1);
+        for (uint32_t mip = 0; mip < pCreateInfo->mipLevelCount; ++mip) {
+            uint64_t blocksX = (width + blockWidth - 1) / blockWidth;
+            uint64_t blocksY = (height + blockWidth - 1) / blockWidth;
+            mAllocationSize += blocksX * blocksY * depth * pFormatDesc->bytesPerTexel;
+            width  = std::max<uint32_t>(width / 2, 1);
+            height = std::max<uint32_t>(height / 2, 1);
+            depth  = std::max<uint32_t>(depth / 2, 1);
+        }
+        mAllocationSize *= static_cast<uint64_t>(pCreateInfo->arrayLayerCount) * static_cast<uint64_t>(pCreateInfo->sampleCount);
+    }
+
+    return ppx::SUCCESS;
+}
+
+void Image::DestroyApiObjects()
+{
+    mAllocationSize = 0;
+}
+
+Result Image::MapMemory(uint64_t offset, void** ppMappedAddress)
+{
+    // Match D3D12, which is the more restrictive API
+    PPX_ASSERT_MSG(false, "memory mapping of textures is not available in the null backend");
+    return ppx::ERROR_FAILED;
+}
+
+void Image::UnmapMemory()
+{
+    PPX_ASSERT_MSG(false, "memory mapping of textures is not available in the null backend");
+}
+
+// -------------------------------------------------------------------------------------------------
+// Sampler
+// -------------------------------------------------------------------------------------------------
+Result Sampler::CreateApiObjects(const grfx::SamplerCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void Sampler::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// DepthStencilView
+// -------------------------------------------------------------------------------------------------
+Result DepthStencilView::CreateApiObjects(const grfx::DepthStencilViewCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void DepthStencilView::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// RenderTargetView
+// -------------------------------------------------------------------------------------------------
+Result RenderTargetView::CreateApiObjects(const grfx::RenderTargetViewCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void RenderTargetView::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// SampledImageView
+// -------------------------------------------------------------------------------------------------
+Result SampledImageView::CreateApiObjects(const grfx::SampledImageViewCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void SampledImageView::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// StorageImageView
+// -------------------------------------------------------------------------------------------------
+Result StorageImageView::CreateApiObjects(const grfx::StorageImageViewCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void StorageImageView::DestroyApiObjects()
+{
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
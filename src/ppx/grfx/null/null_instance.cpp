@@ -0,0 +1,95 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_instance.h"
+#include "ppx/grfx/null/null_device.h"
+#include "ppx/grfx/null/null_gpu.h"
+#include "ppx/grfx/null/null_swapchain.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+Result Instance::CreateApiObjects(const grfx::InstanceCreateInfo* pCreateInfo)
+{
+    if (pCreateInfo->api != grfx::API_NULL) {
+        return ppx::ERROR_UNSUPPORTED_API;
+    }
+
+    grfx::internal::GpuCreateInfo gpuCreateInfo = {};
+
+    grfx::GpuPtr tmpGpu;
+    Result       ppxres = CreateGpu(&gpuCreateInfo, &tmpGpu);
+    if (Failed(ppxres)) {
+        PPX_ASSERT_MSG(false, "Failed creating null GPU object");
+        return ppxres;
+    }
+
+    return ppx::SUCCESS;
+}
+
+void Instance::DestroyApiObjects()
+{
+}
+
+Result Instance::AllocateObject(grfx::Device** ppDevice)
+{
+    null::Device* pObject = new null::Device();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppDevice = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Instance::AllocateObject(grfx::Gpu** ppGpu)
+{
+    null::Gpu* pObject = new null::Gpu();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppGpu = pObject;
+    return ppx::SUCCESS;
+}
+
+Result Instance::AllocateObject(grfx::Surface** ppSurface)
+{
+    null::Surface* pObject = new null::Surface();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppSurface = pObject;
+    return ppx::SUCCESS;
+}
+
+#if defined(PPX_BUILD_XR)
+const XrBaseInStructure* Instance::XrGetGraphicsBinding() const
+{
+    PPX_ASSERT_MSG(false, "XR is not supported by the null backend");
+    return nullptr;
+}
+
+bool Instance::XrIsGraphicsBindingValid() const
+{
+    return false;
+}
+
+void Instance::XrUpdateDeviceInGraphicsBinding()
+{
+}
+#endif
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
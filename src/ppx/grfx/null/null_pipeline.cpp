@@ -0,0 +1,63 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_pipeline.h"
+#include "ppx/grfx/null/null_device.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+// -------------------------------------------------------------------------------------------------
+// ComputePipeline
+// -------------------------------------------------------------------------------------------------
+Result ComputePipeline::CreateApiObjects(const grfx::ComputePipelineCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void ComputePipeline::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// GraphicsPipeline
+// -------------------------------------------------------------------------------------------------
+Result GraphicsPipeline::CreateApiObjects(const grfx::GraphicsPipelineCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void GraphicsPipeline::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// PipelineInterface
+// -------------------------------------------------------------------------------------------------
+Result PipelineInterface::CreateApiObjects(const grfx::PipelineInterfaceCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void PipelineInterface::DestroyApiObjects()
+{
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
@@ -0,0 +1,47 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_query.h"
+#include "ppx/grfx/null/null_device.h"
+
+#include <cstring>
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+Result Query::CreateApiObjects(const grfx::QueryCreateInfo* pCreateInfo)
+{
+    AllocateNullHandle(GetDevice());
+    return ppx::SUCCESS;
+}
+
+void Query::DestroyApiObjects()
+{
+}
+
+void Query::Reset(uint32_t firstQuery, uint32_t queryCount)
+{
+}
+
+Result Query::GetData(void* pDstData, uint64_t dstDataSize)
+{
+    PPX_ASSERT_NULL_ARG(pDstData);
+    std::memset(pDstData, 0, static_cast<size_t>(dstDataSize));
+    return ppx::SUCCESS;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
@@ -0,0 +1,84 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_queue.h"
+#include "ppx/grfx/null/null_sync.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+Result Queue::CreateApiObjects(const grfx::internal::QueueCreateInfo* pCreateInfo)
+{
+    return ppx::SUCCESS;
+}
+
+void Queue::DestroyApiObjects()
+{
+}
+
+Result Queue::WaitIdle()
+{
+    return ppx::SUCCESS;
+}
+
+Result Queue::Submit(const grfx::SubmitInfo* pSubmitInfo)
+{
+    PPX_ASSERT_NULL_ARG(pSubmitInfo);
+
+    if (!pSubmitInfo->signalValues.empty() && (pSubmitInfo->signalValues.size() < pSubmitInfo->signalSemaphoreCount)) {
+        PPX_ASSERT_MSG(false, "signal value count must match signal semaphore count");
+        return ppx::ERROR_UNEXPECTED_COUNT_VALUE;
+    }
+
+    mSubmitCount += 1;
+    mSubmittedCommandBufferCount += pSubmitInfo->commandBufferCount;
+    mSubmittedWaitSemaphoreCount += pSubmitInfo->waitSemaphoreCount;
+
+    for (uint32_t i = 0; i < pSubmitInfo->signalSemaphoreCount; ++i) {
+        uint64_t value = pSubmitInfo->signalValues.empty() ? 0 : pSubmitInfo->signalValues[i];
+        ToApi(pSubmitInfo->ppSignalSemaphores[i])->SignalFromQueue(value);
+    }
+
+    if (!IsNull(pSubmitInfo->pFence)) {
+        ToApi(pSubmitInfo->pFence)->Signal();
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result Queue::QueueWait(grfx::Semaphore* pSemaphore, uint64_t value)
+{
+    PPX_ASSERT_NULL_ARG(pSemaphore);
+    return ppx::SUCCESS;
+}
+
+Result Queue::QueueSignal(grfx::Semaphore* pSemaphore, uint64_t value)
+{
+    PPX_ASSERT_NULL_ARG(pSemaphore);
+    ToApi(pSemaphore)->SignalFromQueue(value);
+    return ppx::SUCCESS;
+}
+
+Result Queue::GetTimestampFrequency(uint64_t* pFrequency) const
+{
+    PPX_ASSERT_NULL_ARG(pFrequency);
+    // Nanosecond ticks, timestamps always read back as zero anyway
+    *pFrequency = 1000000000;
+    return ppx::SUCCESS;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
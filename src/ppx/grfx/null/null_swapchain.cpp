@@ -0,0 +1,105 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_swapchain.h"
+#include "ppx/grfx/null/null_device.h"
+#include "ppx/grfx/null/null_sync.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+// -------------------------------------------------------------------------------------------------
+// Surface
+// -------------------------------------------------------------------------------------------------
+Result Surface::CreateApiObjects(const grfx::SurfaceCreateInfo* pCreateInfo)
+{
+    return ppx::SUCCESS;
+}
+
+void Surface::DestroyApiObjects()
+{
+}
+
+// -------------------------------------------------------------------------------------------------
+// Swapchain
+// -------------------------------------------------------------------------------------------------
+Result Swapchain::CreateApiObjects(const grfx::SwapchainCreateInfo* pCreateInfo)
+{
+    // Headless swapchains get their color images from grfx::Swapchain
+    if (IsHeadless()) {
+        return ppx::SUCCESS;
+    }
+
+    for (uint32_t i = 0; i < pCreateInfo->imageCount; ++i) {
+        grfx::ImageCreateInfo rtCreateInfo = ImageCreateInfo::RenderTarget2D(pCreateInfo->width, pCreateInfo->height, pCreateInfo->colorFormat);
+        rtCreateInfo.ownership             = grfx::OWNERSHIP_RESTRICTED;
+        rtCreateInfo.RTVClearValue         = {0.0f, 0.0f, 0.0f, 0.0f};
+        rtCreateInfo.initialState          = grfx::RESOURCE_STATE_PRESENT;
+        rtCreateInfo.usageFlags =
+            grfx::IMAGE_USAGE_COLOR_ATTACHMENT |
+            grfx::IMAGE_USAGE_TRANSFER_SRC |
+            grfx::IMAGE_USAGE_TRANSFER_DST |
+            grfx::IMAGE_USAGE_SAMPLED;
+
+        grfx::ImagePtr colorImage;
+        Result         ppxres = GetDevice()->CreateImage(&rtCreateInfo, &colorImage);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        mColorImages.push_back(colorImage);
+    }
+
+    // First acquire returns image 0
+    mCurrentImageIndex = pCreateInfo->imageCount - 1;
+
+    return ppx::SUCCESS;
+}
+
+void Swapchain::DestroyApiObjects()
+{
+}
+
+Result Swapchain::AcquireNextImageInternal(
+    uint64_t         timeout,
+    grfx::Semaphore* pSemaphore,
+    grfx::Fence*     pFence,
+    uint32_t*        pImageIndex)
+{
+    *pImageIndex       = (mCurrentImageIndex + 1) % CountU32(mColorImages);
+    mCurrentImageIndex = *pImageIndex;
+
+    if (!IsNull(pSemaphore)) {
+        ToApi(pSemaphore)->SignalFromQueue(0);
+    }
+
+    if (!IsNull(pFence)) {
+        ToApi(pFence)->Signal();
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result Swapchain::PresentInternal(
+    uint32_t                      imageIndex,
+    uint32_t                      waitSemaphoreCount,
+    const grfx::Semaphore* const* ppWaitSemaphores)
+{
+    return ppx::SUCCESS;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
@@ -0,0 +1,89 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/grfx/null/null_sync.h"
+
+namespace ppx {
+namespace grfx {
+namespace null {
+
+// -------------------------------------------------------------------------------------------------
+// Fence
+// -------------------------------------------------------------------------------------------------
+Result Fence::CreateApiObjects(const grfx::FenceCreateInfo* pCreateInfo)
+{
+    mSignaled = pCreateInfo->signaled;
+    return ppx::SUCCESS;
+}
+
+void Fence::DestroyApiObjects()
+{
+}
+
+Result Fence::Wait(uint64_t timeout)
+{
+    if (!mSignaled) {
+        return ppx::ERROR_WAIT_TIMED_OUT;
+    }
+    return ppx::SUCCESS;
+}
+
+Result Fence::Reset()
+{
+    mSignaled = false;
+    return ppx::SUCCESS;
+}
+
+// -------------------------------------------------------------------------------------------------
+// Semaphore
+// -------------------------------------------------------------------------------------------------
+Result Semaphore::CreateApiObjects(const grfx::SemaphoreCreateInfo* pCreateInfo)
+{
+    mValue = pCreateInfo->initialValue;
+    return ppx::SUCCESS;
+}
+
+void Semaphore::DestroyApiObjects()
+{
+}
+
+void Semaphore::SignalFromQueue(uint64_t value)
+{
+    if (IsTimeline()) {
+        mValue = value;
+    }
+}
+
+Result Semaphore::TimelineWait(uint64_t value, uint64_t timeout) const
+{
+    if (mValue < value) {
+        return ppx::ERROR_WAIT_TIMED_OUT;
+    }
+    return ppx::SUCCESS;
+}
+
+Result Semaphore::TimelineSignal(uint64_t value) const
+{
+    mValue = value;
+    return ppx::SUCCESS;
+}
+
+uint64_t Semaphore::TimelineCounterValue() const
+{
+    return mValue;
+}
+
+} // namespace null
+} // namespace grfx
+} // namespace ppx
@@ -21,6 +21,81 @@ namespace ppx {
 namespace grfx {
 namespace vk {
 
+Result MemoryPool::CreateApiObjects(const grfx::MemoryPoolCreateInfo* pCreateInfo)
+{
+    vk::Device* pDevice = ToApi(GetDevice());
+
+    VmaMemoryUsage memoryUsage = ToVmaMemoryUsage(pCreateInfo->memoryUsage);
+    if (memoryUsage == VMA_MEMORY_USAGE_UNKNOWN) {
+        PPX_ASSERT_MSG(false, "unknown memory usage");
+        return ppx::ERROR_API_FAILURE;
+    }
+
+    // VMA only uses the usage flags of the example buffer to pick the
+    // memory type, the size doesn't matter
+    VkBufferCreateInfo exampleBufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    exampleBufferInfo.size               = PPX_UNIFORM_BUFFER_ALIGNMENT;
+    exampleBufferInfo.usage              = ToVkBufferUsageFlags(pCreateInfo->usageFlags);
+    exampleBufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+
+    VmaAllocationCreateInfo vma_alloc_ci = {};
+    vma_alloc_ci.usage                   = memoryUsage;
+
+    uint32_t memoryTypeIndex = 0;
+    VkResult vkres           = vmaFindMemoryTypeIndexForBufferInfo(
+        pDevice->GetVmaAllocator(),
+        &exampleBufferInfo,
+        &vma_alloc_ci,
+        &memoryTypeIndex);
+    if (vkres != VK_SUCCESS) {
+        PPX_ASSERT_MSG(false, "vmaFindMemoryTypeIndexForBufferInfo failed: " << ToString(vkres));
+        return ppx::ERROR_API_FAILURE;
+    }
+
+    VmaPoolCreateFlags createFlags = 0;
+    if (pCreateInfo->algorithm == grfx::MEMORY_POOL_ALGORITHM_LINEAR) {
+        createFlags |= VMA_POOL_CREATE_LINEAR_ALGORITHM_BIT;
+    }
+
+    VmaPoolCreateInfo vma_pool_ci = {};
+    vma_pool_ci.memoryTypeIndex   = memoryTypeIndex;
+    vma_pool_ci.flags             = createFlags;
+    vma_pool_ci.blockSize         = static_cast<VkDeviceSize>(pCreateInfo->blockSize);
+    vma_pool_ci.minBlockCount     = static_cast<size_t>(pCreateInfo->minBlockCount);
+    vma_pool_ci.maxBlockCount     = static_cast<size_t>(pCreateInfo->maxBlockCount);
+
+    vkres = vmaCreatePool(pDevice->GetVmaAllocator(), &vma_pool_ci, &mPool);
+    if (vkres != VK_SUCCESS) {
+        PPX_ASSERT_MSG(false, "vmaCreatePool failed: " << ToString(vkres));
+        return ppx::ERROR_API_FAILURE;
+    }
+
+    return ppx::SUCCESS;
+}
+
+void MemoryPool::DestroyApiObjects()
+{
+    if (mPool) {
+        vmaDestroyPool(ToApi(GetDevice())->GetVmaAllocator(), mPool);
+        mPool.Reset();
+    }
+}
+
+grfx::MemoryPoolStatistics MemoryPool::GetStatistics() const
+{
+    VmaStatistics vmaStats = {};
+    vmaGetPoolStatistics(ToApi(GetDevice())->GetVmaAllocator(), mPool, &vmaStats);
+
+    grfx::MemoryPoolStatistics statistics = {};
+    statistics.blockCount                 = vmaStats.blockCount;
+    statistics.allocationCount            = vmaStats.allocationCount;
+    statistics.blockBytes                 = static_cast<uint64_t>(vmaStats.blockBytes);
+    statistics.allocationBytes            = static_cast<uint64_t>(vmaStats.allocationBytes);
+    return statistics;
+}
+
+// -------------------------------------------------------------------------------------------------
+
 Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
 {
     vk::Device* pDevice = ToApi(GetDevice());
@@ -54,8 +129,9 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
             return ppx::ERROR_API_FAILURE;
         }
 
+        // VMA keeps the memory mapped until the allocation is freed
         VmaAllocationCreateFlags createFlags = 0;
-        if ((memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY) || (memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY)) {
+        if (pCreateInfo->persistentMap) {
             createFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
         }
 
@@ -66,6 +142,9 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
         vma_alloc_ci.preferredFlags          = 0;
         vma_alloc_ci.memoryTypeBits          = 0;
         vma_alloc_ci.pool                    = VK_NULL_HANDLE;
+        if (!IsNull(pCreateInfo->pMemoryPool)) {
+            vma_alloc_ci.pool = ToApi(pCreateInfo->pMemoryPool)->GetVmaPool();
+        }
         vma_alloc_ci.pUserData               = nullptr;
 
         VkResult vkres = vmaAllocateMemoryForBuffer(
@@ -78,6 +157,7 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
             PPX_ASSERT_MSG(false, "vmaAllocateMemoryForBuffer failed: " << ToString(vkres));
             return ppx::ERROR_API_FAILURE;
         }
+        mAllocationSize = static_cast<uint64_t>(mAllocationInfo.size);
     }
 
     // Bind memory
@@ -92,16 +172,27 @@ Result Buffer::CreateApiObjects(const grfx::BufferCreateInfo* pCreateInfo)
         }
     }
 
+    if (pCreateInfo->persistentMap) {
+        if (IsNull(mAllocationInfo.pMappedData)) {
+            PPX_ASSERT_MSG(false, "persistently mapped buffer has no mapped address");
+            return ppx::ERROR_API_FAILURE;
+        }
+        mMappedAddress = mAllocationInfo.pMappedData;
+    }
+
     return ppx::SUCCESS;
 }
 
 void Buffer::DestroyApiObjects()
 {
+    mMappedAddress = nullptr;
+
     if (mAllocation) {
         vmaFreeMemory(ToApi(GetDevice())->GetVmaAllocator(), mAllocation);
         mAllocation.Reset();
 
         mAllocationInfo = {};
+        mAllocationSize = 0;
     }
 
     if (mBuffer) {
@@ -116,25 +207,65 @@ Result Buffer::MapMemory(uint64_t offset, void** ppMappedAddress)
         return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
     }
 
-    VkResult vkres = vmaMapMemory(
+    if (IsPersistentlyMapped()) {
+        *ppMappedAddress = static_cast<char*>(mMappedAddress) + offset;
+        return ppx::SUCCESS;
+    }
+
+    void*    pMappedAddress = nullptr;
+    VkResult vkres          = vmaMapMemory(
         ToApi(GetDevice())->GetVmaAllocator(),
         mAllocation,
-        ppMappedAddress);
+        &pMappedAddress);
     if (vkres != VK_SUCCESS) {
         PPX_ASSERT_MSG(false, "vmaMapMemory failed: " << ToString(vkres));
         return ppx::ERROR_API_FAILURE;
     }
+    *ppMappedAddress = static_cast<char*>(pMappedAddress) + offset;
 
     return ppx::SUCCESS;
 }
 
 void Buffer::UnmapMemory()
 {
+    if (IsPersistentlyMapped()) {
+        return;
+    }
+
     vmaUnmapMemory(
         ToApi(GetDevice())->GetVmaAllocator(),
         mAllocation);
 }
 
+Result Buffer::FlushRangeImpl(uint64_t offset, uint64_t size)
+{
+    // VMA skips coherent memory and rounds to nonCoherentAtomSize
+    VkResult vkres = vmaFlushAllocation(
+        ToApi(GetDevice())->GetVmaAllocator(),
+        mAllocation,
+        static_cast<VkDeviceSize>(offset),
+        static_cast<VkDeviceSize>(size));
+    if (vkres != VK_SUCCESS) {
+        PPX_ASSERT_MSG(false, "vmaFlushAllocation failed: " << ToString(vkres));
+        return ppx::ERROR_API_FAILURE;
+    }
+    return ppx::SUCCESS;
+}
+
+Result Buffer::InvalidateRangeImpl(uint64_t offset, uint64_t size)
+{
+    VkResult vkres = vmaInvalidateAllocation(
+        ToApi(GetDevice())->GetVmaAllocator(),
+        mAllocation,
+        static_cast<VkDeviceSize>(offset),
+        static_cast<VkDeviceSize>(size));
+    if (vkres != VK_SUCCESS) {
+        PPX_ASSERT_MSG(false, "vmaInvalidateAllocation failed: " << ToString(vkres));
+        return ppx::ERROR_API_FAILURE;
+    }
+    return ppx::SUCCESS;
+}
+
 } // namespace vk
 } // namespace grfx
 } // namespace ppx
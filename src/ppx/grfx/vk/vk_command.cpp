@@ -63,7 +63,7 @@ void CommandBuffer::DestroyApiObjects()
     }
 }
 
-Result CommandBuffer::Begin()
+Result CommandBuffer::BeginImpl()
 {
     VkCommandBufferBeginInfo vkbi = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
 
@@ -76,7 +76,7 @@ Result CommandBuffer::Begin()
     return ppx::SUCCESS;
 }
 
-Result CommandBuffer::End()
+Result CommandBuffer::EndImpl()
 {
     VkResult vkres = vk::EndCommandBuffer(mCommandBuffer);
     if (vkres != VK_SUCCESS) {
@@ -416,194 +416,153 @@ void CommandBuffer::ClearDepthStencil(
         &clearRect);
 }
 
-void CommandBuffer::TransitionImageLayout(
-    const grfx::Image*  pImage,
-    uint32_t            mipLevel,
-    uint32_t            mipLevelCount,
-    uint32_t            arrayLayer,
-    uint32_t            arrayLayerCount,
+struct VkBarrierData
+{
+    VkPipelineStageFlags srcStageMask        = 0;
+    VkPipelineStageFlags dstStageMask        = 0;
+    VkAccessFlags        srcAccessMask       = 0;
+    VkAccessFlags        dstAccessMask       = 0;
+    VkImageLayout        oldLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkImageLayout        newLayout           = VK_IMAGE_LAYOUT_UNDEFINED;
+    uint32_t             srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    uint32_t             dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+};
+
+// Returns false if the barrier has no effect
+static bool GetVkBarrierData(
+    const vk::Device*   pDevice,
+    grfx::CommandType   commandType,
     grfx::ResourceState beforeState,
     grfx::ResourceState afterState,
     const grfx::Queue*  pSrcQueue,
-    const grfx::Queue*  pDstQueue)
+    const grfx::Queue*  pDstQueue,
+    VkBarrierData*      pData)
 {
-    PPX_ASSERT_NULL_ARG(pImage);
-
-    if ((!IsNull(pSrcQueue) && IsNull(pDstQueue)) || (IsNull(pSrcQueue) && !IsNull(pDstQueue))) {
-        PPX_ASSERT_MSG(false, "queue family transfer requires both pSrcQueue and pDstQueue to be NOT NULL");
-    }
-
-    uint32_t srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    uint32_t dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     if (!IsNull(pSrcQueue)) {
-        srcQueueFamilyIndex = ToApi(pSrcQueue)->GetQueueFamilyIndex();
+        pData->srcQueueFamilyIndex = ToApi(pSrcQueue)->GetQueueFamilyIndex();
     }
 
     if (!IsNull(pDstQueue)) {
-        dstQueueFamilyIndex = ToApi(pDstQueue)->GetQueueFamilyIndex();
-    }
-
-    if (srcQueueFamilyIndex == dstQueueFamilyIndex) {
-        srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    }
-
-    if (beforeState == afterState && srcQueueFamilyIndex == dstQueueFamilyIndex) {
-        return;
-    }
-
-    if (mipLevelCount == PPX_REMAINING_MIP_LEVELS) {
-        mipLevelCount = pImage->GetMipLevelCount();
+        pData->dstQueueFamilyIndex = ToApi(pDstQueue)->GetQueueFamilyIndex();
     }
 
-    if (arrayLayerCount == PPX_REMAINING_ARRAY_LAYERS) {
-        arrayLayerCount = pImage->GetArrayLayerCount();
+    if (pData->srcQueueFamilyIndex == pData->dstQueueFamilyIndex) {
+        pData->srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        pData->dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
     }
 
-    const vk::Image* pApiImage = ToApi(pImage);
-
-    VkPipelineStageFlags srcStageMask    = InvalidValue<VkPipelineStageFlags>();
-    VkPipelineStageFlags dstStageMask    = InvalidValue<VkPipelineStageFlags>();
-    VkAccessFlags        srcAccessMask   = InvalidValue<VkAccessFlags>();
-    VkAccessFlags        dstAccessMask   = InvalidValue<VkAccessFlags>();
-    VkImageLayout        oldLayout       = InvalidValue<VkImageLayout>();
-    VkImageLayout        newLayout       = InvalidValue<VkImageLayout>();
-    VkDependencyFlags    dependencyFlags = 0;
-
-    vk::Device* pDevice = ToApi(GetDevice());
-
-    grfx::CommandType commandType = GetCommandType();
-
     Result ppxres = ToVkBarrierSrc(
         beforeState,
         commandType,
         pDevice->GetDeviceFeatures(),
-        srcStageMask,
-        srcAccessMask,
-        oldLayout);
+        pData->srcStageMask,
+        pData->srcAccessMask,
+        pData->oldLayout);
     PPX_ASSERT_MSG(ppxres == ppx::SUCCESS, "couldn't get src barrier data");
 
     ppxres = ToVkBarrierDst(
         afterState,
         commandType,
         pDevice->GetDeviceFeatures(),
-        dstStageMask,
-        dstAccessMask,
-        newLayout);
+        pData->dstStageMask,
+        pData->dstAccessMask,
+        pData->newLayout);
     PPX_ASSERT_MSG(ppxres == ppx::SUCCESS, "couldn't get dst barrier data");
 
-    VkImageMemoryBarrier barrier            = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
-    barrier.srcAccessMask                   = srcAccessMask;
-    barrier.dstAccessMask                   = dstAccessMask;
-    barrier.oldLayout                       = oldLayout;
-    barrier.newLayout                       = newLayout;
-    barrier.srcQueueFamilyIndex             = srcQueueFamilyIndex;
-    barrier.dstQueueFamilyIndex             = dstQueueFamilyIndex;
-    barrier.image                           = pApiImage->GetVkImage();
-    barrier.subresourceRange.aspectMask     = pApiImage->GetVkImageAspectFlags();
-    barrier.subresourceRange.baseMipLevel   = mipLevel;
-    barrier.subresourceRange.levelCount     = mipLevelCount;
-    barrier.subresourceRange.baseArrayLayer = arrayLayer;
-    barrier.subresourceRange.layerCount     = arrayLayerCount;
-
-    vk::CmdPipelineBarrier(
-        mCommandBuffer,  // commandBuffer
-        srcStageMask,    // srcStageMask
-        dstStageMask,    // dstStageMask
-        dependencyFlags, // dependencyFlags
-        0,               // memoryBarrierCount
-        nullptr,         // pMemoryBarriers
-        0,               // bufferMemoryBarrierCount
-        nullptr,         // pBufferMemoryBarriers
-        1,               // imageMemoryBarrierCount
-        &barrier);       // pImageMemoryBarriers);
+    return (beforeState != afterState) || (pData->srcQueueFamilyIndex != pData->dstQueueFamilyIndex);
 }
 
-void CommandBuffer::BufferResourceBarrier(
-    const grfx::Buffer* pBuffer,
-    grfx::ResourceState beforeState,
-    grfx::ResourceState afterState,
-    const grfx::Queue*  pSrcQueue,
-    const grfx::Queue*  pDstQueue)
+void CommandBuffer::PipelineBarrierImpl(
+    uint32_t                   imageBarrierCount,
+    const grfx::ImageBarrier*  pImageBarriers,
+    uint32_t                   bufferBarrierCount,
+    const grfx::BufferBarrier* pBufferBarriers)
 {
-    PPX_ASSERT_NULL_ARG(pBuffer);
+    const vk::Device* pDevice     = ToApi(GetDevice());
+    grfx::CommandType commandType = GetCommandType();
 
-    if ((!IsNull(pSrcQueue) && IsNull(pDstQueue)) || (IsNull(pSrcQueue) && !IsNull(pDstQueue))) {
-        PPX_ASSERT_MSG(false, "queue family transfer requires both pSrcQueue and pDstQueue to be NOT NULL");
-    }
+    // All barriers go into one vkCmdPipelineBarrier, so the stage masks
+    // are the union of every barrier's stages.
+    VkPipelineStageFlags srcStageMask = 0;
+    VkPipelineStageFlags dstStageMask = 0;
 
-    uint32_t srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    uint32_t dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    if (!IsNull(pSrcQueue)) {
-        srcQueueFamilyIndex = ToApi(pSrcQueue)->GetQueueFamilyIndex();
-    }
+    mImageMemoryBarriers.clear();
+    for (uint32_t i = 0; i < imageBarrierCount; ++i) {
+        const grfx::ImageBarrier& src = pImageBarriers[i];
 
-    if (!IsNull(pDstQueue)) {
-        dstQueueFamilyIndex = ToApi(pDstQueue)->GetQueueFamilyIndex();
+        VkBarrierData data = {};
+        if (!GetVkBarrierData(pDevice, commandType, src.beforeState, src.afterState, src.pSrcQueue, src.pDstQueue, &data) && !src.discardContents) {
+            continue;
+        }
+
+        // The memory was last used by an aliased resource, so wait on
+        // every prior write rather than this image's last use
+        if (src.discardContents) {
+            data.srcStageMask  = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+            data.srcAccessMask = VK_ACCESS_MEMORY_WRITE_BIT;
+            data.oldLayout     = VK_IMAGE_LAYOUT_UNDEFINED;
+        }
+        srcStageMask |= data.srcStageMask;
+        dstStageMask |= data.dstStageMask;
+
+        const vk::Image* pApiImage = ToApi(src.pImage);
+
+        VkImageMemoryBarrier barrier            = {VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+        barrier.srcAccessMask                   = data.srcAccessMask;
+        barrier.dstAccessMask                   = data.dstAccessMask;
+        barrier.oldLayout                       = data.oldLayout;
+        barrier.newLayout                       = data.newLayout;
+        barrier.srcQueueFamilyIndex             = data.srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex             = data.dstQueueFamilyIndex;
+        barrier.image                           = pApiImage->GetVkImage();
+        barrier.subresourceRange.aspectMask     = pApiImage->GetVkImageAspectFlags();
+        barrier.subresourceRange.baseMipLevel   = src.mipLevel;
+        barrier.subresourceRange.levelCount     = src.mipLevelCount;
+        barrier.subresourceRange.baseArrayLayer = src.arrayLayer;
+        barrier.subresourceRange.layerCount     = src.arrayLayerCount;
+        mImageMemoryBarriers.push_back(barrier);
     }
 
-    if (srcQueueFamilyIndex == dstQueueFamilyIndex) {
-        srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-        dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    mBufferMemoryBarriers.clear();
+    for (uint32_t i = 0; i < bufferBarrierCount; ++i) {
+        const grfx::BufferBarrier& src = pBufferBarriers[i];
+
+        VkBarrierData data = {};
+        if (!GetVkBarrierData(pDevice, commandType, src.beforeState, src.afterState, src.pSrcQueue, src.pDstQueue, &data)) {
+            continue;
+        }
+        srcStageMask |= data.srcStageMask;
+        dstStageMask |= data.dstStageMask;
+
+        VkBufferMemoryBarrier barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
+        barrier.srcAccessMask         = data.srcAccessMask;
+        barrier.dstAccessMask         = data.dstAccessMask;
+        barrier.srcQueueFamilyIndex   = data.srcQueueFamilyIndex;
+        barrier.dstQueueFamilyIndex   = data.dstQueueFamilyIndex;
+        barrier.buffer                = ToApi(src.pBuffer)->GetVkBuffer();
+        barrier.offset                = static_cast<VkDeviceSize>(0);
+        barrier.size                  = static_cast<VkDeviceSize>(src.pBuffer->GetSize());
+        mBufferMemoryBarriers.push_back(barrier);
     }
 
-    if (beforeState == afterState && srcQueueFamilyIndex == dstQueueFamilyIndex) {
+    if (mImageMemoryBarriers.empty() && mBufferMemoryBarriers.empty()) {
         return;
     }
 
-    VkPipelineStageFlags srcStageMask    = InvalidValue<VkPipelineStageFlags>();
-    VkPipelineStageFlags dstStageMask    = InvalidValue<VkPipelineStageFlags>();
-    VkAccessFlags        srcAccessMask   = InvalidValue<VkAccessFlags>();
-    VkAccessFlags        dstAccessMask   = InvalidValue<VkAccessFlags>();
-    VkImageLayout        oldLayout       = InvalidValue<VkImageLayout>();
-    VkImageLayout        newLayout       = InvalidValue<VkImageLayout>();
-    VkDependencyFlags    dependencyFlags = 0;
-
-    vk::Device* pDevice = ToApi(GetDevice());
-
-    grfx::CommandType commandType = GetCommandType();
-
-    Result ppxres = ToVkBarrierSrc(
-        beforeState,
-        commandType,
-        pDevice->GetDeviceFeatures(),
-        srcStageMask,
-        srcAccessMask,
-        oldLayout);
-    PPX_ASSERT_MSG(ppxres == ppx::SUCCESS, "couldn't get src barrier data");
-
-    ppxres = ToVkBarrierDst(
-        afterState,
-        commandType,
-        pDevice->GetDeviceFeatures(),
-        dstStageMask,
-        dstAccessMask,
-        newLayout);
-    PPX_ASSERT_MSG(ppxres == ppx::SUCCESS, "couldn't get dst barrier data");
-
-    VkBufferMemoryBarrier barrier = {VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER};
-    barrier.srcAccessMask         = srcAccessMask;
-    barrier.dstAccessMask         = dstAccessMask;
-    barrier.srcQueueFamilyIndex   = srcQueueFamilyIndex;
-    barrier.dstQueueFamilyIndex   = dstQueueFamilyIndex;
-    barrier.buffer                = ToApi(pBuffer)->GetVkBuffer();
-    barrier.offset                = static_cast<VkDeviceSize>(0);
-    barrier.size                  = static_cast<VkDeviceSize>(pBuffer->GetSize());
-
-    vkCmdPipelineBarrier(
-        mCommandBuffer,  // commandBuffer
-        srcStageMask,    // srcStageMask
-        dstStageMask,    // dstStageMask
-        dependencyFlags, // dependencyFlags
-        0,               // memoryBarrierCount
-        nullptr,         // pMemoryBarriers
-        1,               // bufferMemoryBarrierCount
-        &barrier,        // pBufferMemoryBarriers
-        0,               // imageMemoryBarrierCount
-        nullptr);        // pImageMemoryBarriers);
+    vk::CmdPipelineBarrier(
+        mCommandBuffer,                  // commandBuffer
+        srcStageMask,                    // srcStageMask
+        dstStageMask,                    // dstStageMask
+        0,                               // dependencyFlags
+        0,                               // memoryBarrierCount
+        nullptr,                         // pMemoryBarriers
+        CountU32(mBufferMemoryBarriers), // bufferMemoryBarrierCount
+        DataPtr(mBufferMemoryBarriers),  // pBufferMemoryBarriers
+        CountU32(mImageMemoryBarriers),  // imageMemoryBarrierCount
+        DataPtr(mImageMemoryBarriers));  // pImageMemoryBarriers
 }
 
-void CommandBuffer::SetViewports(uint32_t viewportCount, const grfx::Viewport* pViewports)
+void CommandBuffer::SetViewportsImpl(uint32_t viewportCount, const grfx::Viewport* pViewports)
 {
     VkViewport viewports[PPX_MAX_VIEWPORTS] = {};
     for (uint32_t i = 0; i < viewportCount; ++i) {
@@ -624,7 +583,7 @@ void CommandBuffer::SetViewports(uint32_t viewportCount, const grfx::Viewport* p
         viewports);
 }
 
-void CommandBuffer::SetScissors(uint32_t scissorCount, const grfx::Rect* pScissors)
+void CommandBuffer::SetScissorsImpl(uint32_t scissorCount, const grfx::Rect* pScissors)
 {
     vkCmdSetScissor(
         mCommandBuffer,
@@ -637,7 +596,9 @@ void CommandBuffer::BindDescriptorSets(
     VkPipelineBindPoint               bindPoint,
     const grfx::PipelineInterface*    pInterface,
     uint32_t                          setCount,
-    const grfx::DescriptorSet* const* ppSets)
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
 {
     PPX_ASSERT_NULL_ARG(pInterface);
 
@@ -660,10 +621,16 @@ void CommandBuffer::BindDescriptorSets(
 
     if (setCount > 0) {
         // Get Vulkan handles
-        VkDescriptorSet vkSets[PPX_MAX_BOUND_DESCRIPTOR_SETS] = {VK_NULL_HANDLE};
+        VkDescriptorSet vkSets[PPX_MAX_BOUND_DESCRIPTOR_SETS]                 = {VK_NULL_HANDLE};
+        uint32_t        setDynamicOffsetCounts[PPX_MAX_BOUND_DESCRIPTOR_SETS] = {0};
+        uint32_t        totalDynamicOffsetCount                               = 0;
         for (uint32_t i = 0; i < setCount; ++i) {
-            vkSets[i] = ToApi(ppSets[i])->GetVkDescriptorSet();
+            vkSets[i]                 = ToApi(ppSets[i])->GetVkDescriptorSet();
+            setDynamicOffsetCounts[i] = ppSets[i]->GetLayout()->GetDynamicOffsetCount();
+            totalDynamicOffsetCount += setDynamicOffsetCounts[i];
         }
+        PPX_ASSERT_MSG(dynamicOffsetCount == totalDynamicOffsetCount, "dynamicOffsetCount (" << dynamicOffsetCount << ") does not match the dynamic bindings in ppSets (" << totalDynamicOffsetCount << ")");
+        PPX_ASSERT_MSG((dynamicOffsetCount == 0) || !IsNull(pDynamicOffsets), "pDynamicOffsets is null");
 
         // If we have consecutive set numbers we can bind just once...
         if (pInterface->HasConsecutiveSetNumbers()) {
@@ -676,13 +643,15 @@ void CommandBuffer::BindDescriptorSets(
                 firstSet,                                 // firstSet
                 setCount,                                 // descriptorSetCount
                 vkSets,                                   // pDescriptorSets
-                0,                                        // dynamicOffsetCount
-                nullptr);                                 // pDynamicOffsets
+                dynamicOffsetCount,                       // dynamicOffsetCount
+                pDynamicOffsets);                         // pDynamicOffsets
         }
         // ...otherwise we get to bind a bunch of times
         else {
+            uint32_t dynamicOffsetIndex = 0;
             for (uint32_t i = 0; i < setCount; ++i) {
-                uint32_t firstSet = setNumbers[i];
+                uint32_t        firstSet           = setNumbers[i];
+                const uint32_t* pSetDynamicOffsets = (setDynamicOffsetCounts[i] > 0) ? (pDynamicOffsets + dynamicOffsetIndex) : nullptr;
 
                 vk::CmdBindDescriptorSets(
                     mCommandBuffer,                           // commandBuffer
@@ -691,8 +660,10 @@ void CommandBuffer::BindDescriptorSets(
                     firstSet,                                 // firstSet
                     1,                                        // descriptorSetCount
                     &vkSets[i],                               // pDescriptorSets
-                    0,                                        // dynamicOffsetCount
-                    nullptr);                                 // pDynamicOffsets
+                    setDynamicOffsetCounts[i],                // dynamicOffsetCount
+                    pSetDynamicOffsets);                      // pDynamicOffsets
+
+                dynamicOffsetIndex += setDynamicOffsetCounts[i];
             }
         }
     }
@@ -709,12 +680,14 @@ void CommandBuffer::BindDescriptorSets(
     }
 }
 
-void CommandBuffer::BindGraphicsDescriptorSets(
+void CommandBuffer::BindGraphicsDescriptorSetsImpl(
     const grfx::PipelineInterface*    pInterface,
     uint32_t                          setCount,
-    const grfx::DescriptorSet* const* ppSets)
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
 {
-    BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pInterface, setCount, ppSets);
+    BindDescriptorSets(VK_PIPELINE_BIND_POINT_GRAPHICS, pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets);
 }
 
 void CommandBuffer::PushConstants(
@@ -756,7 +729,7 @@ void CommandBuffer::PushGraphicsConstants(
     PushConstants(pInterface, count, pValues, dstOffset);
 }
 
-void CommandBuffer::BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline)
+void CommandBuffer::BindGraphicsPipelineImpl(const grfx::GraphicsPipeline* pPipeline)
 {
     PPX_ASSERT_NULL_ARG(pPipeline);
 
@@ -769,9 +742,11 @@ void CommandBuffer::BindGraphicsPipeline(const grfx::GraphicsPipeline* pPipeline
 void CommandBuffer::BindComputeDescriptorSets(
     const grfx::PipelineInterface*    pInterface,
     uint32_t                          setCount,
-    const grfx::DescriptorSet* const* ppSets)
+    const grfx::DescriptorSet* const* ppSets,
+    uint32_t                          dynamicOffsetCount,
+    const uint32_t*                   pDynamicOffsets)
 {
-    BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, pInterface, setCount, ppSets);
+    BindDescriptorSets(VK_PIPELINE_BIND_POINT_COMPUTE, pInterface, setCount, ppSets, dynamicOffsetCount, pDynamicOffsets);
 }
 
 void CommandBuffer::PushComputeConstants(
@@ -800,7 +775,7 @@ void CommandBuffer::BindComputePipeline(const grfx::ComputePipeline* pPipeline)
         ToApi(pPipeline)->GetVkPipeline());
 }
 
-void CommandBuffer::BindIndexBuffer(const grfx::IndexBufferView* pView)
+void CommandBuffer::BindIndexBufferImpl(const grfx::IndexBufferView* pView)
 {
     PPX_ASSERT_NULL_ARG(pView);
     PPX_ASSERT_NULL_ARG(pView->pBuffer);
@@ -812,7 +787,7 @@ void CommandBuffer::BindIndexBuffer(const grfx::IndexBufferView* pView)
         ToVkIndexType(pView->indexType));
 }
 
-void CommandBuffer::BindVertexBuffers(uint32_t viewCount, const grfx::VertexBufferView* pViews)
+void CommandBuffer::BindVertexBuffersImpl(uint32_t viewCount, const grfx::VertexBufferView* pViews)
 {
     PPX_ASSERT_NULL_ARG(pViews);
     PPX_ASSERT_MSG(viewCount < PPX_MAX_VERTEX_BINDINGS, "viewCount exceeds PPX_MAX_VERTEX_ATTRIBUTES");
@@ -839,6 +814,8 @@ void CommandBuffer::Draw(
     uint32_t firstVertex,
     uint32_t firstInstance)
 {
+    FlushBarriers();
+
     vkCmdDraw(mCommandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
 }
 
@@ -849,6 +826,8 @@ void CommandBuffer::DrawIndexed(
     int32_t  vertexOffset,
     uint32_t firstInstance)
 {
+    FlushBarriers();
+
     vk::CmdDrawIndexed(mCommandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
 }
 
@@ -857,6 +836,8 @@ void CommandBuffer::Dispatch(
     uint32_t groupCountY,
     uint32_t groupCountZ)
 {
+    FlushBarriers();
+
     vk::CmdDispatch(mCommandBuffer, groupCountX, groupCountY, groupCountZ);
 }
 
@@ -865,6 +846,8 @@ void CommandBuffer::CopyBufferToBuffer(
     grfx::Buffer*                       pSrcBuffer,
     grfx::Buffer*                       pDstBuffer)
 {
+    FlushBarriers();
+
     VkBufferCopy region = {};
     region.srcOffset    = static_cast<VkDeviceSize>(pCopyInfo->srcBuffer.offset);
     region.dstOffset    = static_cast<VkDeviceSize>(pCopyInfo->dstBuffer.offset);
@@ -883,6 +866,8 @@ void CommandBuffer::CopyBufferToImage(
     grfx::Buffer*                                   pSrcBuffer,
     grfx::Image*                                    pDstImage)
 {
+    FlushBarriers();
+
     PPX_ASSERT_NULL_ARG(pSrcBuffer);
     PPX_ASSERT_NULL_ARG(pDstImage);
 
@@ -926,6 +911,8 @@ grfx::ImageToBufferOutputPitch CommandBuffer::CopyImageToBuffer(
     grfx::Image*                       pSrcImage,
     grfx::Buffer*                      pDstBuffer)
 {
+    FlushBarriers();
+
     std::vector<VkBufferImageCopy> regions;
 
     VkBufferImageCopy region               = {};
@@ -989,6 +976,8 @@ void CommandBuffer::CopyImageToImage(
     grfx::Image*                      pSrcImage,
     grfx::Image*                      pDstImage)
 {
+    FlushBarriers();
+
     bool isSourceDepthStencil = grfx::GetFormatDescription(pSrcImage->GetFormat())->aspect == grfx::FORMAT_ASPECT_DEPTH_STENCIL;
     bool isDestDepthStencil   = grfx::GetFormatDescription(pDstImage->GetFormat())->aspect == grfx::FORMAT_ASPECT_DEPTH_STENCIL;
     PPX_ASSERT_MSG(isSourceDepthStencil == isDestDepthStencil, "both images in an image copy must be depth-stencil if one is depth-stencil");
@@ -1039,6 +1028,8 @@ void CommandBuffer::BeginQuery(
     const grfx::Query* pQuery,
     uint32_t           queryIndex)
 {
+    FlushBarriers();
+
     PPX_ASSERT_NULL_ARG(pQuery);
     PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
 
@@ -1058,6 +1049,8 @@ void CommandBuffer::EndQuery(
     const grfx::Query* pQuery,
     uint32_t           queryIndex)
 {
+    FlushBarriers();
+
     PPX_ASSERT_NULL_ARG(pQuery);
     PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
 
@@ -1072,6 +1065,8 @@ void CommandBuffer::WriteTimestamp(
     grfx::PipelineStage pipelineStage,
     uint32_t            queryIndex)
 {
+    FlushBarriers();
+
     PPX_ASSERT_MSG(queryIndex <= pQuery->GetCount(), "invalid query index");
     vkCmdWriteTimestamp(
         mCommandBuffer,
@@ -1085,6 +1080,8 @@ void CommandBuffer::ResolveQueryData(
     uint32_t     startIndex,
     uint32_t     numQueries)
 {
+    FlushBarriers();
+
     PPX_ASSERT_MSG((startIndex + numQueries) <= pQuery->GetCount(), "invalid query index/number");
     const VkQueryResultFlags flags = VK_QUERY_RESULT_WAIT_BIT | VK_QUERY_RESULT_64_BIT;
     vkCmdCopyQueryPoolResults(mCommandBuffer, ToApi(pQuery)->GetVkQueryPool(), startIndex, numQueries, ToApi(pQuery)->GetReadBackBuffer(), 0, ToApi(pQuery)->GetQueryTypeSize(), flags);
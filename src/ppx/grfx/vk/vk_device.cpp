@@ -205,6 +205,11 @@ Result Device::ConfigureExtensions(const grfx::DeviceCreateInfo* pCreateInfo)
         mExtensions.push_back(VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME);
     }
 
+    // Memory budget - if present, VMA uses it for GetMemoryStatistics()
+    if (ElementExists(std::string(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME), mFoundExtensions)) {
+        mExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
     // Dynamic rendering - if present. It also requires
     // VK_KHR_depth_stencil_resolve and VK_KHR_create_renderpass2.
 #if defined(VK_KHR_dynamic_rendering)
@@ -693,6 +698,13 @@ Result Device::CreateApiObjects(const grfx::DeviceCreateInfo* pCreateInfo)
         vmaCreateInfo.physicalDevice         = ToApi(pCreateInfo->pGpu)->GetVkGpu();
         vmaCreateInfo.device                 = mDevice;
         vmaCreateInfo.instance               = ToApi(GetInstance())->GetVkInstance();
+        vmaCreateInfo.vulkanApiVersion       = VK_API_VERSION_1_1;
+
+        // The memory budget extension needs vkGetPhysicalDeviceMemoryProperties2,
+        // which is core in Vulkan 1.1
+        if (ElementExists(std::string(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME), mExtensions)) {
+            vmaCreateInfo.flags |= VMA_ALLOCATOR_CREATE_EXT_MEMORY_BUDGET_BIT;
+        }
 
         vkres = vmaCreateAllocator(&vmaCreateInfo, &mVmaAllocator);
         if (vkres != VK_SUCCESS) {
@@ -833,6 +845,16 @@ Result Device::AllocateObject(grfx::Image** ppObject)
     return ppx::SUCCESS;
 }
 
+Result Device::AllocateObject(grfx::MemoryPool** ppObject)
+{
+    vk::MemoryPool* pObject = new vk::MemoryPool();
+    if (IsNull(pObject)) {
+        return ppx::ERROR_ALLOCATION_FAILED;
+    }
+    *ppObject = pObject;
+    return ppx::SUCCESS;
+}
+
 Result Device::AllocateObject(grfx::PipelineInterface** ppObject)
 {
     vk::PipelineInterface* pObject = new vk::PipelineInterface();
@@ -958,6 +980,27 @@ Result Device::AllocateObject(grfx::Swapchain** ppObject)
     return ppx::SUCCESS;
 }
 
+void Device::GetMemoryHeapStatistics(grfx::MemoryStatistics* pStatistics) const
+{
+    const VkPhysicalDeviceMemoryProperties* pMemoryProperties = nullptr;
+    vmaGetMemoryProperties(mVmaAllocator, &pMemoryProperties);
+
+    // Without VK_EXT_memory_budget VMA estimates usage from its own
+    // allocations and budget as 80% of the heap size
+    std::vector<VmaBudget> budgets(pMemoryProperties->memoryHeapCount);
+    vmaGetHeapBudgets(mVmaAllocator, budgets.data());
+
+    for (uint32_t i = 0; i < pMemoryProperties->memoryHeapCount; ++i) {
+        grfx::MemoryHeapStatistics heap = {};
+        heap.deviceLocal                = (pMemoryProperties->memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) != 0;
+        heap.usageBytes                 = static_cast<uint64_t>(budgets[i].usage);
+        heap.budgetBytes                = static_cast<uint64_t>(budgets[i].budget);
+        heap.blockBytes                 = static_cast<uint64_t>(budgets[i].statistics.blockBytes);
+        heap.allocationBytes            = static_cast<uint64_t>(budgets[i].statistics.allocationBytes);
+        pStatistics->heaps.push_back(heap);
+    }
+}
+
 Result Device::WaitIdle()
 {
     VkResult vkres = vkDeviceWaitIdle(mDevice);
@@ -73,52 +73,85 @@ Result Image::CreateApiObjects(const grfx::ImageCreateInfo* pCreateInfo)
             }
         }
 
-        // Allocate memory
-        {
-            VmaMemoryUsage memoryUsage = ToVmaMemoryUsage(pCreateInfo->memoryUsage);
-            if (memoryUsage == VMA_MEMORY_USAGE_UNKNOWN) {
-                PPX_ASSERT_MSG(false, "unknown memory usage");
-                return ppx::ERROR_API_FAILURE;
-            }
-
-            VmaAllocationCreateFlags createFlags = 0;
-
-            if ((memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY) || (memoryUsage == VMA_MEMORY_USAGE_CPU_TO_GPU)) {
-                createFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+        // Bind to the alias image's allocation, which the alias image keeps
+        // ownership of. The allocation must fit this image's requirements,
+        // including its alignment since VMA binds at the allocation's offset
+        // within its memory block. The render graph falls back to separate
+        // memory if it doesn't.
+        if (!IsNull(pCreateInfo->pMemoryAliasImage)) {
+            VmaAllocationPtr aliasAllocation = ToApi(pCreateInfo->pMemoryAliasImage)->GetVmaAllocation();
+
+            VmaAllocationInfo aliasAllocationInfo = {};
+            vmaGetAllocationInfo(ToApi(GetDevice())->GetVmaAllocator(), aliasAllocation, &aliasAllocationInfo);
+
+            VkMemoryRequirements memoryRequirements = {};
+            vkGetImageMemoryRequirements(ToApi(GetDevice())->GetVkDevice(), mImage, &memoryRequirements);
+
+            bool fits = (memoryRequirements.size <= aliasAllocationInfo.size) &&
+                        ((memoryRequirements.memoryTypeBits & (1u << aliasAllocationInfo.memoryType)) != 0) &&
+                        ((aliasAllocationInfo.offset % memoryRequirements.alignment) == 0);
+            if (!fits) {
+                return ppx::ERROR_ALLOCATION_FAILED;
             }
 
-            VmaAllocationCreateInfo vma_alloc_ci = {};
-            vma_alloc_ci.flags                   = createFlags;
-            vma_alloc_ci.usage                   = memoryUsage;
-            vma_alloc_ci.requiredFlags           = 0;
-            vma_alloc_ci.preferredFlags          = 0;
-            vma_alloc_ci.memoryTypeBits          = 0;
-            vma_alloc_ci.pool                    = VK_NULL_HANDLE;
-            vma_alloc_ci.pUserData               = nullptr;
-
-            VkResult vkres = vmaAllocateMemoryForImage(
-                ToApi(GetDevice())->GetVmaAllocator(),
-                mImage,
-                &vma_alloc_ci,
-                &mAllocation,
-                &mAllocationInfo);
-            if (vkres != VK_SUCCESS) {
-                PPX_ASSERT_MSG(false, "vmaAllocateMemoryForImage failed: " << ToString(vkres));
-                return ppx::ERROR_API_FAILURE;
-            }
-        }
-
-        // Bind memory
-        {
             VkResult vkres = vmaBindImageMemory(
                 ToApi(GetDevice())->GetVmaAllocator(),
-                mAllocation,
+                aliasAllocation,
                 mImage);
             if (vkres != VK_SUCCESS) {
                 PPX_ASSERT_MSG(false, "vmaBindImageMemory failed: " << ToString(vkres));
                 return ppx::ERROR_API_FAILURE;
             }
         }
+        else {
+            // Allocate memory
+            {
+                VmaMemoryUsage memoryUsage = ToVmaMemoryUsage(pCreateInfo->memoryUsage);
+                if (memoryUsage == VMA_MEMORY_USAGE_UNKNOWN) {
+                    PPX_ASSERT_MSG(false, "unknown memory usage");
+                    return ppx::ERROR_API_FAILURE;
+                }
+
+                VmaAllocationCreateFlags createFlags = 0;
+
+                if ((memoryUsage == VMA_MEMORY_USAGE_CPU_ONLY) || (memoryUsage == VMA_MEMORY_USAGE_CPU_TO_GPU)) {
+                    createFlags = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+                }
+
+                VmaAllocationCreateInfo vma_alloc_ci = {};
+                vma_alloc_ci.flags                   = createFlags;
+                vma_alloc_ci.usage                   = memoryUsage;
+                vma_alloc_ci.requiredFlags           = 0;
+                vma_alloc_ci.preferredFlags          = 0;
+                vma_alloc_ci.memoryTypeBits          = 0;
+                vma_alloc_ci.pool                    = VK_NULL_HANDLE;
+                vma_alloc_ci.pUserData               = nullptr;
+
+                VkResult vkres = vmaAllocateMemoryForImage(
+                    ToApi(GetDevice())->GetVmaAllocator(),
+                    mImage,
+                    &vma_alloc_ci,
+                    &mAllocation,
+                    &mAllocationInfo);
+                if (vkres != VK_SUCCESS) {
+                    PPX_ASSERT_MSG(false, "vmaAllocateMemoryForImage failed: " << ToString(vkres));
+                    return ppx::ERROR_API_FAILURE;
+                }
+                mAllocationSize = static_cast<uint64_t>(mAllocationInfo.size);
+            }
+
+            // Bind memory
+            {
+                VkResult vkres = vmaBindImageMemory(
+                    ToApi(GetDevice())->GetVmaAllocator(),
+                    mAllocation,
+                    mImage);
+                if (vkres != VK_SUCCESS) {
+                    PPX_ASSERT_MSG(false, "vmaBindImageMemory failed: " << ToString(vkres));
+                    return ppx::ERROR_API_FAILURE;
+                }
+            }
+        }
     }
     else {
         mImage = reinterpret_cast<VkImage>(pCreateInfo->pApiObject);
@@ -184,6 +217,7 @@ void Image::DestroyApiObjects()
         mAllocation.Reset();
 
         mAllocationInfo = {};
+        mAllocationSize = 0;
     }
 
     if (mImage) {
@@ -224,6 +224,9 @@ void ImGuiImplDx12::Render(grfx::CommandBuffer* pCommandBuffer)
 
     ImGui::Render();
     ImGui_ImplDX12_RenderDrawData(ImGui::GetDrawData(), grfx::dx12::ToApi(pCommandBuffer)->GetDxCommandList());
+
+    // ImGui binds its own state directly on the command list
+    pCommandBuffer->InvalidateFilteredState();
 }
 
 #endif // defined(PPX_D3D12)
@@ -373,6 +376,9 @@ void ImGuiImplVk::Render(grfx::CommandBuffer* pCommandBuffer)
 {
     ImGui::Render();
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), grfx::vk::ToApi(pCommandBuffer)->GetVkCommandBuffer());
+
+    // ImGui binds its own state directly on the command buffer
+    pCommandBuffer->InvalidateFilteredState();
 }
 
 #if defined(PPX_BUILD_XR)
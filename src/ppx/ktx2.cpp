@@ -0,0 +1,218 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/ktx2.h"
+#include "ppx/log.h"
+
+#include <cctype>
+#include <cstring>
+
+#if defined(PPX_ENABLE_ZSTD)
+#include <zstd.h>
+#endif
+
+namespace ppx {
+
+static_assert(sizeof(Ktx2Header) == 80, "Ktx2Header must match the KTX2 file layout");
+static_assert(sizeof(Ktx2LevelIndex) == 24, "Ktx2LevelIndex must match the KTX2 file layout");
+
+bool Ktx2File::IsKtx2File(const std::filesystem::path& path)
+{
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".ktx2";
+}
+
+grfx::Format Ktx2File::ToGrfxFormat(uint32_t vkFormat)
+{
+    // VkFormat values, KTX2 files store them whatever the graphics API
+    // clang-format off
+    switch (vkFormat) {
+        default: break;
+        case 9   : return grfx::FORMAT_R8_UNORM;
+        case 15  : return grfx::FORMAT_R8_SRGB;
+        case 16  : return grfx::FORMAT_R8G8_UNORM;
+        case 22  : return grfx::FORMAT_R8G8_SRGB;
+        case 37  : return grfx::FORMAT_R8G8B8A8_UNORM;
+        case 38  : return grfx::FORMAT_R8G8B8A8_SNORM;
+        case 41  : return grfx::FORMAT_R8G8B8A8_UINT;
+        case 43  : return grfx::FORMAT_R8G8B8A8_SRGB;
+        case 44  : return grfx::FORMAT_B8G8R8A8_UNORM;
+        case 50  : return grfx::FORMAT_B8G8R8A8_SRGB;
+        case 70  : return grfx::FORMAT_R16_UNORM;
+        case 76  : return grfx::FORMAT_R16_FLOAT;
+        case 77  : return grfx::FORMAT_R16G16_UNORM;
+        case 83  : return grfx::FORMAT_R16G16_FLOAT;
+        case 91  : return grfx::FORMAT_R16G16B16A16_UNORM;
+        case 97  : return grfx::FORMAT_R16G16B16A16_FLOAT;
+        case 100 : return grfx::FORMAT_R32_FLOAT;
+        case 103 : return grfx::FORMAT_R32G32_FLOAT;
+        case 109 : return grfx::FORMAT_R32G32B32A32_FLOAT;
+        case 122 : return grfx::FORMAT_R11G11B10_FLOAT;
+        case 131 : return grfx::FORMAT_BC1_RGB_UNORM;
+        case 132 : return grfx::FORMAT_BC1_RGB_SRGB;
+        case 133 : return grfx::FORMAT_BC1_RGBA_UNORM;
+        case 134 : return grfx::FORMAT_BC1_RGBA_SRGB;
+        case 135 : return grfx::FORMAT_BC2_UNORM;
+        case 136 : return grfx::FORMAT_BC2_SRGB;
+        case 137 : return grfx::FORMAT_BC3_UNORM;
+        case 138 : return grfx::FORMAT_BC3_SRGB;
+        case 139 : return grfx::FORMAT_BC4_UNORM;
+        case 140 : return grfx::FORMAT_BC4_SNORM;
+        case 141 : return grfx::FORMAT_BC5_UNORM;
+        case 142 : return grfx::FORMAT_BC5_SNORM;
+        case 143 : return grfx::FORMAT_BC6H_UFLOAT;
+        case 144 : return grfx::FORMAT_BC6H_SFLOAT;
+        case 145 : return grfx::FORMAT_BC7_UNORM;
+        case 146 : return grfx::FORMAT_BC7_SRGB;
+    }
+    // clang-format on
+    return grfx::FORMAT_UNDEFINED;
+}
+
+Result Ktx2File::Open(const std::filesystem::path& path)
+{
+    mHeader     = nullptr;
+    mLevelIndex = nullptr;
+    mData       = nullptr;
+    mSize       = 0;
+    mFileData.clear();
+
+    if (!mFile.OpenMapped(path)) {
+        return ppx::ERROR_PATH_DOES_NOT_EXIST;
+    }
+
+    mSize = mFile.GetLength();
+    if (mFile.IsMapped()) {
+        mData = static_cast<const char*>(mFile.GetMappedData());
+    }
+    else {
+        mFileData.resize(mSize);
+        if (mFile.Read(mFileData.data(), mSize) != mSize) {
+            return ppx::ERROR_IMAGE_FILE_LOAD_FAILED;
+        }
+        mData = mFileData.data();
+    }
+
+    // Validate header
+    if (mSize < sizeof(Ktx2Header)) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+    const Ktx2Header* pHeader = reinterpret_cast<const Ktx2Header*>(mData);
+    if (std::memcmp(pHeader->identifier, kIdentifier, sizeof(kIdentifier)) != 0) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+    if ((pHeader->pixelWidth == 0) || (pHeader->faceCount == 0)) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    const grfx::Format format = ToGrfxFormat(pHeader->vkFormat);
+    if (format == grfx::FORMAT_UNDEFINED) {
+        PPX_LOG_ERROR("Unsupported KTX2 vkFormat " << pHeader->vkFormat << ": " << path);
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    // Validate level index
+    const uint32_t levelCount = std::max<uint32_t>(pHeader->levelCount, 1);
+    if ((mSize - sizeof(Ktx2Header)) / sizeof(Ktx2LevelIndex) < levelCount) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+    const Ktx2LevelIndex* pLevelIndex = reinterpret_cast<const Ktx2LevelIndex*>(mData + sizeof(Ktx2Header));
+
+    // GetLevelSize() reads the header
+    mHeader = pHeader;
+
+    const bool supercompressed = (pHeader->supercompressionScheme != KTX2_SUPERCOMPRESSION_NONE);
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        const Ktx2LevelIndex& index    = pLevelIndex[level];
+        bool                  inBounds = (index.byteOffset <= mSize) && (index.byteLength <= (mSize - index.byteOffset));
+        bool                  sizeOk   = (index.uncompressedByteLength == GetLevelSize(level)) && (supercompressed || (index.byteLength == index.uncompressedByteLength));
+        if (!inBounds || !sizeOk) {
+            mHeader = nullptr;
+            return ppx::ERROR_BAD_DATA_SOURCE;
+        }
+    }
+
+    mLevelIndex = pLevelIndex;
+
+    return ppx::SUCCESS;
+}
+
+uint64_t Ktx2File::GetLevelSize(uint32_t level) const
+{
+    const grfx::FormatDesc* pDesc       = grfx::GetFormatDescription(GetFormat());
+    const uint64_t          blockCountX = (GetLevelWidth(level) + pDesc->blockWidth - 1) / pDesc->blockWidth;
+    const uint64_t          blockCountY = (GetLevelHeight(level) + pDesc->blockWidth - 1) / pDesc->blockWidth;
+    const uint64_t          depth       = std::max<uint32_t>(GetDepth() >> level, 1);
+    return blockCountX * blockCountY * pDesc->bytesPerTexel * depth * GetArrayLayerCount() * GetFaceCount();
+}
+
+const void* Ktx2File::GetLevelData(uint32_t level) const
+{
+    if (!IsOpen() || (level >= GetLevelCount())) {
+        return nullptr;
+    }
+    return mData + mLevelIndex[level].byteOffset;
+}
+
+uint64_t Ktx2File::GetLevelDataSize(uint32_t level) const
+{
+    if (!IsOpen() || (level >= GetLevelCount())) {
+        return 0;
+    }
+    return mLevelIndex[level].byteLength;
+}
+
+Result Ktx2File::ReadLevel(uint32_t level, void* pDst, uint64_t dstSize) const
+{
+    PPX_ASSERT_NULL_ARG(pDst);
+
+    if (!IsOpen() || (level >= GetLevelCount())) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+
+    const Ktx2LevelIndex& index = mLevelIndex[level];
+    if (dstSize < index.uncompressedByteLength) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+
+    switch (GetSupercompression()) {
+        default: break;
+
+        case KTX2_SUPERCOMPRESSION_NONE: {
+            std::memcpy(pDst, mData + index.byteOffset, index.byteLength);
+            return ppx::SUCCESS;
+        }
+
+        case KTX2_SUPERCOMPRESSION_ZSTD: {
+#if defined(PPX_ENABLE_ZSTD)
+            // Each level is a single Zstandard frame
+            const size_t size = ZSTD_decompress(pDst, static_cast<size_t>(dstSize), mData + index.byteOffset, static_cast<size_t>(index.byteLength));
+            if (ZSTD_isError(size) || (size != index.uncompressedByteLength)) {
+                PPX_LOG_ERROR("Failed to decompress KTX2 level " << level << ": " << (ZSTD_isError(size) ? ZSTD_getErrorName(size) : "unexpected size"));
+                return ppx::ERROR_IMAGE_FILE_LOAD_FAILED;
+            }
+            return ppx::SUCCESS;
+#else
+            PPX_LOG_ERROR("KTX2 Zstandard supercompression requires building with PPX_ENABLE_ZSTD");
+            return ppx::ERROR_IMAGE_FILE_LOAD_FAILED;
+#endif
+        }
+    }
+
+    PPX_LOG_ERROR("Unsupported KTX2 supercompression scheme: " << mHeader->supercompressionScheme);
+    return ppx::ERROR_IMAGE_FILE_LOAD_FAILED;
+}
+
+} // namespace ppx
@@ -0,0 +1,648 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/mesh_optimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace ppx {
+
+namespace {
+
+constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+// Forsyth scoring parameters, see "Linear-Speed Vertex Cache Optimisation"
+constexpr float    kForsythCacheDecayPower   = 1.5f;
+constexpr float    kForsythLastTriScore      = 0.75f;
+constexpr float    kForsythValenceBoostScale = 2.0f;
+constexpr float    kForsythValenceBoostPower = 0.5f;
+constexpr uint32_t kForsythMinCacheSize      = 4;
+constexpr uint32_t kForsythMaxCacheSize      = 64;
+
+//! @struct TriangleAdjacency
+//!
+//! Triangles referencing vertex v are stored in
+//! triangles[offsets[v], offsets[v] + counts[v]).
+//!
+struct TriangleAdjacency
+{
+    std::vector<uint32_t> counts;
+    std::vector<uint32_t> offsets;
+    std::vector<uint32_t> triangles;
+};
+
+void BuildTriangleAdjacency(const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, TriangleAdjacency& adjacency)
+{
+    const uint32_t triangleCount = indexCount / 3;
+
+    adjacency.counts.assign(vertexCount, 0);
+    for (uint32_t i = 0; i < (triangleCount * 3); ++i) {
+        PPX_ASSERT_MSG(pIndices[i] < vertexCount, "index out of range: " << pIndices[i]);
+        adjacency.counts[pIndices[i]] += 1;
+    }
+
+    adjacency.offsets.resize(vertexCount);
+    uint32_t offset = 0;
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        adjacency.offsets[v] = offset;
+        offset += adjacency.counts[v];
+    }
+
+    adjacency.triangles.resize(triangleCount * 3);
+    std::vector<uint32_t> cursors = adjacency.offsets;
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        adjacency.triangles[cursors[pIndices[3 * t + 0]]++] = t;
+        adjacency.triangles[cursors[pIndices[3 * t + 1]]++] = t;
+        adjacency.triangles[cursors[pIndices[3 * t + 2]]++] = t;
+    }
+}
+
+float ForsythVertexScore(int32_t cachePosition, uint32_t liveTriangles, uint32_t cacheSize)
+{
+    if (liveTriangles == 0) {
+        return -1.0f;
+    }
+
+    float score = 0.0f;
+    if (cachePosition >= 0) {
+        if (cachePosition < 3) {
+            // Vertices of the last triangle get a fixed score, otherwise the
+            // optimizer would prefer re-using them in the next triangle.
+            score = kForsythLastTriScore;
+        }
+        else {
+            const float scale = 1.0f / static_cast<float>(cacheSize - 3);
+            score             = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scale, kForsythCacheDecayPower);
+        }
+    }
+
+    // Boost vertices with few triangles left so they're finished off
+    score += kForsythValenceBoostScale * std::pow(static_cast<float>(liveTriangles), -kForsythValenceBoostPower);
+    return score;
+}
+
+template <typename T>
+void RemapVertexStream(std::vector<T>& stream, const std::vector<uint32_t>& remap, uint32_t newVertexCount, uint32_t elementsPerVertex)
+{
+    if (stream.empty()) {
+        return;
+    }
+
+    std::vector<T> remapped(static_cast<size_t>(newVertexCount) * elementsPerVertex);
+    for (size_t v = 0; v < remap.size(); ++v) {
+        if (remap[v] == kInvalidIndex) {
+            continue;
+        }
+        const T* pSrc = stream.data() + v * elementsPerVertex;
+        T*       pDst = remapped.data() + static_cast<size_t>(remap[v]) * elementsPerVertex;
+        std::copy(pSrc, pSrc + elementsPerVertex, pDst);
+    }
+    stream.swap(remapped);
+}
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+// MeshOptimizer
+// -------------------------------------------------------------------------------------------------
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+{
+    VertexCacheStatistics stats = {};
+    stats.triangleCount         = indexCount / 3;
+    if ((stats.triangleCount == 0) || (vertexCount == 0)) {
+        return stats;
+    }
+
+    // A vertex is in the cache if it was transformed fewer than cacheSize transforms ago
+    std::vector<uint32_t> timestamps(vertexCount, 0);
+    uint32_t              timestamp = cacheSize + 1;
+    for (uint32_t i = 0; i < (stats.triangleCount * 3); ++i) {
+        const uint32_t v = pIndices[i];
+        PPX_ASSERT_MSG(v < vertexCount, "index out of range: " << v);
+        if (timestamps[v] == 0) {
+            stats.vertexCount += 1;
+        }
+        if ((timestamp - timestamps[v]) > cacheSize) {
+            timestamps[v] = timestamp++;
+            stats.transformCount += 1;
+        }
+    }
+
+    stats.acmr = static_cast<float>(stats.transformCount) / static_cast<float>(stats.triangleCount);
+    stats.atvr = static_cast<float>(stats.transformCount) / static_cast<float>(stats.vertexCount);
+    return stats;
+}
+
+void MeshOptimizer::OptimizeVertexCacheForsyth(uint32_t* pDstIndices, const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize)
+{
+    PPX_ASSERT_MSG(pDstIndices != pIndices, "in place optimization is not supported");
+
+    const uint32_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+    cacheSize = std::clamp(cacheSize, kForsythMinCacheSize, kForsythMaxCacheSize);
+
+    TriangleAdjacency adjacency;
+    BuildTriangleAdjacency(pIndices, indexCount, vertexCount, adjacency);
+
+    // counts doubles as the number of live triangles per vertex. Emitted
+    // triangles are swapped past the end of each vertex's live range.
+    std::vector<uint32_t>& liveTriangles = adjacency.counts;
+
+    std::vector<int32_t> cachePositions(vertexCount, -1);
+    std::vector<float>   vertexScores(vertexCount);
+    for (uint32_t v = 0; v < vertexCount; ++v) {
+        vertexScores[v] = ForsythVertexScore(-1, liveTriangles[v], cacheSize);
+    }
+
+    std::vector<float> triangleScores(triangleCount);
+    std::vector<bool>  emitted(triangleCount, false);
+    for (uint32_t t = 0; t < triangleCount; ++t) {
+        triangleScores[t] = vertexScores[pIndices[3 * t + 0]] + vertexScores[pIndices[3 * t + 1]] + vertexScores[pIndices[3 * t + 2]];
+    }
+
+    // Cache has room for the new triangle's vertices on top of cacheSize
+    std::vector<uint32_t> cache;
+    std::vector<uint32_t> newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    uint32_t bestTriangle = static_cast<uint32_t>(std::distance(triangleScores.begin(), std::max_element(triangleScores.begin(), triangleScores.end())));
+    uint32_t scanCursor   = 0;
+    uint32_t outIndex     = 0;
+
+    while (bestTriangle != kInvalidIndex) {
+        const uint32_t* pTri = pIndices + 3 * bestTriangle;
+        emitted[bestTriangle] = true;
+
+        newCache.clear();
+        for (uint32_t j = 0; j < 3; ++j) {
+            const uint32_t v        = pTri[j];
+            pDstIndices[outIndex++] = v;
+
+            // Remove triangle from the vertex's live range
+            uint32_t* pBegin = adjacency.triangles.data() + adjacency.offsets[v];
+            uint32_t* pEnd   = pBegin + liveTriangles[v];
+            uint32_t* pFound = std::find(pBegin, pEnd, bestTriangle);
+            if (pFound != pEnd) {
+                std::swap(*pFound, *(pEnd - 1));
+                liveTriangles[v] -= 1;
+            }
+
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+        for (uint32_t v : cache) {
+            if (std::find(newCache.begin(), newCache.end(), v) == newCache.end()) {
+                newCache.push_back(v);
+            }
+        }
+
+        // Update scores of everything that was or is in the cache, vertices
+        // pushed out of the cache lose their cache position.
+        for (uint32_t i = 0; i < CountU32(newCache); ++i) {
+            const uint32_t v     = newCache[i];
+            cachePositions[v]    = (i < cacheSize) ? static_cast<int32_t>(i) : -1;
+            const float newScore = ForsythVertexScore(cachePositions[v], liveTriangles[v], cacheSize);
+            const float delta    = newScore - vertexScores[v];
+            vertexScores[v]      = newScore;
+
+            const uint32_t* pTriangles = adjacency.triangles.data() + adjacency.offsets[v];
+            for (uint32_t k = 0; k < liveTriangles[v]; ++k) {
+                triangleScores[pTriangles[k]] += delta;
+            }
+        }
+        if (newCache.size() > cacheSize) {
+            newCache.resize(cacheSize);
+        }
+        cache.swap(newCache);
+
+        // Next triangle is the best one that uses a cached vertex
+        bestTriangle    = kInvalidIndex;
+        float bestScore = -1.0f;
+        for (uint32_t v : cache) {
+            const uint32_t* pTriangles = adjacency.triangles.data() + adjacency.offsets[v];
+            for (uint32_t k = 0; k < liveTriangles[v]; ++k) {
+                const uint32_t t = pTriangles[k];
+                if (triangleScores[t] > bestScore) {
+                    bestScore    = triangleScores[t];
+                    bestTriangle = t;
+                }
+            }
+        }
+
+        // Nothing in the cache has live triangles, continue with the first
+        // unemitted triangle. This is the linear-time fallback from the paper.
+        if (bestTriangle == kInvalidIndex) {
+            while ((scanCursor < triangleCount) && emitted[scanCursor]) {
+                ++scanCursor;
+            }
+            if (scanCursor < triangleCount) {
+                bestTriangle = scanCursor;
+            }
+        }
+    }
+}
+
+void MeshOptimizer::OptimizeVertexCacheTipsify(uint32_t* pDstIndices, const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount, uint32_t cacheSize, std::vector<uint32_t>* pClusters)
+{
+    PPX_ASSERT_MSG(pDstIndices != pIndices, "in place optimization is not supported");
+
+    if (!IsNull(pClusters)) {
+        pClusters->clear();
+    }
+
+    const uint32_t triangleCount = indexCount / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    TriangleAdjacency adjacency;
+    BuildTriangleAdjacency(pIndices, indexCount, vertexCount, adjacency);
+
+    std::vector<uint32_t> liveTriangles = adjacency.counts;
+    std::vector<uint32_t> cacheTimes(vertexCount, 0);
+    std::vector<bool>     emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnd;
+    std::vector<uint32_t> candidates;
+    deadEnd.reserve(indexCount);
+
+    uint32_t time     = cacheSize + 1;
+    uint32_t cursor   = 0;
+    uint32_t outIndex = 0;
+    uint32_t fanning  = pIndices[0];
+
+    if (!IsNull(pClusters)) {
+        pClusters->push_back(0);
+    }
+
+    while (fanning != kInvalidIndex) {
+        // Emit all live triangles around the fanning vertex
+        candidates.clear();
+        const uint32_t* pTriangles = adjacency.triangles.data() + adjacency.offsets[fanning];
+        for (uint32_t k = 0; k < adjacency.counts[fanning]; ++k) {
+            const uint32_t t = pTriangles[k];
+            if (emitted[t]) {
+                continue;
+            }
+            for (uint32_t j = 0; j < 3; ++j) {
+                const uint32_t v        = pIndices[3 * t + j];
+                pDstIndices[outIndex++] = v;
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v] -= 1;
+                if ((time - cacheTimes[v]) > cacheSize) {
+                    cacheTimes[v] = time++;
+                }
+            }
+            emitted[t] = true;
+        }
+
+        // Next fanning vertex is the one that'll still be in the cache after
+        // its live triangles are emitted, preferring the oldest.
+        uint32_t bestVertex   = kInvalidIndex;
+        int64_t  bestPriority = -1;
+        for (uint32_t v : candidates) {
+            if (liveTriangles[v] == 0) {
+                continue;
+            }
+            int64_t priority = 0;
+            if ((time - cacheTimes[v] + 2 * liveTriangles[v]) <= cacheSize) {
+                priority = time - cacheTimes[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                bestVertex   = v;
+            }
+        }
+
+        // Dead end, pick the most recently referenced vertex with live
+        // triangles or the next one in input order. Starts a new cluster.
+        if (bestVertex == kInvalidIndex) {
+            while (!deadEnd.empty()) {
+                const uint32_t v = deadEnd.back();
+                deadEnd.pop_back();
+                if (liveTriangles[v] > 0) {
+                    bestVertex = v;
+                    break;
+                }
+            }
+            while ((bestVertex == kInvalidIndex) && (cursor < vertexCount)) {
+                if (liveTriangles[cursor] > 0) {
+                    bestVertex = cursor;
+                }
+                ++cursor;
+            }
+            if ((bestVertex != kInvalidIndex) && !IsNull(pClusters)) {
+                pClusters->push_back(outIndex);
+            }
+        }
+
+        fanning = bestVertex;
+    }
+}
+
+void MeshOptimizer::OptimizeOverdraw(
+    uint32_t*                    pDstIndices,
+    const uint32_t*              pIndices,
+    uint32_t                     indexCount,
+    const float*                 pPositions,
+    uint32_t                     positionStride,
+    uint32_t                     vertexCount,
+    const std::vector<uint32_t>& clusters,
+    uint32_t                     cacheSize,
+    float                        threshold)
+{
+    PPX_ASSERT_MSG(pDstIndices != pIndices, "in place optimization is not supported");
+
+    const uint32_t triangleIndexCount = (indexCount / 3) * 3;
+    std::copy(pIndices, pIndices + triangleIndexCount, pDstIndices);
+    if (clusters.size() < 2) {
+        return;
+    }
+
+    auto getPosition = [pPositions, positionStride](uint32_t v) -> float3 {
+        const float* p = reinterpret_cast<const float*>(reinterpret_cast<const char*>(pPositions) + static_cast<size_t>(v) * positionStride);
+        return float3(p[0], p[1], p[2]);
+    };
+
+    // Area weighted centroid and normal per cluster
+    const uint32_t      clusterCount = CountU32(clusters);
+    std::vector<float3> clusterCentroids(clusterCount, float3(0));
+    std::vector<float3> clusterNormals(clusterCount, float3(0));
+    float3              meshCentroid = float3(0);
+    float               meshArea     = 0.0f;
+    for (uint32_t c = 0; c < clusterCount; ++c) {
+        const uint32_t begin = clusters[c];
+        const uint32_t end   = (c + 1 < clusterCount) ? clusters[c + 1] : triangleIndexCount;
+
+        float clusterArea = 0.0f;
+        for (uint32_t i = begin; i < end; i += 3) {
+            const float3 p0     = getPosition(pIndices[i + 0]);
+            const float3 p1     = getPosition(pIndices[i + 1]);
+            const float3 p2     = getPosition(pIndices[i + 2]);
+            const float3 normal = glm::cross(p1 - p0, p2 - p0);
+            const float  area   = glm::length(normal);
+
+            clusterCentroids[c] += (p0 + p1 + p2) * (area / 3.0f);
+            clusterNormals[c] += normal;
+            clusterArea += area;
+        }
+
+        meshCentroid += clusterCentroids[c];
+        meshArea += clusterArea;
+        if (clusterArea > 0.0f) {
+            clusterCentroids[c] /= clusterArea;
+        }
+    }
+    if (meshArea > 0.0f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Clusters facing away from the center are more likely to occlude others
+    std::vector<float> sortKeys(clusterCount);
+    for (uint32_t c = 0; c < clusterCount; ++c) {
+        sortKeys[c] = glm::dot(clusterCentroids[c] - meshCentroid, clusterNormals[c]);
+    }
+
+    std::vector<uint32_t> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+    uint32_t outIndex = 0;
+    for (uint32_t c : order) {
+        const uint32_t begin = clusters[c];
+        const uint32_t end   = (c + 1 < clusterCount) ? clusters[c + 1] : triangleIndexCount;
+        std::copy(pIndices + begin, pIndices + end, pDstIndices + outIndex);
+        outIndex += (end - begin);
+    }
+
+    // Keep the input order if the new one costs too much in vertex cache efficiency
+    const VertexCacheStatistics before = AnalyzeVertexCache(pIndices, triangleIndexCount, vertexCount, cacheSize);
+    const VertexCacheStatistics after  = AnalyzeVertexCache(pDstIndices, triangleIndexCount, vertexCount, cacheSize);
+    if (after.acmr > (before.acmr * threshold)) {
+        std::copy(pIndices, pIndices + triangleIndexCount, pDstIndices);
+    }
+}
+
+uint32_t MeshOptimizer::CreateVertexFetchRemap(uint32_t* pRemap, const uint32_t* pIndices, uint32_t indexCount, uint32_t vertexCount)
+{
+    std::fill(pRemap, pRemap + vertexCount, kInvalidIndex);
+
+    uint32_t newVertexCount = 0;
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        const uint32_t v = pIndices[i];
+        PPX_ASSERT_MSG(v < vertexCount, "index out of range: " << v);
+        if (pRemap[v] == kInvalidIndex) {
+            pRemap[v] = newVertexCount++;
+        }
+    }
+    return newVertexCount;
+}
+
+Result MeshOptimizer::OptimizeIndices(const MeshOptimizerOptions& options, std::vector<uint32_t>& indices, uint32_t vertexCount, const float* pPositions, uint32_t positionStride)
+{
+    const uint32_t        indexCount = CountU32(indices);
+    std::vector<uint32_t> optimized(indices.size());
+
+    switch (options.vertexCacheMethod) {
+        default: {
+            PPX_ASSERT_MSG(false, "unknown vertex cache method: " << options.vertexCacheMethod);
+            return ppx::ERROR_INVALID_CREATE_ARGUMENT;
+        } break;
+
+        case MESH_OPTIMIZER_VERTEX_CACHE_METHOD_NONE: {
+        } break;
+
+        case MESH_OPTIMIZER_VERTEX_CACHE_METHOD_FORSYTH: {
+            OptimizeVertexCacheForsyth(optimized.data(), indices.data(), indexCount, vertexCount, options.vertexCacheSize);
+            indices.swap(optimized);
+        } break;
+
+        case MESH_OPTIMIZER_VERTEX_CACHE_METHOD_TIPSIFY: {
+            std::vector<uint32_t> clusters;
+            OptimizeVertexCacheTipsify(optimized.data(), indices.data(), indexCount, vertexCount, options.vertexCacheSize, &clusters);
+            indices.swap(optimized);
+
+            if (options.optimizeOverdraw && !IsNull(pPositions)) {
+                OptimizeOverdraw(optimized.data(), indices.data(), indexCount, pPositions, positionStride, vertexCount, clusters, options.vertexCacheSize, options.overdrawThreshold);
+                indices.swap(optimized);
+            }
+        } break;
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result MeshOptimizer::Optimize(const MeshOptimizerOptions& options, TriMesh* pMesh, MeshOptimizerStatistics* pStatistics)
+{
+    PPX_ASSERT_NULL_ARG(pMesh);
+
+    const grfx::IndexType indexType = pMesh->GetIndexType();
+    if (indexType == grfx::INDEX_TYPE_UNDEFINED) {
+        return ppx::SUCCESS;
+    }
+
+    const uint32_t        indexCount  = pMesh->GetCountIndices();
+    uint32_t              vertexCount = pMesh->GetCountPositions();
+    std::vector<uint32_t> indices(indexCount);
+    if (indexType == grfx::INDEX_TYPE_UINT16) {
+        const uint16_t* pIndices = reinterpret_cast<const uint16_t*>(pMesh->mIndices.data());
+        std::copy(pIndices, pIndices + indexCount, indices.begin());
+    }
+    else {
+        memcpy(indices.data(), pMesh->mIndices.data(), indexCount * sizeof(uint32_t));
+    }
+
+    MeshOptimizerStatistics stats = {};
+    stats.before                  = AnalyzeVertexCache(indices.data(), indexCount, vertexCount, options.vertexCacheSize);
+
+    const float* pPositions = pMesh->mPositions.empty() ? nullptr : &pMesh->mPositions[0].x;
+    Result       ppxres     = OptimizeIndices(options, indices, vertexCount, pPositions, static_cast<uint32_t>(sizeof(float3)));
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    if (options.optimizeVertexFetch) {
+        std::vector<uint32_t> remap(vertexCount);
+        const uint32_t        newVertexCount = CreateVertexFetchRemap(remap.data(), indices.data(), indexCount, vertexCount);
+        for (uint32_t& index : indices) {
+            index = remap[index];
+        }
+
+        RemapVertexStream(pMesh->mPositions, remap, newVertexCount, 1);
+        RemapVertexStream(pMesh->mColors, remap, newVertexCount, 1);
+        RemapVertexStream(pMesh->mNormals, remap, newVertexCount, 1);
+        RemapVertexStream(pMesh->mTexCoords, remap, newVertexCount, static_cast<uint32_t>(pMesh->mTexCoordDim));
+        RemapVertexStream(pMesh->mTangents, remap, newVertexCount, 1);
+        RemapVertexStream(pMesh->mBitangents, remap, newVertexCount, 1);
+        vertexCount = newVertexCount;
+    }
+
+    if (indexType == grfx::INDEX_TYPE_UINT16) {
+        uint16_t* pIndices = reinterpret_cast<uint16_t*>(pMesh->mIndices.data());
+        for (uint32_t i = 0; i < indexCount; ++i) {
+            pIndices[i] = static_cast<uint16_t>(indices[i]);
+        }
+    }
+    else {
+        memcpy(pMesh->mIndices.data(), indices.data(), indexCount * sizeof(uint32_t));
+    }
+
+    stats.after = AnalyzeVertexCache(indices.data(), indexCount, vertexCount, options.vertexCacheSize);
+    if (!IsNull(pStatistics)) {
+        *pStatistics = stats;
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result MeshOptimizer::Optimize(const MeshOptimizerOptions& options, Geometry* pGeometry, MeshOptimizerStatistics* pStatistics)
+{
+    PPX_ASSERT_NULL_ARG(pGeometry);
+
+    const grfx::IndexType indexType = pGeometry->GetIndexType();
+    if ((indexType != grfx::INDEX_TYPE_UINT16) && (indexType != grfx::INDEX_TYPE_UINT32)) {
+        return ppx::SUCCESS;
+    }
+
+    const uint32_t        indexCount  = pGeometry->GetIndexCount();
+    uint32_t              vertexCount = pGeometry->GetVertexCount();
+    Geometry::Buffer      indexBuffer = *pGeometry->GetIndexBuffer();
+    std::vector<uint32_t> indices(indexCount);
+    if (indexType == grfx::INDEX_TYPE_UINT16) {
+        const uint16_t* pIndices = reinterpret_cast<const uint16_t*>(indexBuffer.GetData());
+        std::copy(pIndices, pIndices + indexCount, indices.begin());
+    }
+    else {
+        memcpy(indices.data(), indexBuffer.GetData(), indexCount * sizeof(uint32_t));
+    }
+
+    // Find 32-bit float positions in any vertex binding
+    const float* pPositions     = nullptr;
+    uint32_t     positionStride = 0;
+    for (uint32_t bindingIndex = 0; bindingIndex < pGeometry->GetVertexBindingCount(); ++bindingIndex) {
+        const grfx::VertexBinding* pBinding       = pGeometry->GetVertexBinding(bindingIndex);
+        const uint32_t             attributeIndex = pBinding->GetAttributeIndex(grfx::VERTEX_SEMANTIC_POSITION);
+        if (attributeIndex == PPX_VALUE_IGNORED) {
+            continue;
+        }
+
+        const grfx::VertexAttribute* pAttribute = nullptr;
+        pBinding->GetAttribute(attributeIndex, &pAttribute);
+        if ((pAttribute->format == grfx::FORMAT_R32G32B32_FLOAT) || (pAttribute->format == grfx::FORMAT_R32G32B32A32_FLOAT)) {
+            pPositions     = reinterpret_cast<const float*>(pGeometry->GetVertexBuffer(bindingIndex)->GetData() + pAttribute->offset);
+            positionStride = pBinding->GetStride();
+        }
+        break;
+    }
+
+    MeshOptimizerStatistics stats = {};
+    stats.before                  = AnalyzeVertexCache(indices.data(), indexCount, vertexCount, options.vertexCacheSize);
+
+    Result ppxres = OptimizeIndices(options, indices, vertexCount, pPositions, positionStride);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    if (options.optimizeVertexFetch) {
+        std::vector<uint32_t> remap(vertexCount);
+        const uint32_t        newVertexCount = CreateVertexFetchRemap(remap.data(), indices.data(), indexCount, vertexCount);
+        for (uint32_t& index : indices) {
+            index = remap[index];
+        }
+
+        // Every vertex buffer holds one element per vertex, regardless of attribute layout
+        for (uint32_t bindingIndex = 0; bindingIndex < pGeometry->GetVertexBindingCount(); ++bindingIndex) {
+            const uint32_t    stride  = pGeometry->GetVertexBinding(bindingIndex)->GetStride();
+            Geometry::Buffer* pBuffer = pGeometry->GetVertexBuffer(bindingIndex);
+
+            std::vector<char> remapped(static_cast<size_t>(newVertexCount) * stride);
+            for (uint32_t v = 0; v < vertexCount; ++v) {
+                if (remap[v] != kInvalidIndex) {
+                    memcpy(remapped.data() + static_cast<size_t>(remap[v]) * stride, pBuffer->GetData() + static_cast<size_t>(v) * stride, stride);
+                }
+            }
+            pBuffer->SetSize(static_cast<uint32_t>(remapped.size()));
+            if (!remapped.empty()) {
+                memcpy(pBuffer->GetData(), remapped.data(), remapped.size());
+            }
+        }
+        vertexCount = newVertexCount;
+    }
+
+    if (indexType == grfx::INDEX_TYPE_UINT16) {
+        uint16_t* pIndices = reinterpret_cast<uint16_t*>(indexBuffer.GetData());
+        for (uint32_t i = 0; i < indexCount; ++i) {
+            pIndices[i] = static_cast<uint16_t>(indices[i]);
+        }
+    }
+    else {
+        memcpy(indexBuffer.GetData(), indices.data(), indexCount * sizeof(uint32_t));
+    }
+    pGeometry->SetIndexBuffer(indexBuffer);
+
+    stats.after = AnalyzeVertexCache(indices.data(), indexCount, vertexCount, options.vertexCacheSize);
+    if (!IsNull(pStatistics)) {
+        *pStatistics = stats;
+    }
+
+    return ppx::SUCCESS;
+}
+
+} // namespace ppx
@@ -0,0 +1,629 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/mesh_simplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace ppx {
+
+namespace {
+
+constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+// Border edges are preserved by adding a plane perpendicular to the
+// triangle through the edge, scaled so borders resist collapses.
+constexpr double kBorderQuadricWeight = 10.0;
+
+//! @struct Quadric
+//!
+//! Symmetric 4x4 error quadric, Q(p) = p^T A p + 2 b^T p + c. w is the sum
+//! of the plane weights, Q(p) / w is the weighted mean squared distance.
+//!
+struct Quadric
+{
+    double a00 = 0, a01 = 0, a02 = 0, a11 = 0, a12 = 0, a22 = 0;
+    double b0 = 0, b1 = 0, b2 = 0;
+    double c = 0;
+    double w = 0;
+
+    Quadric& operator+=(const Quadric& rhs)
+    {
+        a00 += rhs.a00;
+        a01 += rhs.a01;
+        a02 += rhs.a02;
+        a11 += rhs.a11;
+        a12 += rhs.a12;
+        a22 += rhs.a22;
+        b0 += rhs.b0;
+        b1 += rhs.b1;
+        b2 += rhs.b2;
+        c += rhs.c;
+        w += rhs.w;
+        return *this;
+    }
+};
+
+// Plane through p with unit normal n, scaled by weight
+Quadric PlaneQuadric(const float3& n, const float3& p, double weight)
+{
+    const double nx = n.x;
+    const double ny = n.y;
+    const double nz = n.z;
+    const double d  = -(nx * p.x + ny * p.y + nz * p.z);
+
+    Quadric q;
+    q.a00 = weight * nx * nx;
+    q.a01 = weight * nx * ny;
+    q.a02 = weight * nx * nz;
+    q.a11 = weight * ny * ny;
+    q.a12 = weight * ny * nz;
+    q.a22 = weight * nz * nz;
+    q.b0  = weight * nx * d;
+    q.b1  = weight * ny * d;
+    q.b2  = weight * nz * d;
+    q.c   = weight * d * d;
+    q.w   = weight;
+    return q;
+}
+
+// Weighted mean squared distance of p to the planes of q
+double EvaluateQuadric(const Quadric& q, const float3& p)
+{
+    const double x = p.x;
+    const double y = p.y;
+    const double z = p.z;
+
+    double error = (q.a00 * x * x) + (q.a11 * y * y) + (q.a22 * z * z);
+    error += 2.0 * ((q.a01 * x * y) + (q.a02 * x * z) + (q.a12 * y * z));
+    error += 2.0 * ((q.b0 * x) + (q.b1 * y) + (q.b2 * z));
+    error += q.c;
+    return (q.w > 0.0) ? std::max(error / q.w, 0.0) : 0.0;
+}
+
+// Distance from p to triangle abc
+float TriangleDistance(const float3& p, const float3& a, const float3& b, const float3& c)
+{
+    // Closest point by Voronoi region, see Ericson, Real-Time Collision Detection 5.1.5
+    const float3 ab = b - a;
+    const float3 ac = c - a;
+    const float3 ap = p - a;
+    const float  d1 = glm::dot(ab, ap);
+    const float  d2 = glm::dot(ac, ap);
+    if ((d1 <= 0.0f) && (d2 <= 0.0f)) {
+        return glm::length(ap);
+    }
+
+    const float3 bp = p - b;
+    const float  d3 = glm::dot(ab, bp);
+    const float  d4 = glm::dot(ac, bp);
+    if ((d3 >= 0.0f) && (d4 <= d3)) {
+        return glm::length(bp);
+    }
+
+    const float vc = d1 * d4 - d3 * d2;
+    if ((vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f)) {
+        return glm::length(ap - ab * (d1 / (d1 - d3)));
+    }
+
+    const float3 cp = p - c;
+    const float  d5 = glm::dot(ab, cp);
+    const float  d6 = glm::dot(ac, cp);
+    if ((d6 >= 0.0f) && (d5 <= d6)) {
+        return glm::length(cp);
+    }
+
+    const float vb = d5 * d2 - d1 * d6;
+    if ((vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f)) {
+        return glm::length(ap - ac * (d2 / (d2 - d6)));
+    }
+
+    const float va = d3 * d6 - d5 * d4;
+    if ((va <= 0.0f) && ((d4 - d3) >= 0.0f) && ((d5 - d6) >= 0.0f)) {
+        return glm::length(bp - (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+    }
+
+    const float denom = 1.0f / (va + vb + vc);
+    return glm::length(ap - ab * (vb * denom) - ac * (vc * denom));
+}
+
+struct PositionKeyHash
+{
+    size_t operator()(const std::array<uint32_t, 3>& key) const
+    {
+        size_t hash = key[0];
+        hash        = (hash * 73856093) ^ key[1];
+        hash        = (hash * 19349663) ^ key[2];
+        return hash;
+    }
+};
+
+struct CollapseCandidate
+{
+    uint32_t from = 0;
+    uint32_t to   = 0;
+    double   cost = 0;
+};
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+// MeshSimplifier
+// -------------------------------------------------------------------------------------------------
+Result MeshSimplifier::Simplify(const TriMesh& mesh, const MeshSimplifierOptions& options, TriMesh* pSimplified, float* pError)
+{
+    PPX_ASSERT_NULL_ARG(pSimplified);
+
+    const uint32_t vertexCount = mesh.GetCountPositions();
+    const float3*  pPositions  = mesh.mPositions.data();
+
+    std::vector<uint32_t> indices;
+    if (mesh.mIndexType == grfx::INDEX_TYPE_UINT16) {
+        const uint16_t* pIndices = reinterpret_cast<const uint16_t*>(mesh.mIndices.data());
+        indices.assign(pIndices, pIndices + mesh.GetCountIndices());
+    }
+    else if (mesh.mIndexType == grfx::INDEX_TYPE_UINT32) {
+        const uint32_t* pIndices = reinterpret_cast<const uint32_t*>(mesh.mIndices.data());
+        indices.assign(pIndices, pIndices + mesh.GetCountIndices());
+    }
+    else {
+        indices.resize(vertexCount);
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            indices[i] = i;
+        }
+    }
+    indices.resize((indices.size() / 3) * 3);
+
+    // Vertices sharing a position are collapsed together, the first vertex
+    // at each position represents it. Vertices at a position are "wedges".
+    std::vector<uint32_t> positionReps(vertexCount);
+    std::vector<uint32_t> firstWedges(vertexCount, kInvalidIndex);
+    std::vector<uint32_t> nextWedges(vertexCount, kInvalidIndex);
+    {
+        std::unordered_map<std::array<uint32_t, 3>, uint32_t, PositionKeyHash> reps;
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            std::array<uint32_t, 3> key = {};
+            memcpy(key.data(), &pPositions[v], sizeof(float3));
+
+            auto it         = reps.emplace(key, v).first;
+            positionReps[v] = it->second;
+            nextWedges[v]   = firstWedges[it->second];
+            firstWedges[it->second] = v;
+        }
+    }
+
+    // Attribute differences are measured relative to the size of the mesh
+    const float3 extent         = mesh.GetBoundingBoxMax() - mesh.GetBoundingBoxMin();
+    const double attributeScale = std::pow(static_cast<double>(options.attributeWeight) * glm::length(extent), 2.0);
+    const uint32_t texCoordDim  = static_cast<uint32_t>(mesh.mTexCoordDim);
+
+    auto attributeDistance2 = [&](uint32_t a, uint32_t b) -> double {
+        double distance2 = 0;
+        if (!mesh.mNormals.empty()) {
+            const float3 d = mesh.mNormals[a] - mesh.mNormals[b];
+            distance2 += glm::dot(d, d);
+        }
+        if (!mesh.mColors.empty()) {
+            const float3 d = mesh.mColors[a] - mesh.mColors[b];
+            distance2 += glm::dot(d, d);
+        }
+        for (uint32_t i = 0; (i < texCoordDim) && !mesh.mTexCoords.empty(); ++i) {
+            const float d = mesh.mTexCoords[a * texCoordDim + i] - mesh.mTexCoords[b * texCoordDim + i];
+            distance2 += d * d;
+        }
+        return distance2;
+    };
+
+    // Wedge of rep 'to' with the closest attributes to wedge w
+    auto closestWedge = [&](uint32_t w, uint32_t to, double* pDistance2) -> uint32_t {
+        uint32_t bestWedge     = firstWedges[to];
+        double   bestDistance2 = attributeDistance2(w, bestWedge);
+        for (uint32_t candidate = nextWedges[bestWedge]; candidate != kInvalidIndex; candidate = nextWedges[candidate]) {
+            const double distance2 = attributeDistance2(w, candidate);
+            if (distance2 < bestDistance2) {
+                bestDistance2 = distance2;
+                bestWedge     = candidate;
+            }
+        }
+        if (!IsNull(pDistance2)) {
+            *pDistance2 = bestDistance2;
+        }
+        return bestWedge;
+    };
+
+    // Triangle plane quadrics, area weighted
+    std::vector<Quadric> quadrics(vertexCount);
+    for (size_t i = 0; i < indices.size(); i += 3) {
+        const uint32_t r0 = positionReps[indices[i + 0]];
+        const uint32_t r1 = positionReps[indices[i + 1]];
+        const uint32_t r2 = positionReps[indices[i + 2]];
+        const float3   n  = glm::cross(pPositions[r1] - pPositions[r0], pPositions[r2] - pPositions[r0]);
+        const float    l  = glm::length(n);
+        if (l > 0.0f) {
+            const Quadric q = PlaneQuadric(n / l, pPositions[r0], 0.5 * l);
+            quadrics[r0] += q;
+            quadrics[r1] += q;
+            quadrics[r2] += q;
+        }
+    }
+
+    // Border edges are only used by one triangle
+    std::vector<bool> locked(vertexCount, false);
+    {
+        std::vector<std::pair<uint64_t, uint32_t>> edges;
+        edges.reserve(indices.size());
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const uint32_t a = positionReps[indices[i]];
+            const uint32_t b = positionReps[indices[(i % 3 == 2) ? (i - 2) : (i + 1)]];
+            const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+            edges.push_back({key, static_cast<uint32_t>(i)});
+        }
+        std::sort(edges.begin(), edges.end());
+
+        for (size_t i = 0; i < edges.size(); ++i) {
+            const bool shared = ((i > 0) && (edges[i - 1].first == edges[i].first)) || ((i + 1 < edges.size()) && (edges[i + 1].first == edges[i].first));
+            if (shared) {
+                continue;
+            }
+
+            const uint32_t corner = edges[i].second;
+            const uint32_t tri    = corner - (corner % 3);
+            const uint32_t a      = positionReps[indices[corner]];
+            const uint32_t b      = positionReps[indices[(corner % 3 == 2) ? tri : (corner + 1)]];
+            const uint32_t c      = positionReps[indices[tri + ((corner % 3 + 2) % 3)]];
+            if (options.lockBorders) {
+                locked[a] = true;
+                locked[b] = true;
+                continue;
+            }
+
+            const float3 edge   = pPositions[b] - pPositions[a];
+            const float3 normal = glm::cross(edge, pPositions[c] - pPositions[a]);
+            const float3 plane  = glm::cross(edge, normal);
+            const float  l      = glm::length(plane);
+            if (l > 0.0f) {
+                const Quadric q = PlaneQuadric(plane / l, pPositions[a], kBorderQuadricWeight * glm::dot(edge, edge));
+                quadrics[a] += q;
+                quadrics[b] += q;
+            }
+        }
+    }
+
+    const size_t targetIndexCount = options.targetIndexCount;
+
+    std::vector<uint32_t>          wedgeRemap(vertexCount);
+    std::vector<uint32_t>          adjacencyOffsets(vertexCount + 1);
+    std::vector<uint32_t>          adjacency;
+    std::vector<bool>              touched(vertexCount);
+    std::vector<CollapseCandidate> candidates;
+    std::vector<float>             vertexErrors(vertexCount, 0.0f);
+    float                          resultError = 0;
+
+    // Each pass collapses a batch of independent edges in cost order
+    while (indices.size() > targetIndexCount) {
+        const uint32_t triangleCount = CountU32(indices) / 3;
+
+        // Triangles around each rep
+        std::fill(adjacencyOffsets.begin(), adjacencyOffsets.end(), 0);
+        for (uint32_t index : indices) {
+            adjacencyOffsets[positionReps[index] + 1] += 1;
+        }
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+        }
+        adjacency.resize(indices.size());
+        {
+            std::vector<uint32_t> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+            for (uint32_t t = 0; t < triangleCount; ++t) {
+                for (uint32_t j = 0; j < 3; ++j) {
+                    adjacency[cursors[positionReps[indices[3 * t + j]]]++] = t;
+                }
+            }
+        }
+
+        // Both directions of every edge are candidates
+        candidates.clear();
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const uint32_t a = positionReps[indices[i]];
+            const uint32_t b = positionReps[indices[(i % 3 == 2) ? (i - 2) : (i + 1)]];
+            if (a != b) {
+                candidates.push_back({a, b, 0});
+                candidates.push_back({b, a, 0});
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(), [](const CollapseCandidate& lhs, const CollapseCandidate& rhs) {
+            return (lhs.from != rhs.from) ? (lhs.from < rhs.from) : (lhs.to < rhs.to);
+        });
+        candidates.erase(std::unique(candidates.begin(), candidates.end(), [](const CollapseCandidate& lhs, const CollapseCandidate& rhs) {
+                             return (lhs.from == rhs.from) && (lhs.to == rhs.to);
+                         }),
+                         candidates.end());
+
+        for (CollapseCandidate& candidate : candidates) {
+            if (locked[candidate.from]) {
+                candidate.cost = -1.0;
+                continue;
+            }
+
+            Quadric q = quadrics[candidate.from];
+            q += quadrics[candidate.to];
+            candidate.cost = EvaluateQuadric(q, pPositions[candidate.to]);
+
+            double attributeError = 0;
+            for (uint32_t w = firstWedges[candidate.from]; w != kInvalidIndex; w = nextWedges[w]) {
+                double distance2 = 0;
+                closestWedge(w, candidate.to, &distance2);
+                attributeError = std::max(attributeError, distance2);
+            }
+            // Both terms are squared object space distances
+            candidate.cost += attributeScale * attributeError;
+        }
+        candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [](const CollapseCandidate& c) { return c.cost < 0.0; }), candidates.end());
+        std::stable_sort(candidates.begin(), candidates.end(), [](const CollapseCandidate& lhs, const CollapseCandidate& rhs) { return lhs.cost < rhs.cost; });
+
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            wedgeRemap[v] = v;
+        }
+        std::fill(touched.begin(), touched.end(), false);
+
+        // A collapse removes about two triangles
+        const size_t trianglesToRemove = (indices.size() - targetIndexCount + 2) / 3;
+        size_t       trianglesRemoved  = 0;
+        uint32_t     collapseCount     = 0;
+
+        for (const CollapseCandidate& candidate : candidates) {
+            if (touched[candidate.from] || touched[candidate.to]) {
+                continue;
+            }
+
+            // Reject collapses that flip a triangle around 'from'. The
+            // triangles left around 'from' and 'to' are the new surface
+            // near 'from', its distance to them is the collapse's error.
+            const float3& fromPosition = pPositions[candidate.from];
+            float         distance     = FLT_MAX;
+            bool          flips        = false;
+            uint32_t      removed      = 0;
+            for (uint32_t k = adjacencyOffsets[candidate.from]; (k < adjacencyOffsets[candidate.from + 1]) && !flips; ++k) {
+                const uint32_t t    = adjacency[k];
+                uint32_t       r[3] = {positionReps[indices[3 * t + 0]], positionReps[indices[3 * t + 1]], positionReps[indices[3 * t + 2]]};
+                if ((r[0] == candidate.to) || (r[1] == candidate.to) || (r[2] == candidate.to)) {
+                    removed += 1;
+                    continue;
+                }
+
+                float3 p[3] = {pPositions[r[0]], pPositions[r[1]], pPositions[r[2]]};
+                float3 n0   = glm::cross(p[1] - p[0], p[2] - p[0]);
+                for (uint32_t j = 0; j < 3; ++j) {
+                    if (r[j] == candidate.from) {
+                        p[j] = pPositions[candidate.to];
+                    }
+                }
+                float3 n1 = glm::cross(p[1] - p[0], p[2] - p[0]);
+                flips     = (glm::dot(n0, n1) <= 0.0f);
+                distance  = std::min(distance, TriangleDistance(fromPosition, p[0], p[1], p[2]));
+            }
+            if (flips) {
+                continue;
+            }
+            for (uint32_t k = adjacencyOffsets[candidate.to]; k < adjacencyOffsets[candidate.to + 1]; ++k) {
+                const uint32_t t    = adjacency[k];
+                const uint32_t r[3] = {positionReps[indices[3 * t + 0]], positionReps[indices[3 * t + 1]], positionReps[indices[3 * t + 2]]};
+                if ((r[0] != candidate.from) && (r[1] != candidate.from) && (r[2] != candidate.from)) {
+                    distance = std::min(distance, TriangleDistance(fromPosition, pPositions[r[0]], pPositions[r[1]], pPositions[r[2]]));
+                }
+            }
+
+            // Vertices merged into 'from' earlier move with it. Their error
+            // is an estimate, the surface around them changes too.
+            const float collapseError = (distance == FLT_MAX) ? vertexErrors[candidate.from] : (vertexErrors[candidate.from] + distance);
+            if ((options.maxError >= 0.0f) && (collapseError > options.maxError)) {
+                continue;
+            }
+
+            // Move every wedge of 'from' to the closest wedge of 'to'
+            for (uint32_t w = firstWedges[candidate.from]; w != kInvalidIndex; w = nextWedges[w]) {
+                wedgeRemap[w] = closestWedge(w, candidate.to, nullptr);
+            }
+            quadrics[candidate.to] += quadrics[candidate.from];
+
+            // Everything around 'from' changes, keep it out of this pass
+            for (uint32_t k = adjacencyOffsets[candidate.from]; k < adjacencyOffsets[candidate.from + 1]; ++k) {
+                const uint32_t t = adjacency[k];
+                for (uint32_t j = 0; j < 3; ++j) {
+                    touched[positionReps[indices[3 * t + j]]] = true;
+                }
+            }
+            touched[candidate.to] = true;
+
+            vertexErrors[candidate.to] = std::max(vertexErrors[candidate.to], collapseError);
+            resultError                = std::max(resultError, collapseError);
+            trianglesRemoved += removed;
+            collapseCount += 1;
+            if (trianglesRemoved >= trianglesToRemove) {
+                break;
+            }
+        }
+
+        if (collapseCount == 0) {
+            break;
+        }
+
+        // Apply the collapses and drop degenerate triangles
+        size_t writeIndex = 0;
+        for (size_t i = 0; i < indices.size(); i += 3) {
+            const uint32_t i0 = wedgeRemap[indices[i + 0]];
+            const uint32_t i1 = wedgeRemap[indices[i + 1]];
+            const uint32_t i2 = wedgeRemap[indices[i + 2]];
+            const uint32_t r0 = positionReps[i0];
+            const uint32_t r1 = positionReps[i1];
+            const uint32_t r2 = positionReps[i2];
+            if ((r0 == r1) || (r1 == r2) || (r0 == r2)) {
+                continue;
+            }
+            indices[writeIndex++] = i0;
+            indices[writeIndex++] = i1;
+            indices[writeIndex++] = i2;
+        }
+        indices.resize(writeIndex);
+    }
+
+    // Compact the vertices still referenced, in order of first use
+    std::vector<uint32_t> remap(vertexCount, kInvalidIndex);
+    std::vector<uint32_t> sourceVertices;
+    for (uint32_t& index : indices) {
+        if (remap[index] == kInvalidIndex) {
+            remap[index] = CountU32(sourceVertices);
+            sourceVertices.push_back(index);
+        }
+        index = remap[index];
+    }
+
+    const grfx::IndexType indexType = (mesh.mIndexType == grfx::INDEX_TYPE_UNDEFINED) ? grfx::INDEX_TYPE_UINT32 : mesh.mIndexType;
+    TriMesh               simplified(indexType, mesh.mTexCoordDim);
+    if (indexType == grfx::INDEX_TYPE_UINT16) {
+        for (uint32_t index : indices) {
+            simplified.AppendIndexU16(static_cast<uint16_t>(index));
+        }
+    }
+    else {
+        for (uint32_t index : indices) {
+            simplified.AppendIndexU32(index);
+        }
+    }
+
+    simplified.mBoundingBoxMin = sourceVertices.empty() ? float3(0) : pPositions[sourceVertices[0]];
+    simplified.mBoundingBoxMax = simplified.mBoundingBoxMin;
+    for (uint32_t v : sourceVertices) {
+        simplified.mPositions.push_back(pPositions[v]);
+        simplified.mBoundingBoxMin = glm::min(simplified.mBoundingBoxMin, pPositions[v]);
+        simplified.mBoundingBoxMax = glm::max(simplified.mBoundingBoxMax, pPositions[v]);
+        if (!mesh.mColors.empty()) {
+            simplified.mColors.push_back(mesh.mColors[v]);
+        }
+        if (!mesh.mNormals.empty()) {
+            simplified.mNormals.push_back(mesh.mNormals[v]);
+        }
+        if (!mesh.mTexCoords.empty()) {
+            simplified.mTexCoords.insert(simplified.mTexCoords.end(), mesh.mTexCoords.begin() + v * texCoordDim, mesh.mTexCoords.begin() + (v + 1) * texCoordDim);
+        }
+        if (!mesh.mTangents.empty()) {
+            simplified.mTangents.push_back(mesh.mTangents[v]);
+        }
+        if (!mesh.mBitangents.empty()) {
+            simplified.mBitangents.push_back(mesh.mBitangents[v]);
+        }
+    }
+
+    *pSimplified = std::move(simplified);
+    if (!IsNull(pError)) {
+        *pError = resultError;
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result MeshSimplifier::CreateLODChain(const TriMesh& mesh, const MeshLODChainOptions& options, std::vector<MeshLOD>* pLODs)
+{
+    PPX_ASSERT_NULL_ARG(pLODs);
+
+    pLODs->clear();
+    pLODs->push_back({mesh, 0.0f});
+
+    for (uint32_t lodIndex = 1; lodIndex < options.maxLODCount; ++lodIndex) {
+        const MeshLOD& prev          = pLODs->back();
+        const uint32_t prevIndexCount = (prev.mesh.GetIndexType() == grfx::INDEX_TYPE_UNDEFINED) ? prev.mesh.GetCountPositions() : prev.mesh.GetCountIndices();
+        const float    prevError      = prev.error;
+
+        MeshSimplifierOptions simplifierOptions = {};
+        simplifierOptions.targetIndexCount      = static_cast<uint32_t>(static_cast<float>(prevIndexCount / 3) * options.reductionRatio) * 3;
+        simplifierOptions.maxError              = (options.maxError < 0.0f) ? -1.0f : std::max(options.maxError - prevError, 0.0f);
+        simplifierOptions.attributeWeight       = options.attributeWeight;
+        simplifierOptions.lockBorders           = options.lockBorders;
+
+        MeshLOD lod    = {};
+        float   error  = 0;
+        Result  ppxres = Simplify(prev.mesh, simplifierOptions, &lod.mesh, &error);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        const uint32_t indexCount = lod.mesh.GetCountIndices();
+        if ((indexCount == 0) || (static_cast<float>(indexCount) > (static_cast<float>(prevIndexCount) * options.minReductionRatio))) {
+            break;
+        }
+
+        // Errors are relative to the previous LOD, so they accumulate
+        lod.error = prevError + error;
+        pLODs->push_back(std::move(lod));
+    }
+
+    return ppx::SUCCESS;
+}
+
+float MeshSimplifier::ComputeScreenSpaceError(
+    const Camera&   camera,
+    const float4x4& modelMatrix,
+    const float3&   boundsMin,
+    const float3&   boundsMax,
+    float           objectError,
+    float           viewportHeight)
+{
+    const float scale = std::max(std::max(glm::length(float3(modelMatrix[0])), glm::length(float3(modelMatrix[1]))), glm::length(float3(modelMatrix[2])));
+
+    const float3 center      = float3(modelMatrix * float4((boundsMin + boundsMax) * 0.5f, 1.0f));
+    const float  radius      = 0.5f * glm::length(boundsMax - boundsMin) * scale;
+    const float  worldError  = objectError * scale;
+    const float  projScale   = std::abs(camera.GetProjectionMatrix()[1][1]);
+    const float  pixelsPerNdc = 0.5f * viewportHeight;
+
+    if (camera.GetCameraType() == CAMERA_TYPE_PERSPECTIVE) {
+        const float distance = std::max(glm::length(center - camera.GetEyePosition()) - radius, camera.GetNearClip());
+        return worldError * projScale * pixelsPerNdc / distance;
+    }
+
+    return worldError * projScale * pixelsPerNdc;
+}
+
+uint32_t MeshSimplifier::SelectLOD(
+    const Camera&               camera,
+    const float4x4&             modelMatrix,
+    const std::vector<MeshLOD>& lods,
+    float                       viewportHeight,
+    float                       maxPixelError)
+{
+    if (lods.empty()) {
+        return 0;
+    }
+
+    // All LODs share the bounds of the source mesh
+    const float3& boundsMin = lods[0].mesh.GetBoundingBoxMin();
+    const float3& boundsMax = lods[0].mesh.GetBoundingBoxMax();
+
+    uint32_t selected = 0;
+    for (uint32_t i = 1; i < CountU32(lods); ++i) {
+        const float pixelError = ComputeScreenSpaceError(camera, modelMatrix, boundsMin, boundsMax, lods[i].error, viewportHeight);
+        if (pixelError > maxPixelError) {
+            break;
+        }
+        selected = i;
+    }
+    return selected;
+}
+
+} // namespace ppx
@@ -0,0 +1,422 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/meshlet.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ppx {
+
+namespace {
+
+constexpr uint32_t kInvalidIndex = UINT32_MAX;
+
+// Cones wider than this (dot of the axis with the furthest normal) can't
+// cull anything useful and are stored as degenerate.
+constexpr float kMinConeDot = 0.1f;
+
+} // namespace
+
+// -------------------------------------------------------------------------------------------------
+// MeshletBuilder
+// -------------------------------------------------------------------------------------------------
+void MeshletBuilder::UnpackTriangle(uint32_t packed, uint32_t& i0, uint32_t& i1, uint32_t& i2)
+{
+    i0 = packed & 0xFF;
+    i1 = (packed >> 8) & 0xFF;
+    i2 = (packed >> 16) & 0xFF;
+}
+
+Result MeshletBuilder::Build(
+    const uint32_t*            pIndices,
+    uint32_t                   indexCount,
+    const float3*              pPositions,
+    uint32_t                   vertexCount,
+    const MeshletBuildOptions& options,
+    MeshletData*               pMeshletData)
+{
+    PPX_ASSERT_NULL_ARG(pMeshletData);
+
+    if ((options.maxVertices < 3) || (options.maxVertices > kMaxVertices) || (options.maxTriangles < 1) || (options.maxTriangles > kMaxTriangles)) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+    if ((indexCount % 3) != 0) {
+        return ppx::ERROR_UNEXPECTED_COUNT_VALUE;
+    }
+    if ((indexCount > 0) && (IsNull(pIndices) || IsNull(pPositions))) {
+        return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
+    }
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        if (pIndices[i] >= vertexCount) {
+            return ppx::ERROR_OUT_OF_RANGE;
+        }
+    }
+
+    *pMeshletData = MeshletData();
+
+    const uint32_t triangleCount = indexCount / 3;
+
+    // Vertex to triangle adjacency
+    std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32_t i = 0; i < indexCount; ++i) {
+        ++adjacencyOffsets[pIndices[i] + 1];
+    }
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        adjacencyOffsets[i + 1] += adjacencyOffsets[i];
+    }
+    std::vector<uint32_t> adjacency(indexCount);
+    {
+        std::vector<uint32_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (uint32_t i = 0; i < indexCount; ++i) {
+            adjacency[fill[pIndices[i]]++] = i / 3;
+        }
+    }
+
+    // Number of triangles not yet emitted per vertex, lets the candidate
+    // search skip vertices whose triangles are all used up.
+    std::vector<uint32_t> liveCounts(vertexCount);
+    for (uint32_t i = 0; i < vertexCount; ++i) {
+        liveCounts[i] = adjacencyOffsets[i + 1] - adjacencyOffsets[i];
+    }
+
+    std::vector<bool>     emitted(triangleCount, false);
+    std::vector<uint32_t> localIndices(vertexCount, kInvalidIndex);
+
+    Meshlet  meshlet  = {};
+    float3   centroid = float3(0);
+    uint32_t nextSeed = 0;
+
+    auto finishMeshlet = [&]() {
+        for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+            localIndices[pMeshletData->vertices[meshlet.vertexOffset + i]] = kInvalidIndex;
+        }
+        pMeshletData->meshlets.push_back(meshlet);
+
+        meshlet                = {};
+        meshlet.vertexOffset   = CountU32(pMeshletData->vertices);
+        meshlet.triangleOffset = CountU32(pMeshletData->triangles);
+        centroid               = float3(0);
+    };
+
+    auto countNewVertices = [&](uint32_t triangle) {
+        const uint32_t* pTri = pIndices + 3 * triangle;
+        return (localIndices[pTri[0]] == kInvalidIndex ? 1u : 0u) +
+               (localIndices[pTri[1]] == kInvalidIndex ? 1u : 0u) +
+               (localIndices[pTri[2]] == kInvalidIndex ? 1u : 0u);
+    };
+
+    // Unemitted triangle adjacent to the previous meshlet, keeps consecutive
+    // meshlets spatially coherent. Falls back to the next triangle in order.
+    auto findSeed = [&](const Meshlet& prev) {
+        for (uint32_t i = 0; i < prev.vertexCount; ++i) {
+            const uint32_t v = pMeshletData->vertices[prev.vertexOffset + i];
+            if (liveCounts[v] == 0) {
+                continue;
+            }
+            for (uint32_t j = adjacencyOffsets[v]; j < adjacencyOffsets[v + 1]; ++j) {
+                if (!emitted[adjacency[j]]) {
+                    return adjacency[j];
+                }
+            }
+        }
+        while ((nextSeed < triangleCount) && emitted[nextSeed]) {
+            ++nextSeed;
+        }
+        return (nextSeed < triangleCount) ? nextSeed : kInvalidIndex;
+    };
+
+    Meshlet  prevMeshlet  = {};
+    uint32_t emittedCount = 0;
+    while (emittedCount < triangleCount) {
+        uint32_t best = kInvalidIndex;
+
+        if (meshlet.triangleCount > 0) {
+            const float3 center       = centroid / static_cast<float>(meshlet.vertexCount);
+            uint32_t     bestNewCount = UINT32_MAX;
+            float        bestDistance = 0;
+            for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+                const uint32_t v = pMeshletData->vertices[meshlet.vertexOffset + i];
+                if (liveCounts[v] == 0) {
+                    continue;
+                }
+                for (uint32_t j = adjacencyOffsets[v]; j < adjacencyOffsets[v + 1]; ++j) {
+                    const uint32_t triangle = adjacency[j];
+                    if (emitted[triangle]) {
+                        continue;
+                    }
+
+                    const uint32_t newCount = countNewVertices(triangle);
+                    if ((meshlet.vertexCount + newCount > options.maxVertices) || (newCount > bestNewCount)) {
+                        continue;
+                    }
+
+                    const uint32_t* pTri     = pIndices + 3 * triangle;
+                    const float3    d        = (pPositions[pTri[0]] + pPositions[pTri[1]] + pPositions[pTri[2]]) / 3.0f - center;
+                    const float     distance = glm::dot(d, d);
+                    if ((newCount < bestNewCount) || (distance < bestDistance)) {
+                        best         = triangle;
+                        bestNewCount = newCount;
+                        bestDistance = distance;
+                    }
+                }
+            }
+
+            // Nothing adjacent fits, start a new meshlet
+            if (best == kInvalidIndex) {
+                prevMeshlet = meshlet;
+                finishMeshlet();
+            }
+        }
+
+        if (best == kInvalidIndex) {
+            best = findSeed(prevMeshlet);
+            PPX_ASSERT_MSG(best != kInvalidIndex, "meshlet seed search failed with triangles remaining");
+        }
+
+        // Add triangle
+        const uint32_t* pTri     = pIndices + 3 * best;
+        uint32_t        local[3] = {};
+        for (uint32_t i = 0; i < 3; ++i) {
+            const uint32_t v = pTri[i];
+            if (localIndices[v] == kInvalidIndex) {
+                localIndices[v] = meshlet.vertexCount++;
+                pMeshletData->vertices.push_back(v);
+                centroid += pPositions[v];
+            }
+            local[i] = localIndices[v];
+            --liveCounts[v];
+        }
+        pMeshletData->triangles.push_back(PackTriangle(local[0], local[1], local[2]));
+        emitted[best] = true;
+        ++meshlet.triangleCount;
+        ++emittedCount;
+
+        if (meshlet.triangleCount == options.maxTriangles) {
+            prevMeshlet = meshlet;
+            finishMeshlet();
+        }
+    }
+    if (meshlet.triangleCount > 0) {
+        finishMeshlet();
+    }
+
+    pMeshletData->bounds.reserve(pMeshletData->meshlets.size());
+    for (const Meshlet& m : pMeshletData->meshlets) {
+        pMeshletData->bounds.push_back(ComputeBounds(*pMeshletData, m, pPositions));
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result MeshletBuilder::Build(const TriMesh& mesh, const MeshletBuildOptions& options, MeshletData* pMeshletData)
+{
+    std::vector<uint32_t> indices(3 * mesh.GetCountTriangles());
+    for (uint32_t i = 0; i < mesh.GetCountTriangles(); ++i) {
+        Result ppxres = mesh.GetTriangle(i, indices[3 * i + 0], indices[3 * i + 1], indices[3 * i + 2]);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+    }
+
+    return Build(indices.data(), CountU32(indices), mesh.GetDataPositions(), mesh.GetCountPositions(), options, pMeshletData);
+}
+
+MeshletBounds MeshletBuilder::ComputeBounds(
+    const MeshletData& meshletData,
+    const Meshlet&     meshlet,
+    const float3*      pPositions)
+{
+    MeshletBounds bounds = {};
+    if (meshlet.vertexCount == 0) {
+        return bounds;
+    }
+
+    const uint32_t* pVertices = meshletData.vertices.data() + meshlet.vertexOffset;
+
+    // Sphere around the box center, looser than a minimal sphere but stable
+    float3 boxMin = pPositions[pVertices[0]];
+    float3 boxMax = boxMin;
+    for (uint32_t i = 1; i < meshlet.vertexCount; ++i) {
+        boxMin = glm::min(boxMin, pPositions[pVertices[i]]);
+        boxMax = glm::max(boxMax, pPositions[pVertices[i]]);
+    }
+    bounds.center = (boxMin + boxMax) * 0.5f;
+    for (uint32_t i = 0; i < meshlet.vertexCount; ++i) {
+        bounds.radius = std::max(bounds.radius, glm::length(pPositions[pVertices[i]] - bounds.center));
+    }
+
+    // Normal cone
+    std::vector<float3> normals;
+    std::vector<float3> corners;
+    normals.reserve(meshlet.triangleCount);
+    corners.reserve(meshlet.triangleCount);
+    float3 normalSum = float3(0);
+    for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+        uint32_t i0 = 0, i1 = 0, i2 = 0;
+        UnpackTriangle(meshletData.triangles[meshlet.triangleOffset + t], i0, i1, i2);
+        const float3& p0 = pPositions[pVertices[i0]];
+        const float3& p1 = pPositions[pVertices[i1]];
+        const float3& p2 = pPositions[pVertices[i2]];
+
+        const float3 n      = glm::cross(p1 - p0, p2 - p0);
+        const float  length = glm::length(n);
+        if (length == 0) {
+            continue;
+        }
+        normals.push_back(n / length);
+        corners.push_back(p0);
+        normalSum += n / length;
+    }
+
+    const float sumLength = glm::length(normalSum);
+    if (normals.empty() || (sumLength == 0)) {
+        return bounds;
+    }
+    const float3 axis = normalSum / sumLength;
+
+    float minDot = 1.0f;
+    for (const float3& n : normals) {
+        minDot = std::min(minDot, glm::dot(axis, n));
+    }
+    if (minDot < kMinConeDot) {
+        return bounds;
+    }
+
+    // Move the apex back along the axis until every triangle's plane is in
+    // front of it, so the cone test is conservative for all of them.
+    float maxT = 0;
+    for (size_t i = 0; i < normals.size(); ++i) {
+        const float t = glm::dot(bounds.center - corners[i], normals[i]) / glm::dot(axis, normals[i]);
+        maxT          = std::max(maxT, t);
+    }
+
+    bounds.coneAxis   = axis;
+    bounds.coneCutoff = std::sqrt(1.0f - minDot * minDot);
+    bounds.coneApex   = bounds.center - axis * maxT;
+
+    return bounds;
+}
+
+// -------------------------------------------------------------------------------------------------
+// MeshletCuller
+// -------------------------------------------------------------------------------------------------
+void MeshletCuller::ExtractFrustumPlanes(const float4x4& matrix, float4* pPlanes)
+{
+    PPX_ASSERT_NULL_ARG(pPlanes);
+
+    auto row = [&matrix](int i) { return float4(matrix[0][i], matrix[1][i], matrix[2][i], matrix[3][i]); };
+
+    const float4 r0 = row(0);
+    const float4 r1 = row(1);
+    const float4 r2 = row(2);
+    const float4 r3 = row(3);
+
+    pPlanes[0] = r3 + r0; // Left
+    pPlanes[1] = r3 - r0; // Right
+    pPlanes[2] = r3 + r1; // Bottom
+    pPlanes[3] = r3 - r1; // Top
+    pPlanes[4] = r2;      // Near
+    pPlanes[5] = r3 - r2; // Far
+
+    for (uint32_t i = 0; i < 6; ++i) {
+        const float length = glm::length(float3(pPlanes[i]));
+        if (length > 0) {
+            pPlanes[i] /= length;
+        }
+    }
+}
+
+bool MeshletCuller::IsSphereOutsideFrustum(const float4* pPlanes, const float3& center, float radius)
+{
+    for (uint32_t i = 0; i < 6; ++i) {
+        if (glm::dot(float3(pPlanes[i]), center) + pPlanes[i].w < -radius) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MeshletCuller::IsConeBackfacing(const MeshletBounds& bounds, const float3& cameraPosition)
+{
+    if (bounds.coneCutoff >= 1.0f) {
+        return false;
+    }
+
+    const float3 view   = bounds.coneApex - cameraPosition;
+    const float  length = glm::length(view);
+    if (length == 0) {
+        return false;
+    }
+    return glm::dot(view / length, bounds.coneAxis) >= bounds.coneCutoff;
+}
+
+Result MeshletCuller::Cull(
+    const MeshletData&        meshletData,
+    const float4x4&           viewProjectionMatrix,
+    const float4x4&           modelMatrix,
+    const float3&             cameraPosition,
+    const MeshletCullOptions& options,
+    std::vector<uint32_t>*    pVisibleMeshlets,
+    MeshletCullStatistics*    pStatistics)
+{
+    PPX_ASSERT_NULL_ARG(pVisibleMeshlets);
+
+    if (meshletData.bounds.size() != meshletData.meshlets.size()) {
+        return ppx::ERROR_BAD_DATA_SOURCE;
+    }
+
+    float4 planes[6] = {};
+    ExtractFrustumPlanes(viewProjectionMatrix * modelMatrix, planes);
+
+    const float3 objectCameraPosition = float3(glm::inverse(modelMatrix) * float4(cameraPosition, 1.0f));
+
+    MeshletCullStatistics stats = {};
+    stats.meshletCount          = meshletData.GetMeshletCount();
+
+    pVisibleMeshlets->clear();
+    for (uint32_t i = 0; i < stats.meshletCount; ++i) {
+        const MeshletBounds& bounds = meshletData.bounds[i];
+        if (options.enableFrustumCulling && IsSphereOutsideFrustum(planes, bounds.center, bounds.radius)) {
+            ++stats.frustumCulledCount;
+            continue;
+        }
+        if (options.enableBackfaceCulling && IsConeBackfacing(bounds, objectCameraPosition)) {
+            ++stats.backfaceCulledCount;
+            continue;
+        }
+        pVisibleMeshlets->push_back(i);
+        ++stats.visibleCount;
+        stats.visibleTriangles += meshletData.meshlets[i].triangleCount;
+    }
+
+    if (!IsNull(pStatistics)) {
+        *pStatistics = stats;
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result MeshletCuller::Cull(
+    const MeshletData&        meshletData,
+    const Camera&             camera,
+    const float4x4&           modelMatrix,
+    const MeshletCullOptions& options,
+    std::vector<uint32_t>*    pVisibleMeshlets,
+    MeshletCullStatistics*    pStatistics)
+{
+    return Cull(meshletData, camera.GetViewProjectionMatrix(), modelMatrix, camera.GetEyePosition(), options, pVisibleMeshlets, pStatistics);
+}
+
+} // namespace ppx
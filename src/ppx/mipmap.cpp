@@ -120,7 +120,7 @@ Mipmap::Mipmap(const Bitmap& bitmap, uint32_t levelCount)
 {
 }
 
-Mipmap::Mipmap(const Bitmap& bitmap, uint32_t levelCount, bool useStaticPool)
+Mipmap::Mipmap(const Bitmap& bitmap, uint32_t levelCount, bool useStaticPool, bool sRGB)
     : Mipmap(bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetFormat(), levelCount, useStaticPool)
 {
     Bitmap* pMip0 = GetMip(0);
@@ -132,13 +132,13 @@ Mipmap::Mipmap(const Bitmap& bitmap, uint32_t levelCount, bool useStaticPool)
         if ((srcSize > 0) && (srcSize == dstSize) && !IsNull(pSrcData) && !IsNull(pDstData)) {
             memcpy(pDstData, pSrcData, srcSize);
 
-            // Generate mip
-            for (uint32_t level = 1; level < levelCount; ++level) {
+            // Generate mip, levelCount may be larger than the actual level count
+            for (uint32_t level = 1; level < GetLevelCount(); ++level) {
                 uint32_t prevLevel = level - 1;
                 Bitmap*  pPrevMip  = GetMip(prevLevel);
                 Bitmap*  pMip      = GetMip(level);
 
-                Result ppxres = pPrevMip->ScaleTo(pMip, STBIR_FILTER_BOX);
+                Result ppxres = pPrevMip->Downsample(pMip, sRGB);
                 if (Failed(ppxres)) {
                     mData.clear();
                     mMips.clear();
@@ -149,6 +149,45 @@ Mipmap::Mipmap(const Bitmap& bitmap, uint32_t levelCount, bool useStaticPool)
     }
 }
 
+Mipmap::Mipmap(const Mipmap& obj)
+    : mData(obj.mData),
+      mUseStaticPool(obj.mUseStaticPool)
+{
+    InternalCopyMips(obj);
+}
+
+Mipmap& Mipmap::operator=(const Mipmap& rhs)
+{
+    if (&rhs != this) {
+        mData          = rhs.mData;
+        mUseStaticPool = rhs.mUseStaticPool;
+        InternalCopyMips(rhs);
+    }
+    return *this;
+}
+
+void Mipmap::InternalCopyMips(const Mipmap& obj)
+{
+    // Copying the mips themselves would give each one its own storage, so
+    // create them again over the same offsets in this mipmap's storage.
+    const char* pSrcBase = obj.mUseStaticPool ? mStaticData.data() : obj.mData.data();
+    char*       pDstBase = mUseStaticPool ? mStaticData.data() : mData.data();
+
+    mMips.clear();
+    mMips.resize(obj.mMips.size());
+    for (size_t i = 0; i < obj.mMips.size(); ++i) {
+        const Bitmap& srcMip = obj.mMips[i];
+        size_t        offset = static_cast<size_t>(srcMip.GetData() - pSrcBase);
+
+        Result ppxres = Bitmap::Create(srcMip.GetWidth(), srcMip.GetHeight(), srcMip.GetFormat(), srcMip.GetRowStride(), pDstBase + offset, &mMips[i]);
+        if (Failed(ppxres)) {
+            mData.clear();
+            mMips.clear();
+            return;
+        }
+    }
+}
+
 bool Mipmap::IsOk() const
 {
     uint32_t levelCount = GetLevelCount();
@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include "ppx/ppm_export.h"
+#include "ppx/graphics_util.h"
 
 #include <filesystem>
 
@@ -136,4 +137,22 @@ Result ExportToPPM(std::ostream& outputStream, grfx::Format inputFormat, const v
     return SUCCESS;
 }
 
+Result ExportToPPM(const std::string& outputFilename, const BitmapView& bitmap)
+{
+    std::filesystem::create_directories(std::filesystem::path(outputFilename).parent_path());
+    std::ofstream file(outputFilename, std::ios::out | std::ios::binary | std::ios::trunc);
+    ppx::Result   result = ExportToPPM(file, bitmap);
+    file.close();
+    return result;
+}
+
+Result ExportToPPM(std::ostream& outputStream, const BitmapView& bitmap)
+{
+    grfx::Format format = grfx_util::ToGrfxFormat(bitmap.GetFormat());
+    if (format == grfx::FORMAT_UNDEFINED) {
+        return ERROR_PPM_EXPORT_FORMAT_NOT_SUPPORTED;
+    }
+    return ExportToPPM(outputStream, format, bitmap.GetData(), bitmap.GetWidth(), bitmap.GetHeight(), bitmap.GetRowStride());
+}
+
 } // namespace ppx
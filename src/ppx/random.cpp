@@ -0,0 +1,228 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/random.h"
+#include "ppx/bitmap.h"
+
+#include <atomic>
+#include <limits>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ppx {
+
+namespace {
+
+constexpr uint32_t kLaneCount = RandomLanes::kLaneCount;
+
+// Fills with fewer values than this stay on the calling thread
+constexpr uint64_t kParallelFillThreshold = 64 * 1024;
+
+// Multiple of the lane count and of every component count up to 4, so a
+// lane always writes the same component
+constexpr uint32_t kPatternSize = 24;
+
+// Calls fn(block) for each block in [0, blockCount). Blocks are spread
+// over threads for large fills, in no particular order.
+template <typename BlockFn>
+void ForEachBlock(uint64_t blockCount, uint64_t valueCount, BlockFn fn)
+{
+    uint32_t threadCount = 1;
+    if (valueCount >= kParallelFillThreshold) {
+        threadCount = static_cast<uint32_t>(std::min<uint64_t>(std::max(std::thread::hardware_concurrency(), 1u), blockCount));
+    }
+
+    std::atomic<uint64_t> nextBlock  = 0;
+    auto                  fillBlocks = [&]() {
+        for (uint64_t block = nextBlock++; block < blockCount; block = nextBlock++) {
+            fn(block);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < threadCount; ++i) {
+        threads.emplace_back(fillBlocks);
+    }
+    fillBlocks();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+template <typename ChannelType>
+void FillChannelRows(Bitmap* pBitmap, uint32_t firstChannel, uint32_t channelCount, const float* pA, const float* pB, uint64_t fillState)
+{
+    constexpr bool   kIsInteger    = std::is_integral_v<ChannelType>;
+    constexpr bool   kIsNormalized = std::is_same_v<ChannelType, uint8_t> || std::is_same_v<ChannelType, uint16_t>;
+    constexpr double kMaxValue     = kIsInteger ? static_cast<double>(std::numeric_limits<ChannelType>::max()) : 0.0;
+    constexpr float  kScale        = kIsNormalized ? static_cast<float>(kMaxValue) : 1.0f;
+
+    float offsets[4] = {};
+    float scales[4]  = {};
+    for (uint32_t c = 0; c < channelCount; ++c) {
+        offsets[c] = pA[c] * kScale;
+        scales[c]  = (pB[c] - pA[c]) * kScale;
+    }
+
+    const uint32_t width       = pBitmap->GetWidth();
+    const uint32_t pixelStride = pBitmap->GetChannelCount();
+
+    ForEachBlock(pBitmap->GetHeight(), static_cast<uint64_t>(width) * pBitmap->GetHeight() * channelCount, [&](uint64_t y) {
+        RandomLanes  lanes(fillState, y * kLaneCount);
+        ChannelType* pRow = reinterpret_cast<ChannelType*>(pBitmap->GetPixelAddress(0, static_cast<uint32_t>(y))) + firstChannel;
+
+        float    values[kPatternSize] = {};
+        uint32_t next                 = kPatternSize;
+        for (uint32_t x = 0; x < width; ++x) {
+            ChannelType* pPixel = pRow + static_cast<size_t>(x) * pixelStride;
+            for (uint32_t c = 0; c < channelCount; ++c) {
+                if (next == kPatternSize) {
+                    lanes.Float(values, kPatternSize);
+                    next = 0;
+                }
+                const float value = offsets[c] + scales[c] * values[next++];
+                if constexpr (kIsInteger) {
+                    double rounded = static_cast<double>(value) + 0.5;
+                    pPixel[c]      = static_cast<ChannelType>(std::min(std::max(rounded, 0.0), kMaxValue));
+                }
+                else {
+                    pPixel[c] = value;
+                }
+            }
+        }
+    });
+}
+
+} // namespace
+
+uint64_t Random::NextFillState()
+{
+    const uint64_t high = mRng.nextUInt();
+    const uint64_t low  = mRng.nextUInt();
+    return (high << 32) | low;
+}
+
+void Random::FillComponents(float* pValues, size_t count, uint32_t componentCount, const float* pA, const float* pB)
+{
+    PPX_ASSERT_MSG((componentCount > 0) && (kPatternSize % componentCount == 0), "unsupported component count");
+
+    const uint64_t fillState = NextFillState();
+    if (count == 0) {
+        return;
+    }
+    PPX_ASSERT_NULL_ARG(pValues);
+
+    // Offset and scale of the component each value of a pattern is for
+    float offsets[kPatternSize] = {};
+    float scales[kPatternSize]  = {};
+    for (uint32_t i = 0; i < kPatternSize; ++i) {
+        offsets[i] = pA[i % componentCount];
+        scales[i]  = pB[i % componentCount] - pA[i % componentCount];
+    }
+
+    const uint64_t valueCount      = static_cast<uint64_t>(count) * componentCount;
+    const uint64_t blockValueCount = static_cast<uint64_t>(kFillBlockSize) * componentCount;
+    const uint64_t blockCount      = (count + kFillBlockSize - 1) / kFillBlockSize;
+
+    ForEachBlock(blockCount, valueCount, [&](uint64_t block) {
+        RandomLanes    lanes(fillState, block * kLaneCount);
+        float*         pDst     = pValues + block * blockValueCount;
+        const uint64_t endValue = std::min(blockValueCount, valueCount - block * blockValueCount);
+
+        // Blocks hold whole elements, so they start at pattern 0
+        uint64_t i = 0;
+        for (; i + kPatternSize <= endValue; i += kPatternSize) {
+            lanes.Float(pDst + i, kPatternSize);
+            for (uint32_t j = 0; j < kPatternSize; ++j) {
+                pDst[i + j] = offsets[j] + scales[j] * pDst[i + j];
+            }
+        }
+        if (i < endValue) {
+            float values[kPatternSize] = {};
+            lanes.Float(values, kPatternSize);
+            for (uint32_t j = 0; i + j < endValue; ++j) {
+                pDst[i + j] = offsets[j] + scales[j] * values[j];
+            }
+        }
+    });
+}
+
+void Random::Fill(float* pValues, size_t count, float a, float b)
+{
+    FillComponents(pValues, count, 1, &a, &b);
+}
+
+void Random::Fill(float2* pValues, size_t count, const float2& a, const float2& b)
+{
+    FillComponents(reinterpret_cast<float*>(pValues), count, 2, &a[0], &b[0]);
+}
+
+void Random::Fill(float3* pValues, size_t count, const float3& a, const float3& b)
+{
+    FillComponents(reinterpret_cast<float*>(pValues), count, 3, &a[0], &b[0]);
+}
+
+void Random::Fill(float4* pValues, size_t count, const float4& a, const float4& b)
+{
+    FillComponents(reinterpret_cast<float*>(pValues), count, 4, &a[0], &b[0]);
+}
+
+Result Random::FillChannels(Bitmap* pBitmap, uint32_t firstChannel, uint32_t channelCount, const float* pA, const float* pB)
+{
+    PPX_ASSERT_NULL_ARG(pBitmap);
+
+    const uint64_t fillState = NextFillState();
+    if (!pBitmap->IsOk()) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    switch (Bitmap::ChannelDataType(pBitmap->GetFormat())) {
+        default: {
+            return ppx::ERROR_IMAGE_INVALID_FORMAT;
+        }
+        case Bitmap::DATA_TYPE_UINT8: {
+            FillChannelRows<uint8_t>(pBitmap, firstChannel, channelCount, pA, pB, fillState);
+        } break;
+        case Bitmap::DATA_TYPE_UINT16: {
+            FillChannelRows<uint16_t>(pBitmap, firstChannel, channelCount, pA, pB, fillState);
+        } break;
+        case Bitmap::DATA_TYPE_UINT32: {
+            FillChannelRows<uint32_t>(pBitmap, firstChannel, channelCount, pA, pB, fillState);
+        } break;
+        case Bitmap::DATA_TYPE_FLOAT: {
+            FillChannelRows<float>(pBitmap, firstChannel, channelCount, pA, pB, fillState);
+        } break;
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result Random::Fill(Bitmap* pBitmap, const float4& a, const float4& b)
+{
+    PPX_ASSERT_NULL_ARG(pBitmap);
+    return FillChannels(pBitmap, 0, pBitmap->GetChannelCount(), &a[0], &b[0]);
+}
+
+Result Random::FillChannel(Bitmap* pBitmap, uint32_t channel, float a, float b)
+{
+    PPX_ASSERT_NULL_ARG(pBitmap);
+    if (channel >= pBitmap->GetChannelCount()) {
+        return ppx::ERROR_OUT_OF_RANGE;
+    }
+    return FillChannels(pBitmap, channel, 1, &a, &b);
+}
+
+} // namespace ppx
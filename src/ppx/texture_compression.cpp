@@ -0,0 +1,919 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/texture_compression.h"
+#include "ppx/fs.h"
+#include "ppx/log.h"
+#include "ppx/mipmap.h"
+#include "ppx/timer.h"
+#include "gli/gli.hpp"
+#include "xxhash.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+namespace ppx {
+
+namespace {
+
+// Bump when the output of the encoders changes so stale cache files are ignored
+constexpr uint32_t kEncoderVersion = 1;
+
+// Below this many blocks, spinning up threads costs more than it saves
+constexpr uint64_t kParallelBlockThreshold = 64 * 64;
+constexpr uint32_t kMinBlockRowsPerBand    = 8;
+
+constexpr uint32_t kBlockDim = 4;
+
+// BC7 4-bit index interpolation weights, out of 64
+constexpr uint32_t kBC7Weights4[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+enum BlockEncoding
+{
+    BLOCK_ENCODING_UNDEFINED = 0,
+    BLOCK_ENCODING_BC1_RGB   = 1,
+    BLOCK_ENCODING_BC1_RGBA  = 2,
+    BLOCK_ENCODING_BC3       = 3,
+    BLOCK_ENCODING_BC4       = 4,
+    BLOCK_ENCODING_BC5       = 5,
+    BLOCK_ENCODING_BC7       = 6,
+};
+
+BlockEncoding GetBlockEncoding(grfx::Format format)
+{
+    // clang-format off
+    switch (format) {
+        default: break;
+        case grfx::FORMAT_BC1_RGB_UNORM  : return BLOCK_ENCODING_BC1_RGB;
+        case grfx::FORMAT_BC1_RGB_SRGB   : return BLOCK_ENCODING_BC1_RGB;
+        case grfx::FORMAT_BC1_RGBA_UNORM : return BLOCK_ENCODING_BC1_RGBA;
+        case grfx::FORMAT_BC1_RGBA_SRGB  : return BLOCK_ENCODING_BC1_RGBA;
+        case grfx::FORMAT_BC3_UNORM      : return BLOCK_ENCODING_BC3;
+        case grfx::FORMAT_BC3_SRGB       : return BLOCK_ENCODING_BC3;
+        case grfx::FORMAT_BC4_UNORM      : return BLOCK_ENCODING_BC4;
+        case grfx::FORMAT_BC5_UNORM      : return BLOCK_ENCODING_BC5;
+        case grfx::FORMAT_BC7_UNORM      : return BLOCK_ENCODING_BC7;
+        case grfx::FORMAT_BC7_SRGB       : return BLOCK_ENCODING_BC7;
+    }
+    // clang-format on
+    return BLOCK_ENCODING_UNDEFINED;
+}
+
+gli::format ToGliFormat(grfx::Format format)
+{
+    // clang-format off
+    switch (format) {
+        default: break;
+        case grfx::FORMAT_BC1_RGB_UNORM  : return gli::FORMAT_RGB_DXT1_UNORM_BLOCK8;
+        case grfx::FORMAT_BC1_RGB_SRGB   : return gli::FORMAT_RGB_DXT1_SRGB_BLOCK8;
+        case grfx::FORMAT_BC1_RGBA_UNORM : return gli::FORMAT_RGBA_DXT1_UNORM_BLOCK8;
+        case grfx::FORMAT_BC1_RGBA_SRGB  : return gli::FORMAT_RGBA_DXT1_SRGB_BLOCK8;
+        case grfx::FORMAT_BC3_UNORM      : return gli::FORMAT_RGBA_DXT5_UNORM_BLOCK16;
+        case grfx::FORMAT_BC3_SRGB       : return gli::FORMAT_RGBA_DXT5_SRGB_BLOCK16;
+        case grfx::FORMAT_BC4_UNORM      : return gli::FORMAT_R_ATI1N_UNORM_BLOCK8;
+        case grfx::FORMAT_BC5_UNORM      : return gli::FORMAT_RG_ATI2N_UNORM_BLOCK16;
+        case grfx::FORMAT_BC7_UNORM      : return gli::FORMAT_RGBA_BP_UNORM_BLOCK16;
+        case grfx::FORMAT_BC7_SRGB       : return gli::FORMAT_RGBA_BP_SRGB_BLOCK16;
+    }
+    // clang-format on
+    return gli::FORMAT_UNDEFINED;
+}
+
+uint32_t GetBlockByteSize(BlockEncoding encoding)
+{
+    switch (encoding) {
+        default: break;
+        case BLOCK_ENCODING_BC1_RGB:
+        case BLOCK_ENCODING_BC1_RGBA:
+        case BLOCK_ENCODING_BC4: return 8;
+        case BLOCK_ENCODING_BC3:
+        case BLOCK_ENCODING_BC5:
+        case BLOCK_ENCODING_BC7: return 16;
+    }
+    return 0;
+}
+
+// 4x4 RGBA pixels, row by row
+struct Block
+{
+    float pixels[16][4];
+};
+
+void LoadBlock(const BitmapView& bitmap, uint32_t blockX, uint32_t blockY, Block* pBlock)
+{
+    for (uint32_t i = 0; i < 16; ++i) {
+        // Edge blocks repeat the last column and row
+        const uint32_t x      = std::min(blockX * kBlockDim + (i % kBlockDim), bitmap.GetWidth() - 1);
+        const uint32_t y      = std::min(blockY * kBlockDim + (i / kBlockDim), bitmap.GetHeight() - 1);
+        const uint8_t* pPixel = reinterpret_cast<const uint8_t*>(bitmap.GetPixelAddress(x, y));
+        for (uint32_t c = 0; c < 4; ++c) {
+            pBlock->pixels[i][c] = static_cast<float>(pPixel[c]);
+        }
+    }
+}
+
+void WriteUint16(uint16_t value, uint8_t* pDst)
+{
+    pDst[0] = static_cast<uint8_t>(value & 0xFF);
+    pDst[1] = static_cast<uint8_t>(value >> 8);
+}
+
+void WriteUint32(uint32_t value, uint8_t* pDst)
+{
+    for (uint32_t i = 0; i < 4; ++i) {
+        pDst[i] = static_cast<uint8_t>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+// Writes fields LSB first, like the BC7 bit layout is specified
+class BlockBitWriter
+{
+public:
+    BlockBitWriter(uint8_t* pBlock)
+        : mBlock(pBlock) {}
+
+    void Write(uint32_t value, uint32_t bitCount)
+    {
+        for (uint32_t i = 0; i < bitCount; ++i, ++mBitOffset) {
+            if ((value >> i) & 1) {
+                mBlock[mBitOffset / 8] |= static_cast<uint8_t>(1 << (mBitOffset % 8));
+            }
+        }
+    }
+
+private:
+    uint8_t* mBlock     = nullptr;
+    uint32_t mBitOffset = 0;
+};
+
+// -------------------------------------------------------------------------------------------------
+// Endpoint search
+// -------------------------------------------------------------------------------------------------
+
+float DistanceSquared(const float* pA, const float* pB, uint32_t channelCount)
+{
+    float sum = 0;
+    for (uint32_t c = 0; c < channelCount; ++c) {
+        const float d = pA[c] - pB[c];
+        sum += d * d;
+    }
+    return sum;
+}
+
+// Picks the two endpoints of the line segment used to approximate the
+// points. FAST uses the bounding box diagonal, pulled in a little since the
+// extremes are rarely hit exactly. Other qualities use the principal axis
+// of the points, found by power iteration on their covariance matrix.
+void FindEndpoints(
+    const float (*pPoints)[4],
+    uint32_t                  pointCount,
+    uint32_t                  channelCount,
+    TextureCompressionQuality quality,
+    float                     endpoint0[4],
+    float                     endpoint1[4])
+{
+    float minValue[4] = {255, 255, 255, 255};
+    float maxValue[4] = {0, 0, 0, 0};
+    float mean[4]     = {0, 0, 0, 0};
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            minValue[c] = std::min(minValue[c], pPoints[i][c]);
+            maxValue[c] = std::max(maxValue[c], pPoints[i][c]);
+            mean[c] += pPoints[i][c] / pointCount;
+        }
+    }
+
+    if (quality == TEXTURE_COMPRESSION_QUALITY_FAST) {
+        uint32_t widest = 0;
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            const float inset = (maxValue[c] - minValue[c]) / 16.0f;
+            endpoint0[c]      = minValue[c] + inset;
+            endpoint1[c]      = maxValue[c] - inset;
+            if ((maxValue[c] - minValue[c]) > (maxValue[widest] - minValue[widest])) {
+                widest = c;
+            }
+        }
+        // Pick the diagonal that follows channels decreasing while the widest one increases
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            float correlation = 0;
+            for (uint32_t i = 0; i < pointCount; ++i) {
+                correlation += (pPoints[i][widest] - mean[widest]) * (pPoints[i][c] - mean[c]);
+            }
+            if (correlation < 0) {
+                std::swap(endpoint0[c], endpoint1[c]);
+            }
+        }
+        return;
+    }
+
+    float covariance[4][4] = {};
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        float d[4] = {};
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            d[c] = pPoints[i][c] - mean[c];
+        }
+        for (uint32_t a = 0; a < channelCount; ++a) {
+            for (uint32_t b = 0; b < channelCount; ++b) {
+                covariance[a][b] += d[a] * d[b];
+            }
+        }
+    }
+
+    // Start from the bounding box diagonal, which is usually close already
+    float axis[4] = {};
+    for (uint32_t c = 0; c < channelCount; ++c) {
+        axis[c] = maxValue[c] - minValue[c];
+    }
+    for (uint32_t iteration = 0; iteration < 8; ++iteration) {
+        float next[4]   = {};
+        float maxLength = 0;
+        for (uint32_t a = 0; a < channelCount; ++a) {
+            for (uint32_t b = 0; b < channelCount; ++b) {
+                next[a] += covariance[a][b] * axis[b];
+            }
+            maxLength = std::max(maxLength, std::fabs(next[a]));
+        }
+        if (maxLength == 0) {
+            break;
+        }
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            axis[c] = next[c] / maxLength;
+        }
+    }
+
+    float axisLengthSquared = 0;
+    for (uint32_t c = 0; c < channelCount; ++c) {
+        axisLengthSquared += axis[c] * axis[c];
+    }
+    if (axisLengthSquared == 0) {
+        // All points are the same
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            endpoint0[c] = mean[c];
+            endpoint1[c] = mean[c];
+        }
+        return;
+    }
+
+    // Extent of the points along the axis
+    float minT = 0;
+    float maxT = 0;
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        float t = 0;
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            t += (pPoints[i][c] - mean[c]) * axis[c];
+        }
+        t /= axisLengthSquared;
+        minT = std::min(minT, t);
+        maxT = std::max(maxT, t);
+    }
+    for (uint32_t c = 0; c < channelCount; ++c) {
+        endpoint0[c] = std::clamp(mean[c] + minT * axis[c], 0.0f, 255.0f);
+        endpoint1[c] = std::clamp(mean[c] + maxT * axis[c], 0.0f, 255.0f);
+    }
+}
+
+// Solves for the endpoints that minimize the squared error of the points
+// given where each one sits between the endpoints (0 is endpoint0, 1 is
+// endpoint1). Returns false if the system is degenerate, e.g. every point
+// uses the same palette entry.
+bool RefineEndpoints(
+    const float (*pPoints)[4],
+    const float* pWeights,
+    uint32_t     pointCount,
+    uint32_t     channelCount,
+    float        endpoint0[4],
+    float        endpoint1[4])
+{
+    float a       = 0;
+    float b       = 0;
+    float c       = 0;
+    float sum0[4] = {};
+    float sum1[4] = {};
+    for (uint32_t i = 0; i < pointCount; ++i) {
+        const float w1 = pWeights[i];
+        const float w0 = 1.0f - w1;
+        a += w0 * w0;
+        b += w0 * w1;
+        c += w1 * w1;
+        for (uint32_t ch = 0; ch < channelCount; ++ch) {
+            sum0[ch] += w0 * pPoints[i][ch];
+            sum1[ch] += w1 * pPoints[i][ch];
+        }
+    }
+
+    const float determinant = a * c - b * b;
+    if (std::fabs(determinant) < 1e-6f) {
+        return false;
+    }
+    for (uint32_t ch = 0; ch < channelCount; ++ch) {
+        endpoint0[ch] = std::clamp((c * sum0[ch] - b * sum1[ch]) / determinant, 0.0f, 255.0f);
+        endpoint1[ch] = std::clamp((a * sum1[ch] - b * sum0[ch]) / determinant, 0.0f, 255.0f);
+    }
+    return true;
+}
+
+// -------------------------------------------------------------------------------------------------
+// BC1 color block
+// -------------------------------------------------------------------------------------------------
+
+uint16_t PackRGB565(const float color[4])
+{
+    const uint32_t r = static_cast<uint32_t>(std::lround(color[0] * 31.0f / 255.0f));
+    const uint32_t g = static_cast<uint32_t>(std::lround(color[1] * 63.0f / 255.0f));
+    const uint32_t b = static_cast<uint32_t>(std::lround(color[2] * 31.0f / 255.0f));
+    return static_cast<uint16_t>((r << 11) | (g << 5) | b);
+}
+
+void UnpackRGB565(uint16_t value, float color[4])
+{
+    const uint32_t r = (value >> 11) & 0x1F;
+    const uint32_t g = (value >> 5) & 0x3F;
+    const uint32_t b = value & 0x1F;
+    color[0]         = static_cast<float>((r << 3) | (r >> 2));
+    color[1]         = static_cast<float>((g << 2) | (g >> 4));
+    color[2]         = static_cast<float>((b << 3) | (b >> 2));
+    color[3]         = 255.0f;
+}
+
+struct ColorBlock
+{
+    uint16_t color0  = 0;
+    uint16_t color1  = 0;
+    uint32_t indices = 0;
+    float    error   = 0;
+};
+
+// Picks the closest palette entry for each pixel. The order of the
+// endpoints selects the mode: color0 > color1 is 4-color mode, otherwise
+// it's 3-color mode, whose index 3 is transparent black.
+ColorBlock FitColorIndices(const Block& block, const bool* pTransparent, uint16_t color0, uint16_t color1, bool threeColorMode)
+{
+    if (threeColorMode ? (color0 > color1) : (color0 < color1)) {
+        std::swap(color0, color1);
+    }
+
+    ColorBlock result = {};
+    result.color0     = color0;
+    result.color1     = color1;
+
+    // Equal endpoints decode as 3-color mode, index 0 is the only safe choice
+    if (color0 == color1) {
+        float palette[4];
+        UnpackRGB565(color0, palette);
+        for (uint32_t i = 0; i < 16; ++i) {
+            if (!IsNull(pTransparent) && pTransparent[i]) {
+                result.indices |= 3u << (2 * i);
+                continue;
+            }
+            result.error += DistanceSquared(block.pixels[i], palette, 3);
+        }
+        return result;
+    }
+
+    float palette[4][4] = {};
+    UnpackRGB565(color0, palette[0]);
+    UnpackRGB565(color1, palette[1]);
+    uint32_t paletteSize = 4;
+    for (uint32_t c = 0; c < 3; ++c) {
+        if (threeColorMode) {
+            palette[2][c] = std::floor((palette[0][c] + palette[1][c]) / 2.0f);
+            paletteSize   = 3;
+        }
+        else {
+            palette[2][c] = std::floor((2.0f * palette[0][c] + palette[1][c] + 1.0f) / 3.0f);
+            palette[3][c] = std::floor((palette[0][c] + 2.0f * palette[1][c] + 1.0f) / 3.0f);
+        }
+    }
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        if (!IsNull(pTransparent) && pTransparent[i]) {
+            result.indices |= 3u << (2 * i);
+            continue;
+        }
+        uint32_t bestIndex = 0;
+        float    bestError = DistanceSquared(block.pixels[i], palette[0], 3);
+        for (uint32_t p = 1; p < paletteSize; ++p) {
+            const float error = DistanceSquared(block.pixels[i], palette[p], 3);
+            if (error < bestError) {
+                bestIndex = p;
+                bestError = error;
+            }
+        }
+        result.indices |= bestIndex << (2 * i);
+        result.error += bestError;
+    }
+    return result;
+}
+
+// Position of each BC1 index between color0 and color1
+float GetColorIndexWeight(uint32_t index, bool threeColorMode)
+{
+    constexpr float kFourColorWeights[4]  = {0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f};
+    constexpr float kThreeColorWeights[4] = {0.0f, 1.0f, 0.5f, 0.0f};
+    return threeColorMode ? kThreeColorWeights[index] : kFourColorWeights[index];
+}
+
+// Encodes the 8 byte BC1 color block. If allowTransparency is true, pixels
+// with alpha < 128 are encoded as transparent using 3-color mode.
+void EncodeColorBlock(const Block& block, TextureCompressionQuality quality, bool allowTransparency, uint8_t* pDst)
+{
+    bool     transparent[16] = {};
+    float    opaquePixels[16][4];
+    uint32_t opaqueCount = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        transparent[i] = allowTransparency && (block.pixels[i][3] < 128.0f);
+        if (!transparent[i]) {
+            std::memcpy(opaquePixels[opaqueCount++], block.pixels[i], sizeof(opaquePixels[0]));
+        }
+    }
+    const bool threeColorMode = (opaqueCount < 16);
+
+    ColorBlock result = {};
+    if (opaqueCount == 0) {
+        result.indices = 0xFFFFFFFF;
+    }
+    else {
+        float endpoint0[4] = {};
+        float endpoint1[4] = {};
+        FindEndpoints(opaquePixels, opaqueCount, 3, quality, endpoint0, endpoint1);
+        result = FitColorIndices(block, transparent, PackRGB565(endpoint0), PackRGB565(endpoint1), threeColorMode);
+
+        if (quality == TEXTURE_COMPRESSION_QUALITY_HIGH) {
+            for (uint32_t iteration = 0; (iteration < 2) && (result.error > 0); ++iteration) {
+                float weights[16];
+                for (uint32_t i = 0, j = 0; i < 16; ++i) {
+                    if (!transparent[i]) {
+                        weights[j++] = GetColorIndexWeight((result.indices >> (2 * i)) & 0x3, threeColorMode);
+                    }
+                }
+                // Weights are relative to color0/color1 after FitColorIndices() ordered them
+                if (!RefineEndpoints(opaquePixels, weights, opaqueCount, 3, endpoint0, endpoint1)) {
+                    break;
+                }
+                const ColorBlock refined = FitColorIndices(block, transparent, PackRGB565(endpoint0), PackRGB565(endpoint1), threeColorMode);
+                if (refined.error >= result.error) {
+                    break;
+                }
+                result = refined;
+            }
+        }
+    }
+
+    WriteUint16(result.color0, pDst);
+    WriteUint16(result.color1, pDst + 2);
+    WriteUint32(result.indices, pDst + 4);
+}
+
+// -------------------------------------------------------------------------------------------------
+// BC4 single channel block, also used for BC3 alpha and both BC5 channels
+// -------------------------------------------------------------------------------------------------
+
+struct ChannelBlock
+{
+    uint8_t  value0  = 0;
+    uint8_t  value1  = 0;
+    uint64_t indices = 0;
+    uint32_t error   = 0;
+};
+
+// value0 > value1 selects 8 interpolated values, otherwise 6 values plus 0 and 255
+ChannelBlock FitChannelIndices(const uint8_t values[16], uint8_t value0, uint8_t value1)
+{
+    int32_t palette[8] = {value0, value1};
+    if (value0 > value1) {
+        for (int32_t i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+        }
+    }
+    else {
+        for (int32_t i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    ChannelBlock result = {};
+    result.value0       = value0;
+    result.value1       = value1;
+    for (uint32_t i = 0; i < 16; ++i) {
+        uint32_t bestIndex = 0;
+        uint32_t bestError = UINT32_MAX;
+        for (uint32_t p = 0; p < 8; ++p) {
+            const int32_t  d     = static_cast<int32_t>(values[i]) - palette[p];
+            const uint32_t error = static_cast<uint32_t>(d * d);
+            if (error < bestError) {
+                bestIndex = p;
+                bestError = error;
+            }
+        }
+        result.indices |= static_cast<uint64_t>(bestIndex) << (3 * i);
+        result.error += bestError;
+    }
+    return result;
+}
+
+void EncodeChannelBlock(const Block& block, uint32_t channel, TextureCompressionQuality quality, uint8_t* pDst)
+{
+    uint8_t values[16];
+    uint8_t minValue = 255;
+    uint8_t maxValue = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        values[i] = static_cast<uint8_t>(block.pixels[i][channel]);
+        minValue  = std::min(minValue, values[i]);
+        maxValue  = std::max(maxValue, values[i]);
+    }
+
+    ChannelBlock result = FitChannelIndices(values, maxValue, minValue);
+
+    if ((quality != TEXTURE_COMPRESSION_QUALITY_FAST) && (result.error > 0)) {
+        // 6 value mode spends its range on the values between the extremes
+        uint8_t innerMin = 255;
+        uint8_t innerMax = 0;
+        for (uint32_t i = 0; i < 16; ++i) {
+            if ((values[i] != 0) && (values[i] != 255)) {
+                innerMin = std::min(innerMin, values[i]);
+                innerMax = std::max(innerMax, values[i]);
+            }
+        }
+        if (innerMin <= innerMax) {
+            const ChannelBlock candidate = FitChannelIndices(values, innerMin, innerMax);
+            if (candidate.error < result.error) {
+                result = candidate;
+            }
+        }
+    }
+
+    if ((quality == TEXTURE_COMPRESSION_QUALITY_HIGH) && (result.error > 0) && (maxValue > minValue)) {
+        // Extremes rarely land on the palette, search endpoints a little inside them
+        for (int32_t d0 = 0; d0 <= 3; ++d0) {
+            for (int32_t d1 = 0; d1 <= 3; ++d1) {
+                const int32_t value0 = maxValue - d0;
+                const int32_t value1 = minValue + d1;
+                if (value0 <= value1) {
+                    continue;
+                }
+                const ChannelBlock candidate = FitChannelIndices(values, static_cast<uint8_t>(value0), static_cast<uint8_t>(value1));
+                if (candidate.error < result.error) {
+                    result = candidate;
+                }
+            }
+        }
+    }
+
+    pDst[0] = result.value0;
+    pDst[1] = result.value1;
+    for (uint32_t i = 0; i < 6; ++i) {
+        pDst[2 + i] = static_cast<uint8_t>((result.indices >> (8 * i)) & 0xFF);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+// BC7
+// -------------------------------------------------------------------------------------------------
+
+// Mode 6: one subset, 7-bit RGBA endpoints with a p-bit each and 4-bit indices
+struct BC7Mode6Block
+{
+    uint32_t endpoints[2][4] = {}; // 7 bits
+    uint32_t pBits[2]        = {};
+    uint32_t indices[16]     = {};
+    float    error           = 0;
+};
+
+BC7Mode6Block FitBC7Mode6(const Block& block, const float endpoint0[4], const float endpoint1[4])
+{
+    BC7Mode6Block best = {};
+    best.error         = FLT_MAX;
+
+    // Try every p-bit combination, the shared low bit moves the endpoints
+    for (uint32_t pBits = 0; pBits < 4; ++pBits) {
+        BC7Mode6Block candidate = {};
+        candidate.pBits[0]      = pBits & 1;
+        candidate.pBits[1]      = pBits >> 1;
+
+        uint32_t decoded[2][4];
+        for (uint32_t c = 0; c < 4; ++c) {
+            const float endpoints[2] = {endpoint0[c], endpoint1[c]};
+            for (uint32_t e = 0; e < 2; ++e) {
+                const int32_t quantized   = static_cast<int32_t>(std::lround((endpoints[e] - candidate.pBits[e]) / 2.0f));
+                candidate.endpoints[e][c] = static_cast<uint32_t>(std::clamp(quantized, 0, 127));
+                decoded[e][c]             = (candidate.endpoints[e][c] << 1) | candidate.pBits[e];
+            }
+        }
+
+        float palette[16][4];
+        for (uint32_t p = 0; p < 16; ++p) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                palette[p][c] = static_cast<float>(((64 - kBC7Weights4[p]) * decoded[0][c] + kBC7Weights4[p] * decoded[1][c] + 32) >> 6);
+            }
+        }
+
+        for (uint32_t i = 0; (i < 16) && (candidate.error < best.error); ++i) {
+            uint32_t bestIndex = 0;
+            float    bestError = DistanceSquared(block.pixels[i], palette[0], 4);
+            for (uint32_t p = 1; p < 16; ++p) {
+                const float error = DistanceSquared(block.pixels[i], palette[p], 4);
+                if (error < bestError) {
+                    bestIndex = p;
+                    bestError = error;
+                }
+            }
+            candidate.indices[i] = bestIndex;
+            candidate.error += bestError;
+        }
+
+        if (candidate.error < best.error) {
+            best = candidate;
+        }
+    }
+    return best;
+}
+
+void EncodeBC7Block(const Block& block, TextureCompressionQuality quality, uint8_t* pDst)
+{
+    float endpoint0[4] = {};
+    float endpoint1[4] = {};
+    FindEndpoints(block.pixels, 16, 4, quality, endpoint0, endpoint1);
+
+    BC7Mode6Block result = FitBC7Mode6(block, endpoint0, endpoint1);
+
+    if (quality == TEXTURE_COMPRESSION_QUALITY_HIGH) {
+        for (uint32_t iteration = 0; (iteration < 2) && (result.error > 0); ++iteration) {
+            float weights[16];
+            for (uint32_t i = 0; i < 16; ++i) {
+                weights[i] = kBC7Weights4[result.indices[i]] / 64.0f;
+            }
+            if (!RefineEndpoints(block.pixels, weights, 16, 4, endpoint0, endpoint1)) {
+                break;
+            }
+            const BC7Mode6Block refined = FitBC7Mode6(block, endpoint0, endpoint1);
+            if (refined.error >= result.error) {
+                break;
+            }
+            result = refined;
+        }
+    }
+
+    // The anchor index is stored without its high bit, which must be 0
+    if (result.indices[0] >= 8) {
+        std::swap(result.endpoints[0], result.endpoints[1]);
+        std::swap(result.pBits[0], result.pBits[1]);
+        for (uint32_t i = 0; i < 16; ++i) {
+            result.indices[i] = 15 - result.indices[i];
+        }
+    }
+
+    std::memset(pDst, 0, 16);
+    BlockBitWriter writer(pDst);
+    writer.Write(1 << 6, 7);
+    for (uint32_t c = 0; c < 4; ++c) {
+        writer.Write(result.endpoints[0][c], 7);
+        writer.Write(result.endpoints[1][c], 7);
+    }
+    writer.Write(result.pBits[0], 1);
+    writer.Write(result.pBits[1], 1);
+    writer.Write(result.indices[0], 3);
+    for (uint32_t i = 1; i < 16; ++i) {
+        writer.Write(result.indices[i], 4);
+    }
+}
+
+// -------------------------------------------------------------------------------------------------
+
+void EncodeBlock(const Block& block, BlockEncoding encoding, TextureCompressionQuality quality, uint8_t* pDst)
+{
+    switch (encoding) {
+        default: break;
+        case BLOCK_ENCODING_BC1_RGB: EncodeColorBlock(block, quality, false, pDst); break;
+        case BLOCK_ENCODING_BC1_RGBA: EncodeColorBlock(block, quality, true, pDst); break;
+        case BLOCK_ENCODING_BC3: {
+            EncodeChannelBlock(block, 3, quality, pDst);
+            EncodeColorBlock(block, quality, false, pDst + 8);
+        } break;
+        case BLOCK_ENCODING_BC4: EncodeChannelBlock(block, 0, quality, pDst); break;
+        case BLOCK_ENCODING_BC5: {
+            EncodeChannelBlock(block, 0, quality, pDst);
+            EncodeChannelBlock(block, 1, quality, pDst + 8);
+        } break;
+        case BLOCK_ENCODING_BC7: EncodeBC7Block(block, quality, pDst); break;
+    }
+}
+
+// Splits block rows into bands and runs fn(firstRow, endRow) on each band,
+// the calling thread takes the first one.
+template <typename BandFn>
+void ForEachBlockRowBand(uint32_t blockRowCount, uint64_t blockCount, BandFn fn)
+{
+    uint32_t bandCount = 1;
+    if (blockCount >= kParallelBlockThreshold) {
+        bandCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), std::max(blockRowCount / kMinBlockRowsPerBand, 1u));
+    }
+
+    const uint32_t rowsPerBand = (blockRowCount + bandCount - 1) / bandCount;
+
+    std::vector<std::thread> threads;
+    for (uint32_t firstRow = rowsPerBand; firstRow < blockRowCount; firstRow += rowsPerBand) {
+        threads.emplace_back(fn, firstRow, std::min(firstRow + rowsPerBand, blockRowCount));
+    }
+    fn(0, std::min(rowsPerBand, blockRowCount));
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+uint64_t HashSourceFile(const std::filesystem::path& path)
+{
+    fs::File file;
+    if (!file.OpenMapped(path)) {
+        return 0;
+    }
+
+    if (file.IsMapped()) {
+        return XXH64(file.GetMappedData(), file.GetLength(), 0);
+    }
+
+    std::vector<char> data(file.GetLength());
+    if (file.Read(data.data(), data.size()) != data.size()) {
+        return 0;
+    }
+    return XXH64(data.data(), data.size(), 0);
+}
+
+} // namespace
+
+bool IsTextureCompressionFormatSupported(grfx::Format format)
+{
+    return GetBlockEncoding(format) != BLOCK_ENCODING_UNDEFINED;
+}
+
+Result CompressBitmap(
+    const BitmapView&         bitmap,
+    grfx::Format              format,
+    TextureCompressionQuality quality,
+    std::vector<char>*        pBlocks)
+{
+    PPX_ASSERT_NULL_ARG(pBlocks);
+
+    const BlockEncoding encoding = GetBlockEncoding(format);
+    if (encoding == BLOCK_ENCODING_UNDEFINED) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+    if (!bitmap.IsOk() || (bitmap.GetFormat() != Bitmap::FORMAT_RGBA_UINT8)) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    const uint32_t blockCountX   = (bitmap.GetWidth() + kBlockDim - 1) / kBlockDim;
+    const uint32_t blockCountY   = (bitmap.GetHeight() + kBlockDim - 1) / kBlockDim;
+    const uint32_t blockByteSize = GetBlockByteSize(encoding);
+    pBlocks->resize(static_cast<size_t>(blockCountX) * blockCountY * blockByteSize);
+
+    uint8_t* pData = reinterpret_cast<uint8_t*>(pBlocks->data());
+    ForEachBlockRowBand(blockCountY, static_cast<uint64_t>(blockCountX) * blockCountY, [&](uint32_t firstRow, uint32_t endRow) {
+        Block block;
+        for (uint32_t blockY = firstRow; blockY < endRow; ++blockY) {
+            uint8_t* pDst = pData + static_cast<size_t>(blockY) * blockCountX * blockByteSize;
+            for (uint32_t blockX = 0; blockX < blockCountX; ++blockX, pDst += blockByteSize) {
+                LoadBlock(bitmap, blockX, blockY, &block);
+                EncodeBlock(block, encoding, quality, pDst);
+            }
+        }
+    });
+
+    return ppx::SUCCESS;
+}
+
+Result CompressBitmapToDDS(
+    const Bitmap&                    bitmap,
+    const TextureCompressionOptions& options,
+    const std::filesystem::path&     path)
+{
+    if (!IsTextureCompressionFormatSupported(options.format)) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    const uint32_t width  = bitmap.GetWidth();
+    const uint32_t height = bitmap.GetHeight();
+    if ((width % kBlockDim != 0) || (height % kBlockDim != 0)) {
+        PPX_LOG_ERROR("Compressed texture width and height must be multiples of " << kBlockDim << ": " << path);
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    uint32_t levelCount = 0;
+    for (uint32_t w = width, h = height; (w >= kBlockDim) && (h >= kBlockDim) && (w % kBlockDim == 0) && (h % kBlockDim == 0); w /= 2, h /= 2) {
+        ++levelCount;
+    }
+
+    const bool sRGB   = (grfx::GetFormatDescription(options.format)->dataType == grfx::FORMAT_DATA_TYPE_SRGB);
+    Mipmap     mipmap = Mipmap(bitmap, levelCount, /* useStaticPool= */ false, sRGB);
+    if (!mipmap.IsOk()) {
+        return ppx::ERROR_FAILED;
+    }
+
+    gli::texture2d    texture(ToGliFormat(options.format), gli::extent2d(width, height), levelCount);
+    std::vector<char> blocks;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        Result ppxres = CompressBitmap(*mipmap.GetMip(level), options.format, options.quality, &blocks);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        if (blocks.size() != texture.size(level)) {
+            PPX_ASSERT_MSG(false, "compressed mip level size doesn't match the DDS level size");
+            return ppx::ERROR_FAILED;
+        }
+        std::memcpy(texture.data(0, 0, level), blocks.data(), blocks.size());
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    if (!gli::save_dds(texture, path.string())) {
+        return ppx::ERROR_IMAGE_FILE_SAVE_FAILED;
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result GetCompressedTextureFile(
+    const std::filesystem::path&     sourcePath,
+    const TextureCompressionOptions& options,
+    std::filesystem::path*           pCachePath)
+{
+    PPX_ASSERT_NULL_ARG(pCachePath);
+
+    if (!IsTextureCompressionFormatSupported(options.format)) {
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    // Source content and options both select the cache file
+    const uint64_t sourceHash = HashSourceFile(sourcePath);
+    if (sourceHash == 0) {
+        return ppx::ERROR_IMAGE_FILE_LOAD_FAILED;
+    }
+    const uint32_t hashedOptions[3] = {static_cast<uint32_t>(options.format), static_cast<uint32_t>(options.quality), kEncoderVersion};
+    const uint64_t optionsHash      = XXH64(hashedOptions, sizeof(hashedOptions), 0);
+    const uint64_t nameHash         = XXH64(&sourceHash, sizeof(sourceHash), optionsHash);
+
+    std::filesystem::path cacheDirectory = options.cacheDirectory;
+    if (cacheDirectory.empty()) {
+        cacheDirectory = fs::GetDefaultOutputDirectory() / "texture_cache";
+    }
+    std::ostringstream cacheFileName;
+    cacheFileName << sourcePath.stem().string() << "_" << std::hex << std::setw(16) << std::setfill('0') << nameHash << ".dds";
+    const std::filesystem::path cachePath = cacheDirectory / cacheFileName.str();
+
+    std::error_code ec;
+    if (std::filesystem::is_regular_file(cachePath, ec)) {
+        *pCachePath = cachePath;
+        return ppx::SUCCESS;
+    }
+
+    ScopedTimer timer("Texture compression of '" + sourcePath.string() + "'");
+
+    Bitmap bitmap;
+    Result ppxres = Bitmap::LoadFile(sourcePath, &bitmap);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+    if (bitmap.GetFormat() != Bitmap::FORMAT_RGBA_UINT8) {
+        // HDR sources would lose their range in these formats
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    // Write to a temporary file first so an interrupted run can't leave a
+    // truncated file that later runs would pick up
+    std::filesystem::path tempPath = cachePath;
+    tempPath += ".tmp";
+    ppxres = CompressBitmapToDDS(bitmap, options, tempPath);
+    if (Failed(ppxres)) {
+        std::filesystem::remove(tempPath, ec);
+        return ppxres;
+    }
+    std::filesystem::rename(tempPath, cachePath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
+        return ppx::ERROR_IMAGE_FILE_SAVE_FAILED;
+    }
+
+    PPX_LOG_INFO("Wrote compressed texture to cache: " << cachePath);
+    *pCachePath = cachePath;
+    return ppx::SUCCESS;
+}
+
+} // namespace ppx
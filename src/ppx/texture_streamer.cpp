@@ -0,0 +1,506 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "ppx/texture_streamer.h"
+#include "ppx/log.h"
+#include "ppx/grfx/grfx_buffer.h"
+#include "ppx/grfx/grfx_device.h"
+#include "ppx/grfx/grfx_image.h"
+#include "ppx/grfx/grfx_queue.h"
+#include "ppx/grfx/grfx_scope.h"
+#include "ppx/grfx/grfx_texture.h"
+#include "ppx/grfx/grfx_util.h"
+
+#include <cmath>
+#include <cstring>
+#include <queue>
+
+namespace ppx {
+
+void StreamedTexture::SetScreenSize(float width, float height)
+{
+    mDesiredLevel = TextureStreamer::CalculateMipLevel(mFile.GetWidth(), mFile.GetHeight(), width, height);
+}
+
+// -------------------------------------------------------------------------------------------------
+
+TextureStreamer::~TextureStreamer()
+{
+    Destroy();
+}
+
+Result TextureStreamer::Create(const TextureStreamerCreateInfo& createInfo)
+{
+    PPX_ASSERT_NULL_ARG(createInfo.pQueue);
+    PPX_ASSERT_MSG(IsNull(mCreateInfo.pQueue), "texture streamer already created");
+
+    mCreateInfo = createInfo;
+
+    const uint32_t workerThreadCount = std::max<uint32_t>(mCreateInfo.workerThreadCount, 1);
+    for (uint32_t i = 0; i < workerThreadCount; ++i) {
+        mWorkers.emplace_back(&TextureStreamer::WorkerThread, this);
+    }
+
+    return ppx::SUCCESS;
+}
+
+void TextureStreamer::Destroy()
+{
+    if (IsNull(mCreateInfo.pQueue)) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStopWorkers = true;
+    }
+    mWorkAvailable.notify_all();
+    for (std::thread& worker : mWorkers) {
+        worker.join();
+    }
+    mWorkers.clear();
+    mLoadRequests.clear();
+    mLoadResults.clear();
+    mStopWorkers      = false;
+    mPendingLoadCount = 0;
+
+    grfx::Device* pDevice = mCreateInfo.pQueue->GetDevice();
+    for (auto& texture : mTextures) {
+        if (texture->mTexture) {
+            pDevice->DestroyTexture(texture->mTexture);
+        }
+    }
+    mTextures.clear();
+
+    for (auto& retired : mRetiredTextures) {
+        pDevice->DestroyTexture(retired.texture);
+    }
+    mRetiredTextures.clear();
+
+    mCreateInfo = {};
+}
+
+uint32_t TextureStreamer::CalculateMipLevel(uint32_t textureWidth, uint32_t textureHeight, float screenWidth, float screenHeight)
+{
+    // Not visible, the coarsest level will do
+    if (!(screenWidth > 0.0f) || !(screenHeight > 0.0f)) {
+        return UINT32_MAX;
+    }
+
+    const float ratio = std::max(textureWidth / screenWidth, textureHeight / screenHeight);
+    if (ratio <= 1.0f) {
+        return 0;
+    }
+    return static_cast<uint32_t>(std::floor(std::log2(ratio)));
+}
+
+uint64_t TextureStreamer::GetResidentSize() const
+{
+    uint64_t size = 0;
+    for (auto& texture : mTextures) {
+        if (!texture->mRemoved) {
+            size += texture->GetResidentSize();
+        }
+    }
+    return size;
+}
+
+Result TextureStreamer::AddTexture(const std::filesystem::path& path, StreamedTexture** ppTexture)
+{
+    PPX_ASSERT_NULL_ARG(ppTexture);
+    PPX_ASSERT_MSG(!IsNull(mCreateInfo.pQueue), "texture streamer not created");
+
+    std::unique_ptr<StreamedTexture> texture(new StreamedTexture());
+
+    Ktx2File& file   = texture->mFile;
+    Result    ppxres = file.Open(path);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+    if ((file.GetDepth() != 1) || (file.GetArrayLayerCount() != 1) || (file.GetFaceCount() != 1)) {
+        PPX_LOG_ERROR("Only 2D KTX2 images without array layers or faces can be streamed: " << path);
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+
+    // Same level rules as grfx_util::CreateImageFromKtx2File()
+    const uint32_t blockWidth = grfx::GetFormatDescription(file.GetFormat())->blockWidth;
+    if ((file.GetWidth() % blockWidth != 0) || (file.GetHeight() % blockWidth != 0)) {
+        PPX_LOG_ERROR("Compressed textures width & height must be a multiple of the block size.");
+        return ppx::ERROR_IMAGE_INVALID_FORMAT;
+    }
+    uint32_t levelCount = 1;
+    while ((levelCount < file.GetLevelCount()) && (file.GetLevelWidth(levelCount) % blockWidth == 0) && (file.GetLevelHeight(levelCount) % blockWidth == 0)) {
+        ++levelCount;
+    }
+
+    texture->mImageSizes.resize(levelCount);
+    uint64_t imageSize = 0;
+    for (uint32_t level = levelCount; level-- > 0;) {
+        imageSize += file.GetLevelSize(level);
+        texture->mImageSizes[level] = imageSize;
+    }
+
+    texture->mTailLevel = levelCount - 1;
+    for (uint32_t level = 0; level < levelCount; ++level) {
+        if (std::max(file.GetLevelWidth(level), file.GetLevelHeight(level)) <= mCreateInfo.residentTailSize) {
+            texture->mTailLevel = level;
+            break;
+        }
+    }
+    texture->mTargetLevel = texture->mTailLevel;
+
+    // The tail is small, load it right away so the texture is usable
+    LoadResult load = {};
+    LoadLevels(LoadRequest{texture.get(), texture->mTailLevel}, &load);
+    if (Failed(load.result)) {
+        return load.result;
+    }
+    ppxres = UploadLevels(load);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    *ppTexture = texture.get();
+    mTextures.push_back(std::move(texture));
+
+    return ppx::SUCCESS;
+}
+
+void TextureStreamer::RemoveTexture(StreamedTexture* pTexture)
+{
+    PPX_ASSERT_NULL_ARG(pTexture);
+    pTexture->mRemoved = true;
+}
+
+void TextureStreamer::LoadLevels(const LoadRequest& request, LoadResult* pResult)
+{
+    const StreamedTexture* pTexture = request.pTexture;
+    const Ktx2File&        file     = pTexture->mFile;
+
+    pResult->pTexture = request.pTexture;
+    pResult->level    = request.level;
+    pResult->data.resize(static_cast<size_t>(pTexture->GetImageSize(request.level)));
+    pResult->levelOffsets.clear();
+
+    uint64_t offset = 0;
+    for (uint32_t level = request.level; level < pTexture->GetMipLevelCount(); ++level) {
+        const uint64_t levelSize = file.GetLevelSize(level);
+
+        pResult->result = file.ReadLevel(level, pResult->data.data() + offset, levelSize);
+        if (Failed(pResult->result)) {
+            return;
+        }
+        pResult->levelOffsets.push_back(offset);
+        offset += levelSize;
+    }
+}
+
+void TextureStreamer::WorkerThread()
+{
+    for (;;) {
+        LoadRequest request = {};
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWorkAvailable.wait(lock, [this] { return mStopWorkers || !mLoadRequests.empty(); });
+            if (mStopWorkers) {
+                return;
+            }
+            request = mLoadRequests.front();
+            mLoadRequests.pop_front();
+        }
+
+        LoadResult result = {};
+        LoadLevels(request, &result);
+
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLoadResults.push_back(std::move(result));
+    }
+}
+
+Result TextureStreamer::UploadLevels(const LoadResult& load)
+{
+    StreamedTexture* pTexture = load.pTexture;
+    const Ktx2File&  file     = pTexture->mFile;
+    grfx::Queue*     pQueue   = mCreateInfo.pQueue;
+
+    // Scoped destroy
+    grfx::ScopeDestroyer SCOPED_DESTROYER(pQueue->GetDevice());
+
+    // Row stride and texture offset alignment to handle DX's requirements
+    const grfx::FormatDesc* pDesc              = grfx::GetFormatDescription(file.GetFormat());
+    const uint32_t          rowStrideAlignment = grfx::IsDx12(pQueue->GetDevice()->GetApi()) ? PPX_D3D12_TEXTURE_DATA_PITCH_ALIGNMENT : 1;
+    const uint32_t          offsetAlignment    = grfx::IsDx12(pQueue->GetDevice()->GetApi()) ? PPX_D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT : 1;
+    const uint32_t          mipLevelCount      = pTexture->GetMipLevelCount() - load.level;
+
+    std::vector<grfx::BufferToImageCopyInfo> copyInfos(mipLevelCount);
+    uint64_t                                 bufferSize = 0;
+    for (uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel) {
+        const uint32_t width        = file.GetLevelWidth(load.level + mipLevel);
+        const uint32_t height       = file.GetLevelHeight(load.level + mipLevel);
+        const uint32_t rowCopySize  = ((width + pDesc->blockWidth - 1) / pDesc->blockWidth) * pDesc->bytesPerTexel;
+        const uint32_t dstRowStride = RoundUp<uint32_t>(rowCopySize, rowStrideAlignment);
+        const uint32_t rowCount     = (height + pDesc->blockWidth - 1) / pDesc->blockWidth;
+
+        grfx::BufferToImageCopyInfo& copyInfo = copyInfos[mipLevel];
+        copyInfo.srcBuffer.imageWidth         = width;
+        copyInfo.srcBuffer.imageHeight        = height;
+        copyInfo.srcBuffer.imageRowStride     = dstRowStride;
+        copyInfo.srcBuffer.footprintOffset    = bufferSize;
+        copyInfo.srcBuffer.footprintWidth     = width;
+        copyInfo.srcBuffer.footprintHeight    = height;
+        copyInfo.srcBuffer.footprintDepth     = 1;
+        copyInfo.dstImage.mipLevel            = mipLevel;
+        copyInfo.dstImage.arrayLayer          = 0;
+        copyInfo.dstImage.arrayLayerCount     = 1;
+        copyInfo.dstImage.x                   = 0;
+        copyInfo.dstImage.y                   = 0;
+        copyInfo.dstImage.z                   = 0;
+        copyInfo.dstImage.width               = width;
+        copyInfo.dstImage.height              = height;
+        copyInfo.dstImage.depth               = 1;
+
+        bufferSize = RoundUp<uint64_t>(bufferSize + static_cast<uint64_t>(dstRowStride) * rowCount, offsetAlignment);
+    }
+
+    // Create staging buffer
+    grfx::BufferPtr stagingBuffer;
+    {
+        grfx::BufferCreateInfo ci      = {};
+        ci.size                        = bufferSize;
+        ci.usageFlags.bits.transferSrc = true;
+        ci.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
+
+        Result ppxres = pQueue->GetDevice()->CreateBuffer(&ci, &stagingBuffer);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        SCOPED_DESTROYER.AddObject(stagingBuffer);
+
+        // Map and copy to staging buffer
+        void* pBufferAddress = nullptr;
+        ppxres               = stagingBuffer->MapMemory(0, &pBufferAddress);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+
+        for (uint32_t mipLevel = 0; mipLevel < mipLevelCount; ++mipLevel) {
+            const grfx::BufferToImageCopyInfo& copyInfo    = copyInfos[mipLevel];
+            const uint32_t                     rowCopySize = ((copyInfo.dstImage.width + pDesc->blockWidth - 1) / pDesc->blockWidth) * pDesc->bytesPerTexel;
+            const uint32_t                     rowCount    = (copyInfo.dstImage.height + pDesc->blockWidth - 1) / pDesc->blockWidth;
+
+            const char* pSrc = load.data.data() + load.levelOffsets[mipLevel];
+            char*       pDst = static_cast<char*>(pBufferAddress) + copyInfo.srcBuffer.footprintOffset;
+            for (uint32_t row = 0; row < rowCount; ++row) {
+                memcpy(pDst, pSrc, rowCopySize);
+                pSrc += rowCopySize;
+                pDst += copyInfo.srcBuffer.imageRowStride;
+            }
+        }
+
+        stagingBuffer->UnmapMemory();
+    }
+
+    // Create target texture
+    grfx::TexturePtr targetTexture;
+    {
+        grfx::TextureCreateInfo ci     = {};
+        ci.pImage                      = nullptr;
+        ci.imageType                   = grfx::IMAGE_TYPE_2D;
+        ci.width                       = file.GetLevelWidth(load.level);
+        ci.height                      = file.GetLevelHeight(load.level);
+        ci.depth                       = 1;
+        ci.imageFormat                 = file.GetFormat();
+        ci.sampleCount                 = grfx::SAMPLE_COUNT_1;
+        ci.mipLevelCount               = mipLevelCount;
+        ci.arrayLayerCount             = 1;
+        ci.usageFlags.bits.transferDst = true;
+        ci.usageFlags.bits.sampled     = true;
+        ci.memoryUsage                 = grfx::MEMORY_USAGE_GPU_ONLY;
+        ci.initialState                = grfx::RESOURCE_STATE_SHADER_RESOURCE;
+        ci.ownership                   = grfx::OWNERSHIP_REFERENCE;
+
+        Result ppxres = pQueue->GetDevice()->CreateTexture(&ci, &targetTexture);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        SCOPED_DESTROYER.AddObject(targetTexture);
+    }
+
+    // Copy to GPU image
+    Result ppxres = pQueue->CopyBufferToImage(
+        copyInfos,
+        stagingBuffer,
+        targetTexture->GetImage(),
+        PPX_ALL_SUBRESOURCES,
+        grfx::RESOURCE_STATE_SHADER_RESOURCE,
+        grfx::RESOURCE_STATE_SHADER_RESOURCE);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    // Change ownership to reference so object doesn't get destroyed
+    targetTexture->SetOwnership(grfx::OWNERSHIP_REFERENCE);
+
+    // Swap in the new texture, the old one may still be in use by the GPU
+    RetireTexture(pTexture->mTexture);
+    pTexture->mTexture       = targetTexture;
+    pTexture->mResidentLevel = load.level;
+    pTexture->mVersion += 1;
+
+    return ppx::SUCCESS;
+}
+
+void TextureStreamer::RetireTexture(grfx::Texture* pTexture)
+{
+    if (!IsNull(pTexture)) {
+        mRetiredTextures.push_back(RetiredTexture{pTexture, mUpdateIndex});
+    }
+}
+
+void TextureStreamer::UpdateTargetLevels()
+{
+    // Start from the desired levels, a texture that failed to load stays
+    // where it is
+    uint64_t totalSize = 0;
+    for (auto& texture : mTextures) {
+        if (texture->mRemoved) {
+            continue;
+        }
+        texture->mTargetLevel = texture->mFailed ? texture->mResidentLevel : std::min(texture->mDesiredLevel, texture->mTailLevel);
+        totalSize += texture->GetImageSize(texture->mTargetLevel);
+    }
+    if (totalSize <= mCreateInfo.memoryBudget) {
+        return;
+    }
+
+    // Drop one level at a time from the largest texture
+    using Candidate = std::pair<uint64_t, StreamedTexture*>;
+    std::priority_queue<Candidate> candidates;
+    for (auto& texture : mTextures) {
+        if (!texture->mRemoved && !texture->mFailed && (texture->mTargetLevel < texture->mTailLevel)) {
+            candidates.push(Candidate(texture->GetImageSize(texture->mTargetLevel), texture.get()));
+        }
+    }
+    while ((totalSize > mCreateInfo.memoryBudget) && !candidates.empty()) {
+        StreamedTexture* pTexture = candidates.top().second;
+        candidates.pop();
+
+        totalSize -= pTexture->GetImageSize(pTexture->mTargetLevel);
+        pTexture->mTargetLevel += 1;
+        totalSize += pTexture->GetImageSize(pTexture->mTargetLevel);
+
+        if (pTexture->mTargetLevel < pTexture->mTailLevel) {
+            candidates.push(Candidate(pTexture->GetImageSize(pTexture->mTargetLevel), pTexture));
+        }
+    }
+}
+
+void TextureStreamer::ScheduleLoads()
+{
+    std::vector<StreamedTexture*> textures;
+    for (auto& texture : mTextures) {
+        bool idle = !texture->mRemoved && !texture->mFailed && (texture->mPendingLevel == StreamedTexture::kNoPendingLevel);
+        if (idle && (texture->mTargetLevel != texture->mResidentLevel)) {
+            textures.push_back(texture.get());
+        }
+    }
+
+    // Evictions free memory so they go first, then the textures furthest
+    // from their target
+    std::sort(textures.begin(), textures.end(), [](const StreamedTexture* pA, const StreamedTexture* pB) {
+        const bool evictA = (pA->mTargetLevel > pA->mResidentLevel);
+        const bool evictB = (pB->mTargetLevel > pB->mResidentLevel);
+        if (evictA != evictB) {
+            return evictA;
+        }
+        return (pA->mResidentLevel - pA->mTargetLevel) > (pB->mResidentLevel - pB->mTargetLevel);
+    });
+
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        for (StreamedTexture* pTexture : textures) {
+            if (mPendingLoadCount >= mCreateInfo.maxPendingLoadCount) {
+                break;
+            }
+            pTexture->mPendingLevel = pTexture->mTargetLevel;
+            mLoadRequests.push_back(LoadRequest{pTexture, pTexture->mTargetLevel});
+            mPendingLoadCount += 1;
+        }
+    }
+    mWorkAvailable.notify_all();
+}
+
+Result TextureStreamer::Update()
+{
+    PPX_ASSERT_MSG(!IsNull(mCreateInfo.pQueue), "texture streamer not created");
+
+    mUpdateIndex += 1;
+
+    // Destroy textures the GPU is done with
+    grfx::Device* pDevice = mCreateInfo.pQueue->GetDevice();
+    auto          retired = std::remove_if(mRetiredTextures.begin(), mRetiredTextures.end(), [this, pDevice](const RetiredTexture& retired) {
+        if (mUpdateIndex < retired.updateIndex + mCreateInfo.retireUpdateCount) {
+            return false;
+        }
+        pDevice->DestroyTexture(retired.texture);
+        return true;
+    });
+    mRetiredTextures.erase(retired, mRetiredTextures.end());
+
+    // Upload finished loads
+    std::vector<LoadResult> loads;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        while (!mLoadResults.empty() && (loads.size() < mCreateInfo.maxUploadsPerUpdate)) {
+            loads.push_back(std::move(mLoadResults.front()));
+            mLoadResults.pop_front();
+        }
+    }
+
+    Result ppxres = ppx::SUCCESS;
+    for (const LoadResult& load : loads) {
+        StreamedTexture* pTexture = load.pTexture;
+        pTexture->mPendingLevel   = StreamedTexture::kNoPendingLevel;
+        mPendingLoadCount -= 1;
+
+        // Drop loads that are no longer wanted or exceed the budget
+        if (pTexture->mRemoved || (load.level < pTexture->mTargetLevel) || (load.level == pTexture->mResidentLevel)) {
+            continue;
+        }
+
+        Result uploadResult = Failed(load.result) ? load.result : UploadLevels(load);
+        if (Failed(uploadResult)) {
+            PPX_LOG_ERROR("Failed to stream texture level " << load.level << " (" << ToString(uploadResult) << "), the texture keeps its resident levels");
+            pTexture->mFailed = true;
+            ppxres            = Success(ppxres) ? uploadResult : ppxres;
+        }
+    }
+
+    // Free removed textures once no load refers to them
+    auto removed = std::remove_if(mTextures.begin(), mTextures.end(), [this](const std::unique_ptr<StreamedTexture>& texture) {
+        if (!texture->mRemoved || (texture->mPendingLevel != StreamedTexture::kNoPendingLevel)) {
+            return false;
+        }
+        RetireTexture(texture->mTexture);
+        return true;
+    });
+    mTextures.erase(removed, mTextures.end());
+
+    UpdateTargetLevels();
+    ScheduleLoads();
+
+    return ppxres;
+}
+
+} // namespace ppx
@@ -13,11 +13,17 @@
 // limitations under the License.
 
 #include "ppx/tri_mesh.h"
+#include "ppx/binary_mesh.h"
 #include "ppx/math_util.h"
+#include "ppx/mesh_optimizer.h"
 #include "ppx/timer.h"
 #include "ppx/fs.h"
 
 #include "tiny_obj_loader.h"
+#include "xxhash.h"
+
+#include <iomanip>
+#include <sstream>
 
 namespace ppx {
 
@@ -148,7 +154,7 @@ uint64_t TriMesh::GetDataSizeTexCoords() const
 
 uint64_t TriMesh::GetDataSizeTangents() const
 {
-    uint64_t size = static_cast<uint64_t>(mTangents.size() * sizeof(float3));
+    uint64_t size = static_cast<uint64_t>(mTangents.size() * sizeof(float4));
     return size;
 }
 
@@ -514,7 +520,7 @@ Result TriMesh::GetVertexData(uint32_t vtxIndex, TriMeshVertexData* pVertexData)
     return ppx::SUCCESS;
 }
 
-void TriMesh::AppendIndexAndVertexData(
+Result TriMesh::AppendIndexAndVertexData(
     std::vector<uint32_t>&    indexData,
     const std::vector<float>& vertexData,
     const uint32_t            expectedVertexCount,
@@ -562,6 +568,13 @@ void TriMesh::AppendIndexAndVertexData(
             uint32_t v2 = indexData[3 * triIndex + 2];
             mesh.AppendTriangle(v0, v1, v2);
         }
+
+        if (options.mEnableOptimizeMesh) {
+            Result ppxres = MeshOptimizer::Optimize(MeshOptimizerOptions(), &mesh);
+            if (Failed(ppxres)) {
+                return ppxres;
+            }
+        }
     }
     else {
         for (size_t i = 0; i < indexData.size(); ++i) {
@@ -588,6 +601,8 @@ void TriMesh::AppendIndexAndVertexData(
             }
         }
     }
+
+    return ppx::SUCCESS;
 }
 
 TriMesh TriMesh::CreatePlane(TriMeshPlane plane, const float2& size, uint32_t usegs, uint32_t vsegs, const TriMeshOptions& options)
@@ -719,7 +734,11 @@ TriMesh TriMesh::CreatePlane(TriMeshPlane plane, const float2& size, uint32_t us
     TriMesh             mesh        = TriMesh(indexType, texCoordDim);
 
     uint32_t expectedVertexCount = uverts * vverts;
-    AppendIndexAndVertexData(indexData, vertexData, expectedVertexCount, options, mesh);
+    Result   ppxres              = AppendIndexAndVertexData(indexData, vertexData, expectedVertexCount, options, mesh);
+    if (Failed(ppxres)) {
+        // The optimizer leaves the mesh unchanged when it fails
+        PPX_LOG_WARN("Failed to optimize plane mesh, using the unoptimized mesh");
+    }
 
     return mesh;
 
@@ -816,7 +835,11 @@ TriMesh TriMesh::CreateCube(const float3& size, const TriMeshOptions& options)
     TriMeshAttributeDim texCoordDim = options.mEnableTexCoords ? TRI_MESH_ATTRIBUTE_DIM_2 : TRI_MESH_ATTRIBUTE_DIM_UNDEFINED;
     TriMesh             mesh        = TriMesh(indexType, texCoordDim);
 
-    AppendIndexAndVertexData(indexData, vertexData, 24, options, mesh);
+    Result ppxres = AppendIndexAndVertexData(indexData, vertexData, 24, options, mesh);
+    if (Failed(ppxres)) {
+        // The optimizer leaves the mesh unchanged when it fails
+        PPX_LOG_WARN("Failed to optimize cube mesh, using the unoptimized mesh");
+    }
 
     return mesh;
 }
@@ -895,17 +918,102 @@ TriMesh TriMesh::CreateSphere(float radius, uint32_t usegs, uint32_t vsegs, cons
     TriMesh             mesh        = TriMesh(indexType, texCoordDim);
 
     uint32_t expectedVertexCount = uverts * vverts;
-    AppendIndexAndVertexData(indexData, vertexData, expectedVertexCount, options, mesh);
+    Result   ppxres              = AppendIndexAndVertexData(indexData, vertexData, expectedVertexCount, options, mesh);
+    if (Failed(ppxres)) {
+        // The optimizer leaves the mesh unchanged when it fails
+        PPX_LOG_WARN("Failed to optimize sphere mesh, using the unoptimized mesh");
+    }
 
     return mesh;
 }
 
+uint64_t TriMesh::HashOptions(const TriMeshOptions& options)
+{
+    // Tightly packed so the hash doesn't depend on padding bytes
+    struct HashedOptions
+    {
+        uint32_t flags;
+        float    objectColor[3];
+        float    translate[3];
+        float    scale[3];
+        float    texCoordScale[2];
+    };
+
+    HashedOptions hashed = {};
+    hashed.flags |= options.mEnableIndices ? (1u << 0) : 0;
+    hashed.flags |= options.mEnableVertexColors ? (1u << 1) : 0;
+    hashed.flags |= options.mEnableNormals ? (1u << 2) : 0;
+    hashed.flags |= options.mEnableTexCoords ? (1u << 3) : 0;
+    hashed.flags |= options.mEnableTangents ? (1u << 4) : 0;
+    hashed.flags |= options.mEnableObjectColor ? (1u << 5) : 0;
+    hashed.flags |= options.mInvertTexCoordsV ? (1u << 6) : 0;
+    hashed.flags |= options.mInvertWinding ? (1u << 7) : 0;
+    hashed.flags |= options.mEnableOptimizeMesh ? (1u << 8) : 0;
+    memcpy(hashed.objectColor, &options.mObjectColor, sizeof(hashed.objectColor));
+    memcpy(hashed.translate, &options.mTranslate, sizeof(hashed.translate));
+    memcpy(hashed.scale, &options.mScale, sizeof(hashed.scale));
+    memcpy(hashed.texCoordScale, &options.mTexCoordScale, sizeof(hashed.texCoordScale));
+
+    return XXH64(&hashed, sizeof(hashed), 0);
+}
+
 Result TriMesh::CreateFromOBJ(const std::filesystem::path& path, const TriMeshOptions& options, TriMesh* pTriMesh)
 {
     if (IsNull(pTriMesh)) {
         return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
     }
 
+    if (!options.mEnableBinaryCache) {
+        return ParseOBJ(path, options, pTriMesh);
+    }
+
+    // Source content and options both invalidate the cache file
+    const uint64_t sourceHash = BinaryMesh::HashFile(path);
+    if (sourceHash == 0) {
+        return ParseOBJ(path, options, pTriMesh);
+    }
+    const uint64_t optionsHash = HashOptions(options);
+
+    // Cache file name is unique per source path and options
+    std::filesystem::path cacheDirectory = options.mBinaryCacheDirectory;
+    if (cacheDirectory.empty()) {
+        cacheDirectory = fs::GetDefaultOutputDirectory() / "mesh_cache";
+    }
+    const std::string  pathString = path.generic_string();
+    const uint64_t     nameHash   = XXH64(pathString.data(), pathString.size(), optionsHash);
+    std::ostringstream cacheFileName;
+    cacheFileName << path.stem().string() << "_" << std::hex << std::setw(16) << std::setfill('0') << nameHash << ".ppxmesh";
+    const std::filesystem::path cachePath = cacheDirectory / cacheFileName.str();
+
+    {
+        BinaryMesh binaryMesh;
+        if (Success(binaryMesh.Open(cachePath)) && (binaryMesh.GetSourceHash() == sourceHash) && (binaryMesh.GetOptionsHash() == optionsHash)) {
+            Result ppxres = binaryMesh.CreateTriMesh(pTriMesh);
+            if (Success(ppxres)) {
+                PPX_LOG_INFO("Loaded mesh from binary cache: " << cachePath << " (" << pTriMesh->GetCountTriangles() << " triangles)");
+                return ppx::SUCCESS;
+            }
+        }
+    }
+
+    Result ppxres = ParseOBJ(path, options, pTriMesh);
+    if (Failed(ppxres)) {
+        return ppxres;
+    }
+
+    if (Failed(BinaryMesh::Write(cachePath, *pTriMesh, sourceHash, optionsHash))) {
+        PPX_LOG_WARN("Failed to write binary mesh cache file: " << cachePath);
+    }
+
+    return ppx::SUCCESS;
+}
+
+Result TriMesh::ParseOBJ(const std::filesystem::path& path, const TriMeshOptions& options, TriMesh* pTriMesh)
+{
+    if (IsNull(pTriMesh)) {
+        return ppx::ERROR_UNEXPECTED_NULL_ARGUMENT;
+    }
+
     Timer timer;
     PPX_ASSERT_MSG(timer.Start() == ppx::TIMER_RESULT_SUCCESS, "timer start failed");
     double fnStartTime = timer.SecondsSinceStart();
@@ -1160,6 +1268,15 @@ Result TriMesh::CreateFromOBJ(const std::filesystem::path& path, const TriMeshOp
     //     }
     // }
 
+    if (options.mEnableOptimizeMesh) {
+        MeshOptimizerStatistics stats  = {};
+        Result                  ppxres = MeshOptimizer::Optimize(MeshOptimizerOptions(), pTriMesh, &stats);
+        if (Failed(ppxres)) {
+            return ppxres;
+        }
+        PPX_LOG_INFO("Optimized mesh from OBJ file: " << path << " (ACMR " << FloatString(stats.before.acmr) << " -> " << FloatString(stats.after.acmr) << ", ATVR " << FloatString(stats.before.atvr) << " -> " << FloatString(stats.after.atvr) << ")");
+    }
+
     double fnEndTime = timer.SecondsSinceStart();
     float  fnElapsed = static_cast<float>(fnEndTime - fnStartTime);
     PPX_LOG_INFO("Created mesh from OBJ file: " << path << " (" << FloatString(fnElapsed) << " seconds, " << numShapes << " shapes, " << totalTriangles << " triangles)");
@@ -0,0 +1,242 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/binary_mesh.h"
+
+#include <cstring>
+#include <fstream>
+
+using namespace ppx;
+
+namespace {
+
+class BinaryMeshTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path = std::filesystem::temp_directory_path() / ("ppx_binary_mesh_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".ppxmesh");
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    std::filesystem::path path;
+};
+
+void ExpectSameBuffer(const Geometry::Buffer* pExpected, const Geometry::Buffer* pActual)
+{
+    ASSERT_EQ(pExpected->GetSize(), pActual->GetSize());
+    EXPECT_EQ(pExpected->GetElementSize(), pActual->GetElementSize());
+    EXPECT_EQ(memcmp(pExpected->GetData(), pActual->GetData(), pExpected->GetSize()), 0);
+}
+
+} // namespace
+
+TEST_F(BinaryMeshTest, TriMeshRoundTrip)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 8, 6, TriMeshOptions().Indices().AllAttributes());
+    ASSERT_EQ(BinaryMesh::Write(path, mesh, 0x1234, 0x5678), ppx::SUCCESS);
+
+    BinaryMesh binaryMesh;
+    ASSERT_EQ(binaryMesh.Open(path), ppx::SUCCESS);
+    EXPECT_EQ(binaryMesh.GetSourceHash(), 0x1234u);
+    EXPECT_EQ(binaryMesh.GetOptionsHash(), 0x5678u);
+    EXPECT_EQ(binaryMesh.GetIndexCount(), mesh.GetCountIndices());
+    EXPECT_EQ(binaryMesh.GetVertexCount(), mesh.GetCountPositions());
+    EXPECT_EQ(binaryMesh.GetStreamSize(BINARY_MESH_STREAM_TANGENTS), mesh.GetDataSizeTangents());
+
+    TriMesh loaded;
+    ASSERT_EQ(binaryMesh.CreateTriMesh(&loaded), ppx::SUCCESS);
+    EXPECT_EQ(loaded.GetIndexType(), mesh.GetIndexType());
+    EXPECT_EQ(loaded.GetTexCoordDim(), mesh.GetTexCoordDim());
+    ASSERT_EQ(loaded.GetCountIndices(), mesh.GetCountIndices());
+    ASSERT_EQ(loaded.GetCountPositions(), mesh.GetCountPositions());
+    EXPECT_EQ(memcmp(loaded.GetDataIndicesU32(), mesh.GetDataIndicesU32(), mesh.GetDataSizeIndices()), 0);
+    EXPECT_EQ(memcmp(loaded.GetDataPositions(), mesh.GetDataPositions(), mesh.GetDataSizePositions()), 0);
+    EXPECT_EQ(memcmp(loaded.GetDataTexCoords2(), mesh.GetDataTexCoords2(), mesh.GetDataSizeTexCoords()), 0);
+    EXPECT_EQ(memcmp(loaded.GetDataTangents(), mesh.GetDataTangents(), mesh.GetDataSizeTangents()), 0);
+    EXPECT_EQ(loaded.GetBoundingBoxMin(), mesh.GetBoundingBoxMin());
+    EXPECT_EQ(loaded.GetBoundingBoxMax(), mesh.GetBoundingBoxMax());
+}
+
+TEST_F(BinaryMeshTest, CreateGeometryMatchesTriMeshGeometry)
+{
+    TriMesh mesh = TriMesh::CreateCube(float3(1, 2, 3), TriMeshOptions().Indices().VertexColors().Normals().TexCoords());
+    ASSERT_EQ(BinaryMesh::Write(path, mesh), ppx::SUCCESS);
+
+    Geometry expected;
+    ASSERT_EQ(Geometry::Create(mesh, &expected), ppx::SUCCESS);
+
+    BinaryMesh binaryMesh;
+    ASSERT_EQ(binaryMesh.Open(path), ppx::SUCCESS);
+    Geometry actual;
+    ASSERT_EQ(binaryMesh.CreateGeometry(&actual), ppx::SUCCESS);
+
+    EXPECT_EQ(actual.GetIndexType(), expected.GetIndexType());
+    ASSERT_EQ(actual.GetVertexBufferCount(), expected.GetVertexBufferCount());
+    ExpectSameBuffer(expected.GetIndexBuffer(), actual.GetIndexBuffer());
+    for (uint32_t i = 0; i < expected.GetVertexBufferCount(); ++i) {
+        ExpectSameBuffer(expected.GetVertexBuffer(i), actual.GetVertexBuffer(i));
+    }
+}
+
+TEST_F(BinaryMeshTest, GeometryRoundTrip)
+{
+    TriMesh  mesh = TriMesh::CreatePlane(TRI_MESH_PLANE_POSITIVE_Y, float2(2, 2), 3, 3, TriMeshOptions().Indices().Normals());
+    Geometry expected;
+    ASSERT_EQ(Geometry::Create(mesh, &expected), ppx::SUCCESS);
+    ASSERT_EQ(BinaryMesh::Write(path, expected), ppx::SUCCESS);
+
+    BinaryMesh binaryMesh;
+    ASSERT_EQ(binaryMesh.Open(path), ppx::SUCCESS);
+    EXPECT_EQ(binaryMesh.GetBoundingBoxMin(), mesh.GetBoundingBoxMin());
+    EXPECT_EQ(binaryMesh.GetBoundingBoxMax(), mesh.GetBoundingBoxMax());
+
+    Geometry actual;
+    ASSERT_EQ(binaryMesh.CreateGeometry(&actual), ppx::SUCCESS);
+    ASSERT_EQ(actual.GetVertexBufferCount(), expected.GetVertexBufferCount());
+    ExpectSameBuffer(expected.GetIndexBuffer(), actual.GetIndexBuffer());
+    for (uint32_t i = 0; i < expected.GetVertexBufferCount(); ++i) {
+        ExpectSameBuffer(expected.GetVertexBuffer(i), actual.GetVertexBuffer(i));
+    }
+}
+
+TEST_F(BinaryMeshTest, MeshletRoundTrip)
+{
+    TriMesh     mesh = TriMesh::CreateSphere(1.0f, 32, 16, TriMeshOptions().Indices());
+    MeshletData meshlets;
+    ASSERT_EQ(MeshletBuilder::Build(mesh, MeshletBuildOptions(), &meshlets), ppx::SUCCESS);
+    ASSERT_EQ(BinaryMesh::Write(path, mesh, 0, 0, &meshlets), ppx::SUCCESS);
+
+    BinaryMesh binaryMesh;
+    ASSERT_EQ(binaryMesh.Open(path), ppx::SUCCESS);
+    EXPECT_EQ(binaryMesh.GetMeshletCount(), meshlets.GetMeshletCount());
+
+    MeshletData loaded;
+    ASSERT_EQ(binaryMesh.CreateMeshletData(&loaded), ppx::SUCCESS);
+    ASSERT_EQ(loaded.GetMeshletCount(), meshlets.GetMeshletCount());
+    EXPECT_EQ(loaded.vertices, meshlets.vertices);
+    EXPECT_EQ(loaded.triangles, meshlets.triangles);
+    EXPECT_EQ(memcmp(loaded.meshlets.data(), meshlets.meshlets.data(), meshlets.meshlets.size() * sizeof(Meshlet)), 0);
+    EXPECT_EQ(memcmp(loaded.bounds.data(), meshlets.bounds.data(), meshlets.bounds.size() * sizeof(MeshletBounds)), 0);
+
+    // Files without meshlets report it
+    ASSERT_EQ(BinaryMesh::Write(path, mesh), ppx::SUCCESS);
+    ASSERT_EQ(binaryMesh.Open(path), ppx::SUCCESS);
+    EXPECT_EQ(binaryMesh.GetMeshletCount(), 0u);
+    EXPECT_EQ(binaryMesh.CreateMeshletData(&loaded), ppx::ERROR_ELEMENT_NOT_FOUND);
+}
+
+TEST_F(BinaryMeshTest, OpenRejectsBadMagic)
+{
+    std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+    BinaryMeshHeader header = {};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+
+    BinaryMesh binaryMesh;
+    EXPECT_EQ(binaryMesh.Open(path), ppx::ERROR_BAD_DATA_SOURCE);
+    EXPECT_FALSE(binaryMesh.IsOpen());
+}
+
+TEST_F(BinaryMeshTest, OpenRejectsTruncatedFile)
+{
+    TriMesh mesh = TriMesh::CreateCube(float3(1), TriMeshOptions().Indices());
+    ASSERT_EQ(BinaryMesh::Write(path, mesh), ppx::SUCCESS);
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 4);
+
+    BinaryMesh binaryMesh;
+    EXPECT_EQ(binaryMesh.Open(path), ppx::ERROR_BAD_DATA_SOURCE);
+}
+
+TEST_F(BinaryMeshTest, OpenRejectsMismatchedStreamLayout)
+{
+    TriMesh mesh = TriMesh::CreateCube(float3(1), TriMeshOptions().Indices().TexCoords());
+    ASSERT_EQ(BinaryMesh::Write(path, mesh), ppx::SUCCESS);
+
+    BinaryMeshHeader original = {};
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        file.read(reinterpret_cast<char*>(&original), sizeof(original));
+    }
+
+    auto openWithHeader = [this](const BinaryMeshHeader& header) {
+        {
+            std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        }
+        BinaryMesh binaryMesh;
+        return binaryMesh.Open(path);
+    };
+
+    ASSERT_EQ(openWithHeader(original), ppx::SUCCESS);
+
+    // Texture coordinates stored as float3 but the header says float2
+    BinaryMeshHeader header = original;
+    header.texCoordDim      = TRI_MESH_ATTRIBUTE_DIM_3;
+    EXPECT_EQ(openWithHeader(header), ppx::ERROR_BAD_DATA_SOURCE);
+
+    header             = original;
+    header.texCoordDim = 7;
+    EXPECT_EQ(openWithHeader(header), ppx::ERROR_BAD_DATA_SOURCE);
+
+    // Element size consistent with the stream size but not with float3
+    header                                                   = original;
+    header.vertexCount                                       = original.vertexCount * 2;
+    header.streams[BINARY_MESH_STREAM_POSITIONS].elementSize = sizeof(float3) / 2;
+    EXPECT_EQ(openWithHeader(header), ppx::ERROR_BAD_DATA_SOURCE);
+
+    // Index element size that doesn't match the index type
+    header                                                 = original;
+    header.indexCount                                      = original.indexCount * 2;
+    header.streams[BINARY_MESH_STREAM_INDICES].elementSize = grfx::IndexTypeSize(static_cast<grfx::IndexType>(original.indexType)) / 2;
+    EXPECT_EQ(openWithHeader(header), ppx::ERROR_BAD_DATA_SOURCE);
+
+    // Indices referenced but missing
+    header                                          = original;
+    header.streams[BINARY_MESH_STREAM_INDICES].size = 0;
+    EXPECT_EQ(openWithHeader(header), ppx::ERROR_BAD_DATA_SOURCE);
+}
+
+TEST_F(BinaryMeshTest, OpenRejectsOutOfRangeIndices)
+{
+    TriMesh mesh = TriMesh::CreateCube(float3(1), TriMeshOptions().Indices());
+    ASSERT_EQ(BinaryMesh::Write(path, mesh), ppx::SUCCESS);
+
+    BinaryMeshHeader header = {};
+    {
+        std::ifstream file(path, std::ios::in | std::ios::binary);
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    }
+    ASSERT_EQ(header.indexType, static_cast<uint32_t>(grfx::INDEX_TYPE_UINT32));
+
+    // Point the last index one past the end of the vertex streams
+    const uint32_t badIndex = header.vertexCount;
+    {
+        const uint64_t lastIndexOffset = header.streams[BINARY_MESH_STREAM_INDICES].offset + (header.indexCount - 1) * sizeof(uint32_t);
+        std::fstream   file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(static_cast<std::streamoff>(lastIndexOffset));
+        file.write(reinterpret_cast<const char*>(&badIndex), sizeof(badIndex));
+    }
+
+    BinaryMesh binaryMesh;
+    EXPECT_EQ(binaryMesh.Open(path), ppx::ERROR_BAD_DATA_SOURCE);
+    EXPECT_FALSE(binaryMesh.IsOpen());
+}
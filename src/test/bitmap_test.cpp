@@ -0,0 +1,383 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/bitmap.h"
+#include "ppx/mipmap.h"
+
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+#include <vector>
+
+using namespace ppx;
+
+namespace {
+
+Bitmap CreatePatternRGBA8(uint32_t width, uint32_t height)
+{
+    Bitmap bitmap = Bitmap::Create(width, height, Bitmap::FORMAT_RGBA_UINT8);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            uint8_t* pPixel = bitmap.GetPixel8u(x, y);
+            pPixel[0]       = static_cast<uint8_t>(x * 7 + y * 3);
+            pPixel[1]       = static_cast<uint8_t>(x * y);
+            pPixel[2]       = static_cast<uint8_t>((x ^ y) * 13);
+            pPixel[3]       = static_cast<uint8_t>(255 - x);
+        }
+    }
+    return bitmap;
+}
+
+} // namespace
+
+TEST(BitmapTest, DownsampleRGBA8AveragesQuads)
+{
+    // Wide enough for the vector loop and its remainder
+    Bitmap source = CreatePatternRGBA8(38, 6);
+    Bitmap target = Bitmap::Create(19, 3, Bitmap::FORMAT_RGBA_UINT8);
+    ASSERT_EQ(source.Downsample(&target), ppx::SUCCESS);
+
+    for (uint32_t y = 0; y < target.GetHeight(); ++y) {
+        for (uint32_t x = 0; x < target.GetWidth(); ++x) {
+            for (uint32_t c = 0; c < 4; ++c) {
+                const uint32_t sum = source.GetPixel8u(2 * x, 2 * y)[c] + source.GetPixel8u(2 * x + 1, 2 * y)[c] +
+                                     source.GetPixel8u(2 * x, 2 * y + 1)[c] + source.GetPixel8u(2 * x + 1, 2 * y + 1)[c];
+                EXPECT_EQ(target.GetPixel8u(x, y)[c], (sum + 2) / 4) << "x=" << x << " y=" << y << " c=" << c;
+            }
+        }
+    }
+}
+
+TEST(BitmapTest, DownsampleOddSizeUsesThreeTaps)
+{
+    Bitmap source = Bitmap::Create(3, 2, Bitmap::FORMAT_R_FLOAT);
+    float  values[6] = {1, 2, 3, 4, 5, 6};
+    for (uint32_t i = 0; i < 6; ++i) {
+        *source.GetPixel32f(i % 3, i / 3) = values[i];
+    }
+
+    Bitmap target = Bitmap::Create(1, 1, Bitmap::FORMAT_R_FLOAT);
+    ASSERT_EQ(source.Downsample(&target), ppx::SUCCESS);
+    EXPECT_FLOAT_EQ(*target.GetPixel32f(0, 0), 3.5f);
+}
+
+TEST(BitmapTest, DownsampleSRGBAveragesInLinearSpace)
+{
+    Bitmap source = Bitmap::Create(2, 2, Bitmap::FORMAT_RGBA_UINT8);
+    for (uint32_t i = 0; i < 4; ++i) {
+        const uint8_t value = (i % 2) ? 255 : 0;
+        uint8_t*      pPixel = source.GetPixel8u(i % 2, i / 2);
+        pPixel[0]            = value;
+        pPixel[1]            = value;
+        pPixel[2]            = value;
+        pPixel[3]            = value;
+    }
+
+    Bitmap target = Bitmap::Create(1, 1, Bitmap::FORMAT_RGBA_UINT8);
+    ASSERT_EQ(source.Downsample(&target, /* sRGB= */ true), ppx::SUCCESS);
+    // Linear 0.5 is sRGB 188, alpha is averaged as is
+    EXPECT_EQ(target.GetPixel8u(0, 0)[0], 188);
+    EXPECT_EQ(target.GetPixel8u(0, 0)[2], 188);
+    EXPECT_EQ(target.GetPixel8u(0, 0)[3], 128);
+
+    ASSERT_EQ(source.Downsample(&target), ppx::SUCCESS);
+    EXPECT_EQ(target.GetPixel8u(0, 0)[0], 128);
+}
+
+TEST(BitmapTest, DownsampleMatchesSerialResultWhenParallel)
+{
+    // Large enough to be split into row bands
+    Bitmap source = Bitmap::Create(1024, 1024, Bitmap::FORMAT_RGBA_FLOAT);
+    for (uint32_t y = 0; y < source.GetHeight(); ++y) {
+        for (uint32_t x = 0; x < source.GetWidth(); ++x) {
+            float* pPixel = source.GetPixel32f(x, y);
+            pPixel[0]     = static_cast<float>(x);
+            pPixel[1]     = static_cast<float>(y);
+            pPixel[2]     = 1.0f;
+            pPixel[3]     = 0.5f;
+        }
+    }
+
+    Bitmap target = Bitmap::Create(512, 512, Bitmap::FORMAT_RGBA_FLOAT);
+    ASSERT_EQ(source.Downsample(&target), ppx::SUCCESS);
+    for (uint32_t y = 0; y < target.GetHeight(); y += 37) {
+        for (uint32_t x = 0; x < target.GetWidth(); x += 41) {
+            const float* pPixel = target.GetPixel32f(x, y);
+            EXPECT_FLOAT_EQ(pPixel[0], 2.0f * x + 0.5f);
+            EXPECT_FLOAT_EQ(pPixel[1], 2.0f * y + 0.5f);
+            EXPECT_FLOAT_EQ(pPixel[2], 1.0f);
+            EXPECT_FLOAT_EQ(pPixel[3], 0.5f);
+        }
+    }
+}
+
+TEST(BitmapTest, DownsampleRejectsMismatchedTarget)
+{
+    Bitmap source = CreatePatternRGBA8(8, 8);
+
+    Bitmap wrongSize = Bitmap::Create(3, 4, Bitmap::FORMAT_RGBA_UINT8);
+    EXPECT_EQ(source.Downsample(&wrongSize), ppx::ERROR_IMAGE_RESIZE_FAILED);
+
+    Bitmap wrongFormat = Bitmap::Create(4, 4, Bitmap::FORMAT_RGBA_FLOAT);
+    EXPECT_EQ(source.Downsample(&wrongFormat), ppx::ERROR_IMAGE_INVALID_FORMAT);
+}
+
+TEST(MipmapTest, GeneratesAllLevels)
+{
+    Bitmap source = CreatePatternRGBA8(64, 16);
+    Mipmap mipmap(source, PPX_REMAINING_MIP_LEVELS);
+    ASSERT_TRUE(mipmap.IsOk());
+    ASSERT_EQ(mipmap.GetLevelCount(), 5);
+    EXPECT_EQ(mipmap.GetMip(4)->GetWidth(), 4);
+    EXPECT_EQ(mipmap.GetMip(4)->GetHeight(), 1);
+}
+
+TEST(BitmapTest, MoveKeepsStorage)
+{
+    Bitmap      source = CreatePatternRGBA8(16, 8);
+    const char* pData  = source.GetData();
+
+    Bitmap moved(std::move(source));
+    EXPECT_EQ(moved.GetData(), pData);
+    EXPECT_EQ(moved.GetWidth(), 16);
+    EXPECT_FALSE(source.IsOk());
+
+    Bitmap assigned;
+    assigned = std::move(moved);
+    EXPECT_EQ(assigned.GetData(), pData);
+    EXPECT_FALSE(moved.IsOk());
+}
+
+TEST(BitmapTest, CopyOfPaddedBitmapIsTightlyPacked)
+{
+    const uint32_t    rowStride = 4 * 4 + 12;
+    std::vector<char> storage(rowStride * 3, 0);
+    Bitmap            padded = Bitmap::Create(4, 3, Bitmap::FORMAT_RGBA_UINT8, rowStride, storage.data());
+    ASSERT_TRUE(padded.IsOk());
+    padded.GetPixel8u(3, 2)[0] = 42;
+
+    Bitmap copy = padded;
+    ASSERT_TRUE(copy.IsOk());
+    EXPECT_NE(copy.GetData(), padded.GetData());
+    EXPECT_EQ(copy.GetRowStride(), 16);
+    EXPECT_EQ(copy.GetPixel8u(3, 2)[0], 42);
+}
+
+TEST(BitmapViewTest, SubViewSharesPixels)
+{
+    Bitmap     source = CreatePatternRGBA8(16, 8);
+    BitmapView view   = BitmapView(source).GetSubView(4, 2, 8, 4);
+    ASSERT_TRUE(view.IsOk());
+    EXPECT_EQ(view.GetWidth(), 8);
+    EXPECT_EQ(view.GetHeight(), 4);
+    EXPECT_EQ(view.GetRowStride(), source.GetRowStride());
+    EXPECT_EQ(view.GetData(), source.GetPixelAddress(4, 2));
+    EXPECT_EQ(view.GetPixelAddress(7, 3), source.GetPixelAddress(11, 5));
+    EXPECT_EQ(view.GetPixelAddress(8, 0), nullptr);
+
+    BitmapView nested = view.GetSubView(1, 1, 2, 2);
+    EXPECT_EQ(nested.GetData(), source.GetPixelAddress(5, 3));
+}
+
+TEST(BitmapViewTest, SubViewOutsideIsEmpty)
+{
+    Bitmap     source = CreatePatternRGBA8(16, 8);
+    BitmapView view(source);
+    EXPECT_FALSE(view.GetSubView(10, 0, 7, 1).IsOk());
+    EXPECT_FALSE(view.GetSubView(0, 8, 1, 1).IsOk());
+    EXPECT_FALSE(view.GetSubView(0, 0, 0, 1).IsOk());
+    EXPECT_FALSE(view.GetSubView(UINT32_MAX, 0, 2, 1).IsOk());
+    EXPECT_FALSE(BitmapView().GetSubView(0, 0, 1, 1).IsOk());
+}
+
+TEST(BitmapViewTest, ConstBitmapViewIsReadOnly)
+{
+    Bitmap        source      = CreatePatternRGBA8(16, 8);
+    const Bitmap& constSource = source;
+
+    // Sub views keep the access of the view they were taken from
+    BitmapView readOnly = BitmapView(constSource).GetSubView(2, 2, 4, 4);
+    ASSERT_TRUE(readOnly.IsOk());
+    EXPECT_TRUE(readOnly.IsReadOnly());
+    EXPECT_EQ(readOnly.GetData(), source.GetPixelAddress(2, 2));
+    static_assert(std::is_same_v<decltype(readOnly.GetData()), const char*>, "view data must be read-only");
+
+    BitmapView writable = BitmapView(source).GetSubView(2, 2, 4, 4);
+    ASSERT_FALSE(writable.IsReadOnly());
+    writable.GetMutablePixelAddress(1, 1)[0] = 17;
+    EXPECT_EQ(source.GetPixel8u(3, 3)[0], 17);
+
+    // Scaling into a read-only view fails instead of writing to it
+    EXPECT_EQ(writable.ScaleTo(readOnly), ppx::ERROR_IMAGE_RESIZE_FAILED);
+}
+
+TEST(MipmapTest, CopyPointsIntoOwnStorage)
+{
+    Bitmap source = CreatePatternRGBA8(32, 32);
+    Mipmap mipmap(source, PPX_REMAINING_MIP_LEVELS);
+    ASSERT_TRUE(mipmap.IsOk());
+
+    Mipmap copy(mipmap);
+    ASSERT_TRUE(copy.IsOk());
+    ASSERT_EQ(copy.GetLevelCount(), mipmap.GetLevelCount());
+    for (uint32_t level = 1; level < copy.GetLevelCount(); ++level) {
+        // Mips are laid out one after another in a single allocation
+        const Bitmap* pPrev = copy.GetMip(level - 1);
+        EXPECT_EQ(copy.GetMip(level)->GetData(), pPrev->GetData() + pPrev->GetFootprintSize());
+        EXPECT_NE(copy.GetMip(level)->GetData(), mipmap.GetMip(level)->GetData());
+        EXPECT_EQ(memcmp(copy.GetMip(level)->GetData(), mipmap.GetMip(level)->GetData(), copy.GetMip(level)->GetFootprintSize()), 0);
+    }
+}
+
+TEST(MipmapTest, MoveKeepsStorage)
+{
+    Bitmap      source = CreatePatternRGBA8(32, 32);
+    Mipmap      mipmap(source, PPX_REMAINING_MIP_LEVELS);
+    const char* pData = mipmap.GetMip(2)->GetData();
+
+    Mipmap moved(std::move(mipmap));
+    ASSERT_TRUE(moved.IsOk());
+    EXPECT_EQ(moved.GetMip(2)->GetData(), pData);
+}
+
+TEST(BitmapTest, ForEachRowFollowsRowStride)
+{
+    const uint32_t    rowStride = 4 * 4 + 8;
+    std::vector<char> storage(rowStride * 3, 0);
+    Bitmap            padded = Bitmap::Create(4, 3, Bitmap::FORMAT_R_FLOAT, rowStride, storage.data());
+
+    uint32_t rowCount = 0;
+    padded.ForEachRow<float>([&rowCount](Bitmap::RowSpan<float> row) {
+        EXPECT_EQ(row.y, rowCount);
+        EXPECT_EQ(row.size(), 4);
+        for (uint32_t x = 0; x < row.width; ++x) {
+            row[x] = static_cast<float>(10 * row.y + x);
+        }
+        ++rowCount;
+    });
+    EXPECT_EQ(rowCount, 3);
+    EXPECT_EQ(*padded.GetPixel32f(3, 2), 23.0f);
+}
+
+TEST(BitmapTest, ConstForEachRowIsReadOnly)
+{
+    Bitmap bitmap = Bitmap::Create(4, 3, Bitmap::FORMAT_R_FLOAT);
+    bitmap.Fill<float>(2.0f, 0, 0, 0);
+
+    const Bitmap& constBitmap = bitmap;
+
+    float sum = 0;
+    constBitmap.ForEachRow<float>([&sum](auto row) {
+        static_assert(std::is_same_v<decltype(row), Bitmap::RowSpan<const float>>, "const bitmaps must yield const rows");
+        for (float pixel : row) {
+            sum += pixel;
+        }
+    });
+    EXPECT_EQ(sum, 24.0f);
+
+    std::atomic<uint32_t> rowCount = 0;
+    constBitmap.ParallelForEachRow<float>([&rowCount](auto row) {
+        static_assert(std::is_same_v<decltype(row), Bitmap::RowSpan<const float>>, "const bitmaps must yield const rows");
+        ++rowCount;
+    });
+    EXPECT_EQ(rowCount, 3u);
+}
+
+TEST(BitmapTest, ParallelForEachRowVisitsEveryRowOnce)
+{
+    // Large enough to be split into bands
+    Bitmap bitmap = Bitmap::Create(512, 512, Bitmap::FORMAT_R_UINT32);
+    bitmap.Fill<uint32_t>(0, 0, 0, 0);
+
+    bitmap.ParallelForEachRow<uint32_t>([](Bitmap::RowSpan<uint32_t> row) {
+        for (uint32_t& pixel : row) {
+            pixel += row.y + 1;
+        }
+    });
+
+    for (uint32_t y = 0; y < bitmap.GetHeight(); ++y) {
+        EXPECT_EQ(*bitmap.GetPixel32u(0, y), y + 1);
+        EXPECT_EQ(*bitmap.GetPixel32u(511, y), y + 1);
+    }
+}
+
+TEST(BitmapTest, TransformNormalizesIntegerChannels)
+{
+    Bitmap bitmap = Bitmap::Create(2, 2, Bitmap::FORMAT_RG_UINT8);
+    bitmap.Fill<uint8_t>(255, 51, 0, 0);
+
+    Result ppxres = bitmap.Transform([](uint32_t x, uint32_t y, const float4& value) {
+        EXPECT_FLOAT_EQ(value.r, 1.0f);
+        EXPECT_FLOAT_EQ(value.g, 0.2f);
+        EXPECT_EQ(value.b, 0.0f);
+        EXPECT_EQ(value.a, 1.0f);
+        return float4(value.r * 0.5f, value.g + 2.0f, 1.0f, 1.0f);
+    });
+    ASSERT_EQ(ppxres, ppx::SUCCESS);
+    EXPECT_EQ(bitmap.GetPixel8u(1, 1)[0], 128);
+    EXPECT_EQ(bitmap.GetPixel8u(1, 1)[1], 255);
+}
+
+TEST(BitmapTest, TransformPassesFloatsThrough)
+{
+    Bitmap bitmap = Bitmap::Create(3, 2, Bitmap::FORMAT_RGBA_FLOAT);
+    bitmap.Fill<float>(0, 0, 0, 0);
+
+    Result ppxres = bitmap.Transform([](uint32_t x, uint32_t y, const float4& value) {
+        return float4(static_cast<float>(x), static_cast<float>(y), -2.5f, 100.0f);
+    });
+    ASSERT_EQ(ppxres, ppx::SUCCESS);
+    const float* pPixel = bitmap.GetPixel32f(2, 1);
+    EXPECT_EQ(pPixel[0], 2.0f);
+    EXPECT_EQ(pPixel[1], 1.0f);
+    EXPECT_EQ(pPixel[2], -2.5f);
+    EXPECT_EQ(pPixel[3], 100.0f);
+
+    Bitmap empty;
+    EXPECT_EQ(empty.Transform([](uint32_t, uint32_t, const float4& value) { return value; }), ppx::ERROR_IMAGE_INVALID_FORMAT);
+}
+
+TEST(BitmapTest, LoadFilesKeepsPathOrder)
+{
+    const std::string                  seed = std::to_string(::testing::UnitTest::GetInstance()->random_seed());
+    std::vector<std::filesystem::path> paths;
+    std::vector<Bitmap>                sources;
+    for (uint32_t i = 0; i < 5; ++i) {
+        paths.push_back(std::filesystem::temp_directory_path() / ("ppx_bitmap_load_files_" + seed + "_" + std::to_string(i) + ".png"));
+        sources.push_back(CreatePatternRGBA8(8 + i, 4 + 2 * i));
+        ASSERT_EQ(Bitmap::SaveFilePNG(paths.back(), &sources.back()), ppx::SUCCESS);
+    }
+
+    std::vector<Bitmap> bitmaps;
+    ASSERT_EQ(Bitmap::LoadFiles(paths, &bitmaps), ppx::SUCCESS);
+    ASSERT_EQ(bitmaps.size(), sources.size());
+    for (size_t i = 0; i < bitmaps.size(); ++i) {
+        ASSERT_EQ(bitmaps[i].GetWidth(), sources[i].GetWidth());
+        ASSERT_EQ(bitmaps[i].GetHeight(), sources[i].GetHeight());
+        EXPECT_EQ(std::memcmp(bitmaps[i].GetData(), sources[i].GetData(), sources[i].GetFootprintSize()), 0) << "file " << i;
+    }
+
+    // Any missing file fails the whole batch
+    paths.insert(paths.begin() + 2, paths[0].string() + ".missing");
+    EXPECT_EQ(Bitmap::LoadFiles(paths, &bitmaps), ppx::ERROR_PATH_DOES_NOT_EXIST);
+    EXPECT_TRUE(bitmaps.empty());
+
+    std::error_code ec;
+    for (const std::filesystem::path& path : paths) {
+        std::filesystem::remove(path, ec);
+    }
+}
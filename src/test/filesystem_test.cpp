@@ -21,8 +21,12 @@
 #include "ppx/config.h"
 #include "ppx/fs.h"
 
+#include <algorithm>
+#include <cstring>
 #include <dirent.h>
 #include <filesystem>
+#include <fstream>
+#include <map>
 #include <stdio.h>
 #include <string>
 #include <string_view>
@@ -46,6 +50,65 @@ static size_t getOpenFDCount()
     return fdCount;
 }
 
+// Writes an asset pack the way tools/pack_assets.py does.
+static void writeTestPack(const std::filesystem::path& path, const std::map<std::string, std::string>& files)
+{
+    auto hashPath = [](const std::string& value) {
+        uint64_t hash = 0xCBF29CE484222325ull;
+        for (char c : value) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 0x100000001B3ull;
+        }
+        return hash;
+    };
+    auto align = [](uint64_t value) { return (value + 63) & ~uint64_t(63); };
+
+    std::vector<std::pair<std::string, std::string>> sorted(files.begin(), files.end());
+    std::sort(sorted.begin(), sorted.end(), [&hashPath](const auto& a, const auto& b) { return hashPath(a.first) < hashPath(b.first); });
+
+    std::string strings;
+    for (const auto& [name, content] : sorted) {
+        strings += name;
+    }
+
+    const uint64_t stringTableOffset = 32 + 32 * sorted.size();
+    uint64_t       dataOffset        = align(stringTableOffset + strings.size());
+
+    std::string header(32, '\0');
+    std::memcpy(header.data(), "PPXPACK", 8);
+    const uint32_t version    = 1;
+    const uint32_t entryCount = static_cast<uint32_t>(sorted.size());
+    const uint64_t stringSize = strings.size();
+    std::memcpy(header.data() + 8, &version, 4);
+    std::memcpy(header.data() + 12, &entryCount, 4);
+    std::memcpy(header.data() + 16, &stringTableOffset, 8);
+    std::memcpy(header.data() + 24, &stringSize, 8);
+
+    std::string entries;
+    std::string data;
+    uint32_t    pathOffset = 0;
+    for (const auto& [name, content] : sorted) {
+        const uint64_t hash       = hashPath(name);
+        const uint64_t size       = content.size();
+        const uint32_t pathLength = static_cast<uint32_t>(name.size());
+        entries.append(reinterpret_cast<const char*>(&hash), 8);
+        entries.append(reinterpret_cast<const char*>(&dataOffset), 8);
+        entries.append(reinterpret_cast<const char*>(&size), 8);
+        entries.append(reinterpret_cast<const char*>(&pathOffset), 4);
+        entries.append(reinterpret_cast<const char*>(&pathLength), 4);
+        pathOffset += pathLength;
+
+        data.resize(dataOffset - align(stringTableOffset + strings.size()), '\0');
+        data += content;
+        dataOffset = align(dataOffset + size);
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out << header << entries << strings;
+    out << std::string(align(stringTableOffset + strings.size()) - (stringTableOffset + strings.size()), '\0');
+    out << data;
+}
+
 class FsTest : public ::testing::Test
 {
 protected:
@@ -190,5 +253,103 @@ TEST_F(FsTest, CloseFileDescriptorOnScopeEnd)
     EXPECT_EQ(getOpenFDCount(), fdCountBefore);
 }
 
+TEST_F(FsTest, OpenMappedReturnsContent)
+{
+    fs::File file;
+    EXPECT_TRUE(file.OpenMapped(readableFile));
+    EXPECT_TRUE(file.IsValid());
+    EXPECT_TRUE(file.IsMapped());
+    ASSERT_EQ(file.GetLength(), kDefaultFileContent.size());
+
+    std::string_view content(reinterpret_cast<const char*>(file.GetMappedData()), file.GetLength());
+    EXPECT_EQ(content, kDefaultFileContent);
+}
+
+TEST_F(FsTest, OpenMappedAndReadReturnsContent)
+{
+    fs::File file;
+    EXPECT_TRUE(file.OpenMapped(readableFile));
+
+    std::string  buffer(kDefaultFileContent.size(), '\0');
+    const size_t readCount = file.Read(buffer.data(), buffer.size());
+    EXPECT_EQ(readCount, kDefaultFileContent.size());
+    EXPECT_EQ(buffer, kDefaultFileContent);
+}
+
+TEST_F(FsTest, OpenMappedNonExistantFileFails)
+{
+    fs::File file;
+    EXPECT_FALSE(file.OpenMapped(nonExistantFile));
+    EXPECT_FALSE(file.IsValid());
+}
+
+TEST_F(FsTest, OpenMappedDoesNotKeepFileDescriptor)
+{
+    const size_t fdCountBefore = getOpenFDCount();
+
+    {
+        fs::File file;
+        EXPECT_TRUE(file.OpenMapped(readableFile));
+        EXPECT_EQ(getOpenFDCount(), fdCountBefore);
+    }
+
+    EXPECT_EQ(getOpenFDCount(), fdCountBefore);
+}
+
+TEST_F(FsTest, MountedPackServesFilesFromMapping)
+{
+    const std::filesystem::path packPath = directory / "ppx_fs_test.ppxpack";
+    writeTestPack(packPath, {{"textures/a.txt", "alpha"}, {"b.txt", "bravo"}});
+
+    ASSERT_TRUE(fs::MountPack(packPath, "/ppx_virtual/assets"));
+    EXPECT_TRUE(fs::path_exists("/ppx_virtual/assets/b.txt"));
+    EXPECT_TRUE(fs::path_exists("/ppx_virtual/assets/textures"));
+    EXPECT_FALSE(fs::path_exists("/ppx_virtual/assets/textures/missing.txt"));
+
+    fs::File file;
+    ASSERT_TRUE(file.Open("/ppx_virtual/assets/textures/../textures/a.txt"));
+    EXPECT_TRUE(file.IsMapped());
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(file.GetMappedData()) % 64, 0);
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(file.GetMappedData()), file.GetLength()), "alpha");
+
+    auto content = fs::load_file("/ppx_virtual/assets/b.txt");
+    ASSERT_TRUE(content.has_value());
+    EXPECT_EQ(std::string(content->begin(), content->end()), "bravo");
+
+    // Files opened from the pack outlive the mount
+    fs::UnmountPack(packPath);
+    EXPECT_FALSE(fs::path_exists("/ppx_virtual/assets/b.txt"));
+    EXPECT_EQ(std::string_view(reinterpret_cast<const char*>(file.GetMappedData()), file.GetLength()), "alpha");
+
+    std::filesystem::remove(packPath);
+}
+
+TEST_F(FsTest, LaterPackTakesPrecedence)
+{
+    const std::filesystem::path firstPath  = directory / "ppx_fs_test_first.ppxpack";
+    const std::filesystem::path secondPath = directory / "ppx_fs_test_second.ppxpack";
+    writeTestPack(firstPath, {{"a.txt", "first"}, {"only_first.txt", "first"}});
+    writeTestPack(secondPath, {{"a.txt", "second"}});
+
+    ASSERT_TRUE(fs::MountPack(firstPath, "/ppx_virtual"));
+    ASSERT_TRUE(fs::MountPack(secondPath, "/ppx_virtual"));
+
+    auto content = fs::load_file("/ppx_virtual/a.txt");
+    ASSERT_TRUE(content.has_value());
+    EXPECT_EQ(std::string(content->begin(), content->end()), "second");
+    EXPECT_TRUE(fs::path_exists("/ppx_virtual/only_first.txt"));
+
+    fs::UnmountPack(firstPath);
+    fs::UnmountPack(secondPath);
+    std::filesystem::remove(firstPath);
+    std::filesystem::remove(secondPath);
+}
+
+TEST_F(FsTest, MountPackRejectsMalformedFile)
+{
+    EXPECT_FALSE(fs::MountPack(readableFile, "/ppx_virtual"));
+    EXPECT_FALSE(fs::MountPack(nonExistantFile, "/ppx_virtual"));
+}
+
 } // namespace ppx
 #endif
@@ -0,0 +1,136 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/geometry.h"
+
+#include <cstring>
+
+using namespace ppx;
+
+namespace {
+
+GeometryCreateInfo AllAttributes(GeometryCreateInfo createInfo)
+{
+    return createInfo.AddColor().AddNormal().AddTexCoord().AddTangent().AddBitangent();
+}
+
+// Builds the expected geometry one vertex at a time through the Append* API
+Geometry CreatePerVertex(const GeometryCreateInfo& createInfo, const TriMesh& mesh)
+{
+    Geometry geometry;
+    EXPECT_EQ(Geometry::Create(createInfo, &geometry), ppx::SUCCESS);
+
+    const bool meshIndexed   = (mesh.GetIndexType() != grfx::INDEX_TYPE_UNDEFINED);
+    const bool targetIndexed = (createInfo.indexType != grfx::INDEX_TYPE_UNDEFINED);
+    if (meshIndexed && !targetIndexed) {
+        for (uint32_t triIndex = 0; triIndex < mesh.GetCountTriangles(); ++triIndex) {
+            uint32_t v[3] = {};
+            EXPECT_EQ(mesh.GetTriangle(triIndex, v[0], v[1], v[2]), ppx::SUCCESS);
+            for (uint32_t i = 0; i < 3; ++i) {
+                TriMeshVertexData vertexData = {};
+                EXPECT_EQ(mesh.GetVertexData(v[i], &vertexData), ppx::SUCCESS);
+                geometry.AppendVertexData(vertexData);
+            }
+        }
+        return geometry;
+    }
+
+    for (uint32_t vertexIndex = 0; vertexIndex < mesh.GetCountPositions(); ++vertexIndex) {
+        TriMeshVertexData vertexData = {};
+        EXPECT_EQ(mesh.GetVertexData(vertexIndex, &vertexData), ppx::SUCCESS);
+        geometry.AppendVertexData(vertexData);
+    }
+    if (targetIndexed) {
+        for (uint32_t triIndex = 0; triIndex < mesh.GetCountTriangles(); ++triIndex) {
+            uint32_t v0 = 3 * triIndex + 0;
+            uint32_t v1 = 3 * triIndex + 1;
+            uint32_t v2 = 3 * triIndex + 2;
+            if (meshIndexed) {
+                EXPECT_EQ(mesh.GetTriangle(triIndex, v0, v1, v2), ppx::SUCCESS);
+            }
+            geometry.AppendIndicesTriangle(v0, v1, v2);
+        }
+    }
+    return geometry;
+}
+
+void ExpectSameBuffer(const Geometry::Buffer* pExpected, const Geometry::Buffer* pActual)
+{
+    ASSERT_EQ(pExpected->GetElementSize(), pActual->GetElementSize());
+    ASSERT_EQ(pExpected->GetSize(), pActual->GetSize());
+    EXPECT_EQ(std::memcmp(pExpected->GetData(), pActual->GetData(), pExpected->GetSize()), 0);
+}
+
+void ExpectSameGeometry(const GeometryCreateInfo& createInfo, const TriMesh& mesh)
+{
+    Geometry expected = CreatePerVertex(createInfo, mesh);
+
+    Geometry actual;
+    ASSERT_EQ(Geometry::Create(createInfo, mesh, &actual), ppx::SUCCESS);
+
+    EXPECT_EQ(expected.GetVertexCount(), actual.GetVertexCount());
+    EXPECT_EQ(expected.GetIndexCount(), actual.GetIndexCount());
+    ExpectSameBuffer(expected.GetIndexBuffer(), actual.GetIndexBuffer());
+    ASSERT_EQ(expected.GetVertexBufferCount(), actual.GetVertexBufferCount());
+    for (uint32_t i = 0; i < expected.GetVertexBufferCount(); ++i) {
+        ExpectSameBuffer(expected.GetVertexBuffer(i), actual.GetVertexBuffer(i));
+    }
+}
+
+} // namespace
+
+TEST(GeometryTest, TriMeshInterleavedIndexed)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 16, 8, TriMeshOptions().Indices().AllAttributes());
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::InterleavedU32()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::InterleavedU16()), mesh);
+}
+
+TEST(GeometryTest, TriMeshPlanarIndexed)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 16, 8, TriMeshOptions().Indices().AllAttributes());
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PlanarU32()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PlanarU16()), mesh);
+}
+
+TEST(GeometryTest, TriMeshPositionPlanarIndexed)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 16, 8, TriMeshOptions().Indices().AllAttributes());
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PositionPlanarU32()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PositionPlanarU16()), mesh);
+}
+
+TEST(GeometryTest, TriMeshIndexedToNonIndexed)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 16, 8, TriMeshOptions().Indices().AllAttributes());
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::Interleaved()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::Planar()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PositionPlanar()), mesh);
+}
+
+TEST(GeometryTest, TriMeshNonIndexed)
+{
+    TriMesh mesh = TriMesh::CreateCube(float3(1, 1, 1), TriMeshOptions().AllAttributes());
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::Interleaved()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PlanarU32()), mesh);
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::PositionPlanarU16()), mesh);
+}
+
+TEST(GeometryTest, TriMeshMissingAttributesAreZero)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 4, 4, TriMeshOptions().Indices());
+    ExpectSameGeometry(AllAttributes(GeometryCreateInfo::InterleavedU32()), mesh);
+}
@@ -0,0 +1,686 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/grfx/grfx_instance.h"
+#include "ppx/grfx/grfx_device.h"
+#include "ppx/grfx/null/null_buffer.h"
+#include "ppx/grfx/null/null_command.h"
+#include "ppx/grfx/null/null_device.h"
+#include "ppx/grfx/null/null_image.h"
+#include "ppx/grfx/null/null_queue.h"
+#include "ppx/graphics_util.h"
+
+using namespace ppx;
+
+#if defined(PPX_NULL)
+
+namespace {
+
+class GrfxNullTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        grfx::InstanceCreateInfo instanceCreateInfo = {};
+        instanceCreateInfo.api                      = grfx::API_NULL;
+        ASSERT_EQ(grfx::CreateInstance(&instanceCreateInfo, &mInstance), ppx::SUCCESS);
+
+        grfx::GpuPtr gpu;
+        ASSERT_EQ(mInstance->GetGpu(0, &gpu), ppx::SUCCESS);
+
+        grfx::DeviceCreateInfo deviceCreateInfo = {};
+        deviceCreateInfo.pGpu                   = gpu;
+        deviceCreateInfo.graphicsQueueCount     = 1;
+        ASSERT_EQ(mInstance->CreateDevice(&deviceCreateInfo, &mDevice), ppx::SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        if (mInstance) {
+            grfx::DestroyInstance(mInstance);
+        }
+    }
+
+    grfx::InstancePtr mInstance;
+    grfx::DevicePtr   mDevice;
+};
+
+} // namespace
+
+TEST_F(GrfxNullTest, RecordsCommandsWhenEnabled)
+{
+    grfx::null::Device* pNullDevice = grfx::null::ToApi(mDevice.Get());
+    grfx::QueuePtr      queue       = mDevice->GetGraphicsQueue();
+
+    grfx::BufferCreateInfo bufferCreateInfo       = {};
+    bufferCreateInfo.size                         = 256;
+    bufferCreateInfo.usageFlags.bits.vertexBuffer = true;
+    bufferCreateInfo.memoryUsage                  = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    grfx::BufferPtr buffer;
+    ASSERT_EQ(mDevice->CreateBuffer(&bufferCreateInfo, &buffer), ppx::SUCCESS);
+
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+    const grfx::null::CommandStream& stream = grfx::null::ToApi(commandBuffer.Get())->GetCommandStream();
+
+    // Recording is off by default
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    commandBuffer->Draw(3, 1, 0, 0);
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+    EXPECT_EQ(stream.GetCommandCount(), 0u);
+
+    pNullDevice->SetCommandRecordingEnabled(true);
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    grfx::VertexBufferView view(buffer, 16);
+    commandBuffer->BindVertexBuffers(1, &view);
+    commandBuffer->Draw(3, 2, 0, 0);
+    commandBuffer->Dispatch(4, 5, 6);
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+
+    EXPECT_EQ(stream.GetCommandCount(), 3u);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_DRAW), 1u);
+
+    size_t                             offset  = 0;
+    grfx::null::CommandStream::Command command = {};
+    ASSERT_TRUE(stream.Read(&offset, &command));
+    EXPECT_EQ(command.op, grfx::null::COMMAND_OP_BIND_VERTEX_BUFFERS);
+    EXPECT_EQ(command.pArgs[0], 1u);
+    EXPECT_EQ(command.pArgs[1], grfx::null::ToApi(buffer.Get())->GetNullHandle());
+    EXPECT_EQ(command.pArgs[2], 16u);
+
+    ASSERT_TRUE(stream.Read(&offset, &command));
+    EXPECT_EQ(command.op, grfx::null::COMMAND_OP_DRAW);
+    ASSERT_EQ(command.argCount, 4u);
+    EXPECT_EQ(command.pArgs[0], 3u);
+    EXPECT_EQ(command.pArgs[1], 2u);
+
+    ASSERT_TRUE(stream.Read(&offset, &command));
+    EXPECT_EQ(command.op, grfx::null::COMMAND_OP_DISPATCH);
+    EXPECT_EQ(command.pArgs[2], 6u);
+
+    EXPECT_FALSE(stream.Read(&offset, &command));
+
+    queue->DestroyCommandBuffer(commandBuffer);
+}
+
+TEST_F(GrfxNullTest, SubmitSignalsFenceAndTimeline)
+{
+    grfx::QueuePtr queue = mDevice->GetGraphicsQueue();
+
+    grfx::FencePtr        fence;
+    grfx::FenceCreateInfo fenceCreateInfo = {};
+    ASSERT_EQ(mDevice->CreateFence(&fenceCreateInfo, &fence), ppx::SUCCESS);
+    EXPECT_EQ(fence->Wait(0), ppx::ERROR_WAIT_TIMED_OUT);
+
+    grfx::SemaphorePtr        timeline;
+    grfx::SemaphoreCreateInfo semaphoreCreateInfo = {};
+    semaphoreCreateInfo.semaphoreType             = grfx::SEMAPHORE_TYPE_TIMELINE;
+    ASSERT_EQ(mDevice->CreateSemaphore(&semaphoreCreateInfo, &timeline), ppx::SUCCESS);
+
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+
+    grfx::Semaphore* pSignalSemaphore = timeline.Get();
+    grfx::SubmitInfo submitInfo       = {};
+    submitInfo.commandBufferCount     = 1;
+    submitInfo.ppCommandBuffers       = &commandBuffer;
+    submitInfo.signalSemaphoreCount   = 1;
+    submitInfo.ppSignalSemaphores     = &pSignalSemaphore;
+    submitInfo.signalValues           = {7};
+    submitInfo.pFence                 = fence;
+    ASSERT_EQ(queue->Submit(&submitInfo), ppx::SUCCESS);
+
+    EXPECT_EQ(fence->WaitAndReset(), ppx::SUCCESS);
+    EXPECT_EQ(fence->Wait(0), ppx::ERROR_WAIT_TIMED_OUT);
+    EXPECT_EQ(timeline->GetCounterValue(), 7u);
+    EXPECT_EQ(timeline->Wait(7, 0), ppx::SUCCESS);
+    EXPECT_EQ(timeline->Wait(8, 0), ppx::ERROR_WAIT_TIMED_OUT);
+
+    queue->DestroyCommandBuffer(commandBuffer);
+}
+
+TEST_F(GrfxNullTest, HeadlessSwapchainSubmitsOncePerFrame)
+{
+    grfx::QueuePtr     queue      = mDevice->GetGraphicsQueue();
+    grfx::null::Queue* pNullQueue = grfx::null::ToApi(queue.Get());
+
+    grfx::SwapchainCreateInfo swapchainCreateInfo = {};
+    swapchainCreateInfo.pQueue                    = queue;
+    swapchainCreateInfo.width                     = 64;
+    swapchainCreateInfo.height                    = 64;
+    swapchainCreateInfo.colorFormat               = grfx::FORMAT_B8G8R8A8_UNORM;
+    swapchainCreateInfo.imageCount                = 2;
+    grfx::SwapchainPtr swapchain;
+    ASSERT_EQ(mDevice->CreateSwapchain(&swapchainCreateInfo, &swapchain), ppx::SUCCESS);
+    ASSERT_TRUE(swapchain->IsHeadless());
+
+    grfx::FencePtr        fence;
+    grfx::FenceCreateInfo fenceCreateInfo = {};
+    ASSERT_EQ(mDevice->CreateFence(&fenceCreateInfo, &fence), ppx::SUCCESS);
+
+    grfx::SemaphorePtr        imageAcquired;
+    grfx::SemaphorePtr        renderComplete;
+    grfx::SemaphoreCreateInfo semaphoreCreateInfo = {};
+    ASSERT_EQ(mDevice->CreateSemaphore(&semaphoreCreateInfo, &imageAcquired), ppx::SUCCESS);
+    ASSERT_EQ(mDevice->CreateSemaphore(&semaphoreCreateInfo, &renderComplete), ppx::SUCCESS);
+
+    const uint64_t submitCount        = pNullQueue->GetSubmitCount();
+    const uint64_t commandBufferCount = pNullQueue->GetSubmittedCommandBufferCount();
+    for (uint32_t frame = 0; frame < 4; ++frame) {
+        uint32_t imageIndex = UINT32_MAX;
+        ASSERT_EQ(swapchain->AcquireNextImage(UINT64_MAX, imageAcquired, fence, &imageIndex), ppx::SUCCESS);
+        EXPECT_EQ(imageIndex, frame % 2);
+        EXPECT_EQ(fence->WaitAndReset(), ppx::SUCCESS);
+
+        const grfx::Semaphore* pWaitSemaphore = renderComplete.Get();
+        ASSERT_EQ(swapchain->Present(imageIndex, 1, &pWaitSemaphore), ppx::SUCCESS);
+    }
+    EXPECT_EQ(pNullQueue->GetSubmitCount() - submitCount, 4u);
+    EXPECT_EQ(pNullQueue->GetSubmittedCommandBufferCount(), commandBufferCount);
+
+    mDevice->DestroySwapchain(swapchain);
+}
+
+TEST_F(GrfxNullTest, HeadlessSwapchainWaitsOnlyForSameImagePresent)
+{
+    grfx::QueuePtr     queue      = mDevice->GetGraphicsQueue();
+    grfx::null::Queue* pNullQueue = grfx::null::ToApi(queue.Get());
+
+    const uint32_t            imageCount          = 3;
+    grfx::SwapchainCreateInfo swapchainCreateInfo = {};
+    swapchainCreateInfo.pQueue                    = queue;
+    swapchainCreateInfo.width                     = 64;
+    swapchainCreateInfo.height                    = 64;
+    swapchainCreateInfo.colorFormat               = grfx::FORMAT_B8G8R8A8_UNORM;
+    swapchainCreateInfo.imageCount                = imageCount;
+    grfx::SwapchainPtr swapchain;
+    ASSERT_EQ(mDevice->CreateSwapchain(&swapchainCreateInfo, &swapchain), ppx::SUCCESS);
+
+    grfx::FencePtr        fence;
+    grfx::FenceCreateInfo fenceCreateInfo = {};
+    ASSERT_EQ(mDevice->CreateFence(&fenceCreateInfo, &fence), ppx::SUCCESS);
+
+    grfx::SemaphorePtr        renderComplete[imageCount];
+    grfx::SemaphoreCreateInfo semaphoreCreateInfo = {};
+    for (uint32_t i = 0; i < imageCount; ++i) {
+        ASSERT_EQ(mDevice->CreateSemaphore(&semaphoreCreateInfo, &renderComplete[i]), ppx::SUCCESS);
+    }
+
+    for (uint32_t frame = 0; frame < 2 * imageCount; ++frame) {
+        // Only reacquiring an image waits, on its own previous present
+        const uint64_t waitCount  = pNullQueue->GetSubmittedWaitSemaphoreCount();
+        uint32_t       imageIndex = UINT32_MAX;
+        ASSERT_EQ(swapchain->AcquireNextImage(UINT64_MAX, nullptr, fence, &imageIndex), ppx::SUCCESS);
+        EXPECT_EQ(imageIndex, frame % imageCount);
+        EXPECT_EQ(pNullQueue->GetSubmittedWaitSemaphoreCount() - waitCount, (frame < imageCount) ? 0u : 1u);
+        EXPECT_EQ(fence->WaitAndReset(), ppx::SUCCESS);
+
+        const grfx::Semaphore* pWaitSemaphore = renderComplete[imageIndex].Get();
+        ASSERT_EQ(swapchain->Present(imageIndex, 1, &pWaitSemaphore), ppx::SUCCESS);
+    }
+
+    mDevice->DestroySwapchain(swapchain);
+}
+
+TEST_F(GrfxNullTest, CopiesBitmapsWithOneSubmit)
+{
+    grfx::QueuePtr     queue      = mDevice->GetGraphicsQueue();
+    grfx::null::Queue* pNullQueue = grfx::null::ToApi(queue.Get());
+
+    grfx::ImageCreateInfo imageCreateInfo       = grfx::ImageCreateInfo::SampledImage2D(16, 16, grfx::FORMAT_R8G8B8A8_UNORM, grfx::SAMPLE_COUNT_1, grfx::MEMORY_USAGE_GPU_ONLY);
+    imageCreateInfo.mipLevelCount               = 2;
+    imageCreateInfo.arrayLayerCount             = 3;
+    imageCreateInfo.usageFlags.bits.transferDst = true;
+    imageCreateInfo.initialState                = grfx::RESOURCE_STATE_SHADER_RESOURCE;
+    grfx::ImagePtr image;
+    ASSERT_EQ(mDevice->CreateImage(&imageCreateInfo, &image), ppx::SUCCESS);
+
+    Bitmap level0 = Bitmap::Create(16, 16, Bitmap::FORMAT_RGBA_UINT8);
+    Bitmap level1 = Bitmap::Create(8, 8, Bitmap::FORMAT_RGBA_UINT8);
+
+    std::vector<grfx_util::BitmapSubresource> subresources;
+    for (uint32_t layer = 0; layer < 3; ++layer) {
+        subresources.push_back({level0, 0, layer});
+        subresources.push_back({level1, 1, layer});
+    }
+
+    const uint64_t submitCount = pNullQueue->GetSubmitCount();
+    ASSERT_EQ(grfx_util::CopyBitmapsToImage(queue, subresources, image, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_SHADER_RESOURCE), ppx::SUCCESS);
+    EXPECT_EQ(pNullQueue->GetSubmitCount() - submitCount, 1u);
+
+    // Nothing to copy or an empty bitmap fails without submitting
+    EXPECT_EQ(grfx_util::CopyBitmapsToImage(queue, {}, image, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_SHADER_RESOURCE), ppx::ERROR_BITMAP_BAD_COPY_SOURCE);
+    subresources.push_back({BitmapView(), 0, 0});
+    EXPECT_EQ(grfx_util::CopyBitmapsToImage(queue, subresources, image, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_SHADER_RESOURCE), ppx::ERROR_BITMAP_BAD_COPY_SOURCE);
+    EXPECT_EQ(pNullQueue->GetSubmitCount() - submitCount, 1u);
+
+    mDevice->DestroyImage(image);
+}
+
+TEST_F(GrfxNullTest, SharesShaderModulesByBytecode)
+{
+    const char codeA[] = "shader A bytecode";
+    const char codeB[] = "shader B bytecode";
+
+    grfx::ShaderModuleCreateInfo createInfoA = {sizeof(codeA), codeA};
+    grfx::ShaderModuleCreateInfo createInfoB = {sizeof(codeB), codeB};
+
+    grfx::ShaderModule* pModuleA0 = nullptr;
+    grfx::ShaderModule* pModuleA1 = nullptr;
+    grfx::ShaderModule* pModuleB  = nullptr;
+    ASSERT_EQ(mDevice->AcquireShaderModule(&createInfoA, &pModuleA0), ppx::SUCCESS);
+    ASSERT_EQ(mDevice->AcquireShaderModule(&createInfoB, &pModuleB), ppx::SUCCESS);
+
+    // Identical bytecode at a different address is the same module
+    std::vector<char> copyA(std::begin(codeA), std::end(codeA));
+    createInfoA.pCode = copyA.data();
+    ASSERT_EQ(mDevice->AcquireShaderModule(&createInfoA, &pModuleA1), ppx::SUCCESS);
+    EXPECT_EQ(pModuleA0, pModuleA1);
+    EXPECT_NE(pModuleA0, pModuleB);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pModuleA0), 2u);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pModuleB), 1u);
+
+    // Destroying releases one reference
+    mDevice->DestroyShaderModule(pModuleA0);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pModuleA1), 1u);
+    mDevice->DestroyShaderModule(pModuleA1);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pModuleA1), 0u);
+
+    // A released module is created again
+    grfx::ShaderModule* pModuleA2 = nullptr;
+    ASSERT_EQ(mDevice->AcquireShaderModule(&createInfoA, &pModuleA2), ppx::SUCCESS);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pModuleA2), 1u);
+
+    // Modules from CreateShaderModule() aren't shared
+    grfx::ShaderModule* pUnshared = nullptr;
+    ASSERT_EQ(mDevice->CreateShaderModule(&createInfoB, &pUnshared), ppx::SUCCESS);
+    EXPECT_NE(pUnshared, pModuleB);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pUnshared), 1u);
+    mDevice->DestroyShaderModule(pUnshared);
+    EXPECT_EQ(mDevice->GetShaderModuleReferenceCount(pModuleB), 1u);
+
+    mDevice->DestroyShaderModule(pModuleA2);
+    mDevice->DestroyShaderModule(pModuleB);
+}
+
+TEST_F(GrfxNullTest, RecordsDynamicOffsets)
+{
+    grfx::DescriptorSetLayoutCreateInfo layoutCreateInfo = {};
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(0, grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER));
+    layoutCreateInfo.bindings.push_back(grfx::DescriptorBinding(1, grfx::DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC));
+    grfx::DescriptorSetLayoutPtr layout;
+    ASSERT_EQ(mDevice->CreateDescriptorSetLayout(&layoutCreateInfo, &layout), ppx::SUCCESS);
+    EXPECT_EQ(layout->GetDynamicOffsetCount(), 1u);
+
+    grfx::DescriptorPoolCreateInfo poolCreateInfo = {};
+    poolCreateInfo.uniformBuffer                  = 1;
+    poolCreateInfo.uniformBufferDynamic           = 1;
+    grfx::DescriptorPoolPtr pool;
+    ASSERT_EQ(mDevice->CreateDescriptorPool(&poolCreateInfo, &pool), ppx::SUCCESS);
+
+    grfx::DescriptorSetPtr set;
+    ASSERT_EQ(mDevice->AllocateDescriptorSet(pool, layout, &set), ppx::SUCCESS);
+
+    grfx::PipelineInterfaceCreateInfo interfaceCreateInfo = {};
+    interfaceCreateInfo.setCount                          = 1;
+    interfaceCreateInfo.sets[0].set                       = 0;
+    interfaceCreateInfo.sets[0].pLayout                   = layout;
+    grfx::PipelineInterfacePtr pipelineInterface;
+    ASSERT_EQ(mDevice->CreatePipelineInterface(&interfaceCreateInfo, &pipelineInterface), ppx::SUCCESS);
+
+    grfx::null::ToApi(mDevice.Get())->SetCommandRecordingEnabled(true);
+
+    grfx::QueuePtr         queue = mDevice->GetGraphicsQueue();
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    const uint32_t dynamicOffset = 2 * PPX_UNIFORM_BUFFER_ALIGNMENT;
+    commandBuffer->BindGraphicsDescriptorSets(pipelineInterface, 1, &set, 1, &dynamicOffset);
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+
+    const grfx::null::CommandStream&   stream  = grfx::null::ToApi(commandBuffer.Get())->GetCommandStream();
+    size_t                             offset  = 0;
+    grfx::null::CommandStream::Command command = {};
+    ASSERT_TRUE(stream.Read(&offset, &command));
+    EXPECT_EQ(command.op, grfx::null::COMMAND_OP_BIND_GRAPHICS_DESCRIPTOR_SETS);
+    ASSERT_EQ(command.argCount, 5u);
+    EXPECT_EQ(command.pArgs[1], 1u);
+    EXPECT_EQ(command.pArgs[3], 1u);
+    EXPECT_EQ(command.pArgs[4], dynamicOffset);
+
+    queue->DestroyCommandBuffer(commandBuffer);
+}
+
+TEST_F(GrfxNullTest, FiltersRedundantState)
+{
+    grfx::DeviceCreateInfo deviceCreateInfo        = {};
+    deviceCreateInfo.pGpu                          = mDevice->GetGpu();
+    deviceCreateInfo.graphicsQueueCount            = 1;
+    deviceCreateInfo.enableRedundantStateFiltering = true;
+    grfx::DevicePtr device;
+    ASSERT_EQ(mInstance->CreateDevice(&deviceCreateInfo, &device), ppx::SUCCESS);
+    grfx::null::ToApi(device.Get())->SetCommandRecordingEnabled(true);
+
+    grfx::BufferCreateInfo bufferCreateInfo       = {};
+    bufferCreateInfo.size                         = 256;
+    bufferCreateInfo.usageFlags.bits.vertexBuffer = true;
+    bufferCreateInfo.usageFlags.bits.indexBuffer  = true;
+    bufferCreateInfo.memoryUsage                  = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    grfx::BufferPtr buffer;
+    ASSERT_EQ(device->CreateBuffer(&bufferCreateInfo, &buffer), ppx::SUCCESS);
+
+    grfx::QueuePtr         queue = device->GetGraphicsQueue();
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+    const grfx::null::CommandStream& stream = grfx::null::ToApi(commandBuffer.Get())->GetCommandStream();
+
+    const uint32_t stride = 16;
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    EXPECT_TRUE(commandBuffer->IsRedundantStateFilteringEnabled());
+    for (uint32_t i = 0; i < 4; ++i) {
+        commandBuffer->SetViewports(grfx::Viewport(0, 0, 64, 64));
+        commandBuffer->SetScissors(grfx::Rect(0, 0, 64, 64));
+        commandBuffer->BindIndexBuffer(buffer, grfx::INDEX_TYPE_UINT32);
+        commandBuffer->BindVertexBuffers(1, &buffer, &stride);
+        commandBuffer->DrawIndexed(3);
+    }
+    commandBuffer->SetViewports(grfx::Viewport(0, 0, 32, 32));
+    commandBuffer->BindIndexBuffer(buffer, grfx::INDEX_TYPE_UINT32, 4);
+    commandBuffer->InvalidateFilteredState();
+    commandBuffer->SetScissors(grfx::Rect(0, 0, 64, 64));
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_SET_VIEWPORTS), 2u);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_SET_SCISSORS), 2u);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_BIND_INDEX_BUFFER), 2u);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_BIND_VERTEX_BUFFERS), 1u);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_DRAW_INDEXED), 4u);
+
+    const grfx::CommandBufferStatistics& stats = commandBuffer->GetStatistics();
+    EXPECT_EQ(stats.submittedStateCommands, 7u);
+    EXPECT_EQ(stats.elidedStateCommands, 12u);
+
+    grfx::CommandBufferStatistics deviceStats = device->GetCommandBufferStatistics();
+    EXPECT_EQ(deviceStats.submittedStateCommands, 7u);
+    EXPECT_EQ(deviceStats.elidedStateCommands, 12u);
+    device->ResetCommandBufferStatistics();
+    EXPECT_EQ(device->GetCommandBufferStatistics().submittedStateCommands, 0u);
+
+    // Shadow state does not carry over between recordings
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    commandBuffer->SetViewports(grfx::Viewport(0, 0, 32, 32));
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_SET_VIEWPORTS), 1u);
+    EXPECT_EQ(commandBuffer->GetStatistics().submittedStateCommands, 1u);
+
+    queue->DestroyCommandBuffer(commandBuffer);
+    mInstance->DestroyDevice(device);
+}
+
+TEST_F(GrfxNullTest, ForwardsRedundantStateWhenFilteringDisabled)
+{
+    grfx::null::ToApi(mDevice.Get())->SetCommandRecordingEnabled(true);
+
+    grfx::QueuePtr         queue = mDevice->GetGraphicsQueue();
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    EXPECT_FALSE(commandBuffer->IsRedundantStateFilteringEnabled());
+    commandBuffer->SetViewports(grfx::Viewport(0, 0, 64, 64));
+    commandBuffer->SetViewports(grfx::Viewport(0, 0, 64, 64));
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+
+    const grfx::null::CommandStream& stream = grfx::null::ToApi(commandBuffer.Get())->GetCommandStream();
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_SET_VIEWPORTS), 2u);
+    EXPECT_EQ(commandBuffer->GetStatistics().submittedStateCommands, 2u);
+    EXPECT_EQ(commandBuffer->GetStatistics().elidedStateCommands, 0u);
+
+    queue->DestroyCommandBuffer(commandBuffer);
+}
+
+TEST_F(GrfxNullTest, BatchesBarriersAndTracksState)
+{
+    grfx::null::ToApi(mDevice.Get())->SetCommandRecordingEnabled(true);
+
+    grfx::ImageCreateInfo imageCreateInfo       = grfx::ImageCreateInfo::SampledImage2D(64, 64, grfx::FORMAT_R8G8B8A8_UNORM);
+    imageCreateInfo.mipLevelCount               = 4;
+    imageCreateInfo.usageFlags.bits.transferDst = true;
+    imageCreateInfo.initialState                = grfx::RESOURCE_STATE_SHADER_RESOURCE;
+    grfx::ImagePtr image0;
+    grfx::ImagePtr image1;
+    ASSERT_EQ(mDevice->CreateImage(&imageCreateInfo, &image0), ppx::SUCCESS);
+    ASSERT_EQ(mDevice->CreateImage(&imageCreateInfo, &image1), ppx::SUCCESS);
+
+    grfx::BufferCreateInfo bufferCreateInfo       = {};
+    bufferCreateInfo.size                         = 256;
+    bufferCreateInfo.usageFlags.bits.vertexBuffer = true;
+    bufferCreateInfo.memoryUsage                  = grfx::MEMORY_USAGE_GPU_ONLY;
+    bufferCreateInfo.initialState                 = grfx::RESOURCE_STATE_VERTEX_BUFFER;
+    grfx::BufferPtr buffer;
+    ASSERT_EQ(mDevice->CreateBuffer(&bufferCreateInfo, &buffer), ppx::SUCCESS);
+    EXPECT_EQ(buffer->GetResourceState(), grfx::RESOURCE_STATE_VERTEX_BUFFER);
+
+    grfx::QueuePtr         queue = mDevice->GetGraphicsQueue();
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+    const grfx::null::CommandStream& stream = grfx::null::ToApi(commandBuffer.Get())->GetCommandStream();
+
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    // Independent resources go out as one barrier right before the draw
+    commandBuffer->TransitionImageLayout(image0, 0, 1, 0, 1, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_COPY_DST);
+    commandBuffer->TransitionImageLayout(image1, PPX_ALL_SUBRESOURCES, grfx::RESOURCE_STATE_SHADER_RESOURCE, grfx::RESOURCE_STATE_COPY_DST);
+    commandBuffer->BufferResourceBarrier(buffer, grfx::RESOURCE_STATE_COPY_DST);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_PIPELINE_BARRIER), 0u);
+    commandBuffer->Draw(3);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_PIPELINE_BARRIER), 1u);
+
+    // Transitioning the same subresources again flushes the earlier barrier first
+    commandBuffer->TransitionImageLayout(image0, 0, 1, 0, 1, grfx::RESOURCE_STATE_COPY_DST, grfx::RESOURCE_STATE_COPY_SRC);
+    commandBuffer->TransitionImageLayout(image0, 0, 1, 0, 1, grfx::RESOURCE_STATE_COPY_SRC, grfx::RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_PIPELINE_BARRIER), 2u);
+
+    // Mip 0 of image0 is back to SHADER_RESOURCE so all mips share a state
+    EXPECT_EQ(image0->GetSubresourceState(0, 0), grfx::RESOURCE_STATE_SHADER_RESOURCE);
+    EXPECT_EQ(image1->GetSubresourceState(3, 0), grfx::RESOURCE_STATE_COPY_DST);
+    EXPECT_EQ(buffer->GetResourceState(), grfx::RESOURCE_STATE_COPY_DST);
+
+    // Inferred transition splits by the state each mip is in
+    commandBuffer->TransitionImageLayout(image1, 1, 1, 0, 1, grfx::RESOURCE_STATE_RENDER_TARGET);
+    commandBuffer->TransitionImageLayout(image1, PPX_ALL_SUBRESOURCES, grfx::RESOURCE_STATE_SHADER_RESOURCE);
+    commandBuffer->BufferResourceBarrier(buffer, grfx::RESOURCE_STATE_VERTEX_BUFFER);
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+    EXPECT_EQ(stream.GetCommandCount(grfx::null::COMMAND_OP_PIPELINE_BARRIER), 4u);
+
+    for (uint32_t mip = 0; mip < image1->GetMipLevelCount(); ++mip) {
+        EXPECT_EQ(image1->GetSubresourceState(mip, 0), grfx::RESOURCE_STATE_SHADER_RESOURCE);
+    }
+    EXPECT_EQ(buffer->GetResourceState(), grfx::RESOURCE_STATE_VERTEX_BUFFER);
+
+    // Mip 1 overlaps the pending RENDER_TARGET barrier so the last batch
+    // starts there: mip 1, mips 2..3 and the buffer
+    size_t                             offset  = 0;
+    grfx::null::CommandStream::Command command = {};
+    grfx::null::CommandStream::Command last    = {};
+    while (stream.Read(&offset, &command)) {
+        if (command.op == grfx::null::COMMAND_OP_PIPELINE_BARRIER) {
+            last = command;
+        }
+    }
+    ASSERT_EQ(last.op, grfx::null::COMMAND_OP_PIPELINE_BARRIER);
+    EXPECT_EQ(last.pArgs[0], 2u);
+    EXPECT_EQ(last.pArgs[1], 1u);
+    EXPECT_EQ(last.pArgs[2 + 1], 1u);
+    EXPECT_EQ(last.pArgs[2 + 5], static_cast<uint32_t>(grfx::RESOURCE_STATE_RENDER_TARGET));
+    EXPECT_EQ(last.pArgs[2 + 8 + 1], 2u);
+    EXPECT_EQ(last.pArgs[2 + 8 + 2], 2u);
+    EXPECT_EQ(last.pArgs[2 + 8 + 5], static_cast<uint32_t>(grfx::RESOURCE_STATE_COPY_DST));
+
+    queue->DestroyCommandBuffer(commandBuffer);
+}
+
+TEST_F(GrfxNullTest, PersistentlyMapsBuffers)
+{
+    grfx::BufferCreateInfo bufferCreateInfo      = {};
+    bufferCreateInfo.size                        = 256;
+    bufferCreateInfo.usageFlags.bits.transferSrc = true;
+    bufferCreateInfo.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    bufferCreateInfo.persistentMap               = true;
+    grfx::BufferPtr buffer;
+    ASSERT_EQ(mDevice->CreateBuffer(&bufferCreateInfo, &buffer), ppx::SUCCESS);
+    ASSERT_TRUE(buffer->IsPersistentlyMapped());
+    ASSERT_NE(buffer->GetMappedAddress(), nullptr);
+
+    // MapMemory hands out the persistent mapping
+    void* pMappedAddress = nullptr;
+    ASSERT_EQ(buffer->MapMemory(16, &pMappedAddress), ppx::SUCCESS);
+    EXPECT_EQ(pMappedAddress, static_cast<char*>(buffer->GetMappedAddress()) + 16);
+    buffer->UnmapMemory();
+    EXPECT_EQ(buffer->GetMappedAddress(), static_cast<char*>(pMappedAddress) - 16);
+
+    const uint32_t srcData[4] = {1, 2, 3, 4};
+    uint32_t       dstData[4] = {};
+    ASSERT_EQ(buffer->CopyFromSource(sizeof(srcData), srcData), ppx::SUCCESS);
+    ASSERT_EQ(buffer->CopyToDest(sizeof(dstData), dstData), ppx::SUCCESS);
+    EXPECT_EQ(dstData[3], 4u);
+
+    EXPECT_EQ(buffer->FlushRange(), ppx::SUCCESS);
+    EXPECT_EQ(buffer->FlushRange(128, PPX_WHOLE_SIZE), ppx::SUCCESS);
+    EXPECT_EQ(buffer->InvalidateRange(0, 256), ppx::SUCCESS);
+
+    // GPU only memory can't be mapped
+    bufferCreateInfo.memoryUsage = grfx::MEMORY_USAGE_GPU_ONLY;
+    grfx::BufferPtr gpuBuffer;
+    EXPECT_DEATH({
+        mDevice->CreateBuffer(&bufferCreateInfo, &gpuBuffer);
+    },
+                 "");
+}
+
+TEST_F(GrfxNullTest, TracksMemoryStatistics)
+{
+    const grfx::MemoryStatistics initialStats = mDevice->GetMemoryStatistics();
+    EXPECT_FALSE(initialStats.heaps.empty());
+
+    grfx::BufferCreateInfo bufferCreateInfo      = {};
+    bufferCreateInfo.size                        = 1024;
+    bufferCreateInfo.usageFlags.bits.transferSrc = true;
+    bufferCreateInfo.memoryUsage                 = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    grfx::BufferPtr buffer;
+    ASSERT_EQ(mDevice->CreateBuffer(&bufferCreateInfo, &buffer), ppx::SUCCESS);
+    EXPECT_EQ(buffer->GetMemoryCategory(), grfx::MEMORY_CATEGORY_STAGING);
+    EXPECT_EQ(buffer->GetAllocationSize(), 1024u);
+
+    grfx::ImageCreateInfo imageCreateInfo = grfx::ImageCreateInfo::RenderTarget2D(64, 64, grfx::FORMAT_R8G8B8A8_UNORM);
+    grfx::ImagePtr        image;
+    ASSERT_EQ(mDevice->CreateImage(&imageCreateInfo, &image), ppx::SUCCESS);
+    EXPECT_EQ(image->GetMemoryCategory(), grfx::MEMORY_CATEGORY_RENDER_TARGET);
+    EXPECT_EQ(image->GetAllocationSize(), 64u * 64u * 4u);
+
+    const grfx::MemoryCategoryStatistics& initialStaging      = initialStats.categories[grfx::MEMORY_CATEGORY_STAGING];
+    const grfx::MemoryCategoryStatistics& initialRenderTarget = initialStats.categories[grfx::MEMORY_CATEGORY_RENDER_TARGET];
+
+    grfx::MemoryStatistics stats = mDevice->GetMemoryStatistics();
+    EXPECT_EQ(stats.categories[grfx::MEMORY_CATEGORY_STAGING].allocationCount, initialStaging.allocationCount + 1);
+    EXPECT_EQ(stats.categories[grfx::MEMORY_CATEGORY_STAGING].allocationBytes, initialStaging.allocationBytes + 1024);
+    EXPECT_EQ(stats.categories[grfx::MEMORY_CATEGORY_RENDER_TARGET].allocationCount, initialRenderTarget.allocationCount + 1);
+    EXPECT_EQ(stats.GetCategoryAllocationBytes(), initialStats.GetCategoryAllocationBytes() + 1024 + 64 * 64 * 4);
+
+    // Destroying releases the bytes but keeps the peak
+    mDevice->DestroyBuffer(buffer);
+    mDevice->DestroyImage(image);
+    stats = mDevice->GetMemoryStatistics();
+    EXPECT_EQ(stats.categories[grfx::MEMORY_CATEGORY_STAGING].allocationCount, initialStaging.allocationCount);
+    EXPECT_EQ(stats.categories[grfx::MEMORY_CATEGORY_STAGING].allocationBytes, initialStaging.allocationBytes);
+    EXPECT_GE(stats.categories[grfx::MEMORY_CATEGORY_STAGING].peakAllocationBytes, initialStaging.allocationBytes + 1024);
+    EXPECT_EQ(stats.GetCategoryAllocationBytes(), initialStats.GetCategoryAllocationBytes());
+}
+
+TEST_F(GrfxNullTest, SubAllocatesBuffersFromMemoryPool)
+{
+    grfx::MemoryPoolCreateInfo poolCreateInfo    = {};
+    poolCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    poolCreateInfo.usageFlags.bits.uniformBuffer = true;
+    poolCreateInfo.blockSize                     = 64 * 1024;
+    poolCreateInfo.maxBlockCount                 = 1;
+    grfx::MemoryPoolPtr pool;
+    ASSERT_EQ(mDevice->CreateMemoryPool(&poolCreateInfo, &pool), ppx::SUCCESS);
+
+    grfx::BufferCreateInfo bufferCreateInfo        = {};
+    bufferCreateInfo.size                          = PPX_MINIMUM_UNIFORM_BUFFER_SIZE;
+    bufferCreateInfo.usageFlags.bits.uniformBuffer = true;
+    bufferCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    bufferCreateInfo.pMemoryPool                   = pool;
+
+    std::vector<grfx::BufferPtr> buffers(16);
+    for (auto& buffer : buffers) {
+        ASSERT_EQ(mDevice->CreateBuffer(&bufferCreateInfo, &buffer), ppx::SUCCESS);
+        EXPECT_EQ(buffer->GetMemoryPool(), pool.Get());
+    }
+
+    grfx::MemoryPoolStatistics stats = pool->GetStatistics();
+    EXPECT_EQ(stats.blockCount, 1u);
+    EXPECT_EQ(stats.allocationCount, 16u);
+    EXPECT_EQ(stats.allocationBytes, 16u * PPX_MINIMUM_UNIFORM_BUFFER_SIZE);
+
+    // A single block can't hold more than its size
+    grfx::BufferCreateInfo largeCreateInfo = bufferCreateInfo;
+    largeCreateInfo.size                   = 128 * 1024;
+    grfx::BufferPtr largeBuffer;
+    EXPECT_EQ(mDevice->CreateBuffer(&largeCreateInfo, &largeBuffer), ppx::ERROR_OUT_OF_MEMORY);
+
+    for (auto& buffer : buffers) {
+        mDevice->DestroyBuffer(buffer);
+    }
+    stats = pool->GetStatistics();
+    EXPECT_EQ(stats.allocationCount, 0u);
+    EXPECT_EQ(stats.allocationBytes, 0u);
+    mDevice->DestroyMemoryPool(pool);
+}
+
+TEST_F(GrfxNullTest, RejectsBuffersIncompatibleWithMemoryPool)
+{
+    grfx::MemoryPoolCreateInfo poolCreateInfo    = {};
+    poolCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    poolCreateInfo.usageFlags.bits.uniformBuffer = true;
+    poolCreateInfo.algorithm                     = grfx::MEMORY_POOL_ALGORITHM_LINEAR;
+    grfx::MemoryPoolPtr pool;
+    ASSERT_EQ(mDevice->CreateMemoryPool(&poolCreateInfo, &pool), ppx::SUCCESS);
+    EXPECT_EQ(pool->GetAlgorithm(), grfx::MEMORY_POOL_ALGORITHM_LINEAR);
+
+    grfx::BufferCreateInfo bufferCreateInfo        = {};
+    bufferCreateInfo.size                          = PPX_MINIMUM_UNIFORM_BUFFER_SIZE;
+    bufferCreateInfo.usageFlags.bits.uniformBuffer = true;
+    bufferCreateInfo.usageFlags.bits.vertexBuffer  = true;
+    bufferCreateInfo.memoryUsage                   = grfx::MEMORY_USAGE_CPU_TO_GPU;
+    bufferCreateInfo.pMemoryPool                   = pool;
+    grfx::BufferPtr buffer;
+    EXPECT_DEATH({
+        mDevice->CreateBuffer(&bufferCreateInfo, &buffer);
+    },
+                 "");
+
+    bufferCreateInfo.usageFlags.bits.vertexBuffer = false;
+    bufferCreateInfo.memoryUsage                  = grfx::MEMORY_USAGE_GPU_ONLY;
+    EXPECT_DEATH({
+        mDevice->CreateBuffer(&bufferCreateInfo, &buffer);
+    },
+                 "");
+}
+
+#endif // defined(PPX_NULL)
@@ -0,0 +1,213 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/grfx/grfx_instance.h"
+#include "ppx/grfx/grfx_device.h"
+#include "ppx/grfx/grfx_render_graph.h"
+#include "ppx/grfx/null/null_command.h"
+#include "ppx/grfx/null/null_device.h"
+#include "ppx/grfx/null/null_image.h"
+
+using namespace ppx;
+
+#if defined(PPX_NULL)
+
+namespace {
+
+class GrfxRenderGraphTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        grfx::InstanceCreateInfo instanceCreateInfo = {};
+        instanceCreateInfo.api                      = grfx::API_NULL;
+        ASSERT_EQ(grfx::CreateInstance(&instanceCreateInfo, &mInstance), ppx::SUCCESS);
+
+        grfx::GpuPtr gpu;
+        ASSERT_EQ(mInstance->GetGpu(0, &gpu), ppx::SUCCESS);
+
+        grfx::DeviceCreateInfo deviceCreateInfo = {};
+        deviceCreateInfo.pGpu                   = gpu;
+        deviceCreateInfo.graphicsQueueCount     = 1;
+        ASSERT_EQ(mInstance->CreateDevice(&deviceCreateInfo, &mDevice), ppx::SUCCESS);
+
+        grfx::ImageCreateInfo imageCreateInfo           = {};
+        imageCreateInfo.type                            = grfx::IMAGE_TYPE_2D;
+        imageCreateInfo.width                           = 64;
+        imageCreateInfo.height                          = 64;
+        imageCreateInfo.depth                           = 1;
+        imageCreateInfo.format                          = grfx::FORMAT_R8G8B8A8_UNORM;
+        imageCreateInfo.usageFlags.bits.colorAttachment = true;
+        imageCreateInfo.initialState                    = grfx::RESOURCE_STATE_PRESENT;
+        ASSERT_EQ(mDevice->CreateImage(&imageCreateInfo, &mBackbuffer), ppx::SUCCESS);
+    }
+
+    void TearDown() override
+    {
+        if (mInstance) {
+            grfx::DestroyInstance(mInstance);
+        }
+    }
+
+    // scene -> bloom -> tonemap -> composite, plus a debug pass nothing reads
+    void DeclareGraph(grfx::RenderGraph& graph)
+    {
+        grfx::RenderGraphImageCreateInfo colorCreateInfo = {};
+        colorCreateInfo.width                            = 64;
+        colorCreateInfo.height                           = 64;
+        colorCreateInfo.format                           = grfx::FORMAT_R16G16B16A16_FLOAT;
+
+        mBackbufferHandle = graph.ImportImage(mBackbuffer, grfx::RESOURCE_STATE_PRESENT);
+        mScene            = graph.CreateImage(colorCreateInfo);
+        mBloom            = graph.CreateImage(colorCreateInfo);
+        mTonemapped       = graph.CreateImage(colorCreateInfo);
+        mDebug            = graph.CreateImage(colorCreateInfo);
+
+        grfx::RenderGraphPassCreateInfo scene = {};
+        scene.name                            = "scene";
+        scene.renderTargetCount               = 1;
+        scene.renderTargets[0]                = mScene;
+        ASSERT_EQ(graph.AddPass(scene), ppx::SUCCESS);
+
+        grfx::RenderGraphPassCreateInfo bloom = {};
+        bloom.name                            = "bloom";
+        bloom.renderTargetCount               = 1;
+        bloom.renderTargets[0]                = mBloom;
+        bloom.reads.push_back({mScene, grfx::RESOURCE_STATE_SHADER_RESOURCE});
+        ASSERT_EQ(graph.AddPass(bloom), ppx::SUCCESS);
+
+        grfx::RenderGraphPassCreateInfo tonemap = {};
+        tonemap.name                            = "tonemap";
+        tonemap.renderTargetCount               = 1;
+        tonemap.renderTargets[0]                = mTonemapped;
+        tonemap.reads.push_back({mBloom, grfx::RESOURCE_STATE_SHADER_RESOURCE});
+        ASSERT_EQ(graph.AddPass(tonemap), ppx::SUCCESS);
+
+        grfx::RenderGraphPassCreateInfo debug = {};
+        debug.name                            = "debug";
+        debug.renderTargetCount               = 1;
+        debug.renderTargets[0]                = mDebug;
+        debug.reads.push_back({mScene, grfx::RESOURCE_STATE_SHADER_RESOURCE});
+        ASSERT_EQ(graph.AddPass(debug), ppx::SUCCESS);
+
+        grfx::RenderGraphPassCreateInfo composite = {};
+        composite.name                            = "composite";
+        composite.renderTargetCount               = 1;
+        composite.renderTargets[0]                = mBackbufferHandle;
+        composite.reads.push_back({mTonemapped, grfx::RESOURCE_STATE_SHADER_RESOURCE});
+        composite.execute = [this](grfx::CommandBuffer* pCommandBuffer, const grfx::RenderGraph& graph) {
+            mCompositeExecuted = true;
+            pCommandBuffer->Draw(3);
+        };
+        ASSERT_EQ(graph.AddPass(composite), ppx::SUCCESS);
+    }
+
+    grfx::InstancePtr      mInstance;
+    grfx::DevicePtr        mDevice;
+    grfx::ImagePtr         mBackbuffer;
+    grfx::RenderGraphImage mBackbufferHandle;
+    grfx::RenderGraphImage mScene;
+    grfx::RenderGraphImage mBloom;
+    grfx::RenderGraphImage mTonemapped;
+    grfx::RenderGraphImage mDebug;
+    bool                   mCompositeExecuted = false;
+};
+
+} // namespace
+
+TEST_F(GrfxRenderGraphTest, CullsPassesAndAliasesTransientImages)
+{
+    grfx::RenderGraph graph(mDevice);
+    DeclareGraph(graph);
+    ASSERT_EQ(graph.Compile(), ppx::SUCCESS);
+
+    EXPECT_FALSE(graph.IsPassCulled(0));
+    EXPECT_FALSE(graph.IsPassCulled(2));
+    EXPECT_TRUE(graph.IsPassCulled(3));
+    EXPECT_EQ(graph.GetImage(mDebug), nullptr);
+    EXPECT_EQ(graph.GetImage(mBackbufferHandle), mBackbuffer.Get());
+
+    // scene is dead once bloom is done, so tonemap can reuse its memory
+    EXPECT_EQ(graph.GetMemoryAliasImage(mScene), nullptr);
+    EXPECT_EQ(graph.GetMemoryAliasImage(mBloom), nullptr);
+    EXPECT_EQ(graph.GetMemoryAliasImage(mTonemapped), graph.GetImage(mScene));
+
+    const grfx::RenderGraphStatistics& stats = graph.GetStatistics();
+    EXPECT_EQ(stats.passCount, 5u);
+    EXPECT_EQ(stats.culledPassCount, 1u);
+    EXPECT_EQ(stats.transientImageCount, 3u);
+    EXPECT_EQ(stats.aliasedImageCount, 1u);
+    EXPECT_EQ(stats.allocatedMemorySize * 3, stats.transientMemorySize * 2);
+}
+
+TEST_F(GrfxRenderGraphTest, AllocatesSeparatelyWithoutAliasing)
+{
+    grfx::RenderGraph graph(mDevice);
+    DeclareGraph(graph);
+    ASSERT_EQ(graph.Compile(false), ppx::SUCCESS);
+
+    EXPECT_EQ(graph.GetMemoryAliasImage(mTonemapped), nullptr);
+    EXPECT_EQ(graph.GetStatistics().aliasedImageCount, 0u);
+    EXPECT_EQ(graph.GetStatistics().allocatedMemorySize, graph.GetStatistics().transientMemorySize);
+}
+
+TEST_F(GrfxRenderGraphTest, ExecuteDiscardsAliasedImages)
+{
+    grfx::null::ToApi(mDevice.Get())->SetCommandRecordingEnabled(true);
+
+    grfx::RenderGraph graph(mDevice);
+    DeclareGraph(graph);
+    ASSERT_EQ(graph.Compile(), ppx::SUCCESS);
+
+    grfx::QueuePtr         queue = mDevice->GetGraphicsQueue();
+    grfx::CommandBufferPtr commandBuffer;
+    ASSERT_EQ(queue->CreateCommandBuffer(&commandBuffer), ppx::SUCCESS);
+    ASSERT_EQ(commandBuffer->Begin(), ppx::SUCCESS);
+    ASSERT_EQ(graph.Execute(commandBuffer), ppx::SUCCESS);
+    ASSERT_EQ(commandBuffer->End(), ppx::SUCCESS);
+
+    EXPECT_TRUE(mCompositeExecuted);
+    EXPECT_EQ(mBackbuffer->GetSubresourceState(0, 0), grfx::RESOURCE_STATE_PRESENT);
+
+    // Only the images sharing memory discard their contents on first use
+    const uint32_t sceneHandle      = grfx::null::ToApi(graph.GetImage(mScene))->GetNullHandle();
+    const uint32_t bloomHandle      = grfx::null::ToApi(graph.GetImage(mBloom))->GetNullHandle();
+    const uint32_t tonemappedHandle = grfx::null::ToApi(graph.GetImage(mTonemapped))->GetNullHandle();
+
+    const grfx::null::CommandStream&   stream  = grfx::null::ToApi(commandBuffer.Get())->GetCommandStream();
+    size_t                             offset  = 0;
+    grfx::null::CommandStream::Command command = {};
+    std::vector<uint32_t>              discardedHandles;
+    while (stream.Read(&offset, &command)) {
+        if (command.op != grfx::null::COMMAND_OP_PIPELINE_BARRIER) {
+            continue;
+        }
+        const uint32_t* pArgs = command.pArgs + 2;
+        for (uint32_t i = 0; i < command.pArgs[0]; ++i, pArgs += 8) {
+            if (pArgs[7] != 0) {
+                discardedHandles.push_back(pArgs[0]);
+            }
+        }
+    }
+    ASSERT_EQ(discardedHandles.size(), 2u);
+    EXPECT_EQ(discardedHandles[0], sceneHandle);
+    EXPECT_EQ(discardedHandles[1], tonemappedHandle);
+    EXPECT_NE(bloomHandle, tonemappedHandle);
+
+    queue->DestroyCommandBuffer(commandBuffer);
+}
+
+#endif // defined(PPX_NULL)
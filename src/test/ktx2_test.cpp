@@ -0,0 +1,218 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/ktx2.h"
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+using namespace ppx;
+
+namespace {
+
+// vkFormat of VK_FORMAT_R8G8B8A8_UNORM
+constexpr uint32_t kVkFormatRGBA8 = 37;
+
+// Zstandard frame of a 4x4 RGBA8 level where every texel is (0x3F, 0x7F, 0xBF, 0xFF)
+const uint8_t kZstdLevel[] = {0x28, 0xB5, 0x2F, 0xFD, 0x20, 0x40, 0x55, 0x00, 0x00, 0x20, 0x3F, 0x7F, 0xBF, 0xFF, 0x01, 0x00, 0x59, 0x72, 0x44};
+
+class Ktx2Test : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        path = std::filesystem::temp_directory_path() / ("ppx_ktx2_test_" + std::to_string(::testing::UnitTest::GetInstance()->random_seed()) + ".ktx2");
+    }
+
+    void TearDown() override
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    // Writes a KTX2 file, levels[0] is the largest level. Level data is
+    // stored smallest level first like libktx does.
+    void WriteFile(
+        uint32_t                              width,
+        uint32_t                              height,
+        Ktx2Supercompression                  supercompression,
+        const std::vector<std::vector<char>>& levels,
+        const std::vector<uint64_t>&          uncompressedSizes)
+    {
+        Ktx2Header header = {};
+        std::memcpy(header.identifier, Ktx2File::kIdentifier, sizeof(header.identifier));
+        header.vkFormat               = kVkFormatRGBA8;
+        header.typeSize               = 1;
+        header.pixelWidth             = width;
+        header.pixelHeight            = height;
+        header.faceCount              = 1;
+        header.levelCount             = static_cast<uint32_t>(levels.size());
+        header.supercompressionScheme = supercompression;
+
+        std::vector<Ktx2LevelIndex> index(levels.size());
+        uint64_t                    offset = sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * levels.size();
+        for (size_t level = levels.size(); level-- > 0;) {
+            index[level].byteOffset             = offset;
+            index[level].byteLength             = levels[level].size();
+            index[level].uncompressedByteLength = uncompressedSizes[level];
+            offset += levels[level].size();
+        }
+
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(index.data()), sizeof(Ktx2LevelIndex) * index.size());
+        for (size_t level = levels.size(); level-- > 0;) {
+            file.write(levels[level].data(), levels[level].size());
+        }
+    }
+
+    // Level data where each byte identifies its level and position
+    static std::vector<char> MakeLevel(uint32_t level, size_t size)
+    {
+        std::vector<char> data(size);
+        for (size_t i = 0; i < size; ++i) {
+            data[i] = static_cast<char>(level * 64 + i);
+        }
+        return data;
+    }
+
+    std::filesystem::path path;
+};
+
+} // namespace
+
+TEST_F(Ktx2Test, OpenReadsHeaderAndLevels)
+{
+    std::vector<std::vector<char>> levels = {MakeLevel(0, 8 * 4 * 4), MakeLevel(1, 4 * 2 * 4), MakeLevel(2, 2 * 1 * 4), MakeLevel(3, 1 * 1 * 4)};
+    WriteFile(8, 4, KTX2_SUPERCOMPRESSION_NONE, levels, {128, 32, 8, 4});
+
+    Ktx2File file;
+    ASSERT_EQ(file.Open(path), ppx::SUCCESS);
+    EXPECT_TRUE(file.IsOpen());
+    EXPECT_EQ(file.GetFormat(), grfx::FORMAT_R8G8B8A8_UNORM);
+    EXPECT_EQ(file.GetWidth(), 8u);
+    EXPECT_EQ(file.GetHeight(), 4u);
+    EXPECT_EQ(file.GetDepth(), 1u);
+    EXPECT_EQ(file.GetArrayLayerCount(), 1u);
+    EXPECT_EQ(file.GetFaceCount(), 1u);
+    EXPECT_EQ(file.GetLevelCount(), 4u);
+    EXPECT_EQ(file.GetSupercompression(), KTX2_SUPERCOMPRESSION_NONE);
+    EXPECT_EQ(file.GetLevelWidth(2), 2u);
+    EXPECT_EQ(file.GetLevelHeight(2), 1u);
+    EXPECT_EQ(file.GetLevelHeight(3), 1u);
+
+    for (uint32_t level = 0; level < file.GetLevelCount(); ++level) {
+        ASSERT_EQ(file.GetLevelSize(level), levels[level].size());
+        ASSERT_EQ(file.GetLevelDataSize(level), levels[level].size());
+        EXPECT_EQ(std::memcmp(file.GetLevelData(level), levels[level].data(), levels[level].size()), 0);
+
+        std::vector<char> data(static_cast<size_t>(file.GetLevelSize(level)));
+        ASSERT_EQ(file.ReadLevel(level, data.data(), data.size()), ppx::SUCCESS);
+        EXPECT_EQ(data, levels[level]);
+    }
+}
+
+TEST_F(Ktx2Test, ReadLevelChecksArguments)
+{
+    WriteFile(1, 1, KTX2_SUPERCOMPRESSION_NONE, {MakeLevel(0, 4)}, {4});
+
+    Ktx2File file;
+    ASSERT_EQ(file.Open(path), ppx::SUCCESS);
+
+    char data[4] = {};
+    EXPECT_EQ(file.ReadLevel(1, data, sizeof(data)), ppx::ERROR_OUT_OF_RANGE);
+    EXPECT_EQ(file.ReadLevel(0, data, sizeof(data) - 1), ppx::ERROR_OUT_OF_RANGE);
+    EXPECT_EQ(file.GetLevelData(1), nullptr);
+    EXPECT_EQ(file.GetLevelDataSize(1), 0u);
+}
+
+TEST_F(Ktx2Test, OpenRejectsBadIdentifier)
+{
+    WriteFile(1, 1, KTX2_SUPERCOMPRESSION_NONE, {MakeLevel(0, 4)}, {4});
+    {
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(1);
+        file.put('X');
+    }
+
+    Ktx2File file;
+    EXPECT_EQ(file.Open(path), ppx::ERROR_BAD_DATA_SOURCE);
+    EXPECT_FALSE(file.IsOpen());
+}
+
+TEST_F(Ktx2Test, OpenRejectsTruncatedFile)
+{
+    WriteFile(4, 4, KTX2_SUPERCOMPRESSION_NONE, {MakeLevel(0, 64)}, {64});
+    std::filesystem::resize_file(path, std::filesystem::file_size(path) - 1);
+
+    Ktx2File file;
+    EXPECT_EQ(file.Open(path), ppx::ERROR_BAD_DATA_SOURCE);
+    EXPECT_FALSE(file.IsOpen());
+}
+
+TEST_F(Ktx2Test, OpenRejectsWrongLevelSize)
+{
+    WriteFile(4, 4, KTX2_SUPERCOMPRESSION_NONE, {MakeLevel(0, 32)}, {32});
+
+    Ktx2File file;
+    EXPECT_EQ(file.Open(path), ppx::ERROR_BAD_DATA_SOURCE);
+}
+
+TEST_F(Ktx2Test, OpenMissingFileFails)
+{
+    Ktx2File file;
+    EXPECT_EQ(file.Open(path), ppx::ERROR_PATH_DOES_NOT_EXIST);
+}
+
+TEST_F(Ktx2Test, ZstdLevel)
+{
+    WriteFile(4, 4, KTX2_SUPERCOMPRESSION_ZSTD, {std::vector<char>(std::begin(kZstdLevel), std::end(kZstdLevel))}, {64});
+
+    Ktx2File file;
+    ASSERT_EQ(file.Open(path), ppx::SUCCESS);
+    EXPECT_EQ(file.GetSupercompression(), KTX2_SUPERCOMPRESSION_ZSTD);
+    EXPECT_EQ(file.GetLevelSize(0), 64u);
+    EXPECT_EQ(file.GetLevelDataSize(0), sizeof(kZstdLevel));
+
+    std::vector<uint8_t> data(64);
+#if defined(PPX_ENABLE_ZSTD)
+    ASSERT_EQ(file.ReadLevel(0, data.data(), data.size()), ppx::SUCCESS);
+    for (size_t i = 0; i < data.size(); ++i) {
+        EXPECT_EQ(data[i], static_cast<uint8_t>(0x3F + (i % 4) * 0x40)) << "byte " << i;
+    }
+#else
+    EXPECT_EQ(file.ReadLevel(0, data.data(), data.size()), ppx::ERROR_IMAGE_FILE_LOAD_FAILED);
+#endif
+}
+
+TEST(Ktx2FileTest, IsKtx2File)
+{
+    EXPECT_TRUE(Ktx2File::IsKtx2File("textures/albedo.ktx2"));
+    EXPECT_TRUE(Ktx2File::IsKtx2File("ALBEDO.KTX2"));
+    EXPECT_FALSE(Ktx2File::IsKtx2File("textures/albedo.ktx"));
+    EXPECT_FALSE(Ktx2File::IsKtx2File("textures/albedo.dds"));
+}
+
+TEST(Ktx2FileTest, ToGrfxFormat)
+{
+    EXPECT_EQ(Ktx2File::ToGrfxFormat(kVkFormatRGBA8), grfx::FORMAT_R8G8B8A8_UNORM);
+    EXPECT_EQ(Ktx2File::ToGrfxFormat(43), grfx::FORMAT_R8G8B8A8_SRGB);
+    EXPECT_EQ(Ktx2File::ToGrfxFormat(131), grfx::FORMAT_BC1_RGB_UNORM);
+    EXPECT_EQ(Ktx2File::ToGrfxFormat(145), grfx::FORMAT_BC7_UNORM);
+    EXPECT_EQ(Ktx2File::ToGrfxFormat(0), grfx::FORMAT_UNDEFINED);
+    EXPECT_EQ(Ktx2File::ToGrfxFormat(1000156000), grfx::FORMAT_UNDEFINED);
+}
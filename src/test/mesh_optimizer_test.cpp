@@ -0,0 +1,186 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/mesh_optimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace ppx;
+
+namespace {
+
+// Indices of a (n x n) quad grid with triangles in random order
+std::vector<uint32_t> CreateShuffledGrid(uint32_t n, uint32_t* pVertexCount)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (uint32_t y = 0; y < n; ++y) {
+        for (uint32_t x = 0; x < n; ++x) {
+            uint32_t v0 = y * (n + 1) + x;
+            uint32_t v1 = v0 + 1;
+            uint32_t v2 = v0 + (n + 1);
+            uint32_t v3 = v2 + 1;
+            triangles.push_back({v0, v2, v1});
+            triangles.push_back({v1, v2, v3});
+        }
+    }
+    std::shuffle(triangles.begin(), triangles.end(), std::mt19937(1234));
+
+    std::vector<uint32_t> indices;
+    for (const auto& tri : triangles) {
+        indices.insert(indices.end(), tri.begin(), tri.end());
+    }
+    *pVertexCount = (n + 1) * (n + 1);
+    return indices;
+}
+
+// Triangles with rotation normalized so winding is preserved, sorted
+std::vector<std::array<uint32_t, 3>> CanonicalTriangles(const std::vector<uint32_t>& indices)
+{
+    std::vector<std::array<uint32_t, 3>> triangles;
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        std::array<uint32_t, 3> tri = {indices[i], indices[i + 1], indices[i + 2]};
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+        triangles.push_back(tri);
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, AnalyzeVertexCacheSingleTriangle)
+{
+    const uint32_t        indices[] = {0, 1, 2};
+    VertexCacheStatistics stats     = MeshOptimizer::AnalyzeVertexCache(indices, 3, 3);
+    EXPECT_EQ(stats.triangleCount, 1u);
+    EXPECT_EQ(stats.vertexCount, 3u);
+    EXPECT_EQ(stats.transformCount, 3u);
+    EXPECT_FLOAT_EQ(stats.acmr, 3.0f);
+    EXPECT_FLOAT_EQ(stats.atvr, 1.0f);
+}
+
+TEST(MeshOptimizerTest, AnalyzeVertexCacheEvictsFifo)
+{
+    // Vertex 0 is evicted by the time it's referenced again with a cache of 3
+    const uint32_t        indices[] = {0, 1, 2, 3, 4, 5, 0, 4, 5};
+    VertexCacheStatistics stats     = MeshOptimizer::AnalyzeVertexCache(indices, 9, 6, 3);
+    EXPECT_EQ(stats.transformCount, 7u);
+}
+
+TEST(MeshOptimizerTest, TipsifyImprovesShuffledGrid)
+{
+    uint32_t              vertexCount = 0;
+    std::vector<uint32_t> indices     = CreateShuffledGrid(32, &vertexCount);
+    std::vector<uint32_t> optimized(indices.size());
+    std::vector<uint32_t> clusters;
+    MeshOptimizer::OptimizeVertexCacheTipsify(optimized.data(), indices.data(), CountU32(indices), vertexCount, 16, &clusters);
+
+    EXPECT_EQ(CanonicalTriangles(optimized), CanonicalTriangles(indices));
+    ASSERT_FALSE(clusters.empty());
+    EXPECT_EQ(clusters[0], 0u);
+    EXPECT_TRUE(std::is_sorted(clusters.begin(), clusters.end()));
+
+    VertexCacheStatistics before = MeshOptimizer::AnalyzeVertexCache(indices.data(), CountU32(indices), vertexCount, 16);
+    VertexCacheStatistics after  = MeshOptimizer::AnalyzeVertexCache(optimized.data(), CountU32(optimized), vertexCount, 16);
+    EXPECT_LT(after.acmr, 1.0f);
+    EXPECT_LT(after.acmr, before.acmr);
+}
+
+TEST(MeshOptimizerTest, ForsythImprovesShuffledGrid)
+{
+    uint32_t              vertexCount = 0;
+    std::vector<uint32_t> indices     = CreateShuffledGrid(32, &vertexCount);
+    std::vector<uint32_t> optimized(indices.size());
+    MeshOptimizer::OptimizeVertexCacheForsyth(optimized.data(), indices.data(), CountU32(indices), vertexCount, 32);
+
+    EXPECT_EQ(CanonicalTriangles(optimized), CanonicalTriangles(indices));
+
+    VertexCacheStatistics before = MeshOptimizer::AnalyzeVertexCache(indices.data(), CountU32(indices), vertexCount, 16);
+    VertexCacheStatistics after  = MeshOptimizer::AnalyzeVertexCache(optimized.data(), CountU32(optimized), vertexCount, 16);
+    EXPECT_LT(after.acmr, 1.0f);
+    EXPECT_LT(after.acmr, before.acmr);
+}
+
+TEST(MeshOptimizerTest, VertexFetchRemapFollowsFirstUse)
+{
+    const uint32_t indices[] = {3, 1, 3, 0, 1, 0};
+    uint32_t       remap[5]  = {};
+    EXPECT_EQ(MeshOptimizer::CreateVertexFetchRemap(remap, indices, 6, 5), 3u);
+    EXPECT_EQ(remap[3], 0u);
+    EXPECT_EQ(remap[1], 1u);
+    EXPECT_EQ(remap[0], 2u);
+    EXPECT_EQ(remap[2], UINT32_MAX);
+    EXPECT_EQ(remap[4], UINT32_MAX);
+}
+
+TEST(MeshOptimizerTest, OptimizeTriMeshPreservesTriangles)
+{
+    TriMesh mesh     = TriMesh::CreateSphere(1.0f, 64, 32, TriMeshOptions().Indices().Normals().TexCoords());
+    TriMesh original = mesh;
+
+    MeshOptimizerStatistics stats = {};
+    ASSERT_EQ(MeshOptimizer::Optimize(MeshOptimizerOptions(), &mesh, &stats), ppx::SUCCESS);
+    EXPECT_LE(stats.after.acmr, stats.before.acmr);
+    EXPECT_GE(stats.after.atvr, 1.0f);
+    ASSERT_EQ(mesh.GetCountTriangles(), original.GetCountTriangles());
+
+    // Compare triangles by vertex content, vertex order may have changed
+    auto triangleVertices = [](const TriMesh& m) {
+        std::vector<std::array<float, 15>> triangles;
+        for (uint32_t t = 0; t < m.GetCountTriangles(); ++t) {
+            uint32_t v[3] = {};
+            m.GetTriangle(t, v[0], v[1], v[2]);
+            std::array<float, 15> tri = {};
+            for (uint32_t j = 0; j < 3; ++j) {
+                const float3& p = *m.GetDataPositions(v[j]);
+                const float3& n = *m.GetDataNormalls(v[j]);
+                tri[5 * j + 0]  = p.x;
+                tri[5 * j + 1]  = p.y;
+                tri[5 * j + 2]  = p.z;
+                tri[5 * j + 3]  = n.x + m.GetDataTexCoords2(v[j])->x;
+                tri[5 * j + 4]  = n.y + m.GetDataTexCoords2(v[j])->y;
+            }
+            triangles.push_back(tri);
+        }
+        std::sort(triangles.begin(), triangles.end());
+        return triangles;
+    };
+    EXPECT_EQ(triangleVertices(mesh), triangleVertices(original));
+}
+
+TEST(MeshOptimizerTest, OptimizeGeometryMatchesTriMesh)
+{
+    TriMesh  mesh = TriMesh::CreateSphere(1.0f, 32, 16, TriMeshOptions().Indices().Normals());
+    Geometry geometry;
+    ASSERT_EQ(Geometry::Create(mesh, &geometry), ppx::SUCCESS);
+
+    MeshOptimizerStatistics meshStats     = {};
+    MeshOptimizerStatistics geometryStats = {};
+    ASSERT_EQ(MeshOptimizer::Optimize(MeshOptimizerOptions(), &mesh, &meshStats), ppx::SUCCESS);
+    ASSERT_EQ(MeshOptimizer::Optimize(MeshOptimizerOptions(), &geometry, &geometryStats), ppx::SUCCESS);
+    EXPECT_EQ(geometryStats.after.transformCount, meshStats.after.transformCount);
+
+    Geometry expected;
+    ASSERT_EQ(Geometry::Create(mesh, &expected), ppx::SUCCESS);
+    ASSERT_EQ(geometry.GetIndexBuffer()->GetSize(), expected.GetIndexBuffer()->GetSize());
+    EXPECT_EQ(memcmp(geometry.GetIndexBuffer()->GetData(), expected.GetIndexBuffer()->GetData(), expected.GetIndexBuffer()->GetSize()), 0);
+    for (uint32_t i = 0; i < expected.GetVertexBufferCount(); ++i) {
+        ASSERT_EQ(geometry.GetVertexBuffer(i)->GetSize(), expected.GetVertexBuffer(i)->GetSize());
+        EXPECT_EQ(memcmp(geometry.GetVertexBuffer(i)->GetData(), expected.GetVertexBuffer(i)->GetData(), expected.GetVertexBuffer(i)->GetSize()), 0);
+    }
+}
@@ -0,0 +1,166 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/mesh_simplifier.h"
+
+using namespace ppx;
+
+TEST(MeshSimplifierTest, SimplifySphereReachesTarget)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 32, 16, TriMeshOptions().Indices().Normals());
+
+    MeshSimplifierOptions options = {};
+    options.targetIndexCount      = mesh.GetCountIndices() / 2;
+
+    TriMesh simplified;
+    float   error = 0;
+    ASSERT_EQ(MeshSimplifier::Simplify(mesh, options, &simplified, &error), ppx::SUCCESS);
+    EXPECT_LE(simplified.GetCountIndices(), options.targetIndexCount);
+    EXPECT_GT(simplified.GetCountTriangles(), 0u);
+    EXPECT_LT(simplified.GetCountPositions(), mesh.GetCountPositions());
+    EXPECT_EQ(simplified.GetCountNormals(), simplified.GetCountPositions());
+    EXPECT_GT(error, 0.0f);
+    EXPECT_LT(error, 0.1f);
+
+    // Remaining vertices stay on the sphere
+    for (uint32_t i = 0; i < simplified.GetCountPositions(); ++i) {
+        EXPECT_NEAR(glm::length(*simplified.GetDataPositions(i)), 1.0f, 1e-3f);
+    }
+}
+
+TEST(MeshSimplifierTest, SimplifyRespectsMaxError)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 32, 16, TriMeshOptions().Indices());
+
+    MeshSimplifierOptions options = {};
+    options.maxError              = 1e-6f;
+
+    TriMesh simplified;
+    float   error = 0;
+    ASSERT_EQ(MeshSimplifier::Simplify(mesh, options, &simplified, &error), ppx::SUCCESS);
+    EXPECT_LE(error, options.maxError);
+    EXPECT_GT(simplified.GetCountTriangles(), mesh.GetCountTriangles() / 2);
+}
+
+TEST(MeshSimplifierTest, ErrorIsDisplacementDistance)
+{
+    // 3x3 vertex grid in the XZ plane with the center vertex raised off the
+    // plane. With the borders locked only the center can collapse, onto the
+    // flat border.
+    for (float scale : {1.0f, 100.0f}) {
+        const float displacement = 0.25f * scale;
+
+        TriMesh mesh(grfx::INDEX_TYPE_UINT32, TRI_MESH_ATTRIBUTE_DIM_UNDEFINED);
+        for (uint32_t z = 0; z < 3; ++z) {
+            for (uint32_t x = 0; x < 3; ++x) {
+                const float y = ((x == 1) && (z == 1)) ? displacement : 0.0f;
+                mesh.AppendPosition(float3(static_cast<float>(x) * scale, y, static_cast<float>(z) * scale));
+            }
+        }
+        for (uint32_t z = 0; z < 2; ++z) {
+            for (uint32_t x = 0; x < 2; ++x) {
+                const uint32_t v = 3 * z + x;
+                mesh.AppendTriangle(v, v + 3, v + 4);
+                mesh.AppendTriangle(v, v + 4, v + 1);
+            }
+        }
+
+        MeshSimplifierOptions options = {};
+        options.targetIndexCount      = mesh.GetCountIndices() - 6;
+        options.lockBorders           = true;
+
+        TriMesh simplified;
+        float   error = 0;
+        ASSERT_EQ(MeshSimplifier::Simplify(mesh, options, &simplified, &error), ppx::SUCCESS);
+        EXPECT_EQ(simplified.GetCountPositions(), 8u);
+        EXPECT_NEAR(error, displacement, 1e-5f * scale);
+
+        // A limit below the displacement keeps the center
+        options.maxError = 0.9f * displacement;
+        ASSERT_EQ(MeshSimplifier::Simplify(mesh, options, &simplified, &error), ppx::SUCCESS);
+        EXPECT_EQ(simplified.GetCountPositions(), 9u);
+        EXPECT_EQ(error, 0.0f);
+    }
+}
+
+TEST(MeshSimplifierTest, SimplifyNonIndexedProducesUint32Indices)
+{
+    TriMesh mesh = TriMesh::CreatePlane(TRI_MESH_PLANE_POSITIVE_Y, float2(2, 2), 8, 8);
+    ASSERT_EQ(mesh.GetIndexType(), grfx::INDEX_TYPE_UNDEFINED);
+
+    MeshSimplifierOptions options = {};
+    options.targetIndexCount      = 6;
+
+    TriMesh simplified;
+    ASSERT_EQ(MeshSimplifier::Simplify(mesh, options, &simplified), ppx::SUCCESS);
+    EXPECT_EQ(simplified.GetIndexType(), grfx::INDEX_TYPE_UINT32);
+    EXPECT_LE(simplified.GetCountIndices(), 6u);
+    EXPECT_GT(simplified.GetCountTriangles(), 0u);
+}
+
+TEST(MeshSimplifierTest, LockBordersKeepsCorners)
+{
+    TriMesh mesh = TriMesh::CreatePlane(TRI_MESH_PLANE_POSITIVE_Y, float2(2, 2), 8, 8, TriMeshOptions().Indices());
+
+    MeshSimplifierOptions options = {};
+    options.lockBorders           = true;
+
+    TriMesh simplified;
+    ASSERT_EQ(MeshSimplifier::Simplify(mesh, options, &simplified), ppx::SUCCESS);
+
+    // Interior vertices collapse away, the 32 border vertices remain
+    EXPECT_EQ(simplified.GetCountPositions(), 32u);
+    EXPECT_EQ(simplified.GetBoundingBoxMin(), mesh.GetBoundingBoxMin());
+    EXPECT_EQ(simplified.GetBoundingBoxMax(), mesh.GetBoundingBoxMax());
+}
+
+TEST(MeshSimplifierTest, LODChainIsMonotonic)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 64, 32, TriMeshOptions().Indices().Normals().TexCoords());
+
+    std::vector<MeshLOD> lods;
+    ASSERT_EQ(MeshSimplifier::CreateLODChain(mesh, MeshLODChainOptions(), &lods), ppx::SUCCESS);
+    ASSERT_GT(lods.size(), 1u);
+    EXPECT_EQ(lods[0].mesh.GetCountIndices(), mesh.GetCountIndices());
+    EXPECT_EQ(lods[0].error, 0.0f);
+    for (size_t i = 1; i < lods.size(); ++i) {
+        EXPECT_LT(lods[i].mesh.GetCountTriangles(), lods[i - 1].mesh.GetCountTriangles());
+        EXPECT_GE(lods[i].error, lods[i - 1].error);
+    }
+}
+
+TEST(MeshSimplifierTest, SelectLODByDistance)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 64, 32, TriMeshOptions().Indices());
+
+    std::vector<MeshLOD> lods;
+    ASSERT_EQ(MeshSimplifier::CreateLODChain(mesh, MeshLODChainOptions(), &lods), ppx::SUCCESS);
+    ASSERT_GT(lods.size(), 2u);
+
+    const float4x4 model = float4x4(1.0f);
+    PerspCamera    nearCamera(float3(0, 0, 2), float3(0, 0, 0), float3(0, 1, 0), 60.0f, 1.0f);
+    PerspCamera    farCamera(float3(0, 0, 1000), float3(0, 0, 0), float3(0, 1, 0), 60.0f, 1.0f, 0.1f, 10000.0f);
+
+    const uint32_t nearLOD = MeshSimplifier::SelectLOD(nearCamera, model, lods, 1080.0f);
+    const uint32_t farLOD  = MeshSimplifier::SelectLOD(farCamera, model, lods, 1080.0f);
+    EXPECT_LT(nearLOD, farLOD);
+
+    // Screen space error shrinks with distance
+    const float error = lods.back().error;
+    EXPECT_GT(
+        MeshSimplifier::ComputeScreenSpaceError(nearCamera, model, mesh.GetBoundingBoxMin(), mesh.GetBoundingBoxMax(), error, 1080.0f),
+        MeshSimplifier::ComputeScreenSpaceError(farCamera, model, mesh.GetBoundingBoxMin(), mesh.GetBoundingBoxMax(), error, 1080.0f));
+}
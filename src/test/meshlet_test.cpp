@@ -0,0 +1,162 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/meshlet.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace ppx;
+
+namespace {
+
+// Triangles with rotation normalized so winding is preserved, sorted
+std::vector<std::array<uint32_t, 3>> CanonicalTriangles(std::vector<std::array<uint32_t, 3>> triangles)
+{
+    for (auto& tri : triangles) {
+        std::rotate(tri.begin(), std::min_element(tri.begin(), tri.end()), tri.end());
+    }
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // namespace
+
+TEST(MeshletTest, BuildRespectsLimitsAndKeepsTriangles)
+{
+    TriMesh mesh = TriMesh::CreateSphere(1.0f, 64, 32, TriMeshOptions().Indices());
+
+    MeshletBuildOptions options = {};
+    MeshletData         data;
+    ASSERT_EQ(MeshletBuilder::Build(mesh, options, &data), ppx::SUCCESS);
+    ASSERT_FALSE(data.meshlets.empty());
+    EXPECT_EQ(data.bounds.size(), data.meshlets.size());
+    EXPECT_EQ(data.triangles.size(), mesh.GetCountTriangles());
+
+    std::vector<std::array<uint32_t, 3>> original;
+    for (uint32_t i = 0; i < mesh.GetCountTriangles(); ++i) {
+        std::array<uint32_t, 3> tri = {};
+        ASSERT_EQ(mesh.GetTriangle(i, tri[0], tri[1], tri[2]), ppx::SUCCESS);
+        original.push_back(tri);
+    }
+
+    std::vector<std::array<uint32_t, 3>> decoded;
+    for (const Meshlet& meshlet : data.meshlets) {
+        EXPECT_LE(meshlet.vertexCount, options.maxVertices);
+        EXPECT_LE(meshlet.triangleCount, options.maxTriangles);
+        EXPECT_GT(meshlet.triangleCount, 0u);
+        for (uint32_t t = 0; t < meshlet.triangleCount; ++t) {
+            uint32_t i0 = 0, i1 = 0, i2 = 0;
+            MeshletBuilder::UnpackTriangle(data.triangles[meshlet.triangleOffset + t], i0, i1, i2);
+            ASSERT_LT(std::max({i0, i1, i2}), meshlet.vertexCount);
+            const uint32_t* pVertices = data.vertices.data() + meshlet.vertexOffset;
+            decoded.push_back({pVertices[i0], pVertices[i1], pVertices[i2]});
+        }
+    }
+    EXPECT_EQ(CanonicalTriangles(decoded), CanonicalTriangles(original));
+
+    // Greedy growth should fill most meshlets
+    const uint32_t minMeshletCount = (mesh.GetCountTriangles() + options.maxTriangles - 1) / options.maxTriangles;
+    EXPECT_LT(data.GetMeshletCount(), 2 * minMeshletCount);
+}
+
+TEST(MeshletTest, BuildRejectsInvalidLimits)
+{
+    const uint32_t indices[]   = {0, 1, 2};
+    const float3   positions[] = {float3(0, 0, 0), float3(1, 0, 0), float3(0, 1, 0)};
+
+    MeshletData         data;
+    MeshletBuildOptions options = {};
+    options.maxVertices         = MeshletBuilder::kMaxVertices + 1;
+    EXPECT_EQ(MeshletBuilder::Build(indices, 3, positions, 3, options, &data), ppx::ERROR_OUT_OF_RANGE);
+
+    options.maxVertices = 2;
+    EXPECT_EQ(MeshletBuilder::Build(indices, 3, positions, 3, options, &data), ppx::ERROR_OUT_OF_RANGE);
+
+    options = {};
+    EXPECT_EQ(MeshletBuilder::Build(indices, 3, positions, 2, options, &data), ppx::ERROR_OUT_OF_RANGE);
+}
+
+TEST(MeshletTest, BoundsContainVertices)
+{
+    TriMesh     mesh = TriMesh::CreateSphere(1.0f, 32, 16, TriMeshOptions().Indices());
+    MeshletData data;
+    ASSERT_EQ(MeshletBuilder::Build(mesh, MeshletBuildOptions(), &data), ppx::SUCCESS);
+
+    for (uint32_t i = 0; i < data.GetMeshletCount(); ++i) {
+        const Meshlet&       meshlet = data.meshlets[i];
+        const MeshletBounds& bounds  = data.bounds[i];
+        for (uint32_t v = 0; v < meshlet.vertexCount; ++v) {
+            const float3& p = *mesh.GetDataPositions(data.vertices[meshlet.vertexOffset + v]);
+            EXPECT_LE(glm::length(p - bounds.center), bounds.radius + 1e-5f);
+        }
+    }
+}
+
+TEST(MeshletTest, ConeBackfacingPlane)
+{
+    TriMesh     mesh = TriMesh::CreatePlane(TRI_MESH_PLANE_POSITIVE_Y, float2(2, 2), 4, 4, TriMeshOptions().Indices());
+    MeshletData data;
+    ASSERT_EQ(MeshletBuilder::Build(mesh, MeshletBuildOptions(), &data), ppx::SUCCESS);
+    ASSERT_EQ(data.GetMeshletCount(), 1u);
+
+    const MeshletBounds& bounds = data.bounds[0];
+    EXPECT_NEAR(bounds.coneAxis.y, 1.0f, 1e-5f);
+    EXPECT_NEAR(bounds.coneCutoff, 0.0f, 1e-3f);
+    EXPECT_FALSE(MeshletCuller::IsConeBackfacing(bounds, float3(0, 5, 0)));
+    EXPECT_TRUE(MeshletCuller::IsConeBackfacing(bounds, float3(0, -5, 0)));
+}
+
+TEST(MeshletTest, ExtractFrustumPlanesFromIdentity)
+{
+    // Identity clip space is the box [-1, 1] x [-1, 1] x [0, 1]
+    float4 planes[6] = {};
+    MeshletCuller::ExtractFrustumPlanes(float4x4(1.0f), planes);
+
+    EXPECT_FALSE(MeshletCuller::IsSphereOutsideFrustum(planes, float3(0, 0, 0.5f), 0.1f));
+    EXPECT_FALSE(MeshletCuller::IsSphereOutsideFrustum(planes, float3(1.5f, 0, 0.5f), 1.0f));
+    EXPECT_TRUE(MeshletCuller::IsSphereOutsideFrustum(planes, float3(1.5f, 0, 0.5f), 0.25f));
+    EXPECT_TRUE(MeshletCuller::IsSphereOutsideFrustum(planes, float3(0, -2, 0.5f), 0.5f));
+    EXPECT_TRUE(MeshletCuller::IsSphereOutsideFrustum(planes, float3(0, 0, -0.5f), 0.25f));
+    EXPECT_TRUE(MeshletCuller::IsSphereOutsideFrustum(planes, float3(0, 0, 1.5f), 0.25f));
+}
+
+TEST(MeshletTest, CullSphere)
+{
+    TriMesh     mesh = TriMesh::CreateSphere(0.4f, 64, 32, TriMeshOptions().Indices());
+    MeshletData data;
+    ASSERT_EQ(MeshletBuilder::Build(mesh, MeshletBuildOptions(), &data), ppx::SUCCESS);
+
+    // Near plane at z = 0 clips part of the camera facing half, the far half is backfacing
+    const float4x4        model = glm::translate(float3(0, 0, 0.1f));
+    std::vector<uint32_t> visible;
+    MeshletCullStatistics stats = {};
+    ASSERT_EQ(MeshletCuller::Cull(data, float4x4(1.0f), model, float3(0, 0, -10), MeshletCullOptions(), &visible, &stats), ppx::SUCCESS);
+
+    EXPECT_EQ(stats.meshletCount, data.GetMeshletCount());
+    EXPECT_GT(stats.frustumCulledCount, 0u);
+    EXPECT_GT(stats.backfaceCulledCount, 0u);
+    EXPECT_GT(stats.visibleCount, 0u);
+    EXPECT_EQ(stats.visibleCount + stats.frustumCulledCount + stats.backfaceCulledCount, stats.meshletCount);
+    EXPECT_EQ(visible.size(), stats.visibleCount);
+
+    MeshletCullOptions options    = {};
+    options.enableFrustumCulling  = false;
+    options.enableBackfaceCulling = false;
+    ASSERT_EQ(MeshletCuller::Cull(data, float4x4(1.0f), model, float3(0, 0, -10), options, &visible, &stats), ppx::SUCCESS);
+    EXPECT_EQ(stats.visibleCount, stats.meshletCount);
+    EXPECT_EQ(stats.visibleTriangles, mesh.GetCountTriangles());
+}
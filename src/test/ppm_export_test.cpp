@@ -234,6 +234,24 @@ TEST(PPMExport, RowStrideLargerThanRowBytes)
     EXPECT_EQ(data->texels, wantTexels);
 }
 
+TEST(PPMExport, BitmapSubView)
+{
+    std::stringstream          buffer(std::stringstream::out | std::stringstream::in | std::ios::binary);
+    std::vector<unsigned char> texels = {0, 1, 2, 3, 4, 5, 6, 7, 8, 10, 11, 12, 13, 14, 15, 16, 17, 18};
+    BitmapView                 view(3, 2, Bitmap::FORMAT_RGB_UINT8, 0, reinterpret_cast<char*>(texels.data()));
+    Result                     res = ExportToPPM(buffer, view.GetSubView(1, 0, 2, 2));
+    EXPECT_EQ(res, 0);
+
+    auto data = PPMData::FromStream(std::move(buffer));
+    ASSERT_TRUE(data.has_value());
+
+    EXPECT_EQ(data->width, 2);
+    EXPECT_EQ(data->height, 2);
+
+    std::vector<unsigned char> wantTexels = {3, 4, 5, 6, 7, 8, 13, 14, 15, 16, 17, 18};
+    EXPECT_EQ(data->texels, wantTexels);
+}
+
 // Errors and unsupported formats.
 TEST(PPMExport, InvalidSize)
 {
@@ -0,0 +1,176 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/random.h"
+#include "ppx/bitmap.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ppx;
+
+TEST(RandomLanesTest, LaneIsStreamOfNextSequence)
+{
+    RandomLanes lanes(42, 7);
+
+    std::vector<RandomLanes> streams;
+    for (uint32_t i = 0; i < RandomLanes::kLaneCount; ++i) {
+        streams.emplace_back(42, 7 + i);
+    }
+
+    for (uint32_t step = 0; step < 16; ++step) {
+        uint32_t values[RandomLanes::kLaneCount] = {};
+        lanes.UInt32(values);
+        for (uint32_t i = 0; i < RandomLanes::kLaneCount; ++i) {
+            uint32_t streamValues[RandomLanes::kLaneCount] = {};
+            streams[i].UInt32(streamValues);
+            EXPECT_EQ(values[i], streamValues[0]) << "lane " << i << " step " << step;
+        }
+    }
+}
+
+TEST(RandomLanesTest, FloatsCoverUnitRange)
+{
+    RandomLanes lanes(0, 0);
+
+    float    minValue = 1.0f;
+    float    maxValue = 0.0f;
+    double   sum      = 0.0;
+    uint32_t count    = 0;
+    for (uint32_t step = 0; step < 4096; ++step) {
+        float values[RandomLanes::kLaneCount] = {};
+        lanes.Float(values);
+        for (float value : values) {
+            minValue = std::min(minValue, value);
+            maxValue = std::max(maxValue, value);
+            sum += value;
+            ++count;
+        }
+    }
+    EXPECT_GE(minValue, 0.0f);
+    EXPECT_LT(maxValue, 1.0f);
+    EXPECT_LT(minValue, 0.001f);
+    EXPECT_GT(maxValue, 0.999f);
+    EXPECT_NEAR(sum / count, 0.5, 0.01);
+}
+
+TEST(RandomLanesTest, BulkFloatMatchesSteps)
+{
+    RandomLanes bulk(3, 11);
+    RandomLanes steps(3, 11);
+
+    std::vector<float> bulkValues(5 * RandomLanes::kLaneCount);
+    bulk.Float(bulkValues.data(), bulkValues.size());
+    for (size_t i = 0; i < bulkValues.size(); i += RandomLanes::kLaneCount) {
+        float values[RandomLanes::kLaneCount] = {};
+        steps.Float(values);
+        for (uint32_t lane = 0; lane < RandomLanes::kLaneCount; ++lane) {
+            EXPECT_EQ(bulkValues[i + lane], values[lane]) << "value " << (i + lane);
+        }
+    }
+}
+
+TEST(RandomTest, FillDoesNotDependOnSize)
+{
+    // Large enough to be split over threads
+    const size_t count = 64 * Random::kFillBlockSize + 5;
+
+    Random             randomLarge;
+    std::vector<float> large(count);
+    randomLarge.Fill(large.data(), large.size(), -1.0f, 1.0f);
+
+    Random             randomSmall;
+    std::vector<float> small(Random::kFillBlockSize + 3);
+    randomSmall.Fill(small.data(), small.size(), -1.0f, 1.0f);
+
+    for (size_t i = 0; i < small.size(); ++i) {
+        ASSERT_EQ(large[i], small[i]) << "value " << i;
+    }
+    for (float value : large) {
+        ASSERT_GE(value, -1.0f);
+        ASSERT_LE(value, 1.0f);
+    }
+
+    // Both generators advanced by the same amount
+    EXPECT_EQ(randomLarge.UInt32(), randomSmall.UInt32());
+
+    // The next fill uses new streams
+    std::vector<float> next(small.size());
+    randomSmall.Fill(next.data(), next.size(), -1.0f, 1.0f);
+    EXPECT_NE(next, small);
+}
+
+TEST(RandomTest, FillUsesComponentRanges)
+{
+    Random              random;
+    std::vector<float3> values(3 * Random::kFillBlockSize + 1);
+    random.Fill(values.data(), values.size(), float3(0.0f, 10.0f, -5.0f), float3(1.0f, 20.0f, -4.0f));
+
+    float3 minValue = values[0];
+    float3 maxValue = values[0];
+    for (const float3& value : values) {
+        minValue = glm::min(minValue, value);
+        maxValue = glm::max(maxValue, value);
+    }
+    EXPECT_GE(minValue.x, 0.0f);
+    EXPECT_LE(maxValue.x, 1.0f);
+    EXPECT_GE(minValue.y, 10.0f);
+    EXPECT_LE(maxValue.y, 20.0f);
+    EXPECT_GE(minValue.z, -5.0f);
+    EXPECT_LE(maxValue.z, -4.0f);
+
+    // Values cover their range
+    EXPECT_LT(minValue.y, 10.1f);
+    EXPECT_GT(maxValue.y, 19.9f);
+}
+
+TEST(RandomTest, FillBitmapChannels)
+{
+    Bitmap bitmap = Bitmap::Create(37, 5, Bitmap::FORMAT_RGBA_UINT8);
+    bitmap.Fill<uint8_t>(1, 2, 3, 4);
+
+    Random random;
+    ASSERT_EQ(random.FillChannel(&bitmap, 2, 0.5f, 1.0f), ppx::SUCCESS);
+    EXPECT_EQ(random.FillChannel(&bitmap, 4), ppx::ERROR_OUT_OF_RANGE);
+
+    uint32_t distinctCount = 0;
+    for (uint32_t y = 0; y < bitmap.GetHeight(); ++y) {
+        for (uint32_t x = 0; x < bitmap.GetWidth(); ++x) {
+            const uint8_t* pPixel = bitmap.GetPixel8u(x, y);
+            EXPECT_EQ(pPixel[0], 1);
+            EXPECT_EQ(pPixel[1], 2);
+            EXPECT_GE(pPixel[2], 127);
+            EXPECT_EQ(pPixel[3], 4);
+            distinctCount += (pPixel[2] != bitmap.GetPixel8u(0, 0)[2]) ? 1 : 0;
+        }
+    }
+    EXPECT_GT(distinctCount, 0u);
+
+    Bitmap floats = Bitmap::Create(9, 3, Bitmap::FORMAT_RGBA_FLOAT);
+    ASSERT_EQ(random.Fill(&floats, float4(-200.0f, 50.0f, -200.0f, 0.5f), float4(200.0f, 450.0f, 200.0f, 1.0f)), ppx::SUCCESS);
+    for (uint32_t y = 0; y < floats.GetHeight(); ++y) {
+        for (uint32_t x = 0; x < floats.GetWidth(); ++x) {
+            const float* pPixel = floats.GetPixel32f(x, y);
+            EXPECT_GE(pPixel[1], 50.0f);
+            EXPECT_LE(pPixel[1], 450.0f);
+            EXPECT_GE(pPixel[3], 0.5f);
+            EXPECT_LE(pPixel[3], 1.0f);
+        }
+    }
+
+    Bitmap empty;
+    EXPECT_EQ(random.Fill(&empty), ppx::ERROR_IMAGE_INVALID_FORMAT);
+}
@@ -0,0 +1,300 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/texture_compression.h"
+
+#include <cstdlib>
+
+using namespace ppx;
+
+namespace {
+
+struct Rgba
+{
+    int32_t c[4];
+};
+
+// Pixels of each 4x4 block lie on a line through RGBA space, which is
+// what a single subset of endpoints can represent
+Bitmap CreateRampRGBA8(uint32_t width, uint32_t height)
+{
+    Bitmap bitmap = Bitmap::Create(width, height, Bitmap::FORMAT_RGBA_UINT8);
+    for (uint32_t y = 0; y < height; ++y) {
+        for (uint32_t x = 0; x < width; ++x) {
+            const uint32_t t      = (x % 4) + 4 * (y % 4);
+            uint8_t*       pPixel = bitmap.GetPixel8u(x, y);
+            pPixel[0]             = static_cast<uint8_t>(40 + 8 * t);
+            pPixel[1]             = static_cast<uint8_t>(200 - 6 * t);
+            pPixel[2]             = static_cast<uint8_t>(4 * t + x / 4);
+            pPixel[3]             = static_cast<uint8_t>(255 - 4 * t);
+        }
+    }
+    return bitmap;
+}
+
+Bitmap CreateSolidRGBA8(uint32_t width, uint32_t height, uint8_t r, uint8_t g, uint8_t b, uint8_t a)
+{
+    Bitmap bitmap = Bitmap::Create(width, height, Bitmap::FORMAT_RGBA_UINT8);
+    bitmap.Fill<uint8_t>(r, g, b, a);
+    return bitmap;
+}
+
+uint32_t ReadBits(const uint8_t* pBlock, uint32_t offset, uint32_t count)
+{
+    uint32_t value = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        const uint32_t bit = offset + i;
+        value |= ((pBlock[bit / 8] >> (bit % 8)) & 1u) << i;
+    }
+    return value;
+}
+
+// Reference decoders for the 4x4 blocks at the start of pBlock
+
+void DecodeBC1(const uint8_t* pBlock, Rgba pixels[16])
+{
+    const uint32_t color0   = pBlock[0] | (pBlock[1] << 8);
+    const uint32_t color1   = pBlock[2] | (pBlock[3] << 8);
+    const uint32_t colors[] = {color0, color1};
+
+    Rgba palette[4] = {};
+    for (uint32_t i = 0; i < 2; ++i) {
+        const int32_t r = (colors[i] >> 11) & 0x1F;
+        const int32_t g = (colors[i] >> 5) & 0x3F;
+        const int32_t b = colors[i] & 0x1F;
+        palette[i]      = {{(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2), 255}};
+    }
+    for (uint32_t c = 0; c < 3; ++c) {
+        if (color0 > color1) {
+            palette[2].c[c] = (2 * palette[0].c[c] + palette[1].c[c] + 1) / 3;
+            palette[3].c[c] = (palette[0].c[c] + 2 * palette[1].c[c] + 1) / 3;
+        }
+        else {
+            palette[2].c[c] = (palette[0].c[c] + palette[1].c[c]) / 2;
+        }
+    }
+    palette[2].c[3] = 255;
+    palette[3].c[3] = (color0 > color1) ? 255 : 0;
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        pixels[i] = palette[ReadBits(pBlock + 4, 2 * i, 2)];
+    }
+}
+
+void DecodeBC4(const uint8_t* pBlock, uint32_t channel, Rgba pixels[16])
+{
+    const int32_t value0     = pBlock[0];
+    const int32_t value1     = pBlock[1];
+    int32_t       palette[8] = {value0, value1};
+    if (value0 > value1) {
+        for (int32_t i = 2; i < 8; ++i) {
+            palette[i] = ((8 - i) * value0 + (i - 1) * value1 + 3) / 7;
+        }
+    }
+    else {
+        for (int32_t i = 2; i < 6; ++i) {
+            palette[i] = ((6 - i) * value0 + (i - 1) * value1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+
+    for (uint32_t i = 0; i < 16; ++i) {
+        pixels[i].c[channel] = palette[ReadBits(pBlock + 2, 3 * i, 3)];
+    }
+}
+
+// Only mode 6, which is what the encoder writes
+void DecodeBC7Mode6(const uint8_t* pBlock, Rgba pixels[16])
+{
+    constexpr int32_t kWeights[16] = {0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64};
+
+    int32_t endpoints[2][4];
+    for (uint32_t c = 0; c < 4; ++c) {
+        endpoints[0][c] = ReadBits(pBlock, 7 + 14 * c, 7) << 1;
+        endpoints[1][c] = ReadBits(pBlock, 14 + 14 * c, 7) << 1;
+    }
+    for (uint32_t e = 0; e < 2; ++e) {
+        const int32_t pBit = ReadBits(pBlock, 63 + e, 1);
+        for (uint32_t c = 0; c < 4; ++c) {
+            endpoints[e][c] |= pBit;
+        }
+    }
+
+    for (uint32_t i = 0, offset = 65; i < 16; ++i) {
+        const uint32_t bitCount = (i == 0) ? 3 : 4;
+        const int32_t  w        = kWeights[ReadBits(pBlock, offset, bitCount)];
+        offset += bitCount;
+        for (uint32_t c = 0; c < 4; ++c) {
+            pixels[i].c[c] = ((64 - w) * endpoints[0][c] + w * endpoints[1][c] + 32) >> 6;
+        }
+    }
+}
+
+// Largest per channel difference over the first channelCount channels
+int32_t MaxBlockError(const Bitmap& bitmap, uint32_t blockX, uint32_t blockY, const Rgba pixels[16], uint32_t channelCount)
+{
+    int32_t maxError = 0;
+    for (uint32_t i = 0; i < 16; ++i) {
+        const uint8_t* pPixel = bitmap.GetPixel8u(blockX * 4 + (i % 4), blockY * 4 + (i / 4));
+        for (uint32_t c = 0; c < channelCount; ++c) {
+            maxError = std::max(maxError, std::abs(pixels[i].c[c] - pPixel[c]));
+        }
+    }
+    return maxError;
+}
+
+} // namespace
+
+TEST(TextureCompressionTest, RejectsUnsupportedFormats)
+{
+    std::vector<char> blocks;
+    Bitmap            rgba = CreateSolidRGBA8(4, 4, 1, 2, 3, 4);
+    EXPECT_EQ(CompressBitmap(rgba, grfx::FORMAT_BC2_UNORM, TEXTURE_COMPRESSION_QUALITY_FAST, &blocks), ppx::ERROR_IMAGE_INVALID_FORMAT);
+    EXPECT_EQ(CompressBitmap(rgba, grfx::FORMAT_R8G8B8A8_UNORM, TEXTURE_COMPRESSION_QUALITY_FAST, &blocks), ppx::ERROR_IMAGE_INVALID_FORMAT);
+
+    Bitmap hdr = Bitmap::Create(4, 4, Bitmap::FORMAT_RGBA_FLOAT);
+    EXPECT_EQ(CompressBitmap(hdr, grfx::FORMAT_BC7_UNORM, TEXTURE_COMPRESSION_QUALITY_FAST, &blocks), ppx::ERROR_IMAGE_INVALID_FORMAT);
+
+    EXPECT_TRUE(IsTextureCompressionFormatSupported(grfx::FORMAT_BC7_SRGB));
+    EXPECT_FALSE(IsTextureCompressionFormatSupported(grfx::FORMAT_BC6H_UFLOAT));
+}
+
+TEST(TextureCompressionTest, EdgeBlocksArePadded)
+{
+    Bitmap            bitmap = CreateRampRGBA8(5, 9);
+    std::vector<char> blocks;
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC1_RGB_UNORM, TEXTURE_COMPRESSION_QUALITY_NORMAL, &blocks), ppx::SUCCESS);
+    EXPECT_EQ(blocks.size(), 2 * 3 * 8);
+
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC7_UNORM, TEXTURE_COMPRESSION_QUALITY_NORMAL, &blocks), ppx::SUCCESS);
+    EXPECT_EQ(blocks.size(), 2 * 3 * 16);
+}
+
+TEST(TextureCompressionTest, BC1SolidColorIsExact)
+{
+    // 0xF800 in RGB565, which expands back to 255, 0, 0
+    Bitmap            bitmap = CreateSolidRGBA8(4, 4, 255, 0, 0, 255);
+    std::vector<char> blocks;
+    for (auto quality : {TEXTURE_COMPRESSION_QUALITY_FAST, TEXTURE_COMPRESSION_QUALITY_NORMAL, TEXTURE_COMPRESSION_QUALITY_HIGH}) {
+        ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC1_RGB_UNORM, quality, &blocks), ppx::SUCCESS);
+        Rgba pixels[16];
+        DecodeBC1(reinterpret_cast<const uint8_t*>(blocks.data()), pixels);
+        EXPECT_EQ(MaxBlockError(bitmap, 0, 0, pixels, 4), 0);
+    }
+}
+
+TEST(TextureCompressionTest, BC1GradientErrorIsSmall)
+{
+    Bitmap bitmap = CreateRampRGBA8(4, 4);
+
+    int32_t errors[3] = {};
+    for (auto quality : {TEXTURE_COMPRESSION_QUALITY_FAST, TEXTURE_COMPRESSION_QUALITY_NORMAL, TEXTURE_COMPRESSION_QUALITY_HIGH}) {
+        std::vector<char> blocks;
+        ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC1_RGB_UNORM, quality, &blocks), ppx::SUCCESS);
+        Rgba pixels[16];
+        DecodeBC1(reinterpret_cast<const uint8_t*>(blocks.data()), pixels);
+        errors[quality] = MaxBlockError(bitmap, 0, 0, pixels, 3);
+        EXPECT_LE(errors[quality], 24) << "quality " << quality;
+    }
+    EXPECT_LE(errors[TEXTURE_COMPRESSION_QUALITY_HIGH], errors[TEXTURE_COMPRESSION_QUALITY_FAST]);
+}
+
+TEST(TextureCompressionTest, BC1AlphaUsesTransparentIndex)
+{
+    Bitmap bitmap = CreateSolidRGBA8(4, 4, 0, 255, 0, 255);
+    bitmap.GetPixel8u(1, 2)[3] = 0;
+
+    std::vector<char> blocks;
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC1_RGBA_UNORM, TEXTURE_COMPRESSION_QUALITY_NORMAL, &blocks), ppx::SUCCESS);
+    Rgba pixels[16];
+    DecodeBC1(reinterpret_cast<const uint8_t*>(blocks.data()), pixels);
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_EQ(pixels[i].c[3], (i == 2 * 4 + 1) ? 0 : 255) << "pixel " << i;
+    }
+}
+
+TEST(TextureCompressionTest, BC4AndBC5ChannelsAreClose)
+{
+    Bitmap            bitmap = CreateRampRGBA8(8, 8);
+    std::vector<char> blocks;
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC5_UNORM, TEXTURE_COMPRESSION_QUALITY_HIGH, &blocks), ppx::SUCCESS);
+    ASSERT_EQ(blocks.size(), 4 * 16);
+    for (uint32_t block = 0; block < 4; ++block) {
+        const uint8_t* pBlock = reinterpret_cast<const uint8_t*>(blocks.data()) + 16 * block;
+        Rgba           pixels[16] = {};
+        DecodeBC4(pBlock, 0, pixels);
+        DecodeBC4(pBlock + 8, 1, pixels);
+        EXPECT_LE(MaxBlockError(bitmap, block % 2, block / 2, pixels, 2), 9) << "block " << block;
+    }
+
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC4_UNORM, TEXTURE_COMPRESSION_QUALITY_FAST, &blocks), ppx::SUCCESS);
+    ASSERT_EQ(blocks.size(), 4 * 8);
+    Rgba pixels[16] = {};
+    DecodeBC4(reinterpret_cast<const uint8_t*>(blocks.data()), 0, pixels);
+    EXPECT_LE(MaxBlockError(bitmap, 0, 0, pixels, 1), 9);
+}
+
+TEST(TextureCompressionTest, BC3CombinesAlphaAndColor)
+{
+    Bitmap            bitmap = CreateRampRGBA8(4, 4);
+    std::vector<char> blocks;
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC3_UNORM, TEXTURE_COMPRESSION_QUALITY_NORMAL, &blocks), ppx::SUCCESS);
+    ASSERT_EQ(blocks.size(), 16);
+
+    const uint8_t* pBlock = reinterpret_cast<const uint8_t*>(blocks.data());
+    Rgba           pixels[16];
+    DecodeBC1(pBlock + 8, pixels);
+    EXPECT_LE(MaxBlockError(bitmap, 0, 0, pixels, 3), 24);
+    DecodeBC4(pBlock, 3, pixels);
+    for (uint32_t i = 0; i < 16; ++i) {
+        EXPECT_LE(std::abs(pixels[i].c[3] - bitmap.GetPixel8u(i % 4, i / 4)[3]), 5) << "pixel " << i;
+    }
+}
+
+TEST(TextureCompressionTest, BC7UsesMode6)
+{
+    Bitmap bitmap = CreateRampRGBA8(8, 4);
+
+    for (auto quality : {TEXTURE_COMPRESSION_QUALITY_FAST, TEXTURE_COMPRESSION_QUALITY_NORMAL, TEXTURE_COMPRESSION_QUALITY_HIGH}) {
+        std::vector<char> blocks;
+        ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC7_UNORM, quality, &blocks), ppx::SUCCESS);
+        ASSERT_EQ(blocks.size(), 2 * 16);
+        for (uint32_t block = 0; block < 2; ++block) {
+            const uint8_t* pBlock = reinterpret_cast<const uint8_t*>(blocks.data()) + 16 * block;
+            // Mode is the position of the lowest set bit
+            EXPECT_EQ(pBlock[0] & 0x7F, 0x40);
+            Rgba pixels[16];
+            DecodeBC7Mode6(pBlock, pixels);
+            EXPECT_LE(MaxBlockError(bitmap, block, 0, pixels, 4), 8) << "quality " << quality << ", block " << block;
+        }
+    }
+}
+
+TEST(TextureCompressionTest, ParallelEncodingMatchesSerial)
+{
+    // Large enough to be split into bands, the result must not depend on it
+    Bitmap            bitmap = CreateRampRGBA8(512, 512);
+    std::vector<char> blocks;
+    ASSERT_EQ(CompressBitmap(bitmap, grfx::FORMAT_BC1_RGB_UNORM, TEXTURE_COMPRESSION_QUALITY_FAST, &blocks), ppx::SUCCESS);
+
+    Bitmap            lastRows = CreateRampRGBA8(512, 512);
+    BitmapView        view     = BitmapView(lastRows).GetSubView(0, 508, 512, 4);
+    std::vector<char> lastRowBlocks;
+    ASSERT_EQ(CompressBitmap(view, grfx::FORMAT_BC1_RGB_UNORM, TEXTURE_COMPRESSION_QUALITY_FAST, &lastRowBlocks), ppx::SUCCESS);
+    ASSERT_EQ(lastRowBlocks.size(), 128 * 8);
+    EXPECT_TRUE(std::equal(lastRowBlocks.begin(), lastRowBlocks.end(), blocks.end() - lastRowBlocks.size()));
+}
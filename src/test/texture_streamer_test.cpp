@@ -0,0 +1,237 @@
+// Copyright 2024 Google LLC
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     https://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gtest/gtest.h"
+
+#include "ppx/texture_streamer.h"
+#include "ppx/grfx/grfx_device.h"
+#include "ppx/grfx/grfx_instance.h"
+#include "ppx/grfx/grfx_texture.h"
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+using namespace ppx;
+
+#if defined(PPX_NULL)
+
+namespace {
+
+// vkFormat of VK_FORMAT_R8G8B8A8_UNORM
+constexpr uint32_t kVkFormatRGBA8 = 37;
+
+// Writes a size x size RGBA8 KTX2 file with a full mip chain
+void WriteKtx2File(const std::filesystem::path& path, uint32_t size)
+{
+    uint32_t levelCount = 1;
+    while ((size >> levelCount) > 0) {
+        ++levelCount;
+    }
+
+    Ktx2Header header = {};
+    std::memcpy(header.identifier, Ktx2File::kIdentifier, sizeof(header.identifier));
+    header.vkFormat    = kVkFormatRGBA8;
+    header.typeSize    = 1;
+    header.pixelWidth  = size;
+    header.pixelHeight = size;
+    header.faceCount   = 1;
+    header.levelCount  = levelCount;
+
+    std::vector<Ktx2LevelIndex> index(levelCount);
+    uint64_t                    offset = sizeof(Ktx2Header) + sizeof(Ktx2LevelIndex) * levelCount;
+    for (uint32_t level = levelCount; level-- > 0;) {
+        const uint64_t levelSize            = 4ull * (size >> level) * (size >> level);
+        index[level].byteOffset             = offset;
+        index[level].byteLength             = levelSize;
+        index[level].uncompressedByteLength = levelSize;
+        offset += levelSize;
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(index.data()), sizeof(Ktx2LevelIndex) * index.size());
+    for (uint32_t level = levelCount; level-- > 0;) {
+        std::vector<char> data(static_cast<size_t>(index[level].byteLength), static_cast<char>(level));
+        file.write(data.data(), data.size());
+    }
+}
+
+// Size of an RGBA8 image holding levels [level, end) of a size x size texture
+uint64_t ImageSize(uint32_t size, uint32_t level)
+{
+    uint64_t imageSize = 0;
+    for (uint32_t levelSize = size >> level; levelSize > 0; levelSize >>= 1) {
+        imageSize += 4ull * levelSize * levelSize;
+    }
+    return imageSize;
+}
+
+class TextureStreamerTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        grfx::InstanceCreateInfo instanceCreateInfo = {};
+        instanceCreateInfo.api                      = grfx::API_NULL;
+        ASSERT_EQ(grfx::CreateInstance(&instanceCreateInfo, &mInstance), ppx::SUCCESS);
+
+        grfx::GpuPtr gpu;
+        ASSERT_EQ(mInstance->GetGpu(0, &gpu), ppx::SUCCESS);
+
+        grfx::DeviceCreateInfo deviceCreateInfo = {};
+        deviceCreateInfo.pGpu                   = gpu;
+        deviceCreateInfo.graphicsQueueCount     = 1;
+        ASSERT_EQ(mInstance->CreateDevice(&deviceCreateInfo, &mDevice), ppx::SUCCESS);
+
+        const std::string seed = std::to_string(::testing::UnitTest::GetInstance()->random_seed());
+        mPathA                 = std::filesystem::temp_directory_path() / ("ppx_texture_streamer_a_" + seed + ".ktx2");
+        mPathB                 = std::filesystem::temp_directory_path() / ("ppx_texture_streamer_b_" + seed + ".ktx2");
+        WriteKtx2File(mPathA, 64);
+        WriteKtx2File(mPathB, 32);
+    }
+
+    void TearDown() override
+    {
+        mStreamer.Destroy();
+        if (mInstance) {
+            grfx::DestroyInstance(mInstance);
+        }
+
+        std::error_code ec;
+        std::filesystem::remove(mPathA, ec);
+        std::filesystem::remove(mPathB, ec);
+    }
+
+    void CreateStreamer(uint64_t budget)
+    {
+        TextureStreamerCreateInfo createInfo = {};
+        createInfo.pQueue                    = mDevice->GetGraphicsQueue();
+        createInfo.memoryBudget              = budget;
+        createInfo.residentTailSize          = 8;
+        ASSERT_EQ(mStreamer.Create(createInfo), ppx::SUCCESS);
+    }
+
+    // Updates until all loads are uploaded
+    void UpdateUntilIdle()
+    {
+        const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        do {
+            ASSERT_EQ(mStreamer.Update(), ppx::SUCCESS);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        } while ((mStreamer.GetPendingLoadCount() > 0) && (std::chrono::steady_clock::now() < timeout));
+        ASSERT_EQ(mStreamer.GetPendingLoadCount(), 0u);
+    }
+
+    grfx::InstancePtr     mInstance;
+    grfx::DevicePtr       mDevice;
+    std::filesystem::path mPathA;
+    std::filesystem::path mPathB;
+    TextureStreamer       mStreamer;
+};
+
+} // namespace
+
+TEST_F(TextureStreamerTest, AddTextureLoadsTail)
+{
+    CreateStreamer(UINT64_MAX);
+
+    StreamedTexture* pTexture = nullptr;
+    ASSERT_EQ(mStreamer.AddTexture(mPathA, &pTexture), ppx::SUCCESS);
+    ASSERT_NE(pTexture, nullptr);
+    EXPECT_EQ(pTexture->GetMipLevelCount(), 7u);
+    EXPECT_EQ(pTexture->GetTailMipLevel(), 3u);
+    EXPECT_EQ(pTexture->GetResidentMipLevel(), 3u);
+    EXPECT_EQ(pTexture->GetResidentSize(), ImageSize(64, 3));
+    EXPECT_EQ(mStreamer.GetResidentSize(), ImageSize(64, 3));
+
+    ASSERT_NE(pTexture->GetTexture(), nullptr);
+    EXPECT_EQ(pTexture->GetTexture()->GetWidth(), 8u);
+    EXPECT_EQ(pTexture->GetTexture()->GetMipLevelCount(), 4u);
+}
+
+TEST_F(TextureStreamerTest, StreamsDesiredLevel)
+{
+    CreateStreamer(UINT64_MAX);
+
+    StreamedTexture* pTexture = nullptr;
+    ASSERT_EQ(mStreamer.AddTexture(mPathA, &pTexture), ppx::SUCCESS);
+    const uint64_t version = pTexture->GetVersion();
+
+    pTexture->SetDesiredMipLevel(1);
+    UpdateUntilIdle();
+    EXPECT_EQ(pTexture->GetResidentMipLevel(), 1u);
+    EXPECT_EQ(pTexture->GetTexture()->GetWidth(), 32u);
+    EXPECT_EQ(pTexture->GetTexture()->GetMipLevelCount(), 6u);
+    EXPECT_GT(pTexture->GetVersion(), version);
+
+    // Coarser than the tail is clamped to the tail
+    pTexture->SetScreenSize(0.0f, 0.0f);
+    UpdateUntilIdle();
+    EXPECT_EQ(pTexture->GetResidentMipLevel(), pTexture->GetTailMipLevel());
+}
+
+TEST_F(TextureStreamerTest, BudgetDropsLargestTextureFirst)
+{
+    // Both textures fit at level 1, A doesn't fit at level 0
+    CreateStreamer(ImageSize(64, 1) + ImageSize(32, 0));
+
+    StreamedTexture* pTextureA = nullptr;
+    StreamedTexture* pTextureB = nullptr;
+    ASSERT_EQ(mStreamer.AddTexture(mPathA, &pTextureA), ppx::SUCCESS);
+    ASSERT_EQ(mStreamer.AddTexture(mPathB, &pTextureB), ppx::SUCCESS);
+
+    UpdateUntilIdle();
+    EXPECT_EQ(pTextureA->GetResidentMipLevel(), 1u);
+    EXPECT_EQ(pTextureB->GetResidentMipLevel(), 0u);
+    EXPECT_LE(mStreamer.GetResidentSize(), mStreamer.GetMemoryBudget());
+
+    // Shrinking the budget evicts levels
+    mStreamer.SetMemoryBudget(ImageSize(64, 2) + ImageSize(32, 1));
+    UpdateUntilIdle();
+    EXPECT_EQ(pTextureA->GetResidentMipLevel(), 2u);
+    EXPECT_EQ(pTextureB->GetResidentMipLevel(), 1u);
+    EXPECT_LE(mStreamer.GetResidentSize(), mStreamer.GetMemoryBudget());
+
+    // Removing a texture frees budget for the other one
+    mStreamer.RemoveTexture(pTextureB);
+    mStreamer.SetMemoryBudget(ImageSize(64, 0));
+    UpdateUntilIdle();
+    UpdateUntilIdle();
+    EXPECT_EQ(pTextureA->GetResidentMipLevel(), 0u);
+    EXPECT_EQ(mStreamer.GetResidentSize(), ImageSize(64, 0));
+}
+
+TEST_F(TextureStreamerTest, AddTextureMissingFileFails)
+{
+    CreateStreamer(UINT64_MAX);
+
+    StreamedTexture* pTexture = nullptr;
+    EXPECT_EQ(mStreamer.AddTexture(mPathA.string() + ".missing", &pTexture), ppx::ERROR_PATH_DOES_NOT_EXIST);
+    EXPECT_EQ(pTexture, nullptr);
+}
+
+#endif // defined(PPX_NULL)
+
+TEST(TextureStreamerMipLevelTest, CalculateMipLevel)
+{
+    EXPECT_EQ(TextureStreamer::CalculateMipLevel(1024, 1024, 2048.0f, 2048.0f), 0u);
+    EXPECT_EQ(TextureStreamer::CalculateMipLevel(1024, 1024, 1024.0f, 1024.0f), 0u);
+    EXPECT_EQ(TextureStreamer::CalculateMipLevel(1024, 1024, 512.0f, 512.0f), 1u);
+    EXPECT_EQ(TextureStreamer::CalculateMipLevel(1024, 1024, 300.0f, 300.0f), 1u);
+    EXPECT_EQ(TextureStreamer::CalculateMipLevel(1024, 512, 1024.0f, 128.0f), 2u);
+    EXPECT_EQ(TextureStreamer::CalculateMipLevel(1024, 1024, 0.0f, 0.0f), UINT32_MAX);
+}
@@ -0,0 +1,148 @@
+# Copyright 2024 Google LLC
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     https://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+"""Packs a directory tree into a single .ppxpack asset pack.
+
+The layout must match the reader in src/ppx/fs.cpp. All values are little
+endian:
+
+    header     magic "PPXPACK\\0", u32 version, u32 entry count,
+               u64 string table offset, u64 string table size
+    entries    u64 path hash, u64 data offset, u64 data size,
+               u32 path offset, u32 path length; sorted by (hash, path)
+    strings    UTF-8 paths relative to the source directory, '/' separated
+    data       file contents, each aligned to DATA_ALIGNMENT bytes
+"""
+
+import argparse
+import fnmatch
+import logging
+import os
+from pathlib import Path
+import struct
+import sys
+from typing import NamedTuple
+
+MAGIC = b"PPXPACK\0"
+VERSION = 1
+DATA_ALIGNMENT = 64
+HEADER_FORMAT = "<8sIIQQ"
+ENTRY_FORMAT = "<QQQII"
+
+
+def align(value: int, alignment: int) -> int:
+    return (value + alignment - 1) & ~(alignment - 1)
+
+
+def hash_path(path: bytes) -> int:
+    """FNV-1a 64, matches HashPackPath() in src/ppx/fs.cpp."""
+    value = 0xCBF29CE484222325
+    for byte in path:
+        value ^= byte
+        value = (value * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return value
+
+
+class PackFile(NamedTuple):
+    path: bytes
+    source: Path
+
+
+def collect_files(source_dir: Path, excludes: list[str]) -> list[PackFile]:
+    files = []
+    for root, dirs, names in os.walk(source_dir):
+        dirs.sort()
+        for name in sorted(names):
+            source = Path(root) / name
+            relative = source.relative_to(source_dir).as_posix()
+            if any(fnmatch.fnmatch(relative, pattern) for pattern in excludes):
+                continue
+            files.append(PackFile(relative.encode("utf-8"), source))
+    return files
+
+
+def pack(source_dir: Path, output: Path, excludes: list[str]) -> None:
+    files = collect_files(source_dir, excludes)
+    files.sort(key=lambda f: (hash_path(f.path), f.path))
+
+    strings = bytearray()
+    path_offsets = []
+    for f in files:
+        path_offsets.append(len(strings))
+        strings += f.path
+
+    header_size = struct.calcsize(HEADER_FORMAT)
+    entry_size = struct.calcsize(ENTRY_FORMAT)
+    string_table_offset = header_size + len(files) * entry_size
+    data_offset = align(string_table_offset + len(strings), DATA_ALIGNMENT)
+
+    entries = bytearray()
+    data_offsets = []
+    for f, path_offset in zip(files, path_offsets):
+        size = f.source.stat().st_size
+        data_offsets.append(data_offset)
+        entries += struct.pack(
+            ENTRY_FORMAT, hash_path(f.path), data_offset, size, path_offset, len(f.path)
+        )
+        data_offset = align(data_offset + size, DATA_ALIGNMENT)
+
+    with open(output, "wb") as out:
+        out.write(
+            struct.pack(
+                HEADER_FORMAT,
+                MAGIC,
+                VERSION,
+                len(files),
+                string_table_offset,
+                len(strings),
+            )
+        )
+        out.write(entries)
+        out.write(strings)
+        for f, offset in zip(files, data_offsets):
+            out.write(b"\0" * (offset - out.tell()))
+            with open(f.source, "rb") as src:
+                out.write(src.read())
+
+    logging.info(f"Packed {len(files)} files from {source_dir} into {output}")
+
+
+def main():
+    logging.basicConfig(
+        format="%(asctime)s %(module)s: %(message)s", level=logging.INFO
+    )
+    parser = argparse.ArgumentParser(
+        description="Packs a directory tree, such as assets/, into a .ppxpack asset pack",
+    )
+    parser.add_argument("input", help="The directory to pack")
+    parser.add_argument("output", help="The output filename, e.g. assets.ppxpack")
+    parser.add_argument(
+        "--exclude",
+        action="append",
+        default=[],
+        help="Glob of paths relative to input to leave out, can be repeated",
+    )
+    args = parser.parse_args()
+
+    source_dir = Path(args.input).resolve()
+    if not source_dir.is_dir():
+        logging.error(f"{args.input} is not a directory")
+        return 1
+
+    pack(source_dir, Path(args.output), args.exclude)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())